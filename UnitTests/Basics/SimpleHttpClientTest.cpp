@@ -0,0 +1,240 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for driving SimpleHttpClient requests without blocking
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2004-2015 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Copyright 2015, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#ifndef _WIN32
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "Basics/Common.h"
+#include "Rest/Endpoint.h"
+#include "SimpleHttpClient/GeneralClientConnection.h"
+#include "SimpleHttpClient/SimpleHttpClient.h"
+#include "SimpleHttpClient/SimpleHttpResult.h"
+
+using namespace triagens;
+using namespace triagens::httpclient;
+using namespace triagens::rest;
+using namespace std;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief opens a listening socket on an ephemeral port of the loopback
+/// interface and returns its port
+////////////////////////////////////////////////////////////////////////////////
+
+static int Listen (int& port) {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  BOOST_REQUIRE(fd >= 0);
+
+  struct sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  addr.sin_port = 0;
+
+  BOOST_REQUIRE(bind(fd, (struct sockaddr*) &addr, sizeof(addr)) == 0);
+  BOOST_REQUIRE(listen(fd, 4) == 0);
+
+  socklen_t len = sizeof(addr);
+  BOOST_REQUIRE(getsockname(fd, (struct sockaddr*) &addr, &len) == 0);
+  port = (int) ntohs(addr.sin_port);
+
+  return fd;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief waits until a socket is ready for the given events
+////////////////////////////////////////////////////////////////////////////////
+
+static bool WaitFor (int fd, short events) {
+  struct pollfd p;
+  p.fd = fd;
+  p.events = events;
+  p.revents = 0;
+
+  return poll(&p, 1, 5000) > 0;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct SimpleHttpClientSetup {
+  SimpleHttpClientSetup ()
+    : endpoint(nullptr),
+      connection(nullptr) {
+    BOOST_TEST_MESSAGE("setup SimpleHttpClient");
+  }
+
+  ~SimpleHttpClientSetup () {
+    delete connection;
+    delete endpoint;
+    BOOST_TEST_MESSAGE("tear-down SimpleHttpClient");
+  }
+
+  void connectTo (int port) {
+    endpoint = Endpoint::clientFactory("tcp://127.0.0.1:" + std::to_string(port));
+    BOOST_REQUIRE(endpoint != nullptr);
+    endpoint->setNonBlockingConnect(true);
+
+    connection = GeneralClientConnection::factory(endpoint, 5.0, 5.0, 0, 0);
+    BOOST_REQUIRE(connection != nullptr);
+  }
+
+  Endpoint* endpoint;
+  GeneralClientConnection* connection;
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+BOOST_FIXTURE_TEST_SUITE (SimpleHttpClientTest, SimpleHttpClientSetup)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a request is driven to completion by single steps whenever its
+/// socket is ready, as the ClusterComm event loop does
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_step_request) {
+  int port;
+  int server = Listen(port);
+
+  connectTo(port);
+
+  SimpleHttpClient client(connection, 5.0, false);
+  std::map<std::string, std::string> headers;
+
+  client.beginRequest(HttpRequest::HTTP_REQUEST_GET, "/_api/version", nullptr, 0, headers);
+  BOOST_CHECK_EQUAL(true, client.needsConnect());
+
+  // connecting must not wait for the server to accept
+  client.processStep(0.0);
+  BOOST_CHECK_EQUAL(false, client.needsConnect());
+  BOOST_CHECK_EQUAL(true, client.wantsWrite());
+
+  BOOST_REQUIRE(WaitFor(server, POLLIN));
+  int peer = accept(server, nullptr, nullptr);
+  BOOST_REQUIRE(peer >= 0);
+
+  int fd = connection->getSocket().fileDescriptor;
+
+  // send the request
+  while (client.wantsWrite()) {
+    BOOST_REQUIRE(WaitFor(fd, POLLOUT));
+    client.processStep(0.0);
+  }
+
+  BOOST_CHECK_EQUAL(false, client.isFinished());
+
+  // answer it
+  std::string request;
+
+  while (request.find("\r\n\r\n") == std::string::npos) {
+    BOOST_REQUIRE(WaitFor(peer, POLLIN));
+
+    char buffer[1024];
+    ssize_t n = read(peer, buffer, sizeof(buffer));
+    BOOST_REQUIRE(n > 0);
+    request.append(buffer, (size_t) n);
+  }
+
+  std::string const response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+  BOOST_REQUIRE(write(peer, response.c_str(), response.size()) == (ssize_t) response.size());
+
+  // receive the response
+  while (! client.isFinished()) {
+    BOOST_REQUIRE(WaitFor(fd, POLLIN));
+    client.processStep(0.0);
+  }
+
+  BOOST_CHECK_EQUAL(0, (int) request.find("GET /_api/version HTTP/1.1\r\n"));
+
+  SimpleHttpResult* result = client.finishRequest();
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK_EQUAL(true, result->isComplete());
+  BOOST_CHECK_EQUAL(200, result->getHttpReturnCode());
+  BOOST_CHECK_EQUAL("ok", std::string(result->getBody().c_str(), result->getBody().length()));
+  delete result;
+
+  close(peer);
+  close(server);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a refused non-blocking connect fails the request instead of being
+/// retried until the timeout
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_step_connect_refused) {
+  int port;
+  int server = Listen(port);
+
+  // nobody listens on the port anymore
+  close(server);
+
+  connectTo(port);
+
+  SimpleHttpClient client(connection, 5.0, false);
+  std::map<std::string, std::string> headers;
+
+  client.beginRequest(HttpRequest::HTTP_REQUEST_GET, "/_api/version", nullptr, 0, headers);
+  client.processStep(0.0);
+
+  if (! client.isFinished()) {
+    // the connect is in progress, its outcome shows up as writability
+    BOOST_CHECK_EQUAL(true, client.wantsWrite());
+    BOOST_REQUIRE(WaitFor(connection->getSocket().fileDescriptor, POLLOUT));
+    client.processStep(0.0);
+  }
+
+  BOOST_CHECK_EQUAL(true, client.isFinished());
+  BOOST_CHECK_EQUAL(false, client.needsConnect());
+  BOOST_CHECK_EQUAL(0, (int) client.getErrorMessage().find("Could not connect to"));
+
+  SimpleHttpResult* result = client.finishRequest();
+  BOOST_REQUIRE(result != nullptr);
+  BOOST_CHECK_EQUAL(false, result->isComplete());
+  delete result;
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+#endif
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
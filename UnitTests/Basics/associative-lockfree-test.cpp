@@ -0,0 +1,317 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for TRI_associative_lockfree_t
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include <boost/test/unit_test.hpp>
+
+#include <thread>
+#include <vector>
+
+#include "Basics/associative.h"
+#include "Basics/hashes.h"
+#include "Basics/tri-strings.h"
+#include "Basics/conversions.h"
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    private macros
+// -----------------------------------------------------------------------------
+
+#define INIT_ASSOC \
+  TRI_associative_lockfree_t a1; \
+  TRI_InitAssociativeLockFree(&a1, TRI_CORE_MEM_ZONE, HashKey, HashElement, IsEqualKeyElement, IsEqualElementElement);
+
+#define DESTROY_ASSOC \
+  TRI_DestroyAssociativeLockFree(&a1);
+
+#define ELEMENT(name, k, v1, v2, v3) \
+  data_container_t name; \
+  name.key = k; \
+  name.a   = v1; \
+  name.b   = v2; \
+  name.c   = v3;
+
+typedef struct data_container_s {
+  char* key;
+  int a;
+  int b;
+  int c;
+}
+data_container_t;
+
+uint64_t HashKey (TRI_associative_lockfree_t* a, void const* key) {
+  return TRI_FnvHashString((char const*) key);
+}
+
+uint64_t HashElement (TRI_associative_lockfree_t* a, void const* e) {
+  data_container_s* element = (data_container_s*) e;
+
+  return TRI_FnvHashString(element->key);
+}
+
+bool IsEqualKeyElement (TRI_associative_lockfree_t* a, void const* k, void const* r) {
+  data_container_s* element = (data_container_s*) r;
+
+  return TRI_EqualString((char*) k, element->key);
+}
+
+bool IsEqualElementElement (TRI_associative_lockfree_t* a, void const* l, void const* r) {
+  data_container_s* left = (data_container_s*) l;
+  data_container_s* right = (data_container_s*) r;
+
+  return TRI_EqualString(left->key, right->key);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an element with key "test<i>"
+////////////////////////////////////////////////////////////////////////////////
+
+static data_container_t* CreateElement (size_t i) {
+  char key[40];
+  char* num = TRI_StringUInt32((uint32_t) i);
+
+  memset(&key, 0, sizeof(key));
+  strcpy(key, "test");
+  strcat(key, num);
+  TRI_FreeString(TRI_CORE_MEM_ZONE, num);
+
+  data_container_t* e = (data_container_t*) TRI_Allocate(TRI_CORE_MEM_ZONE, sizeof(data_container_t), false);
+  e->key = TRI_DuplicateString(key);
+  e->a = (int) i;
+  e->b = (int) i + 1;
+  e->c = (int) i + 2;
+
+  return e;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free all elements contained in the array
+////////////////////////////////////////////////////////////////////////////////
+
+static void FreeElements (TRI_associative_lockfree_t* a) {
+  TRI_associative_lockfree_table_t const* table = a->_table.load();
+
+  for (uint64_t i = 0; i < table->_nrAlloc; ++i) {
+    data_container_t* s = (data_container_t*) table->_slots[i].load();
+
+    if (s) {
+      // free element memory
+      TRI_FreeString(TRI_CORE_MEM_ZONE, s->key);
+      TRI_Free(TRI_CORE_MEM_ZONE, s);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 setup / tear-down
+// -----------------------------------------------------------------------------
+
+struct CAssociativeLockFreeSetup {
+  CAssociativeLockFreeSetup () {
+  }
+
+  ~CAssociativeLockFreeSetup () {
+  }
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        test suite
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief setup
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_FIXTURE_TEST_SUITE(CAssociativeLockFreeTest, CAssociativeLockFreeSetup)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test initialisation
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_init) {
+  INIT_ASSOC
+
+  BOOST_CHECK_EQUAL((size_t) 0, TRI_GetLengthAssociativeLockFree(&a1));
+
+  DESTROY_ASSOC
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test non-unique insertion
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_insert_key_nonunique) {
+  INIT_ASSOC
+
+  void* r = 0;
+
+  ELEMENT(e1, (char*) "test1", 1, 2, 3)
+  BOOST_CHECK_EQUAL(r, TRI_InsertKeyAssociativeLockFree(&a1, e1.key, &e1, false));
+  BOOST_CHECK_EQUAL((size_t) 1, TRI_GetLengthAssociativeLockFree(&a1));
+  BOOST_CHECK_EQUAL(&e1, TRI_LookupByKeyAssociativeLockFree(&a1, "test1"));
+
+  ELEMENT(e2, (char*) "test1", 2, 3, 4)
+  BOOST_CHECK_EQUAL(&e1, TRI_InsertKeyAssociativeLockFree(&a1, e2.key, &e2, false));
+  BOOST_CHECK_EQUAL((size_t) 1, TRI_GetLengthAssociativeLockFree(&a1));
+  BOOST_CHECK_EQUAL(&e1, TRI_LookupByKeyAssociativeLockFree(&a1, "test1"));
+
+  ELEMENT(e3, (char*) "test2", 99, 3, 5)
+  BOOST_CHECK_EQUAL(r, TRI_InsertElementAssociativeLockFree(&a1, &e3, false));
+  BOOST_CHECK_EQUAL((size_t) 2, TRI_GetLengthAssociativeLockFree(&a1));
+  BOOST_CHECK_EQUAL(&e3, TRI_LookupByKeyAssociativeLockFree(&a1, "test2"));
+  BOOST_CHECK_EQUAL(&e3, TRI_LookupByElementAssociativeLockFree(&a1, &e3));
+
+  BOOST_CHECK_EQUAL(r, TRI_LookupByKeyAssociativeLockFree(&a1, "test3"));
+
+  DESTROY_ASSOC
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test overwriting an existing element
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_insert_overwrite) {
+  INIT_ASSOC
+
+  void* r = 0;
+
+  ELEMENT(e1, (char*) "test1", 1, 2, 3)
+  BOOST_CHECK_EQUAL(r, TRI_InsertKeyAssociativeLockFree(&a1, e1.key, &e1, true));
+
+  ELEMENT(e2, (char*) "test1", 2, 3, 4)
+  BOOST_CHECK_EQUAL(&e1, TRI_InsertKeyAssociativeLockFree(&a1, e2.key, &e2, true));
+  BOOST_CHECK_EQUAL((size_t) 1, TRI_GetLengthAssociativeLockFree(&a1));
+  BOOST_CHECK_EQUAL(&e2, TRI_LookupByKeyAssociativeLockFree(&a1, "test1"));
+
+  ELEMENT(e3, (char*) "test1", 5, 6, 7)
+  BOOST_CHECK_EQUAL(&e2, TRI_InsertElementAssociativeLockFree(&a1, &e3, true));
+  BOOST_CHECK_EQUAL((size_t) 1, TRI_GetLengthAssociativeLockFree(&a1));
+  BOOST_CHECK_EQUAL(&e3, TRI_LookupByKeyAssociativeLockFree(&a1, "test1"));
+
+  DESTROY_ASSOC
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test mass insertion
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_mass_insert) {
+  INIT_ASSOC
+
+  void* r = 0;
+
+  for (size_t i = 1; i <= 1000; ++i) {
+    data_container_t* e = CreateElement(i);
+
+    BOOST_CHECK_EQUAL(r, TRI_InsertKeyAssociativeLockFree(&a1, e->key, e, false));
+    BOOST_CHECK_EQUAL(i, TRI_GetLengthAssociativeLockFree(&a1));
+  }
+
+  for (size_t i = 1; i <= 1000; ++i) {
+    char* num = TRI_StringUInt32((uint32_t) i);
+    std::string key = std::string("test") + num;
+    TRI_FreeString(TRI_CORE_MEM_ZONE, num);
+
+    data_container_t* s = (data_container_t*) TRI_LookupByKeyAssociativeLockFree(&a1, key.c_str());
+    BOOST_REQUIRE(s);
+    BOOST_CHECK_EQUAL((size_t) i, (size_t) s->a);
+    BOOST_CHECK_EQUAL(key, s->key);
+  }
+
+  FreeElements(&a1);
+
+  DESTROY_ASSOC
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test lookups running concurrently with inserts and resizes
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_concurrent_lookup) {
+  INIT_ASSOC
+
+  size_t const n = 20000;
+  std::vector<data_container_t*> elements;
+
+  for (size_t i = 1; i <= n; ++i) {
+    elements.push_back(CreateElement(i));
+  }
+
+  std::atomic<size_t> inserted(0);
+  std::atomic<size_t> errors(0);
+
+  std::vector<std::thread> readers;
+
+  for (size_t t = 0; t < 4; ++t) {
+    readers.emplace_back([&] () -> void {
+      size_t done;
+
+      do {
+        done = inserted.load();
+
+        // everything inserted so far must be visible to this reader
+        for (size_t i = 0; i < done; i += 7) {
+          data_container_t const* s = (data_container_t const*) TRI_LookupByKeyAssociativeLockFree(&a1, elements[i]->key);
+
+          if (s != elements[i]) {
+            ++errors;
+          }
+        }
+      }
+      while (done < n);
+    });
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    TRI_InsertKeyAssociativeLockFree(&a1, elements[i]->key, elements[i], false);
+    inserted.store(i + 1);
+  }
+
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  BOOST_CHECK_EQUAL((size_t) 0, errors.load());
+  BOOST_CHECK_EQUAL(n, TRI_GetLengthAssociativeLockFree(&a1));
+
+  FreeElements(&a1);
+
+  DESTROY_ASSOC
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generate tests
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_SUITE_END ()
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
+// End:
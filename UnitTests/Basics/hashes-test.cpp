@@ -423,6 +423,68 @@ BOOST_AUTO_TEST_CASE (tst_crc32_utf8) {
   BOOST_CHECK_EQUAL((uint64_t) 2590070434ULL,   TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), buffer.c_str(), strlen(buffer.c_str()))));
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test crc32c for simple strings
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c_simple) {
+  std::string buffer;
+
+  buffer = "";
+  BOOST_CHECK_EQUAL((uint64_t) 0ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+  BOOST_CHECK_EQUAL((uint64_t) 0ULL, TRI_FinalCrc32(TRI_BlockCrc32CSoftware(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+
+  buffer = " ";
+  BOOST_CHECK_EQUAL((uint64_t) 1925242255ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+  BOOST_CHECK_EQUAL((uint64_t) 1925242255ULL, TRI_FinalCrc32(TRI_BlockCrc32CSoftware(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+
+  buffer = "a";
+  BOOST_CHECK_EQUAL((uint64_t) 3251651376ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+  BOOST_CHECK_EQUAL((uint64_t) 3251651376ULL, TRI_FinalCrc32(TRI_BlockCrc32CSoftware(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+
+  buffer = "A";
+  BOOST_CHECK_EQUAL((uint64_t) 3782069742ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+  BOOST_CHECK_EQUAL((uint64_t) 3782069742ULL, TRI_FinalCrc32(TRI_BlockCrc32CSoftware(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+
+  buffer = "123456789";
+  BOOST_CHECK_EQUAL((uint64_t) 3808858755ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+  BOOST_CHECK_EQUAL((uint64_t) 3808858755ULL, TRI_FinalCrc32(TRI_BlockCrc32CSoftware(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+
+
+  buffer = "The Quick Brown Fox Jumped Over The Lazy Dog";
+  BOOST_CHECK_EQUAL((uint64_t) 4053635637ULL, TRI_Crc32CHashPointer(buffer.c_str(), buffer.size()));
+  BOOST_CHECK_EQUAL((uint64_t) 4053635637ULL, TRI_FinalCrc32(TRI_BlockCrc32CSoftware(TRI_InitialCrc32(), buffer.c_str(), buffer.size())));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test crc32c for unaligned blocks of different lengths
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_crc32c_unaligned) {
+  std::string buffer;
+
+  for (size_t i = 0; i < 1024; ++i) {
+    buffer.push_back(static_cast<char>((i * 7919) & 0xff));
+  }
+
+  for (size_t offset = 0; offset < 16; ++offset) {
+    for (size_t length = 0; length < 64; ++length) {
+      char const* data = buffer.c_str() + offset;
+
+      BOOST_CHECK_EQUAL(TRI_BlockCrc32CSoftware(TRI_InitialCrc32(), data, length), TRI_BlockCrc32C(TRI_InitialCrc32(), data, length));
+    }
+
+    char const* data = buffer.c_str() + offset;
+    size_t length = buffer.size() - offset;
+
+    BOOST_CHECK_EQUAL(TRI_BlockCrc32CSoftware(TRI_InitialCrc32(), data, length), TRI_BlockCrc32C(TRI_InitialCrc32(), data, length));
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
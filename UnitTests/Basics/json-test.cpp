@@ -28,6 +28,7 @@
 #include <boost/test/unit_test.hpp>
 
 #include "Basics/json.h"
+#include "Basics/JsonHelper.h"
 #include "Basics/string-buffer.h"
 
 // -----------------------------------------------------------------------------
@@ -614,6 +615,64 @@ BOOST_AUTO_TEST_CASE (tst_json_array_keys_utf8) {
   FREE_BUFFER
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test binary representation round trip
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_json_binary_roundtrip) {
+  INIT_BUFFER
+
+  TRI_json_t* json = TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE);
+  TRI_json_t* list = TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE);
+  TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, list, TRI_CreateNullJson(TRI_UNKNOWN_MEM_ZONE));
+  TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, list, TRI_CreateBooleanJson(TRI_UNKNOWN_MEM_ZONE, true));
+  TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, list, TRI_CreateNumberJson(TRI_UNKNOWN_MEM_ZONE, -1.5));
+  TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, list, TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, "", 0));
+  TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "list", list);
+  TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "number", TRI_CreateNumberJson(TRI_UNKNOWN_MEM_ZONE, 1234567890123.0));
+  TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "string", TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, "the fox", 7));
+  TRI_Insert3ObjectJson(TRI_UNKNOWN_MEM_ZONE, json, "empty", TRI_CreateObjectJson(TRI_UNKNOWN_MEM_ZONE));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  triagens::basics::JsonHelper::toBinary(json, buffer);
+
+  char const* position = buffer.begin();
+  char const* end = position + buffer.length();
+  TRI_json_t* copy = triagens::basics::JsonHelper::fromBinary(position, end);
+
+  BOOST_REQUIRE(copy != nullptr);
+  BOOST_CHECK(position == end);
+
+  std::string expected(triagens::basics::JsonHelper::toString(json));
+  FREE_JSON
+  json = copy;
+
+  STRINGIFY
+  BOOST_CHECK_EQUAL(expected, STRING_VALUE);
+  FREE_JSON
+  FREE_BUFFER
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test truncated binary representation
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_json_binary_truncated) {
+  TRI_json_t* json = TRI_CreateArrayJson(TRI_UNKNOWN_MEM_ZONE);
+  TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, json, TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, "foobar", 6));
+  TRI_PushBack3ArrayJson(TRI_UNKNOWN_MEM_ZONE, json, TRI_CreateNumberJson(TRI_UNKNOWN_MEM_ZONE, 42.0));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE);
+  triagens::basics::JsonHelper::toBinary(json, buffer);
+
+  for (size_t length = 0; length < buffer.length(); ++length) {
+    char const* position = buffer.begin();
+    BOOST_CHECK(triagens::basics::JsonHelper::fromBinary(position, buffer.begin() + length) == nullptr);
+  }
+
+  FREE_JSON
+}
+
 // TODO: add tests for lookup json array value etc.
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -439,6 +439,80 @@ BOOST_AUTO_TEST_CASE (tst_unique_remove_all) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bulk loading
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_unique_bulk) {
+  triagens::basics::SkipList skiplist(CmpElmElm, CmpKeyElm, nullptr, FreeElm, true);
+  
+  std::vector<void*> values; 
+  for (int i = 0; i < 1000; ++i) {
+    values.push_back(new int(i));
+  }
+  
+  BOOST_CHECK_EQUAL(0, skiplist.bulkInsert(values.data(), values.size()));
+
+  BOOST_CHECK_EQUAL(1000, skiplist.getNrUsed());
+
+  // check start node
+  BOOST_CHECK_EQUAL((void*) 0, skiplist.startNode()->prevNode());
+  BOOST_CHECK_EQUAL(values[0], skiplist.startNode()->nextNode()->document());
+
+  // do a forward iteration
+  triagens::basics::SkipListNode* current = skiplist.startNode()->nextNode();
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(values[i], current->document());
+
+    if (i > 0) {
+      BOOST_CHECK_EQUAL(values[i - 1], current->prevNode()->document());
+    }
+    current = current->nextNode();
+  }
+  BOOST_CHECK_EQUAL((void*) 0, current);
+
+  for (int i = 0; i < 1000; ++i) {
+    BOOST_CHECK_EQUAL(values[i], skiplist.lookup(values[i])->document());
+  }
+  
+  // the bulk-loaded list must be fully usable afterwards
+  int value = 1000;
+  BOOST_CHECK_EQUAL(0, skiplist.insert(&value));
+  BOOST_CHECK_EQUAL(0, skiplist.remove(&value));
+  BOOST_CHECK_EQUAL(0, skiplist.remove(values[500]));
+  BOOST_CHECK_EQUAL((void*) 0, skiplist.lookup(values[500]));
+  BOOST_CHECK_EQUAL(999, skiplist.getNrUsed());
+    
+  // clean up
+  for (auto i : values) {
+    delete static_cast<int*>(i);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test bulk loading with duplicate values
+////////////////////////////////////////////////////////////////////////////////
+
+BOOST_AUTO_TEST_CASE (tst_unique_bulk_duplicate) {
+  triagens::basics::SkipList skiplist(CmpElmElm, CmpKeyElm, nullptr, FreeElm, true);
+  
+  std::vector<void*> values; 
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(new int(i == 50 ? 49 : i));
+  }
+  
+  BOOST_CHECK_EQUAL(TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED, skiplist.bulkInsert(values.data(), values.size()));
+
+  // nothing must have been inserted
+  BOOST_CHECK_EQUAL(0, skiplist.getNrUsed());
+  BOOST_CHECK_EQUAL((void*) 0, skiplist.startNode()->nextNode());
+    
+  // clean up
+  for (auto i : values) {
+    delete static_cast<int*>(i);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief generate tests
 ////////////////////////////////////////////////////////////////////////////////
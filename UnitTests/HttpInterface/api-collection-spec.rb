@@ -323,6 +323,11 @@ describe ArangoDB do
         doc.parsed_response['figures']['compactors']['count'].should be_kind_of(Integer)
         doc.parsed_response['figures']['compactors']['fileSize'].should be_kind_of(Integer)
         doc.parsed_response['figures']['compactors']['count'].should eq(0)
+        doc.parsed_response['figures']['compaction']['backlogCount'].should eq(0)
+        doc.parsed_response['figures']['compaction']['backlogSize'].should eq(0)
+        doc.parsed_response['figures']['compaction']['runs'].should be_kind_of(Integer)
+        doc.parsed_response['figures']['compaction']['bytesRead'].should be_kind_of(Integer)
+        doc.parsed_response['figures']['compaction']['bytesWritten'].should be_kind_of(Integer)
         doc.parsed_response['figures']['shapefiles']['count'].should be_kind_of(Integer)
         doc.parsed_response['figures']['shapefiles']['fileSize'].should be_kind_of(Integer)
         doc.parsed_response['figures']['shapefiles']['count'].should eq(0)
@@ -223,6 +223,142 @@ describe ArangoDB do
         doc.parsed_response['id'].should match(@reId)
       end
 
+      it "creates a streaming cursor single run" do
+        cmd = api
+        body = "{ \"query\" : \"FOR u IN #{@cn} LIMIT 2 RETURN u.n\", \"batchSize\" : 5, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-create-stream-single", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(201)
+        doc.parsed_response['id'].should be_nil
+        doc.parsed_response['hasMore'].should eq(false)
+        doc.parsed_response['count'].should eq(nil)
+        doc.parsed_response['result'].length.should eq(2)
+        doc.parsed_response['extra'].should have_key('stats')
+      end
+
+      it "creates a streaming cursor" do
+        cmd = api
+        body = "{ \"query\" : \"FOR u IN #{@cn} SORT u.n LIMIT 5 RETURN u.n\", \"batchSize\" : 2, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-create-stream", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(201)
+        doc.parsed_response['id'].should be_kind_of(String)
+        doc.parsed_response['id'].should match(@reId)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['count'].should eq(nil)
+        doc.parsed_response['result'].should eq([ 0, 1 ])
+        doc.parsed_response['extra'].should be_nil
+
+        id = doc.parsed_response['id']
+
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_put("#{prefix}-create-stream-cont", cmd)
+        
+        doc.code.should eq(200)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(200)
+        doc.parsed_response['id'].should eq(id)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['result'].should eq([ 2, 3 ])
+        doc.parsed_response['extra'].should be_nil
+
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_put("#{prefix}-create-stream-cont2", cmd)
+        
+        doc.code.should eq(200)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(200)
+        doc.parsed_response['id'].should be_nil
+        doc.parsed_response['hasMore'].should eq(false)
+        doc.parsed_response['result'].should eq([ 4 ])
+        doc.parsed_response['extra'].should have_key('stats')
+        doc.parsed_response['extra']['warnings'].should eq([ ])
+
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_put("#{prefix}-create-stream-cont3", cmd)
+        
+        doc.code.should eq(404)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(1600)
+        doc.parsed_response['code'].should eq(404)
+      end
+
+      it "creates a streaming cursor returning documents" do
+        cmd = api
+        body = "{ \"query\" : \"FOR u IN #{@cn} SORT u.n LIMIT 3 RETURN u\", \"batchSize\" : 2, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-create-stream-documents", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['result'].length.should eq(2)
+
+        doc.parsed_response['result'].each_with_index { |d, i|
+          d['n'].should eq(i)
+          d['_id'].should eq("#{@cn}/#{d['_key']}")
+          d['_key'].should be_kind_of(String)
+          d['_rev'].should be_kind_of(String)
+          d.length.should eq(4)
+        }
+      end
+
+      it "creates a streaming cursor with count" do
+        cmd = api
+        body = "{ \"query\" : \"FOR u IN #{@cn} LIMIT 5 RETURN u.n\", \"count\" : true, \"batchSize\" : 2, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-create-stream-count", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(201)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['count'].should eq(5)
+        doc.parsed_response['result'].length.should eq(2)
+      end
+
+      it "creates a streaming cursor and deletes it in the middle" do
+        cmd = api
+        body = "{ \"query\" : \"FOR u IN #{@cn} RETURN u.n\", \"batchSize\" : 2, \"options\" : { \"stream\" : true } }"
+        doc = ArangoDB.log_post("#{prefix}-create-stream-delete", cmd, :body => body)
+        
+        doc.code.should eq(201)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(201)
+        doc.parsed_response['id'].should be_kind_of(String)
+        doc.parsed_response['id'].should match(@reId)
+        doc.parsed_response['hasMore'].should eq(true)
+        doc.parsed_response['result'].length.should eq(2)
+
+        id = doc.parsed_response['id']
+
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_delete("#{prefix}-create-stream-delete", cmd)
+
+        doc.code.should eq(202)
+        doc.headers['content-type'].should eq("application/json; charset=utf-8")
+        doc.parsed_response['error'].should eq(false)
+        doc.parsed_response['code'].should eq(202)
+        doc.parsed_response['id'].should eq(id)
+        
+        cmd = api + "/#{id}"
+        doc = ArangoDB.log_put("#{prefix}-create-stream-delete-cont", cmd)
+        
+        doc.code.should eq(404)
+        doc.parsed_response['error'].should eq(true)
+        doc.parsed_response['errorNum'].should eq(1600)
+      end
+
       it "deleting a cursor" do
         cmd = api
         body = "{ \"query\" : \"FOR u IN #{@cn} LIMIT 5 RETURN u.n\", \"count\" : true, \"batchSize\" : 2 }"
@@ -0,0 +1,102 @@
+# coding: utf-8
+
+require 'rspec'
+require 'arangodb.rb'
+require 'json'
+
+describe ArangoDB do
+  api = "/_api/query/plan-cache"
+  prefix = "api-query-plan-cache"
+
+  context "dealing with the query plan cache:" do
+
+    before do
+      @cn = "UnitTestsQueryPlanCache"
+      ArangoDB.drop_collection(@cn)
+      @cid = ArangoDB.create_collection(@cn, false)
+
+      ArangoDB.log_put("#{prefix}", api, :body => JSON.dump({ enabled: true, maxEntries: 128 }))
+      ArangoDB.log_delete("#{prefix}", api)
+    end
+
+    after do
+      ArangoDB.log_put("#{prefix}", api, :body => JSON.dump({ enabled: false }))
+      ArangoDB.drop_collection(@cn)
+    end
+
+    def run_query (query, bindVars = { })
+      body = JSON.dump({ query: query, bindVars: bindVars })
+      doc = ArangoDB.log_post("#{prefix}-cursor", "/_api/cursor", :body => body)
+      doc.code.should eq(201)
+      doc
+    end
+
+    def cache_properties ()
+      doc = ArangoDB.log_get("#{prefix}", api)
+      doc.code.should eq(200)
+      doc
+    end
+
+    it "returns the properties" do
+      doc = cache_properties()
+      doc.parsed_response['enabled'].should eq(true)
+      doc.parsed_response['maxEntries'].should eq(128)
+      doc.parsed_response['entries'].should eq(0)
+      doc.parsed_response['hits'].should be_kind_of(Integer)
+      doc.parsed_response['misses'].should be_kind_of(Integer)
+    end
+
+    it "reuses the plan of a repeated query" do
+      query = "FOR i IN #{@cn} FILTER i.value == @value RETURN i"
+      hits = cache_properties().parsed_response['hits']
+
+      run_query(query, { value: 1 })
+      cache_properties().parsed_response['entries'].should eq(1)
+
+      doc = run_query(query, { value: 1 })
+      doc.parsed_response['result'].should eq([ ])
+      cache_properties().parsed_response['hits'].should eq(hits + 1)
+
+      # different bind parameter values produce a different plan
+      run_query(query, { value: 2 })
+      cache_properties().parsed_response['entries'].should eq(2)
+    end
+
+    it "invalidates plans when an index is created" do
+      query = "FOR i IN #{@cn} FILTER i.value == 1 RETURN i"
+      run_query(query)
+      cache_properties().parsed_response['entries'].should eq(1)
+
+      body = JSON.dump({ type: "hash", fields: [ "value" ] })
+      doc = ArangoDB.log_post("#{prefix}-index", "/_api/index?collection=#{@cn}", :body => body)
+      doc.code.should eq(201)
+
+      cache_properties().parsed_response['entries'].should eq(0)
+    end
+
+    it "keeps plans when a collection is loaded" do
+      query = "FOR i IN #{@cn} FILTER i.value == 1 RETURN i"
+      run_query(query)
+      cache_properties().parsed_response['entries'].should eq(1)
+
+      doc = ArangoDB.log_put("#{prefix}-unload", "/_api/collection/#{@cn}/unload", :body => "")
+      doc.code.should eq(200)
+
+      doc = ArangoDB.log_put("#{prefix}-load", "/_api/collection/#{@cn}/load", :body => "")
+      doc.code.should eq(200)
+      doc.parsed_response['status'].should eq(3)
+
+      cache_properties().parsed_response['entries'].should eq(1)
+    end
+
+    it "does not cache plans when disabled" do
+      doc = ArangoDB.log_put("#{prefix}", api, :body => JSON.dump({ enabled: false }))
+      doc.code.should eq(200)
+      doc.parsed_response['enabled'].should eq(false)
+
+      run_query("FOR i IN #{@cn} RETURN i")
+      cache_properties().parsed_response['entries'].should eq(0)
+    end
+
+  end
+end
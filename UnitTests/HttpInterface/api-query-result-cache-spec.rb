@@ -0,0 +1,110 @@
+# coding: utf-8
+
+require 'rspec'
+require 'arangodb.rb'
+require 'json'
+
+describe ArangoDB do
+  api = "/_api/query/result-cache"
+  prefix = "api-query-result-cache"
+
+  context "dealing with the query result cache:" do
+
+    before do
+      @cn = "UnitTestsQueryResultCache"
+      ArangoDB.drop_collection(@cn)
+      @cid = ArangoDB.create_collection(@cn, false)
+
+      ArangoDB.log_put("#{prefix}", api, :body => JSON.dump({ enabled: true, maxEntries: 128 }))
+      ArangoDB.log_delete("#{prefix}", api)
+    end
+
+    after do
+      ArangoDB.log_put("#{prefix}", api, :body => JSON.dump({ enabled: false }))
+      ArangoDB.drop_collection(@cn)
+    end
+
+    def run_query (query, bindVars = { }, options = { })
+      body = JSON.dump({ query: query, bindVars: bindVars, options: options })
+      doc = ArangoDB.log_post("#{prefix}-cursor", "/_api/cursor", :body => body)
+      doc.code.should eq(201)
+      doc
+    end
+
+    def cache_properties ()
+      doc = ArangoDB.log_get("#{prefix}", api)
+      doc.code.should eq(200)
+      doc
+    end
+
+    it "returns the properties" do
+      doc = cache_properties()
+      doc.parsed_response['enabled'].should eq(true)
+      doc.parsed_response['maxEntries'].should eq(128)
+      doc.parsed_response['maxResultSize'].should be_kind_of(Integer)
+      doc.parsed_response['maxMemory'].should be_kind_of(Integer)
+      doc.parsed_response['entries'].should eq(0)
+      doc.parsed_response['memory'].should eq(0)
+      doc.parsed_response['hits'].should be_kind_of(Integer)
+      doc.parsed_response['misses'].should be_kind_of(Integer)
+    end
+
+    it "returns the cached result of a repeated query" do
+      query = "FOR i IN #{@cn} FILTER i.value == @value RETURN i.value"
+      ArangoDB.log_post("#{prefix}-insert", "/_api/document?collection=#{@cn}", :body => JSON.dump({ value: 1 }))
+
+      doc = run_query(query, { value: 1 })
+      doc.parsed_response['result'].should eq([ 1 ])
+      doc.parsed_response['cached'].should eq(false)
+      cache_properties().parsed_response['entries'].should eq(1)
+
+      doc = run_query(query, { value: 1 })
+      doc.parsed_response['result'].should eq([ 1 ])
+      doc.parsed_response['cached'].should eq(true)
+
+      # different bind parameter values produce a different result
+      doc = run_query(query, { value: 2 })
+      doc.parsed_response['result'].should eq([ ])
+      doc.parsed_response['cached'].should eq(false)
+      cache_properties().parsed_response['entries'].should eq(2)
+    end
+
+    it "invalidates results when the collection is modified" do
+      query = "FOR i IN #{@cn} RETURN i.value"
+      run_query(query).parsed_response['result'].should eq([ ])
+      cache_properties().parsed_response['entries'].should eq(1)
+
+      doc = ArangoDB.log_post("#{prefix}-insert", "/_api/document?collection=#{@cn}", :body => JSON.dump({ value: 42 }))
+      doc.code.should eq(202)
+      cache_properties().parsed_response['entries'].should eq(0)
+
+      doc = run_query(query)
+      doc.parsed_response['result'].should eq([ 42 ])
+      doc.parsed_response['cached'].should eq(false)
+    end
+
+    it "does not cache non-deterministic or modifying queries" do
+      run_query("FOR i IN #{@cn} RETURN RAND()")
+      run_query("INSERT { value: 1 } INTO #{@cn}")
+      cache_properties().parsed_response['entries'].should eq(0)
+    end
+
+    it "does not use the cache if disabled for the query" do
+      query = "FOR i IN #{@cn} RETURN i"
+      run_query(query, { }, { cache: false })
+      cache_properties().parsed_response['entries'].should eq(0)
+    end
+
+    it "does not cache results when disabled" do
+      doc = ArangoDB.log_put("#{prefix}", api, :body => JSON.dump({ enabled: false }))
+      doc.code.should eq(200)
+      doc.parsed_response['enabled'].should eq(false)
+
+      run_query("FOR i IN #{@cn} RETURN i")
+      doc = run_query("FOR i IN #{@cn} RETURN i")
+      doc.parsed_response['cached'].should eq(false)
+      cache_properties().parsed_response['entries'].should eq(0)
+    end
+
+  end
+end
@@ -35,8 +35,27 @@ describe ArangoDB do
       doc.parsed_response.should have_key("historicLogfiles")
       doc.parsed_response.should have_key("reserveLogfiles")
       doc.parsed_response.should have_key("syncInterval")
+      doc.parsed_response.should have_key("syncCommitWindow")
+      doc.parsed_response.should have_key("syncCommitSize")
       doc.parsed_response.should have_key("throttleWait")
       doc.parsed_response.should have_key("throttleWhenPending")
+      doc.parsed_response.should have_key("syncStatistics")
+      doc.parsed_response["syncStatistics"].should have_key("syncs")
+      doc.parsed_response["syncStatistics"].should have_key("operations")
+      doc.parsed_response["syncStatistics"].should have_key("averageBatchSize")
+      doc.parsed_response["syncStatistics"].should have_key("maxBatchSize")
+      doc.parsed_response["syncStatistics"].should have_key("averageSyncTime")
+      doc.parsed_response["syncStatistics"].should have_key("maxSyncTime")
+      doc.parsed_response.should have_key("collectorStatistics")
+      doc.parsed_response["collectorStatistics"].should have_key("logfiles")
+      doc.parsed_response["collectorStatistics"].should have_key("collections")
+      doc.parsed_response["collectorStatistics"].should have_key("operations")
+      doc.parsed_response["collectorStatistics"].should have_key("pendingOperations")
+      doc.parsed_response["collectorStatistics"].should have_key("averageCollectTime")
+      doc.parsed_response["collectorStatistics"].should have_key("maxCollectTime")
+      doc.parsed_response["collectorStatistics"].should have_key("lagLogfiles")
+      doc.parsed_response["collectorStatistics"].should have_key("lagBytes")
+      doc.parsed_response["collectorStatistics"].should have_key("lagTicks")
     end
 
 ################################################################################
@@ -51,6 +70,8 @@ describe ArangoDB do
         "logfileSize" => 1024 * 1024 * 8,
         "historicLogfiles" => 4,
         "reserveLogfiles" => 5,
+        "syncCommitWindow" => 0,
+        "syncCommitSize" => 32,
         "throttleWait" => 1000 * 10,
         "throttleWhenPending" => 1024 * 1024
       }
@@ -67,6 +88,10 @@ describe ArangoDB do
       doc.parsed_response.should have_key("reserveLogfiles")
       doc.parsed_response["reserveLogfiles"].should eq(5)
       doc.parsed_response.should have_key("syncInterval")
+      doc.parsed_response.should have_key("syncCommitWindow")
+      doc.parsed_response["syncCommitWindow"].should eq(0)
+      doc.parsed_response.should have_key("syncCommitSize")
+      doc.parsed_response["syncCommitSize"].should eq(32)
       doc.parsed_response.should have_key("throttleWait")
       doc.parsed_response["throttleWait"].should eq(1000 * 10)
       doc.parsed_response.should have_key("throttleWhenPending")
@@ -36,6 +36,12 @@ using JsonHelper = triagens::basics::JsonHelper;
 // --SECTION--                                                      AqlItemBlock
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief content type used to transfer AqlItemBlocks in the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+char const* const AqlItemBlock::BinaryContentType = "application/x-arango-aqlitems";
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                        constructors / destructors
 // -----------------------------------------------------------------------------
@@ -168,6 +174,119 @@ AqlItemBlock::AqlItemBlock (Json const& json) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the block from the binary format produced by toBinary,
+/// the position is advanced behind the block. note that this can throw
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock::AqlItemBlock (char const*& position,
+                            char const* end)
+  : _nrItems(0), _nrRegs(0) {
+
+  auto malformed = [] () {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL,
+                                   "malformed binary AqlItemBlock");
+  };
+
+  uint64_t value;
+  if (! JsonHelper::readBinaryLength(position, end, value) || value == 0) {
+    malformed();
+  }
+  size_t nrItems = static_cast<size_t>(value);
+
+  if (! JsonHelper::readBinaryLength(position, end, value)) {
+    malformed();
+  }
+  RegisterId nrRegs = static_cast<RegisterId>(value);
+
+  // Initialize the data vector:
+  if (nrRegs > 0) {
+    _data.reserve(nrItems * nrRegs);
+    for (size_t i = 0; i < nrItems * nrRegs; ++i) {
+      _data.emplace_back();
+    }
+    _docColls.reserve(nrRegs);
+    for (size_t i = 0; i < nrRegs; ++i) {
+      _docColls.emplace_back(nullptr);
+    }
+  }
+  _nrItems = nrItems;
+  _nrRegs = nrRegs;
+
+  std::vector<AqlValue> madeHere;
+  uint64_t emptyRun = 0;
+
+  try {
+    for (RegisterId column = 0; column < _nrRegs; column++) {
+      for (size_t i = 0; i < _nrItems; i++) {
+        if (emptyRun > 0) {
+          emptyRun--;
+          continue;
+        }
+
+        if (position >= end) {
+          malformed();
+        }
+
+        char tag = *position++;
+
+        if (tag == BinaryEmptyRun) {
+          if (! JsonHelper::readBinaryLength(position, end, emptyRun) || emptyRun == 0) {
+            malformed();
+          }
+          emptyRun--;
+        }
+        else if (tag == BinaryRange) {
+          uint64_t low, high;
+          if (! JsonHelper::readBinaryLength(position, end, low) ||
+              ! JsonHelper::readBinaryLength(position, end, high)) {
+            malformed();
+          }
+          AqlValue a(static_cast<int64_t>(low), static_cast<int64_t>(high));
+          try {
+            setValue(i, column, a);
+          }
+          catch (...) {
+            a.destroy();
+            throw;
+          }
+        }
+        else if (tag == BinaryValue) {
+          TRI_json_t* json = JsonHelper::fromBinary(position, end);
+          if (json == nullptr) {
+            malformed();
+          }
+          AqlValue a(new Json(TRI_UNKNOWN_MEM_ZONE, json));
+          try {
+            setValue(i, column, a);  // if this throws, a is destroyed again
+          }
+          catch (...) {
+            a.destroy();
+            throw;
+          }
+          madeHere.emplace_back(a);
+        }
+        else if (tag == BinaryReference) {
+          if (! JsonHelper::readBinaryLength(position, end, value) ||
+              value >= madeHere.size()) {
+            malformed();
+          }
+          setValue(i, column, madeHere[static_cast<size_t>(value)]);
+          // If this throws, all is OK, because it was already put into
+          // the block elsewhere.
+        }
+        else {
+          malformed();
+        }
+      }
+    }
+  }
+  catch (...) {
+    destroy();
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the block, used in the destructor and elsewhere
 ////////////////////////////////////////////////////////////////////////////////
@@ -553,6 +672,71 @@ Json AqlItemBlock::toJson (triagens::arango::AqlTransaction* trx) const {
   return json;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toBinary, transfer a whole AqlItemBlock to the binary format
+///
+/// The layout follows the one of toJson: the number of items and registers,
+/// followed by the registers column by column. Each entry starts with a tag
+/// byte: empty runs store their length, ranges their bounds, and values are
+/// either stored as binary json or refer to an earlier value of the block.
+////////////////////////////////////////////////////////////////////////////////
+
+void AqlItemBlock::toBinary (triagens::arango::AqlTransaction* trx,
+                             triagens::basics::StringBuffer& buffer) const {
+  JsonHelper::appendBinaryLength(buffer, _nrItems);
+  JsonHelper::appendBinaryLength(buffer, _nrRegs);
+
+  std::unordered_map<AqlValue, size_t> table;   // remember duplicates
+
+  size_t emptyCount = 0;  // here we count runs of empty AqlValues
+
+  auto commitEmpties = [&] () {  // this commits an empty run to the data
+    if (emptyCount > 0) {
+      buffer.appendChar(BinaryEmptyRun);
+      JsonHelper::appendBinaryLength(buffer, emptyCount);
+      emptyCount = 0;
+    }
+  };
+
+  for (RegisterId column = 0; column < _nrRegs; column++) {
+    for (size_t i = 0; i < _nrItems; i++) {
+      AqlValue const& a(_data[i * _nrRegs + column]);
+      if (a.isEmpty()) {
+        emptyCount++;
+      }
+      else {
+        commitEmpties();
+        if (a._type == AqlValue::RANGE) {
+          buffer.appendChar(BinaryRange);
+          JsonHelper::appendBinaryLength(buffer, static_cast<uint64_t>(a._range->_low));
+          JsonHelper::appendBinaryLength(buffer, static_cast<uint64_t>(a._range->_high));
+        }
+        else {
+          auto it = table.find(a);
+          if (it == table.end()) {
+            buffer.appendChar(BinaryValue);
+            if (a._type == AqlValue::JSON) {
+              // no need to copy the value first
+              JsonHelper::toBinary(a._json->json(), buffer);
+            }
+            else {
+              Json json(a.toJson(trx, _docColls[column]));
+              JsonHelper::toBinary(json.json(), buffer);
+            }
+            table.emplace(std::make_pair(a, table.size()));
+          }
+          else {
+            buffer.appendChar(BinaryReference);
+            JsonHelper::appendBinaryLength(buffer, it->second);
+          }
+        }
+      }
+    }
+  }
+  commitEmpties();
+}
+
+
 // Local Variables:
 // mode: outline-minor
 // outline-regexp: "^\\(/// @brief\\|/// {@inheritDoc}\\|/// @addtogroup\\|// --SECTION--\\|/// @\\}\\)"
@@ -77,6 +77,9 @@ namespace triagens {
 
         AqlItemBlock (triagens::basics::Json const& json);
 
+        AqlItemBlock (char const*& position,
+                      char const* end);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the block
 ////////////////////////////////////////////////////////////////////////////////
@@ -332,12 +335,43 @@ namespace triagens {
 
         triagens::basics::Json toJson (triagens::arango::AqlTransaction* trx) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toBinary, append a whole AqlItemBlock to the buffer in the binary
+/// format, the result can be used to recreate the AqlItemBlock via the
+/// binary constructor. Numbers and strings are transferred without text
+/// conversion
+////////////////////////////////////////////////////////////////////////////////
+
+        void toBinary (triagens::arango::AqlTransaction* trx,
+                       triagens::basics::StringBuffer& buffer) const;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public variables
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief content type used to transfer AqlItemBlocks in the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+        static char const* const BinaryContentType;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
 
       private:
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tags of the entries in the binary format
+////////////////////////////////////////////////////////////////////////////////
+
+        static char const BinaryEmptyRun  = 0;
+        static char const BinaryRange     = 1;
+        static char const BinaryValue     = 2;
+        static char const BinaryReference = 3;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief _data, the actual data as a single vector of dimensions _nrItems
 /// times _nrRegs
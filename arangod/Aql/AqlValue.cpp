@@ -28,6 +28,8 @@
 #include "Aql/AqlValue.h"
 #include "Aql/AqlItemBlock.h"
 #include "Basics/json-utilities.h"
+#include "Basics/string-buffer.h"
+#include "Utils/DocumentHelper.h"
 #include "V8/v8-conv.h"
 #include "V8Server/v8-wrapshapedjson.h"
 #include "VocBase/voc-shaper.h"
@@ -701,6 +703,77 @@ Json AqlValue::toJson (triagens::arango::AqlTransaction* trx,
   THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringify the value into a string buffer
+////////////////////////////////////////////////////////////////////////////////
+
+void AqlValue::stringify (triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* document,
+                          TRI_string_buffer_t* buffer) const {
+  int res = TRI_ERROR_NO_ERROR;
+
+  switch (_type) {
+    case JSON: {
+      TRI_ASSERT(_json != nullptr);
+      res = TRI_StringifyJson(buffer, _json->json());
+      break;
+    }
+
+    case SHAPED: {
+      TRI_ASSERT(document != nullptr);
+      TRI_ASSERT(_marker != nullptr);
+
+      res = triagens::arango::DocumentHelper::stringifyDocument(buffer, 
+                                                                 trx->resolver(),
+                                                                 document->_info._cid,
+                                                                 document->getShaper(),
+                                                                 _marker);
+      break;
+    }
+          
+    case DOCVEC: {
+      TRI_ASSERT(_vector != nullptr);
+
+      res = TRI_AppendCharStringBuffer(buffer, '[');
+      bool first = true;
+
+      for (auto it = _vector->begin(); it != _vector->end(); ++it) {
+        auto current = (*it);
+        size_t const n = current->size();
+        auto vecCollection = current->getDocumentCollection(0);
+        for (size_t i = 0; i < n; ++i) {
+          if (! first && 
+              TRI_AppendCharStringBuffer(buffer, ',') != TRI_ERROR_NO_ERROR) {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+          }
+          first = false;
+          current->getValueReference(i, 0).stringify(trx, vecCollection, buffer);
+        }
+      }
+
+      if (res == TRI_ERROR_NO_ERROR) {
+        res = TRI_AppendCharStringBuffer(buffer, ']');
+      }
+      break;
+    }
+          
+    case RANGE: {
+      Json json(toJson(trx, document));
+      res = TRI_StringifyJson(buffer, json.json());
+      break;
+    }
+
+    case EMPTY: {
+      res = TRI_AppendString2StringBuffer(buffer, "null", 4); // strlen("null")
+      break;
+    }
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief extract an attribute value from the AqlValue 
 /// this will return an empty Json if the value is not an object
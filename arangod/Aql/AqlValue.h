@@ -276,6 +276,15 @@ namespace triagens {
       triagens::basics::Json toJson (triagens::arango::AqlTransaction*,
                                      TRI_document_collection_t const*) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringify the value into a string buffer. documents (SHAPED) are
+/// written directly from their markers, without creating a JSON object
+////////////////////////////////////////////////////////////////////////////////
+
+      void stringify (triagens::arango::AqlTransaction*,
+                      TRI_document_collection_t const*,
+                      struct TRI_string_buffer_s*) const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief extract an attribute value from the AqlValue 
 /// this will return null if the value is not an object
@@ -1177,7 +1177,9 @@ bool AstNode::isSimple () const {
 
   if (type == NODE_TYPE_OBJECT_ELEMENT || 
       type == NODE_TYPE_ATTRIBUTE_ACCESS ||
-      type == NODE_TYPE_OPERATOR_UNARY_NOT) {
+      type == NODE_TYPE_OPERATOR_UNARY_NOT ||
+      type == NODE_TYPE_OPERATOR_UNARY_PLUS ||
+      type == NODE_TYPE_OPERATOR_UNARY_MINUS) {
     TRI_ASSERT(numMembers() == 1);
 
     if (! getMember(0)->isSimple()) {
@@ -1195,11 +1197,29 @@ bool AstNode::isSimple () const {
     auto func = static_cast<Function*>(getData());
     TRI_ASSERT(func != nullptr);
 
-    if (func->implementation == nullptr || ! getMember(0)->isSimple()) {
+    auto args = getMember(0);
+
+    if (! func->hasImplementation(args)) {
       setFlag(DETERMINED_SIMPLE);
       return false;
     }
 
+    size_t const n = args->numMembers();
+    for (size_t i = 0; i < n; ++i) {
+      auto member = args->getMember(i);
+
+      if (member->type == NODE_TYPE_COLLECTION &&
+          func->getArgumentConversion(i) != Function::CONVERSION_NONE) {
+        // collection parameters are passed to the function as collection names
+        continue;
+      }
+
+      if (! member->isSimple()) {
+        setFlag(DETERMINED_SIMPLE);
+        return false;
+      }
+    }
+
     setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
     return true;
   }
@@ -1214,11 +1234,19 @@ bool AstNode::isSimple () const {
       type == NODE_TYPE_OPERATOR_BINARY_GE ||
       type == NODE_TYPE_OPERATOR_BINARY_IN ||
       type == NODE_TYPE_OPERATOR_BINARY_NIN ||
+      type == NODE_TYPE_OPERATOR_BINARY_PLUS ||
+      type == NODE_TYPE_OPERATOR_BINARY_MINUS ||
+      type == NODE_TYPE_OPERATOR_BINARY_TIMES ||
+      type == NODE_TYPE_OPERATOR_BINARY_DIV ||
+      type == NODE_TYPE_OPERATOR_BINARY_MOD ||
       type == NODE_TYPE_RANGE ||
-      type == NODE_TYPE_INDEXED_ACCESS) {
+      type == NODE_TYPE_INDEXED_ACCESS ||
+      type == NODE_TYPE_EXPAND) {
     // a logical operator is simple if its operands are simple
     // a comparison operator is simple if both bounds are simple
+    // an arithmetic operator is simple if both operands are simple
     // a range is simple if both bounds are simple
+    // an expansion is simple if the iterator and the expansion are simple
     if (! getMember(0)->isSimple() || ! getMember(1)->isSimple()) {
       setFlag(DETERMINED_SIMPLE);
       return false;
@@ -1228,6 +1256,35 @@ bool AstNode::isSimple () const {
     return true;
   }
 
+  if (type == NODE_TYPE_ITERATOR) {
+    // an iterator is simple if the expanded value is simple
+    // its first member is the iterator variable
+    TRI_ASSERT(numMembers() == 2);
+
+    if (! getMember(1)->isSimple()) {
+      setFlag(DETERMINED_SIMPLE);
+      return false;
+    }
+
+    setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
+    return true;
+  }
+
+  if (type == NODE_TYPE_OPERATOR_TERNARY) {
+    // a ternary operator is simple if the condition and both parts are simple
+    TRI_ASSERT(numMembers() == 3);
+
+    if (! getMember(0)->isSimple() || 
+        ! getMember(1)->isSimple() || 
+        ! getMember(2)->isSimple()) {
+      setFlag(DETERMINED_SIMPLE);
+      return false;
+    }
+
+    setFlag(DETERMINED_SIMPLE, VALUE_SIMPLE);
+    return true;
+  }
+
   setFlag(DETERMINED_SIMPLE);
   return false;
 }
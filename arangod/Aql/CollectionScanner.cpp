@@ -120,6 +120,38 @@ void LinearCollectionScanner::reset () {
   position = 0;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                  struct DatafileCollectionScanner
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+DatafileCollectionScanner::DatafileCollectionScanner (triagens::arango::AqlTransaction* trx,
+                                                      TRI_transaction_collection_t* trxCollection) 
+  : CollectionScanner(trx, trxCollection),
+    scanPosition() {
+
+}
+
+int DatafileCollectionScanner::scan (std::vector<TRI_doc_mptr_copy_t>& docs,
+                                     size_t batchSize) {
+  return trx->readDatafileOrder(trxCollection,
+                                docs,
+                                scanPosition,
+                                static_cast<TRI_voc_size_t>(batchSize),
+                                &totalCount);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+void DatafileCollectionScanner::reset () {
+  scanPosition.reset();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -109,6 +109,33 @@ namespace triagens {
       void reset ();
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                  struct DatafileCollectionScanner
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief full scan in datafile order. returns the documents in the order in
+/// which they are stored on disk, which avoids random memory accesses for
+/// large collections
+////////////////////////////////////////////////////////////////////////////////
+
+    struct DatafileCollectionScanner : public CollectionScanner {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+  
+      DatafileCollectionScanner (triagens::arango::AqlTransaction*,
+                                 TRI_transaction_collection_t*); 
+
+      int scan (std::vector<TRI_doc_mptr_copy_t>&,
+                size_t);
+      
+      void reset ();
+
+      TRI_datafile_scan_t scanPosition;
+    };
+
   }
 }
 
@@ -34,6 +34,10 @@
 #include "Basics/json-utilities.h"
 #include "Basics/Exceptions.h"
 #include "Cluster/ClusterMethods.h"
+#include "FulltextIndex/fulltext-index.h"
+#include "FulltextIndex/fulltext-query.h"
+#include "FulltextIndex/fulltext-result.h"
+#include "GeoIndex/geo-index.h"
 #include "HashIndex/hash-index.h"
 #include "V8/v8-globals.h"
 #include "VocBase/edge-collection.h"
@@ -764,6 +768,8 @@ int SingletonBlock::getOrSkipSome (size_t,   // atLeast,
 // --SECTION--                                    class EnumerateCollectionBlock
 // -----------------------------------------------------------------------------
 
+size_t const EnumerateCollectionBlock::MinDatafileScanCount = 16384;
+
 EnumerateCollectionBlock::EnumerateCollectionBlock (ExecutionEngine* engine,
                                                     EnumerateCollectionNode const* ep)
   : ExecutionBlock(engine, ep),
@@ -782,6 +788,12 @@ EnumerateCollectionBlock::EnumerateCollectionBlock (ExecutionEngine* engine,
     // random scan
     _scanner = new RandomCollectionScanner(_trx, trxCollection);
   }
+  else if (trxCollection != nullptr &&
+           _collection->count() >= MinDatafileScanCount) {
+    // large collection: scan in datafile order, to read the documents
+    // sequentially from disk
+    _scanner = new DatafileCollectionScanner(_trx, trxCollection);
+  }
   else {
     // default: linear scan
     _scanner = new LinearCollectionScanner(_trx, trxCollection);
@@ -2259,50 +2271,598 @@ void IndexRangeBlock::getSkiplistIterator (IndexAndCondition const& ranges) {
       return;
     }
 
-    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_NO_INDEX);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_NO_INDEX);
+  }
+  LEAVE_BLOCK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief actually read from the skiplist index
+////////////////////////////////////////////////////////////////////////////////
+
+void IndexRangeBlock::readSkiplistIndex (size_t atMost) {
+  ENTER_BLOCK;
+  if (_skiplistIterator == nullptr) {
+    return;
+  }
+  
+  try {
+    size_t nrSent = 0;
+    while (nrSent < atMost && _skiplistIterator !=nullptr) { 
+      TRI_skiplist_index_element_t* indexElement = _skiplistIterator->next(_skiplistIterator);
+
+      if (indexElement == nullptr) {
+        TRI_FreeSkiplistIterator(_skiplistIterator);
+        _skiplistIterator = nullptr;
+        if (++_posInRanges < _condition->size()) {
+          getSkiplistIterator(_condition->at(_sortCoords[_posInRanges]));
+        }
+      } 
+      else {
+        TRI_IF_FAILURE("IndexRangeBlock::readSkiplistIndex") {
+          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+        }
+        _documents.emplace_back(*(indexElement->_document));
+        ++nrSent;
+        ++_engine->_stats.scannedIndex;
+      }
+    }
+  }
+  catch (...) {
+    if (_skiplistIterator != nullptr) {
+      TRI_FreeSkiplistIterator(_skiplistIterator);
+      _skiplistIterator = nullptr;
+    }
+    throw;
+  }
+  LEAVE_BLOCK;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               class GeoIndexBlock
+// -----------------------------------------------------------------------------
+
+GeoIndexBlock::GeoIndexBlock (ExecutionEngine* engine,
+                              GeoIndexNode const* en)
+  : ExecutionBlock(engine, en),
+    _collection(en->collection()),
+    _documents(),
+    _posInDocuments(0),
+    _indexRead(false) {
+
+  auto trxCollection = _trx->trxCollection(_collection->cid());
+  if (trxCollection != nullptr) {
+    _trx->orderBarrier(trxCollection);
+  }
+}
+
+GeoIndexBlock::~GeoIndexBlock () {
+}
+
+int GeoIndexBlock::initialize () {
+  return ExecutionBlock::initialize();
+}
+
+int GeoIndexBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
+  int res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  _posInDocuments = 0;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the documents in the geo index and order them by distance
+////////////////////////////////////////////////////////////////////////////////
+
+void GeoIndexBlock::readIndex () {
+  ENTER_BLOCK
+  TRI_ASSERT(! _indexRead);
+
+  throwIfKilled(); // check if we were aborted
+
+  auto en = static_cast<GeoIndexNode const*>(getPlanNode());
+  TRI_index_t* idx = en->getIndex()->getInternals();
+
+  _indexRead = true;
+  _documents.clear();
+
+  // never ask the index for more points than there are documents, as it
+  // allocates its result buffer upfront
+  auto document = _trx->documentCollection(_collection->cid());
+  size_t count = static_cast<size_t>(document->size(document));
+
+  if (en->limit() > 0 && en->limit() < count) {
+    count = en->limit();
+  }
+
+  if (count == 0) {
+    return;
+  }
+
+  GeoCoordinates* coords;
+
+  if (en->hasRadius()) {
+    coords = TRI_WithinGeoIndex(idx, en->_latitude, en->_longitude, en->_radius);
+  }
+  else {
+    if (count > static_cast<size_t>(INT32_MAX)) {
+      count = static_cast<size_t>(INT32_MAX);
+    }
+    coords = TRI_NearestGeoIndex(idx, en->_latitude, en->_longitude, count);
+  }
+
+  // the index does not return the points in any particular order
+  std::vector<std::pair<double, TRI_doc_mptr_copy_t>> found;
+
+  if (coords != nullptr) {
+    try {
+      found.reserve(coords->length);
+
+      for (size_t i = 0; i < coords->length; ++i) {
+        found.emplace_back(coords->distances[i], *static_cast<TRI_doc_mptr_t const*>(coords->coordinates[i].data));
+      }
+    }
+    catch (...) {
+      GeoIndex_CoordinatesFree(coords);
+      throw;
+    }
+
+    GeoIndex_CoordinatesFree(coords);
+  }
+
+  // documents without valid coordinates are not in the index. DISTANCE()
+  // returns null for them, which sorts first and is less than any radius,
+  // or a distance if the coordinates are numbers out of range. the index
+  // counts such documents, so the collection is only scanned if there are any
+  std::vector<TRI_doc_mptr_copy_t> unlocated;
+
+  if (TRI_UnindexedGeoIndex(idx) > 0) {
+    LinearCollectionScanner scanner(_trx, _trx->trxCollection(_collection->cid()));
+    std::vector<TRI_doc_mptr_copy_t> batch;
+
+    GeoCoordinate reference;
+    reference.latitude  = en->_latitude;
+    reference.longitude = en->_longitude;
+    reference.data      = nullptr;
+
+    while (true) {
+      throwIfKilled(); // check if we were aborted
+
+      batch.clear();
+      int res = scanner.scan(batch, DefaultBatchSize);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        THROW_ARANGO_EXCEPTION(res);
+      }
+
+      if (batch.empty()) {
+        break;
+      }
+
+      _engine->_stats.scannedFull += static_cast<int64_t>(batch.size());
+
+      for (auto const& doc : batch) {
+        double latitude;
+        double longitude;
+
+        if (! TRI_CoordinatesGeoIndex(idx, &doc, &latitude, &longitude)) {
+          unlocated.emplace_back(doc);
+        }
+        else if (! TRI_ValidCoordinatesGeoIndex(latitude, longitude)) {
+          GeoCoordinate c;
+          c.latitude  = latitude;
+          c.longitude = longitude;
+          c.data      = nullptr;
+
+          double const distance = GeoIndex_distance(&reference, &c);
+
+          if (! en->hasRadius() || distance <= en->_radius) {
+            found.emplace_back(distance, doc);
+          }
+        }
+      }
+    }
+  }
+
+  std::stable_sort(found.begin(), found.end(), [] (std::pair<double, TRI_doc_mptr_copy_t> const& lhs,
+                                                   std::pair<double, TRI_doc_mptr_copy_t> const& rhs) {
+    return lhs.first < rhs.first;
+  });
+
+  if (unlocated.size() > count) {
+    unlocated.resize(count);
+  }
+
+  if (found.size() > count - unlocated.size()) {
+    // radius lookups are not limited by the index
+    found.resize(count - unlocated.size());
+  }
+
+  _documents = std::move(unlocated);
+  _documents.reserve(_documents.size() + found.size());
+
+  for (auto const& it : found) {
+    _documents.emplace_back(it.second);
+  }
+
+  _engine->_stats.scannedIndex += static_cast<int64_t>(_documents.size());
+  LEAVE_BLOCK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getSome
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* GeoIndexBlock::getSome (size_t, // atLeast,
+                                      size_t atMost) {
+  ENTER_BLOCK
+  if (_done) {
+    return nullptr;
+  }
+
+  if (_buffer.empty()) {
+    size_t toFetch = (std::min)(DefaultBatchSize, atMost);
+    if (! ExecutionBlock::getBlock(toFetch, toFetch)) {
+      _done = true;
+      return nullptr;
+    }
+    _pos = 0;           // this is in the first block
+    _posInDocuments = 0;
+  }
+
+  if (! _indexRead) {
+    readIndex();
+  }
+
+  if (_documents.empty()) {
+    // the lookup result is the same for all incoming items
+    _done = true;
+    return nullptr;
+  }
+
+  // If we get here, we do have _buffer.front()
+  AqlItemBlock* cur = _buffer.front();
+  size_t const curRegs = cur->getNrRegs();
+
+  size_t available = _documents.size() - _posInDocuments;
+  size_t toSend = (std::min)(atMost, available);
+
+  unique_ptr<AqlItemBlock> res(new AqlItemBlock(toSend, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+  // automatically freed if we throw
+  TRI_ASSERT(curRegs <= res->getNrRegs());
+
+  // only copy 1st row of registers inherited from previous frame(s)
+  inheritRegisters(cur, res.get(), _pos);
+
+  // set our collection for our output register
+  res->setDocumentCollection(static_cast<triagens::aql::RegisterId>(curRegs), _trx->documentCollection(_collection->cid()));
+
+  for (size_t j = 0; j < toSend; j++) {
+    if (j > 0) {
+      // re-use already copied aqlvalues
+      for (RegisterId i = 0; i < curRegs; i++) {
+        res->setValue(j, i, res->getValue(0, i));
+      }
+    }
+
+    res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs),
+                  AqlValue(reinterpret_cast<TRI_df_marker_t
+                           const*>(_documents[_posInDocuments++].getDataPtr())));
+  }
+
+  // Advance read position:
+  if (_posInDocuments >= _documents.size()) {
+    // all documents were returned for the current incoming item
+    _posInDocuments = 0;
+    if (++_pos >= cur->size()) {
+      _buffer.pop_front();  // does not throw
+      delete cur;
+      _pos = 0;
+    }
+  }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+  return res.release();
+  LEAVE_BLOCK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief skipSome
+////////////////////////////////////////////////////////////////////////////////
+
+size_t GeoIndexBlock::skipSome (size_t atLeast, 
+                                size_t atMost) {
+  ENTER_BLOCK
+  size_t skipped = 0;
+
+  if (_done) {
+    return skipped;
+  }
+
+  while (skipped < atLeast) {
+    if (_buffer.empty()) {
+      size_t toFetch = (std::min)(DefaultBatchSize, atMost);
+      if (! getBlock(toFetch, toFetch)) {
+        _done = true;
+        return skipped;
+      }
+      _pos = 0;           // this is in the first block
+      _posInDocuments = 0;
+    }
+
+    if (! _indexRead) {
+      readIndex();
+    }
+
+    if (_documents.empty()) {
+      _done = true;
+      return skipped;
+    }
+
+    // if we get here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+    size_t const available = _documents.size() - _posInDocuments;
+
+    if (atMost >= skipped + available) {
+      skipped += available;
+      _posInDocuments = 0;
+
+      if (++_pos >= cur->size()) {
+        _buffer.pop_front();  // does not throw
+        delete cur;
+        _pos = 0;
+      }
+    }
+    else {
+      _posInDocuments += atMost - skipped;
+      skipped = atMost;
+    }
+  }
+
+  return skipped;
+  LEAVE_BLOCK;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                          class FulltextIndexBlock
+// -----------------------------------------------------------------------------
+
+FulltextIndexBlock::FulltextIndexBlock (ExecutionEngine* engine,
+                                        FulltextIndexNode const* en)
+  : ExecutionBlock(engine, en),
+    _collection(en->collection()),
+    _result(nullptr),
+    _posInDocuments(0),
+    _indexRead(false) {
+
+  auto trxCollection = _trx->trxCollection(_collection->cid());
+  if (trxCollection != nullptr) {
+    _trx->orderBarrier(trxCollection);
+  }
+}
+
+FulltextIndexBlock::~FulltextIndexBlock () {
+  if (_result != nullptr) {
+    TRI_FreeResultFulltextIndex(_result);
+  }
+}
+
+int FulltextIndexBlock::initialize () {
+  return ExecutionBlock::initialize();
+}
+
+int FulltextIndexBlock::initializeCursor (AqlItemBlock* items, size_t pos) {
+  int res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  _posInDocuments = 0;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run the fulltext query against the index
+///
+/// the index result is kept as is and its document pointers are handed out
+/// directly, so no intermediate copies of the documents are made
+////////////////////////////////////////////////////////////////////////////////
+
+void FulltextIndexBlock::readIndex () {
+  ENTER_BLOCK
+  TRI_ASSERT(! _indexRead);
+  TRI_ASSERT(_result == nullptr);
+
+  throwIfKilled(); // check if we were aborted
+
+  auto en = static_cast<FulltextIndexNode const*>(getPlanNode());
+  auto idx = reinterpret_cast<TRI_fulltext_index_t*>(en->getIndex()->getInternals());
+
+  _indexRead = true;
+
+  TRI_fulltext_query_t* query = TRI_CreateQueryFulltextIndex(TRI_FULLTEXT_SEARCH_MAX_WORDS);
+
+  if (query == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  bool isSubstringQuery = false;
+  int res = TRI_ParseQueryFulltextIndex(query, en->query().c_str(), &isSubstringQuery);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    TRI_FreeQueryFulltextIndex(query);
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  if (isSubstringQuery && ! idx->_indexSubstrings) {
+    TRI_FreeQueryFulltextIndex(query);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_NOT_IMPLEMENTED);
+  }
+
+  // note: the following call will free "query"!
+  _result = TRI_QueryFulltextIndex(idx->_fulltextIndex, query);
+
+  if (_result == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_INTERNAL);
+  }
+
+  _engine->_stats.scannedIndex += static_cast<int64_t>(_result->_numDocuments);
+  LEAVE_BLOCK;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of documents found
+////////////////////////////////////////////////////////////////////////////////
+
+size_t FulltextIndexBlock::numDocuments () const {
+  return (_result == nullptr ? 0 : static_cast<size_t>(_result->_numDocuments));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getSome
+////////////////////////////////////////////////////////////////////////////////
+
+AqlItemBlock* FulltextIndexBlock::getSome (size_t, // atLeast,
+                                           size_t atMost) {
+  ENTER_BLOCK
+  if (_done) {
+    return nullptr;
+  }
+
+  if (_buffer.empty()) {
+    size_t toFetch = (std::min)(DefaultBatchSize, atMost);
+    if (! ExecutionBlock::getBlock(toFetch, toFetch)) {
+      _done = true;
+      return nullptr;
+    }
+    _pos = 0;           // this is in the first block
+    _posInDocuments = 0;
+  }
+
+  if (! _indexRead) {
+    readIndex();
+  }
+
+  size_t const n = numDocuments();
+
+  if (n == 0) {
+    // the lookup result is the same for all incoming items
+    _done = true;
+    return nullptr;
+  }
+
+  // If we get here, we do have _buffer.front()
+  AqlItemBlock* cur = _buffer.front();
+  size_t const curRegs = cur->getNrRegs();
+
+  size_t available = n - _posInDocuments;
+  size_t toSend = (std::min)(atMost, available);
+
+  unique_ptr<AqlItemBlock> res(new AqlItemBlock(toSend, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+  // automatically freed if we throw
+  TRI_ASSERT(curRegs <= res->getNrRegs());
+
+  // only copy 1st row of registers inherited from previous frame(s)
+  inheritRegisters(cur, res.get(), _pos);
+
+  // set our collection for our output register
+  res->setDocumentCollection(static_cast<triagens::aql::RegisterId>(curRegs), _trx->documentCollection(_collection->cid()));
+
+  for (size_t j = 0; j < toSend; j++) {
+    if (j > 0) {
+      // re-use already copied aqlvalues
+      for (RegisterId i = 0; i < curRegs; i++) {
+        res->setValue(j, i, res->getValue(0, i));
+      }
+    }
+
+    auto mptr = reinterpret_cast<TRI_doc_mptr_t const*>(_result->_documents[_posInDocuments++]);
+
+    res->setValue(j, static_cast<triagens::aql::RegisterId>(curRegs),
+                  AqlValue(reinterpret_cast<TRI_df_marker_t const*>(mptr->getDataPtr())));
+  }
+
+  // Advance read position:
+  if (_posInDocuments >= n) {
+    // all documents were returned for the current incoming item
+    _posInDocuments = 0;
+    if (++_pos >= cur->size()) {
+      _buffer.pop_front();  // does not throw
+      delete cur;
+      _pos = 0;
+    }
   }
+
+  // Clear out registers no longer needed later:
+  clearRegisters(res.get());
+  return res.release();
   LEAVE_BLOCK;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief actually read from the skiplist index
+/// @brief skipSome
 ////////////////////////////////////////////////////////////////////////////////
 
-void IndexRangeBlock::readSkiplistIndex (size_t atMost) {
-  ENTER_BLOCK;
-  if (_skiplistIterator == nullptr) {
-    return;
+size_t FulltextIndexBlock::skipSome (size_t atLeast, 
+                                     size_t atMost) {
+  ENTER_BLOCK
+  size_t skipped = 0;
+
+  if (_done) {
+    return skipped;
   }
-  
-  try {
-    size_t nrSent = 0;
-    while (nrSent < atMost && _skiplistIterator !=nullptr) { 
-      TRI_skiplist_index_element_t* indexElement = _skiplistIterator->next(_skiplistIterator);
 
-      if (indexElement == nullptr) {
-        TRI_FreeSkiplistIterator(_skiplistIterator);
-        _skiplistIterator = nullptr;
-        if (++_posInRanges < _condition->size()) {
-          getSkiplistIterator(_condition->at(_sortCoords[_posInRanges]));
-        }
-      } 
-      else {
-        TRI_IF_FAILURE("IndexRangeBlock::readSkiplistIndex") {
-          THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
-        }
-        _documents.emplace_back(*(indexElement->_document));
-        ++nrSent;
-        ++_engine->_stats.scannedIndex;
+  while (skipped < atLeast) {
+    if (_buffer.empty()) {
+      size_t toFetch = (std::min)(DefaultBatchSize, atMost);
+      if (! getBlock(toFetch, toFetch)) {
+        _done = true;
+        return skipped;
       }
+      _pos = 0;           // this is in the first block
+      _posInDocuments = 0;
     }
-  }
-  catch (...) {
-    if (_skiplistIterator != nullptr) {
-      TRI_FreeSkiplistIterator(_skiplistIterator);
-      _skiplistIterator = nullptr;
+
+    if (! _indexRead) {
+      readIndex();
+    }
+
+    size_t const n = numDocuments();
+
+    if (n == 0) {
+      _done = true;
+      return skipped;
+    }
+
+    // if we get here, then _buffer.front() exists
+    AqlItemBlock* cur = _buffer.front();
+    size_t const available = n - _posInDocuments;
+
+    if (atMost >= skipped + available) {
+      skipped += available;
+      _posInDocuments = 0;
+
+      if (++_pos >= cur->size()) {
+        _buffer.pop_front();  // does not throw
+        delete cur;
+        _pos = 0;
+      }
+    }
+    else {
+      _posInDocuments += atMost - skipped;
+      skipped = atMost;
     }
-    throw;
   }
+
+  return skipped;
   LEAVE_BLOCK;
 }
 
@@ -3469,6 +4029,297 @@ void AggregateBlock::emitGroup (AqlItemBlock const* cur,
   _currentGroup.reset();
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                        class HashedAggregateBlock
+// -----------------------------------------------------------------------------
+
+HashedAggregateBlock::HashedAggregateBlock (ExecutionEngine* engine,
+                                            AggregateNode const* en)
+  : ExecutionBlock(engine, en),
+    _aggregateRegisters(),
+    _groupRegister(0),
+    _groups(),
+    _groupPositions(),
+    _firstRow(nullptr),
+    _groupsBuilt(false),
+    _groupPos(0) {
+  
+  TRI_ASSERT(en->canUseHashing());
+
+  for (auto p : en->_aggregateVariables) {
+    // We know that planRegisters() has been run, so
+    // getPlanNode()->_registerPlan is set up
+    auto itOut = en->getRegisterPlan()->varInfo.find(p.first->id);
+    TRI_ASSERT(itOut != en->getRegisterPlan()->varInfo.end());
+
+    auto itIn = en->getRegisterPlan()->varInfo.find(p.second->id);
+    TRI_ASSERT(itIn != en->getRegisterPlan()->varInfo.end());
+    TRI_ASSERT((*itIn).second.registerId < ExecutionNode::MaxRegisterId);
+    TRI_ASSERT((*itOut).second.registerId < ExecutionNode::MaxRegisterId);
+    _aggregateRegisters.emplace_back(make_pair((*itOut).second.registerId, (*itIn).second.registerId));
+  }
+
+  if (en->_outVariable != nullptr) {
+    // only WITH COUNT INTO is supported here
+    TRI_ASSERT(en->_countOnly);
+
+    auto const& registerPlan = en->getRegisterPlan()->varInfo;
+    auto it = registerPlan.find(en->_outVariable->id);
+    TRI_ASSERT(it != registerPlan.end());
+    _groupRegister = (*it).second.registerId;
+    TRI_ASSERT(_groupRegister > 0 && _groupRegister < ExecutionNode::MaxRegisterId);
+  }
+}
+
+HashedAggregateBlock::~HashedAggregateBlock () {
+  freeGroups();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initializeCursor
+////////////////////////////////////////////////////////////////////////////////
+
+int HashedAggregateBlock::initializeCursor (AqlItemBlock* items, 
+                                            size_t pos) {
+  int res = ExecutionBlock::initializeCursor(items, pos);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  freeGroups();
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hash function for group keys
+////////////////////////////////////////////////////////////////////////////////
+
+size_t HashedAggregateBlock::GroupKeyHash::operator() (std::vector<TRI_json_t const*> const& key) const {
+  uint64_t hash = 0x12345678;
+
+  for (auto it : key) {
+    // -0 and 0 are equal group values, so they must produce the same hash
+    hash ^= TRI_HashJsonNormalized(it) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+  }
+
+  return static_cast<size_t>(hash);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief equality function for group keys
+////////////////////////////////////////////////////////////////////////////////
+
+bool HashedAggregateBlock::GroupKeyEqual::operator() (std::vector<TRI_json_t const*> const& lhs,
+                                                      std::vector<TRI_json_t const*> const& rhs) const {
+  size_t const n = lhs.size();
+  TRI_ASSERT(n == rhs.size());
+
+  for (size_t i = 0; i < n; ++i) {
+    // byte-wise string comparison is sufficient for equality
+    if (TRI_CompareValuesJson(lhs[i], rhs[i], false) != 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free all groups and the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+void HashedAggregateBlock::freeGroups () {
+  _groupPositions.clear();
+
+  for (auto& group : _groups) {
+    for (auto it : group.first) {
+      if (it != nullptr) {
+        TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, const_cast<TRI_json_t*>(it));
+      }
+    }
+  }
+  _groups.clear();
+
+  delete _firstRow;
+  _firstRow = nullptr;
+
+  _groupsBuilt = false;
+  _groupPos = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief consume the complete input and group it in the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+void HashedAggregateBlock::buildGroups () {
+  TRI_ASSERT(! _groupsBuilt);
+  TRI_ASSERT(_groups.empty());
+
+  size_t const n = _aggregateRegisters.size();
+  std::vector<TRI_json_t const*> key;
+  key.reserve(n);
+  // JSON representations of non-JSON group values (e.g. documents) 
+  std::vector<Json> temporaries;
+  temporaries.reserve(n);
+
+  while (getBlock(DefaultBatchSize, DefaultBatchSize)) {
+    AqlItemBlock* cur = _buffer.front();
+    _buffer.pop_front();
+
+    std::unique_ptr<AqlItemBlock> guard(cur);
+
+    if (_firstRow == nullptr && cur->size() > 0) {
+      // keep the values of the first row for populating the output
+      _firstRow = new AqlItemBlock(1, cur->getNrRegs());
+      inheritRegisters(cur, _firstRow, 0);
+    }
+
+    size_t const rows = cur->size();
+
+    for (size_t row = 0; row < rows; ++row) {
+      key.clear();
+      temporaries.clear();
+
+      for (auto const& it : _aggregateRegisters) {
+        AqlValue const& value = cur->getValue(row, it.second);
+
+        if (value._type == AqlValue::JSON) {
+          // use the JSON value as it is
+          key.emplace_back(value._json->json());
+        }
+        else {
+          temporaries.emplace_back(value.toJson(_trx, cur->getDocumentCollection(it.second)));
+          key.emplace_back(temporaries.back().json());
+        }
+      }
+
+      auto it = _groupPositions.find(key);
+
+      if (it != _groupPositions.end()) {
+        // existing group
+        ++_groups[(*it).second].second;
+        continue;
+      }
+
+      // new group. copy the group values, as the input blocks will go away
+      std::vector<TRI_json_t const*> groupValues;
+      groupValues.reserve(n);
+
+      try {
+        for (auto value : key) {
+          TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+
+          if (copy == nullptr) {
+            THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+          }
+          groupValues.emplace_back(copy);
+        }
+
+        _groups.emplace_back(std::make_pair(groupValues, static_cast<size_t>(1)));
+      }
+      catch (...) {
+        for (auto value : groupValues) {
+          TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, const_cast<TRI_json_t*>(value));
+        }
+        throw;
+      }
+
+      // the hash table refers to the group values owned by _groups
+      _groupPositions.emplace(_groups.back().first, _groups.size() - 1);
+    }
+  }
+
+  if (_aggregateRegisters.empty() && _groups.empty()) {
+    // total aggregation, but no input. still need to produce one group
+    _groups.emplace_back(std::make_pair(std::vector<TRI_json_t const*>(), static_cast<size_t>(0)));
+  }
+
+  // the hash table is not needed anymore
+  _groupPositions.clear();
+  _groupsBuilt = true;
+}
+
+int HashedAggregateBlock::getOrSkipSome (size_t atLeast,
+                                         size_t atMost,
+                                         bool skipping,
+                                         AqlItemBlock*& result,
+                                         size_t& skipped) {
+  TRI_ASSERT(result == nullptr && skipped == 0);
+  if (_done) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  if (! _groupsBuilt) {
+    buildGroups();
+  }
+
+  TRI_ASSERT(_groupPos <= _groups.size());
+  size_t const toSend = (std::min)(atMost, _groups.size() - _groupPos);
+
+  if (toSend == 0) {
+    _done = true;
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  if (skipping) {
+    _groupPos += toSend;
+    skipped = toSend;
+  }
+  else {
+    unique_ptr<AqlItemBlock> res(new AqlItemBlock(toSend, getPlanNode()->getRegisterPlan()->nrRegs[getPlanNode()->getDepth()]));
+
+    if (_firstRow != nullptr) {
+      TRI_ASSERT(_firstRow->getNrRegs() <= res->getNrRegs());
+      inheritRegisters(_firstRow, res.get(), 0);
+    }
+
+    for (size_t row = 0; row < toSend; ++row) {
+      if (row > 0 && _firstRow != nullptr) {
+        // re-use already copied aqlvalues
+        for (RegisterId i = 0; i < _firstRow->getNrRegs(); i++) {
+          res->setValue(row, i, res->getValue(0, i));
+        }
+      }
+
+      auto& group = _groups[_groupPos];
+
+      size_t i = 0;
+      for (auto const& it : _aggregateRegisters) {
+        AqlValue a(new Json(TRI_UNKNOWN_MEM_ZONE, const_cast<TRI_json_t*>(group.first[i])));
+        // ownership of the group value is transferred into the AqlValue
+        group.first[i] = nullptr;
+
+        try {
+          res->setValue(row, it.first, a);
+        }
+        catch (...) {
+          a.destroy();
+          throw;
+        }
+        ++i;
+      }
+
+      if (_groupRegister > 0) {
+        // set group count in result register
+        res->setValue(row, _groupRegister, AqlValue(new Json(static_cast<double>(group.second))));
+      }
+
+      ++_groupPos;
+    }
+
+    skipped = toSend;
+    result = res.release();
+  }
+
+  if (_groupPos == _groups.size()) {
+    _done = true;
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   class SortBlock
 // -----------------------------------------------------------------------------
@@ -6303,14 +7154,15 @@ RemoteBlock::~RemoteBlock () {
 ClusterCommResult* RemoteBlock::sendRequest (
           triagens::rest::HttpRequest::HttpRequestType type,
           std::string const& urlPart,
-          std::string const& body) const {
+          std::string const& body,
+          std::map<std::string, std::string> const& extraHeaders) const {
   ENTER_BLOCK
   ClusterComm* cc = ClusterComm::instance();
 
   // Later, we probably want to set these sensibly:
   ClientTransactionID const clientTransactionId = "AQL";
   CoordTransactionID const coordTransactionId = TRI_NewTickServer(); //1;
-  std::map<std::string, std::string> headers;
+  std::map<std::string, std::string> headers(extraHeaders);
   if (! _ownName.empty()) {
     headers.emplace(make_pair("Shard-Id", _ownName));
   }
@@ -6446,15 +7298,52 @@ AqlItemBlock* RemoteBlock::getSome (size_t atLeast,
       ("atMost", Json(static_cast<double>(atMost)));
   std::string bodyString(body.toString());
 
+  // ask for the binary format, servers that do not know it will answer
+  // with Json as before
+  std::map<std::string, std::string> headers;
+  headers.emplace(std::make_pair("Accept", std::string(AqlItemBlock::BinaryContentType)));
+
   std::unique_ptr<ClusterCommResult> res;
   res.reset(sendRequest(rest::HttpRequest::HTTP_REQUEST_PUT,
                         "/_api/aql/getSome/",
-                        bodyString));
+                        bodyString,
+                        headers));
   throwExceptionAfterBadSyncRequest(res.get(), false);
 
   // If we get here, then res->result is the response which will be
   // a serialized AqlItemBlock:
   StringBuffer const& responseBodyBuf(res->result->getBody());
+
+  bool found;
+  std::string contentType(res->result->getHeaderField("content-type", found));
+
+  if (found && contentType == AqlItemBlock::BinaryContentType) {
+    char const* position = responseBodyBuf.begin();
+    char const* end = position + responseBodyBuf.length();
+
+    if (position >= end) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_AQL_COMMUNICATION,
+                                     "empty binary getSome response");
+    }
+    bool exhausted = (*position++ != 0);
+
+    TRI_json_t* stats = JsonHelper::fromBinary(position, end);
+    if (stats == nullptr) {
+      THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_CLUSTER_AQL_COMMUNICATION,
+                                     "malformed binary getSome response");
+    }
+    ExecutionStats newStats(Json(TRI_UNKNOWN_MEM_ZONE, stats));
+
+    _engine->_stats.addDelta(_deltaStats, newStats);
+    _deltaStats = newStats;
+
+    if (exhausted) {
+      return nullptr;
+    }
+
+    return new triagens::aql::AqlItemBlock(position, end);
+  }
+
   Json responseBodyJson(TRI_UNKNOWN_MEM_ZONE,
                         TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, 
                                        responseBodyBuf.begin()));
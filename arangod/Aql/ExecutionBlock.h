@@ -46,6 +46,7 @@
 struct TRI_df_marker_s;
 struct TRI_doc_mptr_copy_t;
 struct TRI_edge_index_iterator_t;
+struct TRI_fulltext_result_s;
 struct TRI_hash_index_element_multi_s;
 struct TRI_json_t;
 
@@ -552,6 +553,14 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool const _random;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum number of documents for scanning a collection in datafile
+/// order. smaller collections are scanned via the primary index, which is
+/// cheaper for data that is in memory anyway
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const MinDatafileScanCount;
     };
 
 // -----------------------------------------------------------------------------
@@ -845,6 +854,179 @@ namespace triagens {
 
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     GeoIndexBlock
+// -----------------------------------------------------------------------------
+
+    class GeoIndexBlock : public ExecutionBlock {
+
+      public:
+
+        GeoIndexBlock (ExecutionEngine* engine,
+                       GeoIndexNode const* en);
+
+        ~GeoIndexBlock ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initialize
+////////////////////////////////////////////////////////////////////////////////
+
+        int initialize () override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initializeCursor
+////////////////////////////////////////////////////////////////////////////////
+
+        int initializeCursor (AqlItemBlock* items, size_t pos) override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getSome
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlItemBlock* getSome (size_t atLeast, size_t atMost) override final;
+
+////////////////////////////////////////////////////////////////////////////////
+// skip between atLeast and atMost, returns the number actually skipped . . .
+// will only return less than atLeast if there aren't atLeast many
+// things to skip overall.
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t skipSome (size_t atLeast, size_t atMost) override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the documents in the geo index and order them by distance.
+/// the reference coordinate is constant, so this is done only once and the
+/// result is re-used for all incoming items
+////////////////////////////////////////////////////////////////////////////////
+
+        void readIndex ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection const* _collection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief documents ordered by distance, documents without coordinates first
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<TRI_doc_mptr_copy_t> _documents;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current position in _documents
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _posInDocuments;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the index was already read
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _indexRead;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                FulltextIndexBlock
+// -----------------------------------------------------------------------------
+
+    class FulltextIndexBlock : public ExecutionBlock {
+
+      public:
+
+        FulltextIndexBlock (ExecutionEngine* engine,
+                            FulltextIndexNode const* en);
+
+        ~FulltextIndexBlock ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initialize
+////////////////////////////////////////////////////////////////////////////////
+
+        int initialize () override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initializeCursor
+////////////////////////////////////////////////////////////////////////////////
+
+        int initializeCursor (AqlItemBlock* items, size_t pos) override;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getSome
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlItemBlock* getSome (size_t atLeast, size_t atMost) override final;
+
+////////////////////////////////////////////////////////////////////////////////
+// skip between atLeast and atMost, returns the number actually skipped . . .
+// will only return less than atLeast if there aren't atLeast many
+// things to skip overall.
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t skipSome (size_t atLeast, size_t atMost) override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run the fulltext query against the index. the query is constant,
+/// so this is done only once and the result is re-used for all incoming items
+////////////////////////////////////////////////////////////////////////////////
+
+        void readIndex ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of documents found
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t numDocuments () const;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection const* _collection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the documents found in the index
+////////////////////////////////////////////////////////////////////////////////
+
+        struct TRI_fulltext_result_s* _result;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current position in _result
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _posInDocuments;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the index was already read
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _indexRead;
+    };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                EnumerateListBlock
 // -----------------------------------------------------------------------------
@@ -1230,6 +1412,107 @@ namespace triagens {
 
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                              HashedAggregateBlock
+// -----------------------------------------------------------------------------
+
+    class HashedAggregateBlock : public ExecutionBlock  {
+
+      public:
+
+        HashedAggregateBlock (ExecutionEngine*,
+                              AggregateNode const*);
+
+        ~HashedAggregateBlock ();
+
+        int initializeCursor (AqlItemBlock* items, size_t pos) override;
+
+      private:
+
+        int getOrSkipSome (size_t atLeast,
+                           size_t atMost,
+                           bool skipping,
+                           AqlItemBlock*& result,
+                           size_t& skipped);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief consume the complete input and group it in the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+        void buildGroups ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free all groups and the hash table
+////////////////////////////////////////////////////////////////////////////////
+
+        void freeGroups ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hash function for group keys
+////////////////////////////////////////////////////////////////////////////////
+
+        struct GroupKeyHash {
+          size_t operator() (std::vector<TRI_json_t const*> const&) const;
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief equality function for group keys
+////////////////////////////////////////////////////////////////////////////////
+
+        struct GroupKeyEqual {
+          bool operator() (std::vector<TRI_json_t const*> const&,
+                           std::vector<TRI_json_t const*> const&) const;
+        };
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief pairs, consisting of out register and in register
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<RegisterId, RegisterId>> _aggregateRegisters;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the optional register that receives the group length (WITH COUNT)
+/// if no count should be returned, then this has a value of 0
+////////////////////////////////////////////////////////////////////////////////
+
+        RegisterId _groupRegister;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief all groups found, consisting of the group values and the group 
+/// length. the group values are owned by the block until they are emitted
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<std::vector<TRI_json_t const*>, size_t>> _groups;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hash table mapping group values to positions in _groups
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<std::vector<TRI_json_t const*>, size_t, GroupKeyHash, GroupKeyEqual> _groupPositions;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief copy of the first input row, used to populate the inherited 
+/// registers of the output
+////////////////////////////////////////////////////////////////////////////////
+
+        AqlItemBlock* _firstRow;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the input has been grouped already
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _groupsBuilt;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief position of the next group to emit
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _groupPos;
+
+    };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                         SortBlock
 // -----------------------------------------------------------------------------
@@ -2324,7 +2607,9 @@ namespace triagens {
         triagens::arango::ClusterCommResult* sendRequest (
                   rest::HttpRequest::HttpRequestType type,
                   std::string const& urlPart,
-                  std::string const& body) const;
+                  std::string const& body,
+                  std::map<std::string, std::string> const& extraHeaders
+                    = std::map<std::string, std::string>()) const;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief our server, can be like "shard:S1000" or like "server:Claus"
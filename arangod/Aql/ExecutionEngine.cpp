@@ -55,6 +55,12 @@ static ExecutionBlock* createBlock (ExecutionEngine* engine,
     case ExecutionNode::INDEX_RANGE: {
       return new IndexRangeBlock(engine, static_cast<IndexRangeNode const*>(en));
     }
+    case ExecutionNode::GEO_INDEX: {
+      return new GeoIndexBlock(engine, static_cast<GeoIndexNode const*>(en));
+    }
+    case ExecutionNode::FULLTEXT_INDEX: {
+      return new FulltextIndexBlock(engine, static_cast<FulltextIndexNode const*>(en));
+    }
     case ExecutionNode::ENUMERATE_COLLECTION: {
       return new EnumerateCollectionBlock(engine,
                                           static_cast<EnumerateCollectionNode const*>(en));
@@ -77,7 +83,12 @@ static ExecutionBlock* createBlock (ExecutionEngine* engine,
       return new SortBlock(engine, static_cast<SortNode const*>(en));
     }
     case ExecutionNode::AGGREGATE: {
-      return new AggregateBlock(engine, static_cast<AggregateNode const*>(en));
+      auto aggregateNode = static_cast<AggregateNode const*>(en);
+
+      if (aggregateNode->isHashed()) {
+        return new HashedAggregateBlock(engine, aggregateNode);
+      }
+      return new AggregateBlock(engine, aggregateNode);
     }
     case ExecutionNode::SUBQUERY: {
       auto es = static_cast<SubqueryNode const*>(en);
@@ -369,6 +380,12 @@ struct CoordinatorInstanciator : public WalkerWorker<ExecutionNode> {
         else if ((*en)->getType() == ExecutionNode::INDEX_RANGE) {
           collection = const_cast<Collection*>(static_cast<IndexRangeNode*>((*en))->collection());
         }
+        else if ((*en)->getType() == ExecutionNode::GEO_INDEX) {
+          collection = const_cast<Collection*>(static_cast<GeoIndexNode*>((*en))->collection());
+        }
+        else if ((*en)->getType() == ExecutionNode::FULLTEXT_INDEX) {
+          collection = const_cast<Collection*>(static_cast<FulltextIndexNode*>((*en))->collection());
+        }
         else if ((*en)->getType() == ExecutionNode::INSERT ||
                  (*en)->getType() == ExecutionNode::UPDATE ||
                  (*en)->getType() == ExecutionNode::REPLACE ||
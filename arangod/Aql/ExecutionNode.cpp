@@ -75,7 +75,9 @@ std::unordered_map<int, std::string const> const ExecutionNode::TypeNames{
   { static_cast<int>(DISTRIBUTE),                   "DistributeNode" },
   { static_cast<int>(GATHER),                       "GatherNode" },
   { static_cast<int>(NORESULTS),                    "NoResultsNode" },
-  { static_cast<int>(UPSERT),                       "UpsertNode" }
+  { static_cast<int>(UPSERT),                       "UpsertNode" },
+  { static_cast<int>(GEO_INDEX),                    "GeoIndexNode" },
+  { static_cast<int>(FULLTEXT_INDEX),               "FulltextIndexNode" }
 };
           
 // -----------------------------------------------------------------------------
@@ -211,6 +213,10 @@ ExecutionNode* ExecutionNode::fromJsonFactory (ExecutionPlan* plan,
       return new NoResultsNode(plan, oneNode);
     case INDEX_RANGE:
       return new IndexRangeNode(plan, oneNode);
+    case GEO_INDEX:
+      return new GeoIndexNode(plan, oneNode);
+    case FULLTEXT_INDEX:
+      return new FulltextIndexNode(plan, oneNode);
     case REMOTE:
       return new RemoteNode(plan, oneNode);
     case GATHER: {
@@ -898,6 +904,36 @@ void ExecutionNode::RegisterPlan::after (ExecutionNode *en) {
       totalNrRegs++;
       break;
     }
+    case ExecutionNode::GEO_INDEX: {
+      depth++;
+      nrRegsHere.emplace_back(1);
+      // create a copy of the last value here
+      // this is requried because back returns a reference and emplace/push_back may invalidate all references
+      RegisterId registerId = 1 + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      auto ep = static_cast<GeoIndexNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(make_pair(ep->outVariable()->id,
+                               VarInfo(depth, totalNrRegs)));
+      totalNrRegs++;
+      break;
+    }
+    case ExecutionNode::FULLTEXT_INDEX: {
+      depth++;
+      nrRegsHere.emplace_back(1);
+      // create a copy of the last value here
+      // this is requried because back returns a reference and emplace/push_back may invalidate all references
+      RegisterId registerId = 1 + nrRegs.back();
+      nrRegs.emplace_back(registerId);
+
+      auto ep = static_cast<FulltextIndexNode const*>(en);
+      TRI_ASSERT(ep != nullptr);
+      varInfo.emplace(make_pair(ep->outVariable()->id,
+                               VarInfo(depth, totalNrRegs)));
+      totalNrRegs++;
+      break;
+    }
     case ExecutionNode::ENUMERATE_LIST: {
       depth++;
       nrRegsHere.emplace_back(1);
@@ -1338,6 +1374,24 @@ std::vector<EnumerateCollectionNode::IndexMatch>
   return out;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the geo indexes of the collection
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<Index*> EnumerateCollectionNode::getGeoIndexes () const {
+  std::vector<Index*> out;
+  auto&& indexes = _collection->getIndexes();
+
+  for (auto idx : indexes) {
+    if (idx->type == TRI_IDX_TYPE_GEO1_INDEX ||
+        idx->type == TRI_IDX_TYPE_GEO2_INDEX) {
+      out.emplace_back(idx);
+    }
+  }
+
+  return out;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief the cost of an enumerate collection node is a multiple of the cost of
 /// its unique dependency
@@ -1675,7 +1729,15 @@ double IndexRangeNode::estimateCost (size_t& nrItems) const {
     for (auto const& x : _ranges) {
       double cost = static_cast<double>(docCount) * incoming;
 
-      for (auto const& y : x) { //only doing the 1-d case so far
+      // use the index statistics for the leading attributes if possible,
+      // and the heuristics below for the rest
+      double fraction = 1.0;
+      size_t const covered = estimateFractionWithIndexStatistics(x, fraction);
+      cost *= fraction;
+
+      for (size_t i = covered; i < x.size(); ++i) {
+        auto const& y = x[i];
+
         if (y.is1ValueRangeInfo()) {
           // equality lookup
           cost /= EqualityReductionFactor;
@@ -1793,6 +1855,259 @@ bool IndexRangeNode::estimateItemsWithIndexSelectivity (size_t incoming,
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief provide an estimate for the fraction of documents matching the
+/// leading attributes of a range, using the index statistics (if present)
+////////////////////////////////////////////////////////////////////////////////
+
+size_t IndexRangeNode::estimateFractionWithIndexStatistics (std::vector<RangeInfo> const& ranges,
+                                                            double& fraction) const {
+  fraction = 1.0;
+
+  if (ranges.empty() || ! _index->hasRangeEstimate()) {
+    return 0;
+  }
+
+  // number of leading attributes compared using eq (==)
+  size_t equalities = 0;
+  while (equalities < ranges.size() && ranges[equalities].is1ValueRangeInfo()) {
+    ++equalities;
+  }
+
+  RangeInfo const& first = ranges[0];
+
+  if (first.isConstant() && first.isValid()) {
+    // the histogram can be used for the first attribute
+    TRI_json_t const* low = nullptr;
+    TRI_json_t const* high = nullptr;
+
+    if (first._lowConst.isDefined()) {
+      low = first._lowConst.bound().json();
+    }
+    if (first._highConst.isDefined()) {
+      high = first._highConst.bound().json();
+    }
+
+    double estimate = _index->rangeEstimate(low, 
+                                            first._lowConst.inclusive(), 
+                                            high, 
+                                            first._highConst.inclusive());
+
+    if (estimate >= 0.0) {
+      fraction = estimate;
+
+      if (equalities > 1) {
+        // the remaining equality attributes narrow down the result by the
+        // average number of distinct combinations per value of the first one
+        double const distinctFirst = _index->distinctEstimate(1);
+        double const distinctAll = _index->distinctEstimate(equalities);
+
+        if (distinctFirst > 0.0 && distinctAll >= distinctFirst) {
+          fraction *= distinctFirst / distinctAll;
+        }
+
+        return equalities;
+      }
+
+      return 1;
+    }
+  }
+
+  if (equalities > 0) {
+    // equality lookups with non-constant values
+    double const distinct = _index->distinctEstimate(equalities);
+
+    if (distinct > 0.0) {
+      fraction = 1.0 / distinct;
+      return equalities;
+    }
+  }
+
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           methods of GeoIndexNode
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor for GeoIndexNode from Json
+////////////////////////////////////////////////////////////////////////////////
+
+GeoIndexNode::GeoIndexNode (ExecutionPlan* plan,
+                            triagens::basics::Json const& json)
+  : ExecutionNode(plan, json),
+    _vocbase(plan->getAst()->query()->vocbase()),
+    _collection(plan->getAst()->query()->collections()->get(JsonHelper::checkAndGetStringValue(json.json(), "collection"))),
+    _outVariable(varFromJson(plan->getAst(), json, "outVariable")),
+    _index(nullptr),
+    _latitude(JsonHelper::checkAndGetNumericValue<double>(json.json(), "latitude")),
+    _longitude(JsonHelper::checkAndGetNumericValue<double>(json.json(), "longitude")),
+    _limit(JsonHelper::checkAndGetNumericValue<size_t>(json.json(), "limit")),
+    _radius(JsonHelper::getNumericValue<double>(json.json(), "radius", -1.0)) {
+
+  auto index = JsonHelper::checkAndGetObjectValue(json.json(), "index");
+  auto iid   = JsonHelper::checkAndGetStringValue(index, "id");
+
+  _index = _collection->getIndex(iid);
+
+  if (_index == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "index not found");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toJson, for GeoIndexNode
+////////////////////////////////////////////////////////////////////////////////
+
+void GeoIndexNode::toJsonHelper (triagens::basics::Json& nodes,
+                                 TRI_memory_zone_t* zone,
+                                 bool verbose) const {
+  triagens::basics::Json json(ExecutionNode::toJsonHelperGeneric(nodes, zone, verbose));
+  // call base class method
+
+  if (json.isEmpty()) {
+    return;
+  }
+
+  json("database", triagens::basics::Json(_vocbase->_name))
+      ("collection", triagens::basics::Json(_collection->getName()))
+      ("outVariable", _outVariable->toJson())
+      ("index", _index->toJson())
+      ("latitude", triagens::basics::Json(_latitude))
+      ("longitude", triagens::basics::Json(_longitude))
+      ("limit", triagens::basics::Json(static_cast<double>(_limit)));
+
+  if (hasRadius()) {
+    json("radius", triagens::basics::Json(_radius));
+  }
+
+  // And add it:
+  nodes(json);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* GeoIndexNode::clone (ExecutionPlan* plan,
+                                    bool withDependencies,
+                                    bool withProperties) const {
+  auto outVariable = _outVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+  }
+
+  auto c = new GeoIndexNode(plan, _id, _vocbase, _collection, outVariable, 
+                            _index, _latitude, _longitude, _limit, _radius);
+
+  CloneHelper(c, plan, withDependencies, withProperties);
+
+  return static_cast<ExecutionNode*>(c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a geo index node is the number of documents it looks
+/// up per incoming item, which is bounded by the limit
+////////////////////////////////////////////////////////////////////////////////
+ 
+double GeoIndexNode::estimateCost (size_t& nrItems) const { 
+  size_t incoming = 0;
+  double const dependencyCost = _dependencies.at(0)->getCost(incoming);
+  size_t count = _collection->count();
+
+  if (_limit > 0 && _limit < count) {
+    count = _limit;
+  }
+
+  nrItems = incoming * count;
+  return dependencyCost + nrItems;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                      methods of FulltextIndexNode
+// -----------------------------------------------------------------------------
+
+FulltextIndexNode::FulltextIndexNode (ExecutionPlan* plan,
+                                      triagens::basics::Json const& json)
+  : ExecutionNode(plan, json),
+    _vocbase(plan->getAst()->query()->vocbase()),
+    _collection(plan->getAst()->query()->collections()->get(JsonHelper::checkAndGetStringValue(json.json(), "collection"))),
+    _outVariable(varFromJson(plan->getAst(), json, "outVariable")),
+    _index(nullptr),
+    _query(JsonHelper::checkAndGetStringValue(json.json(), "query")) {
+
+  auto index = JsonHelper::checkAndGetObjectValue(json.json(), "index");
+  auto iid   = JsonHelper::checkAndGetStringValue(index, "id");
+
+  _index = _collection->getIndex(iid);
+
+  if (_index == nullptr) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "index not found");
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toJson, for FulltextIndexNode
+////////////////////////////////////////////////////////////////////////////////
+
+void FulltextIndexNode::toJsonHelper (triagens::basics::Json& nodes,
+                                      TRI_memory_zone_t* zone,
+                                      bool verbose) const {
+  triagens::basics::Json json(ExecutionNode::toJsonHelperGeneric(nodes, zone, verbose));
+  // call base class method
+
+  if (json.isEmpty()) {
+    return;
+  }
+
+  json("database", triagens::basics::Json(_vocbase->_name))
+      ("collection", triagens::basics::Json(_collection->getName()))
+      ("outVariable", _outVariable->toJson())
+      ("index", _index->toJson())
+      ("query", triagens::basics::Json(_query));
+
+  // And add it:
+  nodes(json);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+ExecutionNode* FulltextIndexNode::clone (ExecutionPlan* plan,
+                                         bool withDependencies,
+                                         bool withProperties) const {
+  auto outVariable = _outVariable;
+
+  if (withProperties) {
+    outVariable = plan->getAst()->variables()->createVariable(outVariable);
+  }
+
+  auto c = new FulltextIndexNode(plan, _id, _vocbase, _collection, outVariable, 
+                                 _index, _query);
+
+  CloneHelper(c, plan, withDependencies, withProperties);
+
+  return static_cast<ExecutionNode*>(c);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a fulltext index node is a fraction of the cost of a
+/// full collection scan, as the number of matches is not known upfront
+////////////////////////////////////////////////////////////////////////////////
+ 
+double FulltextIndexNode::estimateCost (size_t& nrItems) const { 
+  size_t incoming = 0;
+  double const dependencyCost = _dependencies.at(0)->getCost(incoming);
+  // assume that a tenth of the documents match
+  size_t count = _collection->count() / 10 + 1;
+
+  nrItems = incoming * count;
+  return dependencyCost + nrItems;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                              methods of LimitNode
 // -----------------------------------------------------------------------------
@@ -2287,7 +2602,8 @@ AggregateNode::AggregateNode (ExecutionPlan* plan,
     _outVariable(outVariable),
     _keepVariables(keepVariables),
     _variableMap(variableMap),
-    _countOnly(countOnly) {
+    _countOnly(countOnly),
+    _hashed(JsonHelper::getBooleanValue(base.json(), "hashed", false)) {
 
 }
 
@@ -2335,6 +2651,7 @@ void AggregateNode::toJsonHelper (triagens::basics::Json& nodes,
   }
 
   json("count", triagens::basics::Json(_countOnly));
+  json("hashed", triagens::basics::Json(_hashed));
 
   // And add it:
   nodes(json);
@@ -2377,6 +2694,8 @@ ExecutionNode* AggregateNode::clone (ExecutionPlan* plan,
                              _variableMap, 
                              _countOnly);
 
+  c->_hashed = _hashed;
+
   CloneHelper(c, plan, withDependencies, withProperties);
 
   return static_cast<ExecutionNode*>(c);
@@ -2404,6 +2723,8 @@ struct UserVarFinder : public WalkerWorker<ExecutionNode> {
     }
     else if (en->getType() == ExecutionNode::ENUMERATE_COLLECTION ||
              en->getType() == ExecutionNode::INDEX_RANGE ||
+             en->getType() == ExecutionNode::GEO_INDEX ||
+             en->getType() == ExecutionNode::FULLTEXT_INDEX ||
              en->getType() == ExecutionNode::ENUMERATE_LIST ||
              en->getType() == ExecutionNode::AGGREGATE) {
       depth += 1;
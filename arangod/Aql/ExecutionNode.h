@@ -103,7 +103,9 @@ namespace triagens {
           RETURN                  = 18,
           NORESULTS               = 19,
           DISTRIBUTE              = 20,
-          UPSERT                  = 21
+          UPSERT                  = 21,
+          GEO_INDEX               = 22,
+          FULLTEXT_INDEX          = 23
         };
 
 // -----------------------------------------------------------------------------
@@ -914,6 +916,12 @@ namespace triagens {
 
         std::vector<IndexMatch> getIndicesOrdered (IndexMatchVec const& attrs) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the geo indexes of the collection
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Index*> getGeoIndexes () const;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief enable random iteration of documents in collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -922,6 +930,14 @@ namespace triagens {
           _random = true;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the documents are iterated in random order
+////////////////////////////////////////////////////////////////////////////////
+
+        bool isRandom () const {
+          return _random;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the database
 ////////////////////////////////////////////////////////////////////////////////
@@ -1234,6 +1250,15 @@ namespace triagens {
         bool estimateItemsWithIndexSelectivity (size_t,
                                                 size_t&) const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief provide an estimate for the fraction of documents matching the
+/// leading attributes of a range, using the index statistics (if present).
+/// returns the number of range attributes covered by the estimate
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t estimateFractionWithIndexStatistics (std::vector<RangeInfo> const&,
+                                                    double&) const;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -1277,6 +1302,359 @@ namespace triagens {
         bool _reverse;
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class GeoIndexNode
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief class GeoIndexNode
+/// enumerates the documents of a collection via a geo index, in ascending
+/// order of their distance to a fixed coordinate. at most <limit> documents
+/// are looked up (0 means no limit), and only documents within <radius> meters
+/// are returned if a radius is set. documents without valid coordinates are
+/// not contained in the geo index. they are found with a full scan if there
+/// are any, and are returned first, as DISTANCE() is null for them
+////////////////////////////////////////////////////////////////////////////////
+
+    class GeoIndexNode : public ExecutionNode {
+      
+      friend class ExecutionBlock;
+      friend class GeoIndexBlock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor
+////////////////////////////////////////////////////////////////////////////////
+
+      public:
+
+        GeoIndexNode (ExecutionPlan* plan,
+                      size_t id,
+                      TRI_vocbase_t* vocbase, 
+                      Collection const* collection,
+                      Variable const* outVariable,
+                      Index const* index, 
+                      double latitude,
+                      double longitude,
+                      size_t limit,
+                      double radius)
+          : ExecutionNode(plan, id), 
+            _vocbase(vocbase), 
+            _collection(collection),
+            _outVariable(outVariable),
+            _index(index),
+            _latitude(latitude),
+            _longitude(longitude),
+            _limit(limit),
+            _radius(radius) {
+          TRI_ASSERT(_vocbase != nullptr);
+          TRI_ASSERT(_collection != nullptr);
+          TRI_ASSERT(_outVariable != nullptr);
+          TRI_ASSERT(_index != nullptr);
+        }
+
+        GeoIndexNode (ExecutionPlan*, triagens::basics::Json const& base);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the type of the node
+////////////////////////////////////////////////////////////////////////////////
+
+        NodeType getType () const override final {
+          return GEO_INDEX;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the database
+////////////////////////////////////////////////////////////////////////////////
+        
+        TRI_vocbase_t* vocbase () const {
+          return _vocbase;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection const* collection () const {
+          return _collection;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return out variable
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* outVariable () const {
+          return _outVariable;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the index used
+////////////////////////////////////////////////////////////////////////////////
+
+        Index const* getIndex () const {
+          return _index;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the maximum number of documents to look up, 0 = unlimited
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t limit () const {
+          return _limit;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not only documents within a radius are returned
+////////////////////////////////////////////////////////////////////////////////
+
+        bool hasRadius () const {
+          return (_radius >= 0.0);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief export to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+        void toJsonHelper (triagens::basics::Json&,
+                           TRI_memory_zone_t*,
+                           bool) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+        ExecutionNode* clone (ExecutionPlan* plan,
+                              bool withDependencies,
+                              bool withProperties) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getVariablesSetHere
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Variable const*> getVariablesSetHere () const override final {
+          return std::vector<Variable const*>{ _outVariable };
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a geo index node is the number of documents it looks
+/// up per incoming item, which is bounded by the limit
+////////////////////////////////////////////////////////////////////////////////
+
+        double estimateCost (size_t&) const override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the database
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_vocbase_t* _vocbase;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection const* _collection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief output variable
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _outVariable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the geo index
+////////////////////////////////////////////////////////////////////////////////
+
+        Index const* _index;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief latitude of the reference coordinate
+////////////////////////////////////////////////////////////////////////////////
+
+        double const _latitude;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief longitude of the reference coordinate
+////////////////////////////////////////////////////////////////////////////////
+
+        double const _longitude;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of documents to look up, 0 = unlimited
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t const _limit;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum distance in meters, negative = unlimited
+////////////////////////////////////////////////////////////////////////////////
+
+        double const _radius;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                           class FulltextIndexNode
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief class FulltextIndexNode
+/// enumerates the documents of a collection that match a fulltext query, via
+/// a fulltext index. this is the native implementation of
+/// FOR doc IN FULLTEXT(collection, attribute, query)
+////////////////////////////////////////////////////////////////////////////////
+
+    class FulltextIndexNode : public ExecutionNode {
+      
+      friend class ExecutionBlock;
+      friend class FulltextIndexBlock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief constructor
+////////////////////////////////////////////////////////////////////////////////
+
+      public:
+
+        FulltextIndexNode (ExecutionPlan* plan,
+                           size_t id,
+                           TRI_vocbase_t* vocbase, 
+                           Collection const* collection,
+                           Variable const* outVariable,
+                           Index const* index, 
+                           std::string const& query)
+          : ExecutionNode(plan, id), 
+            _vocbase(vocbase), 
+            _collection(collection),
+            _outVariable(outVariable),
+            _index(index),
+            _query(query) {
+          TRI_ASSERT(_vocbase != nullptr);
+          TRI_ASSERT(_collection != nullptr);
+          TRI_ASSERT(_outVariable != nullptr);
+          TRI_ASSERT(_index != nullptr);
+        }
+
+        FulltextIndexNode (ExecutionPlan*, triagens::basics::Json const& base);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the type of the node
+////////////////////////////////////////////////////////////////////////////////
+
+        NodeType getType () const override final {
+          return FULLTEXT_INDEX;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the database
+////////////////////////////////////////////////////////////////////////////////
+        
+        TRI_vocbase_t* vocbase () const {
+          return _vocbase;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection const* collection () const {
+          return _collection;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return out variable
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* outVariable () const {
+          return _outVariable;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the index used
+////////////////////////////////////////////////////////////////////////////////
+
+        Index const* getIndex () const {
+          return _index;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the fulltext query string
+////////////////////////////////////////////////////////////////////////////////
+
+        std::string const& query () const {
+          return _query;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief export to JSON
+////////////////////////////////////////////////////////////////////////////////
+
+        void toJsonHelper (triagens::basics::Json&,
+                           TRI_memory_zone_t*,
+                           bool) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clone ExecutionNode recursively
+////////////////////////////////////////////////////////////////////////////////
+
+        ExecutionNode* clone (ExecutionPlan* plan,
+                              bool withDependencies,
+                              bool withProperties) const override final;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief getVariablesSetHere
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<Variable const*> getVariablesSetHere () const override final {
+          return std::vector<Variable const*>{ _outVariable };
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the cost of a fulltext index node is a fraction of the cost of a
+/// full collection scan, as the number of matches is not known upfront
+////////////////////////////////////////////////////////////////////////////////
+
+        double estimateCost (size_t&) const override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the database
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_vocbase_t* _vocbase;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collection
+////////////////////////////////////////////////////////////////////////////////
+
+        Collection const* _collection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief output variable
+////////////////////////////////////////////////////////////////////////////////
+
+        Variable const* _outVariable;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the fulltext index
+////////////////////////////////////////////////////////////////////////////////
+
+        Index const* _index;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the fulltext query string
+////////////////////////////////////////////////////////////////////////////////
+
+        std::string const _query;
+    };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   class LimitNode
 // -----------------------------------------------------------------------------
@@ -1367,6 +1745,30 @@ namespace triagens {
           _fullCount = true;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the node fully counts what it limits
+////////////////////////////////////////////////////////////////////////////////
+
+        bool fullCount () const {
+          return _fullCount;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the offset
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t offset () const {
+          return _offset;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the limit
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t limit () const {
+          return _limit;
+        }
+
       private:
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1973,6 +2375,7 @@ namespace triagens {
       friend class ExecutionNode;
       friend class ExecutionBlock;
       friend class AggregateBlock;
+      friend class HashedAggregateBlock;
       friend class RedundantCalculationsReplacer;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1995,7 +2398,8 @@ namespace triagens {
             _outVariable(outVariable),
             _keepVariables(keepVariables),
             _variableMap(variableMap),
-            _countOnly(countOnly) {
+            _countOnly(countOnly),
+            _hashed(false) {
           // outVariable can be a nullptr
         }
         
@@ -2046,6 +2450,42 @@ namespace triagens {
           return _countOnly;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the node groups its input using a hash table
+////////////////////////////////////////////////////////////////////////////////
+
+        inline bool isHashed () const {
+          return _hashed;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the node can group its input using a hash table
+/// this is possible if the node does not need to produce the group rows, i.e.
+/// if there is no INTO or if only the group lengths are counted
+////////////////////////////////////////////////////////////////////////////////
+
+        inline bool canUseHashing () const {
+          return (_outVariable == nullptr || _countOnly);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief make the node group its input using a hash table. the input does
+/// not need to be sorted then, but the output will be in arbitrary order
+////////////////////////////////////////////////////////////////////////////////
+
+        void useHashing () {
+          TRI_ASSERT(canUseHashing());
+          _hashed = true;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the aggregate variables (out, in)
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<Variable const*, Variable const*>> const& aggregateVariables () const {
+          return _aggregateVariables;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief whether or not the node has an outVariable (i.e. INTO ...)
 ////////////////////////////////////////////////////////////////////////////////
@@ -2162,6 +2602,12 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         bool const _countOnly;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the grouping is done using a hash table
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _hashed;
     };
 
 // -----------------------------------------------------------------------------
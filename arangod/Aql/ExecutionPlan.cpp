@@ -1696,7 +1696,9 @@ bool ExecutionPlan::isDeadSimple () const {
     if (nodeType == ExecutionNode::SUBQUERY ||
         nodeType == ExecutionNode::ENUMERATE_COLLECTION ||
         nodeType == ExecutionNode::ENUMERATE_LIST ||
-        nodeType == ExecutionNode::INDEX_RANGE) {
+        nodeType == ExecutionNode::INDEX_RANGE ||
+        nodeType == ExecutionNode::GEO_INDEX ||
+        nodeType == ExecutionNode::FULLTEXT_INDEX) {
       // these node types are not simple
       return false;
     }
@@ -31,6 +31,7 @@
 #include "Aql/AqlValue.h"
 #include "Aql/Ast.h"
 #include "Aql/Executor.h"
+#include "Aql/Functions.h"
 #include "Aql/V8Expression.h"
 #include "Aql/Variable.h"
 #include "Basics/JsonHelper.h"
@@ -315,7 +316,8 @@ void Expression::analyzeExpression () {
     _isDeterministic  = true;
     _data             = nullptr;
   }
-  else if (_node->isSimple()) {
+  else if (_node->isSimple() &&
+           _ast->query()->nativeExpressions()) {
     // expression is a simple expression
     _type             = SIMPLE;
     _canThrow         = _node->canThrow();
@@ -382,6 +384,38 @@ void Expression::buildExpression () {
   _built = true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert an operand of an arithmetic operation into a number
+/// returns false if the operand cannot be converted, using AQL's TO_NUMBER
+/// conversion rules
+////////////////////////////////////////////////////////////////////////////////
+
+static bool OperandToNumber (AqlValue const& value,
+                             TRI_document_collection_t const* collection,
+                             triagens::arango::AqlTransaction* trx,
+                             double& result) {
+  if (value._type == AqlValue::JSON) {
+    // fast path, avoids copying the value
+    return Functions::ValueToNumber(value._json->json(), result);
+  }
+
+  Json json = value.toJson(trx, collection);
+  return Functions::ValueToNumber(json.json(), result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from the result of an arithmetic operation
+/// NaN and +/- infinity are converted into null
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue NumericResult (double value) {
+  if (std::isnan(value) || ! std::isfinite(value)) {
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &Expression::NullJson, Json::NOFREE));
+  }
+
+  return AqlValue(new Json(value));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief execute an expression of type SIMPLE, the convention is that
 /// the resulting AqlValue will be destroyed outside eventually
@@ -558,9 +592,26 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, json, Json::NOFREE)); 
   }
 
+  else if (node->type == NODE_TYPE_COLLECTION) {
+    // collection parameters of functions with a C++ implementation are
+    // passed as collection names
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, std::string(node->getStringValue())));
+  }
+
   else if (node->type == NODE_TYPE_REFERENCE) {
     auto v = static_cast<Variable*>(node->getData());
 
+    if (! _expansionValues.empty()) {
+      // check the iterator variables of the currently executed expansions
+      // first. the innermost expansion is at the end
+      for (auto it = _expansionValues.rbegin(); it != _expansionValues.rend(); ++it) {
+        if ((*it).first->id == v->id) {
+          // we do not own the JSON but the expansion does!
+          return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, (*it).second, Json::NOFREE));
+        }
+      }
+    }
+
     size_t i = 0;
     for (auto it = vars.begin(); it != vars.end(); ++it, ++i) {
       if ((*it)->name == v->name) {
@@ -586,7 +637,7 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
 
     AqlValue result = executeSimpleExpression(member, &myCollection, trx, docColls, argv, startPos, vars, regs);
         
-    auto res2 = func->implementation(trx, myCollection, result);
+    auto res2 = func->implementation(_ast->query(), trx, myCollection, result);
     result.destroy();
     return res2;
   }
@@ -719,11 +770,144 @@ AqlValue Expression::executeSimpleExpression (AstNode const* node,
     condition.destroy();
     if (isTrue) {
       // return true part
-      return executeSimpleExpression(node->getMember(1), &myCollection, trx, docColls, argv, startPos, vars, regs);
+      return executeSimpleExpression(node->getMember(1), collection, trx, docColls, argv, startPos, vars, regs);
     }
     
     // return false part  
-    return executeSimpleExpression(node->getMember(2), &myCollection, trx, docColls, argv, startPos, vars, regs);
+    return executeSimpleExpression(node->getMember(2), collection, trx, docColls, argv, startPos, vars, regs);
+  }
+
+  else if (node->type == NODE_TYPE_OPERATOR_UNARY_PLUS ||
+           node->type == NODE_TYPE_OPERATOR_UNARY_MINUS) {
+    TRI_document_collection_t const* myCollection = nullptr;
+    AqlValue operand = executeSimpleExpression(node->getMember(0), &myCollection, trx, docColls, argv, startPos, vars, regs);
+
+    double value;
+    bool const isNumber = OperandToNumber(operand, myCollection, trx, value);
+    operand.destroy();
+
+    if (! isNumber) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &NullJson, Json::NOFREE));
+    }
+
+    if (node->type == NODE_TYPE_OPERATOR_UNARY_MINUS) {
+      value = - value;
+    }
+
+    return NumericResult(value);
+  }
+
+  else if (node->type == NODE_TYPE_OPERATOR_BINARY_PLUS ||
+           node->type == NODE_TYPE_OPERATOR_BINARY_MINUS ||
+           node->type == NODE_TYPE_OPERATOR_BINARY_TIMES ||
+           node->type == NODE_TYPE_OPERATOR_BINARY_DIV ||
+           node->type == NODE_TYPE_OPERATOR_BINARY_MOD) {
+    TRI_document_collection_t const* leftCollection = nullptr;
+    AqlValue left  = executeSimpleExpression(node->getMember(0), &leftCollection, trx, docColls, argv, startPos, vars, regs);
+    TRI_document_collection_t const* rightCollection = nullptr;
+    AqlValue right = executeSimpleExpression(node->getMember(1), &rightCollection, trx, docColls, argv, startPos, vars, regs);
+
+    double l, r;
+    bool const leftIsNumber  = OperandToNumber(left, leftCollection, trx, l);
+    bool const rightIsNumber = OperandToNumber(right, rightCollection, trx, r);
+    left.destroy();
+    right.destroy();
+
+    if (! leftIsNumber) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &NullJson, Json::NOFREE));
+    }
+
+    if (node->type == NODE_TYPE_OPERATOR_BINARY_DIV ||
+        node->type == NODE_TYPE_OPERATOR_BINARY_MOD) {
+      if (! rightIsNumber || r == 0.0) {
+        _ast->query()->registerWarning(TRI_ERROR_QUERY_DIVISION_BY_ZERO, nullptr);
+        return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &NullJson, Json::NOFREE));
+      }
+
+      if (node->type == NODE_TYPE_OPERATOR_BINARY_DIV) {
+        return NumericResult(l / r);
+      }
+      return NumericResult(std::fmod(l, r));
+    }
+
+    if (! rightIsNumber) {
+      return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, &NullJson, Json::NOFREE));
+    }
+
+    if (node->type == NODE_TYPE_OPERATOR_BINARY_PLUS) {
+      return NumericResult(l + r);
+    }
+    else if (node->type == NODE_TYPE_OPERATOR_BINARY_MINUS) {
+      return NumericResult(l - r);
+    }
+    return NumericResult(l * r);
+  }
+
+  else if (node->type == NODE_TYPE_EXPAND) {
+    // array expansion, e.g. users[*].name
+    TRI_ASSERT(node->numMembers() == 2);
+
+    auto iterator = node->getMember(0);
+    TRI_ASSERT(iterator->type == NODE_TYPE_ITERATOR);
+    auto variable = static_cast<Variable const*>(iterator->getMember(0)->getData());
+
+    TRI_document_collection_t const* myCollection = nullptr;
+    AqlValue value = executeSimpleExpression(iterator->getMember(1), &myCollection, trx, docColls, argv, startPos, vars, regs);
+    Json expanded = value.toJson(trx, myCollection);
+    value.destroy();
+
+    // the operand is converted into an array first, like TO_ARRAY() does 
+    TRI_json_t const* json = expanded.json();
+    size_t step = 1;
+    size_t offset = 0;
+    size_t n = 0;
+
+    if (json != nullptr) {
+      if (json->_type == TRI_JSON_ARRAY) {
+        n = TRI_LengthVector(&json->_value._objects);
+      }
+      else if (json->_type == TRI_JSON_OBJECT) {
+        // iterate over the object's values
+        n = TRI_LengthVector(&json->_value._objects);
+        step = 2;
+        offset = 1;
+      }
+      else if (json->_type != TRI_JSON_NULL) {
+        n = 1;
+      }
+    }
+
+    auto result = new Json(Json::Array, n / step);
+
+    try {
+      for (size_t i = offset; i < n; i += step) {
+        TRI_json_t const* element = json;
+        if (json->_type == TRI_JSON_ARRAY || json->_type == TRI_JSON_OBJECT) {
+          element = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+        }
+
+        _expansionValues.emplace_back(variable, element);
+
+        try {
+          TRI_document_collection_t const* subCollection = nullptr;
+          AqlValue sub = executeSimpleExpression(node->getMember(1), &subCollection, trx, docColls, argv, startPos, vars, regs);
+          result->add(sub.toJson(trx, subCollection));
+          sub.destroy();
+        }
+        catch (...) {
+          _expansionValues.pop_back();
+          throw;
+        }
+
+        _expansionValues.pop_back();
+      }
+    }
+    catch (...) {
+      delete result;
+      throw;
+    }
+
+    return AqlValue(result);
   }
  
   THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_INTERNAL, "unhandled type in simple expression");
@@ -387,6 +387,15 @@ namespace triagens {
 
         std::unordered_map<Variable const*, std::unordered_set<std::string>> _attributes;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief values of the iterator variables of the array expansions that are
+/// currently executed in a simple expression. the innermost expansion is at
+/// the end. expressions are never shared between queries (plans from the
+/// plan cache are instanciated anew), so this needs no synchronization
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<std::pair<Variable const*, TRI_json_t const*>> _expansionValues;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                             public static members
 // -----------------------------------------------------------------------------
@@ -46,7 +46,8 @@ Function::Function (std::string const& externalName,
                     bool isDeterministic,
                     bool canThrow,
                     bool canRunOnDBServer,
-                    FunctionImplementation implementation)
+                    FunctionImplementation implementation,
+                    FunctionSupportCheck supportCheck)
   : internalName(internalName),
     externalName(externalName),
     arguments(arguments),
@@ -54,6 +55,7 @@ Function::Function (std::string const& externalName,
     canThrow(canThrow),
     canRunOnDBServer(canRunOnDBServer),
     implementation(implementation),
+    supportCheck(supportCheck),
     conversions() {
 
   initializeArguments();
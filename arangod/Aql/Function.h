@@ -60,7 +60,8 @@ namespace triagens {
                 bool isDeterministic,
                 bool canThrow,
                 bool canRunOnDBServer,
-                FunctionImplementation implementation = nullptr);
+                FunctionImplementation implementation = nullptr,
+                FunctionSupportCheck supportCheck = nullptr);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the function
@@ -89,6 +90,16 @@ namespace triagens {
         return std::make_pair(minRequiredArguments, maxRequiredArguments);
       }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the C++ implementation can be used for a call with
+/// the given arguments node
+////////////////////////////////////////////////////////////////////////////////
+
+      inline bool hasImplementation (AstNode const* arguments) const {
+        return (implementation != nullptr &&
+                (supportCheck == nullptr || supportCheck(arguments)));
+      }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief whether or not a positional argument needs to be converted from a
 /// collection parameter to a collection name parameter
@@ -167,6 +178,13 @@ namespace triagens {
 
       FunctionImplementation  implementation;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the C++ implementation supports a call (maybe nullptr,
+/// meaning it supports all calls)
+////////////////////////////////////////////////////////////////////////////////
+
+      FunctionSupportCheck    supportCheck;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief function argument conversion information
 ////////////////////////////////////////////////////////////////////////////////
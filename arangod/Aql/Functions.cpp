@@ -28,14 +28,199 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Aql/Functions.h"
+#include "Aql/AstNode.h"
+#include "Aql/Query.h"
+#include "Aql/Traverser.h"
 #include "Basics/fpconv.h"
 #include "Basics/Exceptions.h"
 #include "Basics/JsonHelper.h"
+#include "Basics/json-utilities.h"
 #include "Basics/StringBuffer.h"
+#include "Basics/utf8-helper.h"
+#include "Cluster/ServerState.h"
+#include "GeoIndex/GeoIndex.h"
+#include "Rest/SslInterface.h"
 
 using namespace triagens::aql;
 using Json = triagens::basics::Json;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hash function for JSON values, used for uniqueness checks
+////////////////////////////////////////////////////////////////////////////////
+
+struct JsonValueHash {
+  size_t operator() (TRI_json_t const* value) const {
+    return static_cast<size_t>(TRI_HashJson(value));
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief equality function for JSON values, used for uniqueness checks
+////////////////////////////////////////////////////////////////////////////////
+
+struct JsonValueEqual {
+  bool operator() (TRI_json_t const* lhs,
+                   TRI_json_t const* rhs) const {
+    return TRI_CheckSameValueJson(lhs, rhs);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief register a warning for the function, using the same message format
+/// as the JavaScript implementation
+////////////////////////////////////////////////////////////////////////////////
+
+static void RegisterWarning (Query* query,
+                             char const* functionName,
+                             int code) {
+  std::string msg;
+
+  if (code == TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH) {
+    msg = triagens::basics::Exception::FillExceptionString(code, functionName);
+  }
+  else {
+    msg.append("in function '");
+    msg.append(functionName);
+    msg.append("()': ");
+    msg.append(TRI_errno_string(code));
+  }
+
+  query->registerWarning(code, msg.c_str());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract a function parameter from the arguments list
+/// non-existing parameters are returned as null
+////////////////////////////////////////////////////////////////////////////////
+
+static Json ExtractFunctionParameter (triagens::arango::AqlTransaction* trx,
+                                      TRI_document_collection_t const* collection,
+                                      AqlValue const& parameters,
+                                      size_t position,
+                                      bool copy) {
+  if (position >= parameters.arraySize()) {
+    return Json(Json::Null);
+  }
+
+  return parameters.extractArrayMember(trx, collection, static_cast<int64_t>(position), copy);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a JSON value is treated as null by AQL
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsNullValue (TRI_json_t const* json) {
+  if (json == nullptr ||
+      json->_type == TRI_JSON_UNUSED ||
+      json->_type == TRI_JSON_NULL) {
+    return true;
+  }
+
+  if (json->_type == TRI_JSON_NUMBER) {
+    return (std::isnan(json->_value._number) || ! std::isfinite(json->_value._number));
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a JSON value is a string
+////////////////////////////////////////////////////////////////////////////////
+
+static inline bool IsStringValue (TRI_json_t const* json) {
+  return (json != nullptr &&
+          (json->_type == TRI_JSON_STRING || json->_type == TRI_JSON_STRING_REFERENCE));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue containing null
+////////////////////////////////////////////////////////////////////////////////
+
+static inline AqlValue NullValue () {
+  return AqlValue(new Json(Json::Null));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue containing a number, converting NaN and
+/// +/- infinity into null
+////////////////////////////////////////////////////////////////////////////////
+
+static inline AqlValue NumberValue (double value) {
+  if (std::isnan(value) || ! std::isfinite(value)) {
+    return NullValue();
+  }
+
+  return AqlValue(new Json(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue containing a string
+////////////////////////////////////////////////////////////////////////////////
+
+static inline AqlValue StringValue (char const* value,
+                                    size_t length) {
+  TRI_json_t* j = TRI_CreateStringCopyJson(TRI_UNKNOWN_MEM_ZONE, value, length);
+
+  if (j == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue from the contents of a string buffer, stealing
+/// the buffer's memory
+////////////////////////////////////////////////////////////////////////////////
+
+static inline AqlValue StringValue (triagens::basics::StringBuffer& buffer) {
+  size_t length = buffer.length();
+  TRI_json_t* j = TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length);
+
+  if (j == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create an AqlValue containing a copy of the JSON value
+////////////////////////////////////////////////////////////////////////////////
+
+static inline AqlValue CopyValue (TRI_json_t const* json) {
+  if (json == nullptr) {
+    return NullValue();
+  }
+
+  TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, copy));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append a copy of the JSON value to an array
+////////////////////////////////////////////////////////////////////////////////
+
+static void AppendCopy (Json& array,
+                        TRI_json_t const* json) {
+  TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, json);
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  array.add(copy);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief append the JSON value to a string buffer
 ////////////////////////////////////////////////////////////////////////////////
@@ -45,7 +230,7 @@ static void AppendAsString (triagens::basics::StringBuffer& buffer,
   TRI_json_type_e const type = (json == nullptr ? TRI_JSON_UNUSED : json->_type);
 
   switch (type) {
-    case TRI_JSON_UNUSED: 
+    case TRI_JSON_UNUSED:
     case TRI_JSON_NULL: {
       buffer.appendText("null", strlen("null"));
       break;
@@ -74,7 +259,12 @@ static void AppendAsString (triagens::basics::StringBuffer& buffer,
         if (i > 0) {
           buffer.appendChar(',');
         }
-        AppendAsString(buffer, static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i)));
+        auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+        if (IsNullValue(sub)) {
+          // null array members are stringified as empty strings
+          continue;
+        }
+        AppendAsString(buffer, sub);
       }
       break;
     }
@@ -86,191 +276,3843 @@ static void AppendAsString (triagens::basics::StringBuffer& buffer,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_NULL
+/// @brief convert a JSON value to a string, using AQL's string conversion
+/// rules. the result is written into the buffer
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsNull (triagens::arango::AqlTransaction* trx,
-                            TRI_document_collection_t const* collection,
-                            AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isNull()));
+static void ValueToString (triagens::basics::StringBuffer& buffer,
+                           TRI_json_t const* json) {
+  if (IsNullValue(json)) {
+    buffer.appendText("null", strlen("null"));
+    return;
+  }
+
+  AppendAsString(buffer, json);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_BOOL
+/// @brief convert a string into a number, using JavaScript's Number() rules
+/// returns false if the string does not contain a valid finite number
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsBool (triagens::arango::AqlTransaction* trx,
-                            TRI_document_collection_t const* collection,
-                            AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isBoolean()));
-}
+static bool StringToNumber (char const* p,
+                            size_t length,
+                            double& result) {
+  char const* end = p + length;
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_NUMBER
-////////////////////////////////////////////////////////////////////////////////
+  // skip leading and trailing whitespace
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n' || *p == '\f' || *p == '\v')) {
+    ++p;
+  }
+  while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r' || end[-1] == '\n' || end[-1] == '\f' || end[-1] == '\v')) {
+    --end;
+  }
 
-AqlValue Functions::IsNumber (triagens::arango::AqlTransaction* trx,
-                              TRI_document_collection_t const* collection,
-                              AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isNumber()));
-}
+  if (p == end) {
+    // empty string or whitespace only
+    result = 0.0;
+    return true;
+  }
 
-////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_STRING
-////////////////////////////////////////////////////////////////////////////////
+  if (end - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) {
+    // hexadecimal number, without sign
+    double value = 0.0;
+    for (char const* q = p + 2; q < end; ++q) {
+      int digit;
+      if (*q >= '0' && *q <= '9') {
+        digit = *q - '0';
+      }
+      else if (*q >= 'a' && *q <= 'f') {
+        digit = *q - 'a' + 10;
+      }
+      else if (*q >= 'A' && *q <= 'F') {
+        digit = *q - 'A' + 10;
+      }
+      else {
+        return false;
+      }
+      value = value * 16.0 + digit;
+    }
+    result = value;
+    return std::isfinite(result);
+  }
 
-AqlValue Functions::IsString (triagens::arango::AqlTransaction* trx,
-                              TRI_document_collection_t const* collection,
-                              AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isString()));
+  // only allow the characters that can be part of a decimal number, so
+  // strtod's extensions (hex floats, "inf", "nan") are not accepted
+  for (char const* q = p; q < end; ++q) {
+    char c = *q;
+    if (! ((c >= '0' && c <= '9') || c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-')) {
+      return false;
+    }
+  }
+
+  std::string copy(p, end - p);
+  char* parsed = nullptr;
+  double value = strtod(copy.c_str(), &parsed);
+
+  if (parsed == nullptr ||
+      parsed != copy.c_str() + copy.size() ||
+      ! std::isfinite(value)) {
+    return false;
+  }
+
+  result = value;
+  return true;
 }
 
+
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_ARRAY
+/// @brief convert a JSON value into a boolean, using AQL's TO_BOOL rules
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsArray (triagens::arango::AqlTransaction* trx,
-                             TRI_document_collection_t const* collection,
-                             AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isArray()));
+static bool ValueToBoolean (TRI_json_t const* json) {
+  if (IsNullValue(json)) {
+    return false;
+  }
+
+  switch (json->_type) {
+    case TRI_JSON_BOOLEAN:
+      return json->_value._boolean;
+    case TRI_JSON_NUMBER:
+      return (json->_value._number != 0.0);
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE:
+      // the string length includes the NUL byte
+      return (json->_value._string.length > 1);
+    case TRI_JSON_ARRAY:
+    case TRI_JSON_OBJECT:
+      return true;
+    case TRI_JSON_UNUSED:
+    case TRI_JSON_NULL:
+      break;
+  }
+
+  return false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function IS_OBJECT
+/// @brief convert a number into an integer, using JavaScript's ToInteger rules
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::IsObject (triagens::arango::AqlTransaction* trx,
-                              TRI_document_collection_t const* collection,
-                              AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-  return AqlValue(new Json(j.isObject()));
+static inline int64_t ToInteger (double value) {
+  if (value >= 9007199254740992.0) {
+    return INT64_C(9007199254740992);
+  }
+  if (value <= -9007199254740992.0) {
+    return INT64_C(-9007199254740992);
+  }
+  return static_cast<int64_t>(value);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function LENGTH
+/// @brief count the number of characters in a UTF-8 encoded string
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Length (triagens::arango::AqlTransaction* trx,
-                            TRI_document_collection_t const* collection,
-                            AqlValue const parameters) {
-  Json j(parameters.extractArrayMember(trx, collection, 0, false));
-
-  TRI_json_t const* json = j.json();
-  size_t length = 0;
-
-  if (json != nullptr) {
-    switch (json->_type) {
-      case TRI_JSON_UNUSED:
-      case TRI_JSON_NULL: {
-        length = 0;
-        break;
-      }
+static size_t Utf8Length (char const* p,
+                          size_t length) {
+  size_t chars = 0;
 
-      case TRI_JSON_BOOLEAN: {
-        length = (json->_value._boolean ? 1 : 0);
-        break;
-      }
+  for (size_t i = 0; i < length; ++i) {
+    if ((p[i] & 0xc0) != 0x80) {
+      ++chars;
+    }
+  }
 
-      case TRI_JSON_NUMBER: {
-        if (std::isnan(json->_value._number) ||
-            ! std::isfinite(json->_value._number)) {
-          // invalid value
-          length = strlen("null");
-        }
-        else {
-          // convert to a string representation of the number
-          char buffer[24];
-          length = static_cast<size_t>(fpconv_dtoa(json->_value._number, buffer));
-        }
-        break;
-      }
+  return chars;
+}
 
-      case TRI_JSON_STRING:
-      case TRI_JSON_STRING_REFERENCE: {
-        // return number of characters (not bytes) in string
-        length = TRI_CharLengthUtf8String(json->_value._string.data);
-        break;
-      }
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the byte offset of the n-th character in a UTF-8 encoded
+/// string. returns the string length if the string has less characters
+////////////////////////////////////////////////////////////////////////////////
 
-      case TRI_JSON_OBJECT: {
-        // return number of attributes
-        length = json->_value._objects._length / 2;
-        break;
-      }
+static size_t Utf8Offset (char const* p,
+                          size_t length,
+                          size_t n) {
+  size_t i = 0;
 
-      case TRI_JSON_ARRAY: {
-        // return list length
-        length = TRI_LengthArrayJson(json);
-        break;
+  while (i < length) {
+    if ((p[i] & 0xc0) != 0x80) {
+      if (n == 0) {
+        return i;
       }
+      --n;
     }
+    ++i;
   }
 
-  return AqlValue(new Json(static_cast<double>(length)));
+  return length;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function CONCAT
+/// @brief return a substring of a UTF-8 string, using character positions
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Concat (triagens::arango::AqlTransaction* trx,
-                            TRI_document_collection_t const* collection,
-                            AqlValue const parameters) {
-  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+static AqlValue Utf8Substring (char const* p,
+                               size_t length,
+                               size_t from,
+                               size_t to) {
+  if (to <= from) {
+    return StringValue("", 0);
+  }
 
-  size_t const n = parameters.arraySize();
+  size_t const start = Utf8Offset(p, length, from);
+  size_t const end   = start + Utf8Offset(p + start, length - start, to - from);
 
-  for (size_t i = 0; i < n; ++i) {
-    Json member = parameters.at(trx, i);
+  return StringValue(p + start, end - start);
+}
 
-    if (member.isEmpty() || member.isNull()) {
-      continue;
-    }
-      
-    TRI_json_t const* json = member.json();
-    
-    if (member.isArray()) {
-      // append each member individually
-      size_t const subLength = TRI_LengthArrayJson(json);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hash a value with the specified algorithm and return the result as
+/// a hex-encoded string
+////////////////////////////////////////////////////////////////////////////////
 
-      for (size_t j = 0; j < subLength; ++j) {
-        auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j));
+static AqlValue HashedString (TRI_json_t const* json,
+                              bool useSha1) {
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(buffer, json);
 
-        if (sub == nullptr || sub->_type == TRI_JSON_NULL) {
-          continue;
-        }
+  char hash[21];
+  char* p = &hash[0];
+  size_t length;
 
-        AppendAsString(buffer, sub);
-      }
-    }
-    else {
-      // convert member to a string and append
-      AppendAsString(buffer, json);
-    }
+  if (useSha1) {
+    triagens::rest::SslInterface::sslSHA1(buffer.c_str(), buffer.length(), p, length);
   }
-  
-  // steal the StringBuffer's char* pointer so we can avoid copying data around
-  // multiple times
-  size_t length = buffer.length();
-  TRI_json_t* j = TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, buffer.steal(), length);
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j));
+  else {
+    triagens::rest::SslInterface::sslMD5(buffer.c_str(), buffer.length(), p, length);
+    length = 16;
+  }
+
+  char hex[41];
+  p = &hex[0];
+  triagens::rest::SslInterface::sslHEX(hash, length, p, length);
+
+  return StringValue(hex, length);
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    date functions
+// -----------------------------------------------------------------------------
+
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief function PASSTHRU
+/// @brief maximum absolute timestamp value, as used by JavaScript dates
 ////////////////////////////////////////////////////////////////////////////////
 
-AqlValue Functions::Passthru (triagens::arango::AqlTransaction* trx,
-                              TRI_document_collection_t const* collection,
-                              AqlValue const parameters) {
+static double const MaxTimestamp = 8.64e15;
 
-  Json j(parameters.extractArrayMember(trx, collection, 0, true));
-  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of milliseconds per day
+////////////////////////////////////////////////////////////////////////////////
+
+static int64_t const MillisecondsPerDay = INT64_C(86400000);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief broken-down date
+////////////////////////////////////////////////////////////////////////////////
+
+struct DateParts {
+  int64_t year;
+  int month;       // 1 - 12
+  int day;         // 1 - 31
+  int hour;
+  int minute;
+  int second;
+  int millisecond;
+  int dayOfWeek;   // 0 = Sunday
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of days since 1970-01-01 for a (proleptic Gregorian) date
+////////////////////////////////////////////////////////////////////////////////
+
+static int64_t DaysFromCivil (int64_t year,
+                              int64_t month,
+                              int64_t day) {
+  year -= (month <= 2 ? 1 : 0);
+  int64_t const era = (year >= 0 ? year : year - 399) / 400;
+  int64_t const yoe = year - era * 400;
+  int64_t const doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int64_t const doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+  return era * 146097 + doe - 719468;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief split a timestamp (milliseconds since 1970-01-01) into date parts
+////////////////////////////////////////////////////////////////////////////////
+
+static DateParts SplitTimestamp (int64_t timestamp) {
+  int64_t days = timestamp / MillisecondsPerDay;
+  int64_t ms   = timestamp % MillisecondsPerDay;
+
+  if (ms < 0) {
+    ms += MillisecondsPerDay;
+    --days;
+  }
+
+  DateParts parts;
+  parts.dayOfWeek   = static_cast<int>(((days % 7) + 11) % 7);
+  parts.hour        = static_cast<int>(ms / 3600000);
+  parts.minute      = static_cast<int>((ms / 60000) % 60);
+  parts.second      = static_cast<int>((ms / 1000) % 60);
+  parts.millisecond = static_cast<int>(ms % 1000);
+
+  days += 719468;
+  int64_t const era = (days >= 0 ? days : days - 146096) / 146097;
+  int64_t const doe = days - era * 146097;
+  int64_t const yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  int64_t const doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  int64_t const mp  = (5 * doy + 2) / 153;
+
+  parts.day   = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+  parts.month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+  parts.year  = yoe + era * 400 + (parts.month <= 2 ? 1 : 0);
+
+  return parts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marker for a date component that was not specified
+////////////////////////////////////////////////////////////////////////////////
+
+static int const DateNone = INT32_MAX;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief words with a special meaning in date strings
+////////////////////////////////////////////////////////////////////////////////
+
+enum DateKeyword {
+  DATE_KEYWORD_NONE,
+  DATE_KEYWORD_MONTH_NAME,
+  DATE_KEYWORD_AM_PM,
+  DATE_KEYWORD_TIME_ZONE_NAME,
+  DATE_KEYWORD_TIME_SEPARATOR
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief keyword table, identical to the one of the V8 date parser. words
+/// are matched by their (lower-cased) first three characters, only month
+/// names may be longer than that
+////////////////////////////////////////////////////////////////////////////////
+
+static struct {
+  char const prefix[4];
+  DateKeyword const type;
+  int const value;
+}
+DateKeywords[] = {
+  { "jan", DATE_KEYWORD_MONTH_NAME, 1 },
+  { "feb", DATE_KEYWORD_MONTH_NAME, 2 },
+  { "mar", DATE_KEYWORD_MONTH_NAME, 3 },
+  { "apr", DATE_KEYWORD_MONTH_NAME, 4 },
+  { "may", DATE_KEYWORD_MONTH_NAME, 5 },
+  { "jun", DATE_KEYWORD_MONTH_NAME, 6 },
+  { "jul", DATE_KEYWORD_MONTH_NAME, 7 },
+  { "aug", DATE_KEYWORD_MONTH_NAME, 8 },
+  { "sep", DATE_KEYWORD_MONTH_NAME, 9 },
+  { "oct", DATE_KEYWORD_MONTH_NAME, 10 },
+  { "nov", DATE_KEYWORD_MONTH_NAME, 11 },
+  { "dec", DATE_KEYWORD_MONTH_NAME, 12 },
+  { "am", DATE_KEYWORD_AM_PM, 0 },
+  { "pm", DATE_KEYWORD_AM_PM, 12 },
+  { "ut", DATE_KEYWORD_TIME_ZONE_NAME, 0 },
+  { "utc", DATE_KEYWORD_TIME_ZONE_NAME, 0 },
+  { "z", DATE_KEYWORD_TIME_ZONE_NAME, 0 },
+  { "gmt", DATE_KEYWORD_TIME_ZONE_NAME, 0 },
+  { "cdt", DATE_KEYWORD_TIME_ZONE_NAME, -5 },
+  { "cst", DATE_KEYWORD_TIME_ZONE_NAME, -6 },
+  { "edt", DATE_KEYWORD_TIME_ZONE_NAME, -4 },
+  { "est", DATE_KEYWORD_TIME_ZONE_NAME, -5 },
+  { "mdt", DATE_KEYWORD_TIME_ZONE_NAME, -6 },
+  { "mst", DATE_KEYWORD_TIME_ZONE_NAME, -7 },
+  { "pdt", DATE_KEYWORD_TIME_ZONE_NAME, -7 },
+  { "pst", DATE_KEYWORD_TIME_ZONE_NAME, -8 },
+  { "t", DATE_KEYWORD_TIME_SEPARATOR, 0 }
+};
+
+static inline bool IsDateMonth (int n)       { return n >= 1 && n <= 12; }
+static inline bool IsDateDay (int n)         { return n >= 1 && n <= 31; }
+static inline bool IsDateHour (int n)        { return n >= 0 && n <= 23; }
+static inline bool IsDateMinute (int n)      { return n >= 0 && n <= 59; }
+static inline bool IsDateSecond (int n)      { return n >= 0 && n <= 59; }
+static inline bool IsDateMillisecond (int n) { return n >= 0 && n <= 999; }
+static inline bool IsDateHour12 (int n)      { return n >= 0 && n <= 12; }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief token of a date string
+////////////////////////////////////////////////////////////////////////////////
+
+struct DateToken {
+  enum Type {
+    END_OF_INPUT,
+    NUMBER,
+    SYMBOL,
+    WHITESPACE,
+    WORD,
+    UNKNOWN,
+    INVALID
+  };
+
+  bool isEndOfInput () const {
+    return type == END_OF_INPUT;
+  }
+
+  bool isNumber () const {
+    return type == NUMBER;
+  }
+
+  bool isFixedLengthNumber (int n) const {
+    return type == NUMBER && length == n;
+  }
+
+  bool isSymbol (char c) const {
+    return type == SYMBOL && value == c;
+  }
+
+  bool isSign () const {
+    return isSymbol('+') || isSymbol('-');
+  }
+
+  int sign () const {
+    return (value == '-' ? -1 : 1);
+  }
+
+  bool isWhitespace () const {
+    return type == WHITESPACE;
+  }
+
+  bool isKeyword (DateKeyword k) const {
+    return type == WORD && keyword == k;
+  }
+
+  bool isUnknownWord () const {
+    return type == WORD && keyword == DATE_KEYWORD_NONE;
+  }
+
+  bool isKeywordZ () const {
+    return isKeyword(DATE_KEYWORD_TIME_ZONE_NAME) && length == 1 && value == 0;
+  }
+
+  Type type;
+  DateKeyword keyword;
+  int value;     // number, symbol character or keyword value
+  int length;    // number of characters
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief date string tokenizer with one token lookahead
+////////////////////////////////////////////////////////////////////////////////
+
+class DateTokenizer {
+  public:
+
+    DateTokenizer (char const* p,
+                   char const* end)
+      : _p(p),
+        _end(end),
+        _next(scan()) {
+    }
+
+    DateToken next () {
+      DateToken token = _next;
+      _next = scan();
+      return token;
+    }
+
+    DateToken const& peek () const {
+      return _next;
+    }
+
+    bool skipSymbol (char c) {
+      if (_next.isSymbol(c)) {
+        next();
+        return true;
+      }
+      return false;
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief read the digits following a '.' as milliseconds
+    ////////////////////////////////////////////////////////////////////////////////
+
+    static int readMilliseconds (DateToken const& token) {
+      int number = token.value;
+      // only the first 9 digits of a number are read
+      int length = std::min(token.length, 9);
+
+      // use the three most significant digits, 1 -> 100, 12 -> 120
+      for (; length < 3; ++length) {
+        number *= 10;
+      }
+      for (; length > 3; --length) {
+        number /= 10;
+      }
+
+      return number;
+    }
+
+  private:
+
+    DateToken scan () {
+      DateToken token;
+      token.keyword = DATE_KEYWORD_NONE;
+      token.value = 0;
+      token.length = 0;
+
+      if (_p >= _end) {
+        token.type = DateToken::END_OF_INPUT;
+        return token;
+      }
+
+      char const c = *_p;
+
+      if (c >= '0' && c <= '9') {
+        // numbers are cut off after 9 significant digits
+        while (_p < _end && *_p >= '0' && *_p <= '9') {
+          if (token.length < 9) {
+            token.value = token.value * 10 + (*_p - '0');
+          }
+          ++token.length;
+          ++_p;
+        }
+        token.type = DateToken::NUMBER;
+        return token;
+      }
+
+      if (c == ':' || c == '-' || c == '+' || c == '.' || c == ')') {
+        ++_p;
+        token.type = DateToken::SYMBOL;
+        token.value = c;
+        token.length = 1;
+        return token;
+      }
+
+      if (static_cast<unsigned char>(c) >= 'A') {
+        char prefix[3] = { '\0', '\0', '\0' };
+
+        while (_p < _end && static_cast<unsigned char>(*_p) >= 'A') {
+          if (token.length < 3) {
+            prefix[token.length] = static_cast<char>(*_p | 0x20);
+          }
+          ++token.length;
+          ++_p;
+        }
+
+        token.type = DateToken::WORD;
+
+        for (auto const& keyword : DateKeywords) {
+          if (prefix[0] == keyword.prefix[0] &&
+              prefix[1] == keyword.prefix[1] &&
+              prefix[2] == keyword.prefix[2] &&
+              (token.length <= 3 || keyword.type == DATE_KEYWORD_MONTH_NAME)) {
+            token.keyword = keyword.type;
+            token.value = keyword.value;
+            break;
+          }
+        }
+        return token;
+      }
+
+      if (c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r') {
+        ++_p;
+        token.type = DateToken::WHITESPACE;
+        token.length = 1;
+        return token;
+      }
+
+      if (c == '(') {
+        // skip parenthesized text
+        int balance = 0;
+        do {
+          if (*_p == ')') {
+            --balance;
+          }
+          else if (*_p == '(') {
+            ++balance;
+          }
+          ++_p;
+        }
+        while (balance > 0 && _p < _end);
+      }
+      else {
+        ++_p;
+      }
+
+      token.type = DateToken::UNKNOWN;
+      return token;
+    }
+
+    char const* _p;
+    char const* _end;
+    DateToken _next;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collects the day components of a date string
+////////////////////////////////////////////////////////////////////////////////
+
+struct DateDayComposer {
+  DateDayComposer ()
+    : index(0),
+      namedMonth(DateNone),
+      isIsoDate(false) {
+  }
+
+  bool isEmpty () const {
+    return index == 0;
+  }
+
+  bool add (int n) {
+    if (index < 3) {
+      comp[index++] = n;
+      return true;
+    }
+    return false;
+  }
+
+  bool write (int& year,
+              int& month,
+              int& day) {
+    // the year defaults to 0, i.e. 2000
+    year = 0;
+
+    if (index < 1) {
+      return false;
+    }
+
+    // day and month default to 1
+    while (index < 3) {
+      comp[index++] = 1;
+    }
+
+    if (namedMonth == DateNone) {
+      if (isIsoDate || (index == 3 && ! IsDateDay(comp[0]))) {
+        // YMD
+        year = comp[0];
+        month = comp[1];
+        day = comp[2];
+      }
+      else {
+        // MD(Y)
+        month = comp[0];
+        day = comp[1];
+        if (index == 3) {
+          year = comp[2];
+        }
+      }
+    }
+    else {
+      month = namedMonth;
+      if (index == 1) {
+        // MD or DM
+        day = comp[0];
+      }
+      else if (! IsDateDay(comp[0])) {
+        // YMD, MYD, or YDM
+        year = comp[0];
+        day = comp[1];
+      }
+      else {
+        // DMY, MDY, or DYM
+        day = comp[0];
+        year = comp[1];
+      }
+    }
+
+    if (! isIsoDate) {
+      if (year >= 0 && year <= 49) {
+        year += 2000;
+      }
+      else if (year >= 50 && year <= 99) {
+        year += 1900;
+      }
+    }
+
+    return IsDateMonth(month) && IsDateDay(day);
+  }
+
+  int comp[3];
+  int index;
+  int namedMonth;
+  bool isIsoDate;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collects the time components of a date string
+////////////////////////////////////////////////////////////////////////////////
+
+struct DateTimeComposer {
+  DateTimeComposer ()
+    : index(0),
+      hourOffset(DateNone) {
+  }
+
+  bool isEmpty () const {
+    return index == 0;
+  }
+
+  bool isExpecting (int n) const {
+    return (index == 1 && IsDateMinute(n)) ||
+           (index == 2 && IsDateSecond(n)) ||
+           (index == 3 && IsDateMillisecond(n));
+  }
+
+  bool add (int n) {
+    if (index < 4) {
+      comp[index++] = n;
+      return true;
+    }
+    return false;
+  }
+
+  bool addFinal (int n) {
+    if (! add(n)) {
+      return false;
+    }
+    while (index < 4) {
+      comp[index++] = 0;
+    }
+    return true;
+  }
+
+  bool write (int& hour,
+              int& minute,
+              int& second,
+              int& millisecond) {
+    while (index < 4) {
+      comp[index++] = 0;
+    }
+
+    hour = comp[0];
+    minute = comp[1];
+    second = comp[2];
+    millisecond = comp[3];
+
+    if (hourOffset != DateNone) {
+      if (! IsDateHour12(hour)) {
+        return false;
+      }
+      hour %= 12;
+      hour += hourOffset;
+    }
+
+    return IsDateHour(hour) &&
+           IsDateMinute(minute) &&
+           IsDateSecond(second) &&
+           IsDateMillisecond(millisecond);
+  }
+
+  int comp[4];
+  int index;
+  int hourOffset;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collects the timezone of a date string
+////////////////////////////////////////////////////////////////////////////////
+
+struct DateTimeZoneComposer {
+  DateTimeZoneComposer ()
+    : sign(DateNone),
+      hour(DateNone),
+      minute(DateNone) {
+  }
+
+  void set (int offsetHours) {
+    sign = (offsetHours < 0 ? -1 : 1);
+    hour = offsetHours * sign;
+    minute = 0;
+  }
+
+  void setSign (int value) {
+    sign = (value < 0 ? -1 : 1);
+  }
+
+  bool isExpecting (int n) const {
+    return hour != DateNone && minute == DateNone && IsDateMinute(n);
+  }
+
+  bool isUTC () const {
+    return hour == 0 && minute == 0;
+  }
+
+  bool isEmpty () const {
+    return hour == DateNone;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// @brief the offset of the timezone to UTC in milliseconds. V8 would use
+  /// the local timezone for dates without one, but ParseDateValue appends a
+  /// timezone to almost all strings, so the remaining ones are taken as UTC
+  ////////////////////////////////////////////////////////////////////////////////
+
+  bool write (int64_t& offset) const {
+    offset = 0;
+
+    if (sign != DateNone) {
+      int64_t const h = (hour == DateNone ? 0 : hour);
+      int64_t const m = (minute == DateNone ? 0 : minute);
+      int64_t const seconds = h * 3600 + m * 60;
+
+      if (seconds > INT32_MAX) {
+        return false;
+      }
+      offset = sign * seconds * INT64_C(1000);
+    }
+
+    return true;
+  }
+
+  int sign;
+  int hour;
+  int minute;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse the ES5 ISO 8601 date time string format
+/// [('-'|'+')yy]yyyy[-MM[-DD]][THH:mm[:ss[.sss]][Z|(+|-)hh[:]mm]]
+/// returns the token at which the legacy parser has to continue if the
+/// string does not fully match the format, or an invalid token if the
+/// string cannot be a date
+////////////////////////////////////////////////////////////////////////////////
+
+static DateToken ParseDateES5 (DateTokenizer& scanner,
+                               DateDayComposer& day,
+                               DateTimeComposer& time,
+                               DateTimeZoneComposer& tz) {
+  DateToken invalid;
+  invalid.type = DateToken::INVALID;
+  invalid.keyword = DATE_KEYWORD_NONE;
+  invalid.value = 0;
+  invalid.length = 0;
+
+  if (scanner.peek().isSign()) {
+    // extended years have a sign and exactly six digits
+    DateToken const sign = scanner.next();
+    if (! scanner.peek().isFixedLengthNumber(6)) {
+      return sign;
+    }
+    int const year = scanner.next().value;
+    if (sign.sign() < 0 && year == 0) {
+      return sign;
+    }
+    day.add(sign.sign() * year);
+  }
+  else if (scanner.peek().isFixedLengthNumber(4)) {
+    day.add(scanner.next().value);
+  }
+  else {
+    return scanner.next();
+  }
+
+  if (scanner.skipSymbol('-')) {
+    if (! scanner.peek().isFixedLengthNumber(2) ||
+        ! IsDateMonth(scanner.peek().value)) {
+      return scanner.next();
+    }
+    day.add(scanner.next().value);
+
+    if (scanner.skipSymbol('-')) {
+      if (! scanner.peek().isFixedLengthNumber(2) ||
+          ! IsDateDay(scanner.peek().value)) {
+        return scanner.next();
+      }
+      day.add(scanner.next().value);
+    }
+  }
+
+  // check for optional time
+  if (! scanner.peek().isKeyword(DATE_KEYWORD_TIME_SEPARATOR)) {
+    if (! scanner.peek().isEndOfInput()) {
+      return scanner.next();
+    }
+  }
+  else {
+    // ES5 date time string continues with the time
+    scanner.next();
+
+    if (! scanner.peek().isFixedLengthNumber(2) ||
+        scanner.peek().value > 24) {
+      return invalid;
+    }
+    // 24 passes here only if the rest of the time is zero, but is then
+    // rejected when the time is written, as V8 does
+    bool const hourIs24 = (scanner.peek().value == 24);
+    time.add(scanner.next().value);
+
+    if (! scanner.skipSymbol(':')) {
+      return invalid;
+    }
+    if (! scanner.peek().isFixedLengthNumber(2) ||
+        ! IsDateMinute(scanner.peek().value) ||
+        (hourIs24 && scanner.peek().value > 0)) {
+      return invalid;
+    }
+    time.add(scanner.next().value);
+
+    if (scanner.skipSymbol(':')) {
+      if (! scanner.peek().isFixedLengthNumber(2) ||
+          ! IsDateSecond(scanner.peek().value) ||
+          (hourIs24 && scanner.peek().value > 0)) {
+        return invalid;
+      }
+      time.add(scanner.next().value);
+
+      if (scanner.skipSymbol('.')) {
+        if (! scanner.peek().isNumber() ||
+            (hourIs24 && scanner.peek().value > 0)) {
+          return invalid;
+        }
+        // more or less than three digits are allowed
+        time.add(DateTokenizer::readMilliseconds(scanner.next()));
+      }
+    }
+
+    // check for optional timezone designation
+    if (scanner.peek().isKeywordZ()) {
+      scanner.next();
+      tz.set(0);
+    }
+    else if (scanner.peek().isSign()) {
+      tz.setSign(scanner.next().sign());
+
+      if (scanner.peek().isFixedLengthNumber(4)) {
+        // hhmm extension
+        int const hourMinute = scanner.next().value;
+        if (! IsDateHour(hourMinute / 100) || ! IsDateMinute(hourMinute % 100)) {
+          return invalid;
+        }
+        tz.hour = hourMinute / 100;
+        tz.minute = hourMinute % 100;
+      }
+      else {
+        if (! scanner.peek().isFixedLengthNumber(2) ||
+            ! IsDateHour(scanner.peek().value)) {
+          return invalid;
+        }
+        tz.hour = scanner.next().value;
+
+        if (! scanner.skipSymbol(':') ||
+            ! scanner.peek().isFixedLengthNumber(2) ||
+            ! IsDateMinute(scanner.peek().value)) {
+          return invalid;
+        }
+        tz.minute = scanner.next().value;
+      }
+    }
+
+    if (! scanner.peek().isEndOfInput()) {
+      return invalid;
+    }
+  }
+
+  // successfully parsed an ES5 date time string, which defaults to UTC
+  if (tz.isEmpty()) {
+    tz.set(0);
+  }
+  day.isIsoDate = true;
+
+  return scanner.next();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a date string into a timestamp, accepting the same strings
+/// as JavaScript's Date constructor in V8: ES5 ISO 8601 strings and, as a
+/// fallback, the legacy formats such as "Mar 25 2015 10:00 PM GMT+0100"
+/// or "2015/03/25". returns false if the string is not a valid date
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ParseDateString (char const* p,
+                             size_t length,
+                             double& result) {
+  DateTokenizer scanner(p, p + length);
+  DateDayComposer day;
+  DateTimeComposer time;
+  DateTimeZoneComposer tz;
+
+  DateToken const next = ParseDateES5(scanner, day, time, tz);
+
+  if (next.type == DateToken::INVALID) {
+    return false;
+  }
+
+  // anything left is parsed with the legacy rules: unrecognized words before
+  // the first number and parenthesized text are ignored, a number followed by
+  // ':' starts the time, other numbers are day components, and a sign after
+  // a time or "UTC" starts a timezone offset
+  bool hasReadNumber = ! day.isEmpty();
+
+  for (DateToken token = next; ! token.isEndOfInput(); token = scanner.next()) {
+    if (token.isNumber()) {
+      hasReadNumber = true;
+      int const n = token.value;
+
+      if (scanner.skipSymbol(':')) {
+        if (scanner.skipSymbol(':')) {
+          // n + "::"
+          if (! time.isEmpty()) {
+            return false;
+          }
+          time.add(n);
+          time.add(0);
+        }
+        else {
+          // n + ":"
+          if (! time.add(n)) {
+            return false;
+          }
+          if (scanner.peek().isSymbol('.')) {
+            scanner.next();
+          }
+        }
+      }
+      else if (scanner.skipSymbol('.') && time.isExpecting(n)) {
+        time.add(n);
+        if (! scanner.peek().isNumber()) {
+          return false;
+        }
+        time.addFinal(DateTokenizer::readMilliseconds(scanner.next()));
+      }
+      else if (tz.isExpecting(n)) {
+        tz.minute = n;
+      }
+      else if (time.isExpecting(n)) {
+        time.addFinal(n);
+        // require end, whitespace, "Z", "+" or "-" immediately after
+        // finalizing the time
+        DateToken const& peek = scanner.peek();
+        if (! peek.isEndOfInput() &&
+            ! peek.isWhitespace() &&
+            ! peek.isKeywordZ() &&
+            ! peek.isSign()) {
+          return false;
+        }
+      }
+      else {
+        if (! day.add(n)) {
+          return false;
+        }
+        scanner.skipSymbol('-');
+      }
+    }
+    else if (token.type == DateToken::WORD) {
+      if (token.isKeyword(DATE_KEYWORD_AM_PM) && ! time.isEmpty()) {
+        time.hourOffset = token.value;
+      }
+      else if (token.isKeyword(DATE_KEYWORD_MONTH_NAME)) {
+        day.namedMonth = token.value;
+        scanner.skipSymbol('-');
+      }
+      else if (token.isKeyword(DATE_KEYWORD_TIME_ZONE_NAME) && hasReadNumber) {
+        tz.set(token.value);
+      }
+      else {
+        // garbage words are illegal if a number has been read
+        if (hasReadNumber) {
+          return false;
+        }
+        // the first number has to be separated from garbage words by
+        // whitespace or other separators
+        if (scanner.peek().isNumber()) {
+          return false;
+        }
+      }
+    }
+    else if (token.isSign() && (tz.isUTC() || ! time.isEmpty())) {
+      // parse UTC offset (only after UTC or time)
+      tz.setSign(token.sign());
+      // the following number may be empty
+      int n = 0;
+      if (scanner.peek().isNumber()) {
+        n = scanner.next().value;
+      }
+      hasReadNumber = true;
+
+      if (scanner.peek().isSymbol(':')) {
+        tz.hour = n;
+        tz.minute = DateNone;
+      }
+      else {
+        tz.hour = n / 100;
+        tz.minute = n % 100;
+      }
+    }
+    else if ((token.isSymbol(')') || token.isSign()) && hasReadNumber) {
+      // extra sign or ')' is illegal if a number has been read
+      return false;
+    }
+    // ignore other characters and whitespace
+  }
+
+  int year = 0, month = 0, dayOfMonth = 0;
+  int hour = 0, minute = 0, second = 0, millisecond = 0;
+  int64_t offset = 0;
+
+  if (! day.write(year, month, dayOfMonth) ||
+      ! time.write(hour, minute, second, millisecond) ||
+      ! tz.write(offset)) {
+    return false;
+  }
+
+  // compute in doubles, years may be far outside the valid timestamp range
+  double const days = static_cast<double>(DaysFromCivil(year, month, 1)) + dayOfMonth - 1;
+  result = days * static_cast<double>(MillisecondsPerDay) +
+           hour * 3600000.0 +
+           minute * 60000.0 +
+           second * 1000.0 +
+           millisecond -
+           static_cast<double>(offset);
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a string ends with a timezone offset, i.e. matches
+/// /[+\-]\d+(:\d+)?$/, or /-\d+(:\d+)?$/ if plus is false
+////////////////////////////////////////////////////////////////////////////////
+
+static bool EndsWithOffset (char const* p,
+                            size_t length,
+                            bool plus) {
+  size_t i = length;
+
+  for (int part = 0; part < 2; ++part) {
+    size_t const digitsEnd = i;
+    while (i > 0 && p[i - 1] >= '0' && p[i - 1] <= '9') {
+      --i;
+    }
+    if (i == digitsEnd || i == 0) {
+      return false;
+    }
+    if (p[i - 1] == '-' || (plus && p[i - 1] == '+')) {
+      return true;
+    }
+    if (part == 0 && p[i - 1] == ':') {
+      // digits after a colon, there must be a sign before the hours
+      --i;
+      continue;
+    }
+    break;
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a date string as MAKE_DATE does in JavaScript: "Z" is
+/// appended to strings that end in neither a "Z" nor an offset, and to date
+/// only strings ending in something like "-01" or "-1:00", so dates without
+/// timezone are interpreted as UTC. the string is then parsed as V8 does
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ParseDateValue (char const* p,
+                            size_t length,
+                            double& result) {
+  bool appendZ;
+
+  if (length > 0 && (p[length - 1] == 'z' || p[length - 1] == 'Z')) {
+    appendZ = false;
+  }
+  else {
+    appendZ = ! EndsWithOffset(p, length, true);
+  }
+
+  if (! appendZ && EndsWithOffset(p, length, false)) {
+    appendZ = (memchr(p, 'T', length) == nullptr &&
+               memchr(p, 't', length) == nullptr &&
+               memchr(p, ' ', length) == nullptr);
+  }
+
+  if (! appendZ) {
+    return ParseDateString(p, length, result);
+  }
+
+  std::string value(p, length);
+  value.push_back('Z');
+
+  return ParseDateString(value.c_str(), value.size(), result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a timestamp from the function arguments, using the same rules
+/// as the JavaScript implementation. the result is NaN for invalid dates.
+/// returns false and registers a warning if the arguments are invalid
+////////////////////////////////////////////////////////////////////////////////
+
+static bool MakeDateValue (Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const& parameters,
+                           char const* functionName,
+                           double& result) {
+  size_t const n = parameters.arraySize();
+
+  if (n == 1) {
+    Json value(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+    TRI_json_t const* json = value.json();
+
+    if (json != nullptr && json->_type == TRI_JSON_NUMBER) {
+      result = json->_value._number;
+    }
+    else if (IsStringValue(json)) {
+      if (! ParseDateValue(json->_value._string.data, json->_value._string.length - 1, result)) {
+        result = NAN;
+      }
+    }
+    else {
+      RegisterWarning(query, functionName, TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      return false;
+    }
+  }
+  else {
+    if (n < 3) {
+      RegisterWarning(query, functionName, TRI_ERROR_QUERY_FUNCTION_ARGUMENT_NUMBER_MISMATCH);
+      return false;
+    }
+
+    // year, month, day, hour, minute, second, millisecond
+    double components[7] = { 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0 };
+
+    for (size_t i = 0; i < n && i < 7; ++i) {
+      Json value(ExtractFunctionParameter(trx, collection, parameters, i, false));
+      TRI_json_t const* json = value.json();
+      double component = 0.0;
+
+      if (IsNullValue(json)) {
+        component = 0.0;
+      }
+      else if (IsStringValue(json)) {
+        // parseInt() semantics
+        char* end = nullptr;
+        errno = 0;
+        long long parsed = strtoll(json->_value._string.data, &end, 10);
+        if (end == json->_value._string.data || errno != 0) {
+          component = NAN;
+        }
+        else {
+          component = static_cast<double>(parsed);
+        }
+      }
+      else if (json->_type == TRI_JSON_NUMBER) {
+        component = json->_value._number;
+      }
+      else {
+        RegisterWarning(query, functionName, TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+        return false;
+      }
+
+      if (component < 0.0) {
+        RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+        return false;
+      }
+
+      if (i == 1) {
+        // months are 1-based in AQL
+        component -= 1.0;
+      }
+
+      components[i] = component;
+    }
+
+    for (size_t i = 0; i < 7; ++i) {
+      if (std::isnan(components[i]) || ! std::isfinite(components[i])) {
+        result = NAN;
+        return true;
+      }
+      components[i] = static_cast<double>(ToInteger(components[i]));
+    }
+
+    double year = components[0];
+    if (year >= 0.0 && year <= 99.0) {
+      // Date.UTC maps two-digit years to the 20th century
+      year += 1900.0;
+    }
+
+    // normalize months, days will be handled by the day arithmetic below
+    double const month = components[1];
+    year += std::floor(month / 12.0);
+    double const normalizedMonth = std::fmod(month, 12.0);
+
+    if (std::fabs(year) > 400000.0) {
+      result = NAN;
+      return true;
+    }
+
+    int64_t const days = DaysFromCivil(static_cast<int64_t>(year), static_cast<int64_t>(normalizedMonth) + 1, 1);
+    result = (static_cast<double>(days) + components[2] - 1.0) * static_cast<double>(MillisecondsPerDay) +
+             components[3] * 3600000.0 +
+             components[4] * 60000.0 +
+             components[5] * 1000.0 +
+             components[6];
+  }
+
+  if (std::isnan(result) || std::fabs(result) > MaxTimestamp) {
+    result = NAN;
+  }
+  else {
+    result = static_cast<double>(ToInteger(result));
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a timestamp from the function arguments. if the arguments
+/// are invalid, an invalid date value warning is registered in addition to
+/// the specific one, as the JavaScript date functions do
+////////////////////////////////////////////////////////////////////////////////
+
+static bool MakeDate (Query* query,
+                      triagens::arango::AqlTransaction* trx,
+                      TRI_document_collection_t const* collection,
+                      AqlValue const& parameters,
+                      char const* functionName,
+                      double& result) {
+  if (! MakeDateValue(query, trx, collection, parameters, functionName, result)) {
+    RegisterWarning(query, functionName, TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return false;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract one part of a date
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue DatePart (Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const& parameters,
+                          char const* functionName,
+                          std::function<double(DateParts const&)> const& extract) {
+  AqlValue single(new Json(Json::Array, 1));
+
+  try {
+    // only the first parameter is used
+    single._json->add(ExtractFunctionParameter(trx, collection, parameters, 0, true));
+
+    double timestamp;
+    if (! MakeDate(query, trx, collection, single, functionName, timestamp) ||
+        std::isnan(timestamp)) {
+      single.destroy();
+      return NullValue();
+    }
+
+    single.destroy();
+    return NumberValue(extract(SplitTimestamp(static_cast<int64_t>(timestamp))));
+  }
+  catch (...) {
+    single.destroy();
+    throw;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an example list (as used by EDGES and NEIGHBORS)
+/// matches a document. a missing or empty example list matches everything
+////////////////////////////////////////////////////////////////////////////////
+
+static bool MatchesExamples (Query* query,
+                             TRI_json_t const* document,
+                             TRI_json_t const* examples) {
+  if (examples == nullptr ||
+      examples->_type == TRI_JSON_UNUSED ||
+      examples->_type == TRI_JSON_NULL ||
+      (TRI_IsArrayJson(examples) && TRI_LengthArrayJson(examples) == 0)) {
+    return true;
+  }
+
+  if (! TRI_IsObjectJson(document)) {
+    return false;
+  }
+
+  size_t const n = (TRI_IsArrayJson(examples) ? TRI_LengthArrayJson(examples) : 1);
+
+  for (size_t i = 0; i < n; ++i) {
+    TRI_json_t const* example = examples;
+    if (TRI_IsArrayJson(examples)) {
+      example = static_cast<TRI_json_t const*>(TRI_AtVector(&examples->_value._objects, i));
+    }
+
+    if (! TRI_IsObjectJson(example)) {
+      RegisterWarning(query, "MATCHES", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      continue;
+    }
+
+    bool matches = true;
+    size_t const m = example->_value._objects._length;
+
+    for (size_t j = 0; j < m; j += 2) {
+      auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&example->_value._objects, j));
+      auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&example->_value._objects, j + 1));
+
+      if (TRI_CompareValuesJson(TRI_LookupObjectJson(document, key->_value._string.data), value, true) != 0) {
+        matches = false;
+        break;
+      }
+    }
+
+    if (matches) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up the edge collection for a graph function
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_document_collection_t* GetEdgeCollection (triagens::arango::AqlTransaction* trx,
+                                                     TRI_json_t const* name) {
+  TRI_voc_cid_t cid = 0;
+
+  if (IsStringValue(name)) {
+    cid = trx->resolver()->getCollectionId(std::string(name->_value._string.data, name->_value._string.length - 1));
+  }
+
+  if (cid == 0) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND);
+  }
+
+  TRI_transaction_collection_t* trxCollection = trx->trxCollection(cid);
+
+  if (trxCollection == nullptr ||
+      trxCollection->_collection == nullptr ||
+      trxCollection->_collection->_collection == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_TRANSACTION_UNREGISTERED_COLLECTION);
+  }
+
+  TRI_document_collection_t* document = trxCollection->_collection->_collection;
+
+  if (document->_info._type != TRI_COL_TYPE_EDGE) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_ARANGO_COLLECTION_TYPE_INVALID);
+  }
+
+  return document;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a vertex into a vertex id, using the same rules as the
+/// JavaScript TO_ID function
+////////////////////////////////////////////////////////////////////////////////
+
+static Json VertexToId (TRI_json_t const* vertex,
+                        TRI_json_t const* collection) {
+  if (TRI_IsObjectJson(vertex)) {
+    TRI_json_t const* id = TRI_LookupObjectJson(vertex, TRI_VOC_ATTRIBUTE_ID);
+
+    if (id != nullptr) {
+      return Json(TRI_UNKNOWN_MEM_ZONE, TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, id));
+    }
+  }
+  else if (IsStringValue(vertex) &&
+           strchr(vertex->_value._string.data, '/') == nullptr &&
+           IsStringValue(collection)) {
+    std::string id(collection->_value._string.data, collection->_value._string.length - 1);
+    id.push_back('/');
+    id.append(vertex->_value._string.data, vertex->_value._string.length - 1);
+    return Json(TRI_UNKNOWN_MEM_ZONE, id);
+  }
+
+  if (vertex == nullptr) {
+    return Json(Json::Null);
+  }
+
+  return Json(TRI_UNKNOWN_MEM_ZONE, TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, vertex));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a vertex handle (id string or document with an _id)
+////////////////////////////////////////////////////////////////////////////////
+
+static int ParseVertexHandle (Traverser const& traverser,
+                              TRI_json_t const* vertex,
+                              Traverser::VertexId& id) {
+  if (TRI_IsObjectJson(vertex)) {
+    vertex = TRI_LookupObjectJson(vertex, TRI_VOC_ATTRIBUTE_ID);
+  }
+
+  if (! IsStringValue(vertex)) {
+    return TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD;
+  }
+
+  return traverser.parseVertexId(vertex->_value._string.data, id);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract the vertices to look up edges for. an array of vertices
+/// ignores invalid members, a single invalid vertex is an error. this is the
+/// same behavior as the collection's edges(), inEdges() and outEdges()
+////////////////////////////////////////////////////////////////////////////////
+
+static void ExtractVertexIds (Traverser const& traverser,
+                              TRI_json_t const* vertices,
+                              std::vector<Traverser::VertexId>& result) {
+  Traverser::VertexId id;
+
+  if (TRI_IsArrayJson(vertices)) {
+    size_t const n = TRI_LengthArrayJson(vertices);
+
+    for (size_t i = 0; i < n; ++i) {
+      auto vertex = static_cast<TRI_json_t const*>(TRI_AtVector(&vertices->_value._objects, i));
+
+      if (ParseVertexHandle(traverser, vertex, id) == TRI_ERROR_NO_ERROR) {
+        result.emplace_back(id);
+      }
+    }
+    return;
+  }
+
+  int res = ParseVertexHandle(traverser, vertices, id);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  result.emplace_back(id);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse the direction argument of EDGES and NEIGHBORS
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ParseEdgeDirection (TRI_json_t const* json,
+                                TRI_edge_direction_e& direction) {
+  if (! IsStringValue(json)) {
+    return false;
+  }
+
+  char const* value = json->_value._string.data;
+
+  if (strcmp(value, "outbound") == 0) {
+    direction = TRI_EDGE_OUT;
+  }
+  else if (strcmp(value, "inbound") == 0) {
+    direction = TRI_EDGE_IN;
+  }
+  else if (strcmp(value, "any") == 0) {
+    direction = TRI_EDGE_ANY;
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief normalize a traversal option string the same way the JavaScript
+/// traverser does (lower-cased, first dash removed)
+////////////////////////////////////////////////////////////////////////////////
+
+static std::string NormalizeTraversalOption (TRI_json_t const* json) {
+  TRI_ASSERT(IsStringValue(json));
+
+  std::string value(json->_value._string.data, json->_value._string.length - 1);
+  std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+
+  size_t const pos = value.find('-');
+
+  if (pos != std::string::npos) {
+    value.erase(pos, 1);
+  }
+
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse the direction argument of TRAVERSAL and SHORTEST_PATH. null
+/// means outbound, as in the JavaScript traverser
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ParseTraversalDirection (TRI_json_t const* json,
+                                     TRI_edge_direction_e& direction) {
+  if (json == nullptr || json->_type == TRI_JSON_NULL) {
+    direction = TRI_EDGE_OUT;
+    return true;
+  }
+
+  if (! IsStringValue(json)) {
+    return false;
+  }
+
+  std::string const value = NormalizeTraversalOption(json);
+
+  if (value == "outbound") {
+    direction = TRI_EDGE_OUT;
+  }
+  else if (value == "inbound") {
+    direction = TRI_EDGE_IN;
+  }
+  else if (value == "any") {
+    direction = TRI_EDGE_ANY;
+  }
+  else {
+    return false;
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a uniqueness value. null keeps the default
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ParseUniqueness (TRI_json_t const* json,
+                             Traverser::Uniqueness& uniqueness) {
+  if (json == nullptr || json->_type == TRI_JSON_NULL) {
+    return true;
+  }
+
+  if (IsStringValue(json)) {
+    std::string const value = NormalizeTraversalOption(json);
+
+    if (value == "none") {
+      uniqueness = Traverser::UNIQUE_NONE;
+    }
+    else if (value == "path") {
+      uniqueness = Traverser::UNIQUE_PATH;
+    }
+    else if (value == "global") {
+      uniqueness = Traverser::UNIQUE_GLOBAL;
+    }
+    else {
+      return false;
+    }
+    return true;
+  }
+
+  if (json->_type == TRI_JSON_NUMBER) {
+    double const value = json->_value._number;
+
+    if (value == 0.0) {
+      uniqueness = Traverser::UNIQUE_NONE;
+    }
+    else if (value == 1.0) {
+      uniqueness = Traverser::UNIQUE_PATH;
+    }
+    else if (value == 2.0) {
+      uniqueness = Traverser::UNIQUE_GLOBAL;
+    }
+    else {
+      return false;
+    }
+    return true;
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse the options of TRAVERSAL and SHORTEST_PATH. returns false if
+/// the options use a feature only the JavaScript traverser provides (custom
+/// visitors, filters, expanders, other strategies or orders) or contain
+/// invalid values
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ParseTraversalOptions (TRI_json_t const* json,
+                                   bool shortestPath,
+                                   Traverser::Options& options) {
+  if (json == nullptr || json->_type == TRI_JSON_NULL) {
+    return true;
+  }
+
+  if (! TRI_IsObjectJson(json)) {
+    return false;
+  }
+
+  size_t const n = json->_value._objects._length;
+
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i + 1));
+
+    char const* name = key->_value._string.data;
+    bool const isNull = (value->_type == TRI_JSON_NULL);
+    bool const isNumber = (value->_type == TRI_JSON_NUMBER);
+
+    if (strcmp(name, "paths") == 0) {
+      options.trackPaths = ValueToBoolean(value);
+    }
+    else if (strcmp(name, "minDepth") == 0) {
+      if (! isNull && ! isNumber) {
+        return false;
+      }
+      options.minDepth = (isNull ? 0.0 : value->_value._number);
+    }
+    else if (strcmp(name, "maxDepth") == 0) {
+      // an explicit null disables the depth limit
+      if (! isNull && ! isNumber) {
+        return false;
+      }
+      options.maxDepth = (isNull ? 0.0 : value->_value._number);
+    }
+    else if (strcmp(name, "maxIterations") == 0) {
+      if (! isNumber || value->_value._number < 0.0) {
+        return false;
+      }
+      options.maxIterations = static_cast<uint64_t>(value->_value._number);
+    }
+    else if (strcmp(name, "weight") == 0) {
+      if (isNull) {
+        options.weightAttribute.clear();
+      }
+      else if (IsStringValue(value)) {
+        options.weightAttribute = std::string(value->_value._string.data, value->_value._string.length - 1);
+      }
+      else {
+        return false;
+      }
+    }
+    else if (strcmp(name, "defaultWeight") == 0) {
+      if (! isNull && ! isNumber) {
+        return false;
+      }
+      options.defaultWeight = (isNull ? 0.0 : value->_value._number);
+    }
+    else if (strcmp(name, "strategy") == 0) {
+      if (shortestPath) {
+        // SHORTEST_PATH always uses dijkstra
+        continue;
+      }
+      if (isNull) {
+        options.strategy = Traverser::STRATEGY_DEPTH_FIRST;
+        continue;
+      }
+      if (! IsStringValue(value)) {
+        return false;
+      }
+      std::string const strategy = NormalizeTraversalOption(value);
+      if (strategy == "depthfirst") {
+        options.strategy = Traverser::STRATEGY_DEPTH_FIRST;
+      }
+      else if (strategy == "breadthfirst") {
+        options.strategy = Traverser::STRATEGY_BREADTH_FIRST;
+      }
+      else {
+        return false;
+      }
+    }
+    else if (strcmp(name, "order") == 0) {
+      if (isNull) {
+        continue;
+      }
+      if (! IsStringValue(value)) {
+        return false;
+      }
+      std::string const order = NormalizeTraversalOption(value);
+      if (order != "preorder" &&
+          (! shortestPath || (order != "postorder" && order != "preorderexpander"))) {
+        // only dijkstra ignores the visitation order
+        return false;
+      }
+    }
+    else if (strcmp(name, "itemOrder") == 0) {
+      if (isNull) {
+        continue;
+      }
+      if (! IsStringValue(value)) {
+        return false;
+      }
+      std::string const itemOrder = NormalizeTraversalOption(value);
+      if (itemOrder == "forward") {
+        options.backward = false;
+      }
+      else if (itemOrder == "backward") {
+        options.backward = true;
+      }
+      else {
+        return false;
+      }
+    }
+    else if (strcmp(name, "uniqueness") == 0) {
+      if (TRI_IsObjectJson(value)) {
+        if (! ParseUniqueness(TRI_LookupObjectJson(value, "vertices"), options.uniqueVertices) ||
+            ! ParseUniqueness(TRI_LookupObjectJson(value, "edges"), options.uniqueEdges)) {
+          return false;
+        }
+      }
+    }
+    else if (strcmp(name, "data") == 0 ||
+             strcmp(name, "includeData") == 0 ||
+             strcmp(name, "includePath") == 0) {
+      // only used by visitors, which are not supported
+      continue;
+    }
+    else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check if a graph function call can be handled by the C++
+/// implementation. graph functions executed on a coordinator need to access
+/// remote shards, which only the JavaScript implementations can do. the edge
+/// collection must be a collection the query has registered, so it is part
+/// of the query's transaction. collection names passed as strings or as
+/// value bind parameters are only resolved at runtime
+////////////////////////////////////////////////////////////////////////////////
+
+static bool SupportsGraphArguments (AstNode const* arguments,
+                                    size_t edgeCollectionPosition) {
+  if (triagens::arango::ServerState::instance()->isCoordinator()) {
+    return false;
+  }
+
+  if (arguments == nullptr ||
+      arguments->numMembers() <= edgeCollectionPosition) {
+    return false;
+  }
+
+  return (arguments->getMember(edgeCollectionPosition)->type == NODE_TYPE_COLLECTION);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check if the constant options argument of TRAVERSAL or SHORTEST_PATH
+/// can be handled by the C++ traverser
+////////////////////////////////////////////////////////////////////////////////
+
+static bool SupportsTraversalOptions (AstNode const* arguments,
+                                      size_t position,
+                                      bool shortestPath) {
+  if (! SupportsGraphArguments(arguments, 1)) {
+    return false;
+  }
+
+  if (arguments->numMembers() <= position) {
+    return true;
+  }
+
+  auto options = arguments->getMember(position);
+
+  if (options->type != NODE_TYPE_OBJECT || ! options->isConstant()) {
+    return false;
+  }
+
+  Json json(TRI_UNKNOWN_MEM_ZONE, options->toJsonValue(TRI_UNKNOWN_MEM_ZONE));
+  Traverser::Options unused;
+
+  return (json.json() != nullptr &&
+          ParseTraversalOptions(json.json(), shortestPath, unused));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief throw the error the JavaScript traverser throws for an invalid
+/// direction
+////////////////////////////////////////////////////////////////////////////////
+
+static void ThrowInvalidDirection () {
+  THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER, "invalid value for expander");
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert a JSON value into a number, using AQL's TO_NUMBER rules
+/// returns false if the value cannot be converted into a number (in which case
+/// AQL's TO_NUMBER would return null)
+////////////////////////////////////////////////////////////////////////////////
+
+bool Functions::ValueToNumber (TRI_json_t const* json,
+                               double& result) {
+  TRI_json_type_e const type = (json == nullptr ? TRI_JSON_UNUSED : json->_type);
+
+  switch (type) {
+    case TRI_JSON_UNUSED:
+    case TRI_JSON_NULL: {
+      result = 0.0;
+      return true;
+    }
+    case TRI_JSON_BOOLEAN: {
+      result = (json->_value._boolean ? 1.0 : 0.0);
+      return true;
+    }
+    case TRI_JSON_NUMBER: {
+      result = json->_value._number;
+      return (! std::isnan(result) && std::isfinite(result));
+    }
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE: {
+      return StringToNumber(json->_value._string.data, json->_value._string.length - 1, result);
+    }
+    case TRI_JSON_ARRAY: {
+      size_t const n = TRI_LengthArrayJson(json);
+      if (n == 0) {
+        result = 0.0;
+        return true;
+      }
+      if (n == 1) {
+        return ValueToNumber(static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, 0)), result);
+      }
+      return false;
+    }
+    case TRI_JSON_OBJECT: {
+      return false;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief support check for EDGES
+////////////////////////////////////////////////////////////////////////////////
+
+bool Functions::SupportsEdges (AstNode const* arguments) {
+  return SupportsGraphArguments(arguments, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief support check for NEIGHBORS
+////////////////////////////////////////////////////////////////////////////////
+
+bool Functions::SupportsNeighbors (AstNode const* arguments) {
+  return SupportsGraphArguments(arguments, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief support check for TRAVERSAL
+////////////////////////////////////////////////////////////////////////////////
+
+bool Functions::SupportsTraversal (AstNode const* arguments) {
+  return SupportsTraversalOptions(arguments, 4, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief support check for SHORTEST_PATH
+////////////////////////////////////////////////////////////////////////////////
+
+bool Functions::SupportsShortestPath (AstNode const* arguments) {
+  return SupportsTraversalOptions(arguments, 5, true);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_NULL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsNull (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  return AqlValue(new Json(j.isNull()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_BOOL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsBool (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  return AqlValue(new Json(j.isBoolean()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_NUMBER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsNumber (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  return AqlValue(new Json(j.isNumber()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_STRING
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsString (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  return AqlValue(new Json(j.isString()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_ARRAY
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsArray (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  return AqlValue(new Json(j.isArray()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function IS_OBJECT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::IsObject (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  return AqlValue(new Json(j.isObject()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_NUMBER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ToNumber (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  double value;
+  if (! ValueToNumber(j.json(), value)) {
+    return NullValue();
+  }
+
+  return NumberValue(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_STRING
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ToString (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(buffer, j.json());
+
+  return StringValue(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_BOOL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ToBool (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  return AqlValue(new Json(ValueToBoolean(j.json())));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TO_ARRAY
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ToArray (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  TRI_json_t const* json = j.json();
+
+  if (IsNullValue(json)) {
+    return AqlValue(new Json(Json::Array));
+  }
+
+  if (json->_type == TRI_JSON_ARRAY) {
+    return CopyValue(json);
+  }
+
+  if (json->_type == TRI_JSON_OBJECT) {
+    // return the object's values
+    size_t const n = json->_value._objects._length;
+    Json result(Json::Array, n / 2);
+    for (size_t i = 1; i < n; i += 2) {
+      AppendCopy(result, static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i)));
+    }
+    return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+  }
+
+  // primitive value
+  Json result(Json::Array, 1);
+  AppendCopy(result, json);
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LENGTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Length (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  TRI_json_t const* json = j.json();
+  size_t length = 0;
+
+  if (json != nullptr) {
+    switch (json->_type) {
+      case TRI_JSON_UNUSED:
+      case TRI_JSON_NULL: {
+        length = 0;
+        break;
+      }
+
+      case TRI_JSON_BOOLEAN: {
+        length = (json->_value._boolean ? 1 : 0);
+        break;
+      }
+
+      case TRI_JSON_NUMBER: {
+        if (std::isnan(json->_value._number) ||
+            ! std::isfinite(json->_value._number)) {
+          // invalid value
+          length = strlen("null");
+        }
+        else {
+          // convert to a string representation of the number
+          char buffer[24];
+          length = static_cast<size_t>(fpconv_dtoa(json->_value._number, buffer));
+        }
+        break;
+      }
+
+      case TRI_JSON_STRING:
+      case TRI_JSON_STRING_REFERENCE: {
+        // return number of characters (not bytes) in string
+        length = TRI_CharLengthUtf8String(json->_value._string.data);
+        break;
+      }
+
+      case TRI_JSON_OBJECT: {
+        // return number of attributes
+        length = json->_value._objects._length / 2;
+        break;
+      }
+
+      case TRI_JSON_ARRAY: {
+        // return list length
+        length = TRI_LengthArrayJson(json);
+        break;
+      }
+    }
+  }
+
+  return AqlValue(new Json(static_cast<double>(length)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONCAT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Concat (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+
+  size_t const n = parameters.arraySize();
+
+  for (size_t i = 0; i < n; ++i) {
+    Json member = parameters.at(trx, i);
+
+    if (member.isEmpty() || member.isNull()) {
+      continue;
+    }
+
+    TRI_json_t const* json = member.json();
+
+    if (member.isArray()) {
+      // append each member individually
+      size_t const subLength = TRI_LengthArrayJson(json);
+
+      for (size_t j = 0; j < subLength; ++j) {
+        auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j));
+
+        if (sub == nullptr || sub->_type == TRI_JSON_NULL) {
+          continue;
+        }
+
+        AppendAsString(buffer, sub);
+      }
+    }
+    else {
+      // convert member to a string and append
+      AppendAsString(buffer, json);
+    }
+  }
+
+  // steal the StringBuffer's char* pointer so we can avoid copying data around
+  // multiple times
+  return StringValue(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONCAT_SEPARATOR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ConcatSeparator (triagens::aql::Query* query,
+                                     triagens::arango::AqlTransaction* trx,
+                                     TRI_document_collection_t const* collection,
+                                     AqlValue const parameters) {
+  triagens::basics::StringBuffer separator(TRI_UNKNOWN_MEM_ZONE, 8);
+  {
+    Json s(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+    ValueToString(separator, s.json());
+  }
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  bool found = false;
+
+  size_t const n = parameters.arraySize();
+
+  for (size_t i = 1; i < n; ++i) {
+    Json member(ExtractFunctionParameter(trx, collection, parameters, i, false));
+    TRI_json_t const* json = member.json();
+
+    if (IsNullValue(json)) {
+      continue;
+    }
+
+    if (found) {
+      buffer.appendText(separator);
+    }
+
+    if (json->_type == TRI_JSON_ARRAY) {
+      found = false;
+      size_t const subLength = TRI_LengthArrayJson(json);
+
+      for (size_t j = 0; j < subLength; ++j) {
+        auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j));
+
+        if (IsNullValue(sub)) {
+          continue;
+        }
+
+        if (found) {
+          buffer.appendText(separator);
+        }
+        AppendAsString(buffer, sub);
+        found = true;
+      }
+    }
+    else {
+      AppendAsString(buffer, json);
+      found = true;
+    }
+  }
+
+  return StringValue(buffer);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CHAR_LENGTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::CharLength (triagens::aql::Query* query,
+                                triagens::arango::AqlTransaction* trx,
+                                TRI_document_collection_t const* collection,
+                                AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  TRI_json_t const* json = j.json();
+
+  if (IsStringValue(json)) {
+    return AqlValue(new Json(static_cast<double>(Utf8Length(json->_value._string.data, json->_value._string.length - 1))));
+  }
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(buffer, json);
+
+  return AqlValue(new Json(static_cast<double>(Utf8Length(buffer.c_str(), buffer.length()))));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LOWER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Lower (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(buffer, j.json());
+
+  int32_t length = 0;
+  char* lower = TRI_tolower_utf8(TRI_UNKNOWN_MEM_ZONE, buffer.c_str(), static_cast<int32_t>(buffer.length()), &length);
+
+  if (lower == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  TRI_json_t* result = TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, lower, static_cast<size_t>(length));
+
+  if (result == nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, lower);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UPPER
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Upper (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(buffer, j.json());
+
+  int32_t length = 0;
+  char* upper = TRI_toupper_utf8(TRI_UNKNOWN_MEM_ZONE, buffer.c_str(), static_cast<int32_t>(buffer.length()), &length);
+
+  if (upper == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  TRI_json_t* result = TRI_CreateStringJson(TRI_UNKNOWN_MEM_ZONE, upper, static_cast<size_t>(length));
+
+  if (result == nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, upper);
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SUBSTRING
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Substring (triagens::aql::Query* query,
+                               triagens::arango::AqlTransaction* trx,
+                               TRI_document_collection_t const* collection,
+                               AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(buffer, j.json());
+
+  int64_t const length = static_cast<int64_t>(Utf8Length(buffer.c_str(), buffer.length()));
+
+  double number;
+  Json o(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  int64_t offset = (ValueToNumber(o.json(), number) ? ToInteger(number) : 0);
+
+  if (offset < 0) {
+    offset = (std::max)(length + offset, static_cast<int64_t>(0));
+  }
+  offset = (std::min)(offset, length);
+
+  int64_t end = length;
+
+  if (parameters.arraySize() > 2) {
+    Json c(ExtractFunctionParameter(trx, collection, parameters, 2, false));
+    int64_t count = (ValueToNumber(c.json(), number) ? ToInteger(number) : 0);
+    count = (std::max)(count, static_cast<int64_t>(0));
+    end = (std::min)(offset + count, length);
+  }
+
+  return Utf8Substring(buffer.c_str(), buffer.length(), static_cast<size_t>(offset), static_cast<size_t>(end));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CONTAINS
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Contains (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json v(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  Json s(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  Json r(ExtractFunctionParameter(trx, collection, parameters, 2, false));
+
+  triagens::basics::StringBuffer value(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(value, v.json());
+  triagens::basics::StringBuffer search(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(search, s.json());
+
+  int64_t result = -1;
+
+  if (search.length() > 0) {
+    char const* found = static_cast<char const*>(memmem(value.c_str(), value.length(), search.c_str(), search.length()));
+
+    if (found != nullptr) {
+      // return the character position, not the byte position
+      result = static_cast<int64_t>(Utf8Length(value.c_str(), static_cast<size_t>(found - value.c_str())));
+    }
+  }
+
+  if (ValueToBoolean(r.json())) {
+    return AqlValue(new Json(static_cast<double>(result)));
+  }
+
+  return AqlValue(new Json(result != -1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LEFT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Left (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json v(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  Json l(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(buffer, v.json());
+
+  int64_t const length = static_cast<int64_t>(Utf8Length(buffer.c_str(), buffer.length()));
+  double number;
+  int64_t count = (ValueToNumber(l.json(), number) ? ToInteger(number) : 0);
+  count = (std::max)((std::min)(count, length), static_cast<int64_t>(0));
+
+  return Utf8Substring(buffer.c_str(), buffer.length(), 0, static_cast<size_t>(count));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function RIGHT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Right (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json v(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  Json l(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+
+  triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(buffer, v.json());
+
+  int64_t const length = static_cast<int64_t>(Utf8Length(buffer.c_str(), buffer.length()));
+  double number;
+  int64_t count = (ValueToNumber(l.json(), number) ? ToInteger(number) : 0);
+  count = (std::max)((std::min)(count, length), static_cast<int64_t>(0));
+
+  return Utf8Substring(buffer.c_str(), buffer.length(), static_cast<size_t>(length - count), static_cast<size_t>(length));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MD5
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Md5 (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  return HashedString(j.json(), false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SHA1
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Sha1 (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  return HashedString(j.json(), true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FLOOR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Floor (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  double value;
+  if (! ValueToNumber(j.json(), value)) {
+    value = 0.0;
+  }
+  return NumberValue(std::floor(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function CEIL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Ceil (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  double value;
+  if (! ValueToNumber(j.json(), value)) {
+    value = 0.0;
+  }
+  return NumberValue(std::ceil(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ROUND
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Round (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  double value;
+  if (! ValueToNumber(j.json(), value)) {
+    value = 0.0;
+  }
+
+  // JavaScript rounds halfway cases towards +infinity
+  double rounded = std::floor(value);
+  if (value - rounded >= 0.5) {
+    rounded += 1.0;
+  }
+  return NumberValue(rounded);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ABS
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Abs (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  double value;
+  if (! ValueToNumber(j.json(), value)) {
+    value = 0.0;
+  }
+  return NumberValue(std::fabs(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SQRT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Sqrt (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  double value;
+  if (! ValueToNumber(j.json(), value)) {
+    value = 0.0;
+  }
+  return NumberValue(std::sqrt(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DISTANCE
+/// this uses the same formula as the geo index, so distances calculated here
+/// can be compared with the distances the geo index produces
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Distance (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  double values[4];
+
+  for (size_t i = 0; i < 4; ++i) {
+    Json j(ExtractFunctionParameter(trx, collection, parameters, i, false));
+
+    if (! j.isNumber()) {
+      RegisterWarning(query, "DISTANCE", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      return NullValue();
+    }
+
+    values[i] = j.json()->_value._number;
+  }
+
+  GeoCoordinate c1;
+  c1.latitude  = values[0];
+  c1.longitude = values[1];
+  c1.data      = nullptr;
+
+  GeoCoordinate c2;
+  c2.latitude  = values[2];
+  c2.longitude = values[3];
+  c2.data      = nullptr;
+
+  return NumberValue(GeoIndex_distance(&c1, &c2));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIRST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::First (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "FIRST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  size_t const n = TRI_LengthArrayJson(j.json());
+
+  if (n == 0) {
+    return NullValue();
+  }
+
+  return CopyValue(TRI_LookupArrayJson(j.json(), 0));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function LAST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Last (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "LAST", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  size_t const n = TRI_LengthArrayJson(j.json());
+
+  if (n == 0) {
+    return NullValue();
+  }
+
+  return CopyValue(TRI_LookupArrayJson(j.json(), n - 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function NTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Nth (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "NTH", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  Json p(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  double position;
+
+  if (IsNullValue(p.json()) ||
+      ! ValueToNumber(p.json(), position) ||
+      position < 0.0 ||
+      position != std::floor(position) ||
+      position >= static_cast<double>(TRI_LengthArrayJson(j.json()))) {
+    return NullValue();
+  }
+
+  return CopyValue(TRI_LookupArrayJson(j.json(), static_cast<size_t>(position)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function POSITION
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Position (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "POSITION", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  Json s(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  Json r(ExtractFunctionParameter(trx, collection, parameters, 2, false));
+  bool const returnIndex = ValueToBoolean(r.json());
+
+  TRI_json_t const* json = j.json();
+  size_t const n = TRI_LengthArrayJson(json);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto member = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (TRI_CompareValuesJson(member, s.json()) == 0) {
+      if (returnIndex) {
+        return AqlValue(new Json(static_cast<double>(i)));
+      }
+      return AqlValue(new Json(true));
+    }
+  }
+
+  if (returnIndex) {
+    return AqlValue(new Json(-1.0));
+  }
+  return AqlValue(new Json(false));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function REVERSE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Reverse (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  TRI_json_t const* json = j.json();
+
+  if (IsStringValue(json)) {
+    // reverse the characters, keeping multi-byte sequences intact
+    char const* p = json->_value._string.data;
+    size_t const length = json->_value._string.length - 1;
+
+    triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, length + 1);
+    size_t end = length;
+
+    while (end > 0) {
+      size_t start = end - 1;
+      while (start > 0 && (p[start] & 0xc0) == 0x80) {
+        --start;
+      }
+      buffer.appendText(p + start, end - start);
+      end = start;
+    }
+
+    return StringValue(buffer);
+  }
+
+  if (json == nullptr || json->_type != TRI_JSON_ARRAY) {
+    RegisterWarning(query, "REVERSE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  size_t const n = TRI_LengthArrayJson(json);
+  Json result(Json::Array, n);
+
+  for (size_t i = n; i > 0; --i) {
+    AppendCopy(result, static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i - 1)));
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNIQUE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Unique (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "UNIQUE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  TRI_json_t const* json = j.json();
+  size_t const n = TRI_LengthArrayJson(json);
+
+  std::unordered_set<TRI_json_t const*, JsonValueHash, JsonValueEqual> values;
+  values.reserve(n);
+
+  Json result(Json::Array, n);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto member = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (values.emplace(member).second) {
+      AppendCopy(result, member);
+    }
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNION
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Union (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  size_t const n = parameters.arraySize();
+  Json result(Json::Array);
+
+  for (size_t i = 0; i < n; ++i) {
+    Json member(ExtractFunctionParameter(trx, collection, parameters, i, false));
+
+    if (! member.isArray()) {
+      RegisterWarning(query, "UNION", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      return NullValue();
+    }
+
+    TRI_json_t const* json = member.json();
+    size_t const subLength = TRI_LengthArrayJson(json);
+    result.reserve(subLength);
+
+    for (size_t j = 0; j < subLength; ++j) {
+      AppendCopy(result, static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j)));
+    }
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNION_DISTINCT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::UnionDistinct (triagens::aql::Query* query,
+                                   triagens::arango::AqlTransaction* trx,
+                                   TRI_document_collection_t const* collection,
+                                   AqlValue const parameters) {
+  size_t const n = parameters.arraySize();
+
+  // the set only contains pointers into the parameters, so these must be
+  // kept alive until the result has been built
+  std::vector<Json> members;
+  members.reserve(n);
+
+  for (size_t i = 0; i < n; ++i) {
+    members.emplace_back(ExtractFunctionParameter(trx, collection, parameters, i, false));
+
+    if (! members.back().isArray()) {
+      RegisterWarning(query, "UNION_DISTINCT", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      return NullValue();
+    }
+  }
+
+  std::unordered_set<TRI_json_t const*, JsonValueHash, JsonValueEqual> values;
+  Json result(Json::Array);
+
+  for (auto const& member : members) {
+    TRI_json_t const* json = member.json();
+    size_t const subLength = TRI_LengthArrayJson(json);
+
+    for (size_t j = 0; j < subLength; ++j) {
+      auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j));
+
+      if (values.emplace(sub).second) {
+        AppendCopy(result, sub);
+      }
+    }
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SLICE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Slice (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "SLICE", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return NullValue();
+  }
+
+  TRI_json_t const* json = j.json();
+  int64_t const length = static_cast<int64_t>(TRI_LengthArrayJson(json));
+
+  double number;
+  Json f(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  int64_t from = (ValueToNumber(f.json(), number) ? ToInteger(number) : 0);
+  int64_t to = length;
+
+  Json t(ExtractFunctionParameter(trx, collection, parameters, 2, false));
+  if (parameters.arraySize() > 2 && ValueToNumber(t.json(), number)) {
+    to = ToInteger(number);
+    if (to >= 0) {
+      to += from;
+    }
+  }
+
+  // apply JavaScript's Array.prototype.slice() semantics
+  from = (from < 0 ? (std::max)(length + from, static_cast<int64_t>(0)) : (std::min)(from, length));
+  to   = (to < 0 ? (std::max)(length + to, static_cast<int64_t>(0)) : (std::min)(to, length));
+
+  Json result(Json::Array, static_cast<size_t>(to > from ? to - from : 0));
+
+  for (int64_t i = from; i < to; ++i) {
+    AppendCopy(result, static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, static_cast<size_t>(i))));
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief recursive helper for FLATTEN
+////////////////////////////////////////////////////////////////////////////////
+
+static void FlattenArray (Json& result,
+                          TRI_json_t const* json,
+                          int64_t maxDepth,
+                          int64_t depth) {
+  size_t const n = TRI_LengthArrayJson(json);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto member = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (depth < maxDepth && member != nullptr && member->_type == TRI_JSON_ARRAY) {
+      FlattenArray(result, member, maxDepth, depth + 1);
+    }
+    else {
+      AppendCopy(result, member);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FLATTEN
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Flatten (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "FLATTEN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  int64_t maxDepth = 1;
+
+  if (parameters.arraySize() > 1) {
+    Json d(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+    double number;
+    if (! IsNullValue(d.json()) && ValueToNumber(d.json(), number) && number >= 1.0) {
+      maxDepth = ToInteger(number);
+    }
+  }
+
+  Json result(Json::Array);
+  FlattenArray(result, j.json(), maxDepth, 0);
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MIN
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Min (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "MIN", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  TRI_json_t const* json = j.json();
+  TRI_json_t const* minimum = nullptr;
+  size_t const n = TRI_LengthArrayJson(json);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto member = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (IsNullValue(member)) {
+      continue;
+    }
+
+    if (minimum == nullptr || TRI_CompareValuesJson(member, minimum) < 0) {
+      minimum = member;
+    }
+  }
+
+  return CopyValue(minimum);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MAX
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Max (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "MAX", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  TRI_json_t const* json = j.json();
+  TRI_json_t const* maximum = nullptr;
+  size_t const n = TRI_LengthArrayJson(json);
+
+  for (size_t i = 0; i < n; ++i) {
+    auto member = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (IsNullValue(member)) {
+      continue;
+    }
+
+    if (maximum == nullptr || TRI_CompareValuesJson(member, maximum) > 0) {
+      maximum = member;
+    }
+  }
+
+  return CopyValue(maximum);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SUM
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Sum (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "SUM", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  TRI_json_t const* json = j.json();
+  size_t const n = TRI_LengthArrayJson(json);
+  double sum = 0.0;
+
+  for (size_t i = 0; i < n; ++i) {
+    auto member = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (IsNullValue(member)) {
+      continue;
+    }
+
+    if (member->_type != TRI_JSON_NUMBER) {
+      RegisterWarning(query, "SUM", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      return NullValue();
+    }
+
+    sum += member->_value._number;
+  }
+
+  return NumberValue(sum);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function AVERAGE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Average (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isArray()) {
+    RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_ARRAY_EXPECTED);
+    return NullValue();
+  }
+
+  TRI_json_t const* json = j.json();
+  size_t const n = TRI_LengthArrayJson(json);
+  double sum = 0.0;
+  size_t count = 0;
+
+  for (size_t i = 0; i < n; ++i) {
+    auto member = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (IsNullValue(member)) {
+      continue;
+    }
+
+    if (member->_type != TRI_JSON_NUMBER) {
+      RegisterWarning(query, "AVERAGE", TRI_ERROR_QUERY_INVALID_ARITHMETIC_VALUE);
+      return NullValue();
+    }
+
+    sum += member->_value._number;
+    ++count;
+  }
+
+  if (count == 0) {
+    return NullValue();
+  }
+
+  return NumberValue(sum / static_cast<double>(count));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function HAS
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Has (triagens::aql::Query* query,
+                         triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isObject()) {
+    return AqlValue(new Json(false));
+  }
+
+  Json n(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  triagens::basics::StringBuffer name(TRI_UNKNOWN_MEM_ZONE, 24);
+  ValueToString(name, n.json());
+
+  return AqlValue(new Json(TRI_LookupObjectJson(j.json(), name.c_str()) != nullptr));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function ATTRIBUTES
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Attributes (triagens::aql::Query* query,
+                                triagens::arango::AqlTransaction* trx,
+                                TRI_document_collection_t const* collection,
+                                AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isObject()) {
+    RegisterWarning(query, "ATTRIBUTES", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return NullValue();
+  }
+
+  Json r(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  Json s(ExtractFunctionParameter(trx, collection, parameters, 2, false));
+  bool const removeInternal = ValueToBoolean(r.json());
+  bool const doSort = ValueToBoolean(s.json());
+
+  TRI_json_t const* json = j.json();
+  size_t const n = json->_value._objects._length;
+  std::vector<char const*> names;
+  names.reserve(n / 2);
+
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+    char const* name = key->_value._string.data;
+
+    if (removeInternal && *name == '_') {
+      continue;
+    }
+    names.emplace_back(name);
+  }
+
+  if (doSort) {
+    std::sort(names.begin(), names.end(), [] (char const* lhs, char const* rhs) {
+      return strcmp(lhs, rhs) < 0;
+    });
+  }
+
+  Json result(Json::Array, names.size());
+  for (auto const& name : names) {
+    result.add(Json(name));
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function VALUES
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Values (triagens::aql::Query* query,
+                            triagens::arango::AqlTransaction* trx,
+                            TRI_document_collection_t const* collection,
+                            AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isObject()) {
+    RegisterWarning(query, "VALUES", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return NullValue();
+  }
+
+  Json r(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  bool const removeInternal = ValueToBoolean(r.json());
+
+  TRI_json_t const* json = j.json();
+  size_t const n = json->_value._objects._length;
+  Json result(Json::Array, n / 2);
+
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (removeInternal && *key->_value._string.data == '_') {
+      continue;
+    }
+
+    AppendCopy(result, static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i + 1)));
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief helper function for MERGE and MERGE_RECURSIVE
+////////////////////////////////////////////////////////////////////////////////
+
+static AqlValue MergeParameters (triagens::aql::Query* query,
+                                 triagens::arango::AqlTransaction* trx,
+                                 TRI_document_collection_t const* collection,
+                                 AqlValue const& parameters,
+                                 char const* functionName,
+                                 bool recursive) {
+  size_t const n = parameters.arraySize();
+  Json result(Json::Object);
+
+  for (size_t i = 0; i < n; ++i) {
+    Json member(ExtractFunctionParameter(trx, collection, parameters, i, false));
+
+    if (! member.isObject()) {
+      RegisterWarning(query, functionName, TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+      return NullValue();
+    }
+
+    TRI_json_t* merged = TRI_MergeJson(TRI_UNKNOWN_MEM_ZONE, result.json(), member.json(), false, recursive);
+
+    if (merged == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+
+    result = Json(TRI_UNKNOWN_MEM_ZONE, merged);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MERGE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Merge (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  return MergeParameters(query, trx, collection, parameters, "MERGE", false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function MERGE_RECURSIVE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::MergeRecursive (triagens::aql::Query* query,
+                                    triagens::arango::AqlTransaction* trx,
+                                    TRI_document_collection_t const* collection,
+                                    AqlValue const parameters) {
+  return MergeParameters(query, trx, collection, parameters, "MERGE_RECURSIVE", true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract attribute names from the function parameters, starting at
+/// parameter 1. returns false if the parameters contain invalid names
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ExtractKeys (triagens::arango::AqlTransaction* trx,
+                         TRI_document_collection_t const* collection,
+                         AqlValue const& parameters,
+                         std::vector<std::string>& names) {
+  size_t const n = parameters.arraySize();
+
+  for (size_t i = 1; i < n; ++i) {
+    Json member(ExtractFunctionParameter(trx, collection, parameters, i, false));
+    TRI_json_t const* json = member.json();
+
+    if (IsStringValue(json)) {
+      names.emplace_back(json->_value._string.data, json->_value._string.length - 1);
+    }
+    else if (json != nullptr && json->_type == TRI_JSON_NUMBER) {
+      triagens::basics::StringBuffer buffer(TRI_UNKNOWN_MEM_ZONE, 24);
+      ValueToString(buffer, json);
+      names.emplace_back(buffer.c_str(), buffer.length());
+    }
+    else if (json != nullptr && json->_type == TRI_JSON_ARRAY) {
+      size_t const subLength = TRI_LengthArrayJson(json);
+
+      for (size_t j = 0; j < subLength; ++j) {
+        auto sub = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, j));
+
+        if (! IsStringValue(sub)) {
+          return false;
+        }
+        names.emplace_back(sub->_value._string.data, sub->_value._string.length - 1);
+      }
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function UNSET
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Unset (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isObject()) {
+    RegisterWarning(query, "UNSET", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return NullValue();
+  }
+
+  std::vector<std::string> names;
+  if (! ExtractKeys(trx, collection, parameters, names)) {
+    RegisterWarning(query, "UNSET", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return NullValue();
+  }
+
+  std::unordered_set<std::string> const keys(names.begin(), names.end());
+
+  TRI_json_t const* json = j.json();
+  size_t const n = json->_value._objects._length;
+  Json result(Json::Object, n / 2);
+
+  for (size_t i = 0; i < n; i += 2) {
+    auto key = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i));
+
+    if (keys.find(std::string(key->_value._string.data, key->_value._string.length - 1)) != keys.end()) {
+      continue;
+    }
+
+    auto value = static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i + 1));
+    TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+    result.set(key->_value._string.data, copy);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function KEEP
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Keep (triagens::aql::Query* query,
+                          triagens::arango::AqlTransaction* trx,
+                          TRI_document_collection_t const* collection,
+                          AqlValue const parameters) {
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+
+  if (! j.isObject()) {
+    RegisterWarning(query, "KEEP", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return NullValue();
+  }
+
+  std::vector<std::string> names;
+  if (! ExtractKeys(trx, collection, parameters, names)) {
+    RegisterWarning(query, "KEEP", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return NullValue();
+  }
+
+  TRI_json_t const* json = j.json();
+  std::unordered_set<std::string> seen;
+  Json result(Json::Object, names.size());
+
+  for (auto const& name : names) {
+    if (! seen.emplace(name).second) {
+      // attribute name specified more than once
+      continue;
+    }
+
+    TRI_json_t const* value = TRI_LookupObjectJson(json, name.c_str());
+
+    if (value == nullptr) {
+      continue;
+    }
+
+    TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, value);
+
+    if (copy == nullptr) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+    }
+    result.set(name.c_str(), copy);
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_TIMESTAMP
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateTimestamp (triagens::aql::Query* query,
+                                   triagens::arango::AqlTransaction* trx,
+                                   TRI_document_collection_t const* collection,
+                                   AqlValue const parameters) {
+  double timestamp;
+
+  if (! MakeDate(query, trx, collection, parameters, "DATE_TIMESTAMP", timestamp)) {
+    return NullValue();
+  }
+
+  return NumberValue(timestamp);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_ISO8601
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateIso8601 (triagens::aql::Query* query,
+                                 triagens::arango::AqlTransaction* trx,
+                                 TRI_document_collection_t const* collection,
+                                 AqlValue const parameters) {
+  double timestamp;
+
+  if (! MakeDate(query, trx, collection, parameters, "DATE_ISO8601", timestamp)) {
+    return NullValue();
+  }
+
+  if (std::isnan(timestamp)) {
+    RegisterWarning(query, "DATE_ISO8601", TRI_ERROR_QUERY_INVALID_DATE_VALUE);
+    return NullValue();
+  }
+
+  DateParts const parts = SplitTimestamp(static_cast<int64_t>(timestamp));
+
+  char buffer[32];
+  int length;
+
+  if (parts.year >= 0 && parts.year <= 9999) {
+    length = snprintf(buffer, sizeof(buffer), "%04d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                      static_cast<int>(parts.year), parts.month, parts.day,
+                      parts.hour, parts.minute, parts.second, parts.millisecond);
+  }
+  else {
+    // extended year format
+    length = snprintf(buffer, sizeof(buffer), "%c%06d-%02d-%02dT%02d:%02d:%02d.%03dZ",
+                      (parts.year < 0 ? '-' : '+'),
+                      static_cast<int>(parts.year < 0 ? - parts.year : parts.year), parts.month, parts.day,
+                      parts.hour, parts.minute, parts.second, parts.millisecond);
+  }
+
+  return StringValue(buffer, static_cast<size_t>(length));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_DAYOFWEEK
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateDayOfWeek (triagens::aql::Query* query,
+                                   triagens::arango::AqlTransaction* trx,
+                                   TRI_document_collection_t const* collection,
+                                   AqlValue const parameters) {
+  return DatePart(query, trx, collection, parameters, "DATE_DAYOFWEEK", [] (DateParts const& parts) {
+    return static_cast<double>(parts.dayOfWeek);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_YEAR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateYear (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  return DatePart(query, trx, collection, parameters, "DATE_YEAR", [] (DateParts const& parts) {
+    return static_cast<double>(parts.year);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_MONTH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateMonth (triagens::aql::Query* query,
+                               triagens::arango::AqlTransaction* trx,
+                               TRI_document_collection_t const* collection,
+                               AqlValue const parameters) {
+  return DatePart(query, trx, collection, parameters, "DATE_MONTH", [] (DateParts const& parts) {
+    return static_cast<double>(parts.month);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_DAY
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateDay (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  return DatePart(query, trx, collection, parameters, "DATE_DAY", [] (DateParts const& parts) {
+    return static_cast<double>(parts.day);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_HOUR
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateHour (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+  return DatePart(query, trx, collection, parameters, "DATE_HOUR", [] (DateParts const& parts) {
+    return static_cast<double>(parts.hour);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_MINUTE
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateMinute (triagens::aql::Query* query,
+                                triagens::arango::AqlTransaction* trx,
+                                TRI_document_collection_t const* collection,
+                                AqlValue const parameters) {
+  return DatePart(query, trx, collection, parameters, "DATE_MINUTE", [] (DateParts const& parts) {
+    return static_cast<double>(parts.minute);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_SECOND
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateSecond (triagens::aql::Query* query,
+                                triagens::arango::AqlTransaction* trx,
+                                TRI_document_collection_t const* collection,
+                                AqlValue const parameters) {
+  return DatePart(query, trx, collection, parameters, "DATE_SECOND", [] (DateParts const& parts) {
+    return static_cast<double>(parts.second);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function DATE_MILLISECOND
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::DateMillisecond (triagens::aql::Query* query,
+                                     triagens::arango::AqlTransaction* trx,
+                                     TRI_document_collection_t const* collection,
+                                     AqlValue const parameters) {
+  return DatePart(query, trx, collection, parameters, "DATE_MILLISECOND", [] (DateParts const& parts) {
+    return static_cast<double>(parts.millisecond);
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function NOT_NULL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::NotNull (triagens::aql::Query* query,
+                             triagens::arango::AqlTransaction* trx,
+                             TRI_document_collection_t const* collection,
+                             AqlValue const parameters) {
+  size_t const n = parameters.arraySize();
+
+  for (size_t i = 0; i < n; ++i) {
+    Json member(ExtractFunctionParameter(trx, collection, parameters, i, false));
+
+    if (! IsNullValue(member.json())) {
+      return CopyValue(member.json());
+    }
+  }
+
+  return NullValue();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIRST_LIST
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::FirstList (triagens::aql::Query* query,
+                               triagens::arango::AqlTransaction* trx,
+                               TRI_document_collection_t const* collection,
+                               AqlValue const parameters) {
+  size_t const n = parameters.arraySize();
+
+  for (size_t i = 0; i < n; ++i) {
+    Json member(ExtractFunctionParameter(trx, collection, parameters, i, false));
+
+    if (member.isArray()) {
+      return CopyValue(member.json());
+    }
+  }
+
+  return NullValue();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function FIRST_DOCUMENT
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::FirstDocument (triagens::aql::Query* query,
+                                   triagens::arango::AqlTransaction* trx,
+                                   TRI_document_collection_t const* collection,
+                                   AqlValue const parameters) {
+  size_t const n = parameters.arraySize();
+
+  for (size_t i = 0; i < n; ++i) {
+    Json member(ExtractFunctionParameter(trx, collection, parameters, i, false));
+
+    if (member.isObject()) {
+      return CopyValue(member.json());
+    }
+  }
+
+  return NullValue();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function PASSTHRU
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Passthru (triagens::aql::Query* query,
+                              triagens::arango::AqlTransaction* trx,
+                              TRI_document_collection_t const* collection,
+                              AqlValue const parameters) {
+
+  Json j(ExtractFunctionParameter(trx, collection, parameters, 0, true));
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, j.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function EDGES
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Edges (triagens::aql::Query* query,
+                           triagens::arango::AqlTransaction* trx,
+                           TRI_document_collection_t const* collection,
+                           AqlValue const parameters) {
+  Json edgeCollectionName(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  Json vertex(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  Json direction(ExtractFunctionParameter(trx, collection, parameters, 2, false));
+  Json examples(ExtractFunctionParameter(trx, collection, parameters, 3, false));
+
+  TRI_document_collection_t* edgeCollection = GetEdgeCollection(trx, edgeCollectionName.json());
+
+  Traverser::Options options;
+
+  if (! ParseEdgeDirection(direction.json(), options.direction)) {
+    RegisterWarning(query, "EDGES", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return NullValue();
+  }
+
+  Traverser traverser(query, trx, edgeCollection, options);
+
+  std::vector<Traverser::VertexId> vertices;
+  ExtractVertexIds(traverser, vertex.json(), vertices);
+
+  Json result(Json::Array);
+
+  for (auto const& id : vertices) {
+    for (auto const& edge : traverser.edges(id)) {
+      Json json(traverser.edgeJson(static_cast<TRI_df_marker_t const*>(edge.getDataPtr())));
+
+      if (MatchesExamples(query, json.json(), examples.json())) {
+        result.add(json);
+      }
+    }
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function NEIGHBORS
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Neighbors (triagens::aql::Query* query,
+                               triagens::arango::AqlTransaction* trx,
+                               TRI_document_collection_t const* collection,
+                               AqlValue const parameters) {
+  Json vertexCollectionName(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  Json edgeCollectionName(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  Json vertex(ExtractFunctionParameter(trx, collection, parameters, 2, false));
+  Json direction(ExtractFunctionParameter(trx, collection, parameters, 3, false));
+  Json examples(ExtractFunctionParameter(trx, collection, parameters, 4, false));
+
+  Json vertexId(VertexToId(vertex.json(), vertexCollectionName.json()));
+  TRI_document_collection_t* edgeCollection = GetEdgeCollection(trx, edgeCollectionName.json());
+
+  Traverser::Options options;
+
+  if (! ParseEdgeDirection(direction.json(), options.direction)) {
+    RegisterWarning(query, "EDGES", TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    THROW_ARANGO_EXCEPTION_PARAMS(TRI_ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH, "NEIGHBORS");
+  }
+
+  Traverser traverser(query, trx, edgeCollection, options);
+
+  std::vector<Traverser::VertexId> vertices;
+  ExtractVertexIds(traverser, vertexId.json(), vertices);
+
+  // the start vertex itself is only excluded if a single vertex was given
+  bool const single = ! vertexId.isArray();
+
+  Json result(Json::Array);
+
+  for (auto const& id : vertices) {
+    for (auto const& edge : traverser.edges(id)) {
+      auto marker = static_cast<TRI_df_marker_t const*>(edge.getDataPtr());
+      Json json(traverser.edgeJson(marker));
+
+      if (! MatchesExamples(query, json.json(), examples.json())) {
+        continue;
+      }
+
+      Traverser::VertexId peer;
+      if (single) {
+        peer = Traverser::peerVertex(marker, options.direction, id);
+
+        if (peer == id) {
+          // do not return the start vertex itself
+          continue;
+        }
+      }
+      else {
+        peer = Traverser::peerVertex(marker, options.direction == TRI_EDGE_ANY ? TRI_EDGE_IN : options.direction, id);
+      }
+
+      Json item(Json::Object, 2);
+      item.set("edge", json);
+      item.set("vertex", traverser.vertexJson(peer));
+      result.add(item);
+    }
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, result.steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function TRAVERSAL
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::Traversal (triagens::aql::Query* query,
+                               triagens::arango::AqlTransaction* trx,
+                               TRI_document_collection_t const* collection,
+                               AqlValue const parameters) {
+  Json vertexCollectionName(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  Json edgeCollectionName(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  Json startVertex(ExtractFunctionParameter(trx, collection, parameters, 2, false));
+  Json direction(ExtractFunctionParameter(trx, collection, parameters, 3, false));
+  Json params(ExtractFunctionParameter(trx, collection, parameters, 4, false));
+
+  Traverser::Options options;
+
+  if (! ParseTraversalOptions(params.json(), false, options)) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_BAD_PARAMETER);
+  }
+
+  TRI_document_collection_t* edgeCollection = GetEdgeCollection(trx, edgeCollectionName.json());
+  Json startId(VertexToId(startVertex.json(), vertexCollectionName.json()));
+
+  bool const validDirection = ParseTraversalDirection(direction.json(), options.direction);
+  Traverser traverser(query, trx, edgeCollection, options);
+
+  Traverser::VertexId start;
+
+  if (! IsStringValue(startId.json()) ||
+      traverser.parseVertexId(startId.json()->_value._string.data, start) != TRI_ERROR_NO_ERROR ||
+      ! traverser.hasVertex(start)) {
+    // a non-existing start vertex produces an empty result
+    return AqlValue(new Json(Json::Array));
+  }
+
+  if (! validDirection) {
+    ThrowInvalidDirection();
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, traverser.traverse(start).steal()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief function SHORTEST_PATH
+////////////////////////////////////////////////////////////////////////////////
+
+AqlValue Functions::ShortestPath (triagens::aql::Query* query,
+                                  triagens::arango::AqlTransaction* trx,
+                                  TRI_document_collection_t const* collection,
+                                  AqlValue const parameters) {
+  Json vertexCollectionName(ExtractFunctionParameter(trx, collection, parameters, 0, false));
+  Json edgeCollectionName(ExtractFunctionParameter(trx, collection, parameters, 1, false));
+  Json startVertex(ExtractFunctionParameter(trx, collection, parameters, 2, false));
+  Json endVertex(ExtractFunctionParameter(trx, collection, parameters, 3, false));
+  Json direction(ExtractFunctionParameter(trx, collection, parameters, 4, false));
+  Json params(ExtractFunctionParameter(trx, collection, parameters, 5, false));
+
+  Traverser::Options options;
+
+  if (! ParseTraversalOptions(params.json(), true, options)) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_BAD_PARAMETER);
+  }
+
+  TRI_document_collection_t* edgeCollection = GetEdgeCollection(trx, edgeCollectionName.json());
+  Json startId(VertexToId(startVertex.json(), vertexCollectionName.json()));
+  Json endId(VertexToId(endVertex.json(), vertexCollectionName.json()));
+
+  bool const validDirection = ParseTraversalDirection(direction.json(), options.direction);
+  Traverser traverser(query, trx, edgeCollection, options);
+
+  Traverser::VertexId start;
+
+  if (! IsStringValue(startId.json()) ||
+      traverser.parseVertexId(startId.json()->_value._string.data, start) != TRI_ERROR_NO_ERROR ||
+      ! traverser.hasVertex(start)) {
+    // a non-existing start vertex produces an empty result
+    return AqlValue(new Json(Json::Array));
+  }
+
+  if (! validDirection) {
+    ThrowInvalidDirection();
+  }
+
+  Traverser::VertexId end;
+
+  if (IsStringValue(endId.json())) {
+    // an unparsable id leaves the end vertex invalid, which is reported by
+    // the traverser
+    traverser.parseVertexId(endId.json()->_value._string.data, end);
+  }
+  else if (endId.isObject()) {
+    // an end vertex object without an _id can never be reached
+    return AqlValue(new Json(Json::Array));
+  }
+
+  return AqlValue(new Json(TRI_UNKNOWN_MEM_ZONE, traverser.shortestPath(start, end).steal()));
 }
 
 // -----------------------------------------------------------------------------
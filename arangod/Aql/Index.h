@@ -137,6 +137,45 @@ namespace triagens {
 
         return internals->selectivityEstimate(internals);
       }
+
+      bool hasRangeEstimate () const {
+        if (! hasInternals()) { 
+          return false;
+        }
+
+        return (getInternals()->rangeEstimate != nullptr);
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimated fraction of documents whose first indexed attribute lies
+/// between the bounds (nullptr = unbounded), negative if unknown
+////////////////////////////////////////////////////////////////////////////////
+
+      double rangeEstimate (TRI_json_t const* low,
+                            bool lowInclusive,
+                            TRI_json_t const* high,
+                            bool highInclusive) const {
+        TRI_index_t* internals = getInternals();
+
+        TRI_ASSERT(internals->rangeEstimate != nullptr);
+
+        return internals->rangeEstimate(internals, low, lowInclusive, high, highInclusive);
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimated number of distinct values of the first n indexed
+/// attributes, 0 if unknown
+////////////////////////////////////////////////////////////////////////////////
+
+      double distinctEstimate (size_t n) const {
+        TRI_index_t* internals = getInternals();
+
+        if (internals->distinctEstimate == nullptr) {
+          return 0.0;
+        }
+
+        return internals->distinctEstimate(internals, n);
+      }
       
       inline bool hasInternals () const {
         return (internals != nullptr);
@@ -515,6 +515,18 @@ void Optimizer::setupRules () {
                removeRedundantOrRule_pass6,
                true);
 
+  // use a geo index for SORT DISTANCE(...) LIMIT n and FILTER DISTANCE(...) < r
+  registerRule("use-geo-index",
+               useGeoIndexRule,
+               useGeoIndexRule_pass6,
+               true);
+
+  // use a fulltext index for FOR ... IN FULLTEXT(...)
+  registerRule("use-fulltext-index",
+               useFulltextIndexRule,
+               useFulltextIndexRule_pass6,
+               true);
+
   // try to find a filter after an enumerate collection and find an index . . . 
   registerRule("use-index-range",
                useIndexRangeRule,
@@ -533,6 +545,12 @@ void Optimizer::setupRules () {
                useIndexForSortRule_pass6,
                true);
 
+  // group COLLECT input using a hash table instead of sorting it
+  registerRule("use-hash-aggregation",
+               useHashAggregationRule,
+               useHashAggregationRule_pass6,
+               true);
+
 //////////////////////////////////////////////////////////////////////////////
 /// Pass 9: push down calculations beyond FILTERs and LIMITs
 //////////////////////////////////////////////////////////////////////////////
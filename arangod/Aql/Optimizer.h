@@ -179,6 +179,12 @@ namespace triagens {
         // remove redundant OR conditions
         removeRedundantOrRule_pass6                   = 820,
         
+        // use a geo index for SORT DISTANCE(...) LIMIT n and FILTER DISTANCE(...) < r
+        useGeoIndexRule_pass6                         = 825,
+
+        // use a fulltext index for FOR ... IN FULLTEXT(...)
+        useFulltextIndexRule_pass6                    = 826,
+
         // try to find a filter after an enumerate collection and find an index . . . 
         useIndexRangeRule_pass6                       = 830,
 
@@ -188,6 +194,9 @@ namespace triagens {
         // try to find sort blocks which are superseeded by indexes
         useIndexForSortRule_pass6                     = 850,
 
+        // group COLLECT input using a hash table instead of sorting it
+        useHashAggregationRule_pass6                  = 860,
+
 //////////////////////////////////////////////////////////////////////////////
 /// Pass 9: push down calculations beyond FILTERs and LIMITs
 //////////////////////////////////////////////////////////////////////////////
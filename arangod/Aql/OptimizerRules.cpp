@@ -840,6 +840,8 @@ int triagens::aql::removeSortRandRule (Optimizer* opt,
         case EN::FILTER: 
         case EN::SUBQUERY:
         case EN::ENUMERATE_LIST:
+        case EN::GEO_INDEX:
+        case EN::FULLTEXT_INDEX:
         case EN::INDEX_RANGE: {
           // if we found another SortNode, an AggregateNode, FilterNode, a SubqueryNode, 
           // an EnumerateListNode or an IndexRangeNode
@@ -1047,6 +1049,8 @@ int triagens::aql::moveCalculationsDownRule (Optimizer* opt,
         shouldMove = true;
       } 
       else if (currentType == EN::INDEX_RANGE ||
+               currentType == EN::GEO_INDEX ||
+               currentType == EN::FULLTEXT_INDEX ||
                currentType == EN::ENUMERATE_COLLECTION ||
                currentType == EN::ENUMERATE_LIST ||
                currentType == EN::AGGREGATE ||
@@ -1945,6 +1949,8 @@ class FilterToEnumCollFinder : public WalkerWorker<ExecutionNode> {
           // collection, we abort . . .
           return true;
         case EN::SORT:
+        case EN::GEO_INDEX:
+        case EN::FULLTEXT_INDEX:
         case EN::INDEX_RANGE:
           break;
         case EN::ENUMERATE_COLLECTION: {
@@ -2621,6 +2627,8 @@ class SortToIndexNode : public WalkerWorker<ExecutionNode> {
 
         if (node->getType() == EN::ENUMERATE_COLLECTION ||
             node->getType() == EN::INDEX_RANGE ||
+            node->getType() == EN::GEO_INDEX ||
+            node->getType() == EN::FULLTEXT_INDEX ||
             node->getType() == EN::ENUMERATE_LIST) {
           // we are contained in an outer loop
           return true;
@@ -2726,6 +2734,7 @@ class SortToIndexNode : public WalkerWorker<ExecutionNode> {
     bool before (ExecutionNode* en) override final {
       switch (en->getType()) {
       case EN::ENUMERATE_LIST:
+      case EN::FULLTEXT_INDEX:
       case EN::CALCULATION:
       case EN::SUBQUERY:
       case EN::FILTER:
@@ -2746,6 +2755,7 @@ class SortToIndexNode : public WalkerWorker<ExecutionNode> {
       case EN::REMOTE:
       case EN::ILLEGAL:
       case EN::LIMIT:                      // LIMIT is criterion to stop
+      case EN::GEO_INDEX:                  // documents are ordered by distance
         return true;  // abort.
 
       case EN::SORT:     // pulling two sorts together is done elsewhere.
@@ -2790,6 +2800,950 @@ int triagens::aql::useIndexForSortRule (Optimizer* opt,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a DISTANCE() between the documents of a collection and a constant
+/// coordinate, which a geo index of the collection can answer
+////////////////////////////////////////////////////////////////////////////////
+
+struct GeoDistance {
+  Index const* index;
+  double       latitude;
+  double       longitude;
+
+  bool operator== (GeoDistance const& other) const {
+    return (index == other.index &&
+            latitude == other.latitude &&
+            longitude == other.longitude);
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the name of the attribute that an expression accesses on a 
+/// variable, e.g. "a.b" for "variable.a.b"
+////////////////////////////////////////////////////////////////////////////////
+
+static bool GeoAttributeName (AstNode const* node,
+                              Variable const* variable,
+                              std::string& name) {
+  if (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    if (! GeoAttributeName(node->getMember(0), variable, name)) {
+      return false;
+    }
+    if (! name.empty()) {
+      name.push_back('.');
+    }
+    name.append(node->getStringValue());
+    return true;
+  }
+
+  if (node->type == NODE_TYPE_REFERENCE) {
+    name.clear();
+    return (static_cast<Variable const*>(node->getData()) == variable);
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not an expression accesses the array member at the
+/// given position of an attribute of a variable, e.g. "variable.a[0]"
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsGeoArrayMember (AstNode const* node,
+                              Variable const* variable,
+                              std::string const& attribute,
+                              int64_t position) {
+  if (node->type != NODE_TYPE_INDEXED_ACCESS) {
+    return false;
+  }
+
+  auto index = node->getMember(1);
+
+  if (index->type != NODE_TYPE_VALUE || 
+      index->value.type != VALUE_TYPE_INT ||
+      index->getIntValue() != position) {
+    return false;
+  }
+
+  std::string name;
+  return (GeoAttributeName(node->getMember(0), variable, name) && name == attribute);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether an expression is a DISTANCE() call that one of the
+/// geo indexes can answer. this requires the first coordinate to consist of
+/// the indexed attributes of the variable, and the second one to be constant
+////////////////////////////////////////////////////////////////////////////////
+
+static bool MatchGeoDistance (AstNode const* node,
+                              Variable const* variable,
+                              std::vector<Index*> const& indexes,
+                              GeoDistance& result) {
+  if (node->type != NODE_TYPE_FCALL) {
+    return false;
+  }
+
+  auto func = static_cast<Function const*>(node->getData());
+
+  if (func->externalName != "DISTANCE") {
+    return false;
+  }
+
+  auto args = node->getMember(0);
+
+  if (args->numMembers() != 4) {
+    return false;
+  }
+
+  auto latitude  = args->getMember(2);
+  auto longitude = args->getMember(3);
+
+  if (! latitude->isNumericValue() || ! longitude->isNumericValue()) {
+    return false;
+  }
+
+  result.latitude  = latitude->getDoubleValue();
+  result.longitude = longitude->getDoubleValue();
+
+  if (result.latitude < -90.0 || result.latitude > 90.0 ||
+      result.longitude < -180.0 || result.longitude > 180.0) {
+    // the geo index cannot look up invalid coordinates
+    return false;
+  }
+
+  for (auto idx : indexes) {
+    if (! idx->hasInternals()) {
+      // index is not local (cluster)
+      continue;
+    }
+
+    if (idx->type == TRI_IDX_TYPE_GEO2_INDEX) {
+      // separate latitude and longitude attributes
+      std::string latitudeName;
+      std::string longitudeName;
+
+      if (idx->fields.size() == 2 &&
+          GeoAttributeName(args->getMember(0), variable, latitudeName) &&
+          GeoAttributeName(args->getMember(1), variable, longitudeName) &&
+          latitudeName == idx->fields[0] && 
+          longitudeName == idx->fields[1]) {
+        result.index = idx;
+        return true;
+      }
+    }
+    else if (idx->type == TRI_IDX_TYPE_GEO1_INDEX) {
+      // one array attribute, [ latitude, longitude ] or [ longitude, latitude ] 
+      // for GeoJSON
+      bool const geoJson = reinterpret_cast<TRI_geo_index_t const*>(idx->getInternals())->_geoJson;
+
+      if (idx->fields.size() == 1 &&
+          IsGeoArrayMember(args->getMember(0), variable, idx->fields[0], geoJson ? 1 : 0) &&
+          IsGeoArrayMember(args->getMember(1), variable, idx->fields[0], geoJson ? 0 : 1)) {
+        result.index = idx;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether an expression compares a geo index DISTANCE() with a
+/// constant maximum distance, e.g. "DISTANCE(...) < 1000"
+////////////////////////////////////////////////////////////////////////////////
+
+static bool MatchGeoRadius (AstNode const* node,
+                            Variable const* variable,
+                            std::vector<Index*> const& indexes,
+                            std::unordered_map<VariableId, GeoDistance> const& distances,
+                            GeoDistance& result,
+                            double& radius) {
+  AstNode const* distance;
+  AstNode const* value;
+
+  if (node->type == NODE_TYPE_OPERATOR_BINARY_LT ||
+      node->type == NODE_TYPE_OPERATOR_BINARY_LE) {
+    distance = node->getMember(0);
+    value    = node->getMember(1);
+  }
+  else if (node->type == NODE_TYPE_OPERATOR_BINARY_GT ||
+           node->type == NODE_TYPE_OPERATOR_BINARY_GE) {
+    distance = node->getMember(1);
+    value    = node->getMember(0);
+  }
+  else {
+    return false;
+  }
+
+  if (! value->isNumericValue()) {
+    return false;
+  }
+
+  radius = value->getDoubleValue();
+
+  if (radius < 0.0) {
+    return false;
+  }
+
+  if (distance->type == NODE_TYPE_REFERENCE) {
+    // distance calculated in an earlier LET
+    auto it = distances.find(static_cast<Variable const*>(distance->getData())->id);
+
+    if (it == distances.end()) {
+      return false;
+    }
+
+    result = (*it).second;
+    return true;
+  }
+
+  return MatchGeoDistance(distance, variable, indexes, result);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a node is contained in an outer loop
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsInInnerLoop (ExecutionNode const* node) {
+  while (node != nullptr) {
+    auto deps = node->getDependencies();
+
+    if (deps.size() != 1) {
+      return false;
+    }
+
+    node = deps[0];
+
+    if (node->getType() == EN::ENUMERATE_COLLECTION ||
+        node->getType() == EN::INDEX_RANGE ||
+        node->getType() == EN::GEO_INDEX ||
+        node->getType() == EN::FULLTEXT_INDEX ||
+        node->getType() == EN::ENUMERATE_LIST) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a geo index for SORT DISTANCE(...) LIMIT n and for 
+/// FILTER DISTANCE(...) < r
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::useGeoIndexRule (Optimizer* opt, 
+                                    ExecutionPlan* plan, 
+                                    Optimizer::Rule const* rule) {
+  bool modified = false;
+  std::vector<ExecutionNode*> nodes = plan->findNodesOfType(EN::ENUMERATE_COLLECTION, true);
+
+  for (auto n : nodes) {
+    auto en = static_cast<EnumerateCollectionNode*>(n);
+
+    if (en->isRandom()) {
+      continue;
+    }
+
+    std::vector<Index*> const indexes = en->getGeoIndexes();
+
+    if (indexes.empty()) {
+      continue;
+    }
+
+    auto const variable = en->outVariable();
+    bool const innerLoop = IsInInnerLoop(n);
+
+    // variables that hold a DISTANCE() value, and variables that hold a
+    // comparison of a DISTANCE() value with a constant radius
+    std::unordered_map<VariableId, GeoDistance> distances;
+    std::unordered_map<VariableId, std::pair<GeoDistance, double>> conditions;
+
+    GeoDistance target = { nullptr, 0.0, 0.0 };
+    bool hasTarget  = false;
+    double radius   = -1.0;
+    SortNode* sortNode = nullptr;
+    size_t limit    = 0;
+    bool hasFilter  = false;
+
+    // walk the nodes following the collection enumeration, as long as these do
+    // not change the number of rows per document or their order
+    ExecutionNode* current = n;
+
+    while (true) {
+      auto parents = current->getParents();
+
+      if (parents.size() != 1) {
+        break;
+      }
+
+      current = parents[0];
+      auto const type = current->getType();
+
+      if (type == EN::CALCULATION) {
+        auto cn = static_cast<CalculationNode*>(current);
+        auto const node = cn->expression()->node();
+        GeoDistance distance;
+        double maxDistance;
+
+        if (MatchGeoDistance(node, variable, indexes, distance)) {
+          distances.emplace(cn->outVariable()->id, distance);
+        }
+        else if (MatchGeoRadius(node, variable, indexes, distances, distance, maxDistance)) {
+          conditions.emplace(cn->outVariable()->id, std::make_pair(distance, maxDistance));
+        }
+        continue;
+      }
+
+      if (type == EN::FILTER) {
+        auto it = conditions.find(current->getVariablesUsedHere()[0]->id);
+
+        if (it != conditions.end() &&
+            (! hasTarget || (*it).second.first == target)) {
+          // the filter stays in the plan, the index lookup only narrows the
+          // documents down to those that can pass it
+          target    = (*it).second.first;
+          hasTarget = true;
+
+          if (radius < 0.0 || (*it).second.second < radius) {
+            radius = (*it).second.second;
+          }
+        }
+        else {
+          // some other filter. this invalidates pushing a LIMIT into the index
+          hasFilter = true;
+        }
+        continue;
+      }
+
+      if (type == EN::SORT) {
+        auto sn = static_cast<SortNode*>(current);
+        auto const& elements = sn->getElements();
+
+        if (innerLoop ||
+            sortNode != nullptr ||
+            elements.size() != 1 ||
+            ! elements[0].second) {
+          // only a single ascending distance sort in the outermost loop can 
+          // be replaced by the geo index order
+          break;
+        }
+
+        auto it = distances.find(elements[0].first->id);
+
+        if (it == distances.end() ||
+            (hasTarget && ! ((*it).second == target))) {
+          break;
+        }
+
+        target    = (*it).second;
+        hasTarget = true;
+        sortNode  = sn;
+        continue;
+      }
+
+      if (type == EN::LIMIT) {
+        auto ln = static_cast<LimitNode*>(current);
+
+        if (sortNode != nullptr && 
+            ! hasFilter && 
+            ! ln->fullCount()) {
+          // the LIMIT stays in the plan, the index lookup only fetches the
+          // documents it can return
+          limit = ln->offset() + ln->limit();
+        }
+      }
+
+      // all other nodes may change the number or the order of rows
+      break;
+    }
+
+    if (! hasTarget || 
+        (radius < 0.0 && limit == 0)) {
+      // a geo lookup without limit or radius would return all documents
+      continue;
+    }
+
+    auto geoNode = new GeoIndexNode(plan, 
+                                    plan->nextId(), 
+                                    en->vocbase(), 
+                                    en->collection(), 
+                                    variable, 
+                                    target.index, 
+                                    target.latitude, 
+                                    target.longitude, 
+                                    limit, 
+                                    radius);
+    plan->registerNode(geoNode);
+    plan->replaceNode(n, geoNode);
+
+    if (sortNode != nullptr) {
+      // the geo index returns the documents ordered by distance
+      // note: the CalculationNode will be removed by "remove-unnecessary-calculations"
+      // rule if not used
+      plan->unlinkNode(sortNode);
+    }
+
+    modified = true;
+  }
+  
+  if (modified) {
+    plan->findVarUsage();
+  }
+  
+  opt->addPlan(plan, rule->level, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a fulltext index for FOR doc IN FULLTEXT(collection, attribute,
+/// query). the lookup is done natively by a FulltextIndexNode, which hands out
+/// the documents found without building an intermediate array value
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::useFulltextIndexRule (Optimizer* opt, 
+                                         ExecutionPlan* plan, 
+                                         Optimizer::Rule const* rule) {
+  if (triagens::arango::ServerState::instance()->isCoordinator()) {
+    // the coordinator has no access to the index data
+    opt->addPlan(plan, rule->level, false);
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  bool modified = false;
+  std::vector<ExecutionNode*> nodes = plan->findNodesOfType(EN::ENUMERATE_LIST, true);
+  std::vector<std::pair<ExecutionNode*, Variable const*>> calculations;
+
+  for (auto n : nodes) {
+    auto const inVariable = n->getVariablesUsedHere()[0];
+    auto setter = plan->getVarSetBy(inVariable->id);
+
+    if (setter == nullptr || setter->getType() != EN::CALCULATION) {
+      continue;
+    }
+
+    auto const expression = static_cast<CalculationNode*>(setter)->expression();
+
+    if (expression == nullptr ||
+        expression->node() == nullptr ||
+        expression->node()->type != NODE_TYPE_FCALL) {
+      continue;
+    }
+
+    auto const node = expression->node();
+    auto func = static_cast<Function const*>(node->getData());
+
+    if (func->externalName != "FULLTEXT") {
+      continue;
+    }
+
+    auto args = node->getMember(0);
+
+    if (args->numMembers() != 3) {
+      continue;
+    }
+
+    auto collectionArg = args->getMember(0);
+    auto attributeArg  = args->getMember(1);
+    auto queryArg      = args->getMember(2);
+
+    if ((collectionArg->type != NODE_TYPE_COLLECTION && ! collectionArg->isStringValue()) ||
+        ! attributeArg->isStringValue() ||
+        ! queryArg->isStringValue()) {
+      // only constant lookups can be done by the index node
+      continue;
+    }
+
+    auto collection = plan->getAst()->query()->collections()->get(collectionArg->getStringValue());
+
+    if (collection == nullptr) {
+      // collection is not used by the query
+      continue;
+    }
+
+    std::string const attribute(attributeArg->getStringValue());
+    Index const* index = nullptr;
+
+    for (auto idx : collection->getIndexes()) {
+      if (idx->type == TRI_IDX_TYPE_FULLTEXT_INDEX &&
+          ! idx->fields.empty() &&
+          idx->fields[0] == attribute &&
+          idx->getInternals() != nullptr) {
+        // use the first matching index, as FULLTEXT() does
+        index = idx;
+        break;
+      }
+    }
+
+    if (index == nullptr) {
+      continue;
+    }
+
+    auto fulltextNode = new FulltextIndexNode(plan, 
+                                              plan->nextId(), 
+                                              plan->getAst()->query()->vocbase(), 
+                                              collection, 
+                                              n->getVariablesSetHere()[0], 
+                                              index, 
+                                              std::string(queryArg->getStringValue()));
+    plan->registerNode(fulltextNode);
+    plan->replaceNode(n, fulltextNode);
+    calculations.emplace_back(setter, inVariable);
+
+    modified = true;
+  }
+  
+  if (modified) {
+    plan->findVarUsage();
+
+    // the FULLTEXT() calculations are flagged as throwing, so they would not
+    // be removed by "remove-unnecessary-calculations". the index node raises 
+    // the same errors for invalid queries, so they can be removed here if 
+    // their results are not used elsewhere
+    std::unordered_set<ExecutionNode*> toUnlink;
+
+    for (auto const& it : calculations) {
+      auto varsUsedLater = it.first->getVarsUsedLater();
+
+      if (varsUsedLater.find(it.second) == varsUsedLater.end()) {
+        toUnlink.insert(it.first);
+      }
+    }
+
+    if (! toUnlink.empty()) {
+      plan->unlinkNodes(toUnlink);
+      plan->findVarUsage();
+    }
+  }
+  
+  opt->addPlan(plan, rule->level, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum number of estimated input rows for a COLLECT to use hashing
+/// below this, sorting the input is cheap enough
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const HashAggregationMinItems = 1000;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum number of estimated input rows per group for a COLLECT to
+/// use hashing. with fewer rows per group, the groups themselves would have to
+/// be sorted at about the same cost as the input
+////////////////////////////////////////////////////////////////////////////////
+
+static double const HashAggregationMinRowsPerGroup = 4.0;
+
+static double EstimateDistinctValues (ExecutionPlan const*,
+                                      AstNode const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of distinct values a variable can take
+/// returns 0 if unknown
+////////////////////////////////////////////////////////////////////////////////
+
+static double EstimateDistinctValues (ExecutionPlan const* plan,
+                                      Variable const* variable) {
+  auto setter = plan->getVarSetBy(variable->id);
+
+  if (setter == nullptr) {
+    return 0.0;
+  }
+
+  if (setter->getType() == EN::CALCULATION) {
+    auto expression = static_cast<CalculationNode const*>(setter)->expression();
+
+    if (expression == nullptr) {
+      return 0.0;
+    }
+
+    return EstimateDistinctValues(plan, expression->node());
+  }
+
+  if (setter->getType() == EN::ENUMERATE_LIST) {
+    // each member of a constant list is a distinct value at most
+    auto listVariable = setter->getVariablesUsedHere()[0];
+    auto listSetter = plan->getVarSetBy(listVariable->id);
+
+    if (listSetter == nullptr ||
+        listSetter->getType() != EN::CALCULATION) {
+      return 0.0;
+    }
+
+    auto expression = static_cast<CalculationNode const*>(listSetter)->expression();
+
+    if (expression == nullptr) {
+      return 0.0;
+    }
+
+    auto node = expression->node();
+
+    if (node->type == NODE_TYPE_ARRAY &&
+        node->isConstant()) {
+      return static_cast<double>(node->numMembers());
+    }
+
+    if (node->type == NODE_TYPE_RANGE) {
+      auto low = node->getMember(0);
+      auto high = node->getMember(1);
+
+      if (low->isConstant() &&
+          high->isConstant() &&
+          low->isNumericValue() &&
+          high->isNumericValue()) {
+        return std::abs(static_cast<double>(high->getIntValue() - low->getIntValue())) + 1.0;
+      }
+    }
+  }
+
+  return 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collect the attribute names of an attribute access chain such as
+/// doc.a.b, and return the variable it starts at
+////////////////////////////////////////////////////////////////////////////////
+
+static Variable const* GetAttributePath (AstNode const* node,
+                                         std::string& path) {
+  std::vector<std::string> parts;
+
+  while (node->type == NODE_TYPE_ATTRIBUTE_ACCESS) {
+    parts.emplace_back(node->getStringValue());
+    node = node->getMember(0);
+  }
+
+  if (node->type != NODE_TYPE_REFERENCE || parts.empty()) {
+    return nullptr;
+  }
+
+  path.clear();
+  for (auto it = parts.rbegin(); it != parts.rend(); ++it) {
+    if (! path.empty()) {
+      path.push_back('.');
+    }
+    path.append(*it);
+  }
+
+  return static_cast<Variable const*>(node->getData());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of distinct value combinations of some
+/// attributes of the documents of a collection, using the collection's
+/// indexes. returns 0 if unknown
+////////////////////////////////////////////////////////////////////////////////
+
+static double EstimateDistinctAttributeValues (ExecutionPlan const* plan,
+                                               Variable const* variable,
+                                               std::vector<std::string> const& attributes) {
+  auto setter = plan->getVarSetBy(variable->id);
+
+  if (setter == nullptr) {
+    return 0.0;
+  }
+
+  Collection const* collection = nullptr;
+
+  if (setter->getType() == EN::ENUMERATE_COLLECTION) {
+    collection = static_cast<EnumerateCollectionNode const*>(setter)->collection();
+  }
+  else if (setter->getType() == EN::INDEX_RANGE) {
+    collection = static_cast<IndexRangeNode const*>(setter)->collection();
+  }
+
+  if (collection == nullptr) {
+    return 0.0;
+  }
+
+  double const count = static_cast<double>(collection->count());
+
+  for (auto const& it : attributes) {
+    if (it == TRI_VOC_ATTRIBUTE_KEY || it == TRI_VOC_ATTRIBUTE_ID) {
+      // unique per document
+      return count;
+    }
+  }
+
+  size_t const n = attributes.size();
+  auto c = plan->getAst()->query()->collections()->get(collection->getName());
+
+  for (auto const& index : c->getIndexes()) {
+    if (! index->hasInternals() ||
+        index->fields.size() < n) {
+      continue;
+    }
+
+    // the first n indexed attributes must be exactly the group attributes
+    bool covered = true;
+    for (size_t i = 0; i < n; ++i) {
+      if (std::find(attributes.begin(), attributes.end(), index->fields[i]) == attributes.end()) {
+        covered = false;
+        break;
+      }
+    }
+
+    if (! covered) {
+      continue;
+    }
+
+    double distinct = index->distinctEstimate(n);
+
+    if (distinct <= 0.0 &&
+        index->fields.size() == n &&
+        index->hasSelectivityEstimate()) {
+      distinct = index->selectivityEstimate() * count;
+    }
+
+    if (distinct > 0.0) {
+      return distinct;
+    }
+  }
+
+  return 0.0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of distinct values of an expression
+/// returns 0 if unknown
+////////////////////////////////////////////////////////////////////////////////
+
+static double EstimateDistinctValues (ExecutionPlan const* plan,
+                                      AstNode const* node) {
+  if (node->isConstant()) {
+    return 1.0;
+  }
+
+  if (node->isComparisonOperator() ||
+      node->type == NODE_TYPE_OPERATOR_UNARY_NOT) {
+    // true or false
+    return 2.0;
+  }
+
+  switch (node->type) {
+    case NODE_TYPE_OPERATOR_BINARY_MOD: {
+      auto rhs = node->getMember(1);
+
+      if (rhs->isConstant() && rhs->isNumericValue()) {
+        double const divisor = std::abs(rhs->getDoubleValue());
+
+        if (divisor >= 1.0) {
+          // the remainder can be negative, too
+          return std::floor(divisor) * 2.0 - 1.0;
+        }
+      }
+      return 0.0;
+    }
+
+    case NODE_TYPE_OPERATOR_TERNARY: {
+      double const lhs = EstimateDistinctValues(plan, node->getMember(1));
+      double const rhs = EstimateDistinctValues(plan, node->getMember(2));
+
+      if (lhs > 0.0 && rhs > 0.0) {
+        return lhs + rhs;
+      }
+      return 0.0;
+    }
+
+    case NODE_TYPE_REFERENCE: {
+      return EstimateDistinctValues(plan, static_cast<Variable const*>(node->getData()));
+    }
+
+    case NODE_TYPE_ATTRIBUTE_ACCESS: {
+      std::string path;
+      auto variable = GetAttributePath(node, path);
+
+      if (variable == nullptr) {
+        return 0.0;
+      }
+
+      return EstimateDistinctAttributeValues(plan, variable, std::vector<std::string>({ path }));
+    }
+
+    default: {
+      return 0.0;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimate the number of groups a COLLECT produces
+/// returns 0 if unknown
+////////////////////////////////////////////////////////////////////////////////
+
+static double EstimateGroups (ExecutionPlan const* plan,
+                              AggregateNode const* collectNode) {
+  auto const& aggregateVariables = collectNode->aggregateVariables();
+
+  // group attributes of the same document may be covered by one index
+  Variable const* document = nullptr;
+  std::vector<std::string> attributes;
+
+  for (auto const& it : aggregateVariables) {
+    auto setter = plan->getVarSetBy(it.second->id);
+
+    if (setter == nullptr ||
+        setter->getType() != EN::CALCULATION) {
+      document = nullptr;
+      break;
+    }
+
+    auto expression = static_cast<CalculationNode const*>(setter)->expression();
+    std::string path;
+    auto variable = (expression == nullptr ? nullptr : GetAttributePath(expression->node(), path));
+
+    if (variable == nullptr ||
+        (document != nullptr && document != variable)) {
+      document = nullptr;
+      break;
+    }
+
+    document = variable;
+    attributes.emplace_back(path);
+  }
+
+  if (document != nullptr) {
+    double const groups = EstimateDistinctAttributeValues(plan, document, attributes);
+
+    if (groups > 0.0) {
+      return groups;
+    }
+  }
+
+  // otherwise assume the group values are independent
+  double groups = 1.0;
+
+  for (auto const& it : aggregateVariables) {
+    double const distinct = EstimateDistinctValues(plan, it.second);
+
+    if (distinct <= 0.0) {
+      return 0.0;
+    }
+
+    groups *= distinct;
+  }
+
+  return groups;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a hash table for grouping in COLLECT
+/// this rule modifies the plan in place:
+/// - the SORT that was created for a COLLECT without INTO (or with COUNT INTO)
+///   is removed, and the COLLECT groups its input using a hash table
+/// - this is only done if the input is big and the estimated number of groups
+///   is much smaller than the input. if the number of groups is unknown, it
+///   is assumed to be as big as the input
+/// - unless the COLLECT is directly followed by a SORT, a SORT on the group
+///   variables is inserted after the COLLECT so that only the (usually few)
+///   groups get sorted and the result order is the same as before
+////////////////////////////////////////////////////////////////////////////////
+
+int triagens::aql::useHashAggregationRule (Optimizer* opt, 
+                                           ExecutionPlan* plan,
+                                           Optimizer::Rule const* rule) {
+  bool modified = false;
+  std::vector<ExecutionNode*> nodes = plan->findNodesOfType(EN::AGGREGATE, true);
+  
+  for (auto n : nodes) {
+    auto collectNode = static_cast<AggregateNode*>(n);
+    TRI_ASSERT(collectNode != nullptr);
+
+    if (collectNode->isHashed() || 
+        ! collectNode->canUseHashing()) {
+      continue;
+    }
+
+    auto const& aggregateVariables = collectNode->aggregateVariables();
+
+    if (aggregateVariables.empty()) {
+      // total aggregation. input is never sorted for this
+      continue;
+    }
+
+    auto deps = collectNode->getDependencies();
+
+    if (deps.size() != 1 || 
+        deps[0]->getType() != EN::SORT) {
+      // input is not sorted by a SORT, e.g. because an index is used
+      continue;
+    }
+
+    auto sortNode = static_cast<SortNode*>(deps[0]);
+    auto const& elements = sortNode->getElements();
+
+    if (elements.size() != aggregateVariables.size() ||
+        sortNode->getParents().size() != 1) {
+      continue;
+    }
+
+    // the SORT must be the one that sorts on the COLLECT's input variables
+    bool isCollectSort = true;
+    for (size_t i = 0; i < elements.size(); ++i) {
+      if (elements[i].first != aggregateVariables[i].second) {
+        isCollectSort = false;
+        break;
+      }
+    }
+
+    if (! isCollectSort) {
+      continue;
+    }
+
+    size_t nrItems = 0;
+    sortNode->getDependencies()[0]->getCost(nrItems);
+
+    if (nrItems < HashAggregationMinItems) {
+      // not worth it
+      continue;
+    }
+
+    double const groups = EstimateGroups(plan, collectNode);
+
+    if (groups <= 0.0 ||
+        groups * HashAggregationMinRowsPerGroup > static_cast<double>(nrItems)) {
+      // (almost) every row forms a group of its own, so the groups would
+      // have to be sorted at about the cost of sorting the input
+      continue;
+    }
+
+    auto parents = collectNode->getParents();
+
+    if (parents.size() != 1) {
+      continue;
+    }
+
+    plan->unlinkNode(sortNode);
+    collectNode->useHashing();
+
+    if (parents[0]->getType() != EN::SORT &&
+        parents[0]->getDependencies().size() == 1) {
+      // restore the sort order of the groups by sorting the output
+      SortElementVector groupElements;
+      for (auto const& it : aggregateVariables) {
+        groupElements.emplace_back(std::make_pair(it.first, true));
+      }
+
+      auto groupSortNode = new SortNode(plan, plan->nextId(), groupElements, true);
+      plan->registerNode(groupSortNode);
+      plan->insertDependency(parents[0], groupSortNode);
+    }
+
+    modified = true;
+  }
+  
+  if (modified) {
+    plan->findVarUsage();
+  }
+  
+  opt->addPlan(plan, rule->level, modified);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 // TODO: finish rule and test it
 struct FilterCondition {
   std::string variableName;
@@ -3561,6 +4515,8 @@ int triagens::aql::distributeFilternCalcToClusterRule (Optimizer* opt,
         case EN::REMOTE:
         case EN::LIMIT:
         case EN::SORT:
+        case EN::GEO_INDEX:
+        case EN::FULLTEXT_INDEX:
         case EN::INDEX_RANGE:
         case EN::ENUMERATE_COLLECTION:
           stopSearching = true;
@@ -3653,6 +4609,8 @@ int triagens::aql::distributeSortToClusterRule (Optimizer* opt,
         case EN::ILLEGAL:
         case EN::REMOTE:
         case EN::LIMIT:
+        case EN::GEO_INDEX:
+        case EN::FULLTEXT_INDEX:
         case EN::INDEX_RANGE:
         case EN::ENUMERATE_COLLECTION:
           // For all these, we do not want to pull a SortNode further down
@@ -3929,6 +4887,8 @@ class RemoveToEnumCollFinder : public WalkerWorker<ExecutionNode> {
         case EN::ILLEGAL:
         case EN::LIMIT:           
         case EN::SORT:
+        case EN::GEO_INDEX:
+        case EN::FULLTEXT_INDEX:
         case EN::INDEX_RANGE: {
           // if we meet any of the above, then we abort . . .
         }
@@ -138,6 +138,25 @@ namespace triagens {
 
     int useIndexForSortRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a geo index for SORT DISTANCE(...) LIMIT n and for 
+/// FILTER DISTANCE(...) < r
+////////////////////////////////////////////////////////////////////////////////
+
+    int useGeoIndexRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a fulltext index for FOR ... IN FULLTEXT(...)
+////////////////////////////////////////////////////////////////////////////////
+
+    int useFulltextIndexRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use a hash table for grouping in COLLECT instead of sorting the input
+////////////////////////////////////////////////////////////////////////////////
+
+    int useHashAggregationRule (Optimizer*, ExecutionPlan*, Optimizer::Rule const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief try to remove filters which are covered by indexes
 ////////////////////////////////////////////////////////////////////////////////
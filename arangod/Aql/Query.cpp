@@ -35,6 +35,8 @@
 #include "Aql/Optimizer.h"
 #include "Aql/Parser.h"
 #include "Aql/QueryList.h"
+#include "Aql/QueryPlanCache.h"
+#include "Aql/QueryResultCache.h"
 #include "Basics/JsonHelper.h"
 #include "Basics/json.h"
 #include "Basics/tri-strings.h"
@@ -44,7 +46,9 @@
 #include "Utils/CollectionNameResolver.h"
 #include "Utils/StandaloneTransactionContext.h"
 #include "Utils/V8TransactionContext.h"
+#include "V8/v8-conv.h"
 #include "V8Server/ApplicationV8.h"
+#include "VocBase/document-collection.h"
 #include "VocBase/vocbase.h"
 
 using namespace triagens::aql;
@@ -518,7 +522,27 @@ QueryResult Query::prepare (QueryRegistry* registry) {
     std::unique_ptr<Parser> parser(new Parser(this));
     std::unique_ptr<ExecutionPlan> plan;
 
-    if (_queryString != nullptr) {
+    QueryPlanCache* planCache = nullptr;
+    std::string planCacheKey;
+    uint64_t planCacheVersion = 0;
+    std::shared_ptr<QueryPlanCacheEntry const> cachedPlan;
+
+    if (canUsePlanCache()) {
+      planCache = static_cast<QueryPlanCache*>(_vocbase->_queryPlanCache);
+      planCacheKey = buildPlanCacheKey();
+      // the version must be fetched before the plan is built
+      planCacheVersion = planCache->version();
+      cachedPlan = planCache->lookup(planCacheKey);
+    }
+
+    Json const cachedJson(TRI_UNKNOWN_MEM_ZONE, cachedPlan != nullptr ? cachedPlan->plan : nullptr, Json::NOFREE);
+
+    if (cachedPlan != nullptr) {
+      // we have an optimized plan already, no need to parse the query
+      ExecutionPlan::getCollectionsFromJson(parser->ast(), cachedJson);
+      parser->ast()->variables()->fromJson(cachedJson);
+    }
+    else if (_queryString != nullptr) {
       parser->parse(false);
       // put in bind parameters
       parser->ast()->injectBindParameters(_bindParameters);
@@ -530,7 +554,26 @@ QueryResult Query::prepare (QueryRegistry* registry) {
 
     bool planRegisters;
 
-    if (_queryString != nullptr) {
+    if (cachedPlan != nullptr) {
+      // we have an execution plan from the plan cache
+      int res = _trx->begin();
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return transactionError(res);
+      }
+
+      enterState(PLAN_INSTANCIATION);
+      plan.reset(ExecutionPlan::instanciateFromJson(parser->ast(), cachedJson));
+
+      if (plan.get() == nullptr) {
+        // oops
+        return QueryResult(TRI_ERROR_INTERNAL);
+      }
+
+      // the cached plan contains the register planning already
+      planRegisters = false;
+    }
+    else if (_queryString != nullptr) {
       // we have an AST
       int res = _trx->begin();
 
@@ -613,6 +656,20 @@ QueryResult Query::prepare (QueryRegistry* registry) {
     enterState(EXECUTION);
     ExecutionEngine* engine(ExecutionEngine::instanciateFromPlan(registry, this, plan.get(), planRegisters));
 
+    if (planCache != nullptr && 
+        cachedPlan == nullptr && 
+        _warnings.empty()) {
+      // store the optimized plan, including its register planning. plans
+      // that produced warnings are not cached because the warnings would
+      // be lost when the plan is reused
+      try {
+        planCache->store(planCacheKey, plan->toJson(parser->ast(), TRI_UNKNOWN_MEM_ZONE, true).steal(), planCacheVersion);
+      }
+      catch (...) {
+        // failing to cache the plan is not an error
+      }
+    }
+
     // If all went well so far, then we keep _plan, _parser and _trx and
     // return:
     _plan = plan.release();
@@ -645,13 +702,35 @@ QueryResult Query::prepare (QueryRegistry* registry) {
 QueryResult Query::execute (QueryRegistry* registry) {
   // Now start the execution:
   try {
+    QueryResultCache* resultCache = nullptr;
+    std::string resultCacheKey;
+
+    if (canUseResultCache()) {
+      resultCache = static_cast<QueryResultCache*>(_vocbase->_queryResultCache);
+      resultCacheKey = buildResultCacheKey();
+
+      auto entry = resultCache->lookup(resultCacheKey);
+
+      if (entry != nullptr) {
+        // a result can only have been cached if the query is deterministic
+        // and none of its collections was modified since
+        return cachedResult(*entry);
+      }
+    }
+
     QueryResult res = prepare(registry);
     if (res.code != TRI_ERROR_NO_ERROR) {
       return res;
     }
 
+    std::vector<QueryResultCacheRevision> revisions;
+
+    if (resultCache != nullptr &&
+        ! getResultCacheRevisions(revisions)) {
+      resultCache = nullptr;
+    }
+
     triagens::basics::Json jsonResult(triagens::basics::Json::Array, 16);
-    triagens::basics::Json stats;
 
     AqlItemBlock* value = nullptr;
 
@@ -678,23 +757,21 @@ QueryResult Query::execute (QueryRegistry* registry) {
       throw;
     }
 
-    stats = _engine->_stats.toJson();
-
-    _trx->commit();
-    
-    cleanupPlanAndEngine(TRI_ERROR_NO_ERROR);
-
-    enterState(FINALIZATION); 
-
-    QueryResult result(TRI_ERROR_NO_ERROR);
-    result.warnings = warningsToJson(TRI_UNKNOWN_MEM_ZONE);
-    result.json     = jsonResult.steal();
-    result.stats    = stats.steal(); 
-
-    if (_profile != nullptr && profiling()) {
-      result.profile = _profile->toJson(TRI_UNKNOWN_MEM_ZONE);
+    if (resultCache != nullptr &&
+        _warnings.empty()) {
+      // the collections are still in use, so their revisions can be
+      // checked against the ones seen when the query started
+      try {
+        resultCache->store(resultCacheKey, jsonResult.toString(), revisions);
+      }
+      catch (...) {
+        // failing to cache the result is not an error
+      }
     }
 
+    QueryResult result = finalize();
+    result.json = jsonResult.steal();
+
     return result;
   }
   catch (triagens::basics::Exception const& ex) {
@@ -715,6 +792,34 @@ QueryResult Query::execute (QueryRegistry* registry) {
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finalize a prepared AQL query after all results have been fetched
+/// from its engine
+////////////////////////////////////////////////////////////////////////////////
+
+QueryResult Query::finalize () {
+  TRI_ASSERT(_engine != nullptr);
+  TRI_ASSERT(_trx != nullptr);
+
+  triagens::basics::Json stats = _engine->_stats.toJson();
+
+  _trx->commit();
+    
+  cleanupPlanAndEngine(TRI_ERROR_NO_ERROR);
+
+  enterState(FINALIZATION); 
+
+  QueryResult result(TRI_ERROR_NO_ERROR);
+  result.warnings = warningsToJson(TRI_UNKNOWN_MEM_ZONE);
+  result.stats    = stats.steal(); 
+
+  if (_profile != nullptr && profiling()) {
+    result.profile = _profile->toJson(TRI_UNKNOWN_MEM_ZONE);
+  }
+
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief execute an AQL query 
 /// may only be called with an active V8 handle scope
@@ -724,15 +829,43 @@ QueryResultV8 Query::executeV8 (v8::Isolate* isolate, QueryRegistry* registry) {
 
   // Now start the execution:
   try {
+    QueryResultCache* resultCache = nullptr;
+    std::string resultCacheKey;
+
+    if (canUseResultCache()) {
+      resultCache = static_cast<QueryResultCache*>(_vocbase->_queryResultCache);
+      resultCacheKey = buildResultCacheKey();
+
+      auto entry = resultCache->lookup(resultCacheKey);
+
+      if (entry != nullptr) {
+        QueryResultV8 result(cachedResult(*entry));
+        result.result = v8::Handle<v8::Array>::Cast(TRI_ObjectJson(isolate, result.json));
+        TRI_FreeJson(result.zone, result.json);
+        result.json = nullptr;
+
+        return result;
+      }
+    }
+
     QueryResultV8 res = prepare(registry);
     if (res.code != TRI_ERROR_NO_ERROR) {
       return res;
     }
 
+    std::vector<QueryResultCacheRevision> revisions;
+
+    if (resultCache != nullptr &&
+        ! getResultCacheRevisions(revisions)) {
+      resultCache = nullptr;
+    }
+
     uint32_t j = 0;
     QueryResultV8 result(TRI_ERROR_NO_ERROR);
     result.result  = v8::Array::New(isolate);
     triagens::basics::Json stats;
+    // the result is additionally built as JSON only if it is to be cached
+    triagens::basics::Json jsonResult(triagens::basics::Json::Array, resultCache != nullptr ? 16 : 0);
 
     AqlItemBlock* value = nullptr;
 
@@ -747,6 +880,10 @@ QueryResultV8 Query::executeV8 (v8::Isolate* isolate, QueryRegistry* registry) {
 
           if (! val.isEmpty()) {
             result.result->Set(j++, val.toV8(isolate, _trx, doc)); 
+
+            if (resultCache != nullptr) {
+              jsonResult.add(val.toJson(_trx, doc));
+            }
           }
         }
         delete value;
@@ -758,6 +895,16 @@ QueryResultV8 Query::executeV8 (v8::Isolate* isolate, QueryRegistry* registry) {
       throw;
     }
 
+    if (resultCache != nullptr &&
+        _warnings.empty()) {
+      try {
+        resultCache->store(resultCacheKey, jsonResult.toString(), revisions);
+      }
+      catch (...) {
+        // failing to cache the result is not an error
+      }
+    }
+
     stats = _engine->_stats.toJson();
 
     _trx->commit();
@@ -1154,6 +1301,185 @@ bool Query::inspectSimplePlans () const {
   return true; // default;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the query may use the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+bool Query::canUsePlanCache () const {
+  if (_queryString == nullptr || 
+      _part != PART_MAIN ||
+      _vocbase->_queryPlanCache == nullptr) {
+    return false;
+  }
+
+  if (! static_cast<QueryPlanCache*>(_vocbase->_queryPlanCache)->enabled()) {
+    return false;
+  }
+
+  // cluster plans are distributed to the DB servers when the engine is
+  // instanciated, so caching them is not possible
+  return ! triagens::arango::ServerState::instance()->isRunningInCluster();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the plan cache key for the query
+////////////////////////////////////////////////////////////////////////////////
+
+std::string Query::buildPlanCacheKey () const {
+  std::string key(_queryString, _queryLength);
+  key.push_back('\0');
+
+  // all bind parameter values are part of the key: they are injected into
+  // the AST as constants before optimization, and the optimizer may use
+  // them for index selection and constant folding
+  TRI_json_t const* bindParameters = _bindParameters.json();
+
+  if (bindParameters != nullptr) {
+    key.append(triagens::basics::JsonHelper::toString(bindParameters));
+  }
+
+  // add the options that influence the plan
+  if (TRI_IsObjectJson(_options)) {
+    for (auto name : { "optimizer", "maxNumberOfPlans", "fullCount" }) {
+      key.push_back('\0');
+
+      TRI_json_t const* value = TRI_LookupObjectJson(_options, name);
+
+      if (value != nullptr) {
+        key.append(triagens::basics::JsonHelper::toString(value));
+      }
+    }
+  }
+
+  return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the query may use the result cache
+////////////////////////////////////////////////////////////////////////////////
+
+bool Query::canUseResultCache () const {
+  if (_queryString == nullptr || 
+      _part != PART_MAIN ||
+      _vocbase->_queryResultCache == nullptr) {
+    return false;
+  }
+
+  if (! static_cast<QueryResultCache*>(_vocbase->_queryResultCache)->enabled()) {
+    return false;
+  }
+
+  // the cache can be bypassed per query. results with fullCount or a
+  // profile depend on the actual execution, so they are never cached
+  if (! getBooleanOption("cache", true) ||
+      getBooleanOption("fullCount", false) ||
+      profiling()) {
+    return false;
+  }
+
+  // writes on the DB servers cannot be tracked by the coordinator
+  if (triagens::arango::ServerState::instance()->isRunningInCluster()) {
+    return false;
+  }
+
+  if (_contextOwnedByExterior) {
+    // a query inside a JavaScript transaction sees the transaction's own
+    // uncommitted changes, which must neither be served from nor go into
+    // the cache
+    ISOLATE;
+    TRI_GET_GLOBALS();
+    auto ctx = static_cast<triagens::arango::V8TransactionContext*>(v8g->_transactionContext);
+
+    if (ctx != nullptr && ctx->getParentTransaction() != nullptr) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the result cache key for the query
+////////////////////////////////////////////////////////////////////////////////
+
+std::string Query::buildResultCacheKey () const {
+  std::string key(_queryString, _queryLength);
+  key.push_back('\0');
+
+  TRI_json_t const* bindParameters = _bindParameters.json();
+
+  if (bindParameters != nullptr) {
+    key.append(triagens::basics::JsonHelper::toString(bindParameters));
+  }
+
+  return key;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the result of the prepared query can be cached and
+/// record the revisions of the collections it reads
+////////////////////////////////////////////////////////////////////////////////
+
+bool Query::getResultCacheRevisions (std::vector<QueryResultCacheRevision>& revisions) const {
+  TRI_ASSERT(_plan != nullptr);
+  TRI_ASSERT(_trx != nullptr);
+
+  if (_trx->isEmbeddedTransaction()) {
+    return false;
+  }
+
+  for (auto const& it : *(_collections.collections())) {
+    if (it.second->accessType != TRI_TRANSACTION_READ) {
+      // data-modification query
+      return false;
+    }
+  }
+
+  // all expressions must be deterministic, including those in subqueries
+  for (auto node : _plan->findNodesOfType({ ExecutionNode::CALCULATION, ExecutionNode::ENUMERATE_COLLECTION }, true)) {
+    if (node->getType() == ExecutionNode::CALCULATION) {
+      if (! static_cast<CalculationNode const*>(node)->expression()->isDeterministic()) {
+        return false;
+      }
+    }
+    else if (static_cast<EnumerateCollectionNode const*>(node)->isRandom()) {
+      // SORT RAND() was optimized into a random iteration
+      return false;
+    }
+  }
+
+  revisions.reserve(_collections.collections()->size());
+
+  for (auto const& it : *(_collections.collections())) {
+    auto document = it.second->documentCollection();
+    revisions.emplace_back(QueryResultCacheRevision{ it.first, it.second->cid(), document, document->_info._revision });
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief produce the query result from a result cache entry
+////////////////////////////////////////////////////////////////////////////////
+
+QueryResult Query::cachedResult (QueryResultCacheEntry const& entry) {
+  QueryResult result(TRI_ERROR_NO_ERROR);
+  result.json = TRI_JsonString(TRI_UNKNOWN_MEM_ZONE, entry.result.c_str());
+
+  if (result.json == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  // nothing was scanned, and results with warnings are never cached
+  result.warnings = warningsToJson(TRI_UNKNOWN_MEM_ZONE);
+  result.stats    = ExecutionStats().toJson().steal();
+  result.cached   = true;
+
+  enterState(FINALIZATION); 
+
+  return result;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief read the "optimizer.rules" section from the options
 ////////////////////////////////////////////////////////////////////////////////
@@ -60,6 +60,8 @@ namespace triagens {
     class Parser;
     class Query;
     class QueryRegistry;
+    struct QueryResultCacheEntry;
+    struct QueryResultCacheRevision;
     struct Variable;
 
 // -----------------------------------------------------------------------------
@@ -284,6 +286,14 @@ namespace triagens {
           return getBooleanOption("profile", false);
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief may expressions be evaluated natively (without V8)?
+////////////////////////////////////////////////////////////////////////////////
+
+        bool nativeExpressions () const {  
+          return getBooleanOption("nativeExpressions", true);
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief maximum number of plans to produce
 ////////////////////////////////////////////////////////////////////////////////
@@ -341,6 +351,14 @@ namespace triagens {
 
         QueryResult execute (QueryRegistry*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finalize a prepared AQL query after all results have been fetched
+/// from its engine. this commits the transaction, frees the engine and 
+/// returns the statistics, warnings and profile of the query (but no result)
+////////////////////////////////////////////////////////////////////////////////
+
+        QueryResult finalize ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief execute an AQL query 
 /// may only be called with an active V8 handle scope
@@ -490,6 +508,46 @@ namespace triagens {
 
         std::vector<std::string> getRulesFromOptions () const;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the query may use the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        bool canUsePlanCache () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the plan cache key for the query. bind parameter values are
+/// part of the key because they are injected into the plan as constants
+////////////////////////////////////////////////////////////////////////////////
+
+        std::string buildPlanCacheKey () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the query may use the result cache
+////////////////////////////////////////////////////////////////////////////////
+
+        bool canUseResultCache () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the result cache key for the query
+////////////////////////////////////////////////////////////////////////////////
+
+        std::string buildResultCacheKey () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the result of the prepared query can be cached and
+/// record the revisions of the collections it reads. only deterministic
+/// read-only queries are cacheable. must be called before the first
+/// result is fetched
+////////////////////////////////////////////////////////////////////////////////
+
+        bool getResultCacheRevisions (std::vector<QueryResultCacheRevision>&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief produce the query result from a result cache entry
+////////////////////////////////////////////////////////////////////////////////
+
+        QueryResult cachedResult (QueryResultCacheEntry const&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief neatly format transaction errors to the user.
 ////////////////////////////////////////////////////////////////////////////////
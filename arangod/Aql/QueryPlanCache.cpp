@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, cache for optimized query plans
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/QueryPlanCache.h"
+#include "Basics/MutexLocker.h"
+
+using namespace triagens::aql;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       struct QueryPlanCacheEntry
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a cache entry, taking ownership of the plan
+////////////////////////////////////////////////////////////////////////////////
+
+QueryPlanCacheEntry::QueryPlanCacheEntry (std::string const& key,
+                                          TRI_json_t* plan) 
+  : key(key),
+    plan(plan),
+    collections() {
+
+  // remember the names of the collections used, for invalidation
+  TRI_json_t const* list = TRI_LookupObjectJson(plan, "collections");
+
+  if (TRI_IsArrayJson(list)) {
+    size_t const n = TRI_LengthArrayJson(list);
+    collections.reserve(n);
+
+    for (size_t i = 0; i < n; ++i) {
+      TRI_json_t const* name = TRI_LookupObjectJson(TRI_LookupArrayJson(list, i), "name");
+
+      if (TRI_IsStringJson(name)) {
+        collections.emplace_back(std::string(name->_value._string.data, name->_value._string.length - 1));
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a cache entry
+////////////////////////////////////////////////////////////////////////////////
+
+QueryPlanCacheEntry::~QueryPlanCacheEntry () {
+  TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, plan);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the plan uses the collection
+////////////////////////////////////////////////////////////////////////////////
+
+bool QueryPlanCacheEntry::usesCollection (char const* name) const {
+  for (auto const& it : collections) {
+    if (it == name) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                              class QueryPlanCache
+// -----------------------------------------------------------------------------
+
+size_t const QueryPlanCache::DefaultMaxEntries = 256;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+QueryPlanCache::QueryPlanCache () 
+  : _lock(),
+    _entries(),
+    _keys(),
+    _version(0),
+    _hits(0),
+    _misses(0),
+    _maxEntries(DefaultMaxEntries),
+    _enabled(false) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+QueryPlanCache::~QueryPlanCache () {
+  invalidate();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toggle the cache. disabling it also removes all cached plans
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::enabled (bool value) {
+  _enabled = value;
+
+  if (! value) {
+    invalidate();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum number of plans to keep
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::maxEntries (size_t value) {
+  if (value > 16384) {
+    // sanity checks
+    value = 16384;
+  }
+
+  MUTEX_LOCKER(_lock);
+  _maxEntries = value;
+  evict(value);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of plans currently cached
+////////////////////////////////////////////////////////////////////////////////
+
+size_t QueryPlanCache::size () {
+  MUTEX_LOCKER(_lock);
+  return _keys.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a plan
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<QueryPlanCacheEntry const> QueryPlanCache::lookup (std::string const& key) {
+  {
+    MUTEX_LOCKER(_lock);
+
+    auto it = _keys.find(key);
+
+    if (it != _keys.end()) {
+      // move the entry to the front of the LRU list
+      _entries.splice(_entries.begin(), _entries, (*it).second);
+      _hits.fetch_add(1, std::memory_order_relaxed);
+
+      return *((*it).second);
+    }
+  }
+
+  _misses.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store a plan
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::store (std::string const& key,
+                            TRI_json_t* plan,
+                            uint64_t version) {
+  std::shared_ptr<QueryPlanCacheEntry const> entry;
+
+  try {
+    entry.reset(new QueryPlanCacheEntry(key, plan));
+  }
+  catch (...) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, plan);
+    throw;
+  }
+
+  MUTEX_LOCKER(_lock);
+
+  if (_version.load(std::memory_order_relaxed) != version ||
+      ! _enabled ||
+      _maxEntries == 0) {
+    // cache was invalidated or turned off while the plan was built
+    return;
+  }
+
+  auto it = _keys.find(key);
+
+  if (it != _keys.end()) {
+    // another thread was faster, replace its plan
+    _entries.erase((*it).second);
+    _keys.erase(it);
+  }
+
+  evict(_maxEntries - 1);
+
+  _entries.emplace_front(entry);
+
+  try {
+    _keys.emplace(key, _entries.begin());
+  }
+  catch (...) {
+    _entries.pop_front();
+    throw;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans that use the specified collection
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::invalidate (char const* collection) {
+  MUTEX_LOCKER(_lock);
+
+  _version.fetch_add(1, std::memory_order_release);
+
+  for (auto it = _entries.begin(); it != _entries.end(); /* no hoisting */) {
+    if ((*it)->usesCollection(collection)) {
+      _keys.erase((*it)->key);
+      it = _entries.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::invalidate () {
+  MUTEX_LOCKER(_lock);
+
+  _version.fetch_add(1, std::memory_order_release);
+
+  _keys.clear();
+  _entries.clear();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evict the least recently used plans
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryPlanCache::evict (size_t maxEntries) {
+  while (_entries.size() > maxEntries) {
+    _keys.erase(_entries.back()->key);
+    _entries.pop_back();
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
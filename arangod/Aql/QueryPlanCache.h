@@ -0,0 +1,283 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, cache for optimized query plans
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_QUERY_PLAN_CACHE_H
+#define ARANGODB_AQL_QUERY_PLAN_CACHE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/json.h"
+#include "Basics/Mutex.h"
+
+namespace triagens {
+  namespace aql {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                       struct QueryPlanCacheEntry
+// -----------------------------------------------------------------------------
+
+    struct QueryPlanCacheEntry {
+      QueryPlanCacheEntry (QueryPlanCacheEntry const&) = delete;
+      QueryPlanCacheEntry& operator= (QueryPlanCacheEntry const&) = delete;
+
+      QueryPlanCacheEntry (std::string const&,
+                           TRI_json_t*);
+
+      ~QueryPlanCacheEntry ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the plan uses the collection
+////////////////////////////////////////////////////////////////////////////////
+
+      bool usesCollection (char const*) const;
+
+      std::string const        key;
+      TRI_json_t*              plan;
+      std::vector<std::string> collections;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                              class QueryPlanCache
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief bounded per-database cache of optimized execution plans. plans are
+/// stored in their verbose JSON representation (including the register
+/// planning), which is the same format the coordinator ships to the DB
+/// servers, so a cached plan can be instanciated without parsing and
+/// optimizing the query again. the least recently used plan is evicted
+/// when the cache is full
+////////////////////////////////////////////////////////////////////////////////
+
+    class QueryPlanCache {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        QueryPlanCache (QueryPlanCache const&) = delete;
+        QueryPlanCache& operator= (QueryPlanCache const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        QueryPlanCache ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        ~QueryPlanCache ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the cache is used
+/// we're not using a lock here for performance reasons - thus concurrent 
+/// modifications of this variable are possible but are considered unharmful
+////////////////////////////////////////////////////////////////////////////////
+
+        inline bool enabled () const {
+          return _enabled;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toggle the cache. disabling it also removes all cached plans
+////////////////////////////////////////////////////////////////////////////////
+
+        void enabled (bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of plans to keep
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t maxEntries () const {
+          return _maxEntries;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum number of plans to keep, evicting plans if the
+/// cache currently holds more
+////////////////////////////////////////////////////////////////////////////////
+
+        void maxEntries (size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache hits
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t hits () const {
+          return _hits.load(std::memory_order_relaxed);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache misses
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t misses () const {
+          return _misses.load(std::memory_order_relaxed);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current invalidation version. a plan can only be stored with the
+/// version that was current before it was created, so plans built while a
+/// concurrent DDL operation invalidated the cache are never stored
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t version () const {
+          return _version.load(std::memory_order_acquire);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of plans currently cached
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t size ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a plan. the entry stays valid as long as the caller holds
+/// the returned pointer, even if it is evicted concurrently
+////////////////////////////////////////////////////////////////////////////////
+
+        std::shared_ptr<QueryPlanCacheEntry const> lookup (std::string const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store a plan. the cache takes ownership of the plan JSON. the
+/// plan is discarded if the cache was invalidated after the given version
+////////////////////////////////////////////////////////////////////////////////
+
+        void store (std::string const&,
+                    TRI_json_t*,
+                    uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans that use the specified collection
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate (char const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all plans
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evict the least recently used plans until the cache has at most
+/// the specified number of entries. the caller must hold the lock
+////////////////////////////////////////////////////////////////////////////////
+
+        void evict (size_t);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief mutex protecting the entries
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Mutex _lock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cached plans, most recently used first
+////////////////////////////////////////////////////////////////////////////////
+
+        std::list<std::shared_ptr<QueryPlanCacheEntry const>> _entries;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cached plans by key
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<std::string, std::list<std::shared_ptr<QueryPlanCacheEntry const>>::iterator> _keys;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief invalidation version
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _version;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache hits
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _hits;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache misses
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _misses;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of plans to keep
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _maxEntries;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the cache is used
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _enabled;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default maximum number of plans to keep
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const DefaultMaxEntries;
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -261,8 +261,10 @@ void QueryRegistry::destroy (std::string const& vocbase,
     }
   }
 
-  if (errorCode == TRI_ERROR_NO_ERROR) {
-    // commit the operation
+  if (errorCode == TRI_ERROR_NO_ERROR &&
+      qi->_query->trx() != nullptr) {
+    // commit the operation. the transaction may have been committed and
+    // released by Query::finalize() already
     qi->_query->trx()->commit();
   }
 
@@ -54,6 +54,7 @@ namespace triagens {
         clusterplan       = other.clusterplan;
         bindParameters    = other.bindParameters;
         collectionNames   = other.collectionNames;
+        cached            = other.cached;
 
         other.warnings    = nullptr;
         other.json        = nullptr;
@@ -71,7 +72,8 @@ namespace triagens {
           json(nullptr),
           stats(nullptr),
           profile(nullptr),
-          clusterplan(nullptr) {
+          clusterplan(nullptr),
+          cached(false) {
       }
       
       explicit QueryResult (int code)
@@ -107,6 +109,7 @@ namespace triagens {
       TRI_json_t*                     stats;
       TRI_json_t*                     profile;
       TRI_json_t*                     clusterplan;
+      bool                            cached;
     };
 
   }
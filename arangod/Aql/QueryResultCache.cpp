@@ -0,0 +1,377 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, cache for query results
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+
+#include "Aql/QueryResultCache.h"
+#include "Basics/MutexLocker.h"
+#include "VocBase/document-collection.h"
+
+using namespace triagens::aql;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                   struct QueryResultCacheEntry
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a cache entry
+////////////////////////////////////////////////////////////////////////////////
+
+QueryResultCacheEntry::QueryResultCacheEntry (std::string const& key,
+                                              std::string&& result,
+                                              std::vector<std::string>&& collectionNames,
+                                              std::vector<TRI_voc_cid_t>&& collectionIds) 
+  : key(key),
+    result(std::move(result)),
+    collectionNames(std::move(collectionNames)),
+    collectionIds(std::move(collectionIds)) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the result was produced from the collection
+////////////////////////////////////////////////////////////////////////////////
+
+bool QueryResultCacheEntry::usesCollection (char const* name) const {
+  for (auto const& it : collectionNames) {
+    if (it == name) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the result was produced from the collection
+////////////////////////////////////////////////////////////////////////////////
+
+bool QueryResultCacheEntry::usesCollection (TRI_voc_cid_t cid) const {
+  for (auto const& it : collectionIds) {
+    if (it == cid) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                            class QueryResultCache
+// -----------------------------------------------------------------------------
+
+size_t const QueryResultCache::DefaultMaxEntries    = 128;
+size_t const QueryResultCache::DefaultMaxResultSize = 1024 * 1024;
+size_t const QueryResultCache::DefaultMaxMemory     = 64 * 1024 * 1024;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a result cache
+////////////////////////////////////////////////////////////////////////////////
+
+QueryResultCache::QueryResultCache () 
+  : _lock(),
+    _entries(),
+    _keys(),
+    _active(0),
+    _hits(0),
+    _misses(0),
+    _memoryUsage(0),
+    _maxEntries(DefaultMaxEntries),
+    _maxResultSize(DefaultMaxResultSize),
+    _maxMemory(DefaultMaxMemory),
+    _enabled(false) {
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a result cache
+////////////////////////////////////////////////////////////////////////////////
+
+QueryResultCache::~QueryResultCache () {
+  invalidate();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toggle the cache. disabling it also removes all cached results
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryResultCache::enabled (bool value) {
+  _enabled = value;
+
+  if (! value) {
+    invalidate();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum number of results to keep
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryResultCache::maxEntries (size_t value) {
+  if (value > 16384) {
+    // sanity checks
+    value = 16384;
+  }
+
+  MUTEX_LOCKER(_lock);
+  _maxEntries = value;
+  evict(_maxEntries, _maxMemory);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum size of a single serialized result
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryResultCache::maxResultSize (size_t value) {
+  MUTEX_LOCKER(_lock);
+  _maxResultSize = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum memory used by all cached results
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryResultCache::maxMemory (size_t value) {
+  MUTEX_LOCKER(_lock);
+  _maxMemory = value;
+  evict(_maxEntries, _maxMemory);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of results currently cached
+////////////////////////////////////////////////////////////////////////////////
+
+size_t QueryResultCache::size () {
+  MUTEX_LOCKER(_lock);
+  return _keys.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief memory currently used by the cached results
+////////////////////////////////////////////////////////////////////////////////
+
+size_t QueryResultCache::memoryUsage () {
+  MUTEX_LOCKER(_lock);
+  return _memoryUsage;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a result
+////////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<QueryResultCacheEntry const> QueryResultCache::lookup (std::string const& key) {
+  {
+    MUTEX_LOCKER(_lock);
+
+    auto it = _keys.find(key);
+
+    if (it != _keys.end()) {
+      // move the entry to the front of the LRU list
+      _entries.splice(_entries.begin(), _entries, (*it).second);
+      _hits.fetch_add(1, std::memory_order_relaxed);
+
+      return *((*it).second);
+    }
+  }
+
+  _misses.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store a serialized result
+////////////////////////////////////////////////////////////////////////////////
+
+bool QueryResultCache::store (std::string const& key,
+                              std::string&& result,
+                              std::vector<QueryResultCacheRevision> const& revisions) {
+  if (key.size() + result.size() > _maxResultSize) {
+    return false;
+  }
+
+  std::vector<std::string> names;
+  std::vector<TRI_voc_cid_t> ids;
+  names.reserve(revisions.size());
+  ids.reserve(revisions.size());
+
+  for (auto const& it : revisions) {
+    names.emplace_back(it.name);
+    ids.emplace_back(it.cid);
+  }
+
+  std::shared_ptr<QueryResultCacheEntry const> entry(new QueryResultCacheEntry(key, std::move(result), std::move(names), std::move(ids)));
+  size_t const memory = entry->memoryUsage();
+
+  MUTEX_LOCKER(_lock);
+
+  if (! _enabled ||
+      _maxEntries == 0 ||
+      memory > _maxResultSize ||
+      memory > _maxMemory) {
+    return false;
+  }
+
+  // announce the store before checking the revisions. a writer bumps the
+  // revision before it checks _active, so either we see its new revision
+  // here or it sees a non-zero _active and waits for our lock to remove the
+  // entry again
+  _active.fetch_add(1, std::memory_order_seq_cst);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  for (auto const& it : revisions) {
+    if (it.document->_info._revision != it.revision) {
+      // collection was modified while the query was running
+      _active.fetch_sub(1, std::memory_order_relaxed);
+      return false;
+    }
+  }
+
+  auto it = _keys.find(key);
+
+  if (it != _keys.end()) {
+    // another thread was faster, replace its result
+    remove((*it).second);
+  }
+
+  evict(_maxEntries - 1, _maxMemory - memory);
+
+  _entries.emplace_front(entry);
+
+  try {
+    _keys.emplace(key, _entries.begin());
+  }
+  catch (...) {
+    _entries.pop_front();
+    _active.fetch_sub(1, std::memory_order_relaxed);
+    throw;
+  }
+
+  // the pending store has become an entry, so _active stays incremented
+  _memoryUsage += memory;
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all results produced from the specified collection
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryResultCache::invalidate (TRI_voc_cid_t cid) {
+  // the caller has already bumped the collection's revision. see store()
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  if (_active.load(std::memory_order_seq_cst) == 0) {
+    // nothing cached and no store in progress
+    return;
+  }
+
+  MUTEX_LOCKER(_lock);
+
+  for (auto it = _entries.begin(); it != _entries.end(); /* no hoisting */) {
+    if ((*it)->usesCollection(cid)) {
+      it = remove(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all results produced from the specified collection
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryResultCache::invalidate (char const* collection) {
+  MUTEX_LOCKER(_lock);
+
+  for (auto it = _entries.begin(); it != _entries.end(); /* no hoisting */) {
+    if ((*it)->usesCollection(collection)) {
+      it = remove(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all results
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryResultCache::invalidate () {
+  MUTEX_LOCKER(_lock);
+
+  _active.fetch_sub(_entries.size(), std::memory_order_relaxed);
+  _memoryUsage = 0;
+
+  _keys.clear();
+  _entries.clear();
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove an entry
+////////////////////////////////////////////////////////////////////////////////
+
+std::list<std::shared_ptr<QueryResultCacheEntry const>>::iterator QueryResultCache::remove (std::list<std::shared_ptr<QueryResultCacheEntry const>>::iterator it) {
+  TRI_ASSERT(_memoryUsage >= (*it)->memoryUsage());
+
+  _memoryUsage -= (*it)->memoryUsage();
+  _active.fetch_sub(1, std::memory_order_relaxed);
+  _keys.erase((*it)->key);
+
+  return _entries.erase(it);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evict the least recently used results
+////////////////////////////////////////////////////////////////////////////////
+
+void QueryResultCache::evict (size_t maxEntries,
+                              size_t maxMemory) {
+  while (! _entries.empty() &&
+         (_entries.size() > maxEntries || _memoryUsage > maxMemory)) {
+    remove(--_entries.end());
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
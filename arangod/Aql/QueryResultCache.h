@@ -0,0 +1,389 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, cache for query results
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+
+#ifndef ARANGODB_AQL_QUERY_RESULT_CACHE_H
+#define ARANGODB_AQL_QUERY_RESULT_CACHE_H 1
+
+#include "Basics/Common.h"
+#include "Basics/Mutex.h"
+#include "VocBase/voc-types.h"
+
+struct TRI_document_collection_t;
+
+namespace triagens {
+  namespace aql {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                   struct QueryResultCacheEntry
+// -----------------------------------------------------------------------------
+
+    struct QueryResultCacheEntry {
+      QueryResultCacheEntry (QueryResultCacheEntry const&) = delete;
+      QueryResultCacheEntry& operator= (QueryResultCacheEntry const&) = delete;
+
+      QueryResultCacheEntry (std::string const&,
+                             std::string&&,
+                             std::vector<std::string>&&,
+                             std::vector<TRI_voc_cid_t>&&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the result was produced from the collection
+////////////////////////////////////////////////////////////////////////////////
+
+      bool usesCollection (char const*) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the result was produced from the collection
+////////////////////////////////////////////////////////////////////////////////
+
+      bool usesCollection (TRI_voc_cid_t) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief memory accounted for the entry
+////////////////////////////////////////////////////////////////////////////////
+
+      inline size_t memoryUsage () const {
+        return key.size() + result.size();
+      }
+
+      std::string const                key;
+      std::string const                result;
+      std::vector<std::string> const   collectionNames;
+      std::vector<TRI_voc_cid_t> const collectionIds;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                 struct QueryResultCacheRevision
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief revision of a collection as seen by a query when it started. the
+/// document collection must stay in use until the result is stored
+////////////////////////////////////////////////////////////////////////////////
+
+    struct QueryResultCacheRevision {
+      std::string                      name;
+      TRI_voc_cid_t                    cid;
+      TRI_document_collection_t const* document;
+      TRI_voc_rid_t                    revision;
+    };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                            class QueryResultCache
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief optional per-database cache of serialized query results. only
+/// results of deterministic read-only queries are stored. a result is
+/// removed as soon as one of the collections it was produced from is
+/// written to, from the same place that bumps the collection's revision.
+/// the least recently used results are evicted when the number of entries
+/// or the memory used exceeds the configured limits
+////////////////////////////////////////////////////////////////////////////////
+
+    class QueryResultCache {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        QueryResultCache (QueryResultCache const&) = delete;
+        QueryResultCache& operator= (QueryResultCache const&) = delete;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a result cache
+////////////////////////////////////////////////////////////////////////////////
+
+        QueryResultCache ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy a result cache
+////////////////////////////////////////////////////////////////////////////////
+
+        ~QueryResultCache ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the cache is used
+/// we're not using a lock here for performance reasons - thus concurrent 
+/// modifications of this variable are possible but are considered unharmful
+////////////////////////////////////////////////////////////////////////////////
+
+        inline bool enabled () const {
+          return _enabled;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief toggle the cache. disabling it also removes all cached results
+////////////////////////////////////////////////////////////////////////////////
+
+        void enabled (bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of results to keep
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t maxEntries () const {
+          return _maxEntries;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum number of results to keep, evicting results if
+/// the cache currently holds more
+////////////////////////////////////////////////////////////////////////////////
+
+        void maxEntries (size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum size of a single serialized result
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t maxResultSize () const {
+          return _maxResultSize;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum size of a single serialized result. results that
+/// are already cached are kept
+////////////////////////////////////////////////////////////////////////////////
+
+        void maxResultSize (size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum memory used by all cached results
+////////////////////////////////////////////////////////////////////////////////
+
+        inline size_t maxMemory () const {
+          return _maxMemory;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the maximum memory used by all cached results, evicting
+/// results if the cache currently uses more
+////////////////////////////////////////////////////////////////////////////////
+
+        void maxMemory (size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache hits
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t hits () const {
+          return _hits.load(std::memory_order_relaxed);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache misses
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t misses () const {
+          return _misses.load(std::memory_order_relaxed);
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of results currently cached
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t size ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief memory currently used by the cached results
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t memoryUsage ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a result. the entry stays valid as long as the caller
+/// holds the returned pointer, even if it is invalidated concurrently
+////////////////////////////////////////////////////////////////////////////////
+
+        std::shared_ptr<QueryResultCacheEntry const> lookup (std::string const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief store a serialized result. the result is discarded if any of the
+/// collections was modified since the query recorded its revisions, or if
+/// it exceeds the size limits. returns whether the result was stored
+////////////////////////////////////////////////////////////////////////////////
+
+        bool store (std::string const&,
+                    std::string&&,
+                    std::vector<QueryResultCacheRevision> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all results produced from the specified collection. this
+/// is called for every write operation and returns quickly if the cache is
+/// empty
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate (TRI_voc_cid_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all results produced from the specified collection
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate (char const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove all results
+////////////////////////////////////////////////////////////////////////////////
+
+        void invalidate ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove an entry. the caller must hold the lock
+////////////////////////////////////////////////////////////////////////////////
+
+        std::list<std::shared_ptr<QueryResultCacheEntry const>>::iterator remove (std::list<std::shared_ptr<QueryResultCacheEntry const>>::iterator);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief evict the least recently used results until the cache has at most
+/// the specified number of entries and memory usage. the caller must hold
+/// the lock
+////////////////////////////////////////////////////////////////////////////////
+
+        void evict (size_t,
+                    size_t);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief mutex protecting the entries
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Mutex _lock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cached results, most recently used first
+////////////////////////////////////////////////////////////////////////////////
+
+        std::list<std::shared_ptr<QueryResultCacheEntry const>> _entries;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cached results by key
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<std::string, std::list<std::shared_ptr<QueryResultCacheEntry const>>::iterator> _keys;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of entries plus number of stores in progress. writers
+/// only need to acquire the lock if this is non-zero
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _active;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache hits
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _hits;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of cache misses
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<uint64_t> _misses;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief memory used by the cached results
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _memoryUsage;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of results to keep
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _maxEntries;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum size of a single serialized result
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _maxResultSize;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum memory used by all cached results
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _maxMemory;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the cache is used
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _enabled;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default maximum number of results to keep
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const DefaultMaxEntries;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default maximum size of a single serialized result
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const DefaultMaxResultSize;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief default maximum memory used by all cached results
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const DefaultMaxMemory;
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -724,6 +724,34 @@ void RestAqlHandler::handleUseQuery (std::string const& operation,
       }
       items.reset(block->getSomeForShard(atLeast, atMost, shardId));
     }
+
+    char const* accept = _request->header("accept", found);
+    if (found && accept != nullptr &&
+        strstr(accept, AqlItemBlock::BinaryContentType) != nullptr) {
+      // the caller understands the binary format: a flag byte telling
+      // whether we are exhausted, the stats and then the block itself.
+      // the body is built before the response is created, so a failure
+      // does not leave a half-filled response behind
+      try {
+        StringBuffer body(TRI_UNKNOWN_MEM_ZONE);
+        body.appendChar(items.get() == nullptr ? 1 : 0);
+        JsonHelper::toBinary(query->getStats().json(), body);
+        if (items.get() != nullptr) {
+          items->toBinary(query->trx(), body);
+        }
+
+        _response = createResponse(triagens::rest::HttpResponse::OK);
+        _response->setContentType(AqlItemBlock::BinaryContentType);
+        _response->body().swap(&body);
+      }
+      catch (...) {
+        LOG_ERROR("cannot transform AqlItemBlock to binary");
+        generateError(HttpResponse::SERVER_ERROR, TRI_ERROR_HTTP_SERVER_ERROR,
+                      "cannot transform AqlItemBlock to binary");
+      }
+      return;
+    }
+
     if (items.get() == nullptr) {
       answerBody("exhausted", Json(true))
         ("error", Json(false))
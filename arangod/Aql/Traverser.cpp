@@ -0,0 +1,775 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, graph traversal engine
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#include "Aql/Traverser.h"
+#include "Aql/AqlValue.h"
+#include "Aql/Query.h"
+#include "Basics/Exceptions.h"
+#include "ShapedJson/json-shaper.h"
+#include "VocBase/voc-shaper.h"
+
+using namespace triagens::aql;
+using Json = triagens::basics::Json;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shortest path node
+////////////////////////////////////////////////////////////////////////////////
+
+struct Traverser::PathNode {
+  Traverser::VertexInfo* vertex;
+  PathNode*              parent;
+  TRI_df_marker_t const* parentEdge;
+  double                 dist;
+  size_t                 depth;
+  bool                   visited;
+  bool                   hide;
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief binary min-heap of path nodes, ordered by their current distance.
+/// the sift operations are the same as in the JavaScript BinaryHeap, so ties
+/// between paths of equal length are resolved identically
+////////////////////////////////////////////////////////////////////////////////
+
+template<typename T>
+class PathNodeHeap {
+
+  public:
+
+    void push (T* node) {
+      _values.emplace_back(node);
+      sinkDown(_values.size() - 1);
+    }
+
+    T* pop () {
+      T* result = _values[0];
+      T* end = _values.back();
+      _values.pop_back();
+
+      if (! _values.empty()) {
+        _values[0] = end;
+        bubbleUp(0);
+      }
+      return result;
+    }
+
+    bool empty () const {
+      return _values.empty();
+    }
+
+  private:
+
+    void sinkDown (size_t n) {
+      T* element = _values[n];
+
+      while (n > 0) {
+        size_t parentN = (n + 1) / 2 - 1;
+        T* parent = _values[parentN];
+
+        if (element->dist < parent->dist) {
+          _values[parentN] = element;
+          _values[n] = parent;
+          n = parentN;
+        }
+        else {
+          break;
+        }
+      }
+    }
+
+    void bubbleUp (size_t n) {
+      size_t const length = _values.size();
+      T* element = _values[n];
+      double const elemScore = element->dist;
+
+      while (true) {
+        size_t const child2n = (n + 1) * 2;
+        size_t const child1n = child2n - 1;
+        size_t swap = SIZE_MAX;
+        double child1Score = 0.0;
+
+        if (child1n < length) {
+          child1Score = _values[child1n]->dist;
+
+          if (child1Score < elemScore) {
+            swap = child1n;
+          }
+        }
+
+        if (child2n < length) {
+          if (_values[child2n]->dist < (swap == SIZE_MAX ? elemScore : child1Score)) {
+            swap = child2n;
+          }
+        }
+
+        if (swap == SIZE_MAX) {
+          break;
+        }
+
+        _values[n] = _values[swap];
+        _values[swap] = element;
+        n = swap;
+      }
+    }
+
+    std::vector<T*> _values;
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create the traverser
+////////////////////////////////////////////////////////////////////////////////
+
+Traverser::Traverser (Query* query,
+                      triagens::arango::AqlTransaction* trx,
+                      TRI_document_collection_t* edgeCollection,
+                      Options const& options)
+  : _query(query),
+    _trx(trx),
+    _edgeCollection(edgeCollection),
+    _options(options),
+    _weightPid(0),
+    _vertices() {
+
+  TRI_ASSERT(_trx != nullptr);
+  TRI_ASSERT(_edgeCollection != nullptr);
+
+  if (! _options.weightAttribute.empty()) {
+    TRI_shaper_t* shaper = _edgeCollection->getShaper();
+    _weightPid = shaper->lookupAttributePathByName(shaper, _options.weightAttribute.c_str());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroy the traverser
+////////////////////////////////////////////////////////////////////////////////
+
+Traverser::~Traverser () {
+  for (auto& it : _vertices) {
+    if (it.second.json != nullptr) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, it.second.json);
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a vertex id string ("collection/key")
+////////////////////////////////////////////////////////////////////////////////
+
+int Traverser::parseVertexId (char const* value,
+                              VertexId& result) const {
+  char const* p = strchr(value, '/');
+
+  if (p == nullptr || p == value || *(p + 1) == '\0') {
+    return TRI_ERROR_ARANGO_DOCUMENT_HANDLE_BAD;
+  }
+
+  TRI_voc_cid_t cid = _trx->resolver()->getCollectionId(std::string(value, p - value));
+
+  if (cid == 0) {
+    return TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND;
+  }
+
+  result.cid = cid;
+  result.key = std::string(p + 1);
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up all edges connected to a vertex
+////////////////////////////////////////////////////////////////////////////////
+
+std::vector<TRI_doc_mptr_copy_t> Traverser::edges (VertexId const& vertex) const {
+  return TRI_LookupEdgesDocumentCollection(_edgeCollection,
+                                           _options.direction,
+                                           vertex.cid,
+                                           const_cast<TRI_voc_key_t>(vertex.key.c_str()));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert an edge into JSON
+////////////////////////////////////////////////////////////////////////////////
+
+Json Traverser::edgeJson (TRI_df_marker_t const* marker) const {
+  return AqlValue(marker).toJson(_trx, _edgeCollection);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the id of the vertex at the other end of an edge
+////////////////////////////////////////////////////////////////////////////////
+
+Traverser::VertexId Traverser::peerVertex (TRI_df_marker_t const* marker,
+                                           TRI_edge_direction_e direction,
+                                           VertexId const& vertex) {
+  if (direction == TRI_EDGE_OUT) {
+    return VertexId(TRI_EXTRACT_MARKER_TO_CID(marker), TRI_EXTRACT_MARKER_TO_KEY(marker));
+  }
+
+  VertexId from(TRI_EXTRACT_MARKER_FROM_CID(marker), TRI_EXTRACT_MARKER_FROM_KEY(marker));
+
+  if (direction == TRI_EDGE_ANY && from == vertex) {
+    return VertexId(TRI_EXTRACT_MARKER_TO_CID(marker), TRI_EXTRACT_MARKER_TO_KEY(marker));
+  }
+
+  return from;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a vertex exists
+////////////////////////////////////////////////////////////////////////////////
+
+bool Traverser::hasVertex (VertexId const& id) {
+  return lookupVertex(id)->exists;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the JSON of a vertex, or null if the vertex does not exist
+////////////////////////////////////////////////////////////////////////////////
+
+Json Traverser::vertexJson (VertexId const& id) {
+  VertexInfo* vertex = lookupVertex(id);
+
+  if (! vertex->exists) {
+    return Json(Json::Null);
+  }
+
+  return Json(TRI_UNKNOWN_MEM_ZONE, copyVertexJson(vertex));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run a depth-first or breadth-first traversal
+////////////////////////////////////////////////////////////////////////////////
+
+Json Traverser::traverse (VertexId const& start) {
+  Json result(Json::Array);
+
+  VertexInfo* startVertex = lookupVertex(start);
+
+  if (! startVertex->exists) {
+    return result;
+  }
+
+  // depth-first with forward item order and breadth-first with backward
+  // item order need to process the connections of a vertex in reverse
+  bool const reverse = (_options.strategy == STRATEGY_DEPTH_FIRST) != _options.backward;
+
+  std::unordered_set<VertexInfo const*> visitedVertices;
+  std::unordered_set<TRI_df_marker_t const*> visitedEdges;
+  std::vector<VertexInfo*> pathVertices;
+  std::vector<TRI_df_marker_t const*> pathEdges;
+  std::vector<Connection> connected;
+  uint64_t iterations = 0;
+
+  // checks the uniqueness of a vertex and the edge leading to it. the vertex
+  // and edge sequences passed are the ones leading to the item
+  auto isUnique = [&] (VertexInfo const* vertex,
+                       TRI_df_marker_t const* edge,
+                       std::vector<VertexInfo*> const& ancestors,
+                       std::vector<TRI_df_marker_t const*> const& ancestorEdges) -> bool {
+    if (_options.uniqueVertices == UNIQUE_PATH) {
+      if (std::find(ancestors.begin(), ancestors.end(), vertex) != ancestors.end()) {
+        return false;
+      }
+    }
+    else if (_options.uniqueVertices == UNIQUE_GLOBAL) {
+      if (! visitedVertices.emplace(vertex).second) {
+        return false;
+      }
+    }
+
+    if (edge != nullptr) {
+      if (_options.uniqueEdges == UNIQUE_PATH) {
+        if (std::find(ancestorEdges.begin(), ancestorEdges.end(), edge) != ancestorEdges.end()) {
+          return false;
+        }
+      }
+      else if (_options.uniqueEdges == UNIQUE_GLOBAL) {
+        if (! visitedEdges.emplace(edge).second) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  };
+
+  bool const haveUniqueness = (_options.uniqueVertices != UNIQUE_NONE ||
+                               _options.uniqueEdges != UNIQUE_NONE);
+
+  if (_options.strategy == STRATEGY_BREADTH_FIRST) {
+    struct Item {
+      TRI_df_marker_t const* edge;
+      VertexInfo*            vertex;
+      size_t                 parent;
+    };
+
+    std::vector<Item> toVisit;
+    toVisit.push_back({ nullptr, startVertex, SIZE_MAX });
+
+    for (size_t index = 0; index < toVisit.size(); ++index) {
+      checkIteration(iterations);
+
+      // build the path leading to the current item
+      pathVertices.clear();
+      pathEdges.clear();
+
+      for (size_t i = index; i != SIZE_MAX; i = toVisit[i].parent) {
+        pathVertices.emplace_back(toVisit[i].vertex);
+        if (toVisit[i].edge != nullptr) {
+          pathEdges.emplace_back(toVisit[i].edge);
+        }
+      }
+      std::reverse(pathVertices.begin(), pathVertices.end());
+      std::reverse(pathEdges.begin(), pathEdges.end());
+
+      VertexInfo* vertex = toVisit[index].vertex;
+      TRI_df_marker_t const* edge = toVisit[index].edge;
+
+      if (haveUniqueness) {
+        pathVertices.pop_back();
+        if (edge != nullptr) {
+          pathEdges.pop_back();
+        }
+
+        if (! isUnique(vertex, edge, pathVertices, pathEdges)) {
+          continue;
+        }
+
+        pathVertices.emplace_back(vertex);
+        if (edge != nullptr) {
+          pathEdges.emplace_back(edge);
+        }
+      }
+
+      bool visit, expand;
+      filter(pathEdges.size(), visit, expand);
+
+      if (visit) {
+        addResult(result, pathVertices, pathEdges);
+      }
+
+      if (expand) {
+        this->expand(vertex, connected);
+
+        if (reverse) {
+          std::reverse(connected.begin(), connected.end());
+        }
+
+        for (auto const& it : connected) {
+          toVisit.push_back({ it.edge, it.vertex, index });
+        }
+      }
+    }
+  }
+  else {
+    struct Item {
+      TRI_df_marker_t const* edge;
+      VertexInfo*            vertex;
+      bool                   seen;
+    };
+
+    std::vector<Item> toVisit;
+    toVisit.push_back({ nullptr, startVertex, false });
+
+    while (! toVisit.empty()) {
+      checkIteration(iterations);
+
+      Item& current = toVisit.back();
+
+      if (current.seen) {
+        // all children processed
+        toVisit.pop_back();
+        if (! pathEdges.empty()) {
+          pathEdges.pop_back();
+        }
+        pathVertices.pop_back();
+        continue;
+      }
+
+      current.seen = true;
+      VertexInfo* vertex = current.vertex;
+      TRI_df_marker_t const* edge = current.edge;
+
+      if (haveUniqueness && ! isUnique(vertex, edge, pathVertices, pathEdges)) {
+        toVisit.pop_back();
+        continue;
+      }
+
+      if (edge != nullptr) {
+        pathEdges.emplace_back(edge);
+      }
+      pathVertices.emplace_back(vertex);
+
+      bool visit, expand;
+      filter(pathEdges.size(), visit, expand);
+
+      if (visit) {
+        addResult(result, pathVertices, pathEdges);
+      }
+
+      if (expand) {
+        this->expand(vertex, connected);
+
+        if (reverse) {
+          std::reverse(connected.begin(), connected.end());
+        }
+
+        // note: this may invalidate the reference to current
+        for (auto const& it : connected) {
+          toVisit.push_back({ it.edge, it.vertex, false });
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the shortest path between two vertices (dijkstra)
+////////////////////////////////////////////////////////////////////////////////
+
+Json Traverser::shortestPath (VertexId const& start,
+                              VertexId const& end) {
+  Json result(Json::Array);
+
+  VertexInfo* startVertex = lookupVertex(start);
+
+  if (! startVertex->exists) {
+    return result;
+  }
+
+  VertexInfo* endVertex = lookupVertex(end);
+
+  if (! endVertex->exists) {
+    THROW_ARANGO_EXCEPTION_MESSAGE(TRI_ERROR_BAD_PARAMETER,
+                                   std::string(TRI_errno_string(TRI_ERROR_BAD_PARAMETER)) + ": invalid endVertex specified for traversal");
+  }
+
+  std::unordered_map<VertexInfo*, PathNode> nodes;
+
+  auto makeNode = [&nodes] (VertexInfo* vertex) -> PathNode* {
+    auto it = nodes.find(vertex);
+
+    if (it == nodes.end()) {
+      PathNode node = { vertex, nullptr, nullptr, HUGE_VAL, 0, false, false };
+      it = nodes.emplace(vertex, node).first;
+    }
+
+    return &((*it).second);
+  };
+
+  PathNodeHeap<PathNode> heap;
+  std::vector<Connection> connected;
+  uint64_t iterations = 0;
+
+  PathNode* startNode = makeNode(startVertex);
+  startNode->dist = 0.0;
+  heap.push(startNode);
+
+  while (! heap.empty()) {
+    checkIteration(iterations);
+
+    PathNode* current = heap.pop();
+
+    if (current->vertex == endVertex) {
+      // collect the nodes on the path, from start to end
+      std::vector<PathNode*> chain;
+      for (PathNode* n = current; n != nullptr; n = n->parent) {
+        chain.emplace_back(n);
+      }
+      std::reverse(chain.begin(), chain.end());
+
+      std::vector<VertexInfo*> pathVertices;
+      std::vector<TRI_df_marker_t const*> pathEdges;
+
+      for (auto n : chain) {
+        pathVertices.emplace_back(n->vertex);
+        if (n->parentEdge != nullptr) {
+          pathEdges.emplace_back(n->parentEdge);
+        }
+
+        if (! n->hide) {
+          addResult(result, pathVertices, pathEdges);
+        }
+      }
+
+      return result;
+    }
+
+    if (current->visited) {
+      continue;
+    }
+
+    if (current->dist == HUGE_VAL) {
+      break;
+    }
+
+    current->visited = true;
+
+    bool visit, expand;
+    filter(current->depth, visit, expand);
+
+    if (! visit) {
+      current->hide = true;
+    }
+
+    if (! expand) {
+      continue;
+    }
+
+    this->expand(current->vertex, connected);
+
+    for (auto const& it : connected) {
+      PathNode* neighbor = makeNode(it.vertex);
+
+      if (neighbor->visited) {
+        continue;
+      }
+
+      double const alt = current->dist + edgeWeight(it.edge);
+
+      if (alt < neighbor->dist) {
+        neighbor->dist = alt;
+        neighbor->parent = current;
+        neighbor->parentEdge = it.edge;
+        neighbor->depth = current->depth + 1;
+        heap.push(neighbor);
+      }
+    }
+  }
+
+  return result;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a vertex, using the cache
+////////////////////////////////////////////////////////////////////////////////
+
+Traverser::VertexInfo* Traverser::lookupVertex (VertexId const& id) {
+  auto it = _vertices.find(id);
+
+  if (it != _vertices.end()) {
+    return &((*it).second);
+  }
+
+  VertexInfo info;
+  info.id       = nullptr;
+  info.document = nullptr;
+  info.json     = nullptr;
+  info.exists   = false;
+
+  it = _vertices.emplace(id, info).first;
+  VertexInfo* vertex = &((*it).second);
+  vertex->id = &((*it).first);
+
+  // vertex collections the query did not declare are added to its
+  // transaction, as the JavaScript implementation does
+  TRI_transaction_collection_t* trxCollection = _trx->trxCollectionAtRuntime(id.cid);
+
+  if (trxCollection == nullptr ||
+      trxCollection->_collection == nullptr ||
+      trxCollection->_collection->_collection == nullptr) {
+    return vertex;
+  }
+
+  int res = _trx->readSingle(trxCollection, &vertex->mptr, id.key);
+
+  if (res == TRI_ERROR_OUT_OF_MEMORY) {
+    THROW_ARANGO_EXCEPTION(res);
+  }
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    vertex->document = trxCollection->_collection->_collection;
+    vertex->exists   = true;
+  }
+
+  return vertex;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief expand a vertex into its connected edges and (existing) vertices
+////////////////////////////////////////////////////////////////////////////////
+
+void Traverser::expand (VertexInfo const* vertex,
+                        std::vector<Connection>& result) {
+  result.clear();
+
+  std::vector<TRI_doc_mptr_copy_t> found(edges(*vertex->id));
+  result.reserve(found.size());
+
+  for (auto const& it : found) {
+    auto marker = static_cast<TRI_df_marker_t const*>(it.getDataPtr());
+    VertexInfo* peer = lookupVertex(peerVertex(marker, _options.direction, *vertex->id));
+
+    if (peer->exists) {
+      // edges pointing to non-existing vertices are skipped
+      result.push_back({ marker, peer });
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the weight of an edge
+////////////////////////////////////////////////////////////////////////////////
+
+double Traverser::edgeWeight (TRI_df_marker_t const* marker) const {
+  if (_options.weightAttribute.empty()) {
+    return 1.0;
+  }
+
+  if (_weightPid != 0) {
+    TRI_shaper_t* shaper = _edgeCollection->getShaper();
+    TRI_shaped_json_t document;
+    TRI_EXTRACT_SHAPED_JSON_MARKER(document, marker);
+
+    TRI_shaped_json_t json;
+    TRI_shape_t const* shape;
+
+    bool ok = TRI_ExtractShapedJsonVocShaper(shaper, &document, 0, _weightPid, &json, &shape);
+
+    if (ok && shape != nullptr && json._sid == BasicShapes::TRI_SHAPE_SID_NUMBER) {
+      return * (double*) json._data.data;
+    }
+  }
+
+  if (_options.defaultWeight != 0.0) {
+    return _options.defaultWeight;
+  }
+
+  return HUGE_VAL;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply the depth filters
+////////////////////////////////////////////////////////////////////////////////
+
+void Traverser::filter (size_t depth,
+                        bool& visit,
+                        bool& expand) const {
+  double const length = static_cast<double>(depth + 1);
+
+  visit  = ! (_options.minDepth > 0.0 && length <= _options.minDepth);
+  expand = ! (_options.maxDepth > 0.0 && length > _options.maxDepth);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check the iteration limit and whether the query was killed
+////////////////////////////////////////////////////////////////////////////////
+
+void Traverser::checkIteration (uint64_t& iterations) const {
+  if (iterations++ > _options.maxIterations) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_GRAPH_TOO_MANY_ITERATIONS);
+  }
+
+  if (_query != nullptr && _query->killed()) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_QUERY_KILLED);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append a result item for a vertex and its path
+////////////////////////////////////////////////////////////////////////////////
+
+void Traverser::addResult (Json& result,
+                           std::vector<VertexInfo*> const& pathVertices,
+                           std::vector<TRI_df_marker_t const*> const& pathEdges) {
+  TRI_ASSERT(! pathVertices.empty());
+
+  Json item(Json::Object, 2);
+  item.set("vertex", copyVertexJson(pathVertices.back()));
+
+  if (_options.trackPaths) {
+    Json edges(Json::Array, pathEdges.size());
+    for (auto it : pathEdges) {
+      edges.add(edgeJson(it));
+    }
+
+    Json vertices(Json::Array, pathVertices.size());
+    for (auto it : pathVertices) {
+      vertices.add(copyVertexJson(it));
+    }
+
+    Json path(Json::Object, 2);
+    path.set("edges", edges);
+    path.set("vertices", vertices);
+    item.set("path", path);
+  }
+
+  result.add(item);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return a copy of the vertex JSON
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* Traverser::copyVertexJson (VertexInfo* vertex) {
+  TRI_ASSERT(vertex->exists);
+
+  if (vertex->json == nullptr) {
+    auto marker = static_cast<TRI_df_marker_t const*>(vertex->mptr.getDataPtr());
+    vertex->json = AqlValue(marker).toJson(_trx, vertex->document).steal();
+  }
+
+  TRI_json_t* copy = TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, vertex->json);
+
+  if (copy == nullptr) {
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_OUT_OF_MEMORY);
+  }
+
+  return copy;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
@@ -0,0 +1,365 @@
+////////////////////////////////////////////////////////////////////////////////
+/// @brief Aql, graph traversal engine
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2014 ArangoDB GmbH, Cologne, Germany
+/// Copyright 2004-2014 triAGENS GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is ArangoDB GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2014, ArangoDB GmbH, Cologne, Germany
+/// @author Copyright 2012-2013, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef ARANGODB_AQL_TRAVERSER_H
+#define ARANGODB_AQL_TRAVERSER_H 1
+
+#include "Basics/Common.h"
+#include "Basics/JsonHelper.h"
+#include "Utils/AqlTransaction.h"
+#include "VocBase/document-collection.h"
+#include "VocBase/edge-collection.h"
+
+namespace triagens {
+  namespace aql {
+
+    class Query;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   class Traverser
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief traversal engine working directly on the edge index of an edge
+/// collection. this mirrors the behavior of the JavaScript traverser with its
+/// default visitor, expanders and depth filters, but does not build any
+/// intermediate JavaScript objects
+////////////////////////////////////////////////////////////////////////////////
+
+    class Traverser {
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      public types
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief traversal strategy
+////////////////////////////////////////////////////////////////////////////////
+
+        enum Strategy {
+          STRATEGY_DEPTH_FIRST,
+          STRATEGY_BREADTH_FIRST
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief uniqueness level for vertices and edges
+////////////////////////////////////////////////////////////////////////////////
+
+        enum Uniqueness {
+          UNIQUE_NONE   = 0,
+          UNIQUE_PATH   = 1,
+          UNIQUE_GLOBAL = 2
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief vertex identifier, consisting of collection id and key
+////////////////////////////////////////////////////////////////////////////////
+
+        struct VertexId {
+          VertexId ()
+            : cid(0),
+              key() {
+          }
+
+          VertexId (TRI_voc_cid_t cid,
+                    char const* key)
+            : cid(cid),
+              key(key) {
+          }
+
+          bool operator== (VertexId const& other) const {
+            return (cid == other.cid && key == other.key);
+          }
+
+          TRI_voc_cid_t cid;
+          std::string   key;
+        };
+
+        struct VertexIdHash {
+          size_t operator() (VertexId const& id) const {
+            return std::hash<std::string>()(id.key) ^ static_cast<size_t>(id.cid);
+          }
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief traversal options
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Options {
+          Options ()
+            : direction(TRI_EDGE_OUT),
+              strategy(STRATEGY_DEPTH_FIRST),
+              backward(false),
+              uniqueVertices(UNIQUE_NONE),
+              uniqueEdges(UNIQUE_PATH),
+              minDepth(0.0),
+              maxDepth(256.0),
+              maxIterations(10000000),
+              trackPaths(false),
+              weightAttribute(),
+              defaultWeight(0.0) {
+          }
+
+          TRI_edge_direction_e direction;
+          Strategy             strategy;
+          bool                 backward;
+          Uniqueness           uniqueVertices;
+          Uniqueness           uniqueEdges;
+          double               minDepth;      // 0 = no minimum depth
+          double               maxDepth;      // 0 = no maximum depth
+          uint64_t             maxIterations;
+          bool                 trackPaths;
+          std::string          weightAttribute;
+          double               defaultWeight; // 0 = edges without weight are unreachable
+        };
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cached vertex lookup result
+////////////////////////////////////////////////////////////////////////////////
+
+        struct VertexInfo {
+          VertexId const*            id;
+          TRI_document_collection_t* document;
+          TRI_doc_mptr_copy_t        mptr;
+          TRI_json_t*                json;
+          bool                       exists;
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief an edge plus the vertex it leads to
+////////////////////////////////////////////////////////////////////////////////
+
+        struct Connection {
+          TRI_df_marker_t const* edge;
+          VertexInfo*            vertex;
+        };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shortest path node
+////////////////////////////////////////////////////////////////////////////////
+
+        struct PathNode;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+      public:
+
+        Traverser (Traverser const&) = delete;
+        Traverser& operator= (Traverser const&) = delete;
+
+        Traverser (triagens::aql::Query*,
+                   triagens::arango::AqlTransaction*,
+                   TRI_document_collection_t*,
+                   Options const&);
+
+        ~Traverser ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief parse a vertex id string ("collection/key"). returns an error if
+/// the string is not a valid vertex id or the collection is unknown
+////////////////////////////////////////////////////////////////////////////////
+
+        int parseVertexId (char const*,
+                           VertexId&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up all edges connected to a vertex, in the configured
+/// direction
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<TRI_doc_mptr_copy_t> edges (VertexId const&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief convert an edge into JSON
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Json edgeJson (TRI_df_marker_t const*) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the id of the vertex at the other end of an edge
+////////////////////////////////////////////////////////////////////////////////
+
+        static VertexId peerVertex (TRI_df_marker_t const*,
+                                    TRI_edge_direction_e,
+                                    VertexId const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a vertex exists
+////////////////////////////////////////////////////////////////////////////////
+
+        bool hasVertex (VertexId const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the JSON of a vertex, or null if the vertex does not exist
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Json vertexJson (VertexId const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run a depth-first or breadth-first traversal from the start vertex
+/// and return the visited vertices (and paths) in visitation order
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Json traverse (VertexId const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find the shortest path between two vertices (dijkstra) and return
+/// the vertices (and paths) on it
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Json shortestPath (VertexId const&,
+                                             VertexId const&);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief look up a vertex, using the cache
+////////////////////////////////////////////////////////////////////////////////
+
+        VertexInfo* lookupVertex (VertexId const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief expand a vertex into its connected edges and (existing) vertices
+////////////////////////////////////////////////////////////////////////////////
+
+        void expand (VertexInfo const*,
+                     std::vector<Connection>&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the weight of an edge
+////////////////////////////////////////////////////////////////////////////////
+
+        double edgeWeight (TRI_df_marker_t const*) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply the depth filters, returns whether to visit and to expand
+/// the vertex at the given depth
+////////////////////////////////////////////////////////////////////////////////
+
+        void filter (size_t,
+                     bool&,
+                     bool&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check the iteration limit and whether the query was killed
+////////////////////////////////////////////////////////////////////////////////
+
+        void checkIteration (uint64_t&) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append a result item for a vertex and its path
+////////////////////////////////////////////////////////////////////////////////
+
+        void addResult (triagens::basics::Json&,
+                        std::vector<VertexInfo*> const&,
+                        std::vector<TRI_df_marker_t const*> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return a copy of the vertex JSON
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_json_t* copyVertexJson (VertexInfo*);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the query, used for checking if it was killed
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::aql::Query* _query;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the transaction
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::arango::AqlTransaction* _trx;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the edge collection
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_document_collection_t* _edgeCollection;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the traversal options
+////////////////////////////////////////////////////////////////////////////////
+
+        Options const _options;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief attribute path id of the weight attribute in the edge collection
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_shape_pid_t _weightPid;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief vertex cache
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_map<VertexId, VertexInfo, VertexIdHash> _vertices;
+
+    };
+
+  }
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "/// @brief\\|/// {@inheritDoc}\\|/// @page\\|// --SECTION--\\|/// @\\}"
+// End:
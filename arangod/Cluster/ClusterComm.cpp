@@ -39,6 +39,13 @@
 
 #include "VocBase/server.h"
 
+#ifdef _WIN32
+#include "Basics/win-utils.h"
+#include <evwrap.h>
+#else
+#include <ev.h>
+#endif
+
 using namespace std;
 using namespace triagens::arango;
 
@@ -265,6 +272,10 @@ ClusterCommResult* ClusterComm::asyncRequest (
             (unsigned long long) op->operationID);
   somethingToSend.signal();
 
+  if (_backgroundThread != nullptr) {
+    _backgroundThread->wakeup();
+  }
+
   return res;
 }
 
@@ -280,6 +291,11 @@ ClusterCommResult* ClusterComm::asyncRequest (
 /// does not keep a record of this operation, in particular, you cannot
 /// use @ref enquire to ask about it.
 ///
+/// The request itself is sent by the ClusterComm thread like the
+/// asynchronous ones, the calling thread only waits for it to finish. A
+/// dispatcher thread tells the dispatcher that it is blocked meanwhile, as
+/// in @ref wait.
+///
 /// Arguments: `clientTransactionID` is a string coming from the client
 /// and describing the transaction the client is doing, `coordTransactionID`
 /// is a number describing the transaction the coordinator is doing,
@@ -298,130 +314,148 @@ ClusterCommResult* ClusterComm::syncRequest (
         map<string, string> const&         headerFields,
         ClusterCommTimeout                 timeout) {
 
-  map<string, string> headersCopy(headerFields);
-
-  ClusterCommResult* res = new ClusterCommResult();
-  res->clientTransactionID  = clientTransactionID;
-  res->coordTransactionID   = coordTransactionID;
+  ClusterCommOperation* op = new ClusterCommOperation();
+  op->clientTransactionID  = clientTransactionID;
+  op->coordTransactionID   = coordTransactionID;
   do {
-    res->operationID        = getOperationID();
+    op->operationID        = getOperationID();
   } 
-  while (res->operationID == 0);   // just to make sure
-  res->status               = CL_COMM_SENDING;
+  while (op->operationID == 0);   // just to make sure
+  op->status               = CL_COMM_SENDING;
+  op->sync                 = true;
 
-  double currentTime = TRI_microtime();
-  double endTime = timeout == 0.0 ? currentTime + 24 * 60 * 60.0
-                                  : currentTime + timeout;
+  map<string, string>* headersCopy = new map<string, string>(headerFields);
 
   if (destination.substr(0, 6) == "shard:") {
-    res->shardID = destination.substr(6);
-    res->serverID = ClusterInfo::instance()->getResponsibleServer(res->shardID);
-    LOG_DEBUG("Responsible server: %s", res->serverID.c_str());
-    if (res->serverID.empty()) {
-      res->status = CL_COMM_ERROR;
-      return res;
+    op->shardID = destination.substr(6);
+    op->serverID = ClusterInfo::instance()->getResponsibleServer(op->shardID);
+    LOG_DEBUG("Responsible server: %s", op->serverID.c_str());
+    if (op->serverID.empty()) {
+      delete headersCopy;
+      op->status = CL_COMM_ERROR;
+      return op;
     }
     if (triagens::arango::Transaction::_makeNolockHeaders != nullptr) {
       // LOCKING-DEBUG
       // std::cout << "Found Nolock header\n";
-      auto it = triagens::arango::Transaction::_makeNolockHeaders->find(res->shardID);
+      auto it = triagens::arango::Transaction::_makeNolockHeaders->find(op->shardID);
       if (it != triagens::arango::Transaction::_makeNolockHeaders->end()) {
         // LOCKING-DEBUG
-        // std::cout << "Found this shard: " << res->shardID << std::endl;
-        headersCopy["X-Arango-Nolock"] = res->shardID;
+        // std::cout << "Found this shard: " << op->shardID << std::endl;
+        (*headersCopy)["X-Arango-Nolock"] = op->shardID;
       }
     }
   }
   else if (destination.substr(0, 7) == "server:") {
-    res->shardID = "";
-    res->serverID = destination.substr(7);
+    op->shardID = "";
+    op->serverID = destination.substr(7);
   }
   else {
-    res->status = CL_COMM_ERROR;
-    return res;
+    delete headersCopy;
+    op->status = CL_COMM_ERROR;
+    return op;
   }
 
-  // We need a connection to this server:
-  string endpoint = ClusterInfo::instance()->getServerEndpoint(res->serverID);
-  if (endpoint.empty()) {
-    res->status = CL_COMM_ERROR;
-    if (logConnectionErrors()) {
-      LOG_ERROR("cannot find endpoint of server '%s'", res->serverID.c_str());
-    }
-    else {
-      LOG_INFO("cannot find endpoint of server '%s'", res->serverID.c_str());
-    }
+  if (_backgroundThread == nullptr) {
+    delete headersCopy;
+    op->status = CL_COMM_ERROR;
+    op->errorMessage = "ClusterComm background thread is not running";
+    return op;
   }
-  else {
-    httpclient::ConnectionManager* cm = httpclient::ConnectionManager::instance();
-    httpclient::ConnectionManager::SingleServerConnection* connection
-        = cm->leaseConnection(endpoint);
-  
-    if (nullptr == connection) {
-      res->status = CL_COMM_ERROR;
-      if (logConnectionErrors()) {
-        LOG_ERROR("cannot create connection to server '%s'", res->serverID.c_str());
-      }
-      else {
-        LOG_INFO("cannot create connection to server '%s'", res->serverID.c_str());
-      }
-    }
-    else {
-      LOG_DEBUG("sending %s request to DB server '%s': %s",
-         triagens::rest::HttpRequest::translateMethod(reqtype).c_str(),
-         res->serverID.c_str(), body.c_str());
-      // LOCKING-DEBUG
-      // std::cout << "syncRequest: sending " << triagens::rest::HttpRequest::translateMethod(reqtype) << " request to DB server '" << res->serverID << ":" << path << "\n" << body << "\n";
-      // for (auto& h : headersCopy) {
-      //   std::cout << h.first << ":" << h.second << std::endl;
-      // }
-      // std::cout << std::endl;
-      triagens::httpclient::SimpleHttpClient* client
-          = new triagens::httpclient::SimpleHttpClient(
-                                connection->connection,
-                                endTime - currentTime, false);
-      client->keepConnectionOnDestruction(true);
-
-      headersCopy["Authorization"] = ServerState::instance()->getAuthentication();
+
+  (*headersCopy)["Authorization"] = ServerState::instance()->getAuthentication();
 #ifdef DEBUG_CLUSTER_COMM
 #ifdef TRI_ENABLE_MAINTAINER_MODE
 #if HAVE_BACKTRACE
-      std::string bt;
-      TRI_GetBacktrace(bt);
-      std::replace( bt.begin(), bt.end(), '\n', ';'); // replace all '\n' to ';'
-      headersCopy["X-Arango-BT-SYNC"] = bt;
+  std::string bt;
+  TRI_GetBacktrace(bt);
+  std::replace( bt.begin(), bt.end(), '\n', ';'); // replace all '\n' to ';'
+  (*headersCopy)["X-Arango-BT-SYNC"] = bt;
 #endif
 #endif
 #endif
-      res->result = client->request(reqtype, path, body.c_str(), body.size(),
-                                    headersCopy);
 
-      if (res->result == nullptr || ! res->result->isComplete()) {
-        res->errorMessage = client->getErrorMessage();
-        if (res->errorMessage == "Request timeout reached") {
-          res->status = CL_COMM_TIMEOUT;
-        }
-        else {
-          res->status = CL_COMM_ERROR;
-        }
-        cm->brokenConnection(connection);
-        client->invalidateConnection();
+  double endTime = timeout == 0.0 ? TRI_microtime() + 24 * 60 * 60.0
+                                  : TRI_microtime() + timeout;
+
+  op->status               = CL_COMM_SUBMITTED;
+  op->reqtype              = reqtype;
+  op->path                 = path;
+  op->body                 = new string(body);
+  op->freeBody             = true;
+  op->headerFields         = headersCopy;
+  op->endTime              = endTime;
+
+  OperationID const operationID = op->operationID;
+
+  // the request is sent by the ClusterComm thread, like all asynchronous
+  // ones. it does not carry the X-Arango-Async header, so the result field
+  // holds the server's answer once the operation shows up in the receive
+  // queue. match() ignores synchronous operations, so no other caller can
+  // pick it up from there
+  {
+    basics::ConditionLocker locker(&somethingToSend);
+    toSend.push_back(op);
+    list<ClusterCommOperation*>::iterator i = toSend.end();
+    toSendByOpID[operationID] = --i;
+  }
+  LOG_DEBUG("In syncRequest, put into queue %llu",
+            (unsigned long long) operationID);
+  somethingToSend.signal();
+  _backgroundThread->wakeup();
+
+  // tell Dispatcher that we are waiting:
+  if (triagens::rest::DispatcherThread::currentDispatcherThread != nullptr) {
+    triagens::rest::DispatcherThread::currentDispatcherThread->blockThread();
+  }
+
+  ClusterCommOperation* done = nullptr;
+
+  {
+    basics::ConditionLocker locker(&somethingReceived);
+
+    while (true) {
+      IndexIterator i = receivedByOpID.find(operationID);
+
+      if (i != receivedByOpID.end()) {
+        QueueIterator q = i->second;
+        done = *q;
+        receivedByOpID.erase(i);
+        received.erase(q);
+        break;
       }
-      else {
-        cm->returnConnection(connection);
-        if (res->result->wasHttpError()) {
-          res->status = CL_COMM_ERROR;
-          res->errorMessage = client->getErrorMessage();
+
+      {
+        basics::ConditionLocker sendlocker(&somethingToSend);
+
+        if (toSendByOpID.find(operationID) == toSendByOpID.end()) {
+          // the queues have been cleaned up during shutdown
+          break;
         }
       }
-      delete client;
-    }
-    if (res->status == CL_COMM_SENDING) {
-      // Everything was OK
-      res->status = CL_COMM_SENT;
+
+      // the ClusterComm thread finishes the operation at its end time at
+      // the latest, but look again regularly in case it is shutting down
+      somethingReceived.wait(uint64_t(1000000));
     }
   }
-  return res;
+
+  // tell Dispatcher that we are back in business
+  if (triagens::rest::DispatcherThread::currentDispatcherThread != nullptr) {
+    triagens::rest::DispatcherThread::currentDispatcherThread->unblockThread();
+  }
+
+  if (done == nullptr) {
+    ClusterCommResult* res = new ClusterCommResult();
+    res->clientTransactionID = clientTransactionID;
+    res->coordTransactionID = coordTransactionID;
+    res->operationID = operationID;
+    res->status = CL_COMM_ERROR;
+    res->errorMessage = "ClusterComm is shutting down";
+    return res;
+  }
+
+  return done;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -434,7 +468,9 @@ bool ClusterComm::match (
             ShardID const&             shardID,
             ClusterCommOperation* op) {
 
-  return ( (clientTransactionID == "" ||
+  // synchronous operations are only visible to their syncRequest call
+  return ( ! op->sync &&
+           (clientTransactionID == "" ||
             clientTransactionID == op->clientTransactionID) &&
            (0 == coordTransactionID ||
             coordTransactionID == op->coordTransactionID) &&
@@ -974,6 +1010,57 @@ void ClusterComm::cleanupAllQueues() {
 // --SECTION--                                                ClusterCommThread
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a request in flight, driven by the event loop
+///
+/// the watcher must be the first member, so that the libev callback can
+/// cast the watcher back to the request
+////////////////////////////////////////////////////////////////////////////////
+
+struct ClusterCommThread::InFlightRequest {
+  ev_io watcher;
+  ClusterCommThread* thread;
+  ClusterCommOperation* op;
+  httpclient::ConnectionManager::SingleServerConnection* connection;
+  httpclient::SimpleHttpClient* client;
+  bool active;
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief called when the socket of an in-flight request becomes ready
+////////////////////////////////////////////////////////////////////////////////
+
+static void RequestCallback (struct ev_loop*, ev_io* w, int) {
+  auto req = reinterpret_cast<ClusterCommThread::InFlightRequest*>(w);
+
+  req->thread->handleRequestIO(req);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief called when another thread has queued an operation
+////////////////////////////////////////////////////////////////////////////////
+
+static void WakeupCallback (struct ev_loop*, ev_async* w, int) {
+  auto thread = static_cast<ClusterCommThread*>(w->data);
+
+  thread->sendQueuedRequests();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief called periodically to detect timeouts and the stop flag
+////////////////////////////////////////////////////////////////////////////////
+
+static void TimerCallback (struct ev_loop*, ev_timer* w, int) {
+  auto thread = static_cast<ClusterCommThread*>(w->data);
+
+  thread->checkTimeouts();
+  thread->sendQueuedRequests();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -984,11 +1071,35 @@ void ClusterComm::cleanupAllQueues() {
 
 ClusterCommThread::ClusterCommThread ()
   : Thread("ClusterComm"),
+    _loop(nullptr),
+    _wakeupWatcher(nullptr),
+    _timerWatcher(nullptr),
+    _inFlight(),
     _agency(),
     _condition(),
     _stop(0) {
 
   allowAsynchronousCancelation();
+
+  struct ev_loop* loop = ev_loop_new(EVFLAG_AUTO);
+
+  if (loop == nullptr) {
+    LOG_FATAL_AND_EXIT("cannot create event loop for ClusterComm");
+  }
+
+  ev_async* wakeup = new ev_async;
+  ev_async_init(wakeup, WakeupCallback);
+  wakeup->data = this;
+  ev_async_start(loop, wakeup);
+
+  ev_timer* timer = new ev_timer;
+  ev_timer_init(timer, TimerCallback, 0.1, 0.1);
+  timer->data = this;
+  ev_timer_start(loop, timer);
+
+  _loop = loop;
+  _wakeupWatcher = wakeup;
+  _timerWatcher = timer;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -996,6 +1107,16 @@ ClusterCommThread::ClusterCommThread ()
 ////////////////////////////////////////////////////////////////////////////////
 
 ClusterCommThread::~ClusterCommThread () {
+  struct ev_loop* loop = static_cast<struct ev_loop*>(_loop);
+  ev_async* wakeup = static_cast<ev_async*>(_wakeupWatcher);
+  ev_timer* timer = static_cast<ev_timer*>(_timerWatcher);
+
+  ev_async_stop(loop, wakeup);
+  ev_timer_stop(loop, timer);
+  ev_loop_destroy(loop);
+
+  delete wakeup;
+  delete timer;
 }
 
 // -----------------------------------------------------------------------------
@@ -1004,184 +1125,339 @@ ClusterCommThread::~ClusterCommThread () {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief ClusterComm main loop
+///
+/// The thread runs an event loop that keeps up to MaxInFlight requests in
+/// flight at the same time, each of them on its own leased connection from
+/// the ConnectionManager. Thus, a scatter/gather operation over many shards
+/// takes as long as the slowest shard rather than the sum of all of them.
 ////////////////////////////////////////////////////////////////////////////////
 
 void ClusterCommThread::run () {
-  ClusterComm::QueueIterator q;
-  ClusterComm::IndexIterator i;
-  ClusterCommOperation* op;
-  ClusterComm* cc = ClusterComm::instance();
+  struct ev_loop* loop = static_cast<struct ev_loop*>(_loop);
 
   LOG_DEBUG("starting ClusterComm thread");
 
+  // there might be operations that were queued before we started
+  sendQueuedRequests();
+
   while (0 == _stop) {
-    // First check the sending queue, as long as it is not empty, we send
-    // a request via SimpleHttpClient:
-    while (true) {  // left via break when there is no job in send queue
-      if (0 != _stop) {
-        break;
-      }
+    ev_run(loop, EVRUN_ONCE);
+  }
 
-      {
-        basics::ConditionLocker locker(&cc->somethingToSend);
-        if (cc->toSend.empty()) {
-          break;
-        }
-        else {
-          LOG_DEBUG("Noticed something to send");
-          op = cc->toSend.front();
-          TRI_ASSERT(op->status == CL_COMM_SUBMITTED);
-          op->status = CL_COMM_SENDING;
-        }
-      }
+  // give up on all requests still in flight, their operations will
+  // show up as timed out
+  while (! _inFlight.empty()) {
+    finishRequest(*_inFlight.begin());
+  }
 
-      // We release the lock, if the operation is dropped now, the
-      // `dropped` flag is set. We find out about this after we have
-      // sent the request (happens in moveFromSendToReceived).
+  // another thread is waiting for this value to shut down properly
+  _stop = 2;
 
-      // Have we already reached the timeout?
-      double currentTime = TRI_microtime();
-      if (op->endTime <= currentTime) {
-        op->status = CL_COMM_TIMEOUT;
-      }
-      else {
-        if (op->serverID == "") {
-          op->status = CL_COMM_ERROR;
-        }
-        else {
-          // We need a connection to this server:
-          string endpoint
-              = ClusterInfo::instance()->getServerEndpoint(op->serverID);
-          if (endpoint == "") {
-            op->status = CL_COMM_ERROR;
-
-            if (cc->logConnectionErrors()) {
-              LOG_ERROR("cannot find endpoint for server '%s'",
-                        op->serverID.c_str());
-            }
-            else {
-              LOG_INFO("cannot find endpoint for server '%s'",
-                       op->serverID.c_str());
-            }
-          }
-          else {
-            httpclient::ConnectionManager* cm
-                = httpclient::ConnectionManager::instance();
-            httpclient::ConnectionManager::SingleServerConnection* connection
-                = cm->leaseConnection(endpoint);
-            if (0 == connection) {
-              op->status = CL_COMM_ERROR;
-              if (cc->logConnectionErrors()) {
-                LOG_ERROR("cannot create connection to server '%s'", op->serverID.c_str());
-              }
-              else {
-                LOG_INFO("cannot create connection to server '%s'", op->serverID.c_str());
-              }
-            }
-            else {
-              if (0 != op->body) {
-                LOG_DEBUG("sending %s request to DB server '%s': %s",
-                   triagens::rest::HttpRequest::translateMethod(op->reqtype)
-                     .c_str(), op->serverID.c_str(), op->body->c_str());
-              }
-              else {
-                LOG_DEBUG("sending %s request to DB server '%s'",
-                   triagens::rest::HttpRequest::translateMethod(op->reqtype)
-                      .c_str(), op->serverID.c_str());
-              }
-
-              triagens::httpclient::SimpleHttpClient* client
-                = new triagens::httpclient::SimpleHttpClient(
-                                      connection->connection,
-                                      op->endTime-currentTime, false);
-              client->keepConnectionOnDestruction(true);
-
-              // We add this result to the operation struct without acquiring
-              // a lock, since we know that only we do such a thing:
-              if (nullptr != op->body) {
-                op->result = client->request(op->reqtype, op->path,
-                             op->body->c_str(), op->body->size(),
-                             *(op->headerFields));
-              }
-              else {
-                op->result = client->request(op->reqtype, op->path,
-                             nullptr, 0, *(op->headerFields));
-              }
-
-              if (op->result == nullptr || ! op->result->isComplete()) {
-                if (client->getErrorMessage() == "Request timeout reached") {
-                  op->status = CL_COMM_TIMEOUT;
-                }
-                else {
-                  op->status = CL_COMM_ERROR;
-                }
-                cm->brokenConnection(connection);
-                client->invalidateConnection();
-              }
-              else {
-                cm->returnConnection(connection);
-                if (op->result->wasHttpError()) {
-                  op->status = CL_COMM_ERROR;
-                }
-              }
-              delete client;
-            }
-          }
-        }
-      }
+  LOG_DEBUG("stopped ClusterComm thread");
+}
 
-      if (! cc->moveFromSendToReceived(op->operationID)) {
-        // It was dropped in the meantime, so forget about it:
-        delete op;
-      }
-    }
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initialises the cluster comm background thread
+////////////////////////////////////////////////////////////////////////////////
+
+bool ClusterCommThread::init () {
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wakes up the event loop of the ClusterCommThread
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterCommThread::wakeup () {
+  ev_async_send(static_cast<struct ev_loop*>(_loop),
+                static_cast<ev_async*>(_wakeupWatcher));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief starts as many queued operations as the in-flight limit allows
+////////////////////////////////////////////////////////////////////////////////
 
-    // Now the send queue is empty (at least was empty, when we looked
-    // just now, so we can check on our receive queue to detect timeouts:
+void ClusterCommThread::sendQueuedRequests () {
+  ClusterComm* cc = ClusterComm::instance();
+
+  while (0 == _stop && _inFlight.size() < MaxInFlight) {
+    ClusterCommOperation* op = nullptr;
 
     {
-      double currentTime = TRI_microtime();
-      basics::ConditionLocker locker(&cc->somethingReceived);
-      ClusterComm::QueueIterator q;
-      for (q = cc->received.begin(); q != cc->received.end(); ++q) {
-        op = *q;
-        if (op->status == CL_COMM_SENT) {
-          if (op->endTime < currentTime) {
-            op->status = CL_COMM_TIMEOUT;
-          }
+      basics::ConditionLocker locker(&cc->somethingToSend);
+
+      // operations in flight stay in the send queue until they are
+      // finished, and they are always in front of the submitted ones
+      for (auto it : cc->toSend) {
+        if (it->status == CL_COMM_SUBMITTED) {
+          op = it;
+          break;
         }
       }
+
+      if (op == nullptr) {
+        break;
+      }
+
+      LOG_DEBUG("Noticed something to send");
+      op->status = CL_COMM_SENDING;
     }
 
-    // Finally, wait for some time or until something happens using
-    // the condition variable:
-    {
-      basics::ConditionLocker locker(&cc->somethingToSend);
-      locker.wait(100000);
+    // We release the lock, if the operation is dropped now, the
+    // `dropped` flag is set. We find out about this after we have
+    // sent the request (happens in moveFromSendToReceived).
+    startRequest(op);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advances an in-flight request after its socket became ready
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterCommThread::handleRequestIO (InFlightRequest* req) {
+  if (req->op->endTime > TRI_microtime()) {
+    // the watcher has reported the socket as ready, so the step does not
+    // need to wait
+    req->client->processStep(0.0);
+  }
+
+  driveRequest(req);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief times out overdue operations in flight and in the receive queue
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterCommThread::checkTimeouts () {
+  double currentTime = TRI_microtime();
+
+  std::vector<InFlightRequest*> overdue;
+
+  for (auto req : _inFlight) {
+    if (req->op->endTime <= currentTime) {
+      overdue.push_back(req);
     }
   }
 
-  // another thread is waiting for this value to shut down properly
-  _stop = 2;
+  for (auto req : overdue) {
+    finishRequest(req);
+  }
 
-  LOG_DEBUG("stopped ClusterComm thread");
+  ClusterComm* cc = ClusterComm::instance();
+  basics::ConditionLocker locker(&cc->somethingReceived);
+
+  for (auto op : cc->received) {
+    if (op->status == CL_COMM_SENT && ! op->sync) {
+      if (op->endTime < currentTime) {
+        op->status = CL_COMM_TIMEOUT;
+      }
+    }
+  }
 }
 
 // -----------------------------------------------------------------------------
-// --SECTION--                                                    public methods
+// --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief initialises the cluster comm background thread
+/// @brief starts sending an operation
 ////////////////////////////////////////////////////////////////////////////////
 
-bool ClusterCommThread::init () {
+bool ClusterCommThread::startRequest (ClusterCommOperation* op) {
+  ClusterComm* cc = ClusterComm::instance();
+
+  // Have we already reached the timeout?
+  double currentTime = TRI_microtime();
+  if (op->endTime <= currentTime) {
+    op->status = CL_COMM_TIMEOUT;
+    finishOperation(op);
+    return false;
+  }
+
+  if (op->serverID == "") {
+    op->status = CL_COMM_ERROR;
+    finishOperation(op);
+    return false;
+  }
+
+  // We need a connection to this server:
+  string endpoint = ClusterInfo::instance()->getServerEndpoint(op->serverID);
+
+  if (endpoint == "") {
+    op->status = CL_COMM_ERROR;
+
+    if (cc->logConnectionErrors()) {
+      LOG_ERROR("cannot find endpoint for server '%s'",
+                op->serverID.c_str());
+    }
+    else {
+      LOG_INFO("cannot find endpoint for server '%s'",
+               op->serverID.c_str());
+    }
+
+    finishOperation(op);
+    return false;
+  }
+
+  httpclient::ConnectionManager::SingleServerConnection* connection
+      = httpclient::ConnectionManager::instance()->leaseConnection(endpoint);
+
+  if (nullptr == connection) {
+    op->status = CL_COMM_ERROR;
+
+    if (cc->logConnectionErrors()) {
+      LOG_ERROR("cannot create connection to server '%s'", op->serverID.c_str());
+    }
+    else {
+      LOG_INFO("cannot create connection to server '%s'", op->serverID.c_str());
+    }
+
+    finishOperation(op);
+    return false;
+  }
+
+  if (nullptr != op->body) {
+    LOG_DEBUG("sending %s request to DB server '%s': %s",
+       triagens::rest::HttpRequest::translateMethod(op->reqtype)
+         .c_str(), op->serverID.c_str(), op->body->c_str());
+  }
+  else {
+    LOG_DEBUG("sending %s request to DB server '%s'",
+       triagens::rest::HttpRequest::translateMethod(op->reqtype)
+          .c_str(), op->serverID.c_str());
+  }
+
+  // connect without blocking the event loop, the watcher waits for the
+  // socket to become writable instead
+  connection->endpoint->setNonBlockingConnect(true);
+
+  auto client = new triagens::httpclient::SimpleHttpClient(
+                        connection->connection,
+                        op->endTime - currentTime, false);
+  client->keepConnectionOnDestruction(true);
+
+  if (nullptr != op->body) {
+    client->beginRequest(op->reqtype, op->path,
+                         op->body->c_str(), op->body->size(),
+                         *(op->headerFields));
+  }
+  else {
+    client->beginRequest(op->reqtype, op->path,
+                         nullptr, 0, *(op->headerFields));
+  }
+
+  auto req = new InFlightRequest;
+  ev_init(&req->watcher, RequestCallback);
+  req->thread = this;
+  req->op = op;
+  req->connection = connection;
+  req->client = client;
+  req->active = false;
+
+  _inFlight.insert(req);
+
+  driveRequest(req);
   return true;
 }
 
-// -----------------------------------------------------------------------------
-// --SECTION--                                                   private methods
-// -----------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
+/// @brief connects a request if required and (re-)arms its I/O watcher
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterCommThread::driveRequest (InFlightRequest* req) {
+  struct ev_loop* loop = static_cast<struct ev_loop*>(_loop);
+  httpclient::SimpleHttpClient* client = req->client;
+  double remainingTime = req->op->endTime - TRI_microtime();
+
+  // (re-)connecting returns immediately, the connection is established in
+  // the background and the socket becomes writable once it is. this only
+  // happens for new pooled connections or after the server has closed an
+  // idle one. SSL endpoints still connect synchronously
+  if (client->needsConnect() && remainingTime > 0.0) {
+    client->processStep(0.0);
+    remainingTime = req->op->endTime - TRI_microtime();
+  }
+
+  if (client->isFinished() || remainingTime <= 0.0) {
+    finishRequest(req);
+    return;
+  }
+
+  int fd = req->connection->connection->getSocket().fileDescriptor;
+  int events = client->wantsWrite() ? EV_WRITE : EV_READ;
+
+  if (req->active) {
+    if (req->watcher.fd == fd && static_cast<int>(req->watcher.events & (EV_READ | EV_WRITE)) == events) {
+      // watcher is already armed for what we need
+      return;
+    }
+
+    ev_io_stop(loop, &req->watcher);
+  }
+
+  ev_io_set(&req->watcher, fd, events);
+  ev_io_start(loop, &req->watcher);
+  req->active = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finishes an in-flight request
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterCommThread::finishRequest (InFlightRequest* req) {
+  httpclient::ConnectionManager* cm = httpclient::ConnectionManager::instance();
+  httpclient::SimpleHttpClient* client = req->client;
+  ClusterCommOperation* op = req->op;
+
+  if (req->active) {
+    ev_io_stop(static_cast<struct ev_loop*>(_loop), &req->watcher);
+  }
+
+  _inFlight.erase(req);
+
+  // We add this result to the operation struct without acquiring
+  // a lock, since we know that only we do such a thing:
+  op->result = client->finishRequest();
+
+  if (op->result == nullptr || ! op->result->isComplete()) {
+    op->errorMessage = client->getErrorMessage();
+    if (op->errorMessage == "Request timeout reached") {
+      op->status = CL_COMM_TIMEOUT;
+    }
+    else {
+      op->status = CL_COMM_ERROR;
+    }
+    cm->brokenConnection(req->connection);
+    client->invalidateConnection();
+  }
+  else {
+    cm->returnConnection(req->connection);
+    if (op->result->wasHttpError()) {
+      op->status = CL_COMM_ERROR;
+      op->errorMessage = client->getErrorMessage();
+    }
+  }
+
+  delete client;
+  delete req;
+
+  finishOperation(op);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hands a finished operation over to the receive queue
+////////////////////////////////////////////////////////////////////////////////
+
+void ClusterCommThread::finishOperation (ClusterCommOperation* op) {
+  if (! ClusterComm::instance()->moveFromSendToReceived(op->operationID)) {
+    // It was dropped in the meantime, so forget about it:
+    delete op;
+  }
+}
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
@@ -43,6 +43,8 @@
 #include "Cluster/ClusterInfo.h"
 #include "Cluster/ServerState.h"
 
+#include <unordered_set>
+
 namespace triagens {
   namespace arango {
 
@@ -185,11 +187,13 @@ namespace triagens {
       std::map<std::string, std::string>* headerFields;
       ClusterCommCallback* callback;
       ClusterCommTimeout endTime;
+      bool sync;    // submitted by syncRequest, which waits for it
 
       ClusterCommOperation () 
         : body(nullptr), 
           headerFields(nullptr), 
-          callback(nullptr) {
+          callback(nullptr),
+          sync(false) {
       }
 
       virtual ~ClusterCommOperation () {
@@ -462,6 +466,10 @@ void ClusterCommRestCallback (std::string& coordinator, rest::HttpResponse* resp
 
     class ClusterCommThread : public basics::Thread {
 
+      public:
+
+        struct InFlightRequest;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -496,6 +504,33 @@ void ClusterCommRestCallback (std::string& coordinator, rest::HttpResponse* resp
 
         bool init ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wakes up the event loop of the ClusterCommThread
+///
+/// this is called by other threads after they have queued an operation, it
+/// is safe to call this concurrently
+////////////////////////////////////////////////////////////////////////////////
+
+        void wakeup ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief starts as many queued operations as the in-flight limit allows
+////////////////////////////////////////////////////////////////////////////////
+
+        void sendQueuedRequests ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief advances an in-flight request after its socket became ready
+////////////////////////////////////////////////////////////////////////////////
+
+        void handleRequestIO (InFlightRequest*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief times out overdue operations in flight and in the receive queue
+////////////////////////////////////////////////////////////////////////////////
+
+        void checkTimeouts ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief stops the ClusterCommThread
 ////////////////////////////////////////////////////////////////////////////////
@@ -509,6 +544,7 @@ void ClusterCommRestCallback (std::string& coordinator, rest::HttpResponse* resp
 
           _stop = 1;
           _condition.signal();
+          wakeup();
 
           while (_stop != 2) {
             usleep(1000);
@@ -533,12 +569,69 @@ void ClusterCommRestCallback (std::string& coordinator, rest::HttpResponse* resp
 
       private:
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief starts sending an operation, returns false if this failed
+/// immediately (the operation is then already finished)
+////////////////////////////////////////////////////////////////////////////////
+
+        bool startRequest (ClusterCommOperation*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief connects a request if required and (re-)arms its I/O watcher, or
+/// finishes the request if there is nothing more to do
+////////////////////////////////////////////////////////////////////////////////
+
+        void driveRequest (InFlightRequest*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finishes an in-flight request and hands its operation over to
+/// the receive queue
+////////////////////////////////////////////////////////////////////////////////
+
+        void finishRequest (InFlightRequest*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief hands a finished operation over to the receive queue
+////////////////////////////////////////////////////////////////////////////////
+
+        void finishOperation (ClusterCommOperation*);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
 
       private:
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximal number of requests in flight at the same time
+////////////////////////////////////////////////////////////////////////////////
+
+        static size_t const MaxInFlight = 256;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief event loop (struct ev_loop*)
+////////////////////////////////////////////////////////////////////////////////
+
+        void* _loop;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief async watcher used to wake up the event loop (ev_async*)
+////////////////////////////////////////////////////////////////////////////////
+
+        void* _wakeupWatcher;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief periodic timer for timeouts and the stop flag (ev_timer*)
+////////////////////////////////////////////////////////////////////////////////
+
+        void* _timerWatcher;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief requests in flight, only accessed from the event loop
+////////////////////////////////////////////////////////////////////////////////
+
+        std::unordered_set<InFlightRequest*> _inFlight;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief AgencyComm instance
 ////////////////////////////////////////////////////////////////////////////////
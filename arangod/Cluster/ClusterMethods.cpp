@@ -432,6 +432,12 @@ int figuresOnCoordinator (string const& dbname,
             result->_journalfileSize      += ExtractFigure<int64_t>(figures, "journals", "fileSize");
             result->_compactorfileSize    += ExtractFigure<int64_t>(figures, "compactors", "fileSize");
             result->_shapefileSize        += ExtractFigure<int64_t>(figures, "shapefiles", "fileSize");
+
+            result->_compactionBacklogCount += ExtractFigure<TRI_voc_ssize_t>(figures, "compaction", "backlogCount");
+            result->_compactionBacklogSize  += ExtractFigure<int64_t>(figures, "compaction", "backlogSize");
+            result->_compactionRuns         += ExtractFigure<uint64_t>(figures, "compaction", "runs");
+            result->_compactionBytesRead    += ExtractFigure<uint64_t>(figures, "compaction", "bytesRead");
+            result->_compactionBytesWritten += ExtractFigure<uint64_t>(figures, "compaction", "bytesWritten");
           }
           nrok++;
         }
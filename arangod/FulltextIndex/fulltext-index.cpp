@@ -31,6 +31,7 @@
 
 #include "Basics/locks.h"
 #include "Basics/logging.h"
+#include "Basics/ThreadPool.h"
 
 #include "fulltext-handles.h"
 #include "fulltext-list.h"
@@ -55,6 +56,15 @@
 
 #define MAX_WORD_BYTES ((TRI_FULLTEXT_MAX_WORD_LENGTH) * 4)
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of partitions of the index
+/// words are assigned to a partition by their first byte, and each partition
+/// has its own node tree and lock. writers and readers working on words in
+/// different partitions thus do not block each other
+////////////////////////////////////////////////////////////////////////////////
+
+#define NUM_PARTITIONS 16
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                     private types
 // -----------------------------------------------------------------------------
@@ -110,19 +120,20 @@ typedef struct node_s {
 node_t;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief the actual fulltext index
+/// @brief a partition of the fulltext index
+///
+/// the root node of a partition has the first bytes of all words in the
+/// partition as its followers. all nodes of the partition are protected by
+/// the partition's _lock
 ////////////////////////////////////////////////////////////////////////////////
 
 typedef struct {
-  node_t*                 _root;                // root node of the index
-
-  TRI_fulltext_handles_t* _handles;             // handles management instance
+  node_t*                 _root;                // root node of the partition
 
   TRI_read_write_lock_t   _lock;
 
-  size_t                  _memoryAllocated;     // total memory used by index
+  size_t                  _memoryAllocated;     // total memory used by the partition's nodes
 #if TRI_FULLTEXT_DEBUG
-  size_t                  _memoryBase;          // base memory
   size_t                  _memoryNodes;         // total memory used by nodes (node_t only)
   size_t                  _memoryFollowers;     // total memory used for followers (no documents)
   uint32_t                _nodesAllocated;      // number of nodes currently in use
@@ -131,6 +142,30 @@ typedef struct {
   uint32_t                _nodeChunkSize;       // how many sub-nodes to allocate per chunk
   uint32_t                _initialNodeHandles;  // how many handles to allocate per node
 }
+partition_t;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the actual fulltext index
+///
+/// locks are always acquired in this order: _lock, a partition's _lock,
+/// _handlesLock. _lock is held shared by all inserts, removals and queries
+/// and exclusively by the compaction only, which rewrites the handles of all
+/// partitions
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+  partition_t             _partitions[NUM_PARTITIONS];
+
+  TRI_fulltext_handles_t* _handles;             // handles management instance
+
+  TRI_read_write_lock_t   _lock;
+  TRI_read_write_lock_t   _handlesLock;         // protects _handles
+
+  size_t                  _memoryAllocated;     // memory used by the index itself (no nodes)
+#if TRI_FULLTEXT_DEBUG
+  size_t                  _memoryBase;          // base memory
+#endif
+}
 index_t;
 
 // -----------------------------------------------------------------------------
@@ -145,9 +180,9 @@ static node_char_t* NodeFollowersKeys (const node_t* const);
 
 static node_t** NodeFollowersNodes (const node_t* const);
 
-static void FreeFollowers (index_t* const, node_t*);
+static void FreeFollowers (partition_t* const, node_t*);
 
-static void FreeNode (index_t* const, node_t*);
+static void FreeNode (partition_t* const, node_t*);
 
 static size_t MemorySubNodeList (const uint32_t);
 
@@ -256,7 +291,7 @@ static inline size_t Padding (const uint32_t numEntries) {
 /// @brief re-allocate memory for the index and update memory usage statistics
 ////////////////////////////////////////////////////////////////////////////////
 
-static inline void* ReallocateMemory (index_t* const idx,
+static inline void* ReallocateMemory (partition_t* const part,
                                       void* old,
                                       const size_t newSize,
                                       const size_t oldSize) {
@@ -270,8 +305,8 @@ static inline void* ReallocateMemory (index_t* const idx,
 
   data = TRI_Reallocate(TRI_UNKNOWN_MEM_ZONE, old, newSize);
   if (data != NULL) {
-    idx->_memoryAllocated += newSize;
-    idx->_memoryAllocated -= oldSize;
+    part->_memoryAllocated += newSize;
+    part->_memoryAllocated -= oldSize;
   }
   return data;
 }
@@ -280,7 +315,7 @@ static inline void* ReallocateMemory (index_t* const idx,
 /// @brief allocate memory for the index and update memory usage statistics
 ////////////////////////////////////////////////////////////////////////////////
 
-static inline void* AllocateMemory (index_t* const idx, const size_t size) {
+static inline void* AllocateMemory (partition_t* const part, const size_t size) {
   void* data;
 
 #if TRI_FULLTEXT_DEBUG
@@ -289,7 +324,7 @@ static inline void* AllocateMemory (index_t* const idx, const size_t size) {
 
   data = TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, size, false);
   if (data != NULL) {
-    idx->_memoryAllocated += size;
+    part->_memoryAllocated += size;
   }
   return data;
 }
@@ -298,15 +333,15 @@ static inline void* AllocateMemory (index_t* const idx, const size_t size) {
 /// @brief free memory and update memory usage statistics
 ////////////////////////////////////////////////////////////////////////////////
 
-static inline void FreeMemory (index_t* const idx,
+static inline void FreeMemory (partition_t* const part,
                                void* data,
                                const size_t size) {
 #if TRI_FULLTEXT_DEBUG
   TRI_ASSERT(size > 0);
-  TRI_ASSERT(idx->_memoryAllocated >= size);
+  TRI_ASSERT(part->_memoryAllocated >= size);
 #endif
 
-  idx->_memoryAllocated -= size;
+  part->_memoryAllocated -= size;
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, data);
 }
 
@@ -315,7 +350,7 @@ static inline void FreeMemory (index_t* const idx,
 /// note: if the value is set to 0, this might free the sub-nodes list
 ////////////////////////////////////////////////////////////////////////////////
 
-static inline void SetNodeNumFollowers (index_t* const idx,
+static inline void SetNodeNumFollowers (partition_t* const part,
                                         node_t* const node,
                                         uint32_t value) {
 #if TRI_FULLTEXT_DEBUG
@@ -330,9 +365,9 @@ static inline void SetNodeNumFollowers (index_t* const idx,
     uint32_t numAllocated = NodeNumAllocated(node);
 
 #if TRI_FULLTEXT_DEBUG
-    idx->_memoryFollowers -= MemorySubNodeList(numAllocated);
+    part->_memoryFollowers -= MemorySubNodeList(numAllocated);
 #endif
-    FreeMemory(idx, node->_followers, MemorySubNodeList(numAllocated));
+    FreeMemory(part, node->_followers, MemorySubNodeList(numAllocated));
     node->_followers = NULL;
   }
   else {
@@ -478,7 +513,7 @@ static size_t MemorySubNodeList (const uint32_t numEntries) {
 /// size if it is too small to hold another node
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool ExtendSubNodeList (index_t* const idx,
+static bool ExtendSubNodeList (partition_t* const part,
                                node_t* const node,
                                const uint32_t numFollowers,
                                const uint32_t numAllocated) {
@@ -491,12 +526,12 @@ static bool ExtendSubNodeList (index_t* const idx,
 
   // current list has reached its limit, we must increase it
 
-  nextAllocated = numAllocated + idx->_nodeChunkSize;
+  nextAllocated = numAllocated + part->_nodeChunkSize;
   nextSize = MemorySubNodeList(nextAllocated);
 
   if (node->_followers == NULL) {
     // allocate a new list
-    node->_followers = AllocateMemory(idx, nextSize);
+    node->_followers = AllocateMemory(part, nextSize);
     if (node->_followers == NULL) {
       // out of memory
       return false;
@@ -505,7 +540,7 @@ static bool ExtendSubNodeList (index_t* const idx,
     // initialise the chunk of memory we just got
     InitialiseSubNodeList(node->_followers, nextAllocated, numFollowers);
 #if TRI_FULLTEXT_DEBUG
-    idx->_memoryFollowers += nextSize;
+    part->_memoryFollowers += nextSize;
 #endif
     return true;
   }
@@ -516,7 +551,7 @@ static bool ExtendSubNodeList (index_t* const idx,
 
     oldSize = MemorySubNodeList(numAllocated);
 
-    followers = ReallocateMemory(idx, node->_followers, nextSize, oldSize);
+    followers = ReallocateMemory(part, node->_followers, nextSize, oldSize);
     if (followers == NULL) {
       // out of memory
       return false;
@@ -525,8 +560,8 @@ static bool ExtendSubNodeList (index_t* const idx,
     // initialise the chunk of memory we just got
     InitialiseSubNodeList(followers, nextAllocated, numFollowers);
 #if TRI_FULLTEXT_DEBUG
-    idx->_memoryFollowers += nextSize;
-    idx->_memoryFollowers -= oldSize;
+    part->_memoryFollowers += nextSize;
+    part->_memoryFollowers -= oldSize;
 #endif
 
     // note the new pointer
@@ -545,8 +580,8 @@ static bool ExtendSubNodeList (index_t* const idx,
 /// @brief create a new, empty node
 ////////////////////////////////////////////////////////////////////////////////
 
-static node_t* CreateNode (index_t* const idx) {
-  node_t* node = static_cast<node_t*>(AllocateMemory(idx, sizeof(node_t)));
+static node_t* CreateNode (partition_t* const part) {
+  node_t* node = static_cast<node_t*>(AllocateMemory(part, sizeof(node_t)));
 
   if (node == NULL) {
     return NULL;
@@ -556,8 +591,8 @@ static node_t* CreateNode (index_t* const idx) {
   node->_handles   = NULL;
 
 #if TRI_FULLTEXT_DEBUG
-  idx->_nodesAllocated++;
-  idx->_memoryNodes += sizeof(node_t);
+  part->_nodesAllocated++;
+  part->_memoryNodes += sizeof(node_t);
 #endif
 
   return node;
@@ -567,7 +602,7 @@ static node_t* CreateNode (index_t* const idx) {
 /// @brief free a node's follower nodes
 ////////////////////////////////////////////////////////////////////////////////
 
-static void FreeFollowers (index_t* const idx, node_t* node) {
+static void FreeFollowers (partition_t* const part, node_t* node) {
   uint32_t numFollowers;
   uint32_t numAllocated;
 
@@ -587,15 +622,15 @@ static void FreeFollowers (index_t* const idx, node_t* node) {
 
     followerNodes = NodeFollowersNodes(node);
     for (i = 0; i < numFollowers; ++i) {
-      FreeNode(idx, followerNodes[i]);
+      FreeNode(part, followerNodes[i]);
     }
   }
 
   numAllocated = NodeNumAllocated(node);
 #if TRI_FULLTEXT_DEBUG
-  idx->_memoryFollowers -= MemorySubNodeList(numAllocated);
+  part->_memoryFollowers -= MemorySubNodeList(numAllocated);
 #endif
-  FreeMemory(idx, node->_followers, MemorySubNodeList(numAllocated));
+  FreeMemory(part, node->_followers, MemorySubNodeList(numAllocated));
 
   node->_followers = NULL;
 }
@@ -604,27 +639,27 @@ static void FreeFollowers (index_t* const idx, node_t* node) {
 /// @brief free a node in the index
 ////////////////////////////////////////////////////////////////////////////////
 
-static void FreeNode (index_t* const idx, node_t* node) {
+static void FreeNode (partition_t* const part, node_t* node) {
   if (node == NULL) {
     return;
   }
 
   if (node->_handles != NULL) {
     // free handles
-    idx->_memoryAllocated -= TRI_MemoryListFulltextIndex(node->_handles);
+    part->_memoryAllocated -= TRI_MemoryListFulltextIndex(node->_handles);
     TRI_FreeListFulltextIndex(node->_handles);
   }
 
   // free followers
   if (node->_followers != NULL) {
-    FreeFollowers(idx, node);
+    FreeFollowers(part, node);
   }
 
   // free node itself
-  FreeMemory(idx, node, sizeof(node_t));
+  FreeMemory(part, node, sizeof(node_t));
 #if TRI_FULLTEXT_DEBUG
-  idx->_memoryNodes -= sizeof(node_t);
-  idx->_nodesAllocated--;
+  part->_memoryNodes -= sizeof(node_t);
+  part->_nodesAllocated--;
 #endif
 }
 
@@ -633,7 +668,7 @@ static void FreeNode (index_t* const idx, node_t* node) {
 /// the map contains a rewrite-map of document handles
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool CleanupNodes (index_t* idx,
+static bool CleanupNodes (partition_t* part,
                           node_t* node,
                           void* map) {
   bool isActive;
@@ -670,9 +705,9 @@ static bool CleanupNodes (index_t* idx,
 #endif
 
       // recursively clean up sub-nodes
-      if (! CleanupNodes(idx, follower, map)) {
+      if (! CleanupNodes(part, follower, map)) {
         // the sub-node is empty, kill it!
-        FreeNode(idx, follower);
+        FreeNode(part, follower);
         // and go to next follower
         continue;
       }
@@ -696,7 +731,7 @@ static bool CleanupNodes (index_t* idx,
     if (i != j) {
       // number of followers has changed
       // this might delete the memory for the followers!
-      SetNodeNumFollowers(idx, node, j);
+      SetNodeNumFollowers(part, node, j);
     }
   }
 
@@ -712,7 +747,7 @@ static bool CleanupNodes (index_t* idx,
     }
     else {
       // no handles left, we can delete the node's handle list
-      idx->_memoryAllocated -= TRI_MemoryListFulltextIndex(node->_handles);
+      part->_memoryAllocated -= TRI_MemoryListFulltextIndex(node->_handles);
       TRI_FreeListFulltextIndex(node->_handles);
       node->_handles = NULL;
 
@@ -875,17 +910,17 @@ static inline node_t* FindDirectSubNode (const node_t* const node,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief find a node by its key, starting from the index root
+/// @brief find a node by its key, starting from the partition root
 ////////////////////////////////////////////////////////////////////////////////
 
-static node_t* FindNode (const index_t* idx,
+static node_t* FindNode (const partition_t* part,
                          const char* const key,
                          const size_t keyLength) {
   node_t* node;
   node_char_t* p;
   size_t i;
 
-  node = (node_t*) idx->_root;
+  node = (node_t*) part->_root;
 #if TRI_FULLTEXT_DEBUG
   TRI_ASSERT(node != NULL);
 #endif
@@ -973,7 +1008,7 @@ static inline TRI_fulltext_list_t* GetSubNodeHandles (const node_t* const node)
 /// the _followers property
 ////////////////////////////////////////////////////////////////////////////////
 
-static node_t* InsertSubNode (index_t* const idx,
+static node_t* InsertSubNode (partition_t* const part,
                               node_t* const node,
                               const uint32_t position,
                               const node_char_t key) {
@@ -988,7 +1023,7 @@ static node_t* InsertSubNode (index_t* const idx,
 #endif
 
   // create the sub-node
-  subNode = CreateNode(idx);
+  subNode = CreateNode(part);
   if (subNode == NULL) {
     // out of memory
     return NULL;
@@ -1014,7 +1049,7 @@ static node_t* InsertSubNode (index_t* const idx,
   // register the new sub node
   followerNodes[position] = subNode;
   followerKeys[position]  = key;
-  SetNodeNumFollowers(idx, node, numFollowers + 1);
+  SetNodeNumFollowers(part, node, numFollowers + 1);
 
   return subNode;
 }
@@ -1024,7 +1059,7 @@ static node_t* InsertSubNode (index_t* const idx,
 /// if it is not there, it will be created by this function
 ////////////////////////////////////////////////////////////////////////////////
 
-static node_t* EnsureSubNode (index_t* const idx,
+static node_t* EnsureSubNode (partition_t* const part,
                               node_t* node,
                               const node_char_t c) {
   uint32_t numFollowers;
@@ -1083,7 +1118,7 @@ static node_t* EnsureSubNode (index_t* const idx,
   // we'll be doing an insert. make sure the node has enough space for containing
   // a list with one element more
   if (numFollowers >= numAllocated) {
-    if (! ExtendSubNodeList(idx, node, numFollowers, numAllocated)) {
+    if (! ExtendSubNodeList(part, node, numFollowers, numAllocated)) {
       // out of memory
       return NULL;
     }
@@ -1093,14 +1128,14 @@ static node_t* EnsureSubNode (index_t* const idx,
   TRI_ASSERT(node->_followers != NULL);
 #endif
 
-  return InsertSubNode(idx, node, i, c);
+  return InsertSubNode(part, node, i, c);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// insert a handle for a node
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool InsertHandle (index_t* const idx,
+static bool InsertHandle (partition_t* const part,
                           node_t* const node,
                           const TRI_fulltext_handle_t handle) {
   TRI_fulltext_list_t* list;
@@ -1113,10 +1148,10 @@ static bool InsertHandle (index_t* const idx,
 
   if (node->_handles == NULL) {
     // node does not yet have any handles. now allocate a new chunk of handles
-    node->_handles = TRI_CreateListFulltextIndex(idx->_initialNodeHandles);
+    node->_handles = TRI_CreateListFulltextIndex(part->_initialNodeHandles);
 
     if (node->_handles != NULL) {
-      idx->_memoryAllocated += TRI_MemoryListFulltextIndex(node->_handles);
+      part->_memoryAllocated += TRI_MemoryListFulltextIndex(node->_handles);
     }
   }
 
@@ -1138,16 +1173,77 @@ static bool InsertHandle (index_t* const idx,
   if (list != oldList) {
     // the insert might have changed the pointer
     node->_handles = list;
-    idx->_memoryAllocated += TRI_MemoryListFulltextIndex(list);
-    idx->_memoryAllocated -= oldAlloc;
+    part->_memoryAllocated += TRI_MemoryListFulltextIndex(list);
+    part->_memoryAllocated -= oldAlloc;
   }
 
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the partition for a word with the given first byte
+////////////////////////////////////////////////////////////////////////////////
+
+static inline partition_t* GetPartition (index_t* const idx,
+                                         const node_char_t c) {
+  return &idx->_partitions[c % NUM_PARTITIONS];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free the nodes and locks of the first numPartitions partitions
+////////////////////////////////////////////////////////////////////////////////
+
+static void DestroyPartitions (index_t* const idx,
+                               const size_t numPartitions) {
+  size_t i;
+
+  for (i = 0; i < numPartitions; ++i) {
+    partition_t* part = &idx->_partitions[i];
+
+    // free root node (this will recursively free all other nodes)
+    FreeNode(part, part->_root);
+    part->_root = NULL;
+
+#if TRI_FULLTEXT_DEBUG
+    TRI_ASSERT(part->_memoryFollowers == 0);
+    TRI_ASSERT(part->_memoryNodes == 0);
+    TRI_ASSERT(part->_memoryAllocated == 0);
+#endif
+
+    TRI_DestroyReadWriteLock(&part->_lock);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get a new handle for a document
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_fulltext_handle_t InsertDocumentHandle (index_t* const idx,
+                                                   const TRI_fulltext_doc_t document) {
+  TRI_fulltext_handle_t handle;
+
+  TRI_WriteLockReadWriteLock(&idx->_handlesLock);
+  handle = TRI_InsertHandleFulltextIndex(idx->_handles, document);
+  TRI_WriteUnlockReadWriteLock(&idx->_handlesLock);
+
+  return handle;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief mark a document as deleted
+////////////////////////////////////////////////////////////////////////////////
+
+static void DeleteDocumentHandle (index_t* const idx,
+                                  const TRI_fulltext_doc_t document) {
+  TRI_WriteLockReadWriteLock(&idx->_handlesLock);
+  TRI_DeleteDocumentHandleFulltextIndex(idx->_handles, document);
+  TRI_WriteUnlockReadWriteLock(&idx->_handlesLock);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// turn a handle list into a proper document list result
 /// this will also exclude all deleted documents
+/// the caller must hold the index's _lock
 ////////////////////////////////////////////////////////////////////////////////
 
 static TRI_fulltext_result_t* MakeListResult (index_t* const idx,
@@ -1173,6 +1269,8 @@ static TRI_fulltext_result_t* MakeListResult (index_t* const idx,
   pos = 0;
   listEntries = TRI_StartListFulltextIndex(list);
 
+  TRI_ReadLockReadWriteLock(&idx->_handlesLock);
+
   for (i = 0; i < numResults; ++i) {
     TRI_fulltext_handle_t handle;
     TRI_fulltext_doc_t doc;
@@ -1188,6 +1286,8 @@ static TRI_fulltext_result_t* MakeListResult (index_t* const idx,
     result->_documents[pos++] = doc;
   }
 
+  TRI_ReadUnlockReadWriteLock(&idx->_handlesLock);
+
   result->_numDocuments = pos;
 
   // don't need the list anymore
@@ -1197,23 +1297,50 @@ static TRI_fulltext_result_t* MakeListResult (index_t* const idx,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief find all documents from the index that match the key
+/// @brief create a list with the handles of all documents matching the key
+/// this will read-lock the partition of the key. the empty prefix matches the
+/// words of all partitions
+/// the caller must hold the index's _lock
 ////////////////////////////////////////////////////////////////////////////////
 
-TRI_fulltext_result_t* FindDocuments (index_t* const idx,
-                                      const char* const key,
-                                      const size_t keyLength,
-                                      const bool recursive) {
+static TRI_fulltext_list_t* FindHandles (index_t* const idx,
+                                         const char* const key,
+                                         const size_t keyLength,
+                                         const bool recursive) {
+  partition_t* part;
   node_t* node;
   TRI_fulltext_list_t* list;
 
-  node = FindNode(idx, key, keyLength);
-  if (node == NULL) {
-    // not found, create empty result
-    return TRI_CreateResultFulltextIndex(0);
+  if (keyLength == 0 && recursive) {
+    size_t i;
+
+    list = NULL;
+
+    for (i = 0; i < NUM_PARTITIONS; ++i) {
+      part = &idx->_partitions[i];
+
+      TRI_ReadLockReadWriteLock(&part->_lock);
+      list = TRI_UnioniseListFulltextIndex(list, GetSubNodeHandles(part->_root));
+      TRI_ReadUnlockReadWriteLock(&part->_lock);
+
+      if (list == NULL) {
+        return NULL;
+      }
+    }
+
+    return list;
   }
 
-  if (recursive) {
+  part = GetPartition(idx, keyLength > 0 ? (node_char_t) *key : 0);
+
+  TRI_ReadLockReadWriteLock(&part->_lock);
+
+  node = FindNode(part, key, keyLength);
+  if (node == NULL) {
+    // not found, create empty list
+    list = TRI_CreateListFulltextIndex(0);
+  }
+  else if (recursive) {
     // prefix matching
     list = GetSubNodeHandles(node);
   }
@@ -1222,7 +1349,26 @@ TRI_fulltext_result_t* FindDocuments (index_t* const idx,
     list = GetDirectNodeHandles(node);
   }
 
-  return MakeListResult(idx, list);
+  TRI_ReadUnlockReadWriteLock(&part->_lock);
+
+  return list;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief find all documents from the index that match the key
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_fulltext_result_t* FindDocuments (index_t* const idx,
+                                      const char* const key,
+                                      const size_t keyLength,
+                                      const bool recursive) {
+  TRI_fulltext_result_t* result;
+
+  TRI_ReadLockReadWriteLock(&idx->_lock);
+  result = MakeListResult(idx, FindHandles(idx, key, keyLength, recursive));
+  TRI_ReadUnlockReadWriteLock(&idx->_lock);
+
+  return result;
 }
 
 // -----------------------------------------------------------------------------
@@ -1244,6 +1390,124 @@ static inline size_t CommonPrefixLength (const char* const lhs,
   return length;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the end of the run of words starting at position start that
+/// have the same first byte. all words of a run belong to the same partition
+/// the wordlist must be sorted
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint32_t EndOfRun (const TRI_fulltext_wordlist_t* const wordlist,
+                                 const uint32_t start) {
+  node_char_t first = (node_char_t) wordlist->_words[start][0];
+  uint32_t end = start + 1;
+
+  while (end < wordlist->_numWords && (node_char_t) wordlist->_words[end][0] == first) {
+    ++end;
+  }
+
+  return end;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                               insertion functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief insert the words [from, to) of a sorted wordlist into a partition
+/// the caller must hold the write lock of the partition
+///
+/// the wordlist is sorted so we can
+/// - filter out duplicates on insertion
+/// - save redundant lookups of prefix nodes for adjacent words with shared
+///   prefixes
+////////////////////////////////////////////////////////////////////////////////
+
+static bool InsertWords (partition_t* const part,
+                         const TRI_fulltext_handle_t handle,
+                         const TRI_fulltext_wordlist_t* const wordlist,
+                         const uint32_t from,
+                         const uint32_t to) {
+  node_t* paths[MAX_WORD_BYTES + 4];
+  size_t lastLength;
+  uint32_t w;
+
+  // if words are all different, we must start from the root node. the root node is also the
+  // start for the 1st word inserted
+  paths[0] = part->_root;
+  lastLength = 0;
+
+  w = from;
+  while (w < to) {
+    node_t* node;
+    char* p;
+    size_t start;
+    size_t i;
+
+    // LOG_DEBUG("checking word %s", wordlist->_words[w]);
+
+    if (w > from) {
+      // check if current word has a shared/common prefix with the previous word inserted
+      // in case this is true, we can use an optimisation and do not need to traverse the
+      // tree from the root again. instead, we just start at the node at the end of the
+      // shared/common prefix. this will save us a lot of tree lookups
+      start = CommonPrefixLength(wordlist->_words[w - 1], wordlist->_words[w]);
+      if (start > MAX_WORD_BYTES) {
+        start = MAX_WORD_BYTES;
+      }
+
+      // check if current word is the same as the last word. we do not want to insert the
+      // same word multiple times for the same document
+      if (start > 0 && start == lastLength && start == strlen(wordlist->_words[w])) {
+        // duplicate word, skip it and continue with next word
+        w++;
+        continue;
+      }
+    }
+    else {
+      start = 0;
+    }
+
+    // for words with common prefixes, use the most appropriate start node we
+    // do not need to traverse the tree from the root again
+    node = paths[start];
+#if TRI_FULLTEXT_DEBUG
+    TRI_ASSERT(node != NULL);
+#endif
+
+    // now insert into the tree, starting at the next character after the common prefix
+    p = wordlist->_words[w++] + start;
+
+    for (i = start; *p && i <= MAX_WORD_BYTES; ++i) {
+      node_char_t c = (node_char_t) *(p++);
+
+#if TRI_FULLTEXT_DEBUG
+      TRI_ASSERT(node != NULL);
+#endif
+
+      node = EnsureSubNode(part, node, c);
+      if (node == NULL) {
+        return false;
+      }
+
+#if TRI_FULLTEXT_DEBUG
+  TRI_ASSERT(node != NULL);
+#endif
+
+      paths[i + 1] = node;
+    }
+
+    if (! InsertHandle(part, node, handle)) {
+      return false;
+    }
+
+    // store length of word just inserted
+    // we'll use that to compare with the next word for duplicate removal
+    lastLength = i;
+  }
+
+  return true;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                        constructors / destructors
 // -----------------------------------------------------------------------------
@@ -1256,6 +1520,7 @@ TRI_fts_index_t* TRI_CreateFtsIndex (uint32_t handleChunkSize,
                                      uint32_t nodeChunkSize,
                                      uint32_t initialNodeHandles) {
   index_t* idx = static_cast<index_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(index_t), false));
+  size_t i;
 
   if (idx == NULL) {
     return NULL;
@@ -1264,28 +1529,39 @@ TRI_fts_index_t* TRI_CreateFtsIndex (uint32_t handleChunkSize,
   idx->_memoryAllocated    = sizeof(index_t);
 #if TRI_FULLTEXT_DEBUG
   idx->_memoryBase         = sizeof(index_t);
-  idx->_memoryNodes        = 0;
-  idx->_memoryFollowers    = 0;
-  idx->_nodesAllocated     = 0;
 #endif
-  // how many followers to allocate at once
-  idx->_nodeChunkSize      = nodeChunkSize;
-  // how many handles to create per node by default
-  idx->_initialNodeHandles = initialNodeHandles;
-
-  // create the root node
-  idx->_root               = CreateNode(idx);
-  if (idx->_root == NULL) {
-    // out of memory
-    TRI_Free(TRI_UNKNOWN_MEM_ZONE, idx);
-    return NULL;
+
+  for (i = 0; i < NUM_PARTITIONS; ++i) {
+    partition_t* part = &idx->_partitions[i];
+
+    part->_memoryAllocated    = 0;
+#if TRI_FULLTEXT_DEBUG
+    part->_memoryNodes        = 0;
+    part->_memoryFollowers    = 0;
+    part->_nodesAllocated     = 0;
+#endif
+    // how many followers to allocate at once
+    part->_nodeChunkSize      = nodeChunkSize;
+    // how many handles to create per node by default
+    part->_initialNodeHandles = initialNodeHandles;
+
+    // create the root node
+    part->_root               = CreateNode(part);
+    if (part->_root == NULL) {
+      // out of memory
+      DestroyPartitions(idx, i);
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, idx);
+      return NULL;
+    }
+
+    TRI_InitReadWriteLock(&part->_lock);
   }
 
   // create an instance for managing document handles
   idx->_handles = TRI_CreateHandlesFulltextIndex(handleChunkSize);
   if (idx->_handles == NULL) {
     // out of memory
-    TRI_Free(TRI_UNKNOWN_MEM_ZONE, idx->_root);
+    DestroyPartitions(idx, NUM_PARTITIONS);
     TRI_Free(TRI_UNKNOWN_MEM_ZONE, idx);
     return NULL;
   }
@@ -1296,6 +1572,7 @@ TRI_fts_index_t* TRI_CreateFtsIndex (uint32_t handleChunkSize,
 #endif
 
   TRI_InitReadWriteLock(&idx->_lock);
+  TRI_InitReadWriteLock(&idx->_handlesLock);
 
   return (TRI_fts_index_t*) idx;
 }
@@ -1307,8 +1584,8 @@ TRI_fts_index_t* TRI_CreateFtsIndex (uint32_t handleChunkSize,
 void TRI_FreeFtsIndex (TRI_fts_index_t* ftx) {
   index_t* idx = (index_t*) ftx;
 
-  // free root node (this will recursively free all other nodes)
-  FreeNode(idx, idx->_root);
+  // free all nodes
+  DestroyPartitions(idx, NUM_PARTITIONS);
 
   // free handles
   TRI_FreeHandlesFulltextIndex(idx->_handles);
@@ -1318,11 +1595,10 @@ void TRI_FreeFtsIndex (TRI_fts_index_t* ftx) {
 #if TRI_FULLTEXT_DEBUG
   idx->_memoryBase -= sizeof(TRI_fulltext_handles_t);
   TRI_ASSERT(idx->_memoryBase == sizeof(index_t));
-  TRI_ASSERT(idx->_memoryFollowers == 0);
-  TRI_ASSERT(idx->_memoryNodes == 0);
   TRI_ASSERT(idx->_memoryAllocated == sizeof(index_t));
 #endif
 
+  TRI_DestroyReadWriteLock(&idx->_handlesLock);
   TRI_DestroyReadWriteLock(&idx->_lock);
 
   // free index itself
@@ -1341,9 +1617,9 @@ void TRI_DeleteDocumentFulltextIndex (TRI_fts_index_t* const ftx,
                                       const TRI_fulltext_doc_t document) {
   index_t* idx = (index_t*) ftx;
 
-  TRI_WriteLockReadWriteLock(&idx->_lock);
-  TRI_DeleteDocumentHandleFulltextIndex(idx->_handles, document);
-  TRI_WriteUnlockReadWriteLock(&idx->_lock);
+  TRI_ReadLockReadWriteLock(&idx->_lock);
+  DeleteDocumentHandle(idx, document);
+  TRI_ReadUnlockReadWriteLock(&idx->_lock);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1357,6 +1633,7 @@ bool TRI_InsertWordFulltextIndex (TRI_fts_index_t* const ftx,
                                   const char* const key,
                                   const size_t keyLength) {
   index_t* idx;
+  partition_t* part;
   TRI_fulltext_handle_t handle;
   node_t* node;
   char* p;
@@ -1366,15 +1643,19 @@ bool TRI_InsertWordFulltextIndex (TRI_fts_index_t* const ftx,
 
   idx = (index_t*) ftx;
 
-  TRI_WriteLockReadWriteLock(&idx->_lock);
+  TRI_ReadLockReadWriteLock(&idx->_lock);
   // get a new handle for the document
-  handle = TRI_InsertHandleFulltextIndex(idx->_handles, document);
+  handle = InsertDocumentHandle(idx, document);
   if (handle == 0) {
-    TRI_WriteUnlockReadWriteLock(&idx->_lock);
+    TRI_ReadUnlockReadWriteLock(&idx->_lock);
     return false;
   }
 
-  node = idx->_root;
+  part = GetPartition(idx, keyLength > 0 ? (node_char_t) *key : 0);
+
+  TRI_WriteLockReadWriteLock(&part->_lock);
+
+  node = part->_root;
 #if TRI_FULLTEXT_DEBUG
   TRI_ASSERT(node != NULL);
 #endif
@@ -1386,22 +1667,28 @@ bool TRI_InsertWordFulltextIndex (TRI_fts_index_t* const ftx,
     end = MAX_WORD_BYTES;
   }
 
+  result = true;
+
   for (i = 0; i < end; ++i) {
     node_char_t c = (node_char_t) *(p++);
 
-    node = EnsureSubNode(idx, node, c);
+    node = EnsureSubNode(part, node, c);
     if (node == NULL) {
-      TRI_WriteUnlockReadWriteLock(&idx->_lock);
-      return false;
+      result = false;
+      break;
     }
   }
 
+  if (result) {
 #if TRI_FULLTEXT_DEBUG
-  TRI_ASSERT(node != NULL);
+    TRI_ASSERT(node != NULL);
 #endif
 
-  result = InsertHandle(idx, node, handle);
-  TRI_WriteUnlockReadWriteLock(&idx->_lock);
+    result = InsertHandle(part, node, handle);
+  }
+
+  TRI_WriteUnlockReadWriteLock(&part->_lock);
+  TRI_ReadUnlockReadWriteLock(&idx->_lock);
 
   return result;
 }
@@ -1416,6 +1703,7 @@ bool TRI_InsertWordFulltextIndex (TRI_fts_index_t* const ftx,
 /// - filter out duplicates on insertion
 /// - save redundant lookups of prefix nodes for adjacent words with shared
 ///   prefixes
+/// - insert all words of a partition with a single lock acquisition
 ////////////////////////////////////////////////////////////////////////////////
 
 bool TRI_InsertWordsFulltextIndex (TRI_fts_index_t* const ftx,
@@ -1423,9 +1711,8 @@ bool TRI_InsertWordsFulltextIndex (TRI_fts_index_t* const ftx,
                                    TRI_fulltext_wordlist_t* wordlist) {
   index_t* idx;
   TRI_fulltext_handle_t handle;
-  node_t* paths[MAX_WORD_BYTES + 4];
-  size_t lastLength;
-  size_t w;
+  uint32_t w;
+  bool result;
 
   if (wordlist->_numWords == 0) {
     return true;
@@ -1437,96 +1724,164 @@ bool TRI_InsertWordsFulltextIndex (TRI_fts_index_t* const ftx,
 
   idx = (index_t*) ftx;
 
-  TRI_WriteLockReadWriteLock(&idx->_lock);
+  TRI_ReadLockReadWriteLock(&idx->_lock);
 
   // get a new handle for the document
-  handle = TRI_InsertHandleFulltextIndex(idx->_handles, document);
+  handle = InsertDocumentHandle(idx, document);
   if (handle == 0) {
-    TRI_WriteUnlockReadWriteLock(&idx->_lock);
+    TRI_ReadUnlockReadWriteLock(&idx->_lock);
     return false;
   }
 
-  // if words are all different, we must start from the root node. the root node is also the
-  // start for the 1st word inserted
-  paths[0] = idx->_root;
-  lastLength = 0;
+  result = true;
 
+  // words with the same first byte are adjacent in the sorted wordlist and
+  // belong to the same partition
   w = 0;
   while (w < wordlist->_numWords) {
-    node_t* node;
-    char* p;
-    size_t start;
-    size_t i;
+    partition_t* part = GetPartition(idx, (node_char_t) wordlist->_words[w][0]);
+    uint32_t end = EndOfRun(wordlist, w);
 
-    // LOG_DEBUG("checking word %s", wordlist->_words[w]);
+    TRI_WriteLockReadWriteLock(&part->_lock);
+    result = InsertWords(part, handle, wordlist, w, end);
+    TRI_WriteUnlockReadWriteLock(&part->_lock);
 
-    if (w > 0) {
-      // check if current word has a shared/common prefix with the previous word inserted
-      // in case this is true, we can use an optimisation and do not need to traverse the
-      // tree from the root again. instead, we just start at the node at the end of the
-      // shared/common prefix. this will save us a lot of tree lookups
-      start = CommonPrefixLength(wordlist->_words[w - 1], wordlist->_words[w]);
-      if (start > MAX_WORD_BYTES) {
-        start = MAX_WORD_BYTES;
-      }
+    if (! result) {
+      // document was added at least once, mark it as deleted
+      DeleteDocumentHandle(idx, document);
+      break;
+    }
 
-      // check if current word is the same as the last word. we do not want to insert the
-      // same word multiple times for the same document
-      if (start > 0 && start == lastLength && start == strlen(wordlist->_words[w])) {
-        // duplicate word, skip it and continue with next word
-        w++;
-        continue;
+    w = end;
+  }
+
+  TRI_ReadUnlockReadWriteLock(&idx->_lock);
+
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief insert many documents with their wordlists into the index
+///
+/// the handles for all documents are created at once, and each partition is
+/// locked only once to insert the words of all documents that belong to it.
+/// if a thread pool is given, the wordlists are sorted and the partitions
+/// are filled in parallel. the same restrictions for the wordlists apply as
+/// for TRI_InsertWordsFulltextIndex, and the wordlists are sorted in place
+/// if inserting fails, all documents are marked as deleted
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_InsertDocumentsFulltextIndex (TRI_fts_index_t* const ftx,
+                                      std::vector<std::pair<TRI_fulltext_doc_t, TRI_fulltext_wordlist_t*>> const& documents,
+                                      triagens::basics::ThreadPool* pool) {
+  index_t* idx = (index_t*) ftx;
+  size_t const n = documents.size();
+  std::vector<TRI_fulltext_handle_t> handles;
+
+  try {
+    handles.resize(n, 0);
+  }
+  catch (...) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  // calls the function for each partition, in parallel if possible
+  auto forEachPartition = [&pool] (std::function<int(size_t)> const& func) -> int {
+    if (pool != nullptr) {
+      return pool->parallelFor(NUM_PARTITIONS, func);
+    }
+
+    for (size_t i = 0; i < NUM_PARTITIONS; ++i) {
+      int res = func(i);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
       }
     }
-    else {
-      start = 0;
+
+    return TRI_ERROR_NO_ERROR;
+  };
+
+  // sort the wordlists, in chunks of documents
+  forEachPartition([&] (size_t chunk) -> int {
+    size_t const end = (chunk + 1) * n / NUM_PARTITIONS;
+
+    for (size_t i = chunk * n / NUM_PARTITIONS; i < end; ++i) {
+      TRI_SortWordlistFulltextIndex(documents[i].second);
     }
 
-    // for words with common prefixes, use the most appropriate start node we
-    // do not need to traverse the tree from the root again
-    node = paths[start];
-#if TRI_FULLTEXT_DEBUG
-    TRI_ASSERT(node != NULL);
-#endif
+    return TRI_ERROR_NO_ERROR;
+  });
 
-    // now insert into the tree, starting at the next character after the common prefix
-    p = wordlist->_words[w++] + start;
+  int res = TRI_ERROR_NO_ERROR;
 
-    for (i = start; *p && i <= MAX_WORD_BYTES; ++i) {
-      node_char_t c = (node_char_t) *(p++);
+  TRI_ReadLockReadWriteLock(&idx->_lock);
 
-#if TRI_FULLTEXT_DEBUG
-      TRI_ASSERT(node != NULL);
-#endif
+  // get new handles for all documents that have words
+  TRI_WriteLockReadWriteLock(&idx->_handlesLock);
 
-      node = EnsureSubNode(idx, node, c);
-      if (node == NULL) {
-        TRI_WriteUnlockReadWriteLock(&idx->_lock);
-        return false;
-      }
+  for (size_t i = 0; i < n; ++i) {
+    if (documents[i].second->_numWords == 0) {
+      continue;
+    }
 
-#if TRI_FULLTEXT_DEBUG
-  TRI_ASSERT(node != NULL);
-#endif
+    handles[i] = TRI_InsertHandleFulltextIndex(idx->_handles, documents[i].first);
 
-      paths[i + 1] = node;
+    if (handles[i] == 0) {
+      res = TRI_ERROR_OUT_OF_MEMORY;
+      break;
     }
+  }
 
-    if (! InsertHandle(idx, node, handle)) {
-      // document was added at least once, mark it as deleted
-      TRI_DeleteDocumentHandleFulltextIndex(idx->_handles, document);
-      TRI_WriteUnlockReadWriteLock(&idx->_lock);
-      return false;
+  TRI_WriteUnlockReadWriteLock(&idx->_handlesLock);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = forEachPartition([&] (size_t i) -> int {
+      partition_t* part = &idx->_partitions[i];
+      int result = TRI_ERROR_NO_ERROR;
+
+      TRI_WriteLockReadWriteLock(&part->_lock);
+
+      for (size_t j = 0; j < n && result == TRI_ERROR_NO_ERROR; ++j) {
+        TRI_fulltext_wordlist_t const* wordlist = documents[j].second;
+        uint32_t w = 0;
+
+        // only insert the runs of words that belong to this partition
+        while (w < wordlist->_numWords) {
+          uint32_t end = EndOfRun(wordlist, w);
+
+          if (GetPartition(idx, (node_char_t) wordlist->_words[w][0]) == part &&
+              ! InsertWords(part, handles[j], wordlist, w, end)) {
+            result = TRI_ERROR_OUT_OF_MEMORY;
+            break;
+          }
+
+          w = end;
+        }
+      }
+
+      TRI_WriteUnlockReadWriteLock(&part->_lock);
+
+      return result;
+    });
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    // documents may have been added partially, mark them as deleted
+    TRI_WriteLockReadWriteLock(&idx->_handlesLock);
+
+    for (size_t i = 0; i < n; ++i) {
+      if (handles[i] != 0) {
+        TRI_DeleteDocumentHandleFulltextIndex(idx->_handles, documents[i].first);
+      }
     }
 
-    // store length of word just inserted
-    // we'll use that to compare with the next word for duplicate removal
-    lastLength = i;
+    TRI_WriteUnlockReadWriteLock(&idx->_handlesLock);
   }
 
-  TRI_WriteUnlockReadWriteLock(&idx->_lock);
+  TRI_ReadUnlockReadWriteLock(&idx->_lock);
 
-  return true;
+  return res;
 }
 
 // -----------------------------------------------------------------------------
@@ -1562,6 +1917,7 @@ TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
                                                TRI_fulltext_query_t* query) {
   index_t* idx;
   TRI_fulltext_list_t* result;
+  TRI_fulltext_result_t* documents;
   size_t i;
 
   if (query == NULL) {
@@ -1576,6 +1932,9 @@ TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
 
   idx = (index_t*) ftx;
 
+  // the index's lock keeps the handles stable between looking up the words
+  // (which only locks the word's partition) and converting the handles into
+  // documents
   TRI_ReadLockReadWriteLock(&idx->_lock);
 
   // initial result is empty
@@ -1587,7 +1946,6 @@ TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
     TRI_fulltext_query_match_e match;
     TRI_fulltext_query_operation_e operation;
     TRI_fulltext_list_t* list;
-    node_t* node;
 
     word      = query->_words[i];
     if (word == NULL) {
@@ -1605,23 +1963,16 @@ TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
       continue;
     }
 
-    list = NULL;
-    node = FindNode(idx, word, strlen(word));
-    if (node != NULL) {
-      if (match == TRI_FULLTEXT_COMPLETE) {
-        // complete matching
-        list = GetDirectNodeHandles(node);
-      }
-      else if (match == TRI_FULLTEXT_PREFIX) {
-        // prefix matching
-        list = GetSubNodeHandles(node);
-      }
-      else {
-        LOG_WARNING("invalid matching option for fulltext index query");
-        list = TRI_CreateListFulltextIndex(0);
-      }
+    if (match == TRI_FULLTEXT_COMPLETE) {
+      // complete matching
+      list = FindHandles(idx, word, strlen(word), false);
+    }
+    else if (match == TRI_FULLTEXT_PREFIX) {
+      // prefix matching
+      list = FindHandles(idx, word, strlen(word), true);
     }
     else {
+      LOG_WARNING("invalid matching option for fulltext index query");
       list = TRI_CreateListFulltextIndex(0);
     }
 
@@ -1644,18 +1995,21 @@ TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
     }
   }
 
-  TRI_ReadUnlockReadWriteLock(&idx->_lock);
-
   TRI_FreeQueryFulltextIndex(query);
 
   if (result == NULL) {
     // if we haven't found anything...
-    return TRI_CreateResultFulltextIndex(0);
+    documents = TRI_CreateResultFulltextIndex(0);
   }
+  else {
+    // now convert the handle list into a result (this will also filter out
+    // deleted documents)
+    documents = MakeListResult(idx, result);
+  }
+
+  TRI_ReadUnlockReadWriteLock(&idx->_lock);
 
-  // now convert the handle list into a result (this will also filter out
-  // deleted documents)
-  return MakeListResult(idx, result);
+  return documents;
 }
 
 // -----------------------------------------------------------------------------
@@ -1669,9 +2023,14 @@ TRI_fulltext_result_t* TRI_QueryFulltextIndex (TRI_fts_index_t* const ftx,
 #if TRI_FULLTEXT_DEBUG
 void TRI_DumpTreeFtsIndex (const TRI_fts_index_t* const ftx) {
   index_t* idx = (index_t*) ftx;
+  size_t i;
 
   TRI_DumpHandleFulltextIndex(idx->_handles);
-  DumpNode(idx->_root, 0);
+
+  for (i = 0; i < NUM_PARTITIONS; ++i) {
+    printf("partition %lu\n", (unsigned long) i);
+    DumpNode(idx->_partitions[i]._root, 0);
+  }
 }
 #endif
 
@@ -1721,12 +2080,26 @@ TRI_fulltext_stats_t TRI_StatsFulltextIndex (const TRI_fts_index_t* const ftx) {
 #if TRI_FULLTEXT_DEBUG
   stats._memoryOwn           = idx->_memoryAllocated;
   stats._memoryBase          = idx->_memoryBase;
-  stats._memoryNodes         = idx->_memoryNodes;
-  stats._memoryFollowers     = idx->_memoryFollowers;
-  stats._memoryDocuments     = idx->_memoryAllocated - idx->_memoryNodes - idx->_memoryBase;
-  stats._numNodes            = idx->_nodesAllocated;
+  stats._memoryNodes         = 0;
+  stats._memoryFollowers     = 0;
+  stats._numNodes            = 0;
+
+  for (size_t i = 0; i < NUM_PARTITIONS; ++i) {
+    partition_t* part = &idx->_partitions[i];
+
+    TRI_ReadLockReadWriteLock(&part->_lock);
+    stats._memoryOwn         += part->_memoryAllocated;
+    stats._memoryNodes       += part->_memoryNodes;
+    stats._memoryFollowers   += part->_memoryFollowers;
+    stats._numNodes          += part->_nodesAllocated;
+    TRI_ReadUnlockReadWriteLock(&part->_lock);
+  }
+
+  stats._memoryDocuments     = stats._memoryOwn - stats._memoryNodes - stats._memoryBase;
 #endif
 
+  TRI_ReadLockReadWriteLock(&idx->_handlesLock);
+
   if (idx->_handles != NULL) {
     stats._memoryHandles       = TRI_MemoryHandleFulltextIndex(idx->_handles);
     stats._numDocuments        = TRI_NumHandlesHandleFulltextIndex(idx->_handles);
@@ -1742,6 +2115,7 @@ TRI_fulltext_stats_t TRI_StatsFulltextIndex (const TRI_fts_index_t* const ftx) {
     stats._shouldCompact       = false;
   }
 
+  TRI_ReadUnlockReadWriteLock(&idx->_handlesLock);
   TRI_ReadUnlockReadWriteLock(&idx->_lock);
 
   return stats;
@@ -1753,12 +2127,26 @@ TRI_fulltext_stats_t TRI_StatsFulltextIndex (const TRI_fts_index_t* const ftx) {
 
 size_t TRI_MemoryFulltextIndex (const TRI_fts_index_t* const ftx) {
   index_t* idx = (index_t*) ftx;
+  size_t memory = idx->_memoryAllocated;
+  size_t i;
+
+  for (i = 0; i < NUM_PARTITIONS; ++i) {
+    partition_t* part = &idx->_partitions[i];
+
+    TRI_ReadLockReadWriteLock(&part->_lock);
+    memory += part->_memoryAllocated;
+    TRI_ReadUnlockReadWriteLock(&part->_lock);
+  }
+
+  TRI_ReadLockReadWriteLock(&idx->_handlesLock);
 
   if (idx->_handles != NULL) {
-    return idx->_memoryAllocated + TRI_MemoryHandleFulltextIndex(idx->_handles);
+    memory += TRI_MemoryHandleFulltextIndex(idx->_handles);
   }
 
-  return idx->_memoryAllocated;
+  TRI_ReadUnlockReadWriteLock(&idx->_handlesLock);
+
+  return memory;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1769,11 +2157,14 @@ size_t TRI_MemoryFulltextIndex (const TRI_fts_index_t* const ftx) {
 bool TRI_CompactFulltextIndex (TRI_fts_index_t* const ftx) {
   index_t* idx;
   TRI_fulltext_handles_t* clone;
+  size_t i;
 
   idx = (index_t*) ftx;
 
   // but don't block if the index is busy
-  // try to acquire the write lock to clean up
+  // try to acquire the write lock to clean up. this excludes all inserts,
+  // removals and queries, but not the memory usage calculation, which only
+  // locks the partitions and the handles
   if (! TRI_TryWriteLockReadWriteLock(&idx->_lock)) {
     return true;
   }
@@ -1794,7 +2185,15 @@ bool TRI_CompactFulltextIndex (TRI_fts_index_t* const ftx) {
     return false;
   }
 
-  CleanupNodes(idx, idx->_root, clone->_map);
+  for (i = 0; i < NUM_PARTITIONS; ++i) {
+    partition_t* part = &idx->_partitions[i];
+
+    TRI_WriteLockReadWriteLock(&part->_lock);
+    CleanupNodes(part, part->_root, clone->_map);
+    TRI_WriteUnlockReadWriteLock(&part->_lock);
+  }
+
+  TRI_WriteLockReadWriteLock(&idx->_handlesLock);
 
   // delete the original handle list
   TRI_FreeHandlesFulltextIndex(idx->_handles);
@@ -1805,6 +2204,7 @@ bool TRI_CompactFulltextIndex (TRI_fts_index_t* const ftx) {
 
   // cleanup finished, now switch over
   idx->_handles = clone;
+  TRI_WriteUnlockReadWriteLock(&idx->_handlesLock);
   TRI_WriteUnlockReadWriteLock(&idx->_lock);
 
   return true;
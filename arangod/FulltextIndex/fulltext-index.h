@@ -40,6 +40,12 @@ struct TRI_fulltext_query_s;
 struct TRI_fulltext_result_s;
 struct TRI_fulltext_wordlist_s;
 
+namespace triagens {
+  namespace basics {
+    class ThreadPool;
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                     public macros
 // -----------------------------------------------------------------------------
@@ -127,6 +133,16 @@ bool TRI_InsertWordsFulltextIndex (TRI_fts_index_t* const,
                                    const TRI_fulltext_doc_t,
                                    struct TRI_fulltext_wordlist_s*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief insert many documents with their lists of words into the index
+/// the partitions of the index are filled in parallel if a thread pool is
+/// given
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_InsertDocumentsFulltextIndex (TRI_fts_index_t* const,
+                                      std::vector<std::pair<TRI_fulltext_doc_t, struct TRI_fulltext_wordlist_s*>> const&,
+                                      triagens::basics::ThreadPool*);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   query functions
 // -----------------------------------------------------------------------------
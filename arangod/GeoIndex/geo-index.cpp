@@ -225,6 +225,38 @@ static bool ExtractDoubleList (TRI_shaper_t* shaper,
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extracts the coordinates of a document
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ExtractCoordinates (TRI_geo_index_t* geo,
+                                TRI_doc_mptr_t const* doc,
+                                double* latitude,
+                                double* longitude) {
+  TRI_shaped_json_t shapedJson;
+  TRI_shaper_t* shaper;
+  bool missing;
+  bool ok;
+
+  shaper = geo->base._collection->getShaper();  // ONLY IN INDEX, PROTECTED by RUNTIME
+  TRI_EXTRACT_SHAPED_JSON_MARKER(shapedJson, doc->getDataPtr());  // ONLY IN INDEX, PROTECTED by RUNTIME
+
+  if (geo->_location != 0) {
+    if (geo->_geoJson) {
+      ok = ExtractDoubleList(shaper, &shapedJson, geo->_location, longitude, latitude, &missing);
+    }
+    else {
+      ok = ExtractDoubleList(shaper, &shapedJson, geo->_location, latitude, longitude, &missing);
+    }
+  }
+  else {
+    ok = ExtractDoubleArray(shaper, &shapedJson, geo->_latitude, latitude, &missing);
+    ok = ok && ExtractDoubleArray(shaper, &shapedJson, geo->_longitude, longitude, &missing);
+  }
+
+  return ok;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the memory used by the index
 ////////////////////////////////////////////////////////////////////////////////
@@ -320,35 +352,16 @@ static int InsertGeoIndex (TRI_index_t* idx,
                            TRI_doc_mptr_t const* doc,
                            bool isRollback) {
   GeoCoordinate gc;
-  TRI_shaped_json_t shapedJson;
   TRI_geo_index_t* geo;
-  TRI_shaper_t* shaper;
-  bool missing;
-  bool ok;
   double latitude;
   double longitude;
   int res;
 
   geo = (TRI_geo_index_t*) idx;
-  shaper = geo->base._collection->getShaper();  // ONLY IN INDEX, PROTECTED by RUNTIME
 
   // lookup latitude and longitude
-  TRI_EXTRACT_SHAPED_JSON_MARKER(shapedJson, doc->getDataPtr());  // ONLY IN INDEX, PROTECTED by RUNTIME
-
-  if (geo->_location != 0) {
-    if (geo->_geoJson) {
-      ok = ExtractDoubleList(shaper, &shapedJson, geo->_location, &longitude, &latitude, &missing);
-    }
-    else {
-      ok = ExtractDoubleList(shaper, &shapedJson, geo->_location, &latitude, &longitude, &missing);
-    }
-  }
-  else {
-    ok = ExtractDoubleArray(shaper, &shapedJson, geo->_latitude, &latitude, &missing);
-    ok = ok && ExtractDoubleArray(shaper, &shapedJson, geo->_longitude, &longitude, &missing);
-  }
-
-  if (! ok) {
+  if (! ExtractCoordinates(geo, doc, &latitude, &longitude)) {
+    geo->_unindexed++;
     return TRI_ERROR_NO_ERROR;
   }
 
@@ -368,6 +381,7 @@ static int InsertGeoIndex (TRI_index_t* idx,
   }
   else if (res == -3) {
     LOG_DEBUG("illegal geo-coordinates, ignoring entry");
+    geo->_unindexed++;
     return TRI_ERROR_NO_ERROR;
   }
   else if (res < 0) {
@@ -385,36 +399,29 @@ static int RemoveGeoIndex (TRI_index_t* idx,
                            TRI_doc_mptr_t const* doc,
                            bool isRollback) {
   GeoCoordinate gc;
-  TRI_shaped_json_t shapedJson;
   TRI_geo_index_t* geo;
-  TRI_shaper_t* shaper;
-  bool missing;
-  bool ok;
   double latitude;
   double longitude;
 
   geo = (TRI_geo_index_t*) idx;
-  shaper = geo->base._collection->getShaper();  // ONLY IN INDEX, PROTECTED by RUNTIME
-  TRI_EXTRACT_SHAPED_JSON_MARKER(shapedJson, doc->getDataPtr());  // ONLY IN INDEX, PROTECTED by RUNTIME
 
-  // lookup OLD latitude and longitude
-  if (geo->_location != 0) {
-    ok = ExtractDoubleList(shaper, &shapedJson, geo->_location, &latitude, &longitude, &missing);
-  }
-  else {
-    ok = ExtractDoubleArray(shaper, &shapedJson, geo->_latitude, &latitude, &missing);
-    ok = ok && ExtractDoubleArray(shaper, &shapedJson, geo->_longitude, &longitude, &missing);
+  // lookup OLD latitude and longitude, in the same order as on insert
+  if (! ExtractCoordinates(geo, doc, &latitude, &longitude) ||
+      ! TRI_ValidCoordinatesGeoIndex(latitude, longitude)) {
+    // the document was not indexed
+    if (geo->_unindexed > 0) {
+      geo->_unindexed--;
+    }
+    return TRI_ERROR_NO_ERROR;
   }
 
   // and remove old entry
-  if (ok) {
-    gc.latitude = latitude;
-    gc.longitude = longitude;
-    gc.data = CONST_CAST(doc);
+  gc.latitude = latitude;
+  gc.longitude = longitude;
+  gc.data = CONST_CAST(doc);
 
-    // ignore non-existing elements in geo-index
-    GeoIndex_remove(geo->_geoIndex, &gc);
-  }
+  // ignore non-existing elements in geo-index
+  GeoIndex_remove(geo->_geoIndex, &gc);
 
   return TRI_ERROR_NO_ERROR;
 }
@@ -462,6 +469,7 @@ TRI_index_t* TRI_CreateGeo1Index (TRI_document_collection_t* document,
   geo->_latitude   = 0;
   geo->_longitude  = 0;
   geo->_geoJson    = geoJson;
+  geo->_unindexed  = 0;
 
   return idx;
 }
@@ -508,6 +516,7 @@ TRI_index_t* TRI_CreateGeo2Index (TRI_document_collection_t* document,
   geo->_location   = 0;
   geo->_latitude   = latitude;
   geo->_longitude  = longitude;
+  geo->_unindexed  = 0;
 
   return idx;
 }
@@ -539,6 +548,36 @@ void TRI_FreeGeoIndex (TRI_index_t* idx) {
 // --SECTION--                                                  public functions
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the coordinates of a document as seen by the index
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_CoordinatesGeoIndex (TRI_index_t* idx,
+                              TRI_doc_mptr_t const* doc,
+                              double* latitude,
+                              double* longitude) {
+  return ExtractCoordinates((TRI_geo_index_t*) idx, doc, latitude, longitude);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the index accepts the coordinates
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_ValidCoordinatesGeoIndex (double latitude,
+                                   double longitude) {
+  return (latitude >= -90.0 && latitude <= 90.0 &&
+          longitude >= -180.0 && longitude <= 180.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of documents that are not in the index because
+/// they have no valid coordinates
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_UnindexedGeoIndex (TRI_index_t* idx) {
+  return ((TRI_geo_index_t*) idx)->_unindexed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief looks up all points within a given radius
 ////////////////////////////////////////////////////////////////////////////////
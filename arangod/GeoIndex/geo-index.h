@@ -79,6 +79,29 @@ void TRI_FreeGeoIndex (TRI_index_t* idx);
 // --SECTION--                                                  public functions
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the coordinates of a document as seen by the index
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_CoordinatesGeoIndex (TRI_index_t* idx,
+                              struct TRI_doc_mptr_t const* doc,
+                              double* latitude,
+                              double* longitude);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the index accepts the coordinates
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_ValidCoordinatesGeoIndex (double latitude,
+                                   double longitude);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of documents that are not in the index because
+/// they have no valid coordinates
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_UnindexedGeoIndex (TRI_index_t* idx);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief looks up all points within a given radius
 ////////////////////////////////////////////////////////////////////////////////
@@ -236,6 +236,66 @@ triagens::basics::Json RestCursorHandler::buildExtra (triagens::aql::QueryResult
   return extra;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a streaming cursor and return the first results
+/// the cursor takes over the prepared query and will fetch further results
+/// from its execution engine when they are requested
+////////////////////////////////////////////////////////////////////////////////
+
+void RestCursorHandler::createStreamCursor (TRI_json_t const* queryString,
+                                            TRI_json_t const* bindVars,
+                                            triagens::basics::Json const& options) {
+  std::unique_ptr<triagens::aql::Query> query(new triagens::aql::Query(
+    _applicationV8, 
+    false, 
+    _vocbase, 
+    queryString->_value._string.data,
+    static_cast<size_t>(queryString->_value._string.length - 1),
+    (bindVars != nullptr ? TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, bindVars) : nullptr),
+    TRI_CopyJson(TRI_UNKNOWN_MEM_ZONE, options.json()), 
+    triagens::aql::PART_MAIN
+  ));
+
+  registerQuery(query.get()); 
+  auto queryResult = query->prepare(_queryRegistry);
+  unregisterQuery(); 
+
+  if (queryResult.code != TRI_ERROR_NO_ERROR) {
+    if (queryResult.code == TRI_ERROR_REQUEST_CANCELED ||
+        (queryResult.code == TRI_ERROR_QUERY_KILLED && wasCancelled())) {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_REQUEST_CANCELED);
+    }
+
+    THROW_ARANGO_EXCEPTION_MESSAGE(queryResult.code, queryResult.details);
+  }
+
+  _response = createResponse(HttpResponse::CREATED);
+  _response->setContentType("application/json; charset=utf-8");
+
+  auto cursors = static_cast<triagens::arango::CursorRepository*>(_vocbase->_cursorRepository);
+  TRI_ASSERT(cursors != nullptr);
+
+  size_t batchSize = triagens::basics::JsonHelper::getNumericValue<size_t>(options.json(), "batchSize", 1000);
+  double ttl = triagens::basics::JsonHelper::getNumericValue<double>(options.json(), "ttl", 30);
+
+  // cursor will take over the ownership of the query
+  triagens::arango::StreamCursor* cursor = cursors->createFromQuery(_queryRegistry, query.release(), batchSize, ttl); 
+
+  try {
+    _response->body().appendChar('{');
+    cursor->dump(_response->body());
+    _response->body().appendText(",\"error\":false,\"code\":");
+    _response->body().appendInteger(static_cast<uint32_t>(_response->responseCode()));
+    _response->body().appendChar('}');
+
+    cursors->release(cursor);
+  }
+  catch (...) {
+    cursors->release(cursor);
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @startDocuBlock JSF_post_api_cursor
 /// @brief create a cursor and return the first results
@@ -294,6 +354,30 @@ triagens::basics::Json RestCursorHandler::buildExtra (triagens::aql::QueryResult
 ///   specific rules. To disable a rule, prefix its name with a `-`, to enable a rule, prefix it
 ///   with a `+`. There is also a pseudo-rule `all`, which will match all optimizer rules.
 ///
+/// - *nativeExpressions*: if set to *false*, all expressions of the query will be
+///   evaluated with V8, even those that could be evaluated natively. This is meant
+///   for comparing the results and the performance of both implementations. The
+///   default value is *true*.
+///
+/// - *stream*: if set to *true*, the query results will not be computed completely
+///   before the first batch is returned. Instead, the server will keep the query
+///   running and compute the next batch of results only when it is requested.
+///   This keeps the memory usage of the server bounded and makes the first results
+///   available quickly, even for queries with big results. The *extra* attribute
+///   will then only be returned with the last batch of the cursor. The query's
+///   transaction (and thus its locks) will be held until the last batch was fetched
+///   or the cursor was deleted or timed out. Deleting or timing out an unfinished 
+///   streaming cursor will abort the query's transaction. The *stream* option
+///   is ignored if *count* is requested for the cursor.
+///
+/// - *cache*: if set to *false*, the query result cache will neither be used
+///   nor filled for this query. The option has no effect if the result cache
+///   is turned off (see *PUT /_api/query/result-cache*). Only results of 
+///   deterministic queries that do not modify data can be cached, and a cached
+///   result is dropped as soon as one of the involved collections is modified.
+///   Results of streaming queries and of queries using the *fullCount* or 
+///   *profile* options are never cached.
+///
 /// If the result set can be created by the server, the server will respond with
 /// *HTTP 201*. The body of the response will contain a JSON object with the
 /// result set.
@@ -320,6 +404,10 @@ triagens::basics::Json RestCursorHandler::buildExtra (triagens::aql::QueryResult
 ///   of modified documents and the number of documents that could not be modified
 ///   due to an error (if *ignoreErrors* query option is specified)
 ///
+/// - *cached*: a boolean flag indicating whether the query result was served
+///   from the query result cache. The result cache is turned off by default and
+///   can be bypassed for a single query by setting the *cache* option to *false*
+///
 /// If the JSON representation is malformed or the query specification is
 /// missing from the request, the server will respond with *HTTP 400*.
 ///
@@ -594,6 +682,14 @@ void RestCursorHandler::createCursor () {
     }
     
     auto options = buildOptions(json.get());
+
+    if (triagens::basics::JsonHelper::getBooleanValue(options.json(), "stream", false) &&
+        ! triagens::basics::JsonHelper::getBooleanValue(options.json(), "count", false)) {
+      // counting the results would require the full result, so results are 
+      // only streamed when no count was requested
+      createStreamCursor(queryString, bindVars, options);
+      return;
+    }
   
     triagens::aql::Query query(_applicationV8, 
                                false, 
@@ -660,6 +756,7 @@ void RestCursorHandler::createCursor () {
         }
       
         result.set("extra", extra);
+        result.set("cached", triagens::basics::Json(queryResult.cached));
         result.set("error", triagens::basics::Json(false));
         result.set("code", triagens::basics::Json(static_cast<double>(_response->responseCode())));
 
@@ -682,6 +779,7 @@ void RestCursorHandler::createCursor () {
       try {
         _response->body().appendChar('{');
         cursor->dump(_response->body());
+        _response->body().appendText(queryResult.cached ? ",\"cached\":true" : ",\"cached\":false");
         _response->body().appendText(",\"error\":false,\"code\":");
         _response->body().appendInteger(static_cast<uint32_t>(_response->responseCode()));
         _response->body().appendChar('}');
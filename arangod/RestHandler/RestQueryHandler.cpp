@@ -31,6 +31,8 @@
 
 #include "Aql/Query.h"
 #include "Aql/QueryList.h"
+#include "Aql/QueryPlanCache.h"
+#include "Aql/QueryResultCache.h"
 #include "Basics/StringUtils.h"
 #include "Basics/conversions.h"
 #include "Basics/json.h"
@@ -284,6 +286,154 @@ bool RestQueryHandler::readQuery (bool slow) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @startDocuBlock GetApiQueryPlanCache
+/// @brief returns the properties and statistics of the AQL query plan cache
+///
+/// @RESTHEADER{GET /_api/query/plan-cache, Returns the AQL query plan cache properties}
+///
+/// Optimized execution plans are cached per database, keyed by the query
+/// string, the bind parameters and the optimizer options. Repeated queries 
+/// with a cached plan skip parsing and optimization. Cached plans are
+/// removed when a collection they use is dropped, renamed or recreated, or
+/// when one of its indexes is created or dropped.
+///
+/// Bind parameter values are folded into the plan by the optimizer, so
+/// each combination of values gets a plan of its own. The cache is
+/// therefore disabled by default and should only be enabled for workloads
+/// that repeat queries with the same bind parameter values.
+///
+/// Returns a JSON object with the following properties:
+///
+/// - *enabled*: whether or not the plan cache is used.
+///
+/// - *maxEntries*: the maximum number of plans kept in the cache. If the
+///   cache is full, the least recently used plan is discarded.
+///
+/// - *entries*: the number of plans currently cached.
+///
+/// - *hits*: the number of queries that used a cached plan.
+///
+/// - *misses*: the number of queries that had to be planned because no
+///   cached plan was found.
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// Is returned when the properties can be retrieved successfully.
+///
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::readPlanCache () {
+  try {
+    auto planCache = static_cast<QueryPlanCache*>(_vocbase->_queryPlanCache);
+
+    Json result(Json::Object);
+
+    result
+    .set("error", Json(false))
+    .set("code", Json(HttpResponse::OK))
+    .set("enabled", Json(planCache->enabled()))
+    .set("maxEntries", Json(static_cast<double>(planCache->maxEntries())))
+    .set("entries", Json(static_cast<double>(planCache->size())))
+    .set("hits", Json(static_cast<double>(planCache->hits())))
+    .set("misses", Json(static_cast<double>(planCache->misses())));
+
+    generateResult(HttpResponse::OK, result.json());
+  }
+  catch (Exception const& err) {
+    handleError(err);
+  }
+  catch (std::exception const& ex) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, ex.what(), __FILE__, __LINE__);
+    handleError(err);
+  }
+  catch (...) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, __FILE__, __LINE__);
+    handleError(err);
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @startDocuBlock GetApiQueryResultCache
+/// @brief returns the properties and statistics of the AQL query result cache
+///
+/// @RESTHEADER{GET /_api/query/result-cache, Returns the AQL query result cache properties}
+///
+/// Results of deterministic read-only queries can be cached per database,
+/// keyed by the query string and the bind parameters. A cached result is
+/// returned without executing the query again, and the cursor response will
+/// then contain the attribute *cached* with a value of *true*. Cached results
+/// are removed as soon as one of the collections they were produced from is
+/// modified. The result cache is turned off by default.
+///
+/// Returns a JSON object with the following properties:
+///
+/// - *enabled*: whether or not the result cache is used.
+///
+/// - *maxEntries*: the maximum number of results kept in the cache. If the
+///   cache is full, the least recently used result is discarded.
+///
+/// - *maxResultSize*: the maximum size (in bytes) of a single serialized 
+///   result. Bigger results are not cached.
+///
+/// - *maxMemory*: the maximum total size (in bytes) of all cached results. 
+///
+/// - *entries*: the number of results currently cached.
+///
+/// - *memory*: the total size (in bytes) of the results currently cached.
+///
+/// - *hits*: the number of queries that were answered from the cache.
+///
+/// - *misses*: the number of cacheable queries that had to be executed 
+///   because no cached result was found.
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// Is returned when the properties can be retrieved successfully.
+///
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::readResultCache () {
+  try {
+    auto resultCache = static_cast<QueryResultCache*>(_vocbase->_queryResultCache);
+
+    Json result(Json::Object);
+
+    result
+    .set("error", Json(false))
+    .set("code", Json(HttpResponse::OK))
+    .set("enabled", Json(resultCache->enabled()))
+    .set("maxEntries", Json(static_cast<double>(resultCache->maxEntries())))
+    .set("maxResultSize", Json(static_cast<double>(resultCache->maxResultSize())))
+    .set("maxMemory", Json(static_cast<double>(resultCache->maxMemory())))
+    .set("entries", Json(static_cast<double>(resultCache->size())))
+    .set("memory", Json(static_cast<double>(resultCache->memoryUsage())))
+    .set("hits", Json(static_cast<double>(resultCache->hits())))
+    .set("misses", Json(static_cast<double>(resultCache->misses())));
+
+    generateResult(HttpResponse::OK, result.json());
+  }
+  catch (Exception const& err) {
+    handleError(err);
+  }
+  catch (std::exception const& ex) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, ex.what(), __FILE__, __LINE__);
+    handleError(err);
+  }
+  catch (...) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, __FILE__, __LINE__);
+    handleError(err);
+  }
+
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns AQL query tracking
 ////////////////////////////////////////////////////////////////////////////////
@@ -309,10 +459,16 @@ bool RestQueryHandler::readQuery () {
   else if (name == "properties") {
     return readQueryProperties();
   }
+  else if (name == "plan-cache") {
+    return readPlanCache();
+  }
+  else if (name == "result-cache") {
+    return readResultCache();
+  }
 
   generateError(HttpResponse::NOT_FOUND,
                 TRI_ERROR_HTTP_NOT_FOUND,
-                "unknown type '" + name + "', expecting 'slow', 'current', or 'properties'");
+                "unknown type '" + name + "', expecting 'slow', 'current', 'properties', 'plan-cache' or 'result-cache'");
   return true;
 }
 
@@ -401,6 +557,62 @@ bool RestQueryHandler::deleteQuery (const string& name) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @startDocuBlock DeleteApiQueryPlanCache
+/// @brief removes all plans from the AQL query plan cache
+///
+/// @RESTHEADER{DELETE /_api/query/plan-cache, Clears the AQL query plan cache}
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// The server will respond with *HTTP 200* when the plan cache was
+/// cleared successfully.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::deletePlanCache () {
+  auto planCache = static_cast<triagens::aql::QueryPlanCache*>(_vocbase->_queryPlanCache);
+  planCache->invalidate();
+
+  Json result(Json::Object);
+
+  result
+  .set("error", Json(false))
+  .set("code", Json(HttpResponse::OK));
+
+  generateResult(HttpResponse::OK, result.json());
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @startDocuBlock DeleteApiQueryResultCache
+/// @brief removes all results from the AQL query result cache
+///
+/// @RESTHEADER{DELETE /_api/query/result-cache, Clears the AQL query result cache}
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// The server will respond with *HTTP 200* when the result cache was
+/// cleared successfully.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::deleteResultCache () {
+  auto resultCache = static_cast<triagens::aql::QueryResultCache*>(_vocbase->_queryResultCache);
+  resultCache->invalidate();
+
+  Json result(Json::Object);
+
+  result
+  .set("error", Json(false))
+  .set("code", Json(HttpResponse::OK));
+
+  generateResult(HttpResponse::OK, result.json());
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief interrupts a query
 ////////////////////////////////////////////////////////////////////////////////
@@ -411,7 +623,7 @@ bool RestQueryHandler::deleteQuery () {
   if (suffix.size() != 1) {
     generateError(HttpResponse::BAD,
                   TRI_ERROR_HTTP_BAD_PARAMETER,
-                  "expecting DELETE /_api/query/<id> or /_api/query/slow");
+                  "expecting DELETE /_api/query/<id>, /_api/query/slow, /_api/query/plan-cache or /_api/query/result-cache");
     return true;
   }
 
@@ -420,6 +632,12 @@ bool RestQueryHandler::deleteQuery () {
   if (name == "slow") {
     return deleteQuerySlow();
   }
+  else if (name == "plan-cache") {
+    return deletePlanCache();
+  }
+  else if (name == "result-cache") {
+    return deleteResultCache();
+  }
   else {
     return deleteQuery(name);
   }
@@ -477,10 +695,18 @@ bool RestQueryHandler::deleteQuery () {
 bool RestQueryHandler::replaceProperties () {
   const auto& suffix = _request->suffix();
 
+  if (suffix.size() == 1 && suffix[0] == "plan-cache") {
+    return replacePlanCacheProperties();
+  }
+
+  if (suffix.size() == 1 && suffix[0] == "result-cache") {
+    return replaceResultCacheProperties();
+  }
+
   if (suffix.size() != 1 || suffix[0] != "properties") {
     generateError(HttpResponse::BAD,
                   TRI_ERROR_HTTP_BAD_PARAMETER,
-                  "expecting PUT /_api/query/properties");
+                  "expecting PUT /_api/query/properties, /_api/query/plan-cache or /_api/query/result-cache");
     return true;
   }
 
@@ -545,6 +771,147 @@ bool RestQueryHandler::replaceProperties () {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @startDocuBlock PutApiQueryPlanCache
+/// @brief changes the configuration of the AQL query plan cache
+///
+/// @RESTHEADER{PUT /_api/query/plan-cache, Changes the AQL query plan cache properties}
+///
+/// @RESTBODYPARAM{properties,json,required}
+/// The body needs to be a JSON object with any of the following properties:
+/// 
+/// - *enabled*: whether or not the plan cache is used. Disabling the cache
+///   removes all cached plans.
+///
+/// - *maxEntries*: the maximum number of plans kept in the cache. 
+///
+/// After the properties have been changed, the current properties and
+/// statistics of the plan cache will be returned in the HTTP response.
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// Is returned if the properties were changed successfully.
+///
+/// @RESTRETURNCODE{400}
+/// The server will respond with *HTTP 400* in case of a malformed request,
+///
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::replacePlanCacheProperties () {
+  unique_ptr<TRI_json_t> body(parseJsonBody());
+
+  if (body == nullptr) {
+    // error message generated in parseJsonBody
+    return true;
+  }
+
+  auto planCache = static_cast<triagens::aql::QueryPlanCache*>(_vocbase->_queryPlanCache);
+
+  try {
+    if (JsonHelper::getObjectElement(body.get(), "enabled") != nullptr) {
+      planCache->enabled(JsonHelper::checkAndGetBooleanValue(body.get(), "enabled"));
+    }
+
+    if (JsonHelper::getObjectElement(body.get(), "maxEntries") != nullptr) {
+      planCache->maxEntries(JsonHelper::checkAndGetNumericValue<size_t>(body.get(), "maxEntries"));
+    }
+
+    return readPlanCache();
+  }
+  catch (Exception const& err) {
+    handleError(err);
+  }
+  catch (std::exception const& ex) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, ex.what(), __FILE__, __LINE__);
+    handleError(err);
+  }
+  catch (...) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, __FILE__, __LINE__);
+    handleError(err);
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @startDocuBlock PutApiQueryResultCache
+/// @brief changes the configuration of the AQL query result cache
+///
+/// @RESTHEADER{PUT /_api/query/result-cache, Changes the AQL query result cache properties}
+///
+/// @RESTBODYPARAM{properties,json,required}
+/// The body needs to be a JSON object with any of the following properties:
+/// 
+/// - *enabled*: whether or not the result cache is used. Disabling the cache
+///   removes all cached results.
+///
+/// - *maxEntries*: the maximum number of results kept in the cache. 
+///
+/// - *maxResultSize*: the maximum size (in bytes) of a single serialized
+///   result.
+///
+/// - *maxMemory*: the maximum total size (in bytes) of all cached results.
+///
+/// After the properties have been changed, the current properties and
+/// statistics of the result cache will be returned in the HTTP response.
+///
+/// @RESTRETURNCODES
+///
+/// @RESTRETURNCODE{200}
+/// Is returned if the properties were changed successfully.
+///
+/// @RESTRETURNCODE{400}
+/// The server will respond with *HTTP 400* in case of a malformed request,
+///
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+bool RestQueryHandler::replaceResultCacheProperties () {
+  unique_ptr<TRI_json_t> body(parseJsonBody());
+
+  if (body == nullptr) {
+    // error message generated in parseJsonBody
+    return true;
+  }
+
+  auto resultCache = static_cast<triagens::aql::QueryResultCache*>(_vocbase->_queryResultCache);
+
+  try {
+    if (JsonHelper::getObjectElement(body.get(), "maxEntries") != nullptr) {
+      resultCache->maxEntries(JsonHelper::checkAndGetNumericValue<size_t>(body.get(), "maxEntries"));
+    }
+
+    if (JsonHelper::getObjectElement(body.get(), "maxResultSize") != nullptr) {
+      resultCache->maxResultSize(JsonHelper::checkAndGetNumericValue<size_t>(body.get(), "maxResultSize"));
+    }
+
+    if (JsonHelper::getObjectElement(body.get(), "maxMemory") != nullptr) {
+      resultCache->maxMemory(JsonHelper::checkAndGetNumericValue<size_t>(body.get(), "maxMemory"));
+    }
+
+    if (JsonHelper::getObjectElement(body.get(), "enabled") != nullptr) {
+      resultCache->enabled(JsonHelper::checkAndGetBooleanValue(body.get(), "enabled"));
+    }
+
+    return readResultCache();
+  }
+  catch (Exception const& err) {
+    handleError(err);
+  }
+  catch (std::exception const& ex) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, ex.what(), __FILE__, __LINE__);
+    handleError(err);
+  }
+  catch (...) {
+    triagens::basics::Exception err(TRI_ERROR_INTERNAL, __FILE__, __LINE__);
+    handleError(err);
+  }
+
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @startDocuBlock JSF_post_api_query
 /// @brief parse an AQL query and return information about it
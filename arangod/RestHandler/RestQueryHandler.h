@@ -106,6 +106,18 @@ namespace triagens {
 
         bool readQuery ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the plan cache properties and statistics
+////////////////////////////////////////////////////////////////////////////////
+
+        bool readPlanCache ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the result cache properties and statistics
+////////////////////////////////////////////////////////////////////////////////
+
+        bool readResultCache ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes the slow log
 ////////////////////////////////////////////////////////////////////////////////
@@ -124,12 +136,36 @@ namespace triagens {
 
         bool deleteQuery ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clears the plan cache
+////////////////////////////////////////////////////////////////////////////////
+
+        bool deletePlanCache ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief clears the result cache
+////////////////////////////////////////////////////////////////////////////////
+
+        bool deleteResultCache ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief changes the settings
 ////////////////////////////////////////////////////////////////////////////////
 
         bool replaceProperties ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief changes the plan cache settings
+////////////////////////////////////////////////////////////////////////////////
+
+        bool replacePlanCacheProperties ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief changes the result cache settings
+////////////////////////////////////////////////////////////////////////////////
+
+        bool replaceResultCacheProperties ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief parses a query
 ////////////////////////////////////////////////////////////////////////////////
@@ -80,6 +80,7 @@
 #include "V8/v8-utils.h"
 #include "V8Server/ApplicationV8.h"
 #include "VocBase/auth.h"
+#include "VocBase/compactor.h"
 #include "VocBase/server.h"
 #include "Wal/LogfileManager.h"
 
@@ -304,6 +305,8 @@ ArangoServer::ArangoServer (int argc, char** argv)
     _dispatcherQueueSize(8192),
     _v8Contexts(8),
     _indexThreads(2),
+    _compactorThreads(2),
+    _compactorMaxRate(128 * 1024 * 1024),
     _databasePath(),
     _defaultMaximalSize(TRI_JOURNAL_DEFAULT_MAXIMAL_SIZE),
     _defaultWaitForSync(false),
@@ -311,10 +314,12 @@ ArangoServer::ArangoServer (int argc, char** argv)
     _ignoreDatafileErrors(true),
     _disableReplicationApplier(false),
     _disableQueryTracking(false),
+    _documentLevelLocking(false),
     _server(nullptr),
     _queryRegistry(nullptr),
     _pairForAql(nullptr),
-    _indexPool(nullptr) {
+    _indexPool(nullptr),
+    _compactorPool(nullptr) {
 
   TRI_SetApplicationName("arangod");
 
@@ -343,6 +348,7 @@ ArangoServer::ArangoServer (int argc, char** argv)
 
 ArangoServer::~ArangoServer () {
   delete _indexPool;
+  delete _compactorPool;
 
   delete _jobManager;
 
@@ -551,7 +557,10 @@ void ArangoServer::buildApplicationServer () {
     ("database.force-sync-properties", &_forceSyncProperties, "force syncing of collection properties to disk, will use waitForSync value of collection when turned off")
     ("database.ignore-datafile-errors", &_ignoreDatafileErrors, "load collections even if datafiles may contain errors")
     ("database.disable-query-tracking", &_disableQueryTracking, "turn off AQL query tracking by default")
+    ("database.document-level-locking", &_documentLevelLocking, "use document-level locking for single-document write operations")
     ("database.index-threads", &_indexThreads, "threads to start for parallel background index creation")
+    ("database.compactor-threads", &_compactorThreads, "number of threads for compacting collections in parallel")
+    ("database.compactor-max-rate", &_compactorMaxRate, "maximum number of bytes per second read and written by compactions (0 = unlimited)")
   ;
 
   // .............................................................................
@@ -702,6 +711,7 @@ void ArangoServer::buildApplicationServer () {
   
   // set global query tracking flag
   triagens::aql::Query::DisableQueryTracking(_disableQueryTracking);
+  TRI_SetDocumentLevelLockingDocumentCollection(_documentLevelLocking);
 
 
   // .............................................................................
@@ -760,6 +770,10 @@ void ArangoServer::buildApplicationServer () {
       _indexThreads = 128;
     }
   }
+
+  if (_compactorThreads < 1 || _compactorThreads > 64) {
+    LOG_FATAL_AND_EXIT("invalid value for '--database.compactor-threads'. Please use a value between 1 and 64");
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1245,6 +1259,13 @@ void ArangoServer::openDatabases (bool checkVersion,
     _indexPool = new triagens::basics::ThreadPool(_indexThreads, "IndexBuilder");
   }
 
+  if (_compactorThreads > 1) {
+    // the compactor thread of each database participates, too
+    _compactorPool = new triagens::basics::ThreadPool(_compactorThreads - 1, "Compactor");
+  }
+
+  TRI_ConfigureCompactorVocBase(_compactorPool, _compactorMaxRate);
+
   int res = TRI_InitServer(_server,
                            _applicationEndpointServer,
                            _indexPool,
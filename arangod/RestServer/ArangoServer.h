@@ -372,6 +372,44 @@ namespace triagens {
 
         int _indexThreads;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of threads for compaction
+/// @startDocuBlock compactorThreads
+/// `--database.compactor-threads`
+///
+/// Specifies the *number* of threads that compact datafiles in parallel. Each
+/// database has its own compactor thread that decides which collections to
+/// compact, starting with the collections that have the most reclaimable
+/// bytes in their datafiles. The compactions of different collections are
+/// then executed by the compactor thread and by additional worker threads,
+/// which are shared among all databases. A collection is only compacted by
+/// one thread at a time. Specifying a value of *1* will compact all
+/// collections of a database sequentially in its compactor thread.
+///
+/// The default is *2*.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        int _compactorThreads;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum compaction I/O rate
+/// @startDocuBlock compactorMaxRate
+/// `--database.compactor-max-rate`
+///
+/// Limits the number of bytes per second that all compactions together will
+/// read from datafiles and write into compaction files. When compactions are
+/// ahead of the allowed rate, the compactor pauses before its next run, so
+/// compaction will compete less with other operations for disk I/O. No
+/// collection locks are held during the pause. Specifying a value
+/// of *0* will turn off the limit.
+///
+/// The default is *134217728* (128 MB per second).
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _compactorMaxRate;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief path to the database
 /// @startDocuBlock DatabaseDirectory
@@ -512,6 +550,27 @@ namespace triagens {
 
         bool _disableQueryTracking;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief use document-level locking for single-document operations
+/// @startDocuBlock databaseDocumentLevelLocking
+/// `--database.document-level-locking flag`
+///
+/// If *true*, single-document insert, update, replace and remove operations
+/// will not acquire an exclusive lock on the collection. Instead, they will
+/// only lock the affected document key, and write to the write-ahead log
+/// while other operations on the same collection are ongoing. Readers will
+/// only be blocked while the in-memory indexes are modified.
+///
+/// This only applies to collections without secondary indexes other than
+/// the edge index. Operations on other collections and multi-document
+/// transactions will continue to use exclusive collection locks.
+///
+/// The default is *false*.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _documentLevelLocking;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief unit tests
 ///
@@ -592,6 +651,12 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         triagens::basics::ThreadPool* _indexPool;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief thread pool for parallel compaction of collections
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::ThreadPool* _compactorPool;
     };
   }
 }
@@ -29,6 +29,10 @@
 
 #include "skiplistIndex.h"
 
+#include "Basics/json-utilities.h"
+#include "Basics/Mutex.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/ThreadPool.h"
 #include "Basics/utf8-helper.h"
 #include "ShapedJson/json-shaper.h"
 #include "ShapedJson/shaped-json.h"
@@ -211,6 +215,286 @@ static void FreeElm (void* e) {
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
 }
 
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+// Statistics
+//------------------------------------------------------------------------------
+//------------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of buckets in the histogram
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const HistogramBuckets = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief minimum number of modifications before the statistics are rebuilt
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t const MinStatisticsModifications = 16;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief statistics about the values in a skiplist index, used by the
+/// optimizer for cost estimation
+///
+/// the statistics consist of the number of distinct values for each prefix
+/// of the indexed attributes and of an equi-depth histogram on the first
+/// indexed attribute. the element count and the distinct values are kept up
+/// to date on every modification by comparing the element with its neighbors
+/// in the skiplist. the histogram is rebuilt from the sorted skiplist by the
+/// cleanup thread once the number of modifications since the last rebuild
+/// exceeds a quarter of the elements
+////////////////////////////////////////////////////////////////////////////////
+
+struct SkiplistIndexStatistics {
+  SkiplistIndexStatistics ()
+    : lock(),
+      modifications(0),
+      count(0),
+      distinct(),
+      bounds() {
+  }
+
+  ~SkiplistIndexStatistics () {
+    for (auto& bound : bounds) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, bound);
+    }
+  }
+
+  // protects count, distinct and bounds
+  triagens::basics::Mutex lock;
+
+  // modifications since the last rebuild. only accessed by writers, which
+  // are serialized by the collection's write lock, and by the rebuild, which
+  // holds the collection's read lock
+  uint64_t modifications;
+
+  // number of elements
+  uint64_t count;
+
+  // distinct[i] is the number of distinct values of the first i + 1 attributes
+  std::vector<double> distinct;
+
+  // histogram bounds. bucket i contains the values between bounds[i] and
+  // bounds[i + 1] (both inclusive), each bucket holds count / (bounds.size() - 1)
+  // elements
+  std::vector<TRI_json_t*> bounds;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief converts the first indexed attribute of an element into JSON
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_json_t* FirstValueJson (TRI_skiplist_index_element_t const* element,
+                                   TRI_shaper_t* shaper) {
+  auto subObjects = SkiplistIndex_Subobjects(element);
+
+  TRI_shaped_json_t shaped;
+  shaped._sid = subObjects[0]._sid;
+  TRI_InspectShapedSub(&subObjects[0], element->_document->getShapedJsonPtr(), shaped);  // ONLY IN INDEX
+
+  return TRI_JsonShapedJson(shaper, &shaped);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rebuilds the statistics of a skiplist index from the skiplist
+/// the caller must make sure that the skiplist is not modified concurrently
+////////////////////////////////////////////////////////////////////////////////
+
+static void RebuildStatistics (SkiplistIndex* skiplistIndex) {
+  auto statistics = skiplistIndex->statistics;
+  TRI_shaper_t* shaper = skiplistIndex->_collection->getShaper();  // ONLY IN INDEX, PROTECTED by RUNTIME
+  size_t const numFields = skiplistIndex->_numFields;
+  uint64_t const count = skiplistIndex->skiplist->getNrUsed();
+  uint64_t const numBuckets = (std::min)(static_cast<uint64_t>(HistogramBuckets), count);
+
+  std::vector<double> distinct;
+  std::vector<TRI_json_t*> bounds;
+
+  auto freeBounds = [&bounds] () -> void {
+    for (auto& bound : bounds) {
+      TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, bound);
+    }
+  };
+
+  try {
+    distinct.resize(numFields, 0.0);
+    bounds.reserve(numBuckets + 1);
+
+    TRI_skiplist_index_element_t const* previous = nullptr;
+    uint64_t position = 0;
+    uint64_t nextBound = 0;
+    triagens::basics::SkipListNode* node = skiplistIndex->skiplist->startNode()->nextNode();
+
+    while (node != nullptr) {
+      auto element = static_cast<TRI_skiplist_index_element_t const*>(node->document());
+
+      // find the first attribute in which the element differs from its predecessor
+      size_t first = 0;
+      if (previous != nullptr) {
+        while (first < numFields &&
+               CompareElementElement(previous, first, element, first, shaper) == 0) {
+          ++first;
+        }
+      }
+
+      for (size_t i = first; i < numFields; ++i) {
+        distinct[i] += 1.0;
+      }
+
+      // the first element is the lower bound of the first bucket, and it may
+      // also be the upper bound of the first bucket
+      while (position == nextBound && bounds.size() <= numBuckets) {
+        TRI_json_t* json = FirstValueJson(element, shaper);
+
+        if (json == nullptr) {
+          freeBounds();
+          return;
+        }
+
+        bounds.emplace_back(json);
+        // the next bound is the last element of the next bucket
+        nextBound = (bounds.size() * count / numBuckets) - 1;
+      }
+
+      previous = element;
+      ++position;
+      node = node->nextNode();
+    }
+  }
+  catch (...) {
+    // leave the old statistics in place, they will be rebuilt later
+    freeBounds();
+    return;
+  }
+
+  {
+    MUTEX_LOCKER(statistics->lock);
+
+    statistics->count = count;
+    statistics->distinct.swap(distinct);
+    statistics->bounds.swap(bounds);
+  }
+
+  // bounds now contains the old histogram
+  freeBounds();
+  statistics->modifications = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief returns the number of leading indexed attributes in which the
+/// element stored in the node equals one of its neighbors. the element
+/// contributes a distinct value to all longer prefixes
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t SharedPrefixNeighbors (SkiplistIndex* skiplistIndex,
+                                     triagens::basics::SkipListNode* node) {
+  TRI_shaper_t* shaper = skiplistIndex->_collection->getShaper();  // ONLY IN INDEX, PROTECTED by RUNTIME
+  size_t const numFields = skiplistIndex->_numFields;
+  auto element = static_cast<TRI_skiplist_index_element_t const*>(node->document());
+
+  size_t shared = 0;
+
+  auto compare = [&] (triagens::basics::SkipListNode* neighbor) -> void {
+    auto other = static_cast<TRI_skiplist_index_element_t const*>(neighbor->document());
+    size_t i = 0;
+
+    while (i < numFields &&
+           CompareElementElement(other, i, element, i, shaper) == 0) {
+      ++i;
+    }
+
+    shared = (std::max)(shared, i);
+  };
+
+  auto prev = skiplistIndex->skiplist->prevNode(node);
+  if (prev != skiplistIndex->skiplist->startNode()) {
+    compare(prev);
+  }
+
+  auto next = skiplistIndex->skiplist->nextNode(node);
+  if (next != nullptr) {
+    compare(next);
+  }
+
+  return shared;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief counts an inserted (delta = 1) or removed (delta = -1) element in
+/// the statistics. must be called by the writer
+////////////////////////////////////////////////////////////////////////////////
+
+static void UpdateStatistics (SkiplistIndex* skiplistIndex,
+                              size_t shared,
+                              double delta) {
+  auto statistics = skiplistIndex->statistics;
+  size_t const numFields = skiplistIndex->_numFields;
+
+  statistics->modifications++;
+
+  MUTEX_LOCKER(statistics->lock);
+
+  statistics->count = skiplistIndex->skiplist->getNrUsed();
+
+  if (statistics->distinct.size() != numFields) {
+    statistics->distinct.resize(numFields, 0.0);
+  }
+
+  for (size_t i = shared; i < numFields; ++i) {
+    statistics->distinct[i] = (std::max)(0.0, statistics->distinct[i] + delta);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compares two JSON values for the histogram
+////////////////////////////////////////////////////////////////////////////////
+
+static inline int CompareHistogramValues (TRI_json_t const* left,
+                                          TRI_json_t const* right) {
+  return TRI_CompareValuesJson(left, right, true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief estimates which part of a histogram bucket lies within a range
+/// that partially overlaps it. numbers are interpolated linearly, for all
+/// other types half of the bucket is assumed
+////////////////////////////////////////////////////////////////////////////////
+
+static double PartialBucket (TRI_json_t const* lower,
+                             TRI_json_t const* upper,
+                             TRI_json_t const* low,
+                             TRI_json_t const* high) {
+  if (lower->_type != TRI_JSON_NUMBER ||
+      upper->_type != TRI_JSON_NUMBER ||
+      (low != nullptr && low->_type != TRI_JSON_NUMBER) ||
+      (high != nullptr && high->_type != TRI_JSON_NUMBER)) {
+    return 0.5;
+  }
+
+  double const width = upper->_value._number - lower->_value._number;
+
+  if (width <= 0.0) {
+    return 0.5;
+  }
+
+  double from = lower->_value._number;
+  double to = upper->_value._number;
+
+  if (low != nullptr && low->_value._number > from) {
+    from = low->_value._number;
+  }
+  if (high != nullptr && high->_value._number < to) {
+    to = high->_value._number;
+  }
+
+  if (to <= from) {
+    return 0.0;
+  }
+
+  return (to - from) / width;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the current interval that the iterator points at
 ////////////////////////////////////////////////////////////////////////////////
@@ -412,6 +696,9 @@ void SkiplistIndex_destroy (SkiplistIndex* slIndex) {
 
   delete slIndex->skiplist;
   slIndex->skiplist = nullptr;
+
+  delete slIndex->statistics;
+  slIndex->statistics = nullptr;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -453,11 +740,13 @@ SkiplistIndex* SkiplistIndex_new (TRI_document_collection_t* document,
   skiplistIndex->_numFields = numFields;
   skiplistIndex->unique = unique;
   try {
+    skiplistIndex->statistics = new SkiplistIndexStatistics();
     skiplistIndex->skiplist = new triagens::basics::SkipList(
                                            CmpElmElm, CmpKeyElm, skiplistIndex,
                                            FreeElm, unique);
   }
   catch (...) {
+    delete skiplistIndex->statistics;
     TRI_Free(TRI_CORE_MEM_ZONE, skiplistIndex);
     return nullptr;
   }
@@ -804,6 +1093,115 @@ int SkiplistIndex_insert (SkiplistIndex* skiplistIndex,
   if (res != TRI_ERROR_NO_ERROR) {
     TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
   }
+  else {
+    auto node = skiplistIndex->skiplist->lookup(element);
+    TRI_ASSERT(node != nullptr);
+
+    UpdateStatistics(skiplistIndex, SharedPrefixNeighbors(skiplistIndex, node), 1.0);
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts many data elements into an empty skip list at once
+///
+/// the elements are sorted in runs (in parallel if a thread pool is given),
+/// the runs are merged pairwise and the skip list is then built bottom-up
+/// from the sorted sequence. ownership for the elements is transferred to
+/// the index, they are freed if the insertion fails
+////////////////////////////////////////////////////////////////////////////////
+
+int SkiplistIndex_bulkInsert (SkiplistIndex* skiplistIndex,
+                              std::vector<TRI_skiplist_index_element_t*>& elements,
+                              triagens::basics::ThreadPool* pool) {
+  // minimum number of elements per sort run
+  static size_t const MinRunSize = 8192;
+
+  size_t const n = elements.size();
+
+  auto less = [&skiplistIndex] (TRI_skiplist_index_element_t* left,
+                                TRI_skiplist_index_element_t* right) -> bool {
+    return CmpElmElm(skiplistIndex, left, right, triagens::basics::SKIPLIST_CMP_TOTORDER) < 0;
+  };
+
+  size_t runs = 1;
+  if (pool != nullptr && n >= 2 * MinRunSize) {
+    runs = (std::min)(pool->size() + 1, n / MinRunSize);
+  }
+
+  int res = TRI_ERROR_NO_ERROR;
+
+  try {
+    if (runs == 1) {
+      std::sort(elements.begin(), elements.end(), less);
+    }
+    else {
+      // run i covers the range [bounds[i], bounds[i + 1])
+      std::vector<size_t> bounds;
+      bounds.reserve(runs + 1);
+      for (size_t i = 0; i <= runs; ++i) {
+        bounds.emplace_back(i * n / runs);
+      }
+
+      res = pool->parallelFor(runs, [&] (size_t i) -> int {
+        std::sort(elements.begin() + bounds[i], elements.begin() + bounds[i + 1], less);
+        return TRI_ERROR_NO_ERROR;
+      });
+
+      std::vector<TRI_skiplist_index_element_t*> buffer(n);
+      auto* source = &elements;
+      auto* target = &buffer;
+
+      while (res == TRI_ERROR_NO_ERROR && runs > 1) {
+        size_t const pairs = (runs + 1) / 2;
+
+        res = pool->parallelFor(pairs, [&] (size_t i) -> int {
+          size_t const from = bounds[2 * i];
+          size_t const middle = bounds[(std::min)(2 * i + 1, runs)];
+          size_t const to = bounds[(std::min)(2 * i + 2, runs)];
+
+          std::merge(source->begin() + from, source->begin() + middle,
+                     source->begin() + middle, source->begin() + to,
+                     target->begin() + from, less);
+          return TRI_ERROR_NO_ERROR;
+        });
+
+        // keep every other boundary
+        std::vector<size_t> merged;
+        merged.reserve(pairs + 1);
+        for (size_t i = 0; i < runs; i += 2) {
+          merged.emplace_back(bounds[i]);
+        }
+        merged.emplace_back(n);
+        bounds.swap(merged);
+
+        runs = pairs;
+        std::swap(source, target);
+      }
+
+      if (source != &elements) {
+        elements.swap(buffer);
+      }
+    }
+  }
+  catch (...) {
+    res = TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = skiplistIndex->skiplist->bulkInsert(reinterpret_cast<void* const*>(elements.data()), n);
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    for (auto& element : elements) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
+    }
+    elements.clear();
+  }
+  else {
+    RebuildStatistics(skiplistIndex);
+  }
 
   return res;
 }
@@ -815,10 +1213,22 @@ int SkiplistIndex_insert (SkiplistIndex* skiplistIndex,
 
 int SkiplistIndex_remove (SkiplistIndex* skiplistIndex,
                           TRI_skiplist_index_element_t* element) {
+  // the neighbors must be compared before the element is gone
+  size_t shared = 0;
+  auto node = skiplistIndex->skiplist->lookup(element);
+
+  if (node != nullptr) {
+    shared = SharedPrefixNeighbors(skiplistIndex, node);
+  }
+
   int res = skiplistIndex->skiplist->remove(element);
 
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
 
+  if (res == TRI_ERROR_NO_ERROR) {
+    UpdateStatistics(skiplistIndex, shared, -1.0);
+  }
+
   if (res == TRI_ERROR_ARANGO_DOCUMENT_NOT_FOUND) {
     // This is for the case of a rollback in an aborted transaction.
     // We silently ignore the fact that the document was not there.
@@ -847,6 +1257,163 @@ size_t SkiplistIndex_memoryUsage (SkiplistIndex const* skiplistIndex) {
          skiplistIndex->skiplist->getNrUsed() * SkiplistIndex_ElementSize(skiplistIndex);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rebuilds the statistics of the index if they are outdated
+////////////////////////////////////////////////////////////////////////////////
+
+bool SkiplistIndex_updateStatistics (SkiplistIndex* skiplistIndex) {
+  auto statistics = skiplistIndex->statistics;
+
+  if (statistics->modifications < MinStatisticsModifications ||
+      statistics->modifications < skiplistIndex->skiplist->getNrUsed() / 4) {
+    return false;
+  }
+
+  RebuildStatistics(skiplistIndex);
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the selectivity estimate of the index
+////////////////////////////////////////////////////////////////////////////////
+
+double SkiplistIndex_selectivityEstimate (SkiplistIndex* skiplistIndex) {
+  if (skiplistIndex->unique) {
+    return 1.0;
+  }
+
+  auto statistics = skiplistIndex->statistics;
+  MUTEX_LOCKER(statistics->lock);
+
+  if (statistics->count == 0 || statistics->distinct.empty()) {
+    return 1.0;
+  }
+
+  return statistics->distinct.back() / static_cast<double>(statistics->count);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the estimated number of distinct values of the first n
+/// indexed attributes
+////////////////////////////////////////////////////////////////////////////////
+
+double SkiplistIndex_distinctEstimate (SkiplistIndex* skiplistIndex,
+                                       size_t n) {
+  auto statistics = skiplistIndex->statistics;
+  MUTEX_LOCKER(statistics->lock);
+
+  if (n == 0 || statistics->distinct.empty()) {
+    return 0.0;
+  }
+
+  n = (std::min)(n, statistics->distinct.size());
+
+  return statistics->distinct[n - 1];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the estimated fraction of elements whose first indexed
+/// attribute lies within the given bounds
+////////////////////////////////////////////////////////////////////////////////
+
+double SkiplistIndex_rangeEstimate (SkiplistIndex* skiplistIndex,
+                                    TRI_json_t const* low,
+                                    bool lowInclusive,
+                                    TRI_json_t const* high,
+                                    bool highInclusive) {
+  auto statistics = skiplistIndex->statistics;
+  MUTEX_LOCKER(statistics->lock);
+
+  auto const& bounds = statistics->bounds;
+
+  if (bounds.size() < 2) {
+    // no statistics yet
+    return -1.0;
+  }
+
+  size_t const numBuckets = bounds.size() - 1;
+
+  if (low != nullptr && high != nullptr) {
+    int cmp = CompareHistogramValues(low, high);
+
+    if (cmp > 0 || (cmp == 0 && ! (lowInclusive && highInclusive))) {
+      // empty range
+      return 0.0;
+    }
+
+    if (cmp == 0) {
+      // equality lookup
+      if (CompareHistogramValues(low, bounds.front()) < 0 ||
+          CompareHistogramValues(low, bounds.back()) > 0) {
+        return 0.0;
+      }
+
+      // buckets consisting of only the value indicate a frequent value.
+      // otherwise assume that all values occur equally often
+      size_t full = 0;
+      for (size_t i = 0; i < numBuckets; ++i) {
+        if (CompareHistogramValues(bounds[i], low) == 0 &&
+            CompareHistogramValues(bounds[i + 1], low) == 0) {
+          ++full;
+        }
+      }
+
+      double uniform = 0.0;
+      if (! statistics->distinct.empty() && statistics->distinct[0] > 0.0) {
+        uniform = 1.0 / statistics->distinct[0];
+      }
+
+      return (std::max)(static_cast<double>(full) / static_cast<double>(numBuckets), uniform);
+    }
+  }
+
+  double matching = 0.0;
+
+  for (size_t i = 0; i < numBuckets; ++i) {
+    TRI_json_t const* lower = bounds[i];
+    TRI_json_t const* upper = bounds[i + 1];
+
+    if (low != nullptr) {
+      int cmp = CompareHistogramValues(upper, low);
+
+      if (cmp < 0 || (cmp == 0 && ! lowInclusive)) {
+        // bucket is below the range
+        continue;
+      }
+    }
+
+    if (high != nullptr) {
+      int cmp = CompareHistogramValues(lower, high);
+
+      if (cmp > 0 || (cmp == 0 && ! highInclusive)) {
+        // bucket is above the range
+        continue;
+      }
+    }
+
+    bool containsLower = true;
+    if (low != nullptr) {
+      int cmp = CompareHistogramValues(lower, low);
+      containsLower = (cmp > 0 || (cmp == 0 && lowInclusive));
+    }
+
+    bool containsUpper = true;
+    if (high != nullptr) {
+      int cmp = CompareHistogramValues(upper, high);
+      containsUpper = (cmp < 0 || (cmp == 0 && highInclusive));
+    }
+
+    if (containsLower && containsUpper) {
+      matching += 1.0;
+    }
+    else {
+      matching += PartialBucket(lower, upper, low, high);
+    }
+  }
+
+  return matching / static_cast<double>(numBuckets);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
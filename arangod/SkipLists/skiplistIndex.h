@@ -41,9 +41,16 @@
 // --SECTION--                                              forward declarations
 // -----------------------------------------------------------------------------
 
+struct SkiplistIndexStatistics;
 struct TRI_doc_mptr_t;
 struct TRI_document_collection_t;
 
+namespace triagens {
+  namespace basics {
+    class ThreadPool;
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                        skiplistIndex public types
 // -----------------------------------------------------------------------------
@@ -53,6 +60,7 @@ typedef struct {
   bool unique;
   struct TRI_document_collection_t* _collection;
   size_t _numFields;
+  struct SkiplistIndexStatistics* statistics;
 }
 SkiplistIndex;
 
@@ -149,6 +157,10 @@ TRI_skiplist_iterator_t* SkiplistIndex_find (SkiplistIndex*,
 
 int SkiplistIndex_insert (SkiplistIndex*, TRI_skiplist_index_element_t*);
 
+int SkiplistIndex_bulkInsert (SkiplistIndex*,
+                              std::vector<TRI_skiplist_index_element_t*>&,
+                              triagens::basics::ThreadPool*);
+
 int SkiplistIndex_remove (SkiplistIndex*, TRI_skiplist_index_element_t*);
 
 bool SkiplistIndex_update (SkiplistIndex*, const TRI_skiplist_index_element_t*,
@@ -166,6 +178,41 @@ uint64_t SkiplistIndex_getNrUsed (SkiplistIndex*);
 
 size_t SkiplistIndex_memoryUsage (SkiplistIndex const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rebuilds the histogram and the distinct value counts of the index
+/// if there were many modifications since the last rebuild. this walks the
+/// whole skiplist, so the caller must hold the collection's read lock.
+/// returns whether or not the statistics were rebuilt
+////////////////////////////////////////////////////////////////////////////////
+
+bool SkiplistIndex_updateStatistics (SkiplistIndex*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the selectivity estimate of the index, that is the number
+/// of distinct keys divided by the number of elements
+////////////////////////////////////////////////////////////////////////////////
+
+double SkiplistIndex_selectivityEstimate (SkiplistIndex*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the estimated number of distinct values of the first n
+/// indexed attributes, or 0 if no statistics are available
+////////////////////////////////////////////////////////////////////////////////
+
+double SkiplistIndex_distinctEstimate (SkiplistIndex*, size_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the estimated fraction of elements whose first indexed
+/// attribute lies within the given bounds, or a negative value if no
+/// statistics are available. a bound of nullptr means unbounded
+////////////////////////////////////////////////////////////////////////////////
+
+double SkiplistIndex_rangeEstimate (SkiplistIndex*,
+                                    TRI_json_t const*,
+                                    bool,
+                                    TRI_json_t const*,
+                                    bool);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the memory size of a skiplist index element
 ////////////////////////////////////////////////////////////////////////////////
@@ -116,22 +116,16 @@ void CollectionExport::run (uint64_t maxWaitTime) {
   {
     triagens::arango::CollectionReadLocker lock(_document, true);
 
-    size_t const n = _document->_primaryIndex._nrAlloc;
-  
-    _documents->reserve(n);
-  
-    for (size_t i = 0; i < n; ++i) {
-      auto ptr = _document->_primaryIndex._table[i];
+    _documents->reserve(_document->_primaryIndex._nrUsed);
 
-      if (ptr != nullptr) {
-        void const* marker = static_cast<TRI_doc_mptr_t const*>(ptr)->getDataPtr();
+    // walk the datafiles sequentially. it is only safe to use the markers
+    // from the datafiles, not the WAL, so the WAL part of the scan is skipped
+    TRI_datafile_scan_t position;
+    auto documents = _documents;
 
-        // it is only safe to use the markers from the datafiles, not the WAL
-        if (! TRI_IsWalDataMarkerDatafile(marker)) {
-          _documents->emplace_back(marker);
-        }
-      }
-    }
+    TRI_ScanDatafilesDocumentCollection(_document, &position, SIZE_MAX, false, [&documents] (TRI_doc_mptr_t const* mptr) {
+      documents->emplace_back(mptr->getDataPtr());
+    });
   }
 }
 
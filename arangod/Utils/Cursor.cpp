@@ -28,6 +28,11 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Utils/Cursor.h"
+#include "Aql/AqlItemBlock.h"
+#include "Aql/ExecutionBlock.h"
+#include "Aql/ExecutionEngine.h"
+#include "Aql/Query.h"
+#include "Aql/QueryRegistry.h"
 #include "Basics/JsonHelper.h"
 #include "ShapedJson/shaped-json.h"
 #include "Utils/CollectionExport.h"
@@ -208,6 +213,340 @@ void JsonCursor::freeJson () {
   _isDeleted = true;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class StreamCursor
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                        constructors / destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create a cursor that fetches the results of an already prepared
+/// query on demand. the cursor takes ownership of the query, and keeps its
+/// engine and transaction alive until the last result was fetched or the
+/// cursor is destroyed
+///
+/// between two batches, the query is parked in the query registry under the
+/// cursor id, and each batch takes it out and returns it again. this hands
+/// the transaction over between the threads that serve the requests, in the
+/// same way as for queries that are continued by a coordinator
+////////////////////////////////////////////////////////////////////////////////
+
+StreamCursor::StreamCursor (TRI_vocbase_t* vocbase,
+                            CursorId id,
+                            triagens::aql::QueryRegistry* queryRegistry,
+                            triagens::aql::Query* query,
+                            size_t batchSize,
+                            double ttl)
+  : Cursor(id, batchSize, nullptr, ttl, false),
+    _vocbase(vocbase),
+    _queryRegistry(queryRegistry),
+    _query(nullptr),
+    _block(nullptr),
+    _blockPosition(0),
+    _current(nullptr),
+    _finished(false) {
+
+  TRI_ASSERT(_queryRegistry != nullptr);
+  TRI_ASSERT(query != nullptr);
+  TRI_ASSERT(query->engine() != nullptr);
+
+  // the registry takes over the query and its transaction from here on
+  _queryRegistry->insert(static_cast<triagens::aql::QueryId>(id), query, ttl);
+
+  TRI_UseVocBase(vocbase);
+}
+        
+StreamCursor::~StreamCursor () {
+  freeCurrent();
+
+  delete _block;
+
+  if (! _finished) {
+    // abort the transaction of the unfinished query
+    abortQuery();
+  }
+
+  TRI_ReleaseVocBase(_vocbase);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief check whether the cursor contains more data
+/// this will fetch the next block of results from the engine if required
+////////////////////////////////////////////////////////////////////////////////
+
+bool StreamCursor::hasNext () {
+  if (_finished) {
+    return false;
+  }
+
+  bool const opened = openQuery();
+  bool found = false;
+
+  try {
+    while (! found) {
+      if (_block != nullptr) {
+        size_t const n = _block->size();
+
+        while (_blockPosition < n) {
+          if (! _block->getValueReference(_blockPosition, 0).isEmpty()) {
+            found = true;
+            break;
+          }
+          // skip empty values, as Query::execute() does
+          ++_blockPosition;
+        }
+
+        if (found) {
+          break;
+        }
+
+        delete _block;
+        _block = nullptr;
+      }
+
+      _blockPosition = 0;
+      _block = _query->engine()->getSome(1, triagens::aql::ExecutionBlock::DefaultBatchSize);
+
+      if (_block == nullptr) {
+        // engine is exhausted. this will also remove the query from the registry
+        finish();
+        return false;
+      }
+    }
+  }
+  catch (...) {
+    abortQuery();
+    throw;
+  }
+
+  if (opened) {
+    closeQuery();
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the next element
+/// the element is owned by the cursor and valid until the next call
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* StreamCursor::next () {
+  TRI_ASSERT(_block != nullptr);
+  TRI_ASSERT(_blockPosition < _block->size());
+
+  freeCurrent();
+
+  bool const opened = openQuery();
+
+  try {
+    auto const& value = _block->getValueReference(_blockPosition, 0);
+    _current = value.toJson(_query->trx(), _block->getDocumentCollection(0)).steal();
+    ++_blockPosition;
+  }
+  catch (...) {
+    abortQuery();
+    throw;
+  }
+
+  if (opened) {
+    closeQuery();
+  }
+
+  return _current;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the cursor size
+/// the total number of results is unknown for a streaming cursor
+////////////////////////////////////////////////////////////////////////////////
+
+size_t StreamCursor::count () const {
+  return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief dump the cursor contents into a string buffer
+////////////////////////////////////////////////////////////////////////////////
+        
+void StreamCursor::dump (triagens::basics::StringBuffer& buffer) {
+  try {
+    // take the query out of the registry once for the whole batch
+    if (! _finished) {
+      openQuery();
+    }
+
+    buffer.appendText("\"result\":[");
+
+    size_t const n = batchSize();
+
+    for (size_t i = 0; i < n; ++i) {
+      if (! hasNext()) {
+        break;
+      }
+
+      if (i > 0) {
+        buffer.appendChar(',');
+      }
+    
+      // write the value directly into the buffer. this will not create
+      // any intermediate JSON for documents
+      auto const& value = _block->getValueReference(_blockPosition, 0);
+      value.stringify(_query->trx(), _block->getDocumentCollection(0), buffer.stringBuffer());
+      ++_blockPosition;
+    }
+
+    // this might fetch the next block from the engine, or finish the query
+    bool const more = hasNext();
+
+    // return the query to the registry until the next batch is requested
+    closeQuery();
+
+    buffer.appendText("],\"hasMore\":");
+    buffer.appendText(more ? "true" : "false");
+
+    if (more) {
+      // only return cursor id if there are more documents
+      buffer.appendText(",\"id\":\"");
+      buffer.appendInteger(id());
+      buffer.appendText("\"");
+    }
+
+    // the extra attributes are only known after the query has finished
+    TRI_json_t const* extraJson = extra();
+
+    if (TRI_IsObjectJson(extraJson)) {
+      buffer.appendText(",\"extra\":");
+      TRI_StringifyJson(buffer.stringBuffer(), extraJson);
+    }
+    
+    if (! more) {
+      // mark the cursor as deleted
+      this->deleted();
+    }
+  }
+  catch (...) {
+    // the query cannot be continued after an error
+    abortQuery();
+    this->deleted();
+    throw;
+  }
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finish the query after the engine is exhausted, and keep the 
+/// query statistics and warnings in the "extra" attribute
+////////////////////////////////////////////////////////////////////////////////
+
+void StreamCursor::finish () {
+  TRI_ASSERT(_query != nullptr);
+  TRI_ASSERT(! _finished);
+
+  auto queryResult = _query->finalize();
+
+  triagens::basics::Json extra(triagens::basics::Json::Object); 
+ 
+  if (queryResult.stats != nullptr) {
+    extra.set("stats", triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, queryResult.stats, triagens::basics::Json::AUTOFREE));
+    queryResult.stats = nullptr;
+  }
+  if (queryResult.profile != nullptr) {
+    extra.set("profile", triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, queryResult.profile, triagens::basics::Json::AUTOFREE));
+    queryResult.profile = nullptr;
+  }
+  if (queryResult.warnings == nullptr) {
+    extra.set("warnings", triagens::basics::Json(triagens::basics::Json::Array));
+  }
+  else {
+    extra.set("warnings", triagens::basics::Json(TRI_UNKNOWN_MEM_ZONE, queryResult.warnings, triagens::basics::Json::AUTOFREE));
+    queryResult.warnings = nullptr;
+  }
+
+  TRI_ASSERT(_extra == nullptr);
+  _extra = extra.steal();
+
+  // the transaction was committed by finalize(), so the query can be 
+  // removed from the registry now
+  _finished = true;
+  _query = nullptr;
+  _queryRegistry->destroy(_vocbase, static_cast<triagens::aql::QueryId>(id()), TRI_ERROR_NO_ERROR);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief take the query out of the registry for the current thread
+/// returns false if the query was taken out already
+////////////////////////////////////////////////////////////////////////////////
+
+bool StreamCursor::openQuery () {
+  TRI_ASSERT(! _finished);
+
+  if (_query != nullptr) {
+    return false;
+  }
+
+  _query = _queryRegistry->open(_vocbase, static_cast<triagens::aql::QueryId>(id()));
+
+  if (_query == nullptr) {
+    // the query has expired in the registry
+    _finished = true;
+    THROW_ARANGO_EXCEPTION(TRI_ERROR_CURSOR_NOT_FOUND);
+  }
+
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the query to the registry
+////////////////////////////////////////////////////////////////////////////////
+
+void StreamCursor::closeQuery () {
+  if (_query != nullptr) {
+    _query = nullptr;
+    _queryRegistry->close(_vocbase, static_cast<triagens::aql::QueryId>(id()), ttl());
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief remove the query from the registry and abort its transaction
+////////////////////////////////////////////////////////////////////////////////
+
+void StreamCursor::abortQuery () {
+  if (_finished) {
+    return;
+  }
+
+  _finished = true;
+  _query = nullptr;
+
+  try {
+    _queryRegistry->destroy(_vocbase, static_cast<triagens::aql::QueryId>(id()), TRI_ERROR_TRANSACTION_ABORTED);
+  }
+  catch (...) {
+    // the query may have expired in the registry already
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief free the element returned by the last call to next()
+////////////////////////////////////////////////////////////////////////////////
+
+void StreamCursor::freeCurrent () {
+  if (_current != nullptr) {
+    TRI_FreeJson(TRI_UNKNOWN_MEM_ZONE, _current);
+    _current = nullptr;
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                class ExportCursor
 // -----------------------------------------------------------------------------
@@ -38,6 +38,12 @@ struct TRI_json_t;
 struct TRI_vocbase_s;
 
 namespace triagens {
+  namespace aql {
+    class AqlItemBlock;
+    class Query;
+    class QueryRegistry;
+  }
+
   namespace arango {
 
     class CollectionExport;
@@ -192,6 +198,67 @@ namespace triagens {
         size_t const          _size;
     };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                class StreamCursor
+// -----------------------------------------------------------------------------
+    
+    class StreamCursor : public Cursor {
+      public:
+
+        StreamCursor (struct TRI_vocbase_s*,
+                      CursorId,
+                      triagens::aql::QueryRegistry*,
+                      triagens::aql::Query*,
+                      size_t,
+                      double);
+
+        ~StreamCursor ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+      public:
+
+        bool hasNext () override final;
+
+        struct TRI_json_t* next () override final;
+        
+        size_t count () const override final;
+
+        void dump (triagens::basics::StringBuffer&) override final;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+      private:
+
+        bool openQuery ();
+
+        void closeQuery ();
+
+        void abortQuery ();
+
+        void finish ();
+
+        void freeCurrent ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+      private:
+
+        struct TRI_vocbase_s*          _vocbase;
+        triagens::aql::QueryRegistry*  _queryRegistry;
+        triagens::aql::Query*          _query;
+        triagens::aql::AqlItemBlock*   _block;
+        size_t                         _blockPosition;
+        struct TRI_json_t*             _current;
+        bool                           _finished;
+    };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                class ExportCursor
 // -----------------------------------------------------------------------------
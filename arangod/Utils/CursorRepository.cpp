@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "Utils/CursorRepository.h"
+#include "Aql/Query.h"
 #include "Basics/json.h"
 #include "Basics/MutexLocker.h"
 #include "Utils/CollectionExport.h"
@@ -142,6 +143,41 @@ ExportCursor* CursorRepository::createFromExport (triagens::arango::CollectionEx
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a streaming cursor and stores it in the registry
+////////////////////////////////////////////////////////////////////////////////
+
+StreamCursor* CursorRepository::createFromQuery (triagens::aql::QueryRegistry* queryRegistry,
+                                                 triagens::aql::Query* query,
+                                                 size_t batchSize,
+                                                 double ttl) {
+  TRI_ASSERT(queryRegistry != nullptr);
+  TRI_ASSERT(query != nullptr);
+
+  CursorId const id = TRI_NewTickServer();
+  triagens::arango::StreamCursor* cursor = nullptr;
+
+  try {
+    cursor = new triagens::arango::StreamCursor(_vocbase, id, queryRegistry, query, batchSize, ttl);
+  }
+  catch (...) {
+    delete query;
+    throw;
+  }
+
+  cursor->use();
+
+  try {
+    MUTEX_LOCKER(_lock);
+    _cursors.emplace(std::make_pair(id, cursor));
+    return cursor;
+  }
+  catch (...) {
+    delete cursor;
+    throw;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief remove a cursor by id
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +95,20 @@ namespace triagens {
                                         double, 
                                         bool);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates a streaming cursor and stores it in the registry
+/// the cursor will be returned with the usage flag set to true. it must be
+/// returned later using release() 
+/// the cursor will take ownership of the query, which must have been 
+/// prepared already. the query is parked in the query registry between
+/// two batches
+////////////////////////////////////////////////////////////////////////////////
+
+        StreamCursor* createFromQuery (triagens::aql::QueryRegistry*,
+                                       triagens::aql::Query*,
+                                       size_t,
+                                       double);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief remove a cursor by id
 ////////////////////////////////////////////////////////////////////////////////
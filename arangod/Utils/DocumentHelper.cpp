@@ -30,7 +30,11 @@
 #include "DocumentHelper.h"
 
 #include "Basics/json.h"
+#include "Basics/string-buffer.h"
 #include "Basics/StringUtils.h"
+#include "ShapedJson/shaped-json.h"
+#include "VocBase/document-collection.h"
+#include "VocBase/voc-shaper.h"
 #include "VocBase/vocbase.h"
 
 using namespace triagens::arango;
@@ -127,6 +131,101 @@ int DocumentHelper::getKey (TRI_json_t const* json,
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append a document id (collection name + key) to a string buffer
+////////////////////////////////////////////////////////////////////////////////
+
+static int AppendDocumentId (TRI_string_buffer_t* buffer,
+                             char const* attribute,
+                             char const* name,
+                             size_t nameLength,
+                             char const* key) {
+  int res = TRI_AppendStringStringBuffer(buffer, attribute);
+
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = TRI_AppendString2StringBuffer(buffer, name, nameLength);
+  }
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = TRI_AppendCharStringBuffer(buffer, '/');
+  }
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = TRI_AppendStringStringBuffer(buffer, key);
+  }
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = TRI_AppendCharStringBuffer(buffer, '"');
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringify a document marker, including its system attributes,
+/// directly into a string buffer, without building a JSON object first
+///
+/// the system attributes are written first, followed by the attributes of the
+/// shaped JSON. collection names and document keys never need JSON escaping,
+/// so they are appended verbatim
+////////////////////////////////////////////////////////////////////////////////
+
+int DocumentHelper::stringifyDocument (TRI_string_buffer_t* buffer,
+                                       CollectionNameResolver const* resolver,
+                                       TRI_voc_cid_t cid,
+                                       TRI_shaper_t* shaper,
+                                       TRI_df_marker_t const* marker) {
+  // collection names are at most TRI_COL_NAME_LENGTH bytes long
+  char name[TRI_COL_NAME_LENGTH + 1];
+  char const* key = TRI_EXTRACT_MARKER_KEY(marker);
+
+  // _id
+  size_t length = resolver->getCollectionName(&name[0], cid);
+  int res = AppendDocumentId(buffer, "{\"" TRI_VOC_ATTRIBUTE_ID "\":\"", &name[0], length, key);
+ 
+  // _rev
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = TRI_AppendStringStringBuffer(buffer, ",\"" TRI_VOC_ATTRIBUTE_REV "\":\"");
+  }
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = TRI_AppendUInt64StringBuffer(buffer, TRI_EXTRACT_MARKER_RID(marker));
+  }
+
+  // _key
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = TRI_AppendStringStringBuffer(buffer, "\",\"" TRI_VOC_ATTRIBUTE_KEY "\":\"");
+  }
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = TRI_AppendStringStringBuffer(buffer, key);
+  }
+  if (res == TRI_ERROR_NO_ERROR) {
+    res = TRI_AppendCharStringBuffer(buffer, '"');
+  }
+
+  if (res == TRI_ERROR_NO_ERROR && TRI_IS_EDGE_MARKER(marker)) {
+    // _from
+    length = resolver->getCollectionNameCluster(&name[0], TRI_EXTRACT_MARKER_FROM_CID(marker));
+    res = AppendDocumentId(buffer, ",\"" TRI_VOC_ATTRIBUTE_FROM "\":\"", &name[0], length, TRI_EXTRACT_MARKER_FROM_KEY(marker));
+
+    // _to
+    if (res == TRI_ERROR_NO_ERROR) {
+      length = resolver->getCollectionNameCluster(&name[0], TRI_EXTRACT_MARKER_TO_CID(marker));
+      res = AppendDocumentId(buffer, ",\"" TRI_VOC_ATTRIBUTE_TO "\":\"", &name[0], length, TRI_EXTRACT_MARKER_TO_KEY(marker));
+    }
+  }
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  // all other attributes
+  TRI_shaped_json_t shaped;
+  TRI_EXTRACT_SHAPED_JSON_MARKER(shaped, marker);
+
+  if (! TRI_StringifyArrayShapedJson(shaper, buffer, &shaped, true)) {
+    return TRI_ERROR_INTERNAL;
+  }
+
+  return TRI_AppendCharStringBuffer(buffer, '}');
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
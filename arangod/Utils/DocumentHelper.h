@@ -34,7 +34,10 @@
 #include "Utils/CollectionNameResolver.h"
 #include "VocBase/voc-types.h"
 
+struct TRI_df_marker_s;
 struct TRI_json_t;
+struct TRI_shaper_s;
+struct TRI_string_buffer_s;
 
 namespace triagens {
   namespace arango {
@@ -91,6 +94,17 @@ namespace triagens {
         static int getKey (struct TRI_json_t const*,
                            TRI_voc_key_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stringify a document marker, including its system attributes,
+/// directly into a string buffer, without building a JSON object first
+////////////////////////////////////////////////////////////////////////////////
+
+        static int stringifyDocument (struct TRI_string_buffer_s*,
+                                      triagens::arango::CollectionNameResolver const*,
+                                      TRI_voc_cid_t,
+                                      struct TRI_shaper_s*,
+                                      struct TRI_df_marker_s const*);
+
     };
   }
 }
@@ -348,6 +348,44 @@ namespace triagens {
            return TRI_GetCollectionTransaction(_trx, cid, TRI_TRANSACTION_READ);
          }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the transaction collection for a document collection that
+/// the transaction may not have declared. an undeclared collection is added
+/// for reading the same way an embedded read transaction adds it, and stays
+/// in use until the transaction ends. returns a nullptr if the collection
+/// cannot be used
+////////////////////////////////////////////////////////////////////////////////
+
+         TRI_transaction_collection_t* trxCollectionAtRuntime (TRI_voc_cid_t cid) {
+           TRI_ASSERT(_trx != nullptr);
+           TRI_ASSERT(getStatus() == TRI_TRANSACTION_RUNNING);
+
+           TRI_transaction_collection_t* trxCollection = TRI_GetCollectionTransaction(_trx, cid, TRI_TRANSACTION_READ);
+
+           if (trxCollection != nullptr || cid == 0) {
+             return trxCollection;
+           }
+
+           int const nestingLevel = _nestingLevel + 1;
+           int res = TRI_AddCollectionTransaction(_trx, cid, TRI_TRANSACTION_READ, nestingLevel, false);
+
+           if (res == TRI_ERROR_NO_ERROR) {
+             // use the collection. this also releases the lock it acquires,
+             // the documents are locked on each read
+             res = TRI_BeginTransaction(_trx, _trx->_hints, nestingLevel);
+
+             if (res == TRI_ERROR_NO_ERROR) {
+               res = TRI_CommitTransaction(_trx, nestingLevel);
+             }
+           }
+
+           if (res != TRI_ERROR_NO_ERROR) {
+             return nullptr;
+           }
+
+           return TRI_GetCollectionTransaction(_trx, cid, TRI_TRANSACTION_READ);
+         }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief order a barrier for a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -443,6 +481,63 @@ namespace triagens {
           return TRI_ERROR_NO_ERROR;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read all master pointers in datafile order. this walks the
+/// datafiles sequentially instead of the primary index, and returns the
+/// documents still in the write-ahead log at the end. the scan position must
+/// be kept by the caller. the result is only consistent if the read-lock on
+/// the collection is held for the whole scan
+////////////////////////////////////////////////////////////////////////////////
+
+        int readDatafileOrder (TRI_transaction_collection_t* trxCollection,
+                               std::vector<TRI_doc_mptr_copy_t>& docs,
+                               TRI_datafile_scan_t& position,
+                               TRI_voc_size_t batchSize,
+                               uint32_t* total) {
+
+          TRI_document_collection_t* document = documentCollection(trxCollection);
+
+          // READ-LOCK START
+          int res = this->lock(trxCollection, TRI_TRANSACTION_READ);
+
+          if (res != TRI_ERROR_NO_ERROR) {
+            return res;
+          }
+
+          if (document->_primaryIndex._nrUsed == 0) {
+            // nothing to do
+            this->unlock(trxCollection, TRI_TRANSACTION_READ);
+
+            // READ-LOCK END
+            *total = 0;
+            return TRI_ERROR_NO_ERROR;
+          }
+
+          if (orderBarrier(trxCollection) == nullptr) {
+            this->unlock(trxCollection, TRI_TRANSACTION_READ);
+            return TRI_ERROR_OUT_OF_MEMORY;
+          }
+
+          *total = (uint32_t) document->_primaryIndex._nrUsed;
+
+          try {
+            TRI_ScanDatafilesDocumentCollection(document, &position, static_cast<size_t>(batchSize), true, [&docs] (TRI_doc_mptr_t const* mptr) {
+              docs.emplace_back(*mptr);
+            });
+          }
+          catch (triagens::basics::Exception const& ex) {
+            res = ex.code();
+          }
+          catch (...) {
+            res = TRI_ERROR_OUT_OF_MEMORY;
+          }
+
+          this->unlock(trxCollection, TRI_TRANSACTION_READ);
+          // READ-LOCK END
+
+          return res;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief read all master pointers, using skip and limit and an internal
 /// offset into the primary index. this can be used for incremental access to
@@ -1723,6 +1723,17 @@ static TRI_doc_collection_info_t* GetFigures (TRI_vocbase_col_t* collection) {
 /// * *compactors.count*: The number of compactor files.
 /// * *compactors.fileSize*: The total filesize of the compactor files
 ///   (in bytes).
+/// * *compaction.backlogCount*: The number of datafiles that qualify for
+///   compaction.
+/// * *compaction.backlogSize*: The total size of the dead documents in the
+///   datafiles that qualify for compaction (in bytes). This is the amount of
+///   disk space compaction can reclaim.
+/// * *compaction.runs*: The number of compactions executed for the
+///   collection since it was loaded.
+/// * *compaction.bytesRead*: The number of bytes read from datafiles by these
+///   compactions.
+/// * *compaction.bytesWritten*: The number of bytes written into compaction
+///   files by these compactions.
 /// * *shapefiles.count*: The number of shape files. This value is
 ///   deprecated and kept for compatibility reasons only. The value will always
 ///   be 0 since ArangoDB 2.0 and higher.
@@ -1841,6 +1852,16 @@ static void JS_FiguresVocbaseCol (const v8::FunctionCallbackInfo<v8::Value>& arg
   cs->Set(TRI_V8_ASCII_STRING("count"),          v8::Number::New(isolate, (double) info->_numberCompactorfiles));
   cs->Set(TRI_V8_ASCII_STRING("fileSize"),       v8::Number::New(isolate, (double) info->_compactorfileSize));
 
+  // compaction info
+  v8::Handle<v8::Object> compaction = v8::Object::New(isolate);
+
+  result->Set(TRI_V8_ASCII_STRING("compaction"), compaction);
+  compaction->Set(TRI_V8_ASCII_STRING("backlogCount"), v8::Number::New(isolate, (double) info->_compactionBacklogCount));
+  compaction->Set(TRI_V8_ASCII_STRING("backlogSize"),  v8::Number::New(isolate, (double) info->_compactionBacklogSize));
+  compaction->Set(TRI_V8_ASCII_STRING("runs"),         v8::Number::New(isolate, (double) info->_compactionRuns));
+  compaction->Set(TRI_V8_ASCII_STRING("bytesRead"),    v8::Number::New(isolate, (double) info->_compactionBytesRead));
+  compaction->Set(TRI_V8_ASCII_STRING("bytesWritten"), v8::Number::New(isolate, (double) info->_compactionBytesWritten));
+
   // shapefiles info
   v8::Handle<v8::Object> sf = v8::Object::New(isolate);
 
@@ -50,6 +50,8 @@
 #include "V8/v8-utils.h"
 #include "V8/V8LineEditor.h"
 #include "Wal/LogfileManager.h"
+#include "Wal/CollectorThread.h"
+#include "Wal/SynchroniserThread.h"
 
 #include "VocBase/auth.h"
 #include "v8.h"
@@ -386,11 +388,34 @@ static void JS_Transaction (const v8::FunctionCallbackInfo<v8::Value>& args) {
 ///   allocates in the background
 /// - *syncInterval*: the interval for automatic synchronization of not-yet
 ///   synchronized write-ahead log data (in milliseconds)
+/// - *syncCommitWindow*: the maximum time that the synchronization of 
+///   write-ahead log data waits for further operations (in microseconds)
+/// - *syncCommitSize*: the number of pending operations that ends the commit
+///   window
 /// - *throttleWait*: the maximum wait time that operations will wait before
 ///   they get aborted if case of write-throttling (in milliseconds)
 /// - *throttleWhenPending*: the number of unprocessed garbage-collection 
 ///   operations that, when reached, will activate write-throttling. A value of
 ///   *0* means that write-throttling will not be triggered.
+/// - *syncStatistics*: statistics about the disk syncs of the write-ahead log:
+///   - *syncs*: number of syncs executed
+///   - *operations*: number of operations synchronized by these syncs
+///   - *averageBatchSize*: average number of operations per sync
+///   - *maxBatchSize*: maximum number of operations in a single sync
+///   - *averageSyncTime*: average duration of a sync (in seconds)
+///   - *maxSyncTime*: maximum duration of a sync (in seconds)
+/// - *collectorStatistics*: statistics about the garbage collection of the
+///   write-ahead log:
+///   - *logfiles*: number of logfiles collected
+///   - *collections*: number of per-collection transfers executed
+///   - *operations*: number of operations transferred into collections
+///   - *pendingOperations*: number of transferred operations not yet applied
+///   - *averageCollectTime*: average duration of collecting a logfile (in seconds)
+///   - *maxCollectTime*: maximum duration of collecting a logfile (in seconds)
+///   - *lagLogfiles*: number of logfiles with data not yet collected
+///   - *lagBytes*: size of the logfiles with data not yet collected
+///   - *lagTicks*: number of ticks between the oldest uncollected operation
+///     and the last committed one
 ///
 /// @EXAMPLES
 ///
@@ -413,6 +438,12 @@ static void JS_Transaction (const v8::FunctionCallbackInfo<v8::Value>& args) {
 /// - *historicLogfiles*: the maximum number of historic logfiles to keep
 /// - *reserveLogfiles*: the maximum number of reserve logfiles that ArangoDB
 ///   allocates in the background
+/// - *syncCommitWindow*: the maximum time that the synchronization of 
+///   write-ahead log data waits for further operations (in microseconds). A
+///   value of *0* turns off waiting. The window must not be greater than the
+///   sync interval
+/// - *syncCommitSize*: the number of pending operations that ends the commit
+///   window
 /// - *throttleWait*: the maximum wait time that operations will wait before
 ///   they get aborted if case of write-throttling (in milliseconds)
 /// - *throttleWhenPending*: the number of unprocessed garbage-collection 
@@ -443,6 +474,15 @@ static void JS_PropertiesWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
   if (args.Length() == 1) {
     // set the properties
     v8::Handle<v8::Object> object = v8::Handle<v8::Object>::Cast(args[0]);
+
+    // validated first so an invalid value does not change any property
+    if (object->Has(TRI_V8_ASCII_STRING("syncCommitWindow"))) {
+      uint64_t value = TRI_ObjectToUInt64(object->Get(TRI_V8_ASCII_STRING("syncCommitWindow")), true);
+      if (! l->syncCommitWindow(value)) {
+        TRI_V8_THROW_EXCEPTION_PARAMETER("<syncCommitWindow> must not be greater than the sync interval");
+      }
+    }
+
     if (object->Has(TRI_V8_ASCII_STRING("allowOversizeEntries"))) {
       bool value = TRI_ObjectToBoolean(object->Get(TRI_V8_ASCII_STRING("allowOversizeEntries")));
       l->allowOversizeEntries(value);
@@ -462,6 +502,11 @@ static void JS_PropertiesWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
       uint32_t value = static_cast<uint32_t>(TRI_ObjectToUInt64(object->Get(TRI_V8_ASCII_STRING("reserveLogfiles")), true));
       l->reserveLogfiles(value);
     }
+
+    if (object->Has(TRI_V8_ASCII_STRING("syncCommitSize"))) {
+      uint32_t value = static_cast<uint32_t>(TRI_ObjectToUInt64(object->Get(TRI_V8_ASCII_STRING("syncCommitSize")), true));
+      l->syncCommitSize(value);
+    }
     
     if (object->Has(TRI_V8_ASCII_STRING("throttleWait"))) {
       uint64_t value = TRI_ObjectToUInt64(object->Get(TRI_V8_ASCII_STRING("throttleWait")), true);
@@ -480,9 +525,36 @@ static void JS_PropertiesWal (const v8::FunctionCallbackInfo<v8::Value>& args) {
   result->Set(TRI_V8_ASCII_STRING("historicLogfiles"),      v8::Number::New(isolate, l->historicLogfiles()));
   result->Set(TRI_V8_ASCII_STRING("reserveLogfiles"),       v8::Number::New(isolate, l->reserveLogfiles()));
   result->Set(TRI_V8_ASCII_STRING("syncInterval"),          v8::Number::New(isolate, (double) l->syncInterval()));
+  result->Set(TRI_V8_ASCII_STRING("syncCommitWindow"),      v8::Number::New(isolate, (double) l->syncCommitWindow()));
+  result->Set(TRI_V8_ASCII_STRING("syncCommitSize"),        v8::Number::New(isolate, (double) l->syncCommitSize()));
   result->Set(TRI_V8_ASCII_STRING("throttleWait"),          v8::Number::New(isolate, (double) l->maxThrottleWait()));
   result->Set(TRI_V8_ASCII_STRING("throttleWhenPending"),   v8::Number::New(isolate, (double) l->throttleWhenPending()));
 
+  auto const stats = l->syncStatistics();
+
+  v8::Handle<v8::Object> syncStatistics = v8::Object::New(isolate);
+  syncStatistics->Set(TRI_V8_ASCII_STRING("syncs"),            v8::Number::New(isolate, (double) stats.numSyncs));
+  syncStatistics->Set(TRI_V8_ASCII_STRING("operations"),       v8::Number::New(isolate, (double) stats.numMarkers));
+  syncStatistics->Set(TRI_V8_ASCII_STRING("averageBatchSize"), v8::Number::New(isolate, stats.numSyncs > 0 ? (double) stats.numMarkers / (double) stats.numSyncs : 0.0));
+  syncStatistics->Set(TRI_V8_ASCII_STRING("maxBatchSize"),     v8::Number::New(isolate, (double) stats.maxMarkers));
+  syncStatistics->Set(TRI_V8_ASCII_STRING("averageSyncTime"),  v8::Number::New(isolate, stats.numSyncs > 0 ? stats.totalTime / (double) stats.numSyncs : 0.0));
+  syncStatistics->Set(TRI_V8_ASCII_STRING("maxSyncTime"),      v8::Number::New(isolate, stats.maxTime));
+  result->Set(TRI_V8_ASCII_STRING("syncStatistics"), syncStatistics);
+
+  auto const collector = l->collectorStatistics();
+
+  v8::Handle<v8::Object> collectorStatistics = v8::Object::New(isolate);
+  collectorStatistics->Set(TRI_V8_ASCII_STRING("logfiles"),           v8::Number::New(isolate, (double) collector.numLogfiles));
+  collectorStatistics->Set(TRI_V8_ASCII_STRING("collections"),        v8::Number::New(isolate, (double) collector.numCollections));
+  collectorStatistics->Set(TRI_V8_ASCII_STRING("operations"),         v8::Number::New(isolate, (double) collector.numOperations));
+  collectorStatistics->Set(TRI_V8_ASCII_STRING("pendingOperations"),  v8::Number::New(isolate, (double) collector.pendingOperations));
+  collectorStatistics->Set(TRI_V8_ASCII_STRING("averageCollectTime"), v8::Number::New(isolate, collector.numLogfiles > 0 ? collector.totalTime / (double) collector.numLogfiles : 0.0));
+  collectorStatistics->Set(TRI_V8_ASCII_STRING("maxCollectTime"),     v8::Number::New(isolate, collector.maxTime));
+  collectorStatistics->Set(TRI_V8_ASCII_STRING("lagLogfiles"),        v8::Number::New(isolate, (double) collector.lagLogfiles));
+  collectorStatistics->Set(TRI_V8_ASCII_STRING("lagBytes"),           v8::Number::New(isolate, (double) collector.lagBytes));
+  collectorStatistics->Set(TRI_V8_ASCII_STRING("lagTicks"),           v8::Number::New(isolate, (double) collector.lagTicks));
+  result->Set(TRI_V8_ASCII_STRING("collectorStatistics"), collectorStatistics);
+
   TRI_V8_RETURN(result);
 }
 
@@ -1275,6 +1347,8 @@ static void JS_ExecuteAql (const v8::FunctionCallbackInfo<v8::Value>& args) {
   else {
     result->Set(TRI_V8_ASCII_STRING("warnings"), TRI_ObjectJson(isolate, queryResult.warnings));
   }
+
+  result->Set(TRI_V8_ASCII_STRING("cached"), v8::Boolean::New(isolate, queryResult.cached));
   
   TRI_V8_RETURN(result);
 }
@@ -305,6 +305,7 @@ void TRI_CleanupVocBase (void* data) {
         // clean indexes?
         if (iterations % (uint64_t) CLEANUP_INDEX_ITERATIONS == 0) {
           document->cleanupIndexes(document);
+          TRI_UpdateIndexStatisticsDocumentCollection(document);
         }
 
         CleanupDocumentCollection(collection, document);
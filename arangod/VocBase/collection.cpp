@@ -1786,12 +1786,14 @@ int TRI_UpgradeCollection20 (TRI_vocbase_t* vocbase,
         tick = TRI_NewTickServer();
 
         // datafile header
+        // the shape and attribute markers are copied verbatim from the old
+        // datafiles, so the new datafile must use the old checksum type
         TRI_InitMarkerDatafile((char*) &header, TRI_DF_MARKER_HEADER, sizeof(TRI_df_header_marker_t));
-        header._version     = TRI_DF_VERSION;
+        header._version     = TRI_DF_VERSION_1;
         header._maximalSize = 0; // TODO: seems ok to set this to 0, check if this is ok
         header._fid         = tick;
         header.base._tick   = tick;
-        header.base._crc    = TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), (char const*) &header.base, header.base._size));
+        header.base._crc    = TRI_CrcMarkerDatafile(TRI_DF_VERSION_1, &header.base);
 
         written += TRI_WRITE(fdout, &header.base, header.base._size);
 
@@ -1800,7 +1802,7 @@ int TRI_UpgradeCollection20 (TRI_vocbase_t* vocbase,
         cm._type      = (TRI_col_type_t) info->_type;
         cm._cid       = info->_cid;
         cm.base._tick = tick;
-        cm.base._crc  = TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), (char const*) &cm.base, cm.base._size));
+        cm.base._crc  = TRI_CrcMarkerDatafile(TRI_DF_VERSION_1, &cm.base);
 
         written += TRI_WRITE(fdout, &cm.base, cm.base._size);
       }
@@ -1838,7 +1840,7 @@ int TRI_UpgradeCollection20 (TRI_vocbase_t* vocbase,
       tick = TRI_NewTickServer();
       TRI_InitMarkerDatafile((char*) &footer, TRI_DF_MARKER_FOOTER, sizeof(TRI_df_footer_marker_t));
       footer.base._tick = tick;
-      footer.base._crc  = TRI_FinalCrc32(TRI_BlockCrc32(TRI_InitialCrc32(), (char const*) &footer.base, footer.base._size));
+      footer.base._crc  = TRI_CrcMarkerDatafile(TRI_DF_VERSION_1, &footer.base);
 
       written += TRI_WRITE(fdout, &footer.base, footer.base._size);
 
@@ -36,6 +36,8 @@
 #include "Basics/conversions.h"
 #include "Basics/files.h"
 #include "Basics/logging.h"
+#include "Basics/MutexLocker.h"
+#include "Basics/ThreadPool.h"
 #include "Basics/tri-strings.h"
 #include "Utils/transactions.h"
 #include "VocBase/document-collection.h"
@@ -107,6 +109,41 @@
 
 static int const COMPACTOR_INTERVAL = (1 * 1000 * 1000);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum time to sleep in one go when throttling compaction (in s)
+////////////////////////////////////////////////////////////////////////////////
+
+#define COMPACTOR_THROTTLE_STEP (0.1)
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief thread pool shared by the compactor threads of all databases
+////////////////////////////////////////////////////////////////////////////////
+
+static triagens::basics::ThreadPool* CompactorPool = nullptr;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of bytes per second read and written by compactions
+////////////////////////////////////////////////////////////////////////////////
+
+static uint64_t CompactorMaxRate = 0;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lock protecting the compaction rate limit
+////////////////////////////////////////////////////////////////////////////////
+
+static triagens::basics::Mutex ThrottleLock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief point in time at which the compaction I/O done so far has used up
+/// its share of the rate limit
+////////////////////////////////////////////////////////////////////////////////
+
+static double ThrottleNext = 0.0;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                     private types
 // -----------------------------------------------------------------------------
@@ -156,6 +193,19 @@ typedef struct compaction_info_s {
 }
 compaction_info_t;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief datafile of a collection, considered for compaction
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct compaction_candidate_s {
+  TRI_datafile_t*                _datafile;
+  TRI_doc_datafile_info_t const* _dfi;
+  size_t                         _position;
+  int64_t                        _numAliveBefore;
+  bool                           _eligible;
+}
+compaction_candidate_t;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
@@ -201,9 +251,13 @@ static TRI_datafile_t* CreateCompactor (TRI_document_collection_t* document,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief write a copy of the marker into the datafile
+///
+/// the marker's checksum is recomputed if the compactor uses a different
+/// checksum type than the original datafile
 ////////////////////////////////////////////////////////////////////////////////
 
 static int CopyMarker (TRI_document_collection_t* document,
+                       TRI_datafile_t const* datafile,
                        TRI_datafile_t* compactor,
                        TRI_df_marker_t const* marker,
                        TRI_df_marker_t** result) {
@@ -215,7 +269,13 @@ static int CopyMarker (TRI_document_collection_t* document,
     return TRI_ERROR_ARANGO_NO_JOURNAL;
   }
 
-  return TRI_WriteElementDatafile(compactor, *result, marker, false);
+  res = TRI_WriteElementDatafile(compactor, *result, marker, false);
+
+  if (res == TRI_ERROR_NO_ERROR && datafile->_version != compactor->_version) {
+    (*result)->_crc = TRI_CrcMarkerDatafile(compactor->_version, *result);
+  }
+
+  return res;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -471,7 +531,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
     context->_keepDeletions = true;
 
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(document, datafile, context->_compactor, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -520,7 +580,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
   else if (marker->_type == TRI_DOC_MARKER_KEY_DELETION &&
            context->_keepDeletions) {
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(document, datafile, context->_compactor, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -534,7 +594,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
   // shapes
   else if (marker->_type == TRI_DF_MARKER_SHAPE) {
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(document, datafile, context->_compactor, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -554,7 +614,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
   // attributes
   else if (marker->_type == TRI_DF_MARKER_ATTRIBUTE) {
     // write to compactor files
-    res = CopyMarker(document, context->_compactor, marker, &result);
+    res = CopyMarker(document, datafile, context->_compactor, marker, &result);
 
     if (res != TRI_ERROR_NO_ERROR) {
       // TODO: dont fail but recover from this state
@@ -582,7 +642,7 @@ static bool Compactifier (TRI_df_marker_t const* marker,
 
     if (document->_failedTransactions != nullptr) {
       // write to compactor files
-      res = CopyMarker(document, context->_compactor, marker, &result);
+      res = CopyMarker(document, datafile, context->_compactor, marker, &result);
 
       if (res != TRI_ERROR_NO_ERROR) {
         // TODO: dont fail but recover from this state
@@ -778,6 +838,57 @@ static compaction_initial_context_t InitCompaction (TRI_document_collection_t* d
   return context;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief account for the specified number of bytes read and written by a
+/// compaction that started at the specified time. the rate limit is shared
+/// by all compactions. this never sleeps, as the caller holds the locks of
+/// the collection
+////////////////////////////////////////////////////////////////////////////////
+
+static void AccountCompaction (uint64_t bytes,
+                               double start) {
+  uint64_t const maxRate = CompactorMaxRate;
+
+  if (maxRate == 0 || bytes == 0) {
+    return;
+  }
+
+  MUTEX_LOCKER(ThrottleLock);
+
+  if (ThrottleNext < start) {
+    ThrottleNext = start;
+  }
+
+  ThrottleNext += (double) bytes / (double) maxRate;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until the compactions done so far are within the rate limit
+/// must be called without holding any collection or compaction locks, so
+/// writes can continue while the compactor pauses
+////////////////////////////////////////////////////////////////////////////////
+
+static void ThrottleCompaction (TRI_vocbase_t* vocbase) {
+  if (CompactorMaxRate == 0) {
+    return;
+  }
+
+  double wait;
+
+  {
+    MUTEX_LOCKER(ThrottleLock);
+    wait = ThrottleNext - TRI_microtime();
+  }
+
+  // sleep in small steps so we do not delay the shutdown
+  while (wait > 0.0 && vocbase->_state == 1) {
+    double const step = (wait > COMPACTOR_THROTTLE_STEP ? COMPACTOR_THROTTLE_STEP : wait);
+
+    usleep((unsigned long) (step * 1000.0 * 1000.0));
+    wait -= step;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief compact a list of datafiles
 ////////////////////////////////////////////////////////////////////////////////
@@ -828,10 +939,15 @@ static void CompactifyDatafiles (TRI_document_collection_t* document,
   context._compactor = compactor;
   context._dfi._fid  = compactor->_fid;
 
+  uint64_t bytesRead = 0;
+  uint64_t bytesWritten = 0;
+
   // now compact all datafiles
   for (i = 0; i < n; ++i) {
     compaction_info_t* compaction = static_cast<compaction_info_t*>(TRI_AtVector(compactions, i));
     TRI_datafile_t* df = compaction->_datafile;
+    double const start = TRI_microtime();
+    TRI_voc_size_t const compactorSize = compactor->_currentSize;
 
     LOG_TRACE("compacting datafile '%s' into '%s', number: %d, keep deletions: %d",
                df->getName(df),
@@ -856,8 +972,21 @@ static void CompactifyDatafiles (TRI_document_collection_t* document,
       // TODO: Remove
       return;
     }
+
+    uint64_t const read    = static_cast<uint64_t>(df->_currentSize);
+    uint64_t const written = static_cast<uint64_t>(compactor->_currentSize - compactorSize);
+
+    bytesRead    += read;
+    bytesWritten += written;
+
+    // the compactor pauses before its next run if this exceeds the rate limit
+    AccountCompaction(read + written, start);
   } // next file
 
+  ++document->_compactionRuns;
+  document->_compactionBytesRead    += bytesRead;
+  document->_compactionBytesWritten += bytesWritten;
+
 
   // locate the compactor
   // must acquire a write-lock as we're about to change the datafiles vector
@@ -976,6 +1105,84 @@ static void CompactifyDatafiles (TRI_document_collection_t* document,
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a datafile qualifies for compaction on its own
+////////////////////////////////////////////////////////////////////////////////
+
+static bool IsCompactionCandidate (TRI_datafile_t const* df,
+                                   TRI_doc_datafile_info_t const* dfi,
+                                   int64_t numAliveBefore,
+                                   bool isLast) {
+  if (df->_maximalSize < COMPACTOR_MIN_SIZE && ! isLast) {
+    // very small datafile. let's compact it so it's merged with others
+    return true;
+  }
+
+  if (numAliveBefore == 0 && dfi->_numberAlive == 0 && dfi->_numberDeletion > 0) {
+    // compact first datafile(s) already if they have some deletions
+    return true;
+  }
+
+  // in all other cases, only check the number and size of "dead" objects
+  if (dfi->_sizeDead >= (int64_t) COMPACTOR_DEAD_SIZE_THRESHOLD) {
+    return true;
+  }
+
+  if (dfi->_sizeDead > 0) {
+    // the size of dead objects is above some threshold
+    double share = (double) dfi->_sizeDead / ((double) dfi->_sizeDead + (double) dfi->_sizeAlive);
+
+    if (share >= COMPACTOR_DEAD_SIZE_SHARE) {
+      // the size of dead objects is above some share
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief build the list of datafiles of a collection, in datafile order, and
+/// determine which of them qualify for compaction
+/// note: the caller must hold the datafiles lock or the collection lock
+////////////////////////////////////////////////////////////////////////////////
+
+static void CollectCandidates (TRI_document_collection_t* document,
+                               std::vector<compaction_candidate_t>& candidates,
+                               bool warn) {
+  size_t const n = document->_datafiles._length;
+  int64_t numAlive = 0;
+
+  candidates.reserve(n);
+
+  for (size_t i = 0;  i < n;  ++i) {
+    TRI_datafile_t* df = static_cast<TRI_datafile_t*>(document->_datafiles._buffer[i]);
+
+    TRI_ASSERT(df != nullptr);
+
+    TRI_doc_datafile_info_t const* dfi = TRI_FindDatafileInfoDocumentCollection(document, df->_fid, false);
+
+    if (dfi == nullptr) {
+      // datafile info not found. this shouldn't happen
+      if (warn) {
+        LOG_WARNING("datafile info not found for datafile %llu", (unsigned long long) df->_fid);
+      }
+      continue;
+    }
+
+    compaction_candidate_t candidate;
+    candidate._datafile       = df;
+    candidate._dfi            = dfi;
+    candidate._position       = i;
+    candidate._numAliveBefore = numAlive;
+    candidate._eligible       = IsCompactionCandidate(df, dfi, numAlive, i == n - 1);
+
+    candidates.push_back(candidate);
+
+    numAlive += (int64_t) dfi->_numberAlive;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief checks all datafiles of a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -1013,70 +1220,60 @@ static bool CompactifyDocumentCollection (TRI_document_collection_t* document) {
     maxSize = COMPACTOR_MAX_RESULT_FILESIZE;
   }
 
-  // copy datafile information
-  TRI_vector_t vector;
-  TRI_InitVector(&vector, TRI_UNKNOWN_MEM_ZONE, sizeof(compaction_info_t));
-  int64_t numAlive = 0;
-  bool compactNext = false;
+  std::vector<compaction_candidate_t> candidates;
+  CollectCandidates(document, candidates, true);
 
-  for (size_t i = 0;  i < n;  ++i) {
-    TRI_doc_datafile_info_t* dfi;
-    compaction_info_t compaction;
-    uint64_t totalSize = 0;
-    bool shouldCompact;
+  // pick the run of datafiles that will reclaim the most bytes. ties are
+  // broken in favor of older datafiles
+  size_t const m = candidates.size();
+  size_t bestStart = m;
+  size_t bestEnd = m;
+  int64_t bestSize = -1;
 
-    TRI_datafile_t* df = static_cast<TRI_datafile_t*>(document->_datafiles._buffer[i]);
+  for (size_t i = 0; i < m; ++i) {
+    if (! candidates[i]._eligible) {
+      continue;
+    }
 
-    TRI_ASSERT(df != nullptr);
+    // once we have found a datafile eligible for compaction, we also
+    // compact the datafiles following it, so they are merged. we stop at
+    // the first few datafiles.
+    // this is better than going over all datafiles in a collection in one go
+    // because collecting all datafiles might take a long time (it might even
+    // be that there is a request to delete the collection in the middle of
+    // compaction, but the compactor will not pick this up as it is
+    // read-locking the collection status)
+    int64_t reclaimable = 0;
+    uint64_t totalSize = 0;
+    size_t j = i;
 
-    dfi = TRI_FindDatafileInfoDocumentCollection(document, df->_fid, false);
+    while (j < m) {
+      reclaimable += candidates[j]._dfi->_sizeDead;
+      totalSize += (uint64_t) candidates[j]._datafile->_maximalSize;
+      ++j;
 
-    if (dfi == nullptr) {
-      // datafile info not found. this shouldn't happen
-      LOG_WARNING("datafile info not found for datafile %llu", (unsigned long long) df->_fid);
-      continue;
+      if (j - i >= COMPACTOR_MAX_FILES ||
+          totalSize >= maxSize) {
+        // found enough to compact
+        break;
+      }
     }
 
-    shouldCompact = false;
-  
-    if (! compactNext &&
-        df->_maximalSize < COMPACTOR_MIN_SIZE &&
-        i < n - 1) {
-      // very small datafile. let's compact it so it's merged with others
-      shouldCompact = true;
-      compactNext = true;
-    }
-    else if (numAlive == 0 && dfi->_numberAlive == 0 && dfi->_numberDeletion > 0) {
-      // compact first datafile(s) already if they have some deletions
-      shouldCompact = true;
-      compactNext = true;
-    }
-    else {
-      // in all other cases, only check the number and size of "dead" objects
-      if (dfi->_sizeDead >= (int64_t) COMPACTOR_DEAD_SIZE_THRESHOLD) {
-        shouldCompact = true;
-        compactNext = true;
-      }
-      else if (dfi->_sizeDead > 0) {
-        // the size of dead objects is above some threshold
-        double share = (double) dfi->_sizeDead / ((double) dfi->_sizeDead + (double) dfi->_sizeAlive);
-
-        if (share >= COMPACTOR_DEAD_SIZE_SHARE) {
-          // the size of dead objects is above some share
-          shouldCompact = true;
-          compactNext = true;
-        }
-      }
+    if (reclaimable > bestSize) {
+      bestStart = i;
+      bestEnd = j;
+      bestSize = reclaimable;
     }
+  }
 
-    if (! shouldCompact) {
-      // only use those datafiles that contain dead objects
+  // copy datafile information
+  TRI_vector_t vector;
+  TRI_InitVector(&vector, TRI_UNKNOWN_MEM_ZONE, sizeof(compaction_info_t));
 
-      if (! compactNext) {
-        numAlive += (int64_t) dfi->_numberAlive;
-        continue;
-      }
-    }
+  for (size_t i = bestStart; i < bestEnd; ++i) {
+    compaction_candidate_t const& candidate = candidates[i];
+    TRI_datafile_t* df = candidate._datafile;
+    TRI_doc_datafile_info_t const* dfi = candidate._dfi;
 
     LOG_TRACE("found datafile eligible for compaction. fid: %llu, size: %llu "
               "numberDead: %llu, numberAlive: %llu, numberDeletion: %llu, "
@@ -1096,27 +1293,12 @@ static bool CompactifyDocumentCollection (TRI_document_collection_t* document) {
               (unsigned long long) dfi->_sizeShapes,
               (unsigned long long) dfi->_sizeAttributes,
               (unsigned long long) dfi->_sizeTransactions);
-    totalSize += (uint64_t) df->_maximalSize;
 
+    compaction_info_t compaction;
     compaction._datafile = df;
-    compaction._keepDeletions = (numAlive > 0 && i > 0);
+    compaction._keepDeletions = (candidate._numAliveBefore > 0 && candidate._position > 0);
 
     TRI_PushBackVector(&vector, &compaction);
-
-    // we stop at the first few datafiles.
-    // this is better than going over all datafiles in a collection in one go
-    // because the compactor is single-threaded, and collecting all datafiles
-    // might take a long time (it might even be that there is a request to
-    // delete the collection in the middle of compaction, but the compactor
-    // will not pick this up as it is read-locking the collection status)
-
-    if (TRI_LengthVector(&vector) >= COMPACTOR_MAX_FILES ||
-        totalSize >= maxSize) {
-      // found enough to compact
-      break;
-    }
-
-    numAlive += (int64_t) dfi->_numberAlive;
   }
 
   // can now continue without the lock
@@ -1199,10 +1381,140 @@ static bool CheckAndLockCompaction (TRI_vocbase_t* vocbase) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief determine the number of bytes compaction could reclaim in a
+/// collection. returns 0 if the collection cannot be compacted now
+////////////////////////////////////////////////////////////////////////////////
+
+static int64_t ReclaimableSize (TRI_vocbase_col_t* collection) {
+  if (! TRI_TRY_READ_LOCK_STATUS_VOCBASE_COL(collection)) {
+    // if we can't acquire the read lock instantly, we continue directly
+    return 0;
+  }
+
+  int64_t size = 0;
+  TRI_document_collection_t* document = collection->_collection;
+
+  if (document != nullptr &&
+      collection->_status == TRI_VOC_COL_STATUS_LOADED &&
+      document->_info._doCompact) {
+    if (TRI_TRY_READ_LOCK_DATAFILES_DOC_COLLECTION(document)) {
+      TRI_voc_ssize_t count;
+      TRI_BacklogCompactorVocBase(document, &count, &size);
+
+      TRI_READ_UNLOCK_DATAFILES_DOC_COLLECTION(document);
+    }
+  }
+
+  TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
+
+  return size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compact a single collection, if it is due. returns whether any
+/// datafiles were compacted
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CompactifyCollection (TRI_vocbase_t* vocbase,
+                                  TRI_vocbase_col_t* collection,
+                                  double now) {
+  if (! TRI_TRY_READ_LOCK_STATUS_VOCBASE_COL(collection)) {
+    // if we can't acquire the read lock instantly, we continue directly
+    // we don't want to stall here for too long
+    return false;
+  }
+
+  TRI_document_collection_t* document = collection->_collection;
+
+  if (document == nullptr) {
+    TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
+    return false;
+  }
+
+  bool worked    = false;
+  bool doCompact = document->_info._doCompact;
+
+  // for document collection, compactify datafiles
+  if (collection->_status == TRI_VOC_COL_STATUS_LOADED && doCompact) {
+    // check whether someone else holds a read-lock on the compaction lock
+    if (! TRI_TryWriteLockReadWriteLock(&document->_compactionLock)) {
+      // someone else is holding the compactor lock, we'll not compact
+      TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
+      return false;
+    }
+
+    if (document->_lastCompaction + COMPACTOR_COLLECTION_INTERVAL <= now) {
+      TRI_barrier_t* ce = TRI_CreateBarrierCompaction(&document->_barrierList);
+
+      if (ce == nullptr) {
+        // out of memory
+        LOG_WARNING("out of memory when trying to create a barrier element");
+      }
+      else {
+        worked = CompactifyDocumentCollection(document);
+
+        if (! worked) {
+          // set compaction stamp
+          document->_lastCompaction = now;
+        }
+        // if we worked, then we don't set the compaction stamp to force another round of compaction
+
+        TRI_FreeBarrier(ce);
+      }
+    }
+
+    // read-unlock the compaction lock
+    TRI_WriteUnlockReadWriteLock(&document->_compactionLock);
+  }
+
+  TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
+
+  if (worked) {
+    // signal the cleanup thread that we worked and that it can now wake up
+    TRI_LockCondition(&vocbase->_cleanupCondition);
+    TRI_SignalCondition(&vocbase->_cleanupCondition);
+    TRI_UnlockCondition(&vocbase->_cleanupCondition);
+  }
+
+  return worked;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  public functions
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief configure the compaction
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_ConfigureCompactorVocBase (triagens::basics::ThreadPool* pool,
+                                    uint64_t maxRate) {
+  CompactorPool    = pool;
+  CompactorMaxRate = maxRate;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief determine the compaction backlog of a collection
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_BacklogCompactorVocBase (TRI_document_collection_t* document,
+                                  TRI_voc_ssize_t* count,
+                                  int64_t* size) {
+  std::vector<compaction_candidate_t> candidates;
+  CollectCandidates(document, candidates, false);
+
+  *count = 0;
+  *size  = 0;
+
+  for (auto const& candidate : candidates) {
+    if (candidate._eligible) {
+      ++(*count);
+      *size += candidate._dfi->_sizeDead;
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief initialise the compaction blockers structure
 ////////////////////////////////////////////////////////////////////////////////
@@ -1389,6 +1701,11 @@ void TRI_CompactorVocBase (void* data) {
     // keep initial _state value as vocbase->_state might change during compaction loop
     int state = vocbase->_state;
 
+    // pause between runs while compaction is ahead of the rate limit. no
+    // locks are held here, so data-modification operations and the collector
+    // are not affected
+    ThrottleCompaction(vocbase);
+
     // check if compaction is currently disallowed
     if (CheckAndLockCompaction(vocbase)) {
       // compaction is currently allowed
@@ -1402,70 +1719,44 @@ void TRI_CompactorVocBase (void* data) {
 
       size_t const n = collections._length;
 
+      // compact the collections with the most reclaimable bytes first
+      std::vector<std::pair<TRI_vocbase_col_t*, int64_t>> candidates;
+      candidates.reserve(n);
+
       for (size_t i = 0;  i < n;  ++i) {
         TRI_vocbase_col_t* collection = static_cast<TRI_vocbase_col_t*>(collections._buffer[i]);
 
-        if (! TRI_TRY_READ_LOCK_STATUS_VOCBASE_COL(collection)) {
-          // if we can't acquire the read lock instantly, we continue directly
-          // we don't want to stall here for too long
-          continue;
-        }
-
-        TRI_document_collection_t* document = collection->_collection;
-
-        if (document == nullptr) {
-          TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
-          continue;
-        }
-
-        bool worked    = false;
-        bool doCompact = document->_info._doCompact;
-
-        // for document collection, compactify datafiles
-        if (collection->_status == TRI_VOC_COL_STATUS_LOADED && doCompact) {
-          // check whether someone else holds a read-lock on the compaction lock
-          if (! TRI_TryWriteLockReadWriteLock(&document->_compactionLock)) {
-            // someone else is holding the compactor lock, we'll not compact
-            TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
-            continue;
-          }
-
-          if (document->_lastCompaction + COMPACTOR_COLLECTION_INTERVAL <= now) {
-            TRI_barrier_t* ce = TRI_CreateBarrierCompaction(&document->_barrierList);
-
-            if (ce == nullptr) {
-              // out of memory
-              LOG_WARNING("out of memory when trying to create a barrier element");
-            }
-            else {
-              worked = CompactifyDocumentCollection(document);
+        candidates.emplace_back(collection, ReclaimableSize(collection));
+      }
 
-              if (! worked) {
-                // set compaction stamp
-                document->_lastCompaction = now;
-              }
-              // if we worked, then we don't set the compaction stamp to force another round of compaction
+      std::stable_sort(candidates.begin(), candidates.end(), [] (std::pair<TRI_vocbase_col_t*, int64_t> const& lhs,
+                                                                 std::pair<TRI_vocbase_col_t*, int64_t> const& rhs) {
+        return lhs.second > rhs.second;
+      });
 
-              TRI_FreeBarrier(ce);
-            }
-          }
+      std::atomic<int> compacted(0);
 
-          // read-unlock the compaction lock
-          TRI_WriteUnlockReadWriteLock(&document->_compactionLock);
+      auto compact = [&] (size_t i) -> int {
+        if (CompactifyCollection(vocbase, candidates[i].first, now)) {
+          ++compacted;
         }
-
-        TRI_READ_UNLOCK_STATUS_VOCBASE_COL(collection);
-
-        if (worked) {
-          ++numCompacted;
-
-          // signal the cleanup thread that we worked and that it can now wake up
-          TRI_LockCondition(&vocbase->_cleanupCondition);
-          TRI_SignalCondition(&vocbase->_cleanupCondition);
-          TRI_UnlockCondition(&vocbase->_cleanupCondition);
+        return TRI_ERROR_NO_ERROR;
+      };
+
+      if (CompactorPool != nullptr && n > 1) {
+        // different collections are compacted in parallel. the pool hands out
+        // the collections in order, so the ones with the most reclaimable
+        // bytes are still started first
+        CompactorPool->parallelFor(n, compact);
+      }
+      else {
+        for (size_t i = 0;  i < n;  ++i) {
+          compact(i);
         }
       }
 
+      numCompacted = compacted.load();
+
       UnlockCompaction(vocbase);
     }
 
@@ -34,8 +34,15 @@
 
 #include "VocBase/voc-types.h"
 
+struct TRI_document_collection_t;
 struct TRI_vocbase_s;
 
+namespace triagens {
+  namespace basics {
+    class ThreadPool;
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                  public functions
 // -----------------------------------------------------------------------------
@@ -95,6 +102,27 @@ bool TRI_CheckAndLockCompactorVocBase (struct TRI_vocbase_s*);
 
 void TRI_UnlockCompactorVocBase (struct TRI_vocbase_s*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief configure the compaction. the thread pool (which may be a nullptr)
+/// is shared by the compactor threads of all databases and is used to compact
+/// multiple collections in parallel. the maximum rate is the number of bytes
+/// per second all compactions may read and write (0 = unlimited)
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_ConfigureCompactorVocBase (triagens::basics::ThreadPool*,
+                                    uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief determine the compaction backlog of a collection, i.e. the number
+/// of datafiles that qualify for compaction and the number of bytes that
+/// compacting them would reclaim
+/// note: the caller must hold the datafiles lock or the collection lock
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_BacklogCompactorVocBase (struct TRI_document_collection_t*,
+                                  TRI_voc_ssize_t*,
+                                  int64_t*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief compactor event loop
 ////////////////////////////////////////////////////////////////////////////////
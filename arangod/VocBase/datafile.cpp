@@ -138,14 +138,9 @@ static int TruncateDatafile (TRI_datafile_t* const datafile, const off_t length)
 /// @brief checks a CRC of a marker
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool CheckCrcMarker (TRI_df_marker_t const* marker,
+static bool CheckCrcMarker (TRI_df_version_t version,
+                            TRI_df_marker_t const* marker,
                             char const* end) {
-  TRI_voc_size_t zero = 0;
-  off_t o = offsetof(TRI_df_marker_t, _crc);
-  size_t n = sizeof(TRI_voc_crc_t);
-
-  char const* ptr = (char const*) marker;
-
   if (marker->_size < sizeof(TRI_df_marker_t)) {
     return false;
   }
@@ -154,15 +149,7 @@ static bool CheckCrcMarker (TRI_df_marker_t const* marker,
     return false;
   }
 
-  TRI_voc_crc_t crc = TRI_InitialCrc32();
-
-  crc = TRI_BlockCrc32(crc, ptr, o);
-  crc = TRI_BlockCrc32(crc, (char*) &zero, n);
-  crc = TRI_BlockCrc32(crc, ptr + o + n, marker->_size - o - n);
-
-  crc = TRI_FinalCrc32(crc);
-
-  return marker->_crc == crc;
+  return marker->_crc == TRI_CrcMarkerDatafile(version, marker);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -235,6 +222,7 @@ static void InitDatafile (TRI_datafile_t* datafile,
                           TRI_voc_size_t maximalSize,
                           TRI_voc_size_t currentSize,
                           TRI_voc_fid_t fid,
+                          TRI_df_version_t version,
                           char* data) {
 
   // filename is a string for physical datafiles, and NULL for anonymous regions
@@ -256,6 +244,7 @@ static void InitDatafile (TRI_datafile_t* datafile,
   datafile->_maximalSize = maximalSize;
   datafile->_currentSize = currentSize;
   datafile->_footerSize  = sizeof(TRI_df_footer_marker_t);
+  datafile->_version     = version;
 
   datafile->_isSealed    = false;
   datafile->_lastError   = TRI_ERROR_NO_ERROR;
@@ -523,7 +512,7 @@ static TRI_df_scan_t ScanDatafile (TRI_datafile_t const* datafile) {
       return scan;
     }
 
-    ok = CheckCrcMarker(marker, end);
+    ok = CheckCrcMarker(datafile->_version, marker, end);
 
     if (! ok) {
       entry._status = 5;
@@ -665,7 +654,7 @@ static bool CheckDatafile (TRI_datafile_t* datafile,
     }
 
     if (marker->_type != 0) {
-      bool ok = CheckCrcMarker(marker, end);
+      bool ok = CheckCrcMarker(datafile->_version, marker, end);
 
       if (! ok) {
         if (marker->_size > 0) {
@@ -768,7 +757,7 @@ static int WriteInitialHeaderMarker (TRI_datafile_t* datafile,
   TRI_InitMarkerDatafile((char*) &header, TRI_DF_MARKER_HEADER, sizeof(TRI_df_header_marker_t));
   header.base._tick = (TRI_voc_tick_t) fid;
 
-  header._version     = TRI_DF_VERSION;
+  header._version     = datafile->_version;
   header._maximalSize = maximalSize;
   header._fid         = fid;
 
@@ -862,13 +851,15 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
   
   char const* end = static_cast<char const*>(ptr) + len;
 
-  // check CRC
-  ok = CheckCrcMarker(&header.base, end);
+  // check the datafile version first, as it determines the checksum type
+  ok = TRI_IsKnownVersionDatafile(header._version);
 
   if (! ok) {
     TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
 
-    LOG_ERROR("corrupted datafile header read from '%s'", filename);
+    LOG_ERROR("unknown datafile version '%u' in datafile '%s'",
+              (unsigned int) header._version,
+              filename);
 
     if (! ignoreErrors) {
       TRI_CLOSE(fd);
@@ -876,14 +867,14 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
     }
   }
 
-  // check the datafile version
+  // check CRC
   if (ok) {
-    if (header._version != TRI_DF_VERSION) {
+    ok = CheckCrcMarker(header._version, &header.base, end);
+
+    if (! ok) {
       TRI_set_errno(TRI_ERROR_ARANGO_CORRUPTED_DATAFILE);
 
-      LOG_ERROR("unknown datafile version '%u' in datafile '%s'",
-                (unsigned int) header._version,
-                filename);
+      LOG_ERROR("corrupted datafile header read from '%s'", filename);
 
       if (! ignoreErrors) {
         TRI_CLOSE(fd);
@@ -892,6 +883,13 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
     }
   }
 
+  // fall back to the oldest version if the header cannot be trusted
+  TRI_df_version_t version = TRI_DF_VERSION_1;
+
+  if (TRI_IsKnownVersionDatafile(header._version)) {
+    version = header._version;
+  }
+
   // check the maximal size
   if (size > header._maximalSize) {
     LOG_DEBUG("datafile '%s' has size '%u', but maximal size is '%u'",
@@ -928,6 +926,7 @@ static TRI_datafile_t* OpenDatafile (char const* filename,
                size,
                size,
                fid,
+               version,
                static_cast<char*>(data));
 
   return datafile;
@@ -1072,6 +1071,7 @@ TRI_datafile_t* TRI_CreateAnonymousDatafile (TRI_voc_fid_t fid,
                maximalSize,
                0,
                fid,
+               TRI_DF_VERSION,
                static_cast<char*>(data));
 
   return datafile;
@@ -1132,6 +1132,7 @@ TRI_datafile_t* TRI_CreatePhysicalDatafile (char const* filename,
                maximalSize,
                0,
                fid,
+               TRI_DF_VERSION,
                static_cast<char*>(data));
 
   return datafile;
@@ -1289,6 +1290,45 @@ bool TRI_IsValidMarkerDatafile (TRI_df_marker_t const* marker) {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether a datafile version is known
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_IsKnownVersionDatafile (TRI_df_version_t version) {
+  return (version == TRI_DF_VERSION_1 || version == TRI_DF_VERSION_2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes the checksum of a marker for a datafile version
+///
+/// version 1 datafiles use CRC32, all later versions use CRC32C, which is
+/// computed by the CPU's crc32 instruction if available
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_voc_crc_t TRI_CrcMarkerDatafile (TRI_df_version_t version,
+                                     TRI_df_marker_t const* marker) {
+  TRI_voc_crc_t zero = 0;
+  off_t o = offsetof(TRI_df_marker_t, _crc);
+  size_t n = sizeof(TRI_voc_crc_t);
+
+  char const* ptr = (char const*) marker;
+
+  TRI_voc_crc_t crc = TRI_InitialCrc32();
+
+  if (version == TRI_DF_VERSION_1) {
+    crc = TRI_BlockCrc32(crc, ptr, o);
+    crc = TRI_BlockCrc32(crc, (char*) &zero, n);
+    crc = TRI_BlockCrc32(crc, ptr + o + n, marker->_size - o - n);
+  }
+  else {
+    crc = TRI_BlockCrc32C(crc, ptr, o);
+    crc = TRI_BlockCrc32C(crc, (char*) &zero, n);
+    crc = TRI_BlockCrc32C(crc, ptr + o + n, marker->_size - o - n);
+  }
+
+  return TRI_FinalCrc32(crc);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief reserves room for an element, advances the pointer
 ///
@@ -1527,10 +1567,7 @@ int TRI_WriteCrcElementDatafile (TRI_datafile_t* datafile,
   TRI_ASSERT(marker->_tick != 0);
 
   if (datafile->isPhysical(datafile)) {
-    TRI_voc_crc_t crc = TRI_InitialCrc32();
-
-    crc = TRI_BlockCrc32(crc, (char const*) marker, marker->_size);
-    marker->_crc = TRI_FinalCrc32(crc);
+    marker->_crc = TRI_CrcMarkerDatafile(datafile->_version, marker);
   }
 
   return TRI_WriteElementDatafile(datafile, position, marker, forceSync);
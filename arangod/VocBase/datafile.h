@@ -96,10 +96,22 @@
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief datafile version
+/// @brief datafile version 1, markers are checksummed using CRC32
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_VERSION_1        (1)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief datafile version 2, markers are checksummed using CRC32C
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DF_VERSION_2        (2)
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief datafile version used for new datafiles
 ////////////////////////////////////////////////////////////////////////////////
 
-#define TRI_DF_VERSION          (1)
+#define TRI_DF_VERSION          (TRI_DF_VERSION_2)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief alignment in datafile blocks
@@ -261,6 +273,7 @@ typedef struct TRI_datafile_s {
   TRI_voc_size_t _maximalSize;   // maximale size of the datafile
   TRI_voc_size_t _currentSize;   // current size of the datafile
   TRI_voc_size_t _footerSize;    // size of the final footer
+  TRI_df_version_t _version;     // datafile version, determines the checksum type
 
   char* _data;                   // start of the data array
   char* _next;                   // end of the current data
@@ -659,6 +672,21 @@ void TRI_InitMarkerDatafile (char*,
 
 bool TRI_IsValidMarkerDatafile (TRI_df_marker_t const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks whether a datafile version is known
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_IsKnownVersionDatafile (TRI_df_version_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes the checksum of a marker for a datafile version
+///
+/// the checksum is computed as if the marker's _crc field is equal to 0
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_voc_crc_t TRI_CrcMarkerDatafile (TRI_df_version_t,
+                                     TRI_df_marker_t const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief reserves room for an element, advances the pointer
 ////////////////////////////////////////////////////////////////////////////////
@@ -33,9 +33,11 @@
 #include "Basics/conversions.h"
 #include "Basics/files.h"
 #include "Basics/logging.h"
+#include "Basics/memory-map.h"
 #include "Basics/tri-strings.h"
 #include "Basics/ThreadPool.h"
 #include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
 #include "CapConstraint/cap-constraint.h"
 #include "FulltextIndex/fulltext-index.h"
 #include "GeoIndex/geo-index.h"
@@ -45,6 +47,7 @@
 #include "Utils/transactions.h"
 #include "Utils/CollectionReadLocker.h"
 #include "Utils/CollectionWriteLocker.h"
+#include "VocBase/compactor.h"
 #include "VocBase/edge-collection.h"
 #include "VocBase/index.h"
 #include "VocBase/key-generator.h"
@@ -112,7 +115,10 @@ void TRI_doc_mptr_copy_t::setDataPtr (void const* d) {
 TRI_document_collection_t::TRI_document_collection_t () 
   : _useSecondaryIndexes(true),
     _keyGenerator(nullptr),
-    _uncollectedLogfileEntries(0) {
+    _uncollectedLogfileEntries(0),
+    _compactionRuns(0),
+    _compactionBytesRead(0),
+    _compactionBytesWritten(0) {
 
   _tickMax = 0;
 }
@@ -146,6 +152,17 @@ TRI_shaper_t* TRI_document_collection_t::getShaper () const {
 
 int TRI_AddOperationTransaction (triagens::wal::DocumentOperation&, bool&);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not single-document write operations use document-level
+/// locking instead of exclusive collection locks
+////////////////////////////////////////////////////////////////////////////////
+
+static bool DocumentLevelLocking = false;
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                              forward declarations
 // -----------------------------------------------------------------------------
@@ -589,23 +606,12 @@ static inline TRI_voc_rid_t GetRevisionId (TRI_voc_rid_t previous) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief insert a document
+/// @brief insert a new document into the indexes
 ////////////////////////////////////////////////////////////////////////////////
 
-static int InsertDocument (TRI_transaction_collection_t* trxCollection,
-                           TRI_doc_mptr_t* header,
-                           triagens::wal::DocumentOperation& operation,
-                           TRI_doc_mptr_copy_t* mptr,
-                           bool& waitForSync) {
-
-  TRI_ASSERT(header != nullptr);
-  TRI_ASSERT(mptr != nullptr);
-  TRI_document_collection_t* document = trxCollection->_collection->_collection;
-
-  // .............................................................................
-  // insert into indexes
-  // .............................................................................
-
+static int InsertDocumentIndexes (TRI_document_collection_t* document,
+                                  TRI_doc_mptr_t* header,
+                                  triagens::wal::DocumentOperation& operation) {
   // insert into primary index first
   int res = InsertPrimaryIndex(document, header, false);
 
@@ -627,6 +633,33 @@ static int InsertDocument (TRI_transaction_collection_t* trxCollection,
 
   operation.indexed();
 
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief insert a document
+////////////////////////////////////////////////////////////////////////////////
+
+static int InsertDocument (TRI_transaction_collection_t* trxCollection,
+                           TRI_doc_mptr_t* header,
+                           triagens::wal::DocumentOperation& operation,
+                           TRI_doc_mptr_copy_t* mptr,
+                           bool& waitForSync) {
+
+  TRI_ASSERT(header != nullptr);
+  TRI_ASSERT(mptr != nullptr);
+  TRI_document_collection_t* document = trxCollection->_collection->_collection;
+
+  // .............................................................................
+  // insert into indexes
+  // .............................................................................
+
+  int res = InsertDocumentIndexes(document, header, operation);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
   TRI_IF_FAILURE("InsertDocumentNoOperation") {
     return TRI_ERROR_DEBUG;
   }
@@ -671,16 +704,41 @@ static int LookupDocument (TRI_document_collection_t* document,
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief updates an existing document
+/// @brief removes a document from the indexes and unlinks its header
 ////////////////////////////////////////////////////////////////////////////////
 
-static int UpdateDocument (TRI_transaction_collection_t* trxCollection,
-                           TRI_doc_mptr_t* oldHeader,
-                           triagens::wal::DocumentOperation& operation,
-                           TRI_doc_mptr_copy_t* mptr,
-                           bool syncRequested) {
-  TRI_document_collection_t* document = trxCollection->_collection->_collection;
+static int RemoveDocumentIndexes (TRI_document_collection_t* document,
+                                  TRI_doc_mptr_t* header,
+                                  triagens::wal::DocumentOperation& operation) {
+  int res = DeleteSecondaryIndexes(document, header, false);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    InsertSecondaryIndexes(document, header, true);
+    return res;
+  }
+
+  res = DeletePrimaryIndex(document, header, false);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    InsertSecondaryIndexes(document, header, true);
+    return res;
+  }
+
+  operation.indexed();
+
+  document->_headersPtr->unlink(header);  // PROTECTED by trx in trxCollection
+  document->_numberDocuments--;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief updates the header and the secondary indexes of an existing document
+////////////////////////////////////////////////////////////////////////////////
 
+static int UpdateDocumentIndexes (TRI_document_collection_t* document,
+                                  TRI_doc_mptr_t* oldHeader,
+                                  triagens::wal::DocumentOperation& operation) {
   // save the old data, remember
   TRI_doc_mptr_copy_t oldData = *oldHeader;
 
@@ -727,6 +785,26 @@ static int UpdateDocument (TRI_transaction_collection_t* trxCollection,
 
   operation.indexed();
 
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief updates an existing document
+////////////////////////////////////////////////////////////////////////////////
+
+static int UpdateDocument (TRI_transaction_collection_t* trxCollection,
+                           TRI_doc_mptr_t* oldHeader,
+                           triagens::wal::DocumentOperation& operation,
+                           TRI_doc_mptr_copy_t* mptr,
+                           bool syncRequested) {
+  TRI_document_collection_t* document = trxCollection->_collection->_collection;
+
+  int res = UpdateDocumentIndexes(document, oldHeader, operation);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
   TRI_IF_FAILURE("UpdateDocumentNoOperation") {
     return TRI_ERROR_DEBUG;
   }
@@ -739,7 +817,7 @@ static int UpdateDocument (TRI_transaction_collection_t* trxCollection,
 
   if (res == TRI_ERROR_NO_ERROR) {
     // write new header into result
-    *mptr = *((TRI_doc_mptr_t*) newHeader);
+    *mptr = *oldHeader;
   }
 
   return res;
@@ -877,6 +955,7 @@ static int BeginRead (TRI_document_collection_t* document) {
   // LOCKING-DEBUG
   // std::cout << "BeginRead: " << document->_info._name << std::endl;
   TRI_READ_LOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
+  TRI_ReadLockReadWriteLock(&document->_documentsLock);
 
   return TRI_ERROR_NO_ERROR;
 }
@@ -898,6 +977,7 @@ static int EndRead (TRI_document_collection_t* document) {
   }
   // LOCKING-DEBUG
   // std::cout << "EndRead: " << document->_info._name << std::endl;
+  TRI_ReadUnlockReadWriteLock(&document->_documentsLock);
   TRI_READ_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
 
   return TRI_ERROR_NO_ERROR;
@@ -982,6 +1062,23 @@ static int BeginReadTimed (TRI_document_collection_t* document,
     }
   }
 
+  // the documents lock is only held exclusively for a short time by
+  // single-document writers
+  while (! TRI_TryReadLockReadWriteLock(&document->_documentsLock)) {
+#ifdef _WIN32
+    usleep((unsigned long) sleepPeriod);
+#else
+    usleep((useconds_t) sleepPeriod);
+#endif
+
+    waited += sleepPeriod;
+
+    if (waited > timeout) {
+      TRI_READ_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
+      return TRI_ERROR_LOCK_TIMEOUT;
+    }
+  }
+
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -1931,6 +2028,12 @@ static TRI_doc_collection_info_t* Figures (TRI_document_collection_t* document)
   info->_uncollectedLogfileEntries = document->_uncollectedLogfileEntries;
   info->_tickMax = document->_tickMax;
 
+  // add compaction information
+  TRI_BacklogCompactorVocBase(document, &info->_compactionBacklogCount, &info->_compactionBacklogSize);
+  info->_compactionRuns         = document->_compactionRuns.load();
+  info->_compactionBytesRead    = document->_compactionBytesRead.load();
+  info->_compactionBytesWritten = document->_compactionBytesWritten.load();
+
   return info;
 }
 
@@ -1970,6 +2073,7 @@ static int InitBaseDocumentCollection (TRI_document_collection_t* document,
   TRI_InitBarrierList(&document->_barrierList, document);
 
   TRI_InitReadWriteLock(&document->_lock);
+  TRI_InitReadWriteLock(&document->_documentsLock);
   TRI_InitReadWriteLock(&document->_compactionLock);
 
   return TRI_ERROR_NO_ERROR;
@@ -1986,6 +2090,7 @@ static void DestroyBaseDocumentCollection (TRI_document_collection_t* document)
   }
 
   TRI_DestroyReadWriteLock(&document->_compactionLock);
+  TRI_DestroyReadWriteLock(&document->_documentsLock);
   TRI_DestroyReadWriteLock(&document->_lock);
 
   TRI_DestroyPrimaryIndex(&document->_primaryIndex);
@@ -3115,6 +3220,28 @@ static int FillIndex (TRI_document_collection_t* document,
     idx->sizeHint(idx, (size_t) document->_primaryIndex._nrUsed);
   }
 
+  if (idx->batchInsert != nullptr) {
+    // the index can be filled with all documents at once
+    std::vector<TRI_doc_mptr_t const*> documents;
+
+    try {
+      documents.reserve((size_t) document->_primaryIndex._nrUsed);
+
+      for (;  ptr < end;  ++ptr) {
+        if (*ptr != nullptr) {
+          documents.emplace_back(static_cast<TRI_doc_mptr_t const*>(*ptr));
+        }
+      }
+    }
+    catch (...) {
+      return TRI_ERROR_OUT_OF_MEMORY;
+    }
+
+    auto indexPool = document->_vocbase->_server->_indexPool;
+
+    return idx->batchInsert(idx, &documents, indexPool);
+  }
+
 #ifdef TRI_ENABLE_MAINTAINER_MODE
   static const int LoopSize = 10000;
   int counter = 0;
@@ -3405,6 +3532,148 @@ bool TRI_IsFullyCollectedDocumentCollection (TRI_document_collection_t* document
   return (uncollected == 0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief scans the live documents of a collection in datafile order
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_ScanDatafilesDocumentCollection (TRI_document_collection_t* document,
+                                            TRI_datafile_scan_t* position,
+                                            size_t batchSize,
+                                            bool includeWal,
+                                            std::function<void(TRI_doc_mptr_t const*)> const& callback) {
+  if (! position->_initialized) {
+    TRI_READ_LOCK_DATAFILES_DOC_COLLECTION(document);
+
+    try {
+      for (auto vector : { &document->_datafiles, &document->_journals, &document->_compactors }) {
+        for (size_t i = 0; i < vector->_length; ++i) {
+          position->_datafiles.emplace_back(static_cast<TRI_datafile_t*>(vector->_buffer[i]));
+        }
+      }
+    }
+    catch (...) {
+      TRI_READ_UNLOCK_DATAFILES_DOC_COLLECTION(document);
+      throw;
+    }
+
+    TRI_READ_UNLOCK_DATAFILES_DOC_COLLECTION(document);
+
+    position->_scanned.reserve(position->_datafiles.size());
+    position->_initialized = true;
+  }
+
+  size_t count = 0;
+
+  // first walk the datafiles
+  while (count < batchSize && position->_datafileIndex < position->_datafiles.size()) {
+    TRI_datafile_t* datafile = position->_datafiles[position->_datafileIndex];
+
+    char const* ptr = datafile->_data + position->_offset;
+    char const* end = datafile->_data + datafile->_currentSize;
+
+    if (position->_offset == 0) {
+      TRI_MMFileAdvise(datafile->_data, datafile->_currentSize, TRI_MADVISE_SEQUENTIAL);
+
+      if (position->_datafileIndex + 1 < position->_datafiles.size()) {
+        // let the operating system already read the next datafile
+        TRI_datafile_t* next = position->_datafiles[position->_datafileIndex + 1];
+        TRI_MMFileAdvise(next->_data, next->_currentSize, TRI_MADVISE_WILLNEED);
+      }
+    }
+
+    while (ptr < end && count < batchSize) {
+      TRI_df_marker_t const* marker = reinterpret_cast<TRI_df_marker_t const*>(ptr);
+
+      if (marker->_size == 0) {
+        // end of the data
+        end = ptr;
+        break;
+      }
+
+      if (marker->_type == TRI_DOC_MARKER_KEY_DOCUMENT ||
+          marker->_type == TRI_DOC_MARKER_KEY_EDGE) {
+        auto mptr = static_cast<TRI_doc_mptr_t const*>(TRI_LookupByKeyPrimaryIndex(&document->_primaryIndex, TRI_EXTRACT_MARKER_KEY(marker)));
+
+        if (mptr != nullptr && mptr->getDataPtr() == marker) {  // PROTECTED by trx from above
+          callback(mptr);
+          ++count;
+          ++position->_found;
+        }
+      }
+
+      ptr += TRI_DF_ALIGN_BLOCK(marker->_size);
+    }
+
+    if (ptr >= end) {
+      // datafile done
+      position->_scanned.emplace_back(datafile->_data, end);
+      position->_offset = 0;
+      ++position->_datafileIndex;
+
+      if (position->_datafileIndex == position->_datafiles.size()) {
+        std::sort(position->_scanned.begin(), position->_scanned.end());
+      }
+    }
+    else {
+      position->_offset = static_cast<size_t>(ptr - datafile->_data);
+    }
+  }
+
+  if (! includeWal ||
+      count >= batchSize ||
+      position->_found >= document->_primaryIndex._nrUsed) {
+    return count;
+  }
+
+  // now return the documents that are not in any of the scanned datafiles
+  auto const& scanned = position->_scanned;
+  size_t const n = document->_primaryIndex._nrAlloc;
+
+  for (; position->_primaryPosition < n && count < batchSize; ++position->_primaryPosition) {
+    auto mptr = static_cast<TRI_doc_mptr_t const*>(document->_primaryIndex._table[position->_primaryPosition]);
+
+    if (mptr == nullptr) {
+      continue;
+    }
+
+    char const* data = static_cast<char const*>(mptr->getDataPtr());  // PROTECTED by trx from above
+
+    // find the last region starting at or before the data
+    auto it = std::upper_bound(scanned.begin(), scanned.end(), std::make_pair(data, static_cast<char const*>(nullptr)),
+                               [] (std::pair<char const*, char const*> const& left,
+                                   std::pair<char const*, char const*> const& right) {
+      return left.first < right.first;
+    });
+
+    if (it != scanned.begin() && data < (it - 1)->second) {
+      // already returned from a datafile
+      continue;
+    }
+
+    callback(mptr);
+    ++count;
+  }
+
+  return count;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enable or disable document-level locking for single-document
+/// write operations
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_SetDocumentLevelLockingDocumentCollection (bool value) {
+  DocumentLevelLocking = value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not document-level locking is enabled
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_UseDocumentLevelLockingDocumentCollection () {
+  return DocumentLevelLocking;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns a description of all indexes
 ///
@@ -3434,6 +3703,30 @@ TRI_vector_pointer_t* TRI_IndexesDocumentCollection (TRI_document_collection_t*
   return vector;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rebuilds the outdated statistics of all indexes
+///
+/// the statistics are rebuilt here instead of in the writers, so inserts and
+/// removals do not have to walk the whole index. readers can proceed while
+/// the read-lock is held
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_UpdateIndexStatisticsDocumentCollection (TRI_document_collection_t* document) {
+  TRI_READ_LOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
+
+  size_t const n = document->_allIndexes._length;
+
+  for (size_t i = 0;  i < n;  ++i) {
+    TRI_index_t* idx = static_cast<TRI_index_t*>(document->_allIndexes._buffer[i]);
+
+    if (idx->updateStatistics != nullptr) {
+      idx->updateStatistics(idx);
+    }
+  }
+
+  TRI_READ_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief drops an index, including index file removal and replication
 ////////////////////////////////////////////////////////////////////////////////
@@ -3481,6 +3774,9 @@ bool TRI_DropIndexDocumentCollection (TRI_document_collection_t* document,
 
   if (found != nullptr) {
     RebuildIndexInfo(document);
+
+    // cached query plans might use the dropped index
+    TRI_InvalidateQueryCachesVocBase(vocbase, document->_info._name);
   }
 
   TRI_WRITE_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(document);
@@ -4924,57 +5220,547 @@ int TRI_RotateJournalDocumentCollection (TRI_document_collection_t* document) {
 }
 
 // -----------------------------------------------------------------------------
-// --SECTION--                                                      CRUD methods
+// --SECTION--                                            DOCUMENT-LEVEL LOCKING
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
 // -----------------------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief reads an element from the document collection
+/// @brief locks held by a single-document write operation that runs with
+/// document-level locking
+///
+/// the collection lock is held in read mode for the lifetime of the object.
+/// the documents lock can be acquired and released as needed. it is released
+/// in the destructor, so objects that must be destroyed while the documents
+/// lock is still held (e.g. DocumentOperation) must be declared after the
+/// locker
 ////////////////////////////////////////////////////////////////////////////////
 
-int TRI_ReadShapedJsonDocumentCollection (TRI_transaction_collection_t* trxCollection,
-                                          const TRI_voc_key_t key,
-                                          TRI_doc_mptr_copy_t* mptr,
-                                          bool lock) {
-  TRI_ASSERT(mptr != nullptr);
-  mptr->setDataPtr(nullptr);  // PROTECTED by trx in trxCollection
+class DocumentLevelLocker {
 
-  {
-    TRI_IF_FAILURE("ReadDocumentNoLock") {
-      // test what happens if no lock can be acquired
-      return TRI_ERROR_DEBUG;
-    }
+  public:
 
-    TRI_IF_FAILURE("ReadDocumentNoLockExcept") {
-      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read-locks the collection. if the collection has secondary indexes
+/// other than the edge index, the lock is released immediately and
+/// isLocked() will return false
+////////////////////////////////////////////////////////////////////////////////
+
+    explicit DocumentLevelLocker (TRI_document_collection_t* document)
+      : _document(document),
+        _keyLock(nullptr),
+        _documentsLocked(false),
+        _documentsWrite(false) {
+
+      TRI_READ_LOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(_document);
+
+      // the set of indexes can only change while the collection is 
+      // write-locked, so it is safe to inspect it now
+      size_t const n = _document->_allIndexes._length;
+
+      for (size_t i = 1;  i < n;  ++i) {
+        TRI_index_t const* idx = static_cast<TRI_index_t const*>(_document->_allIndexes._buffer[i]);
+
+        if (idx->_type != TRI_IDX_TYPE_EDGE_INDEX) {
+          // other index types are not prepared for concurrent writers
+          TRI_READ_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(_document);
+          _document = nullptr;
+          return;
+        }
+      }
     }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief releases all locks
+////////////////////////////////////////////////////////////////////////////////
 
-    TRI_document_collection_t* document = trxCollection->_collection->_collection;
-    triagens::arango::CollectionReadLocker collectionLocker(document, lock);
+    ~DocumentLevelLocker () {
+      if (_document == nullptr) {
+        return;
+      }
 
-    TRI_doc_mptr_t* header;
-    int res = LookupDocument(document, key, nullptr, header);
+      unlockDocuments();
 
-    if (res != TRI_ERROR_NO_ERROR) {
-      return res;
+      if (_keyLock != nullptr) {
+        _keyLock->unlock();
+      }
+
+      TRI_READ_UNLOCK_DOCUMENTS_INDEXES_PRIMARY_COLLECTION(_document);
     }
 
-    // we found a document, now copy it over
-    *mptr = *header;
-  }
+  public:
 
-  TRI_ASSERT(mptr->getDataPtr() != nullptr);  // PROTECTED by trx in trxCollection
-  TRI_ASSERT(mptr->_rid > 0);
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not document-level locking can be used
+////////////////////////////////////////////////////////////////////////////////
 
-  return TRI_ERROR_NO_ERROR;
-}
+    bool isLocked () const {
+      return _document != nullptr;
+    }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief removes a shaped-json document (or edge)
+/// @brief locks the key with the given hash value
 ////////////////////////////////////////////////////////////////////////////////
 
-int TRI_RemoveShapedJsonDocumentCollection (TRI_transaction_collection_t* trxCollection,
-                                            TRI_voc_key_t key,
+    void lockKey (uint64_t hash) {
+      TRI_ASSERT(_keyLock == nullptr);
+
+      _keyLock = &_document->_keyLocks[hash % TRI_DOCUMENT_KEY_LOCKS];
+      _keyLock->lock();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief acquires the documents lock
+////////////////////////////////////////////////////////////////////////////////
+
+    void lockDocuments (bool write) {
+      TRI_ASSERT(! _documentsLocked);
+
+      if (write) {
+        TRI_WriteLockReadWriteLock(&_document->_documentsLock);
+      }
+      else {
+        TRI_ReadLockReadWriteLock(&_document->_documentsLock);
+      }
+
+      _documentsLocked = true;
+      _documentsWrite = write;
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief releases the documents lock, if held
+////////////////////////////////////////////////////////////////////////////////
+
+    void unlockDocuments () {
+      if (! _documentsLocked) {
+        return;
+      }
+
+      if (_documentsWrite) {
+        TRI_WriteUnlockReadWriteLock(&_document->_documentsLock);
+      }
+      else {
+        TRI_ReadUnlockReadWriteLock(&_document->_documentsLock);
+      }
+
+      _documentsLocked = false;
+    }
+
+  private:
+
+    TRI_document_collection_t* _document;
+
+    triagens::basics::Mutex* _keyLock;
+
+    bool _documentsLocked;
+
+    bool _documentsWrite;
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a write operation may use document-level locking
+/// this is only the case for single-document operations that acquire the
+/// collection lock themselves
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CanUseDocumentLevelLocking (TRI_transaction_collection_t const* trxCollection,
+                                        bool lock) {
+  if (! DocumentLevelLocking || ! lock) {
+    return false;
+  }
+
+  if (triagens::arango::Transaction::_makeNolockHeaders != nullptr) {
+    return false;
+  }
+
+  TRI_transaction_t const* trx = trxCollection->_transaction;
+
+  return ((trx->_hints & (TRI_transaction_hint_t) TRI_TRANSACTION_HINT_SINGLE_OPERATION) != 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts a document using document-level locking
+///
+/// the marker is written into the WAL while only the collection read lock and
+/// the key lock are held. the in-memory state is modified afterwards under the
+/// documents write lock. sets handled to false if the operation must be
+/// carried out with an exclusive collection lock instead
+////////////////////////////////////////////////////////////////////////////////
+
+static int InsertDocumentLevel (TRI_transaction_collection_t* trxCollection,
+                                TRI_voc_rid_t rid,
+                                std::string const& keyString,
+                                uint64_t hash,
+                                triagens::wal::Marker* marker,
+                                bool freeMarker,
+                                TRI_doc_mptr_copy_t* mptr,
+                                bool forceSync,
+                                bool& handled) {
+  TRI_document_collection_t* document = trxCollection->_collection->_collection;
+
+  int res = TRI_ERROR_NO_ERROR;
+  TRI_voc_tick_t markerTick = 0;
+  {
+    DocumentLevelLocker locker(document);
+
+    if (! locker.isLocked()) {
+      handled = false;
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    handled = true;
+
+    triagens::wal::DocumentOperation operation(marker, freeMarker, trxCollection, TRI_VOC_DOCUMENT_OPERATION_INSERT, rid);
+
+    locker.lockKey(hash);
+
+    // check for a unique constraint violation before writing to the WAL
+    locker.lockDocuments(false);
+    bool const exists = (TRI_LookupByKeyPrimaryIndex(&document->_primaryIndex, keyString.c_str()) != nullptr);
+    locker.unlockDocuments();
+
+    if (exists) {
+      return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+    }
+
+    TRI_voc_fid_t fid;
+    void const* position;
+    int64_t sizeChanged;
+
+    res = TRI_WriteOperationTransaction(operation, forceSync, fid, position, sizeChanged);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+
+    locker.lockDocuments(true);
+
+    TRI_doc_mptr_t* header = operation.header = document->_headersPtr->request(marker->size());  // PROTECTED by trx in trxCollection
+
+    if (header == nullptr) {
+      res = TRI_ERROR_OUT_OF_MEMORY;
+    }
+    else {
+      header->_rid  = rid;
+      header->setDataPtr(operation.marker->mem());  // PROTECTED by trx in trxCollection
+      header->_hash = hash;
+
+      res = InsertDocumentIndexes(document, header, operation);
+
+      if (res == TRI_ERROR_NO_ERROR) {
+        res = TRI_ApplyOperationTransaction(operation, fid, position, sizeChanged);
+      }
+    }
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      operation.revert();
+
+      // the document is already in the WAL. write a remove marker so it does
+      // not re-appear on recovery
+      triagens::wal::RemoveMarker removeMarker(document->_vocbase->_id,
+                                               document->_info._cid,
+                                               GetRevisionId(0),
+                                               TRI_MarkerIdTransaction(trxCollection->_transaction),
+                                               keyString);
+
+      int res2 = triagens::wal::LogfileManager::instance()->allocateAndWrite(removeMarker, false).errorCode;
+
+      if (res2 != TRI_ERROR_NO_ERROR) {
+        LOG_ERROR("unable to revert insert of document '%s' in collection '%s': %s",
+                  keyString.c_str(),
+                  document->_info._name,
+                  TRI_errno_string(res2));
+      }
+
+      return res;
+    }
+
+    *mptr = *header;
+
+    PostInsertIndexes(trxCollection, header);
+
+    if (forceSync) {
+      markerTick = operation.tick;
+    }
+  }
+
+  if (markerTick > 0) {
+    // need to wait for tick, outside the lock
+    triagens::wal::LogfileManager::instance()->slots()->waitForTick(markerTick);
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief updates a document using document-level locking
+/// sets handled to false if the operation must be carried out with an
+/// exclusive collection lock instead
+////////////////////////////////////////////////////////////////////////////////
+
+static int UpdateDocumentLevel (TRI_transaction_collection_t* trxCollection,
+                                TRI_voc_key_t key,
+                                TRI_voc_rid_t rid,
+                                triagens::wal::Marker* marker,
+                                bool freeMarker,
+                                TRI_doc_mptr_copy_t* mptr,
+                                TRI_shaped_json_t const* shaped,
+                                TRI_doc_update_policy_t const* policy,
+                                bool forceSync,
+                                bool& handled) {
+  TRI_document_collection_t* document = trxCollection->_collection->_collection;
+
+  int res = TRI_ERROR_NO_ERROR;
+  TRI_voc_tick_t markerTick = 0;
+  {
+    DocumentLevelLocker locker(document);
+
+    if (! locker.isLocked()) {
+      handled = false;
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    handled = true;
+
+    locker.lockKey(TRI_HashKeyPrimaryIndex(key, strlen(key)));
+
+    // get the header pointer of the previous revision. as the key is locked
+    // and the collector cannot run, the header cannot be modified by others
+    TRI_doc_mptr_t* oldHeader;
+
+    locker.lockDocuments(false);
+    res = LookupDocument(document, key, policy, oldHeader);
+
+    if (res == TRI_ERROR_NO_ERROR && marker == nullptr) {
+      TRI_df_marker_t const* original = static_cast<TRI_df_marker_t const*>(oldHeader->getDataPtr());  // PROTECTED by trx in trxCollection
+
+      res = CloneMarkerNoLegend(marker, original, document, rid, trxCollection, shaped);
+
+      if (res != TRI_ERROR_NO_ERROR && marker != nullptr) {
+        // avoid memleak
+        delete marker;
+      }
+    }
+    locker.unlockDocuments();
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+
+    TRI_ASSERT(marker != nullptr);
+
+    triagens::wal::DocumentOperation operation(marker, freeMarker, trxCollection, TRI_VOC_DOCUMENT_OPERATION_UPDATE, rid);
+
+    // the indexes must be updated before the marker goes into the WAL: a
+    // failed index update cannot be compensated for in the WAL, because
+    // recovery only applies markers with a newer revision. the documents
+    // lock is held until the operation is applied, so no reader can see the
+    // header while it points to the unlogged marker
+    locker.lockDocuments(true);
+
+    operation.header = oldHeader;
+    operation.init();
+
+    res = UpdateDocumentIndexes(document, oldHeader, operation);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      operation.revert();
+      return res;
+    }
+
+    TRI_voc_fid_t fid;
+    void const* position;
+    int64_t sizeChanged;
+
+    res = TRI_WriteOperationTransaction(operation, forceSync, fid, position, sizeChanged);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      // nothing has been logged
+      operation.revert();
+      return res;
+    }
+
+    res = TRI_ApplyOperationTransaction(operation, fid, position, sizeChanged);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      operation.revert();
+
+      LOG_ERROR("unable to apply update of document '%s' in collection '%s' after writing it to the WAL: %s",
+                (char const*) key,
+                document->_info._name,
+                TRI_errno_string(res));
+      return res;
+    }
+
+    *mptr = *oldHeader;
+
+    if (forceSync) {
+      markerTick = operation.tick;
+    }
+  }
+
+  if (markerTick > 0) {
+    // need to wait for tick, outside the lock
+    triagens::wal::LogfileManager::instance()->slots()->waitForTick(markerTick);
+  }
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes a document using document-level locking
+/// sets handled to false if the operation must be carried out with an
+/// exclusive collection lock instead
+////////////////////////////////////////////////////////////////////////////////
+
+static int RemoveDocumentLevel (TRI_transaction_collection_t* trxCollection,
+                                TRI_voc_key_t key,
+                                TRI_voc_rid_t rid,
+                                triagens::wal::Marker* marker,
+                                bool freeMarker,
+                                TRI_doc_update_policy_t const* policy,
+                                bool forceSync,
+                                bool& handled) {
+  TRI_document_collection_t* document = trxCollection->_collection->_collection;
+
+  int res = TRI_ERROR_NO_ERROR;
+  TRI_voc_tick_t markerTick = 0;
+  {
+    DocumentLevelLocker locker(document);
+
+    if (! locker.isLocked()) {
+      handled = false;
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    handled = true;
+
+    // the operation releases the header of the removed document when it is
+    // destroyed, so it must be declared after the locker
+    triagens::wal::DocumentOperation operation(marker, freeMarker, trxCollection, TRI_VOC_DOCUMENT_OPERATION_REMOVE, rid);
+
+    locker.lockKey(TRI_HashKeyPrimaryIndex(key, strlen(key)));
+
+    TRI_doc_mptr_t* header;
+
+    locker.lockDocuments(false);
+    res = LookupDocument(document, key, policy, header);
+    locker.unlockDocuments();
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+
+    // as for updates, the indexes are modified before the marker is written
+    // into the WAL, so a failure does not leave a logged remove behind
+    locker.lockDocuments(true);
+
+    TRI_ASSERT(header != nullptr);
+    operation.header = header;
+    operation.init();
+
+    res = RemoveDocumentIndexes(document, header, operation);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      operation.revert();
+      return res;
+    }
+
+    TRI_voc_fid_t fid;
+    void const* position;
+    int64_t sizeChanged;
+
+    res = TRI_WriteOperationTransaction(operation, forceSync, fid, position, sizeChanged);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      // nothing has been logged
+      operation.revert();
+      return res;
+    }
+
+    res = TRI_ApplyOperationTransaction(operation, fid, position, sizeChanged);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      operation.revert();
+
+      LOG_ERROR("unable to apply removal of document '%s' in collection '%s' after writing it to the WAL: %s",
+                (char const*) key,
+                document->_info._name,
+                TRI_errno_string(res));
+      return res;
+    }
+
+    if (forceSync) {
+      markerTick = operation.tick;
+    }
+  }
+
+  if (markerTick > 0) {
+    // need to wait for tick, outside the lock
+    triagens::wal::LogfileManager::instance()->slots()->waitForTick(markerTick);
+  }
+
+  return res;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      CRUD methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief reads an element from the document collection
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_ReadShapedJsonDocumentCollection (TRI_transaction_collection_t* trxCollection,
+                                          const TRI_voc_key_t key,
+                                          TRI_doc_mptr_copy_t* mptr,
+                                          bool lock) {
+  TRI_ASSERT(mptr != nullptr);
+  mptr->setDataPtr(nullptr);  // PROTECTED by trx in trxCollection
+
+  {
+    TRI_IF_FAILURE("ReadDocumentNoLock") {
+      // test what happens if no lock can be acquired
+      return TRI_ERROR_DEBUG;
+    }
+
+    TRI_IF_FAILURE("ReadDocumentNoLockExcept") {
+      THROW_ARANGO_EXCEPTION(TRI_ERROR_DEBUG);
+    }
+
+
+    TRI_document_collection_t* document = trxCollection->_collection->_collection;
+    triagens::arango::CollectionReadLocker collectionLocker(document, lock);
+
+    TRI_doc_mptr_t* header;
+    int res = LookupDocument(document, key, nullptr, header);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+
+    // we found a document, now copy it over
+    *mptr = *header;
+  }
+
+  TRI_ASSERT(mptr->getDataPtr() != nullptr);  // PROTECTED by trx in trxCollection
+  TRI_ASSERT(mptr->_rid > 0);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes a shaped-json document (or edge)
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_RemoveShapedJsonDocumentCollection (TRI_transaction_collection_t* trxCollection,
+                                            TRI_voc_key_t key,
                                             TRI_voc_rid_t rid,
                                             triagens::wal::Marker* marker,
                                             TRI_doc_update_policy_t const* policy,
@@ -5008,6 +5794,15 @@ int TRI_RemoveShapedJsonDocumentCollection (TRI_transaction_collection_t* trxCol
 
   TRI_ASSERT(marker != nullptr);
 
+  if (CanUseDocumentLevelLocking(trxCollection, lock)) {
+    bool handled;
+    int res = RemoveDocumentLevel(trxCollection, key, rid, marker, freeMarker, policy, forceSync, handled);
+
+    if (handled) {
+      return res;
+    }
+  }
+
   TRI_doc_mptr_t* header;
   int res;
   TRI_voc_tick_t markerTick = 0;
@@ -5036,25 +5831,12 @@ int TRI_RemoveShapedJsonDocumentCollection (TRI_transaction_collection_t* trxCol
     operation.init();
 
     // delete from indexes
-    res = DeleteSecondaryIndexes(document, header, false);
-
-    if (res != TRI_ERROR_NO_ERROR) {
-      InsertSecondaryIndexes(document, header, true);
-      return res;
-    }
-
-    res = DeletePrimaryIndex(document, header, false);
+    res = RemoveDocumentIndexes(document, header, operation);
 
     if (res != TRI_ERROR_NO_ERROR) {
-      InsertSecondaryIndexes(document, header, true);
       return res;
     }
 
-    operation.indexed();
-
-    document->_headersPtr->unlink(header);  // PROTECTED by trx in trxCollection
-    document->_numberDocuments--;
-
     TRI_IF_FAILURE("RemoveDocumentNoOperation") {
       return TRI_ERROR_DEBUG;
     }
@@ -5149,6 +5931,15 @@ int TRI_InsertShapedJsonDocumentCollection (TRI_transaction_collection_t* trxCol
 
   TRI_ASSERT(marker != nullptr);
 
+  if (CanUseDocumentLevelLocking(trxCollection, lock)) {
+    bool handled;
+    res = InsertDocumentLevel(trxCollection, rid, keyString, hash, marker, freeMarker, mptr, forceSync, handled);
+
+    if (handled) {
+      return res;
+    }
+  }
+
   TRI_voc_tick_t markerTick = 0;
   // now insert into indexes
   {
@@ -5239,6 +6030,15 @@ int TRI_UpdateShapedJsonDocumentCollection (TRI_transaction_collection_t* trxCol
   TRI_document_collection_t* document = trxCollection->_collection->_collection;
   //TRI_ASSERT_EXPENSIVE(lock || TRI_IsLockedCollectionTransaction(trxCollection, TRI_TRANSACTION_WRITE, 0));
 
+  if (CanUseDocumentLevelLocking(trxCollection, lock)) {
+    bool handled;
+    int res = UpdateDocumentLevel(trxCollection, key, rid, marker, freeMarker, mptr, shaped, policy, forceSync, handled);
+
+    if (handled) {
+      return res;
+    }
+  }
+
   int res = TRI_ERROR_NO_ERROR;
   TRI_voc_tick_t markerTick = 0;
   {
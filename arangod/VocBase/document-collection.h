@@ -33,6 +33,7 @@
 
 #include "Basics/Common.h"
 
+#include "Basics/Mutex.h"
 #include "VocBase/barrier.h"
 #include "VocBase/collection.h"
 #include "VocBase/headers.h"
@@ -60,6 +61,12 @@ class KeyGenerator;
 // --SECTION--                                                     public macros
 // -----------------------------------------------------------------------------
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of mutexes used for locking individual document keys
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_DOCUMENT_KEY_LOCKS (64)
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief read locks the documents and indexes
 ////////////////////////////////////////////////////////////////////////////////
@@ -128,8 +135,16 @@ struct TRI_doc_mptr_t {
                         _dataptr(nullptr) {
     }
 
+    // the destructor is only virtual in maintainer mode, where the data
+    // pointer accessors are virtual too. this keeps the vtable pointer out of
+    // the master pointers in production builds
+#ifdef TRI_ENABLE_MAINTAINER_MODE
     virtual ~TRI_doc_mptr_t () {
     }
+#else
+    ~TRI_doc_mptr_t () {
+    }
+#endif
 
     void clear () {
       _rid = 0;
@@ -280,6 +295,47 @@ typedef struct TRI_doc_datafile_info_s {
 }
 TRI_doc_datafile_info_t;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief position of a scan over the documents of a collection in datafile
+/// order, see TRI_ScanDatafilesDocumentCollection
+////////////////////////////////////////////////////////////////////////////////
+
+struct TRI_datafile_scan_t {
+  TRI_datafile_scan_t ()
+    : _datafiles(),
+      _scanned(),
+      _datafileIndex(0),
+      _offset(0),
+      _primaryPosition(0),
+      _found(0),
+      _initialized(false) {
+  }
+
+  void reset () {
+    _datafiles.clear();
+    _scanned.clear();
+    _datafileIndex = 0;
+    _offset = 0;
+    _primaryPosition = 0;
+    _found = 0;
+    _initialized = false;
+  }
+
+  // the datafiles, journals and compactor files at the start of the scan
+  std::vector<struct TRI_datafile_s*> _datafiles;
+  // the memory regions of the datafiles scanned so far, sorted once the
+  // datafiles are done
+  std::vector<std::pair<char const*, char const*>> _scanned;
+  // the current datafile and the offset in it
+  size_t _datafileIndex;
+  size_t _offset;
+  // position in the primary index, for the documents not in the datafiles
+  size_t _primaryPosition;
+  // number of live documents found in the datafiles
+  size_t _found;
+  bool _initialized;
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief collection info
 ////////////////////////////////////////////////////////////////////////////////
@@ -312,6 +368,12 @@ typedef struct TRI_doc_collection_info_s {
 
   TRI_voc_tick_t  _tickMax;
   uint64_t        _uncollectedLogfileEntries;
+
+  TRI_voc_ssize_t _compactionBacklogCount;
+  int64_t         _compactionBacklogSize;
+  uint64_t        _compactionRuns;
+  uint64_t        _compactionBytesRead;
+  uint64_t        _compactionBytesWritten;
 }
 TRI_doc_collection_info_t;
 
@@ -330,6 +392,17 @@ struct TRI_document_collection_t : public TRI_collection_t {
 
   TRI_read_write_lock_t        _lock;
 
+  // ...........................................................................
+  // with document-level locking, single-document write operations only hold
+  // _lock in read mode. they serialize operations on the same key using
+  // _keyLocks, and modify the in-memory state (indexes and headers) while
+  // holding _documentsLock in write mode. all readers hold _documentsLock 
+  // in read mode in addition to _lock
+  // ...........................................................................
+
+  TRI_read_write_lock_t        _documentsLock;
+  triagens::basics::Mutex      _keyLocks[TRI_DOCUMENT_KEY_LOCKS];
+
 private:
   TRI_shaper_t*                _shaper;
 
@@ -374,6 +447,11 @@ public:
   TRI_read_write_lock_t        _compactionLock;
   double                       _lastCompaction;
 
+  // compaction statistics, updated by the compactor
+  std::atomic<uint64_t>        _compactionRuns;
+  std::atomic<uint64_t>        _compactionBytesRead;
+  std::atomic<uint64_t>        _compactionBytesWritten;
+
   // ...........................................................................
   // this condition variable protects the _journalsCondition
   // ...........................................................................
@@ -701,6 +779,41 @@ void TRI_UpdateRevisionDocumentCollection (TRI_document_collection_t*,
 
 bool TRI_IsFullyCollectedDocumentCollection (TRI_document_collection_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief scans the live documents of a collection in datafile order
+///
+/// the datafiles, journals and compactor files are walked sequentially, with
+/// read-ahead hints for the operating system. a document marker is live if
+/// the master pointer for its key points to it. if includeWal is true, the
+/// documents that are not contained in any of the datafiles (i.e. the
+/// documents still in the write-ahead log) are returned afterwards, from the
+/// primary index. the callback is called for at most batchSize documents,
+/// and the scan can be resumed with the same position. returns the number of
+/// documents found, 0 when the scan is complete.
+///
+/// note: the caller must hold the read-lock on the collection and a barrier
+/// for the whole scan
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_ScanDatafilesDocumentCollection (TRI_document_collection_t*,
+                                            TRI_datafile_scan_t*,
+                                            size_t,
+                                            bool,
+                                            std::function<void(TRI_doc_mptr_t const*)> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief enable or disable document-level locking for single-document
+/// write operations
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_SetDocumentLevelLockingDocumentCollection (bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not document-level locking is enabled
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_UseDocumentLevelLockingDocumentCollection ();
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief create an index, based on a JSON description
 ////////////////////////////////////////////////////////////////////////////////
@@ -773,6 +886,12 @@ int TRI_CloseDocumentCollection (TRI_document_collection_t*,
 
 TRI_vector_pointer_t* TRI_IndexesDocumentCollection (TRI_document_collection_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rebuilds the outdated statistics of all indexes
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_UpdateIndexStatisticsDocumentCollection (TRI_document_collection_t*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief drops an index, including index file removal and replication
 ////////////////////////////////////////////////////////////////////////////////
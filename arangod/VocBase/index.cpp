@@ -40,6 +40,7 @@
 #include "Basics/json-utilities.h"
 #include "Basics/JsonHelper.h"
 #include "Basics/Exceptions.h"
+#include "Basics/ThreadPool.h"
 #include "CapConstraint/cap-constraint.h"
 #include "FulltextIndex/fulltext-index.h"
 #include "FulltextIndex/fulltext-wordlist.h"
@@ -94,10 +95,14 @@ void TRI_InitIndex (TRI_index_t* idx,
 
   // init common functions
   idx->selectivityEstimate    = nullptr;
+  idx->distinctEstimate       = nullptr;
+  idx->rangeEstimate          = nullptr;
+  idx->updateStatistics       = nullptr;
   idx->memory                 = nullptr;
   idx->removeIndex            = nullptr;
   idx->cleanup                = nullptr;
   idx->sizeHint               = nullptr;
+  idx->batchInsert            = nullptr;
   idx->postInsert             = nullptr;
 
   LOG_TRACE("initialising index of type %s", TRI_TypeNameIndex(idx->_type));
@@ -369,6 +374,10 @@ int TRI_SaveIndex (TRI_document_collection_t* document,
     return TRI_errno();
   }
 
+  // cached query plans might be improved by using the new index. this is
+  // not done in AddIndex, which also runs when a collection is loaded
+  TRI_InvalidateQueryCachesVocBase(vocbase, document->_info._name);
+
   if (! writeMarker) {
     return TRI_ERROR_NO_ERROR;
   }
@@ -498,7 +507,7 @@ static int RemovePrimary (TRI_index_t* idx,
 ////////////////////////////////////////////////////////////////////////////////
 
 static size_t MemoryPrimary (TRI_index_t const* idx) {
-  return idx->_collection->_primaryIndex._nrAlloc * sizeof(void*);
+  return TRI_MemoryPrimaryIndex(&idx->_collection->_primaryIndex);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1332,6 +1341,155 @@ static int InsertSkiplistIndex (TRI_index_t* idx,
   return SkiplistIndex_insert(skiplistIndex->_skiplistIndex, skiplistElement);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief fills an empty skiplist index with many documents at once
+///
+/// the index elements are built in partitions (in parallel if a thread pool
+/// is given) and then handed to the skiplist for sorting and bulk loading.
+/// if the index is not empty, the documents are inserted one by one
+////////////////////////////////////////////////////////////////////////////////
+
+static int BatchInsertSkiplistIndex (TRI_index_t* idx,
+                                     std::vector<TRI_doc_mptr_t const*> const* documents,
+                                     void* indexPool) {
+  // minimum number of documents per partition
+  static size_t const MinPartitionSize = 8192;
+
+  TRI_skiplist_index_t* skiplistIndex = (TRI_skiplist_index_t*) idx;
+  auto pool = static_cast<triagens::basics::ThreadPool*>(indexPool);
+  size_t const n = documents->size();
+
+  if (SkiplistIndex_getNrUsed(skiplistIndex->_skiplistIndex) > 0) {
+    for (auto const& doc : *documents) {
+      int res = InsertSkiplistIndex(idx, doc, false);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        return res;
+      }
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  std::vector<TRI_skiplist_index_element_t*> elements;
+
+  try {
+    elements.resize(n, nullptr);
+  }
+  catch (...) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  size_t const elementSize = SkiplistIndex_ElementSize(skiplistIndex->_skiplistIndex);
+
+  size_t partitions = 1;
+  if (pool != nullptr && n >= 2 * MinPartitionSize) {
+    partitions = (std::min)(pool->size() + 1, n / MinPartitionSize);
+  }
+
+  auto buildElements = [&] (size_t partition) -> int {
+    size_t const to = (partition + 1) * n / partitions;
+
+    for (size_t i = partition * n / partitions; i < to; ++i) {
+      auto skiplistElement = static_cast<TRI_skiplist_index_element_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, elementSize, false));
+
+      if (skiplistElement == nullptr) {
+        return TRI_ERROR_OUT_OF_MEMORY;
+      }
+
+      int res = SkiplistIndexHelper(skiplistIndex, skiplistElement, (*documents)[i]);
+
+      // see InsertSkiplistIndex for why a missing attribute is not an error
+      if (res == TRI_ERROR_ARANGO_INDEX_DOCUMENT_ATTRIBUTE_MISSING) {
+        if (idx->_sparse) {
+          TRI_Free(TRI_UNKNOWN_MEM_ZONE, skiplistElement);
+          continue;
+        }
+
+        res = TRI_ERROR_NO_ERROR;
+      }
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        TRI_Free(TRI_UNKNOWN_MEM_ZONE, skiplistElement);
+        return res;
+      }
+
+      elements[i] = skiplistElement;
+    }
+
+    return TRI_ERROR_NO_ERROR;
+  };
+
+  int res;
+  if (partitions == 1) {
+    res = buildElements(0);
+  }
+  else {
+    res = pool->parallelFor(partitions, buildElements);
+  }
+
+  // remove the documents skipped by a sparse index
+  elements.erase(std::remove(elements.begin(), elements.end(), nullptr), elements.end());
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    for (auto& element : elements) {
+      TRI_Free(TRI_UNKNOWN_MEM_ZONE, element);
+    }
+
+    return res;
+  }
+
+  // the memory for the elements will be owned or freed by the index
+  return SkiplistIndex_bulkInsert(skiplistIndex->_skiplistIndex, elements, pool);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the selectivity estimate of the index
+////////////////////////////////////////////////////////////////////////////////
+
+static double SelectivityEstimateSkiplistIndex (TRI_index_t const* idx) {
+  TRI_skiplist_index_t const* skiplistIndex = (TRI_skiplist_index_t const*) idx;
+
+  return SkiplistIndex_selectivityEstimate(skiplistIndex->_skiplistIndex);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the estimated number of distinct values of the first n
+/// indexed attributes
+////////////////////////////////////////////////////////////////////////////////
+
+static double DistinctEstimateSkiplistIndex (TRI_index_t const* idx,
+                                             size_t n) {
+  TRI_skiplist_index_t const* skiplistIndex = (TRI_skiplist_index_t const*) idx;
+
+  return SkiplistIndex_distinctEstimate(skiplistIndex->_skiplistIndex, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the estimated fraction of documents in a range of the first
+/// indexed attribute
+////////////////////////////////////////////////////////////////////////////////
+
+static double RangeEstimateSkiplistIndex (TRI_index_t const* idx,
+                                          TRI_json_t const* low,
+                                          bool lowInclusive,
+                                          TRI_json_t const* high,
+                                          bool highInclusive) {
+  TRI_skiplist_index_t const* skiplistIndex = (TRI_skiplist_index_t const*) idx;
+
+  return SkiplistIndex_rangeEstimate(skiplistIndex->_skiplistIndex, low, lowInclusive, high, highInclusive);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief rebuilds outdated statistics of a skiplist index
+////////////////////////////////////////////////////////////////////////////////
+
+static void UpdateStatisticsSkiplistIndex (TRI_index_t* idx) {
+  TRI_skiplist_index_t* skiplistIndex = (TRI_skiplist_index_t*) idx;
+
+  SkiplistIndex_updateStatistics(skiplistIndex->_skiplistIndex);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the memory used by the index
 ////////////////////////////////////////////////////////////////////////////////
@@ -1472,9 +1630,16 @@ TRI_index_t* TRI_CreateSkiplistIndex (TRI_document_collection_t* document,
 
   TRI_InitIndex(idx, iid, TRI_IDX_TYPE_SKIPLIST_INDEX, document, sparse, unique);
 
+  idx->_hasSelectivityEstimate = true;
+  idx->selectivityEstimate     = SelectivityEstimateSkiplistIndex;
+  idx->distinctEstimate        = DistinctEstimateSkiplistIndex;
+  idx->rangeEstimate           = RangeEstimateSkiplistIndex;
+  idx->updateStatistics        = UpdateStatisticsSkiplistIndex;
+
   idx->memory   = MemorySkiplistIndex;
   idx->json     = JsonSkiplistIndex;
   idx->insert   = InsertSkiplistIndex;
+  idx->batchInsert = BatchInsertSkiplistIndex;
   idx->remove   = RemoveSkiplistIndex;
 
   // ...........................................................................
@@ -1639,6 +1804,95 @@ static int InsertFulltextIndex (TRI_index_t* idx,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief inserts many documents into the fulltext index at once
+///
+/// the documents are processed in chunks to limit the memory used for the
+/// wordlists. the wordlists of a chunk are built in parallel if a thread pool
+/// is given, and then inserted with a single call into the fulltext index
+////////////////////////////////////////////////////////////////////////////////
+
+static int BatchInsertFulltextIndex (TRI_index_t* idx,
+                                     std::vector<TRI_doc_mptr_t const*> const* documents,
+                                     void* indexPool) {
+  // maximum number of documents per chunk
+  static size_t const ChunkSize = 65536;
+  // minimum number of documents per partition of a chunk
+  static size_t const MinPartitionSize = 4096;
+
+  TRI_fulltext_index_t* fulltextIndex = (TRI_fulltext_index_t*) idx;
+  auto pool = static_cast<triagens::basics::ThreadPool*>(indexPool);
+
+  std::vector<std::pair<TRI_fulltext_doc_t, TRI_fulltext_wordlist_t*>> wordlists;
+
+  try {
+    wordlists.reserve((std::min)(documents->size(), ChunkSize));
+  }
+  catch (...) {
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  int res = TRI_ERROR_NO_ERROR;
+
+  for (size_t offset = 0; offset < documents->size() && res == TRI_ERROR_NO_ERROR; offset += ChunkSize) {
+    size_t const n = (std::min)(documents->size() - offset, ChunkSize);
+
+    wordlists.clear();
+    wordlists.resize(n, std::make_pair(TRI_fulltext_doc_t(0), nullptr));
+
+    size_t partitions = 1;
+    if (pool != nullptr && n >= 2 * MinPartitionSize) {
+      partitions = (std::min)(pool->size() + 1, n / MinPartitionSize);
+    }
+
+    auto buildWordlists = [&] (size_t partition) -> int {
+      size_t const to = (partition + 1) * n / partitions;
+
+      for (size_t i = partition * n / partitions; i < to; ++i) {
+        auto doc = (*documents)[offset + i];
+
+        // a document without words is not an error, see InsertFulltextIndex
+        wordlists[i] = std::make_pair((TRI_fulltext_doc_t) ((uintptr_t) doc), GetWordlist(idx, doc));
+      }
+
+      return TRI_ERROR_NO_ERROR;
+    };
+
+    if (partitions == 1) {
+      buildWordlists(0);
+    }
+    else {
+      pool->parallelFor(partitions, buildWordlists);
+    }
+
+    // remove the documents that have no words to index
+    wordlists.erase(std::remove_if(wordlists.begin(), wordlists.end(), [] (std::pair<TRI_fulltext_doc_t, TRI_fulltext_wordlist_t*> const& it) {
+      if (it.second == nullptr) {
+        return true;
+      }
+
+      if (it.second->_numWords == 0) {
+        TRI_FreeWordlistFulltextIndex(it.second);
+        return true;
+      }
+
+      return false;
+    }), wordlists.end());
+
+    res = TRI_InsertDocumentsFulltextIndex(fulltextIndex->_fulltextIndex, wordlists, pool);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_ERROR("adding documents to fulltext index failed");
+    }
+
+    for (auto& it : wordlists) {
+      TRI_FreeWordlistFulltextIndex(it.second);
+    }
+  }
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the memory used by the index
 ////////////////////////////////////////////////////////////////////////////////
@@ -1768,6 +2022,7 @@ TRI_index_t* TRI_CreateFulltextIndex (TRI_document_collection_t* document,
   idx->insert   = InsertFulltextIndex;
   idx->remove   = RemoveFulltextIndex;
   idx->cleanup  = CleanupFulltextIndex;
+  idx->batchInsert = BatchInsertFulltextIndex;
 
   fulltextIndex->_fulltextIndex   = fts;
   fulltextIndex->_indexSubstrings = indexSubstrings;
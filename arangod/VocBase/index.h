@@ -103,6 +103,19 @@ typedef struct TRI_index_s {
   bool _hasSelectivityEstimate;
 
   double (*selectivityEstimate) (struct TRI_index_s const*);
+
+  // NULL by default. estimated number of distinct values of the first n indexed
+  // attributes, 0 if unknown
+  double (*distinctEstimate) (struct TRI_index_s const*, size_t);
+
+  // NULL by default. estimated fraction of documents whose first indexed attribute
+  // lies between the bounds (nullptr = unbounded), negative if unknown
+  double (*rangeEstimate) (struct TRI_index_s const*, TRI_json_t const*, bool, TRI_json_t const*, bool);
+
+  // NULL by default. rebuilds the statistics used for the estimates if they are
+  // outdated. called by the cleanup thread with the collection read-locked
+  void (*updateStatistics) (struct TRI_index_s*);
+
   size_t (*memory) (struct TRI_index_s const*);
   TRI_json_t* (*json) (struct TRI_index_s const*);
   void (*removeIndex) (struct TRI_index_s*, struct TRI_document_collection_t*);
@@ -123,6 +136,10 @@ typedef struct TRI_index_s {
   // give index a hint about the expected size
   int (*sizeHint) (struct TRI_index_s*, size_t);
 
+  // NULL by default. if non-NULL, used to fill an empty index with all
+  // documents at once. the last parameter is an optional thread pool
+  int (*batchInsert) (struct TRI_index_s*, std::vector<struct TRI_doc_mptr_t const*> const*, void*);
+
   // .........................................................................................
   // the following functions are called by the query machinery which attempting to determine an
   // appropriate index and when using the index to obtain a result set.
@@ -146,6 +163,8 @@ typedef struct TRI_geo_index_s {
 
   bool _geoJson;
   bool _constraint;
+
+  size_t _unindexed;
 }
 TRI_geo_index_t;
 
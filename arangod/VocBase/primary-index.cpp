@@ -53,6 +53,42 @@ static inline bool ShouldResize (TRI_primary_index_t const* idx) {
   return (idx->_nrAlloc < idx->_nrUsed + idx->_nrUsed);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief calculates the tag byte for a hash value
+///
+/// the tag uses the uppermost 7 bits of the hash. the highest bit of the tag
+/// is always set, so a tag is never 0 (which marks an empty slot)
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint8_t TagFromHash (uint64_t hash) {
+  return static_cast<uint8_t>((hash >> 57) | 0x80);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief allocates the table and the tags for the given number of slots
+////////////////////////////////////////////////////////////////////////////////
+
+static bool AllocateTable (uint64_t size,
+                           void*** table,
+                           uint8_t** tags) {
+  *table = static_cast<void**>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, (size_t) (size * sizeof(void*)), true));
+
+  if (*table == nullptr) {
+    return false;
+  }
+
+  *tags = static_cast<uint8_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, (size_t) (size * sizeof(uint8_t)), true));
+
+  if (*tags == nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, *table);
+    *table = nullptr;
+
+    return false;
+  }
+
+  return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief resizes the index
 ////////////////////////////////////////////////////////////////////////////////
@@ -67,11 +103,11 @@ static bool ResizePrimaryIndex (TRI_primary_index_t* idx,
   }
 
   void** oldTable = idx->_table;
+  uint8_t* oldTags = idx->_tags;
 
-  idx->_table = static_cast<void**>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, (size_t) (targetSize * sizeof(void*)), true));
-
-  if (idx->_table == nullptr) {
+  if (! AllocateTable(targetSize, &idx->_table, &idx->_tags)) {
     idx->_table = oldTable;
+    idx->_tags = oldTags;
 
     return false;
   }
@@ -81,27 +117,28 @@ static bool ResizePrimaryIndex (TRI_primary_index_t* idx,
 
     // table is already cleared by allocate, now copy old data
     for (uint64_t j = 0; j < oldAlloc; j++) {
-      TRI_doc_mptr_t const* element = static_cast<TRI_doc_mptr_t const*>(oldTable[j]);
-
-      if (element != nullptr) {
+      if (oldTags[j] != 0) {
+        TRI_doc_mptr_t const* element = static_cast<TRI_doc_mptr_t const*>(oldTable[j]);
         uint64_t const hash = element->_hash;
         uint64_t i, k;
 
         i = k = hash % targetSize;
 
-        for (; i < targetSize && idx->_table[i] != nullptr; ++i);
+        for (; i < targetSize && idx->_tags[i] != 0; ++i);
         if (i == targetSize) {
-          for (i = 0; i < k && idx->_table[i] != nullptr; ++i);
+          for (i = 0; i < k && idx->_tags[i] != 0; ++i);
         }
 
         TRI_ASSERT_EXPENSIVE(i < targetSize);
 
         idx->_table[i] = (void*) element;
+        idx->_tags[i] = oldTags[j];
       }
     }
   }
 
   TRI_Free(TRI_UNKNOWN_MEM_ZONE, oldTable);
+  TRI_Free(TRI_UNKNOWN_MEM_ZONE, oldTags);
   idx->_nrAlloc = targetSize;
 
   return true;
@@ -109,6 +146,8 @@ static bool ResizePrimaryIndex (TRI_primary_index_t* idx,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief comparison function, compares a master pointer to another
+///
+/// must only be called if the tags of both elements are equal
 ////////////////////////////////////////////////////////////////////////////////
 
 static inline bool IsDifferentKeyElement (TRI_doc_mptr_t const* header,
@@ -121,6 +160,8 @@ static inline bool IsDifferentKeyElement (TRI_doc_mptr_t const* header,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief comparison function, compares a hash/key to a master pointer
+///
+/// must only be called if the tags of both elements are equal
 ////////////////////////////////////////////////////////////////////////////////
 
 static inline bool IsDifferentHashElement (char const* key, uint64_t hash, void const* element) {
@@ -129,6 +170,63 @@ static inline bool IsDifferentHashElement (char const* key, uint64_t hash, void
   return (hash != e->_hash || strcmp(key, TRI_EXTRACT_MARKER_KEY(e)) != 0);  // ONLY IN INDEX, PROTECTED by RUNTIME
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finds the slot for a hash/key
+///
+/// returns the slot containing the key, or the empty slot at which the
+/// probing stopped
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint64_t FindSlotByKey (TRI_primary_index_t const* idx,
+                                      char const* key,
+                                      uint64_t hash) {
+  uint64_t const n = idx->_nrAlloc;
+  uint8_t const tag = TagFromHash(hash);
+  uint8_t const* tags = idx->_tags;
+  uint64_t i, k;
+
+  TRI_ASSERT_EXPENSIVE(n > 0);
+
+  i = k = hash % n;
+
+  for (; i < n && tags[i] != 0 && (tags[i] != tag || IsDifferentHashElement(key, hash, idx->_table[i])); ++i);
+  if (i == n) {
+    for (i = 0; i < k && tags[i] != 0 && (tags[i] != tag || IsDifferentHashElement(key, hash, idx->_table[i])); ++i);
+  }
+
+  TRI_ASSERT_EXPENSIVE(i < n);
+
+  return i;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finds the slot for a master pointer
+///
+/// returns the slot containing a master pointer with the same key, or the
+/// empty slot at which the probing stopped
+////////////////////////////////////////////////////////////////////////////////
+
+static inline uint64_t FindSlotByElement (TRI_primary_index_t const* idx,
+                                          TRI_doc_mptr_t const* header) {
+  uint64_t const n = idx->_nrAlloc;
+  uint8_t const tag = TagFromHash(header->_hash);
+  uint8_t const* tags = idx->_tags;
+  uint64_t i, k;
+
+  TRI_ASSERT_EXPENSIVE(n > 0);
+
+  i = k = header->_hash % n;
+
+  for (; i < n && tags[i] != 0 && (tags[i] != tag || IsDifferentKeyElement(header, idx->_table[i])); ++i);
+  if (i == n) {
+    for (i = 0; i < k && tags[i] != 0 && (tags[i] != tag || IsDifferentKeyElement(header, idx->_table[i])); ++i);
+  }
+
+  TRI_ASSERT_EXPENSIVE(i < n);
+
+  return i;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                      constructors and destructors
 // -----------------------------------------------------------------------------
@@ -140,10 +238,10 @@ static inline bool IsDifferentHashElement (char const* key, uint64_t hash, void
 int TRI_InitPrimaryIndex (TRI_primary_index_t* idx) {
   idx->_nrAlloc = 0;
   idx->_nrUsed  = 0;
+  idx->_table   = nullptr;
+  idx->_tags    = nullptr;
 
-  idx->_table = static_cast<void**>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, (size_t) (InitialSize() * sizeof(void*)), true));
-
-  if (idx->_table == nullptr) {
+  if (! AllocateTable(InitialSize(), &idx->_table, &idx->_tags)) {
     return TRI_ERROR_OUT_OF_MEMORY;
   }
 
@@ -176,6 +274,14 @@ int TRI_AutoResizePrimaryIndex (TRI_primary_index_t* idx) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the memory used by the index
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_MemoryPrimaryIndex (TRI_primary_index_t const* idx) {
+  return (size_t) (idx->_nrAlloc * (sizeof(void*) + sizeof(uint8_t)));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroys an index, but does not free the pointer
 ////////////////////////////////////////////////////////////////////////////////
@@ -185,6 +291,11 @@ void TRI_DestroyPrimaryIndex (TRI_primary_index_t* idx) {
     TRI_Free(TRI_UNKNOWN_MEM_ZONE, idx->_table);
     idx->_table = nullptr;
   }
+
+  if (idx->_tags != nullptr) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, idx->_tags);
+    idx->_tags = nullptr;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -203,20 +314,7 @@ void* TRI_LookupByKeyPrimaryIndex (TRI_primary_index_t* idx,
 
   // compute the hash
   uint64_t const hash = TRI_HashKeyPrimaryIndex(key);
-  uint64_t const n = idx->_nrAlloc;
-  uint64_t i, k;
-
-  i = k = hash % n;
-
-  TRI_ASSERT_EXPENSIVE(n > 0);
-
-  // search the table
-  for (; i < n && idx->_table[i] != nullptr && IsDifferentHashElement(key, hash, idx->_table[i]); ++i);
-  if (i == n) {
-    for (i = 0; i < k && idx->_table[i] != nullptr && IsDifferentHashElement(key, hash, idx->_table[i]); ++i);
-  }
-
-  TRI_ASSERT_EXPENSIVE(i < n);
+  uint64_t const i = FindSlotByKey(idx, key, hash);
 
   // return whatever we found
   return idx->_table[i];
@@ -239,19 +337,7 @@ int TRI_InsertKeyPrimaryIndex (TRI_primary_index_t* idx,
     }
   }
 
-  uint64_t const n = idx->_nrAlloc;
-  uint64_t i, k;
-
-  TRI_ASSERT_EXPENSIVE(n > 0);
-
-  i = k = header->_hash % n;
-
-  for (; i < n && idx->_table[i] != nullptr && IsDifferentKeyElement(header, idx->_table[i]); ++i);
-  if (i == n) {
-    for (i = 0; i < k && idx->_table[i] != nullptr && IsDifferentKeyElement(header, idx->_table[i]); ++i);
-  }
-
-  TRI_ASSERT_EXPENSIVE(i < n);
+  uint64_t const i = FindSlotByElement(idx, header);
 
   void* old = idx->_table[i];
 
@@ -264,6 +350,7 @@ int TRI_InsertKeyPrimaryIndex (TRI_primary_index_t* idx,
 
   // add a new element to the associative idx
   idx->_table[i] = (void*) header;
+  idx->_tags[i] = TagFromHash(header->_hash);
   ++idx->_nrUsed;
 
   return TRI_ERROR_NO_ERROR;
@@ -277,22 +364,13 @@ int TRI_InsertKeyPrimaryIndex (TRI_primary_index_t* idx,
 
 void TRI_InsertKeyPrimaryIndex (TRI_primary_index_t* idx,
                                 TRI_doc_mptr_t const* header) {
-  uint64_t const n = idx->_nrAlloc;
-  uint64_t i, k;
-
-  i = k = header->_hash % n;
-
-  for (; i < n && idx->_table[i] != nullptr && IsDifferentKeyElement(header, idx->_table[i]); ++i);
-  if (i == n) {
-    for (i = 0; i < k && idx->_table[i] != nullptr && IsDifferentKeyElement(header, idx->_table[i]); ++i);
-  }
-
-  TRI_ASSERT_EXPENSIVE(i < n);
+  uint64_t const i = FindSlotByElement(idx, header);
 
   TRI_ASSERT_EXPENSIVE(idx->_table[i] == nullptr);
 
   // add a new element to the associative idx
   idx->_table[i] = (void*) header;
+  idx->_tags[i] = TagFromHash(header->_hash);
   ++idx->_nrUsed;
 }
 
@@ -304,37 +382,30 @@ void* TRI_RemoveKeyPrimaryIndex (TRI_primary_index_t* idx,
                                  char const* key) {
   uint64_t const hash = TRI_HashKeyPrimaryIndex(key);
   uint64_t const n = idx->_nrAlloc;
-  uint64_t i, k;
-
-  i = k = hash % n;
-
-  // search the table
-  for (; i < n && idx->_table[i] != nullptr && IsDifferentHashElement(key, hash, idx->_table[i]); ++i);
-  if (i == n) {
-    for (i = 0; i < k && idx->_table[i] != nullptr && IsDifferentHashElement(key, hash, idx->_table[i]); ++i);
-  }
-
-  TRI_ASSERT_EXPENSIVE(i < n);
+  uint64_t i = FindSlotByKey(idx, key, hash);
 
   // if we did not find such an item return false
-  if (idx->_table[i] == nullptr) {
+  if (idx->_tags[i] == 0) {
     return nullptr;
   }
 
   // remove item
   void* old = idx->_table[i];
   idx->_table[i] = nullptr;
+  idx->_tags[i] = 0;
   idx->_nrUsed--;
 
   // and now check the following places for items to move here
-  k = TRI_IncModU64(i, n);
+  uint64_t k = TRI_IncModU64(i, n);
 
-  while (idx->_table[k] != nullptr) {
+  while (idx->_tags[k] != 0) {
     uint64_t j = (static_cast<TRI_doc_mptr_t const*>(idx->_table[k])->_hash) % n;
 
     if ((i < k && ! (i < j && j <= k)) || (k < i && ! (i < j || j <= k))) {
       idx->_table[i] = idx->_table[k];
+      idx->_tags[i] = idx->_tags[k];
       idx->_table[k] = nullptr;
+      idx->_tags[k] = 0;
       i = k;
     }
 
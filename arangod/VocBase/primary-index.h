@@ -43,6 +43,11 @@ struct TRI_doc_mptr_t;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief associative array of pointers
+///
+/// next to the table of master pointers, the index keeps one tag byte per
+/// slot. a tag of 0 marks an empty slot, any other tag contains 7 bits of the
+/// key's hash. probing compares the tags first, so master pointers and
+/// markers of non-matching slots are not dereferenced
 ////////////////////////////////////////////////////////////////////////////////
 
 typedef struct TRI_primary_index_s {
@@ -50,6 +55,7 @@ typedef struct TRI_primary_index_s {
   uint64_t _nrUsed;      // the number of used entries
 
   void** _table;         // the table itself
+  uint8_t* _tags;        // the tag bytes, one per slot in _table
 }
 TRI_primary_index_t;
 
@@ -76,6 +82,12 @@ int TRI_ResizePrimaryIndex (TRI_primary_index_t*,
 
 int TRI_AutoResizePrimaryIndex (TRI_primary_index_t*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the memory used by the index
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_MemoryPrimaryIndex (TRI_primary_index_t const*);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroys the index, but does not free the pointer
 ////////////////////////////////////////////////////////////////////////////////
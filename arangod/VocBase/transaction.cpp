@@ -166,6 +166,9 @@ static void FreeOperations (TRI_transaction_t* trx) {
 
         op->revert();
       }
+
+      // results cached while the operations were visible are stale now
+      TRI_InvalidateQueryResultsVocBase(trx->_vocbase, document->_info._cid);
     }
     else {
       // update datafile statistics for all operations
@@ -1083,11 +1086,36 @@ bool TRI_IsLockedCollectionTransaction (TRI_transaction_collection_t const* trxC
 
 int TRI_AddOperationTransaction (triagens::wal::DocumentOperation& operation,
                                  bool& waitForSync) {
+  TRI_ASSERT(operation.header != nullptr);
+
+  TRI_voc_fid_t fid = 0;
+  void const* position = nullptr;
+  int64_t sizeChanged = 0;
+
+  int res = TRI_WriteOperationTransaction(operation, waitForSync, fid, position, sizeChanged);
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  return TRI_ApplyOperationTransaction(operation, fid, position, sizeChanged);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief write the marker of a WAL operation into the logfiles
+/// this does not modify the in-memory state of the collection, and thus can
+/// be called without holding the collection's write lock. fid, position and
+/// sizeChanged must later be passed to TRI_ApplyOperationTransaction
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_WriteOperationTransaction (triagens::wal::DocumentOperation& operation,
+                                   bool& waitForSync,
+                                   TRI_voc_fid_t& fid,
+                                   void const*& position,
+                                   int64_t& sizeChanged) {
   TRI_transaction_collection_t* trxCollection = operation.trxCollection;
   TRI_transaction_t* trx = trxCollection->_transaction;
 
-  TRI_ASSERT(operation.header != nullptr);
-
   bool const isSingleOperationTransaction = IsSingleOperationTransaction(trx);
 
   // upgrade the info for the transaction
@@ -1118,10 +1146,10 @@ int TRI_AddOperationTransaction (triagens::wal::DocumentOperation& operation,
     }
   }
 
-  TRI_voc_fid_t fid = 0;
-  void const* position = nullptr;
+  fid = 0;
+  position = nullptr;
+  sizeChanged = 0;
 
-  int64_t sizeChanged = 0;
   TRI_document_collection_t* document = operation.trxCollection->_collection->_collection;
 
   if (operation.marker->fid() == 0) {
@@ -1211,6 +1239,29 @@ int TRI_AddOperationTransaction (triagens::wal::DocumentOperation& operation,
    
   TRI_ASSERT(fid > 0);
   TRI_ASSERT(position != nullptr);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply a WAL operation that was written by 
+/// TRI_WriteOperationTransaction to the in-memory state of the collection
+/// the caller must hold the collection's write lock
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_ApplyOperationTransaction (triagens::wal::DocumentOperation& operation,
+                                   TRI_voc_fid_t fid,
+                                   void const* position,
+                                   int64_t sizeChanged) {
+  TRI_transaction_collection_t* trxCollection = operation.trxCollection;
+  TRI_transaction_t* trx = trxCollection->_transaction;
+  TRI_document_collection_t* document = trxCollection->_collection->_collection;
+
+  TRI_ASSERT(operation.header != nullptr);
+  TRI_ASSERT(fid > 0);
+  TRI_ASSERT(position != nullptr);
+
+  bool const isSingleOperationTransaction = IsSingleOperationTransaction(trx);
   
   if (operation.type == TRI_VOC_DOCUMENT_OPERATION_INSERT ||
       operation.type == TRI_VOC_DOCUMENT_OPERATION_UPDATE) {
@@ -1270,6 +1321,9 @@ int TRI_AddOperationTransaction (triagens::wal::DocumentOperation& operation,
   }
 
   TRI_UpdateRevisionDocumentCollection(document, operation.rid, false);
+
+  // cached query results based on the collection are now stale
+  TRI_InvalidateQueryResultsVocBase(trx->_vocbase, document->_info._cid);
   
   TRI_IF_FAILURE("TransactionOperationAtEnd") {
     return TRI_ERROR_DEBUG;
@@ -294,6 +294,27 @@ bool TRI_IsLockedCollectionTransaction (TRI_transaction_collection_t const*,
 
 bool TRI_IsLockedCollectionTransaction (TRI_transaction_collection_t const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief write the marker of a WAL operation into the logfiles, without
+/// modifying the in-memory state of the collection
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_WriteOperationTransaction (triagens::wal::DocumentOperation&,
+                                   bool&,
+                                   TRI_voc_fid_t&,
+                                   void const*&,
+                                   int64_t&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief apply a WAL operation written by TRI_WriteOperationTransaction to
+/// the in-memory state of the collection
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_ApplyOperationTransaction (triagens::wal::DocumentOperation&,
+                                   TRI_voc_fid_t,
+                                   void const*,
+                                   int64_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief begin a transaction
 ////////////////////////////////////////////////////////////////////////////////
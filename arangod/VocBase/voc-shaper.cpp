@@ -32,9 +32,6 @@
 
 #include "Basics/Mutex.h"
 #include "Basics/MutexLocker.h"
-#include "Basics/ReadLocker.h"
-#include "Basics/ReadWriteLock.h"
-#include "Basics/WriteLocker.h"
 #include "Basics/associative.h"
 #include "Basics/hashes.h"
 #include "Basics/locks.h"
@@ -56,19 +53,18 @@
 typedef struct voc_shaper_s {
   TRI_shaper_t                    base;
 
-  TRI_associative_synced_t        _attributeNames;
-  TRI_associative_synced_t        _attributeIds;
-  TRI_associative_synced_t        _shapeDictionary;
-  TRI_associative_synced_t        _shapeIds;
+  TRI_associative_lockfree_t      _attributeNames;
+  TRI_associative_lockfree_t      _attributeIds;
+  TRI_associative_lockfree_t      _shapeDictionary;
+  TRI_associative_lockfree_t      _shapeIds;
 
-  TRI_associative_pointer_t       _accessors;
+  TRI_associative_lockfree_t      _accessors;
 
   std::atomic<TRI_shape_aid_t>    _nextAid;
   std::atomic<TRI_shape_sid_t>    _nextSid;
 
   TRI_document_collection_t*      _collection;
 
-  triagens::basics::ReadWriteLock _accessorLock;
   triagens::basics::Mutex         _shapeLock;
   triagens::basics::Mutex         _attributeLock;
 }
@@ -120,7 +116,7 @@ static inline char const* GetAttributeName (void const* marker) {
 /// @brief hashs the attribute name of a key
 ////////////////////////////////////////////////////////////////////////////////
 
-static uint64_t HashKeyAttributeName (TRI_associative_synced_t* array, void const* key) {
+static uint64_t HashKeyAttributeName (TRI_associative_lockfree_t* array, void const* key) {
   char const* k = (char const*) key;
   return TRI_FnvHashString(k);
 }
@@ -129,7 +125,7 @@ static uint64_t HashKeyAttributeName (TRI_associative_synced_t* array, void cons
 /// @brief hashs the attribute name of an element
 ////////////////////////////////////////////////////////////////////////////////
 
-static uint64_t HashElementAttributeName (TRI_associative_synced_t* array, void const* element) {
+static uint64_t HashElementAttributeName (TRI_associative_lockfree_t* array, void const* element) {
   return TRI_FnvHashString(GetAttributeName(element));
 }
 
@@ -137,7 +133,7 @@ static uint64_t HashElementAttributeName (TRI_associative_synced_t* array, void
 /// @brief compares an attribute name and an attribute
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool EqualKeyAttributeName (TRI_associative_synced_t* array, void const* key, void const* element) {
+static bool EqualKeyAttributeName (TRI_associative_lockfree_t* array, void const* key, void const* element) {
   char const* k = (char const*) key;
 
   return TRI_EqualString(k, GetAttributeName(element));
@@ -152,14 +148,13 @@ static TRI_shape_aid_t LookupAttributeByName (TRI_shaper_t* shaper,
   TRI_ASSERT(name != nullptr);
 
   voc_shaper_t* s = reinterpret_cast<voc_shaper_t*>(shaper);
-  std::function<TRI_shape_aid_t(void const*)> callback = [](void const* element) -> TRI_shape_aid_t {
-    if (element == nullptr) {
-      return 0;
-    }
-    return GetAttributeId(element);
-  };
+  void const* element = TRI_LookupByKeyAssociativeLockFree(&s->_attributeNames, name);
+
+  if (element == nullptr) {
+    return 0;
+  }
 
-  return TRI_ProcessByKeyAssociativeSynced<TRI_shape_aid_t>(&s->_attributeNames, name, callback);
+  return GetAttributeId(element);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -189,7 +184,7 @@ static TRI_shape_aid_t FindOrCreateAttributeByName (TRI_shaper_t* shaper,
     // lock the index and check that the element is still missing
     {
       MUTEX_LOCKER(s->_attributeLock);
-      void const* p = TRI_LookupByKeyAssociativeSynced(&s->_attributeNames, name);
+      void const* p = TRI_LookupByKeyAssociativeLockFree(&s->_attributeNames, name);
 
       // if the element appeared, return the aid
       if (p != nullptr) {
@@ -208,11 +203,11 @@ static TRI_shape_aid_t FindOrCreateAttributeByName (TRI_shaper_t* shaper,
         THROW_ARANGO_EXCEPTION(slotInfo.errorCode);
       }
 
-      void* f TRI_UNUSED = TRI_InsertKeyAssociativeSynced(&s->_attributeIds, &aid, const_cast<void*>(slotInfo.mem), false);
+      void* f TRI_UNUSED = TRI_InsertKeyAssociativeLockFree(&s->_attributeIds, &aid, const_cast<void*>(slotInfo.mem), false);
       TRI_ASSERT(f == nullptr);
 
       // enter into the dictionaries
-      f = TRI_InsertKeyAssociativeSynced(&s->_attributeNames, name, const_cast<void*>(slotInfo.mem), false);
+      f = TRI_InsertKeyAssociativeLockFree(&s->_attributeNames, name, const_cast<void*>(slotInfo.mem), false);
       TRI_ASSERT(f == nullptr);
     }
 
@@ -234,7 +229,7 @@ static TRI_shape_aid_t FindOrCreateAttributeByName (TRI_shaper_t* shaper,
 /// @brief hashes the attribute id
 ////////////////////////////////////////////////////////////////////////////////
 
-static uint64_t HashKeyAttributeId (TRI_associative_synced_t* array, void const* key) {
+static uint64_t HashKeyAttributeId (TRI_associative_lockfree_t* array, void const* key) {
   TRI_shape_aid_t const* k = static_cast<TRI_shape_aid_t const*>(key);
   return TRI_FnvHashPointer(k, sizeof(TRI_shape_aid_t));
 }
@@ -243,7 +238,7 @@ static uint64_t HashKeyAttributeId (TRI_associative_synced_t* array, void const*
 /// @brief hashes the attribute
 ////////////////////////////////////////////////////////////////////////////////
 
-static uint64_t HashElementAttributeId (TRI_associative_synced_t* array, void const* element) {
+static uint64_t HashElementAttributeId (TRI_associative_lockfree_t* array, void const* element) {
   TRI_shape_aid_t aid = GetAttributeId(element);
   return TRI_FnvHashPointer(&aid, sizeof(TRI_shape_aid_t));
 }
@@ -252,7 +247,7 @@ static uint64_t HashElementAttributeId (TRI_associative_synced_t* array, void co
 /// @brief compares an attribute name and an attribute
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool EqualKeyAttributeId (TRI_associative_synced_t* array, void const* key, void const* element) {
+static bool EqualKeyAttributeId (TRI_associative_lockfree_t* array, void const* key, void const* element) {
   TRI_shape_aid_t const* k = static_cast<TRI_shape_aid_t const*>(key);
   TRI_shape_aid_t aid = GetAttributeId(element);
 
@@ -266,21 +261,20 @@ static bool EqualKeyAttributeId (TRI_associative_synced_t* array, void const* ke
 static char const* LookupAttributeId (TRI_shaper_t* shaper,
                                       TRI_shape_aid_t aid) {
   voc_shaper_t* s = reinterpret_cast<voc_shaper_t*>(shaper);
-  std::function<char const*(void const*)> callback = [](void const* element) -> char const* {
-    if (element == nullptr) {
-      return nullptr;
-    }
-    return GetAttributeName(element);
-  };
+  void const* element = TRI_LookupByKeyAssociativeLockFree(&s->_attributeIds, &aid);
 
-  return TRI_ProcessByKeyAssociativeSynced<char const*>(&s->_attributeIds, &aid, callback);
+  if (element == nullptr) {
+    return nullptr;
+  }
+
+  return GetAttributeName(element);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief hashes the shapes
 ////////////////////////////////////////////////////////////////////////////////
 
-static uint64_t HashElementShape (TRI_associative_synced_t* array,
+static uint64_t HashElementShape (TRI_associative_lockfree_t* array,
                                   void const* element) {
   TRI_shape_t const* shape = static_cast<TRI_shape_t const*>(element);
   TRI_ASSERT(shape != nullptr);
@@ -292,7 +286,7 @@ static uint64_t HashElementShape (TRI_associative_synced_t* array,
 /// @brief compares shapes
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool EqualElementShape (TRI_associative_synced_t* array,
+static bool EqualElementShape (TRI_associative_lockfree_t* array,
                                void const* left,
                                void const* right) {
   TRI_shape_t const* l = static_cast<TRI_shape_t const*>(left);
@@ -321,7 +315,7 @@ static TRI_shape_t const* FindShape (TRI_shaper_t* shaper,
   TRI_shape_t const* found = TRI_LookupBasicShapeShaper(shape);
 
   if (found == nullptr) {
-    found = static_cast<TRI_shape_t const*>(TRI_LookupByElementAssociativeSynced(&s->_shapeDictionary, shape));
+    found = static_cast<TRI_shape_t const*>(TRI_LookupByElementAssociativeLockFree(&s->_shapeDictionary, shape));
   }
 
   // shape found, free argument and return
@@ -350,7 +344,7 @@ static TRI_shape_t const* FindShape (TRI_shaper_t* shaper,
     // lock the index and check the element is still missing
     MUTEX_LOCKER(s->_shapeLock);
 
-    found = static_cast<TRI_shape_t const*>(TRI_LookupByElementAssociativeSynced(&s->_shapeDictionary, shape));
+    found = static_cast<TRI_shape_t const*>(TRI_LookupByElementAssociativeLockFree(&s->_shapeDictionary, shape));
 
     if (found != nullptr) {
       TRI_Free(TRI_UNKNOWN_MEM_ZONE, shape);
@@ -372,13 +366,13 @@ static TRI_shape_t const* FindShape (TRI_shaper_t* shaper,
     char const* m = static_cast<char const*>(slotInfo.mem) + sizeof(triagens::wal::shape_marker_t);
     TRI_shape_t const* result = reinterpret_cast<TRI_shape_t const*>(m);
 
-    void* f = TRI_InsertKeyAssociativeSynced(&s->_shapeIds, &sid, (void*) m, false);
+    void* f = TRI_InsertKeyAssociativeLockFree(&s->_shapeIds, &sid, (void*) m, false);
     if (f != nullptr) {
       LOG_ERROR("logic error when inserting shape into id dictionary");
     }
     TRI_ASSERT(f == nullptr);
 
-    f = TRI_InsertElementAssociativeSynced(&s->_shapeDictionary, (void*) m, false);
+    f = TRI_InsertElementAssociativeLockFree(&s->_shapeDictionary, (void*) m, false);
     if (f != nullptr) {
       LOG_ERROR("logic error when inserting shape into dictionary");
     }
@@ -405,7 +399,7 @@ static TRI_shape_t const* FindShape (TRI_shaper_t* shaper,
 /// @brief hashes the shape id
 ////////////////////////////////////////////////////////////////////////////////
 
-static uint64_t HashKeyShapeId (TRI_associative_synced_t* array,
+static uint64_t HashKeyShapeId (TRI_associative_lockfree_t* array,
                                 void const* key) {
   TRI_shape_sid_t const* k = static_cast<TRI_shape_sid_t const*>(key);
   return TRI_FnvHashPointer(k, sizeof(TRI_shape_sid_t));
@@ -415,7 +409,7 @@ static uint64_t HashKeyShapeId (TRI_associative_synced_t* array,
 /// @brief hashes the shape
 ////////////////////////////////////////////////////////////////////////////////
 
-static uint64_t HashElementShapeId (TRI_associative_synced_t* array,
+static uint64_t HashElementShapeId (TRI_associative_lockfree_t* array,
                                     void const* element) {
   TRI_shape_t const* shape = static_cast<TRI_shape_t const*>(element);
   TRI_ASSERT(shape != nullptr);
@@ -426,7 +420,7 @@ static uint64_t HashElementShapeId (TRI_associative_synced_t* array,
 /// @brief compares a shape id and a shape
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool EqualKeyShapeId (TRI_associative_synced_t* array,
+static bool EqualKeyShapeId (TRI_associative_lockfree_t* array,
                              void const* key,
                              void const* element) {
   TRI_shape_sid_t const* k = static_cast<TRI_shape_sid_t const*>(key);
@@ -446,7 +440,7 @@ static TRI_shape_t const* LookupShapeId (TRI_shaper_t* shaper,
 
   if (shape == nullptr) {
     voc_shaper_t* s = (voc_shaper_t*) shaper;
-    shape = static_cast<TRI_shape_t const*>(TRI_LookupByKeyAssociativeSynced(&s->_shapeIds, &sid));
+    shape = static_cast<TRI_shape_t const*>(TRI_LookupByKeyAssociativeLockFree(&s->_shapeIds, &sid));
   }
 
   return shape;
@@ -456,7 +450,7 @@ static TRI_shape_t const* LookupShapeId (TRI_shaper_t* shaper,
 /// @brief hashes the accessor
 ////////////////////////////////////////////////////////////////////////////////
 
-static uint64_t HashElementAccessor (TRI_associative_pointer_t* array, void const* element) {
+static uint64_t HashElementAccessor (TRI_associative_lockfree_t* array, void const* element) {
   TRI_shape_access_t const* ee = static_cast<TRI_shape_access_t const*>(element);
   uint64_t v[2];
 
@@ -470,7 +464,7 @@ static uint64_t HashElementAccessor (TRI_associative_pointer_t* array, void cons
 /// @brief compares an accessor
 ////////////////////////////////////////////////////////////////////////////////
 
-static bool EqualElementAccessor (TRI_associative_pointer_t* array, void const* left, void const* right) {
+static bool EqualElementAccessor (TRI_associative_lockfree_t* array, void const* left, void const* right) {
   TRI_shape_access_t const* ll = static_cast<TRI_shape_access_t const*>(left);
   TRI_shape_access_t const* rr = static_cast<TRI_shape_access_t const*>(right);
 
@@ -488,7 +482,7 @@ static int InitStep1VocShaper (voc_shaper_t* shaper) {
   shaper->base.findShape                   = FindShape;
   shaper->base.lookupShapeId               = LookupShapeId;
 
-  int res = TRI_InitAssociativeSynced(&shaper->_attributeNames,
+  int res = TRI_InitAssociativeLockFree(&shaper->_attributeNames,
                                       TRI_UNKNOWN_MEM_ZONE,
                                       HashKeyAttributeName,
                                       HashElementAttributeName,
@@ -499,7 +493,7 @@ static int InitStep1VocShaper (voc_shaper_t* shaper) {
     return res;
   }
 
-  res = TRI_InitAssociativeSynced(&shaper->_attributeIds,
+  res = TRI_InitAssociativeLockFree(&shaper->_attributeIds,
                                   TRI_UNKNOWN_MEM_ZONE,
                                   HashKeyAttributeId,
                                   HashElementAttributeId,
@@ -507,12 +501,12 @@ static int InitStep1VocShaper (voc_shaper_t* shaper) {
                                   0);
 
   if (res != TRI_ERROR_NO_ERROR) {
-    TRI_DestroyAssociativeSynced(&shaper->_attributeNames);
+    TRI_DestroyAssociativeLockFree(&shaper->_attributeNames);
 
     return res;
   }
 
-  res = TRI_InitAssociativeSynced(&shaper->_shapeDictionary,
+  res = TRI_InitAssociativeLockFree(&shaper->_shapeDictionary,
                                   TRI_UNKNOWN_MEM_ZONE,
                                   0,
                                   HashElementShape,
@@ -520,13 +514,13 @@ static int InitStep1VocShaper (voc_shaper_t* shaper) {
                                   EqualElementShape);
 
   if (res != TRI_ERROR_NO_ERROR) {
-    TRI_DestroyAssociativeSynced(&shaper->_attributeIds);
-    TRI_DestroyAssociativeSynced(&shaper->_attributeNames);
+    TRI_DestroyAssociativeLockFree(&shaper->_attributeIds);
+    TRI_DestroyAssociativeLockFree(&shaper->_attributeNames);
 
     return res;
   }
 
-  res = TRI_InitAssociativeSynced(&shaper->_shapeIds,
+  res = TRI_InitAssociativeLockFree(&shaper->_shapeIds,
                                   TRI_UNKNOWN_MEM_ZONE,
                                   HashKeyShapeId,
                                   HashElementShapeId,
@@ -534,35 +528,35 @@ static int InitStep1VocShaper (voc_shaper_t* shaper) {
                                   0);
 
   if (res != TRI_ERROR_NO_ERROR) {
-    TRI_DestroyAssociativeSynced(&shaper->_shapeDictionary);
-    TRI_DestroyAssociativeSynced(&shaper->_attributeIds);
-    TRI_DestroyAssociativeSynced(&shaper->_attributeNames);
+    TRI_DestroyAssociativeLockFree(&shaper->_shapeDictionary);
+    TRI_DestroyAssociativeLockFree(&shaper->_attributeIds);
+    TRI_DestroyAssociativeLockFree(&shaper->_attributeNames);
 
     return res;
   }
 
-  res = TRI_InitAssociativePointer(&shaper->_accessors,
-                                   TRI_UNKNOWN_MEM_ZONE,
-                                   0,
-                                   HashElementAccessor,
-                                   0,
-                                   EqualElementAccessor);
+  res = TRI_InitAssociativeLockFree(&shaper->_accessors,
+                                    TRI_UNKNOWN_MEM_ZONE,
+                                    0,
+                                    HashElementAccessor,
+                                    0,
+                                    EqualElementAccessor);
 
   if (res != TRI_ERROR_NO_ERROR) {
-    TRI_DestroyAssociativeSynced(&shaper->_shapeIds);
-    TRI_DestroyAssociativeSynced(&shaper->_shapeDictionary);
-    TRI_DestroyAssociativeSynced(&shaper->_attributeIds);
-    TRI_DestroyAssociativeSynced(&shaper->_attributeNames);
+    TRI_DestroyAssociativeLockFree(&shaper->_shapeIds);
+    TRI_DestroyAssociativeLockFree(&shaper->_shapeDictionary);
+    TRI_DestroyAssociativeLockFree(&shaper->_attributeIds);
+    TRI_DestroyAssociativeLockFree(&shaper->_attributeNames);
 
     return res;
   }
 
   if (res != TRI_ERROR_NO_ERROR) {
-    TRI_DestroyAssociativePointer(&shaper->_accessors);
-    TRI_DestroyAssociativeSynced(&shaper->_shapeIds);
-    TRI_DestroyAssociativeSynced(&shaper->_shapeDictionary);
-    TRI_DestroyAssociativeSynced(&shaper->_attributeIds);
-    TRI_DestroyAssociativeSynced(&shaper->_attributeNames);
+    TRI_DestroyAssociativeLockFree(&shaper->_accessors);
+    TRI_DestroyAssociativeLockFree(&shaper->_shapeIds);
+    TRI_DestroyAssociativeLockFree(&shaper->_shapeDictionary);
+    TRI_DestroyAssociativeLockFree(&shaper->_attributeIds);
+    TRI_DestroyAssociativeLockFree(&shaper->_attributeNames);
 
     return res;
   }
@@ -632,19 +626,22 @@ void TRI_DestroyVocShaper (TRI_shaper_t* s) {
 
   TRI_ASSERT(shaper != nullptr);
 
-  TRI_DestroyAssociativeSynced(&shaper->_attributeNames);
-  TRI_DestroyAssociativeSynced(&shaper->_attributeIds);
-  TRI_DestroyAssociativeSynced(&shaper->_shapeDictionary);
-  TRI_DestroyAssociativeSynced(&shaper->_shapeIds);
+  TRI_DestroyAssociativeLockFree(&shaper->_attributeNames);
+  TRI_DestroyAssociativeLockFree(&shaper->_attributeIds);
+  TRI_DestroyAssociativeLockFree(&shaper->_shapeDictionary);
+  TRI_DestroyAssociativeLockFree(&shaper->_shapeIds);
+
+  // only the current table needs to be inspected, as it contains all accessors
+  TRI_associative_lockfree_table_t const* table = shaper->_accessors._table.load();
 
-  for (size_t i = 0; i < shaper->_accessors._nrAlloc; ++i) {
-    TRI_shape_access_t* accessor = (TRI_shape_access_t*) shaper->_accessors._table[i];
+  for (uint64_t i = 0; i < table->_nrAlloc; ++i) {
+    TRI_shape_access_t* accessor = static_cast<TRI_shape_access_t*>(table->_slots[i].load());
 
     if (accessor != nullptr) {
       TRI_FreeShapeAccessor(accessor);
     }
   }
-  TRI_DestroyAssociativePointer(&shaper->_accessors);
+  TRI_DestroyAssociativeLockFree(&shaper->_accessors);
   TRI_DestroyShaper(s);
 }
 
@@ -689,7 +686,7 @@ int TRI_MoveMarkerVocShaper (TRI_shaper_t* s,
 
     if (expectedOldPosition != nullptr) {
       char* old = static_cast<char*>(expectedOldPosition);
-      void const* found = TRI_LookupByKeyAssociativeSynced(&shaper->_shapeIds, &l->_sid);
+      void const* found = TRI_LookupByKeyAssociativeLockFree(&shaper->_shapeIds, &l->_sid);
 
       if (found != nullptr) {
         if (old + sizeof(TRI_df_shape_marker_t) != found &&
@@ -705,7 +702,7 @@ int TRI_MoveMarkerVocShaper (TRI_shaper_t* s,
 
     // remove the old marker
     // and re-insert the marker with the new pointer
-    f = TRI_InsertKeyAssociativeSynced(&shaper->_shapeIds, &l->_sid, l, true);
+    f = TRI_InsertKeyAssociativeLockFree(&shaper->_shapeIds, &l->_sid, l, true);
 
     // note: this assertion is wrong if the recovery collects the shape in the WAL and it has not been transferred
     // into the collection datafile yet
@@ -716,7 +713,7 @@ int TRI_MoveMarkerVocShaper (TRI_shaper_t* s,
 
     // same for the shape dictionary
     // delete and re-insert
-    f = TRI_InsertElementAssociativeSynced(&shaper->_shapeDictionary, l, true);
+    f = TRI_InsertElementAssociativeLockFree(&shaper->_shapeDictionary, l, true);
 
     // note: this assertion is wrong if the recovery collects the shape in the WAL and it has not been transferred
     // into the collection datafile yet
@@ -733,7 +730,7 @@ int TRI_MoveMarkerVocShaper (TRI_shaper_t* s,
     MUTEX_LOCKER(shaper->_attributeLock);
     
     if (expectedOldPosition != nullptr) {
-      void const* found = TRI_LookupByKeyAssociativeSynced(&shaper->_attributeNames, p);
+      void const* found = TRI_LookupByKeyAssociativeLockFree(&shaper->_attributeNames, p);
 
       if (found != nullptr && found != expectedOldPosition) {
         // do not insert if position doesn't match the expectation
@@ -747,7 +744,7 @@ int TRI_MoveMarkerVocShaper (TRI_shaper_t* s,
     // remove attribute by name (p points to new location of name, but names
     // are identical in old and new marker)
     // and re-insert same attribute with adjusted pointer
-    f = TRI_InsertKeyAssociativeSynced(&shaper->_attributeNames, p, m, true);
+    f = TRI_InsertKeyAssociativeLockFree(&shaper->_attributeNames, p, m, true);
 
     // note: this assertion is wrong if the recovery collects the attribute in the WAL and it has not been transferred
     // into the collection datafile yet
@@ -758,7 +755,7 @@ int TRI_MoveMarkerVocShaper (TRI_shaper_t* s,
 
     // same for attribute ids
     // delete and re-insert same attribute with adjusted pointer
-    f = TRI_InsertKeyAssociativeSynced(&shaper->_attributeIds, &m->_aid, m, true);
+    f = TRI_InsertKeyAssociativeLockFree(&shaper->_attributeIds, &m->_aid, m, true);
 
     // note: this assertion is wrong if the recovery collects the attribute in the WAL and it has not been transferred
     // into the collection datafile yet
@@ -798,7 +795,7 @@ int TRI_InsertShapeVocShaper (TRI_shaper_t* s,
   MUTEX_LOCKER(shaper->_shapeLock);
 
   void* f;
-  f = TRI_InsertElementAssociativeSynced(&shaper->_shapeDictionary, l, false);
+  f = TRI_InsertElementAssociativeLockFree(&shaper->_shapeDictionary, l, false);
   if (warnIfDuplicate && f != nullptr) {
     char const* name = shaper->_collection->_info._name;
 #ifdef TRI_ENABLE_MAINTAINER_MODE
@@ -809,7 +806,7 @@ int TRI_InsertShapeVocShaper (TRI_shaper_t* s,
 #endif
   }
 
-  f = TRI_InsertKeyAssociativeSynced(&shaper->_shapeIds, &l->_sid, l, false);
+  f = TRI_InsertKeyAssociativeLockFree(&shaper->_shapeIds, &l->_sid, l, false);
   if (warnIfDuplicate && f != nullptr) {
     char const* name = shaper->_collection->_info._name;
 
@@ -859,7 +856,7 @@ int TRI_InsertAttributeVocShaper (TRI_shaper_t* s,
   MUTEX_LOCKER(shaper->_attributeLock);
 
   void* found;
-  found = TRI_InsertKeyAssociativeSynced(&shaper->_attributeNames, name, (void*) marker, false);
+  found = TRI_InsertKeyAssociativeLockFree(&shaper->_attributeNames, name, (void*) marker, false);
 
   if (warnIfDuplicate && found != nullptr) {
     char const* cname = shaper->_collection->_info._name;
@@ -871,7 +868,7 @@ int TRI_InsertAttributeVocShaper (TRI_shaper_t* s,
 #endif
   }
 
-  found = TRI_InsertKeyAssociativeSynced(&shaper->_attributeIds, &aid, (void*) marker, false);
+  found = TRI_InsertKeyAssociativeLockFree(&shaper->_attributeIds, &aid, (void*) marker, false);
 
   if (warnIfDuplicate && found != nullptr) {
     char const* cname = shaper->_collection->_info._name;
@@ -902,15 +899,10 @@ TRI_shape_access_t const* TRI_FindAccessorVocShaper (TRI_shaper_t* s,
 
   voc_shaper_t* shaper = (voc_shaper_t*) s;
 
-  TRI_shape_access_t const* found;
-  {
-    READ_LOCKER(shaper->_accessorLock);
+  TRI_shape_access_t const* found = static_cast<TRI_shape_access_t const*>(TRI_LookupByElementAssociativeLockFree(&shaper->_accessors, &search));
 
-    found = static_cast<TRI_shape_access_t const*>(TRI_LookupByElementAssociativePointer(&shaper->_accessors, &search));
-
-    if (found != nullptr) {
-      return found;
-    }
+  if (found != nullptr) {
+    return found;
   }
 
   // not found... time for us to create the accessor ourselves!
@@ -921,16 +913,12 @@ TRI_shape_access_t const* TRI_FindAccessorVocShaper (TRI_shaper_t* s,
     return nullptr;
   }
 
-  // acquire the write-lock and try to insert our own accessor
-  {
-    WRITE_LOCKER(shaper->_accessorLock);
-
-    found = static_cast<TRI_shape_access_t const*>(TRI_InsertElementAssociativePointer(&shaper->_accessors, const_cast<void*>(static_cast<void const*>(accessor)), false));
-  }
+  // try to insert our own accessor
+  found = static_cast<TRI_shape_access_t const*>(TRI_InsertElementAssociativeLockFree(&shaper->_accessors, const_cast<void*>(static_cast<void const*>(accessor)), false));
 
   if (found != nullptr) {
-    // someone else inserted the same accessor in the period after we release the read-lock
-    // but before we acquired the write-lock
+    // someone else inserted the same accessor in the period after our lookup
+    // but before our insert
     // this is ok, and we can return the concurrently built accessor now
     TRI_FreeShapeAccessor(accessor);
     return found;
@@ -36,6 +36,8 @@
 #include <regex.h>
 
 #include "Aql/QueryList.h"
+#include "Aql/QueryPlanCache.h"
+#include "Aql/QueryResultCache.h"
 #include "Basics/conversions.h"
 #include "Basics/files.h"
 #include "Basics/hashes.h"
@@ -1371,6 +1373,8 @@ TRI_vocbase_t* TRI_CreateInitialVocBase (TRI_server_t* server,
   vocbase->_userStructures     = nullptr;
   vocbase->_cursorRepository   = nullptr;
   vocbase->_queries            = nullptr;
+  vocbase->_queryPlanCache     = nullptr;
+  vocbase->_queryResultCache   = nullptr;
   vocbase->_oldTransactions    = nullptr;
 
   try {
@@ -1385,10 +1389,39 @@ TRI_vocbase_t* TRI_CreateInitialVocBase (TRI_server_t* server,
     return nullptr;
   }
 
+  try {
+    vocbase->_queryPlanCache   = new triagens::aql::QueryPlanCache();
+  }
+  catch (...) {
+    delete static_cast<triagens::aql::QueryList*>(vocbase->_queries);
+    TRI_Free(TRI_CORE_MEM_ZONE, vocbase->_name);
+    TRI_Free(TRI_CORE_MEM_ZONE, vocbase->_path);
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, vocbase);
+    TRI_set_errno(TRI_ERROR_OUT_OF_MEMORY);
+    
+    return nullptr;
+  }
+
+  try {
+    vocbase->_queryResultCache = new triagens::aql::QueryResultCache();
+  }
+  catch (...) {
+    delete static_cast<triagens::aql::QueryPlanCache*>(vocbase->_queryPlanCache);
+    delete static_cast<triagens::aql::QueryList*>(vocbase->_queries);
+    TRI_Free(TRI_CORE_MEM_ZONE, vocbase->_name);
+    TRI_Free(TRI_CORE_MEM_ZONE, vocbase->_path);
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, vocbase);
+    TRI_set_errno(TRI_ERROR_OUT_OF_MEMORY);
+    
+    return nullptr;
+  }
+
   try {
     vocbase->_cursorRepository = new triagens::arango::CursorRepository(vocbase);
   }
   catch (...) {
+    delete static_cast<triagens::aql::QueryResultCache*>(vocbase->_queryResultCache);
+    delete static_cast<triagens::aql::QueryPlanCache*>(vocbase->_queryPlanCache);
     delete static_cast<triagens::aql::QueryList*>(vocbase->_queries);
     TRI_Free(TRI_CORE_MEM_ZONE, vocbase->_name);
     TRI_Free(TRI_CORE_MEM_ZONE, vocbase->_path);
@@ -1476,6 +1509,14 @@ void TRI_DestroyInitialVocBase (TRI_vocbase_t* vocbase) {
     delete static_cast<triagens::arango::CursorRepository*>(vocbase->_cursorRepository);
   }
 
+  if (vocbase->_queryResultCache != nullptr) {
+    delete static_cast<triagens::aql::QueryResultCache*>(vocbase->_queryResultCache);
+  }
+
+  if (vocbase->_queryPlanCache != nullptr) {
+    delete static_cast<triagens::aql::QueryPlanCache*>(vocbase->_queryPlanCache);
+  }
+
   if (vocbase->_queries != nullptr) {
     delete static_cast<triagens::aql::QueryList*>(vocbase->_queries);
   }
@@ -1977,6 +2018,11 @@ TRI_vocbase_col_t* TRI_CreateCollectionVocBase (TRI_vocbase_t* vocbase,
 
   TRI_ReadUnlockReadWriteLock(&vocbase->_inventoryLock);
 
+  if (collection != nullptr) {
+    // plans for a previous collection with the same name must not be reused
+    TRI_InvalidateQueryCachesVocBase(vocbase, parameters->_name);
+  }
+
   return collection;
 }
 
@@ -2131,6 +2177,7 @@ int TRI_DropCollectionVocBase (TRI_vocbase_t* vocbase,
 
     collection->_status = TRI_VOC_COL_STATUS_DELETED;
     UnregisterCollection(vocbase, collection);
+    TRI_InvalidateQueryCachesVocBase(vocbase, collection->_name);
     if (writeMarker) {
       WriteDropCollectionMarker(vocbase, collection->_cid);
     }
@@ -2192,6 +2239,7 @@ int TRI_DropCollectionVocBase (TRI_vocbase_t* vocbase,
     collection->_status = TRI_VOC_COL_STATUS_DELETED;
 
     UnregisterCollection(vocbase, collection);
+    TRI_InvalidateQueryCachesVocBase(vocbase, collection->_name);
     if (writeMarker) {
       WriteDropCollectionMarker(vocbase, collection->_cid);
     }
@@ -2296,11 +2344,49 @@ int TRI_RenameCollectionVocBase (TRI_vocbase_t* vocbase,
 
   TRI_ReadUnlockReadWriteLock(&vocbase->_inventoryLock);
 
+  if (res == TRI_ERROR_NO_ERROR) {
+    TRI_InvalidateQueryCachesVocBase(vocbase, oldName);
+    TRI_InvalidateQueryCachesVocBase(vocbase, newName);
+  }
+
   TRI_FreeString(TRI_CORE_MEM_ZONE, oldName);
 
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes all cached query plans and results that use a collection
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_InvalidateQueryCachesVocBase (TRI_vocbase_t* vocbase,
+                                       char const* name) {
+  auto planCache = static_cast<triagens::aql::QueryPlanCache*>(vocbase->_queryPlanCache);
+
+  if (planCache != nullptr) {
+    planCache->invalidate(name);
+  }
+
+  auto resultCache = static_cast<triagens::aql::QueryResultCache*>(vocbase->_queryResultCache);
+
+  if (resultCache != nullptr) {
+    resultCache->invalidate(name);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes all cached query results that were produced from a
+/// collection
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_InvalidateQueryResultsVocBase (TRI_vocbase_t* vocbase,
+                                        TRI_voc_cid_t cid) {
+  auto resultCache = static_cast<triagens::aql::QueryResultCache*>(vocbase->_queryResultCache);
+
+  if (resultCache != nullptr) {
+    resultCache->invalidate(cid);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief locks a (document) collection for usage, loading or manifesting it
 ////////////////////////////////////////////////////////////////////////////////
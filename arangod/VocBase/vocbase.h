@@ -313,6 +313,8 @@ typedef struct TRI_vocbase_s {
   // structures for user-defined volatile data
   void*                      _userStructures;
   void*                      _queries;
+  void*                      _queryPlanCache;
+  void*                      _queryResultCache;
   void*                      _cursorRepository;
 
   TRI_associative_pointer_t  _authInfo;
@@ -558,6 +560,23 @@ int TRI_RenameCollectionVocBase (TRI_vocbase_t*,
                                  bool,
                                  bool);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes all cached query plans and results that use a collection.
+/// must be called whenever a collection or its indexes change
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_InvalidateQueryCachesVocBase (TRI_vocbase_t*,
+                                       char const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief removes all cached query results that were produced from a
+/// collection. must be called after each write to the collection, once its
+/// revision has been updated
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_InvalidateQueryResultsVocBase (TRI_vocbase_t*,
+                                        TRI_voc_cid_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief locks a (document) collection for usage, loading or manifesting it
 ///
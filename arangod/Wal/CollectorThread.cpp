@@ -282,7 +282,8 @@ uint64_t const CollectorThread::Interval = 1000000;
 ////////////////////////////////////////////////////////////////////////////////
 
 CollectorThread::CollectorThread (LogfileManager* logfileManager,
-                                  TRI_server_t* server)
+                                  TRI_server_t* server,
+                                  uint32_t numThreads)
   : Thread("WalCollector"),
     _logfileManager(logfileManager),
     _server(server),
@@ -291,7 +292,11 @@ CollectorThread::CollectorThread (LogfileManager* logfileManager,
     _operationsQueue(),
     _operationsQueueInUse(false),
     _stop(0),
-    _numPendingOperations(0) {
+    _numPendingOperations(0),
+    _numThreads(numThreads),
+    _threadPool(nullptr),
+    _statisticsLock(),
+    _statistics() {
 
   allowAsynchronousCancelation();
 }
@@ -301,6 +306,7 @@ CollectorThread::CollectorThread (LogfileManager* logfileManager,
 ////////////////////////////////////////////////////////////////////////////////
 
 CollectorThread::~CollectorThread () {
+  delete _threadPool;
 }
 
 // -----------------------------------------------------------------------------
@@ -333,6 +339,23 @@ void CollectorThread::signal () {
   guard.signal();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the collector statistics
+////////////////////////////////////////////////////////////////////////////////
+
+CollectorStatistics CollectorThread::statistics () {
+  CollectorStatistics result;
+
+  {
+    MUTEX_LOCKER(_statisticsLock);
+    result = _statistics;
+  }
+
+  result.pendingOperations = _numPendingOperations.load();
+
+  return result;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    Thread methods
 // -----------------------------------------------------------------------------
@@ -420,9 +443,23 @@ bool CollectorThread::collectLogfiles () {
     
   _logfileManager->setCollectionRequested(logfile);
 
+  double const startTime = TRI_microtime();
+
   int res = collect(logfile);
 
   if (res == TRI_ERROR_NO_ERROR) {
+    double const duration = TRI_microtime() - startTime;
+
+    {
+      MUTEX_LOCKER(_statisticsLock);
+      ++_statistics.numLogfiles;
+      _statistics.totalTime += duration;
+
+      if (duration > _statistics.maxTime) {
+        _statistics.maxTime = duration;
+      }
+    }
+
     _logfileManager->setCollectionDone(logfile);
     return true;
   }
@@ -456,72 +493,26 @@ bool CollectorThread::processQueuedOperations () {
 
   // go on without the mutex!
 
-  // process operations for each collection
-  for (auto it = _operationsQueue.begin(); it != _operationsQueue.end(); ++it) {
-    auto& operations = (*it).second;
-    TRI_ASSERT(! operations.empty());
-
-    for (auto it2 = operations.begin(); it2 != operations.end(); /* no hoisting */ ) {
-      Logfile* logfile = (*it2)->logfile;
-
-      int res = TRI_ERROR_INTERNAL;
-
-      try {
-        res = processCollectionOperations((*it2));
-      }
-      catch (triagens::basics::Exception const& ex) {
-        res = ex.code();
-      }
-
-      if (res == TRI_ERROR_LOCK_TIMEOUT) {
-        // could not acquire write-lock for collection in time
-        // do not delete the operations
-        ++it2;
-        continue;
-      }
-
-      if (res == TRI_ERROR_NO_ERROR) {
-        LOG_TRACE("queued operations applied successfully");
-      }
-      else if (res == TRI_ERROR_ARANGO_DATABASE_NOT_FOUND ||
-               res == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
-        // these are expected errors
-        LOG_TRACE("removing queued operations for already deleted collection");
-        res = TRI_ERROR_NO_ERROR;
-      }
-      else {
-        LOG_WARNING("got unexpected error code while applying queued operations: %s", TRI_errno_string(res));
-      }
-
-      if (res == TRI_ERROR_NO_ERROR) {
-        uint64_t numOperations = (*it2)->operations->size();
-        uint64_t maxNumPendingOperations = _logfileManager->throttleWhenPending();
-
-        if (maxNumPendingOperations > 0 && 
-            _numPendingOperations >= maxNumPendingOperations &&
-            (_numPendingOperations - numOperations) < maxNumPendingOperations) {
-          // write-throttling was active, but can be turned off now
-          _logfileManager->deactivateWriteThrottling();
-          LOG_INFO("deactivating write-throttling");
-        }
-
-        _numPendingOperations -= numOperations;
-
-        // delete the object
-        delete (*it2);
+  // the queue's structure will not change while the flag is set, so the
+  // per-collection vectors can be handed to different workers
+  std::vector<std::vector<CollectorCache*>*> work;
+  work.reserve(_operationsQueue.size());
 
-        // delete the element from the vector while iterating over the vector
-        it2 = operations.erase(it2);
+  for (auto it = _operationsQueue.begin(); it != _operationsQueue.end(); ++it) {
+    TRI_ASSERT(! (*it).second.empty());
+    work.push_back(&((*it).second));
+  }
 
-        _logfileManager->decreaseCollectQueueSize(logfile);
-      }
-      else {
-        // do not delete the object but advance in the operations vector
-        ++it2;
-      }
-    }
+  // process operations for each collection. operations of the same collection
+  // are always applied in order and by the same worker
+  int res = parallelFor(work.size(), [this, &work] (size_t i) -> int {
+    processQueuedCollectionOperations(*work[i]);
+    return TRI_ERROR_NO_ERROR;
+  });
 
-    // next collection
+  if (res != TRI_ERROR_NO_ERROR) {
+    // the caller will re-activate the queue
+    THROW_ARANGO_EXCEPTION(res);
   }
 
   // finally remove all entries from the map with empty vectors
@@ -544,6 +535,73 @@ bool CollectorThread::processQueuedOperations () {
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the queued operations of a single collection, in order
+////////////////////////////////////////////////////////////////////////////////
+
+void CollectorThread::processQueuedCollectionOperations (std::vector<CollectorCache*>& operations) {
+  for (auto it = operations.begin(); it != operations.end(); /* no hoisting */ ) {
+    Logfile* logfile = (*it)->logfile;
+
+    int res = TRI_ERROR_INTERNAL;
+
+    try {
+      res = processCollectionOperations((*it));
+    }
+    catch (triagens::basics::Exception const& ex) {
+      res = ex.code();
+    }
+
+    if (res == TRI_ERROR_LOCK_TIMEOUT) {
+      // could not acquire write-lock for collection in time
+      // do not delete the operations
+      ++it;
+      continue;
+    }
+
+    if (res == TRI_ERROR_NO_ERROR) {
+      LOG_TRACE("queued operations applied successfully");
+    }
+    else if (res == TRI_ERROR_ARANGO_DATABASE_NOT_FOUND ||
+             res == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+      // these are expected errors
+      LOG_TRACE("removing queued operations for already deleted collection");
+      res = TRI_ERROR_NO_ERROR;
+    }
+    else {
+      LOG_WARNING("got unexpected error code while applying queued operations: %s", TRI_errno_string(res));
+    }
+
+    if (res == TRI_ERROR_NO_ERROR) {
+      uint64_t numOperations = (*it)->operations->size();
+      uint64_t maxNumPendingOperations = _logfileManager->throttleWhenPending();
+
+      // other workers may modify the counter concurrently
+      uint64_t previous = _numPendingOperations.fetch_sub(numOperations);
+
+      if (maxNumPendingOperations > 0 && 
+          previous >= maxNumPendingOperations &&
+          (previous - numOperations) < maxNumPendingOperations) {
+        // write-throttling was active, but can be turned off now
+        _logfileManager->deactivateWriteThrottling();
+        LOG_INFO("deactivating write-throttling");
+      }
+
+      // delete the object
+      delete (*it);
+
+      // delete the element from the vector while iterating over the vector
+      it = operations.erase(it);
+
+      _logfileManager->decreaseCollectQueueSize(logfile);
+    }
+    else {
+      // do not delete the object but advance in the operations vector
+      ++it;
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief check whether there are queued operations left
 ////////////////////////////////////////////////////////////////////////////////
@@ -773,24 +831,33 @@ int CollectorThread::collect (Logfile* logfile) {
     }
   }
 
-  // now for each collection, write all surviving markers into collection datafiles
-  for (auto it = collectionIds.begin(); it != collectionIds.end(); ++it) {
-    auto cid = (*it);
+  std::vector<TRI_voc_cid_t> const work(collectionIds.begin(), collectionIds.end());
+  std::atomic<uint64_t> numCollections(0);
+  std::atomic<uint64_t> numOperations(0);
+
+  // now for each collection, write all surviving markers into collection datafiles.
+  // collections are independent of each other, so they are handled by different
+  // workers. the state is only read from here on
+  int res = parallelFor(work.size(), [&] (size_t i) -> int {
+    auto cid = work[i];
 
     OperationsType sortedOperations;
 
     // insert structural operations - those are already sorted by tick
-    if (state.structuralOperations.find(cid) != state.structuralOperations.end()) {
-      OperationsType const& ops = state.structuralOperations[cid];
+    auto structural = state.structuralOperations.find(cid);
+
+    if (structural != state.structuralOperations.end()) {
+      OperationsType const& ops = (*structural).second;
 
       sortedOperations.insert(sortedOperations.begin(), ops.begin(), ops.end());
       TRI_ASSERT_EXPENSIVE(sortedOperations.size() == ops.size());
     }
 
     // insert document operations - those are sorted by key, not by tick
-    if (state.documentOperations.find(cid) != state.documentOperations.end()) {
-      DocumentOperationsType const& ops = state.documentOperations[cid];
+    auto documents = state.documentOperations.find(cid);
 
+    if (documents != state.documentOperations.end()) {
+      DocumentOperationsType const& ops = (*documents).second;
 
       for (auto it2 = ops.begin(); it2 != ops.end(); ++it2) {
         sortedOperations.push_back((*it2).second);
@@ -802,27 +869,51 @@ int CollectorThread::collect (Logfile* logfile) {
       });
     }
 
-    if (! sortedOperations.empty()) {
-      int res = TRI_ERROR_INTERNAL;
+    if (sortedOperations.empty()) {
+      return TRI_ERROR_NO_ERROR;
+    }
 
-      try {
-        res = transferMarkers(logfile, cid, state.collections[cid], state.operationsCount[cid], sortedOperations);
-      }
-      catch (triagens::basics::Exception const& ex) {
-        res = ex.code();
-      }
-      catch (...) {
-        res = TRI_ERROR_INTERNAL;
-      }
+    auto count = state.operationsCount.find(cid);
+    int64_t const totalOperationsCount = (count == state.operationsCount.end() ? 0 : (*count).second);
 
-      if (res != TRI_ERROR_NO_ERROR &&
-          res != TRI_ERROR_ARANGO_DATABASE_NOT_FOUND &&
-          res != TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
-        LOG_WARNING("got unexpected error in CollectorThread::collect: %s", TRI_errno_string(res));
-        // abort early
-        return res;
-      }
+    int res = TRI_ERROR_INTERNAL;
+
+    try {
+      res = transferMarkers(logfile, cid, state.collections.at(cid), totalOperationsCount, sortedOperations);
+    }
+    catch (triagens::basics::Exception const& ex) {
+      res = ex.code();
+    }
+    catch (...) {
+      res = TRI_ERROR_INTERNAL;
     }
+
+    if (res == TRI_ERROR_ARANGO_DATABASE_NOT_FOUND ||
+        res == TRI_ERROR_ARANGO_COLLECTION_NOT_FOUND) {
+      // these are expected errors
+      return TRI_ERROR_NO_ERROR;
+    }
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      LOG_WARNING("got unexpected error in CollectorThread::collect: %s", TRI_errno_string(res));
+      return res;
+    }
+
+    ++numCollections;
+    numOperations += sortedOperations.size();
+
+    return TRI_ERROR_NO_ERROR;
+  });
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    // abort early
+    return res;
+  }
+
+  {
+    MUTEX_LOCKER(_statisticsLock);
+    _statistics.numCollections += numCollections.load();
+    _statistics.numOperations += numOperations.load();
   }
 
   // TODO: what to do if an error has occurred?
@@ -835,6 +926,33 @@ int CollectorThread::collect (Logfile* logfile) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run a function for the given number of items, using the worker
+/// pool if there is one
+////////////////////////////////////////////////////////////////////////////////
+
+int CollectorThread::parallelFor (size_t n,
+                                  std::function<int(size_t)> const& function) {
+  if (n > 1 && _numThreads > 1) {
+    if (_threadPool == nullptr) {
+      // the collector thread participates, too
+      _threadPool = new triagens::basics::ThreadPool(static_cast<size_t>(_numThreads - 1), "WalCollectorWorker");
+    }
+
+    return _threadPool->parallelFor(n, function);
+  }
+
+  for (size_t i = 0; i < n; ++i) {
+    int res = function(i);
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      return res;
+    }
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief transfer markers into a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -1150,16 +1268,17 @@ int CollectorThread::queueOperations (triagens::wal::Logfile* logfile,
   
   uint64_t numOperations = cache->operations->size();
 
+  // other workers may modify the counter concurrently
+  uint64_t previous = _numPendingOperations.fetch_add(numOperations);
+
   if (maxNumPendingOperations > 0 && 
-      _numPendingOperations < maxNumPendingOperations &&
-      (_numPendingOperations + numOperations) >= maxNumPendingOperations) {
+      previous < maxNumPendingOperations &&
+      (previous + numOperations) >= maxNumPendingOperations) {
     // activate write-throttling!
     _logfileManager->activateWriteThrottling();
     LOG_WARNING("queued more than %llu pending WAL collector operations. now activating write-throttling", 
                 (unsigned long long) maxNumPendingOperations);
   }
-  
-  _numPendingOperations += numOperations;
 
   // we have put the object into the queue successfully
   // now set the original pointer to null so it isn't double-freed
@@ -1399,14 +1518,12 @@ void CollectorThread::finishMarker (char const* walPosition,
   // re-use the original WAL marker's tick
   marker->_tick = tick;
 
-  // calculate the CRC
-  TRI_voc_crc_t crc = TRI_InitialCrc32();
-  crc = TRI_BlockCrc32(crc, const_cast<char*>(datafilePosition), marker->_size);
-  marker->_crc = TRI_FinalCrc32(crc);
-
   TRI_datafile_t* datafile = cache->lastDatafile;
   TRI_ASSERT(datafile != nullptr);
 
+  // calculate the CRC, using the checksum type of the target datafile
+  marker->_crc = TRI_CrcMarkerDatafile(datafile->_version, marker);
+
   // update ticks
   TRI_UpdateTicksDatafile(datafile, marker);
 
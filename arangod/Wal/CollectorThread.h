@@ -34,6 +34,7 @@
 #include "Basics/ConditionVariable.h"
 #include "Basics/Mutex.h"
 #include "Basics/Thread.h"
+#include "Basics/ThreadPool.h"
 #include "VocBase/barrier.h"
 #include "VocBase/datafile.h"
 #include "VocBase/document-collection.h"
@@ -51,6 +52,39 @@ namespace triagens {
     class LogfileManager;
     class Logfile;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                               CollectorStatistics
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief statistics about the work done by the collector thread, plus the
+/// collector's lag behind the WAL (filled in by the logfile manager)
+////////////////////////////////////////////////////////////////////////////////
+
+    struct CollectorStatistics {
+      CollectorStatistics ()
+        : numLogfiles(0),
+          numCollections(0),
+          numOperations(0),
+          pendingOperations(0),
+          totalTime(0.0),
+          maxTime(0.0),
+          lagLogfiles(0),
+          lagBytes(0),
+          lagTicks(0) {
+      }
+
+      uint64_t  numLogfiles;
+      uint64_t  numCollections;
+      uint64_t  numOperations;
+      uint64_t  pendingOperations;
+      double    totalTime;
+      double    maxTime;
+      uint64_t  lagLogfiles;
+      uint64_t  lagBytes;
+      uint64_t  lagTicks;
+    };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                         struct CollectorOperation
 // -----------------------------------------------------------------------------
@@ -210,7 +244,8 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         CollectorThread (LogfileManager*,
-                         struct TRI_server_s*);
+                         struct TRI_server_s*,
+                         uint32_t);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroy the collector thread
@@ -254,6 +289,13 @@ namespace triagens {
 
         void signal ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the collector statistics. the lag values are not filled in
+/// here but by the logfile manager
+////////////////////////////////////////////////////////////////////////////////
+
+        CollectorStatistics statistics ();
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    Thread methods
 // -----------------------------------------------------------------------------
@@ -296,6 +338,12 @@ namespace triagens {
 
         bool processQueuedOperations ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process the queued operations of a single collection, in order
+////////////////////////////////////////////////////////////////////////////////
+
+        void processQueuedCollectionOperations (std::vector<CollectorCache*>&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief process all operations for a single collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -308,6 +356,14 @@ namespace triagens {
 
         int collect (Logfile*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief run a function for the given number of items, using the worker
+/// pool if there is one
+////////////////////////////////////////////////////////////////////////////////
+
+        int parallelFor (size_t,
+                         std::function<int(size_t)> const&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief transfer markers into a collection
 ////////////////////////////////////////////////////////////////////////////////
@@ -426,7 +482,34 @@ namespace triagens {
 /// @brief number of pending operations in collector queue
 ////////////////////////////////////////////////////////////////////////////////
 
-        uint64_t _numPendingOperations;
+        std::atomic<uint64_t> _numPendingOperations;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of threads used for collection, including the collector
+/// thread itself
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t const _numThreads;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief worker pool for transferring markers and applying the queued
+/// operations of different collections in parallel. the pool is created
+/// lazily, and never if the collector is configured to use a single thread
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::ThreadPool* _threadPool;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief statistics lock
+////////////////////////////////////////////////////////////////////////////////
+
+        triagens::basics::Mutex _statisticsLock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief collector statistics
+////////////////////////////////////////////////////////////////////////////////
+
+        CollectorStatistics _statistics;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief wait interval for the collector thread when idle
@@ -137,11 +137,15 @@ LogfileManager::LogfileManager (TRI_server_t* server,
     _maxOpenLogfiles(0),
     _numberOfSlots(1048576),
     _syncInterval(100),
+    _syncCommitWindow(0),
+    _syncCommitSize(64),
     _maxThrottleWait(15000),
     _throttleWhenPending(0),
     _allowOversizeEntries(true),
     _ignoreLogfileErrors(false),
     _ignoreRecoveryErrors(false),
+    _recoveryThreads(4),
+    _collectorThreads(2),
     _suppressShapeInformation(false),
     _allowWrites(false), // start in read-only mode
     _hasFoundLastTick(false),
@@ -233,16 +237,20 @@ void LogfileManager::initialise (std::string* path,
 void LogfileManager::setupOptions (std::map<std::string, triagens::basics::ProgramOptionsDescription>& options) {
   options["Write-ahead log options:help-wal"]
     ("wal.allow-oversize-entries", &_allowOversizeEntries, "allow entries that are bigger than --wal.logfile-size")
+    ("wal.collector-threads", &_collectorThreads, "number of threads for collecting the operations of different collections in parallel")
     ("wal.directory", &_directory, "logfile directory")
     ("wal.historic-logfiles", &_historicLogfiles, "maximum number of historic logfiles to keep after collection")
     ("wal.ignore-logfile-errors", &_ignoreLogfileErrors, "ignore logfile errors. this will read recoverable data from corrupted logfiles but ignore any unrecoverable data")
     ("wal.ignore-recovery-errors", &_ignoreRecoveryErrors, "continue recovery even if re-applying operations fails")
     ("wal.logfile-size", &_filesize, "size of each logfile (in bytes)")
     ("wal.open-logfiles", &_maxOpenLogfiles, "maximum number of parallel open logfiles")
+    ("wal.recovery-threads", &_recoveryThreads, "number of threads for applying the operations of different collections in parallel during recovery")
     ("wal.reserve-logfiles", &_reserveLogfiles, "maximum number of reserve logfiles to maintain")
     ("wal.slots", &_numberOfSlots, "number of logfile slots to use")
     ("wal.suppress-shape-information", &_suppressShapeInformation, "do not write shape information for markers (saves a lot of disk space, but effectively disables using the write-ahead log for replication)")
     ("wal.sync-interval", &_syncInterval, "interval for automatic, non-requested disk syncs (in milliseconds)")
+    ("wal.sync-commit-window", &_syncCommitWindow, "maximum time to wait for further operations to join a disk sync (in microseconds, 0 = do not wait)")
+    ("wal.sync-commit-size", &_syncCommitSize, "number of pending operations that triggers a disk sync before the commit window has passed")
     ("wal.throttle-when-pending", &_throttleWhenPending, "throttle writes when at least this many operations are waiting for collection (set to 0 to deactivate write-throttling)")
     ("wal.throttle-wait", &_maxThrottleWait, "maximum wait time per operation when write-throttled (in milliseconds)")
   ;
@@ -310,9 +318,25 @@ bool LogfileManager::prepare () {
   // we use microseconds
   _syncInterval = _syncInterval * 1000;
 
+  if (_syncCommitWindow > _syncInterval) {
+    LOG_FATAL_AND_EXIT("invalid value for --wal.sync-commit-window. Please use a value not greater than the sync interval");
+  }
+
+  if (_syncCommitSize == 0) {
+    LOG_FATAL_AND_EXIT("invalid value for --wal.sync-commit-size. Please use a value of at least 1");
+  }
+
+  if (_recoveryThreads == 0 || _recoveryThreads > 64) {
+    LOG_FATAL_AND_EXIT("invalid value for --wal.recovery-threads. Please use a value between 1 and 64");
+  }
+
+  if (_collectorThreads == 0 || _collectorThreads > 64) {
+    LOG_FATAL_AND_EXIT("invalid value for --wal.collector-threads. Please use a value between 1 and 64");
+  }
+
   // initialise some objects
   _slots = new Slots(this, _numberOfSlots, 0);
-  _recoverState = new RecoverState(_server, _ignoreRecoveryErrors);
+  _recoverState = new RecoverState(_server, _ignoreRecoveryErrors, _recoveryThreads);
 
   return true;
 }
@@ -1450,6 +1474,80 @@ LogfileManagerState LogfileManager::state () {
   return state;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the statistics of the synchroniser thread
+////////////////////////////////////////////////////////////////////////////////
+
+SynchroniserStatistics LogfileManager::syncStatistics () {
+  if (_synchroniserThread == nullptr) {
+    return SynchroniserStatistics();
+  }
+
+  return _synchroniserThread->statistics();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the statistics of the collector thread, including the
+/// collector's lag behind the write-ahead log
+////////////////////////////////////////////////////////////////////////////////
+
+CollectorStatistics LogfileManager::collectorStatistics () {
+  CollectorStatistics result;
+
+  if (_collectorThread != nullptr) {
+    result = _collectorThread->statistics();
+  }
+
+  // the lag is made up of all logfiles with data that has not been
+  // collected yet, including the currently open one
+  TRI_voc_tick_t minTick = 0;
+
+  {
+    READ_LOCKER(_logfilesLock);
+
+    for (auto it = _logfiles.begin(); it != _logfiles.end(); ++it) {
+      Logfile* logfile = (*it).second;
+
+      if (logfile == nullptr) {
+        continue;
+      }
+
+      auto status = logfile->status();
+
+      if (status != Logfile::StatusType::OPEN &&
+          status != Logfile::StatusType::SEAL_REQUESTED &&
+          status != Logfile::StatusType::SEALED &&
+          status != Logfile::StatusType::COLLECTION_REQUESTED) {
+        continue;
+      }
+
+      TRI_datafile_t const* df = logfile->df();
+
+      if (df == nullptr || df->_tickMin == 0) {
+        // logfile does not contain any data yet
+        continue;
+      }
+
+      ++result.lagLogfiles;
+      result.lagBytes += static_cast<uint64_t>(df->_currentSize);
+
+      if (minTick == 0 || df->_tickMin < minTick) {
+        minTick = df->_tickMin;
+      }
+    }
+  }
+
+  if (minTick > 0) {
+    TRI_voc_tick_t lastTick = _slots->lastCommittedTick();
+
+    if (lastTick >= minTick) {
+      result.lagTicks = static_cast<uint64_t>(lastTick - minTick + 1);
+    }
+  }
+
+  return result;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -1770,7 +1868,7 @@ void LogfileManager::stopAllocatorThread () {
 ////////////////////////////////////////////////////////////////////////////////
 
 int LogfileManager::startCollectorThread () {
-  _collectorThread = new CollectorThread(this, _server);
+  _collectorThread = new CollectorThread(this, _server, _collectorThreads);
 
   if (_collectorThread == nullptr) {
     return TRI_ERROR_INTERNAL;
@@ -48,10 +48,12 @@ namespace triagens {
 
     class AllocatorThread;
     class CollectorThread;
+    struct CollectorStatistics;
     struct RecoverState;
     class RemoverThread;
     class Slot;
     class SynchroniserThread;
+    struct SynchroniserStatistics;
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                               LogfileManagerState
@@ -197,6 +199,44 @@ namespace triagens {
           _syncInterval = value * 1000;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the group commit window (in microseconds)
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint64_t syncCommitWindow () const {
+          return _syncCommitWindow;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the group commit window (in microseconds)
+/// returns false and keeps the current window if the value is greater than
+/// the sync interval
+////////////////////////////////////////////////////////////////////////////////
+
+        inline bool syncCommitWindow (uint64_t value) {
+          if (value > _syncInterval) {
+            return false;
+          }
+          _syncCommitWindow = value;
+          return true;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the number of operations that ends a group commit window
+////////////////////////////////////////////////////////////////////////////////
+
+        inline uint32_t syncCommitSize () const {
+          return _syncCommitSize;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set the number of operations that ends a group commit window
+////////////////////////////////////////////////////////////////////////////////
+
+        inline void syncCommitSize (uint32_t value) {
+          _syncCommitSize = (value > 0 ? value : 1);
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the number of reserve logfiles
 ////////////////////////////////////////////////////////////////////////////////
@@ -635,6 +675,19 @@ namespace triagens {
 
         LogfileManagerState state ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the statistics of the synchroniser thread
+////////////////////////////////////////////////////////////////////////////////
+
+        SynchroniserStatistics syncStatistics ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the statistics of the collector thread, including the
+/// collector's lag behind the write-ahead log
+////////////////////////////////////////////////////////////////////////////////
+
+        CollectorStatistics collectorStatistics ();
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
@@ -912,6 +965,40 @@ namespace triagens {
 
         uint64_t _syncInterval;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief group commit window for disk syncs
+/// @startDocuBlock WalLogfileSyncCommitWindow
+/// `--wal.sync-commit-window`
+///
+/// The maximum time (in microseconds) that ArangoDB will wait for further
+/// operations before synchronizing the write-ahead log to disk. All 
+/// operations that finish within this window, including concurrent operations
+/// executed with the *waitForSync* attribute, will be synchronized to disk 
+/// with a single sync call. The window ends early when at least
+/// `--wal.sync-commit-size` operations are pending. 
+///
+/// Increasing the value will add up to this much latency to operations with
+/// *waitForSync*, but can considerably increase the throughput of durable
+/// writes with many concurrent clients. The default value of *0* turns off
+/// waiting for further operations.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint64_t _syncCommitWindow;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of pending operations that ends a group commit window
+/// @startDocuBlock WalLogfileSyncCommitSize
+/// `--wal.sync-commit-size`
+///
+/// The number of pending operations after which ArangoDB will synchronize the
+/// write-ahead log to disk without waiting for the end of the group commit
+/// window. This option has no effect if `--wal.sync-commit-window` is *0*.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t _syncCommitSize;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief maximum wait time for write-throttling
 ////////////////////////////////////////////////////////////////////////////////
@@ -1007,6 +1094,37 @@ namespace triagens {
 
         bool _ignoreRecoveryErrors;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of recovery threads
+/// @startDocuBlock WalLogfileRecoveryThreads
+/// `--wal.recovery-threads`
+///
+/// The number of threads used for re-applying the document operations found
+/// in the write-ahead logfiles during recovery. Operations of the same
+/// collection are always applied in order by a single thread, but operations
+/// of different collections are applied in parallel. Setting the option to *1*
+/// will apply all operations in the recovering thread.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t _recoveryThreads;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of collector threads
+/// @startDocuBlock WalLogfileCollectorThreads
+/// `--wal.collector-threads`
+///
+/// The number of threads used by the garbage collector for transferring the
+/// operations from the write-ahead logfiles into the collection datafiles, and
+/// for applying them to the collections' in-memory state. Operations of the
+/// same collection are always handled in order by a single thread, but
+/// operations of different collections are handled in parallel. Setting the
+/// option to *1* will make the collector run single-threaded.
+/// @endDocuBlock
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t _collectorThreads;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief suppress shape information
 /// @startDocuBlock WalLogfileSuppressShapeInformation
@@ -52,6 +52,68 @@ static inline bool IsVolatile (TRI_transaction_collection_t const* trxCollection
   return trxCollection->_collection->_collection->_info._isVolatile;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief maximum number of document operations to buffer before applying
+/// them
+////////////////////////////////////////////////////////////////////////////////
+
+static size_t const MaxPendingOperations = 1024 * 1024;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not all pending document operations must be applied
+/// before the marker can be replayed. this is the case for all markers that
+/// modify collections or databases as a whole, and for the markers of remote
+/// transactions, which are executed immediately
+////////////////////////////////////////////////////////////////////////////////
+
+static bool RequiresPendingOperations (TRI_df_marker_t const* marker) {
+  switch (marker->_type) {
+    case TRI_DF_MARKER_HEADER:
+    case TRI_DF_MARKER_FOOTER:
+    case TRI_WAL_MARKER_ATTRIBUTE:
+    case TRI_WAL_MARKER_SHAPE:
+    case TRI_WAL_MARKER_DOCUMENT:
+    case TRI_WAL_MARKER_EDGE:
+    case TRI_WAL_MARKER_REMOVE:
+    case TRI_WAL_MARKER_BEGIN_TRANSACTION:
+    case TRI_WAL_MARKER_COMMIT_TRANSACTION:
+    case TRI_WAL_MARKER_ABORT_TRANSACTION:
+      return false;
+
+    default:
+      return true;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief extract collection and transaction id from a document operation
+/// marker. returns false for all other markers
+////////////////////////////////////////////////////////////////////////////////
+
+static bool GetOperationIds (TRI_df_marker_t const* marker,
+                             TRI_voc_cid_t& collectionId,
+                             TRI_voc_tid_t& transactionId) {
+  switch (marker->_type) {
+    case TRI_WAL_MARKER_DOCUMENT:
+    case TRI_WAL_MARKER_EDGE: {
+      document_marker_t const* m = reinterpret_cast<document_marker_t const*>(marker);
+      collectionId  = m->_collectionId;
+      transactionId = m->_transactionId;
+      return true;
+    }
+
+    case TRI_WAL_MARKER_REMOVE: {
+      remove_marker_t const* m = reinterpret_cast<remove_marker_t const*>(marker);
+      collectionId  = m->_collectionId;
+      transactionId = m->_transactionId;
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the directory for a database
 ////////////////////////////////////////////////////////////////////////////////
@@ -176,7 +238,8 @@ static int WaitForDeletion (TRI_vocbase_t* vocbase,
 ////////////////////////////////////////////////////////////////////////////////
 
 RecoverState::RecoverState (TRI_server_t* server,
-                            bool ignoreRecoveryErrors)
+                            bool ignoreRecoveryErrors,
+                            uint32_t recoveryThreads)
   : server(server),
     failedTransactions(),
     remoteTransactions(),
@@ -188,9 +251,15 @@ RecoverState::RecoverState (TRI_server_t* server,
     openedDatabases(),
     runningRemoteTransactions(),
     emptyLogfiles(),
+    pendingOperations(),
+    numPendingOperations(0),
     policy(TRI_DOC_UPDATE_ONLY_IF_NEWER, 0, nullptr),
     ignoreRecoveryErrors(ignoreRecoveryErrors),
-    errorCount(0) {
+    errorCount(0),
+    recoveryThreads(recoveryThreads),
+    threadPool(nullptr),
+    appliedOperations(0),
+    applyTime(0.0) {
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -208,6 +277,8 @@ RecoverState::~RecoverState () {
   }
 
   runningRemoteTransactions.clear();
+
+  delete threadPool;
 }
 
 // -----------------------------------------------------------------------------
@@ -554,6 +625,290 @@ int RecoverState::executeSingleOperation (TRI_voc_tick_t databaseId,
   return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief queues a document operation for later application
+////////////////////////////////////////////////////////////////////////////////
+
+int RecoverState::queueOperation (TRI_voc_tick_t databaseId,
+                                  TRI_voc_cid_t collectionId,
+                                  TRI_df_marker_t const* marker,
+                                  TRI_voc_fid_t fid) {
+  auto it = pendingOperations.find(collectionId);
+
+  if (it == pendingOperations.end()) {
+    it = pendingOperations.emplace(collectionId, RecoverCollectionOperations()).first;
+    (*it).second.databaseId = databaseId;
+  }
+
+  (*it).second.operations.emplace_back(RecoverOperation({ marker, fid }));
+
+  if (++numPendingOperations >= MaxPendingOperations) {
+    return applyPendingOperations();
+  }
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the pending document operations must be applied
+/// before the marker can be replayed
+////////////////////////////////////////////////////////////////////////////////
+
+bool RecoverState::mustApplyPendingOperations (TRI_df_marker_t const* marker) const {
+  if (RequiresPendingOperations(marker)) {
+    return true;
+  }
+
+  TRI_voc_cid_t collectionId;
+  TRI_voc_tid_t transactionId;
+
+  if (! GetOperationIds(marker, collectionId, transactionId) ||
+      ! isRemoteTransaction(transactionId)) {
+    return false;
+  }
+
+  // operations of remote transactions are not queued but executed directly,
+  // so earlier local operations on the same collection must be applied first
+  return (pendingOperations.find(collectionId) != pendingOperations.end());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief applies all pending document operations
+////////////////////////////////////////////////////////////////////////////////
+
+int RecoverState::applyPendingOperations () {
+  if (pendingOperations.empty()) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  double const start = TRI_microtime();
+
+  // open the databases and collections first. this modifies the state and
+  // must happen in this thread
+  std::vector<std::pair<TRI_vocbase_col_t*, std::vector<RecoverOperation> const*>> work;
+  work.reserve(pendingOperations.size());
+
+  for (auto const& it : pendingOperations) {
+    TRI_voc_tick_t databaseId = it.second.databaseId;
+    TRI_voc_cid_t collectionId = it.first;
+    TRI_vocbase_t* vocbase = useDatabase(databaseId);
+
+    if (vocbase == nullptr) {
+      LOG_TRACE("database %llu not found", (unsigned long long) databaseId);
+      continue;
+    }
+
+    int res;
+    TRI_vocbase_col_t* collection = useCollection(vocbase, collectionId, res);
+
+    if (collection == nullptr || collection->_collection == nullptr) {
+      if (res == TRI_ERROR_ARANGO_CORRUPTED_COLLECTION) {
+        LOG_WARNING("unable to apply operations in collection %llu of database %llu: %s", 
+                    (unsigned long long) collectionId,
+                    (unsigned long long) databaseId,
+                    TRI_errno_string(res));
+        ++errorCount;
+
+        if (! canContinue()) {
+          pendingOperations.clear();
+          numPendingOperations = 0;
+          return res;
+        }
+      }
+      continue;
+    }
+
+    work.emplace_back(collection, &it.second.operations);
+  }
+
+  std::atomic<int64_t> errors(0);
+  std::atomic<uint64_t> applied(0);
+  int res = TRI_ERROR_NO_ERROR;
+
+  auto apply = [&] (size_t i) -> int {
+    return applyCollectionOperations(work[i].first, *(work[i].second), errors, applied);
+  };
+
+  if (work.size() > 1 && recoveryThreads > 1) {
+    if (threadPool == nullptr) {
+      // the calling thread participates, too
+      threadPool = new triagens::basics::ThreadPool(static_cast<size_t>(recoveryThreads - 1), "WalRecovery");
+    }
+
+    res = threadPool->parallelFor(work.size(), apply);
+  }
+  else {
+    for (size_t i = 0; i < work.size(); ++i) {
+      res = apply(i);
+
+      if (res != TRI_ERROR_NO_ERROR) {
+        break;
+      }
+    }
+  }
+
+  double const duration = TRI_microtime() - start;
+
+  errorCount += errors.load();
+  appliedOperations += applied.load();
+  applyTime += duration;
+
+  LOG_DEBUG("applied %llu of %llu WAL operations in %d collection(s) in %.3f s",
+            (unsigned long long) applied.load(),
+            (unsigned long long) numPendingOperations,
+            (int) work.size(),
+            duration);
+
+  pendingOperations.clear();
+  numPendingOperations = 0;
+
+  return res;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief applies the pending document operations of a single collection
+/// the operations are applied directly to the collection inside one single
+/// operation transaction, which does not write any markers and does not
+/// buffer the operations. secondary indexes are disabled during recovery, so
+/// this only touches the primary index and the collection statistics
+////////////////////////////////////////////////////////////////////////////////
+
+int RecoverState::applyCollectionOperations (TRI_vocbase_col_t* collection,
+                                             std::vector<RecoverOperation> const& operations,
+                                             std::atomic<int64_t>& errors,
+                                             std::atomic<uint64_t>& applied) {
+  TRI_voc_tick_t const tickMax = collection->_collection->_tickMax;
+  TRI_voc_tick_t const databaseId = collection->_vocbase->_id;
+  TRI_voc_cid_t const collectionId = collection->_cid;
+
+  // collections are handled in parallel, so each one needs its own policy
+  TRI_doc_update_policy_t updatePolicy(TRI_DOC_UPDATE_ONLY_IF_NEWER, 0, nullptr);
+
+  int res = TRI_ERROR_NO_ERROR;
+  uint64_t count = 0;
+  bool reported = false;
+
+  try {
+    SingleWriteTransactionType trx(new triagens::arango::StandaloneTransactionContext(), collection->_vocbase, collectionId);
+
+    trx.addHint(TRI_TRANSACTION_HINT_NO_BEGIN_MARKER, false);
+    trx.addHint(TRI_TRANSACTION_HINT_NO_ABORT_MARKER, false);
+    trx.addHint(TRI_TRANSACTION_HINT_NO_THROTTLING, false);
+    trx.addHint(TRI_TRANSACTION_HINT_LOCK_NEVER, false);
+
+    res = trx.begin();
+
+    if (res != TRI_ERROR_NO_ERROR) {
+      THROW_ARANGO_EXCEPTION(res);
+    }
+
+    TRI_transaction_collection_t* trxCollection = trx.trxCollection();
+
+    // volatile collections are not recovered
+    if (! IsVolatile(trxCollection)) {
+      for (auto const& operation : operations) {
+        TRI_df_marker_t const* marker = operation.marker;
+
+        if (marker->_tick <= tickMax) {
+          // already transferred this marker
+          continue;
+        }
+
+        EnvelopeMarker envelope(marker, operation.fid);
+        TRI_doc_mptr_copy_t mptr;
+        char const* base = reinterpret_cast<char const*>(marker);
+
+        if (marker->_type == TRI_WAL_MARKER_DOCUMENT) {
+          document_marker_t const* m = reinterpret_cast<document_marker_t const*>(marker);
+          char const* key = base + m->_offsetKey;
+          TRI_shaped_json_t shaped;
+          TRI_EXTRACT_SHAPED_JSON_MARKER(shaped, m);
+
+          res = TRI_InsertShapedJsonDocumentCollection(trxCollection, (TRI_voc_key_t) key, m->_revisionId, &envelope, &mptr, &shaped, nullptr, false, false, true);
+
+          if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) {
+            updatePolicy.setExpectedRevision(m->_revisionId);
+            res = TRI_UpdateShapedJsonDocumentCollection(trxCollection, (TRI_voc_key_t) key, m->_revisionId, &envelope, &mptr, &shaped, &updatePolicy, false, false);
+          }
+        }
+        else if (marker->_type == TRI_WAL_MARKER_EDGE) {
+          edge_marker_t const* m = reinterpret_cast<edge_marker_t const*>(marker);
+          char const* key = base + m->_offsetKey;
+          TRI_document_edge_t edge;
+          edge._fromCid = m->_fromCid;
+          edge._toCid   = m->_toCid;
+          edge._fromKey = const_cast<char*>(base) + m->_offsetFromKey;
+          edge._toKey   = const_cast<char*>(base) + m->_offsetToKey;
+
+          TRI_shaped_json_t shaped;
+          TRI_EXTRACT_SHAPED_JSON_MARKER(shaped, m);
+
+          res = TRI_InsertShapedJsonDocumentCollection(trxCollection, (TRI_voc_key_t) key, m->_revisionId, &envelope, &mptr, &shaped, &edge, false, false, true);
+
+          if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) {
+            updatePolicy.setExpectedRevision(m->_revisionId);
+            res = TRI_UpdateShapedJsonDocumentCollection(trxCollection, (TRI_voc_key_t) key, m->_revisionId, &envelope, &mptr, &shaped, &updatePolicy, false, false);
+          }
+        }
+        else {
+          TRI_ASSERT(marker->_type == TRI_WAL_MARKER_REMOVE);
+
+          remove_marker_t const* m = reinterpret_cast<remove_marker_t const*>(marker);
+          char const* key = base + sizeof(remove_marker_t);
+
+          // remove the document and ignore any potential errors
+          updatePolicy.setExpectedRevision(m->_revisionId);
+          TRI_RemoveShapedJsonDocumentCollection(trxCollection, (TRI_voc_key_t) key, m->_revisionId, &envelope, &updatePolicy, false, false);
+          res = TRI_ERROR_NO_ERROR;
+        }
+
+        if (res != TRI_ERROR_NO_ERROR && 
+            res != TRI_ERROR_ARANGO_CONFLICT) {
+          LOG_WARNING("unable to %s in collection %llu of database %llu: %s", 
+                      (marker->_type == TRI_WAL_MARKER_EDGE ? "insert edge" : "insert document"),
+                      (unsigned long long) collectionId,
+                      (unsigned long long) databaseId,
+                      TRI_errno_string(res));
+          ++errors;
+
+          if (! canContinue()) {
+            reported = true;
+            THROW_ARANGO_EXCEPTION(res);
+          }
+        }
+
+        ++count;
+      }
+    }
+
+    res = trx.commit();
+  }
+  catch (triagens::basics::Exception const& ex) {
+    res = ex.code();
+  }
+  catch (...) {
+    res = TRI_ERROR_INTERNAL;
+  }
+
+  applied += count;
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    if (! reported) {
+      LOG_WARNING("unable to apply operations in collection %llu of database %llu: %s", 
+                  (unsigned long long) collectionId,
+                  (unsigned long long) databaseId,
+                  TRI_errno_string(res));
+      ++errors;
+    }
+
+    if (canContinue()) {
+      return TRI_ERROR_NO_ERROR;
+    }
+  }
+
+  return res;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief callback to handle one marker during recovery
 /// this function only builds up state and does not change any data
@@ -705,6 +1060,15 @@ bool RecoverState::ReplayMarker (TRI_df_marker_t const* marker,
 #ifdef TRI_ENABLE_FAILURE_TESTS
   LOG_TRACE("replaying marker of type %s", TRI_NameMarkerDatafile(marker));
 #endif
+
+  if (! state->pendingOperations.empty() &&
+      state->mustApplyPendingOperations(marker)) {
+    // apply the queued document operations before the collection or database
+    // is modified, or before a remote transaction operates on the collection
+    if (state->applyPendingOperations() != TRI_ERROR_NO_ERROR) {
+      return false;
+    }
+  }
   
   switch (marker->_type) {
 
@@ -816,22 +1180,14 @@ bool RecoverState::ReplayMarker (TRI_df_marker_t const* marker,
         });
       }
       else if (! state->isUsedByRemoteTransaction(collectionId)) {
-        // local operation
-        res = state->executeSingleOperation(databaseId, collectionId, marker, datafile->_fid, [&](SingleWriteTransactionType* trx, Marker* envelope) -> int { 
-          if (IsVolatile(trx->trxCollection())) {
-            return TRI_ERROR_NO_ERROR;
-          } 
-
-          TRI_doc_mptr_copy_t mptr;
-          int res = TRI_InsertShapedJsonDocumentCollection(trx->trxCollection(), (TRI_voc_key_t) key, m->_revisionId, envelope, &mptr, &shaped, nullptr, false, false, true);
-
-          if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) {
-            state->policy.setExpectedRevision(m->_revisionId);
-            res = TRI_UpdateShapedJsonDocumentCollection(trx->trxCollection(), (TRI_voc_key_t) key, m->_revisionId, envelope, &mptr, &shaped, &state->policy, false, false);
-          }
+        // local operation. this is applied later, together with the other
+        // operations of the collection
+        res = state->queueOperation(databaseId, collectionId, marker, datafile->_fid);
 
-          return res;
-        });
+        if (res != TRI_ERROR_NO_ERROR) {
+          // applying the pending operations failed
+          return false;
+        }
       }
       else {
         // ERROR - found a local action for a collection that has an ongoing remote transaction
@@ -900,22 +1256,14 @@ bool RecoverState::ReplayMarker (TRI_df_marker_t const* marker,
         });
       }
       else if (! state->isUsedByRemoteTransaction(collectionId)) {
-        // local operation
-        res = state->executeSingleOperation(databaseId, collectionId, marker, datafile->_fid, [&](SingleWriteTransactionType* trx, Marker* envelope) -> int {
-          if (IsVolatile(trx->trxCollection())) {
-            return TRI_ERROR_NO_ERROR;
-          } 
- 
-          TRI_doc_mptr_copy_t mptr;
-          int res = TRI_InsertShapedJsonDocumentCollection(trx->trxCollection(), (TRI_voc_key_t) key, m->_revisionId, envelope, &mptr, &shaped, &edge, false, false, true);
-
-          if (res == TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED) {
-            state->policy.setExpectedRevision(m->_revisionId);
-            res = TRI_UpdateShapedJsonDocumentCollection(trx->trxCollection(), (TRI_voc_key_t) key, m->_revisionId, envelope, &mptr, &shaped, &state->policy, false, false);
-          }
+        // local operation. this is applied later, together with the other
+        // operations of the collection
+        res = state->queueOperation(databaseId, collectionId, marker, datafile->_fid);
 
-          return res;
-        });
+        if (res != TRI_ERROR_NO_ERROR) {
+          // applying the pending operations failed
+          return false;
+        }
       }
       else {
         // ERROR - found a local action for a collection that has an ongoing remote transaction
@@ -972,18 +1320,14 @@ bool RecoverState::ReplayMarker (TRI_df_marker_t const* marker,
         });
       }
       else if (! state->isUsedByRemoteTransaction(collectionId)) {
-        // local operation
-        res = state->executeSingleOperation(databaseId, collectionId, marker, datafile->_fid, [&](SingleWriteTransactionType* trx, Marker* envelope) -> int { 
-          if (IsVolatile(trx->trxCollection())) {
-            return TRI_ERROR_NO_ERROR;
-          } 
+        // local operation. this is applied later, together with the other
+        // operations of the collection
+        res = state->queueOperation(databaseId, collectionId, marker, datafile->_fid);
 
-          // remove the document and ignore any potential errors
-          state->policy.setExpectedRevision(m->_revisionId);
-          TRI_RemoveShapedJsonDocumentCollection(trx->trxCollection(), (TRI_voc_key_t) key, m->_revisionId, envelope, &state->policy, false, false);
-
-          return TRI_ERROR_NO_ERROR;
-        });
+        if (res != TRI_ERROR_NO_ERROR) {
+          // applying the pending operations failed
+          return false;
+        }
       }
       else {
         // ERROR - found a local action for a collection that has an ongoing remote transaction
@@ -1555,8 +1899,11 @@ int RecoverState::replayLogfile (Logfile* logfile,
                                  int number) {
   int const n = static_cast<int>(logfilesToProcess.size());
 
-  LOG_INFO("replaying WAL logfile '%s' (%d of %d)", 
-           logfile->filename().c_str(), number + 1, n);
+  LOG_INFO("replaying WAL logfile '%s' (%d of %d), %llu operations applied so far", 
+           logfile->filename().c_str(), 
+           number + 1, 
+           n,
+           (unsigned long long) appliedOperations);
 
   if (! TRI_IterateDatafile(logfile->df(), &RecoverState::ReplayMarker, static_cast<void*>(this))) {
     LOG_WARNING("WAL inspection failed when scanning logfile '%s'", logfile->filename().c_str());
@@ -1574,6 +1921,8 @@ int RecoverState::replayLogfiles () {
   droppedCollections.clear();
   droppedDatabases.clear();
 
+  double const start = TRI_microtime();
+
   int i = 0;
   for (auto& it : logfilesToProcess) {
     TRI_ASSERT(it != nullptr);
@@ -1584,6 +1933,22 @@ int RecoverState::replayLogfiles () {
     }
   }
 
+  // apply the operations still pending at the end of the last logfile
+  int res = applyPendingOperations();
+
+  if (res != TRI_ERROR_NO_ERROR) {
+    return res;
+  }
+
+  double const duration = TRI_microtime() - start;
+
+  LOG_INFO("replayed %llu WAL operations in %.2f s (%.2f s applying operations, %.0f operations/s), using %d thread(s)",
+           (unsigned long long) appliedOperations,
+           duration,
+           applyTime,
+           (duration > 0.0 ? (double) appliedOperations / duration : 0.0),
+           (int) recoveryThreads);
+
   return TRI_ERROR_NO_ERROR;
 }
 
@@ -31,6 +31,7 @@
 #define ARANGODB_WAL_RECOVER_STATE_H 1
 
 #include "Basics/Common.h"
+#include "Basics/ThreadPool.h"
 #include "Utils/transactions.h"
 #include "VocBase/datafile.h"
 #include "VocBase/document-collection.h"
@@ -59,6 +60,30 @@ struct TRI_server_s;
 namespace triagens {
   namespace wal {
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  RecoverOperation
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a document operation found during recovery. document operations are
+/// collected per collection and are applied later, with the operations of
+/// different collections being applied in parallel
+////////////////////////////////////////////////////////////////////////////////
+
+    struct RecoverOperation {
+      TRI_df_marker_t const* marker;
+      TRI_voc_fid_t          fid;
+    };
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief the pending document operations of a collection
+////////////////////////////////////////////////////////////////////////////////
+
+    struct RecoverCollectionOperations {
+      TRI_voc_tick_t                databaseId;
+      std::vector<RecoverOperation> operations;
+    };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                      RecoverState
 // -----------------------------------------------------------------------------
@@ -81,7 +106,8 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
       RecoverState (TRI_server_t*,
-                    bool);
+                    bool,
+                    uint32_t);
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief destroys the recover state
@@ -250,6 +276,41 @@ namespace triagens {
                                   TRI_voc_fid_t,
                                   std::function<int(SingleWriteTransactionType*, Marker*)>);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief queues a document operation for later application. applies all
+/// pending operations if there are too many of them
+////////////////////////////////////////////////////////////////////////////////
+
+      int queueOperation (TRI_voc_tick_t,
+                          TRI_voc_cid_t,
+                          TRI_df_marker_t const*,
+                          TRI_voc_fid_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the pending document operations must be applied
+/// before the marker can be replayed
+////////////////////////////////////////////////////////////////////////////////
+
+      bool mustApplyPendingOperations (TRI_df_marker_t const*) const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief applies all pending document operations. the operations of each
+/// collection are applied in order, but different collections are handled
+/// by multiple threads
+////////////////////////////////////////////////////////////////////////////////
+
+      int applyPendingOperations ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief applies the pending document operations of a single collection,
+/// using a single transaction for all of them
+////////////////////////////////////////////////////////////////////////////////
+
+      int applyCollectionOperations (TRI_vocbase_col_t*,
+                                     std::vector<RecoverOperation> const&,
+                                     std::atomic<int64_t>&,
+                                     std::atomic<uint64_t>&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief callback to handle one marker during recovery
 /// this function modifies indexes etc.
@@ -318,9 +379,16 @@ namespace triagens {
       std::unordered_map<TRI_voc_tid_t, RemoteTransactionType*>                   runningRemoteTransactions;
       std::vector<std::string>                                                    emptyLogfiles;
 
+      std::unordered_map<TRI_voc_cid_t, RecoverCollectionOperations>              pendingOperations;
+      size_t                                                                      numPendingOperations;
+
       TRI_doc_update_policy_t                                                     policy;
       bool                                                                        ignoreRecoveryErrors;
       int64_t                                                                     errorCount;
+      uint32_t                                                                    recoveryThreads;
+      triagens::basics::ThreadPool*                                               threadPool;
+      uint64_t                                                                    appliedOperations;
+      double                                                                      applyTime;
     };
 
   }
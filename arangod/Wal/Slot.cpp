@@ -45,6 +45,7 @@ Slot::Slot ()
     _logfileId(0),
     _mem(nullptr),
     _size(0),
+    _version(0),
     _status(StatusType::UNUSED) {
 }
 
@@ -57,7 +58,7 @@ Slot::Slot ()
 ////////////////////////////////////////////////////////////////////////////////
 
 std::string Slot::statusText () const {
-  switch (_status) {
+  switch (_status.load()) {
     case StatusType::UNUSED:
       return "unused";
     case StatusType::USED:
@@ -96,10 +97,7 @@ void Slot::fill (void* src,
   marker->_size = static_cast<TRI_voc_size_t>(size);
 
   // calculate the crc
-  marker->_crc = 0;
-  TRI_voc_crc_t crc = TRI_InitialCrc32();
-  crc = TRI_BlockCrc32(crc, (char const*) marker, static_cast<TRI_voc_size_t>(size));
-  marker->_crc = TRI_FinalCrc32(crc);
+  marker->_crc = TRI_CrcMarkerDatafile(static_cast<TRI_df_version_t>(_version), marker);
 
   TRI_IF_FAILURE("WalSlotCrc") {
     // intentionally corrupt the marker
@@ -125,7 +123,8 @@ void Slot::setUnused () {
   _logfileId   = 0;
   _mem         = nullptr;
   _size        = 0;
-  _status      = StatusType::UNUSED;
+  _version     = 0;
+  _status.store(StatusType::UNUSED, std::memory_order_release);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -135,13 +134,16 @@ void Slot::setUnused () {
 void Slot::setUsed (void* mem,
                     uint32_t size,
                     Logfile::IdType logfileId,
+                    TRI_df_version_t version,
                     Slot::TickType tick) {
   TRI_ASSERT(isUnused());
+  TRI_ASSERT(TRI_IsKnownVersionDatafile(version));
   _tick = tick;
   _logfileId = logfileId;
   _mem = mem;
   _size = size;
-  _status = StatusType::USED;
+  _version = static_cast<uint16_t>(version);
+  _status.store(StatusType::USED, std::memory_order_release);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -151,10 +153,10 @@ void Slot::setUsed (void* mem,
 void Slot::setReturned (bool waitForSync) {
   TRI_ASSERT(isUsed());
   if (waitForSync) {
-    _status = StatusType::RETURNED_WFS;
+    _status.store(StatusType::RETURNED_WFS, std::memory_order_release);
   }
   else {
-    _status = StatusType::RETURNED;
+    _status.store(StatusType::RETURNED, std::memory_order_release);
   }
 }
 
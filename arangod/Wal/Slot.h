@@ -65,7 +65,7 @@ namespace triagens {
 /// @brief slot status typedef
 ////////////////////////////////////////////////////////////////////////////////
 
-        enum class StatusType : uint32_t {
+        enum class StatusType : uint16_t {
           UNUSED        = 0,
           USED          = 1,
           RETURNED      = 2,
@@ -147,7 +147,7 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         inline bool isUnused () const {
-          return _status == StatusType::UNUSED;
+          return _status.load(std::memory_order_acquire) == StatusType::UNUSED;
         }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -155,7 +155,7 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         inline bool isUsed () const {
-          return _status == StatusType::USED;
+          return _status.load(std::memory_order_acquire) == StatusType::USED;
         }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -163,8 +163,9 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         inline bool isReturned () const {
-          return (_status == StatusType::RETURNED ||
-                  _status == StatusType::RETURNED_WFS);
+          StatusType const status = _status.load(std::memory_order_acquire);
+          return (status == StatusType::RETURNED ||
+                  status == StatusType::RETURNED_WFS);
         }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -172,7 +173,7 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         inline bool waitForSync () const {
-          return (_status == StatusType::RETURNED_WFS);
+          return (_status.load(std::memory_order_acquire) == StatusType::RETURNED_WFS);
         }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -188,6 +189,7 @@ namespace triagens {
         void setUsed (void*,
                       uint32_t,
                       Logfile::IdType,
+                      TRI_df_version_t,
                       Slot::TickType);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -230,11 +232,20 @@ namespace triagens {
 
         uint32_t _size;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief version of the logfile the slot memory belongs to. this determines
+/// the checksum type used for the marker
+////////////////////////////////////////////////////////////////////////////////
+
+        uint16_t _version;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief slot status
+/// the status is written with release semantics after all other members
+/// have been set, so a thread that observes a status can safely read them
 ////////////////////////////////////////////////////////////////////////////////
 
-        StatusType _status;
+        std::atomic<StatusType> _status;
 
     };
 
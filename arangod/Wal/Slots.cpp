@@ -36,6 +36,7 @@
 #include "VocBase/server.h"
 #include "Wal/LogfileManager.h"
 
+
 using namespace triagens::wal;
 
 // -----------------------------------------------------------------------------
@@ -52,6 +53,7 @@ Slots::Slots (LogfileManager* logfileManager,
   : _logfileManager(logfileManager),
     _condition(),
     _lock(),
+    _handoutLock(),
     _slots(new Slot[numberOfSlots]),
     _numberOfSlots(numberOfSlots),
     _freeSlots(numberOfSlots),
@@ -86,10 +88,9 @@ Slots::~Slots () {
 void Slots::statistics (Slot::TickType& lastTick,
                         Slot::TickType& lastDataTick,
                         uint64_t& numEvents) {
-  MUTEX_LOCKER(_lock);
-  lastTick     = _lastCommittedTick;
-  lastDataTick = _lastCommittedDataTick;
-  numEvents    = _numEvents;
+  lastTick     = _lastCommittedTick.load(std::memory_order_acquire);
+  lastDataTick = _lastCommittedDataTick.load(std::memory_order_acquire);
+  numEvents    = _numEvents.load(std::memory_order_relaxed);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -127,8 +128,7 @@ int Slots::flush (bool waitForSync) {
 ////////////////////////////////////////////////////////////////////////////////
 
 Slot::TickType Slots::lastCommittedTick () {
-  MUTEX_LOCKER(_lock);
-  return _lastCommittedTick;
+  return _lastCommittedTick.load(std::memory_order_acquire);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -144,8 +144,10 @@ SlotInfo Slots::nextUnused (uint32_t size) {
   TRI_ASSERT(size > 0);
 
   while (++iterations < 1000) {
+    bool noLogfile = false;
+
     {
-      MUTEX_LOCKER(_lock);
+      MUTEX_LOCKER(_handoutLock);
 
       Slot* slot = &_slots[_handoutIndex];
       TRI_ASSERT(slot != nullptr);
@@ -181,13 +183,13 @@ SlotInfo Slots::nextUnused (uint32_t size) {
           Logfile::StatusType status = newLogfile(alignedSize);
 
           if (_logfile == nullptr) {
-            usleep(10 * 1000);
-
             TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
               return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
             }
 
-            // try again in next iteration
+            // try again after sleeping outside the handout lock
+            noLogfile = true;
+            break;
           }
           else if (status == Logfile::StatusType::EMPTY) {
             // inititialise the empty logfile by writing a header marker
@@ -206,21 +208,29 @@ SlotInfo Slots::nextUnused (uint32_t size) {
           }
         }
 
-        // if we get here, we got a free slot for the actual data...
+        if (! noLogfile) {
+          // if we get here, we got a free slot for the actual data...
 
-        char* mem = _logfile->reserve(alignedSize);
+          char* mem = _logfile->reserve(alignedSize);
 
-        if (mem == nullptr) {
-          return SlotInfo(TRI_ERROR_INTERNAL);
-        }
+          if (mem == nullptr) {
+            return SlotInfo(TRI_ERROR_INTERNAL);
+          }
 
-        // only in this case we return a valid slot
-        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout());
+          // only in this case we return a valid slot
+          slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), _logfile->df()->_version, handout());
 
-        return SlotInfo(slot);
+          return SlotInfo(slot);
+        }
       }
     }
 
+    if (noLogfile) {
+      // no writeable logfile available yet
+      usleep(10 * 1000);
+      continue;
+    }
+
     // if we get here, all slots are busy
     CONDITION_LOCKER(guard, _condition);
     if (! hasWaited) {
@@ -228,13 +238,7 @@ SlotInfo Slots::nextUnused (uint32_t size) {
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(_lock);
-      mustWait = (_freeSlots == 0);
-    }
-
-    if (mustWait) {
+    if (_freeSlots.load() == 0) {
       guard.wait(10 * 1000);
     }
   }
@@ -263,8 +267,10 @@ SlotInfo Slots::nextUnused (uint32_t size,
   TRI_ASSERT(size > 0);
 
   while (++iterations < 1000) {
+    bool noLogfile = false;
+
     {
-      MUTEX_LOCKER(_lock);
+      MUTEX_LOCKER(_handoutLock);
 
       Slot* slot = &_slots[_handoutIndex];
       TRI_ASSERT(slot != nullptr);
@@ -300,13 +306,13 @@ SlotInfo Slots::nextUnused (uint32_t size,
           Logfile::StatusType status = newLogfile(alignedSize);
 
           if (_logfile == nullptr) {
-            usleep(10 * 1000);
-
             TRI_IF_FAILURE("LogfileManagerGetWriteableLogfile") {
               return SlotInfo(TRI_ERROR_ARANGO_NO_JOURNAL);
             }
 
-            // try again in next iteration
+            // try again after sleeping outside the handout lock
+            noLogfile = true;
+            break;
           }
           else if (status == Logfile::StatusType::EMPTY) {
             // inititialise the empty logfile by writing a header marker
@@ -325,36 +331,44 @@ SlotInfo Slots::nextUnused (uint32_t size,
           }
         }
 
-        // if we get here, we got a free slot for the actual data...
+        if (! noLogfile) {
+          // if we get here, we got a free slot for the actual data...
         
-        // Now sort out the legend business:
-        if (legendOffset == 0) {
-          void* legend = _logfile->lookupLegend(cid, sid);
-          if (nullptr == legend) {
-            // Bad, we would need a legend for this marker
-            return SlotInfo(TRI_ERROR_LEGEND_NOT_IN_WAL_FILE);
+          // Now sort out the legend business:
+          if (legendOffset == 0) {
+            void* legend = _logfile->lookupLegend(cid, sid);
+            if (nullptr == legend) {
+              // Bad, we would need a legend for this marker
+              return SlotInfo(TRI_ERROR_LEGEND_NOT_IN_WAL_FILE);
+            }
+            oldLegend = legend;
           }
-          oldLegend = legend;
-        }
 
-        char* mem = _logfile->reserve(alignedSize);
+          char* mem = _logfile->reserve(alignedSize);
 
-        if (mem == nullptr) {
-          return SlotInfo(TRI_ERROR_INTERNAL);
-        }
+          if (mem == nullptr) {
+            return SlotInfo(TRI_ERROR_INTERNAL);
+          }
 
-        if (legendOffset != 0) {
-          void* legend = static_cast<void*>(mem + legendOffset);
-          _logfile->cacheLegend(cid, sid, legend);
-        }
+          if (legendOffset != 0) {
+            void* legend = static_cast<void*>(mem + legendOffset);
+            _logfile->cacheLegend(cid, sid, legend);
+          }
 
-        // only in this case we return a valid slot
-        slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), handout());
+          // only in this case we return a valid slot
+          slot->setUsed(static_cast<void*>(mem), size, _logfile->id(), _logfile->df()->_version, handout());
 
-        return SlotInfo(slot);
+          return SlotInfo(slot);
+        }
       }
     }
 
+    if (noLogfile) {
+      // no writeable logfile available yet
+      usleep(10 * 1000);
+      continue;
+    }
+
     // if we get here, all slots are busy
     CONDITION_LOCKER(guard, _condition);
     if (! hasWaited) {
@@ -362,13 +376,7 @@ SlotInfo Slots::nextUnused (uint32_t size,
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(_lock);
-      mustWait = (_freeSlots == 0);
-    }
-
-    if (mustWait) {
+    if (_freeSlots.load() == 0) {
       guard.wait(10 * 1000);
     }
   }
@@ -387,11 +395,9 @@ void Slots::returnUsed (SlotInfo& slotInfo,
 
   TRI_ASSERT(tick > 0);
 
-  {
-    MUTEX_LOCKER(_lock);
-    slotInfo.slot->setReturned(waitForSync);
-    ++_numEvents;
-  }
+  // the slot status is atomic, so returning a slot does not need a lock
+  slotInfo.slot->setReturned(waitForSync);
+  _numEvents.fetch_add(1, std::memory_order_relaxed);
 
   _logfileManager->signalSync();
 
@@ -418,8 +424,9 @@ SyncRegion Slots::getSyncRegion () {
     if (! slot->isReturned()) {
       // found a slot that is not yet returned
       // if it belongs to another logfile, we can seal the logfile we created
-      // the region for
-      auto otherId = slot->logfileId();
+      // the region for. unused slots may be handed out concurrently, so
+      // only the logfile id of a used slot can be inspected
+      auto otherId = (slot->isUsed() ? slot->logfileId() : 0);
       if (region.logfileId != 0 && otherId != 0 && 
           otherId != region.logfileId) {
         region.canSeal = true;
@@ -439,6 +446,7 @@ SyncRegion Slots::getSyncRegion () {
       region.logfileStatus  = status;
       region.firstSlotIndex = slotIndex;
       region.lastSlotIndex  = slotIndex;
+      region.numSlots       = 1;
       region.waitForSync    = slot->waitForSync();
     }
     else {
@@ -454,6 +462,7 @@ SyncRegion Slots::getSyncRegion () {
       // update the region
       region.size += (uint32_t) (static_cast<char*>(slot->mem()) - (region.mem + region.size) + slot->size());
       region.lastSlotIndex = slotIndex;
+      ++region.numSlots;
       region.waitForSync |= slot->waitForSync();
     }
 
@@ -488,8 +497,8 @@ void Slots::returnSyncRegion (SyncRegion const& region) {
 
       // note last tick
       Slot::TickType tick = slot->tick();
-      TRI_ASSERT(tick >= _lastCommittedTick);
-      _lastCommittedTick = tick;
+      TRI_ASSERT(tick >= _lastCommittedTick.load());
+      _lastCommittedTick.store(tick, std::memory_order_release);
 
       // update the data tick
       TRI_df_marker_t const* m = static_cast<TRI_df_marker_t const*>(slot->mem());
@@ -497,7 +506,7 @@ void Slots::returnSyncRegion (SyncRegion const& region) {
           m->_type != TRI_DF_MARKER_FOOTER && 
           m->_type != TRI_WAL_MARKER_ATTRIBUTE &&
           m->_type != TRI_WAL_MARKER_SHAPE) {
-        _lastCommittedDataTick = tick;
+        _lastCommittedDataTick.store(tick, std::memory_order_release);
       }
 
       region.logfile->update(m);
@@ -536,7 +545,8 @@ void Slots::returnSyncRegion (SyncRegion const& region) {
 void Slots::getActiveLogfileRegion (Logfile* logfile,
                                     char const*& begin,
                                     char const*& end) {
-  MUTEX_LOCKER(_lock);
+  // the current size of the logfile is modified when handing out slots
+  MUTEX_LOCKER(_handoutLock);
 
   TRI_datafile_t* datafile = logfile->df();
 
@@ -576,10 +586,12 @@ int Slots::closeLogfile (Slot::TickType& lastCommittedTick,
   worked = false;
 
   while (++iterations < 1000) {
+    bool noLogfile = false;
+
     {
-      MUTEX_LOCKER(_lock);
+      MUTEX_LOCKER(_handoutLock);
 
-      lastCommittedTick = _lastCommittedTick;
+      lastCommittedTick = _lastCommittedTick.load(std::memory_order_acquire);
 
       Slot* slot = &_slots[_handoutIndex];
       TRI_ASSERT(slot != nullptr);
@@ -629,8 +641,8 @@ int Slots::closeLogfile (Slot::TickType& lastCommittedTick,
             return TRI_ERROR_ARANGO_NO_JOURNAL;
           }
 
-          usleep(10 * 1000);
-          // try again in next iteration
+          // try again after sleeping outside the handout lock
+          noLogfile = true;
         }
         else if (status == Logfile::StatusType::EMPTY) {
           // inititialise the empty logfile by writing a header marker
@@ -653,6 +665,12 @@ int Slots::closeLogfile (Slot::TickType& lastCommittedTick,
       }
     }
 
+    if (noLogfile) {
+      // no writeable logfile available yet
+      usleep(10 * 1000);
+      continue;
+    }
+
     // if we get here, all slots are busy
     CONDITION_LOCKER(guard, _condition);
     if (! hasWaited) {
@@ -660,13 +678,7 @@ int Slots::closeLogfile (Slot::TickType& lastCommittedTick,
       hasWaited = true;
     }
 
-    bool mustWait;
-    {
-      MUTEX_LOCKER(_lock);
-      mustWait = (_freeSlots == 0);
-    }
-
-    if (mustWait) {
+    if (_freeSlots.load() == 0) {
       guard.wait(10 * 1000);
     }
   }
@@ -685,7 +697,7 @@ int Slots::writeHeader (Slot* slot) {
   TRI_df_marker_t* mem = reinterpret_cast<TRI_df_marker_t*>(_logfile->reserve(size));
   TRI_ASSERT(mem != nullptr);
 
-  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout());
+  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), _logfile->df()->_version, handout());
   slot->fill(&header.base, size);
   slot->setReturned(false); // sync
 
@@ -705,7 +717,7 @@ int Slots::writeFooter (Slot* slot) {
   TRI_df_marker_t* mem = reinterpret_cast<TRI_df_marker_t*>(_logfile->reserve(size));
   TRI_ASSERT(mem != nullptr);
 
-  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), handout());
+  slot->setUsed(static_cast<void*>(mem), static_cast<uint32_t>(size), _logfile->id(), _logfile->df()->_version, handout());
   slot->fill(&footer.base, size);
   slot->setReturned(true); // sync
 
@@ -740,8 +752,15 @@ bool Slots::waitForTick (Slot::TickType tick) {
 
   // wait until data has been committed to disk
   while (++iterations < MaxIterations) {
+    // the commit tick can be checked without any locks
+    if (lastCommittedTick() >= tick) {
+      return true;
+    }
+
     CONDITION_LOCKER(guard, _condition);
 
+    // check again, as the tick may have been committed in between and we
+    // might have missed the signal
     if (lastCommittedTick() >= tick) {
       return true;
     }
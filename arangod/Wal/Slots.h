@@ -270,11 +270,20 @@ namespace triagens {
         basics::ConditionVariable _condition;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief mutex protecting the slots interface
+/// @brief mutex protecting the synchronisation side of the slots
+/// (the recycle index and the tick ranges of the logfiles)
 ////////////////////////////////////////////////////////////////////////////////
 
         basics::Mutex _lock;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief mutex protecting the handout side of the slots
+/// (the handout index, the current logfile and the reservation of space in
+/// it). it is not held while sleeping
+////////////////////////////////////////////////////////////////////////////////
+
+        basics::Mutex _handoutLock;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief all slots
 ////////////////////////////////////////////////////////////////////////////////
@@ -291,7 +300,7 @@ namespace triagens {
 /// @brief the number of currently free slots
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _freeSlots;
+        std::atomic<size_t> _freeSlots;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief whether or not someone is waiting for a slot
@@ -327,19 +336,19 @@ namespace triagens {
 /// @brief last committed tick value
 ////////////////////////////////////////////////////////////////////////////////
 
-        Slot::TickType _lastCommittedTick;
+        std::atomic<Slot::TickType> _lastCommittedTick;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief last committed data tick value
 ////////////////////////////////////////////////////////////////////////////////
 
-        Slot::TickType _lastCommittedDataTick;
+        std::atomic<Slot::TickType> _lastCommittedDataTick;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief number of log events handled
 ////////////////////////////////////////////////////////////////////////////////
 
-        uint64_t _numEvents;
+        std::atomic<uint64_t> _numEvents;
 
     };
 
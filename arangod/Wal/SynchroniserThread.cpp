@@ -32,6 +32,7 @@
 #include "Basics/logging.h"
 #include "Basics/ConditionLocker.h"
 #include "Basics/Exceptions.h"
+#include "Basics/MutexLocker.h"
 #include "VocBase/server.h"
 #include "Wal/LogfileManager.h"
 #include "Wal/Slots.h"
@@ -59,6 +60,8 @@ SynchroniserThread::SynchroniserThread (LogfileManager* logfileManager,
     _waiting(0),
     _stop(0),
     _syncInterval(syncInterval),
+    _statisticsLock(),
+    _statistics(),
     _logfileCache() {
 
   allowAsynchronousCancelation();
@@ -102,6 +105,15 @@ void SynchroniserThread::signalSync () {
   _condition.signal();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the sync statistics
+////////////////////////////////////////////////////////////////////////////////
+
+SynchroniserStatistics SynchroniserThread::statistics () {
+  MUTEX_LOCKER(_statisticsLock);
+  return _statistics;
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    Thread methods
 // -----------------------------------------------------------------------------
@@ -124,6 +136,11 @@ void SynchroniserThread::run () {
 
     // go on without the lock
 
+    if (waiting > 0 && stop == 0) {
+      // group commit: let concurrent writers join the next sync
+      waiting = waitForGroupCommit(waiting);
+    }
+
     if (waiting > 0 || ++iterations == 10) {
       iterations = 0;
 
@@ -199,7 +216,9 @@ int SynchroniserThread::doSync (bool& checkMore) {
   int fd = getLogfileDescriptor(region.logfileId);
   TRI_ASSERT(fd >= 0);
   void** mmHandle = nullptr;
+  double const start = TRI_microtime();
   bool result = TRI_MSync(fd, mmHandle, region.mem, region.mem + region.size);
+  double const duration = TRI_microtime() - start;
 
   LOG_TRACE("syncing logfile %llu, region %p - %p, length: %lu, wfs: %s",
             (unsigned long long) id,
@@ -214,6 +233,20 @@ int SynchroniserThread::doSync (bool& checkMore) {
     return TRI_ERROR_ARANGO_MSYNC_FAILED;
   }
 
+  {
+    MUTEX_LOCKER(_statisticsLock);
+    ++_statistics.numSyncs;
+    _statistics.numMarkers += region.numSlots;
+    _statistics.totalTime += duration;
+
+    if (region.numSlots > _statistics.maxMarkers) {
+      _statistics.maxMarkers = region.numSlots;
+    }
+    if (duration > _statistics.maxTime) {
+      _statistics.maxTime = duration;
+    }
+  }
+
   // all ok
 
   if (status == Logfile::StatusType::SEAL_REQUESTED) {
@@ -251,6 +284,39 @@ int SynchroniserThread::doSync (bool& checkMore) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until enough operations are pending for a group commit, or
+/// until the commit window has passed. returns the number of pending
+/// operations
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t SynchroniserThread::waitForGroupCommit (uint32_t waiting) {
+  uint64_t const window = _logfileManager->syncCommitWindow();
+  uint32_t const size = _logfileManager->syncCommitSize();
+
+  if (window == 0 || waiting >= size) {
+    // group commit turned off, or already enough operations pending
+    return waiting;
+  }
+
+  double const end = TRI_microtime() + static_cast<double>(window) / 1000000.0;
+
+  CONDITION_LOCKER(guard, _condition);
+
+  // each finished operation will signal the condition variable
+  while (_waiting < size && _stop == 0) {
+    double const remaining = end - TRI_microtime();
+
+    if (remaining <= 0.0) {
+      break;
+    }
+
+    guard.wait(static_cast<uint64_t>(remaining * 1000000.0));
+  }
+
+  return _waiting;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a logfile descriptor (it caches the descriptor for performance)
 ////////////////////////////////////////////////////////////////////////////////
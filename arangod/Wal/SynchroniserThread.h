@@ -32,6 +32,7 @@
 
 #include "Basics/Common.h"
 #include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "Basics/Thread.h"
 #include "Wal/Logfile.h"
 #include "Wal/SyncRegion.h"
@@ -41,6 +42,30 @@ namespace triagens {
 
     class LogfileManager;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                            SynchroniserStatistics
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief statistics about the syncs executed by the synchroniser thread
+////////////////////////////////////////////////////////////////////////////////
+
+    struct SynchroniserStatistics {
+      SynchroniserStatistics ()
+        : numSyncs(0),
+          numMarkers(0),
+          maxMarkers(0),
+          totalTime(0.0),
+          maxTime(0.0) {
+      }
+
+      uint64_t  numSyncs;
+      uint64_t  numMarkers;
+      uint64_t  maxMarkers;
+      double    totalTime;
+      double    maxTime;
+    };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                          class SynchroniserThread
 // -----------------------------------------------------------------------------
@@ -92,6 +117,12 @@ namespace triagens {
 
         void signalSync ();
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the sync statistics
+////////////////////////////////////////////////////////////////////////////////
+
+        SynchroniserStatistics statistics ();
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                    Thread methods
 // -----------------------------------------------------------------------------
@@ -116,6 +147,14 @@ namespace triagens {
 
         int doSync (bool&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wait until enough operations are pending for a group commit, or
+/// until the commit window has passed. returns the number of pending
+/// operations
+////////////////////////////////////////////////////////////////////////////////
+
+        uint32_t waitForGroupCommit (uint32_t);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a logfile descriptor (it caches the descriptor for performance)
 ////////////////////////////////////////////////////////////////////////////////
@@ -158,6 +197,18 @@ namespace triagens {
 
         uint64_t const _syncInterval;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief mutex protecting the statistics
+////////////////////////////////////////////////////////////////////////////////
+
+        basics::Mutex _statisticsLock;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief sync statistics
+////////////////////////////////////////////////////////////////////////////////
+
+        SynchroniserStatistics _statistics;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief logfile descriptor cache
 ////////////////////////////////////////////////////////////////////////////////
@@ -41,6 +41,8 @@ static bool CreateDocument (SimpleHttpClient*, const std::string&, const std::st
 
 static bool CreateIndex (SimpleHttpClient*, const std::string&, const std::string&, const std::string&);
 
+static bool ExecuteQuery (SimpleHttpClient*, const std::string&);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                              benchmark test cases
 // -----------------------------------------------------------------------------
@@ -1503,6 +1505,503 @@ struct AqlInsertTest : public BenchmarkOperation {
   }
 };
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                AQL functions test
+// -----------------------------------------------------------------------------
+
+struct AqlFunctionsTest : public BenchmarkOperation {
+  AqlFunctionsTest (bool useV8)
+    : BenchmarkOperation (),
+      _useV8(useV8) {
+  }
+
+  ~AqlFunctionsTest () {
+  }
+
+  bool setUp (SimpleHttpClient* client) {
+    return true;
+  }
+
+  void tearDown () {
+  }
+
+  std::string url (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return std::string("/_api/cursor");
+  }
+
+  HttpRequest::HttpRequestType type (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return HttpRequest::HTTP_REQUEST_POST;
+  }
+
+  const char* payload (size_t* length, const int threadNumber, const size_t threadCounter, const size_t globalCounter, bool* mustFree) {
+    TRI_string_buffer_t* buffer;
+    buffer = TRI_CreateSizedStringBuffer(TRI_UNKNOWN_MEM_ZONE, 512);
+
+    TRI_AppendStringStringBuffer(buffer, "{\"query\":\"FOR i IN 1..");
+    TRI_AppendUInt64StringBuffer(buffer, Complexity);
+    TRI_AppendStringStringBuffer(buffer, " LET d = { value: i, name: CONCAT(\\\"Test\\\", i) } ");
+    TRI_AppendStringStringBuffer(buffer, "RETURN { lower: LOWER(d.name), length: LENGTH(d.name), ");
+    TRI_AppendStringStringBuffer(buffer, "floor: FLOOR(SQRT(d.value)), year: DATE_YEAR(d.value), ");
+    TRI_AppendStringStringBuffer(buffer, "merged: MERGE(d, { hash: MD5(d.name) }) }\",\"batchSize\":1000");
+
+    if (_useV8) {
+      // evaluate the same expressions with V8
+      TRI_AppendStringStringBuffer(buffer, ",\"options\":{\"nativeExpressions\":false}");
+    }
+
+    TRI_AppendStringStringBuffer(buffer, "}");
+
+    *length = TRI_LengthStringBuffer(buffer);
+    *mustFree = true;
+    char* ptr = TRI_StealStringBuffer(buffer);
+    TRI_FreeStringBuffer(TRI_UNKNOWN_MEM_ZONE, buffer);
+
+    return (const char*) ptr;
+  }
+
+  bool _useV8;
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                              AQL calculation test
+// -----------------------------------------------------------------------------
+
+struct AqlCalculationTest : public BenchmarkOperation {
+  AqlCalculationTest (bool useV8)
+    : BenchmarkOperation (),
+      _useV8(useV8) {
+  }
+
+  ~AqlCalculationTest () {
+  }
+
+  bool setUp (SimpleHttpClient* client) {
+    return true;
+  }
+
+  void tearDown () {
+  }
+
+  std::string url (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return std::string("/_api/cursor");
+  }
+
+  HttpRequest::HttpRequestType type (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return HttpRequest::HTTP_REQUEST_POST;
+  }
+
+  const char* payload (size_t* length, const int threadNumber, const size_t threadCounter, const size_t globalCounter, bool* mustFree) {
+    TRI_string_buffer_t* buffer;
+    buffer = TRI_CreateSizedStringBuffer(TRI_UNKNOWN_MEM_ZONE, 512);
+
+    TRI_AppendStringStringBuffer(buffer, "{\"query\":\"FOR i IN 1..");
+    TRI_AppendUInt64StringBuffer(buffer, Complexity);
+    TRI_AppendStringStringBuffer(buffer, " LET d = { value: i, values: [ i, i + 1, i + 2 ] } ");
+    TRI_AppendStringStringBuffer(buffer, "RETURN { gross: d.value * 1.19, net: d.value / 1.19 - 1, ");
+    TRI_AppendStringStringBuffer(buffer, "mod: d.value % 7, sign: d.value % 2 == 0 ? d.value : -d.value, ");
+    TRI_AppendStringStringBuffer(buffer, "expanded: [ d, d ][*].values }\",\"batchSize\":1000");
+
+    if (_useV8) {
+      // evaluate the same expressions with V8
+      TRI_AppendStringStringBuffer(buffer, ",\"options\":{\"nativeExpressions\":false}");
+    }
+
+    TRI_AppendStringStringBuffer(buffer, "}");
+
+    *length = TRI_LengthStringBuffer(buffer);
+    *mustFree = true;
+    char* ptr = TRI_StealStringBuffer(buffer);
+    TRI_FreeStringBuffer(TRI_UNKNOWN_MEM_ZONE, buffer);
+
+    return (const char*) ptr;
+  }
+
+  bool _useV8;
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                AQL documents test
+// -----------------------------------------------------------------------------
+
+struct AqlDocumentsTest : public BenchmarkOperation {
+  AqlDocumentsTest (bool stream)
+    : BenchmarkOperation (),
+      _stream(stream) {
+  }
+
+  ~AqlDocumentsTest () {
+  }
+
+  bool setUp (SimpleHttpClient* client) {
+    // create <complexity> documents that are returned by each query
+    std::string const query = 
+      "FOR i IN 1.." + StringUtils::itoa(Complexity) + 
+      " INSERT { value: i, name: CONCAT('test', i), values: [ i, i + 1, i + 2 ], " 
+      "nested: { active: i % 2 == 0, description: 'some text to be returned' } } IN " + Collection;
+
+    return DeleteCollection(client, Collection) &&
+           CreateCollection(client, Collection, 2) &&
+           ExecuteQuery(client, query);
+  }
+
+  void tearDown () {
+  }
+
+  std::string url (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return std::string("/_api/cursor");
+  }
+
+  HttpRequest::HttpRequestType type (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return HttpRequest::HTTP_REQUEST_POST;
+  }
+
+  const char* payload (size_t* length, const int threadNumber, const size_t threadCounter, const size_t globalCounter, bool* mustFree) {
+    TRI_string_buffer_t* buffer;
+    buffer = TRI_CreateSizedStringBuffer(TRI_UNKNOWN_MEM_ZONE, 256);
+
+    // return all documents in a single batch
+    TRI_AppendStringStringBuffer(buffer, "{\"query\":\"FOR d IN ");
+    TRI_AppendStringStringBuffer(buffer, Collection.c_str());
+    TRI_AppendStringStringBuffer(buffer, " RETURN d\",\"batchSize\":");
+    TRI_AppendUInt64StringBuffer(buffer, Complexity);
+
+    if (_stream) {
+      TRI_AppendStringStringBuffer(buffer, ",\"options\":{\"stream\":true}");
+    }
+
+    TRI_AppendStringStringBuffer(buffer, "}");
+
+    *length = TRI_LengthStringBuffer(buffer);
+    *mustFree = true;
+    char* ptr = TRI_StealStringBuffer(buffer);
+    TRI_FreeStringBuffer(TRI_UNKNOWN_MEM_ZONE, buffer);
+
+    return (const char*) ptr;
+  }
+
+  bool _stream;
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   WAL append test
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief each thread appends small documents to its own collection, so the
+/// threads do not compete for collection locks but only for write-ahead log
+/// slots. run with increasing --concurrency to measure the scalability of
+/// WAL appends
+////////////////////////////////////////////////////////////////////////////////
+
+struct WalAppendTest : public BenchmarkOperation {
+  WalAppendTest ()
+    : BenchmarkOperation () {
+  }
+
+  ~WalAppendTest () {
+  }
+
+  bool setUp (SimpleHttpClient* client) {
+    for (int i = 0; i < Concurrency; ++i) {
+      std::string const name = Collection + StringUtils::itoa(i);
+
+      if (! DeleteCollection(client, name) ||
+          ! CreateCollection(client, name, 2)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void tearDown () {
+  }
+
+  std::string url (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return std::string("/_api/document?collection=" + Collection + StringUtils::itoa(threadNumber));
+  }
+
+  HttpRequest::HttpRequestType type (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return HttpRequest::HTTP_REQUEST_POST;
+  }
+
+  const char* payload (size_t* length, const int threadNumber, const size_t threadCounter, const size_t globalCounter, bool* mustFree) {
+    static const char* payload = "{\"value\":1}";
+
+    *mustFree = false;
+    *length = strlen(payload);
+    return payload;
+  }
+
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   key lookup test
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief each thread alternately inserts a small document with a known key
+/// and looks up one of its previously inserted documents by key, spread over
+/// the whole key range. this measures insert and lookup throughput of the
+/// primary index. the memory used per document can be calculated from the
+/// collection's figures (indexes.size / alive.count) afterwards
+////////////////////////////////////////////////////////////////////////////////
+
+struct KeyLookupTest : public BenchmarkOperation {
+  KeyLookupTest ()
+    : BenchmarkOperation () {
+  }
+
+  ~KeyLookupTest () {
+  }
+
+  bool setUp (SimpleHttpClient* client) {
+    return DeleteCollection(client, Collection) &&
+           CreateCollection(client, Collection, 2);
+  }
+
+  void tearDown () {
+  }
+
+  std::string url (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    if (threadCounter % 2 == 0) {
+      return std::string("/_api/document?collection=" + Collection);
+    }
+
+    // pick one of the documents this thread has inserted already
+    size_t const keyId = (threadCounter * 7919) % (threadCounter / 2 + 1);
+
+    return std::string("/_api/document/" + Collection + "/" + key(threadNumber, keyId));
+  }
+
+  HttpRequest::HttpRequestType type (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    if (threadCounter % 2 == 0) {
+      return HttpRequest::HTTP_REQUEST_POST;
+    }
+
+    return HttpRequest::HTTP_REQUEST_GET;
+  }
+
+  const char* payload (size_t* length, const int threadNumber, const size_t threadCounter, const size_t globalCounter, bool* mustFree) {
+    if (threadCounter % 2 == 0) {
+      std::string const data = "{\"_key\":\"" + key(threadNumber, threadCounter / 2) + "\"}";
+
+      *length = data.size();
+      *mustFree = true;
+      return TRI_DuplicateString2Z(TRI_UNKNOWN_MEM_ZONE, data.c_str(), data.size());
+    }
+
+    *length = 0;
+    *mustFree = false;
+    return (const char*) nullptr;
+  }
+
+  static std::string key (const int threadNumber, const size_t keyId) {
+    return "t" + StringUtils::itoa(threadNumber) + "k" + StringUtils::itoa(keyId);
+  }
+
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 shape lookup test
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief all threads read the same documents, which use many different
+/// attribute names and shapes. no new attributes or shapes are created during
+/// the run, so the server time is dominated by concurrent lookups in the
+/// collection's shaper. the number of documents is set with --complexity.
+/// run with increasing --concurrency to measure how shape and attribute
+/// lookups scale
+////////////////////////////////////////////////////////////////////////////////
+
+struct ShapeLookupTest : public BenchmarkOperation {
+  ShapeLookupTest ()
+    : BenchmarkOperation () {
+  }
+
+  ~ShapeLookupTest () {
+  }
+
+  bool setUp (SimpleHttpClient* client) {
+    if (! DeleteCollection(client, Collection) ||
+        ! CreateCollection(client, Collection, 2)) {
+      return false;
+    }
+
+    // create <complexity> documents, using 16 different sets of attribute
+    // names and alternating value types
+    for (uint64_t i = 0; i < Complexity; ++i) {
+      std::string data = "{\"value\":" + StringUtils::itoa(i);
+
+      for (uint64_t j = 0; j < 10; ++j) {
+        data += ",\"attr" + StringUtils::itoa(j) + "_" + StringUtils::itoa(i % 16) + "\":";
+
+        if ((i + j) % 2 == 0) {
+          data += StringUtils::itoa(j);
+        }
+        else {
+          data += "\"value" + StringUtils::itoa(j) + "\"";
+        }
+      }
+
+      data += "}";
+
+      if (! CreateDocument(client, Collection, data)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void tearDown () {
+  }
+
+  std::string url (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return std::string("/_api/cursor");
+  }
+
+  HttpRequest::HttpRequestType type (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return HttpRequest::HTTP_REQUEST_POST;
+  }
+
+  const char* payload (size_t* length, const int threadNumber, const size_t threadCounter, const size_t globalCounter, bool* mustFree) {
+    TRI_string_buffer_t* buffer;
+    buffer = TRI_CreateSizedStringBuffer(TRI_UNKNOWN_MEM_ZONE, 256);
+
+    // access a few attributes of every document and return the documents
+    TRI_AppendStringStringBuffer(buffer, "{\"query\":\"FOR d IN ");
+    TRI_AppendStringStringBuffer(buffer, Collection.c_str());
+    TRI_AppendStringStringBuffer(buffer, " FILTER d.value >= 0 && d.attr0_");
+    TRI_AppendUInt64StringBuffer(buffer, threadCounter % 16);
+    TRI_AppendStringStringBuffer(buffer, " != 'foo' RETURN d\",\"batchSize\":");
+    TRI_AppendUInt64StringBuffer(buffer, Complexity);
+    TRI_AppendStringStringBuffer(buffer, "}");
+
+    *length = TRI_LengthStringBuffer(buffer);
+    *mustFree = true;
+    char* ptr = TRI_StealStringBuffer(buffer);
+    TRI_FreeStringBuffer(TRI_UNKNOWN_MEM_ZONE, buffer);
+
+    return (const char*) ptr;
+  }
+
+};
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        graph test
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generates a graph with <complexity> vertices and eight outgoing
+/// edges per vertex (use --complexity 250000 for two million edges), then
+/// runs TRAVERSAL or SHORTEST_PATH queries from changing start vertices. only
+/// the length of the result is returned, so the server time is dominated by
+/// the graph function itself
+////////////////////////////////////////////////////////////////////////////////
+
+struct GraphTest : public BenchmarkOperation {
+  GraphTest (bool shortestPath)
+    : BenchmarkOperation (),
+      _shortestPath(shortestPath) {
+  }
+
+  ~GraphTest () {
+  }
+
+  bool setUp (SimpleHttpClient* client) {
+    std::string const edges = Collection + "Edges";
+
+    if (! DeleteCollection(client, Collection) ||
+        ! DeleteCollection(client, edges) ||
+        ! CreateCollection(client, Collection, 2) ||
+        ! CreateCollection(client, edges, 3)) {
+      return false;
+    }
+
+    // insert vertices and edges in chunks to keep the transactions small
+    uint64_t const chunkSize = 10000;
+
+    for (uint64_t from = 0; from < Complexity; from += chunkSize) {
+      std::string const range = StringUtils::itoa(from) + ".." + StringUtils::itoa((std::min)(from + chunkSize, Complexity) - 1);
+
+      std::string const vertexQuery =
+        "FOR i IN " + range +
+        " INSERT { _key: CONCAT('v', i), value: i } IN " + Collection;
+
+      std::string const edgeQuery =
+        "FOR i IN " + range +
+        " FOR j IN 1..8 INSERT { _from: CONCAT('" + Collection + "/v', i), " +
+        "_to: CONCAT('" + Collection + "/v', (i * 7 + j * 7919) % " + StringUtils::itoa(Complexity) + "), " +
+        "weight: j } IN " + edges;
+
+      if (! ExecuteQuery(client, vertexQuery) ||
+          ! ExecuteQuery(client, edgeQuery)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  void tearDown () {
+  }
+
+  std::string url (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return std::string("/_api/cursor");
+  }
+
+  HttpRequest::HttpRequestType type (const int threadNumber, const size_t threadCounter, const size_t globalCounter) {
+    return HttpRequest::HTTP_REQUEST_POST;
+  }
+
+  const char* payload (size_t* length, const int threadNumber, const size_t threadCounter, const size_t globalCounter, bool* mustFree) {
+    TRI_string_buffer_t* buffer;
+    buffer = TRI_CreateSizedStringBuffer(TRI_UNKNOWN_MEM_ZONE, 256);
+
+    uint64_t const start = (globalCounter * 7919) % Complexity;
+
+    if (_shortestPath) {
+      uint64_t const end = (globalCounter * 104729 + 1) % Complexity;
+
+      TRI_AppendStringStringBuffer(buffer, "{\"query\":\"RETURN LENGTH(SHORTEST_PATH(");
+      TRI_AppendStringStringBuffer(buffer, Collection.c_str());
+      TRI_AppendStringStringBuffer(buffer, ", ");
+      TRI_AppendStringStringBuffer(buffer, Collection.c_str());
+      TRI_AppendStringStringBuffer(buffer, "Edges, '");
+      TRI_AppendStringStringBuffer(buffer, Collection.c_str());
+      TRI_AppendStringStringBuffer(buffer, "/v");
+      TRI_AppendUInt64StringBuffer(buffer, start);
+      TRI_AppendStringStringBuffer(buffer, "', '");
+      TRI_AppendStringStringBuffer(buffer, Collection.c_str());
+      TRI_AppendStringStringBuffer(buffer, "/v");
+      TRI_AppendUInt64StringBuffer(buffer, end);
+      TRI_AppendStringStringBuffer(buffer, "', 'outbound', { weight: 'weight' }))\"}");
+    }
+    else {
+      TRI_AppendStringStringBuffer(buffer, "{\"query\":\"RETURN LENGTH(TRAVERSAL(");
+      TRI_AppendStringStringBuffer(buffer, Collection.c_str());
+      TRI_AppendStringStringBuffer(buffer, ", ");
+      TRI_AppendStringStringBuffer(buffer, Collection.c_str());
+      TRI_AppendStringStringBuffer(buffer, "Edges, '");
+      TRI_AppendStringStringBuffer(buffer, Collection.c_str());
+      TRI_AppendStringStringBuffer(buffer, "/v");
+      TRI_AppendUInt64StringBuffer(buffer, start);
+      TRI_AppendStringStringBuffer(buffer, "', 'outbound', { maxDepth: 4, uniqueness: { vertices: 'global', edges: 'global' } }))\"}");
+    }
+
+    *length = TRI_LengthStringBuffer(buffer);
+    *mustFree = true;
+    char* ptr = TRI_StealStringBuffer(buffer);
+    TRI_FreeStringBuffer(TRI_UNKNOWN_MEM_ZONE, buffer);
+
+    return (const char*) ptr;
+  }
+
+  bool _shortestPath;
+};
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private functions
 // -----------------------------------------------------------------------------
@@ -1627,6 +2126,35 @@ static bool CreateDocument (SimpleHttpClient* client,
   return ! failed;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief execute an AQL query, discarding its result
+////////////////////////////////////////////////////////////////////////////////
+
+static bool ExecuteQuery (SimpleHttpClient* client,
+                          const std::string& query) {
+  std::map<std::string, std::string> headerFields;
+  SimpleHttpResult* result = nullptr;
+
+  std::string payload = "{\"query\":\"" + StringUtils::escapeUnicode(query) + "\"}";
+  result = client->request(HttpRequest::HTTP_REQUEST_POST,
+                           "/_api/cursor",
+                           payload.c_str(),
+                           payload.size(),
+                           headerFields);
+
+  bool failed = true;
+
+  if (result != nullptr) {
+    if (result->getHttpReturnCode() == 201) {
+      failed = false;
+    }
+
+    delete result;
+  }
+
+  return ! failed;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return the test case for a name
 ////////////////////////////////////////////////////////////////////////////////
@@ -1686,6 +2214,39 @@ static BenchmarkOperation* GetTestCase (const std::string& name) {
   if (name == "aqlinsert") {
     return new AqlInsertTest();
   }
+  if (name == "aqlfunctions") {
+    return new AqlFunctionsTest(false);
+  }
+  if (name == "aqlfunctions-v8") {
+    return new AqlFunctionsTest(true);
+  }
+  if (name == "aqlcalculation") {
+    return new AqlCalculationTest(false);
+  }
+  if (name == "aqlcalculation-v8") {
+    return new AqlCalculationTest(true);
+  }
+  if (name == "aqldocuments") {
+    return new AqlDocumentsTest(false);
+  }
+  if (name == "aqldocuments-stream") {
+    return new AqlDocumentsTest(true);
+  }
+  if (name == "wal-append") {
+    return new WalAppendTest();
+  }
+  if (name == "key-lookup") {
+    return new KeyLookupTest();
+  }
+  if (name == "shape-lookup") {
+    return new ShapeLookupTest();
+  }
+  if (name == "traversal") {
+    return new GraphTest(false);
+  }
+  if (name == "shortest-path") {
+    return new GraphTest(true);
+  }
 
   return nullptr;
 }
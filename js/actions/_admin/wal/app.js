@@ -103,6 +103,12 @@ actions.defineHttp({
 /// - *historicLogfiles*: the maximum number of historic logfiles to keep
 /// - *reserveLogfiles*: the maximum number of reserve logfiles that ArangoDB
 ///   allocates in the background
+/// - *syncCommitWindow*: the maximum time that the synchronization of
+///   write-ahead log data waits for further operations (in microseconds). A
+///   value of *0* turns off waiting. The window must not be greater than the
+///   sync interval
+/// - *syncCommitSize*: the number of pending operations that ends the commit
+///   window
 /// - *throttleWait*: the maximum wait time that operations will wait before
 ///   they get aborted if case of write-throttling (in milliseconds)
 /// - *throttleWhenPending*: the number of unprocessed garbage-collection
@@ -117,6 +123,10 @@ actions.defineHttp({
 /// @RESTRETURNCODE{200}
 /// Is returned if the operation succeeds.
 ///
+/// @RESTRETURNCODE{400}
+/// is returned if *syncCommitWindow* is greater than the sync interval. No
+/// property is changed in this case.
+///
 /// @RESTRETURNCODE{405}
 /// is returned when an invalid HTTP method is used.
 /// @endDocuBlock
@@ -155,11 +165,34 @@ actions.defineHttp({
 ///   allocates in the background
 /// - *syncInterval*: the interval for automatic synchronization of not-yet
 ///   synchronized write-ahead log data (in milliseconds)
+/// - *syncCommitWindow*: the maximum time that the synchronization of
+///   write-ahead log data waits for further operations (in microseconds)
+/// - *syncCommitSize*: the number of pending operations that ends the commit
+///   window
 /// - *throttleWait*: the maximum wait time that operations will wait before
 ///   they get aborted if case of write-throttling (in milliseconds)
 /// - *throttleWhenPending*: the number of unprocessed garbage-collection
 ///   operations that, when reached, will activate write-throttling. A value of
 ///   *0* means that write-throttling will not be triggered.
+/// - *syncStatistics*: statistics about the disk syncs of the write-ahead log:
+///   - *syncs*: number of syncs executed
+///   - *operations*: number of operations synchronized by these syncs
+///   - *averageBatchSize*: average number of operations per sync
+///   - *maxBatchSize*: maximum number of operations in a single sync
+///   - *averageSyncTime*: average duration of a sync (in seconds)
+///   - *maxSyncTime*: maximum duration of a sync (in seconds)
+/// - *collectorStatistics*: statistics about the garbage collection of the
+///   write-ahead log:
+///   - *logfiles*: number of logfiles collected
+///   - *collections*: number of per-collection transfers executed
+///   - *operations*: number of operations transferred into collections
+///   - *pendingOperations*: number of transferred operations not yet applied
+///   - *averageCollectTime*: average duration of collecting a logfile (in seconds)
+///   - *maxCollectTime*: maximum duration of collecting a logfile (in seconds)
+///   - *lagLogfiles*: number of logfiles with data not yet collected
+///   - *lagBytes*: size of the logfiles with data not yet collected
+///   - *lagTicks*: number of ticks between the oldest uncollected operation
+///     and the last committed one
 ///
 /// @RESTRETURNCODES
 ///
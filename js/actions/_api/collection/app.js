@@ -633,6 +633,18 @@ function get_api_collections (req, res) {
 /// - *figures.compactors.count*: The number of compactor files.
 /// - *figures.compactors.fileSize*: The total filesize of all compactor files (in bytes).
 ///
+/// - *figures.compaction.backlogCount*: The number of datafiles that qualify
+///   for compaction.
+/// - *figures.compaction.backlogSize*: The total size of the dead documents in
+///   the datafiles that qualify for compaction (in bytes). This is the amount
+///   of disk space compaction can reclaim.
+/// - *figures.compaction.runs*: The number of compactions executed for the
+///   collection since it was loaded.
+/// - *figures.compaction.bytesRead*: The number of bytes read from datafiles
+///   by these compactions.
+/// - *figures.compaction.bytesWritten*: The number of bytes written into
+///   compaction files by these compactions.
+///
 /// * *figures.shapefiles.count*: The number of shape files. This value is
 ///   deprecated and kept for compatibility reasons only. The value will always
 ///   be 0 since ArangoDB 2.0 and higher.
@@ -430,6 +430,24 @@ function processQuery (query, explain) {
         index.node = node.id;
         indexes.push(index);
         return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* " + (node.reverse ? "reverse " : "") + node.index.type + " index scan") + annotation("*/");
+      case "GeoIndexNode":
+        collectionVariables[node.outVariable.id] = node.collection;
+        var geoIndex = node.index;
+        geoIndex.ranges = keyword("NEAR") + " " + value(JSON.stringify([ node.latitude, node.longitude ])) + 
+                          (node.hasOwnProperty("radius") ? " " + keyword("WITHIN") + " " + value(JSON.stringify(node.radius)) : "") +
+                          (node.limit > 0 ? " " + keyword("LIMIT") + " " + value(JSON.stringify(node.limit)) : "");
+        geoIndex.collection = node.collection;
+        geoIndex.node = node.id;
+        indexes.push(geoIndex);
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* " + node.index.type + " index scan, ordered by distance */");
+      case "FulltextIndexNode":
+        collectionVariables[node.outVariable.id] = node.collection;
+        var fulltextIndex = node.index;
+        fulltextIndex.ranges = keyword("FULLTEXT") + " " + value(JSON.stringify(node.query));
+        fulltextIndex.collection = node.collection;
+        fulltextIndex.node = node.id;
+        indexes.push(fulltextIndex);
+        return keyword("FOR") + " " + variableName(node.outVariable) + " " + keyword("IN") + " " + collection(node.collection) + "   " + annotation("/* " + node.index.type + " index scan */");
       case "CalculationNode":
         return keyword("LET") + " " + variableName(node.outVariable) + " = " + buildExpression(node.expression);
       case "FilterNode":
@@ -440,7 +458,8 @@ function processQuery (query, explain) {
         }).join(", ") + 
                  (node.count ? " " + keyword("WITH COUNT") : "") + 
                  (node.outVariable ? " " + keyword("INTO") + " " + variableName(node.outVariable) : "") +
-                 (node.keepVariables ? " " + keyword("KEEP") + " " + node.keepVariables.map(function(variable) { return variableName(variable); }).join(", ") : "");
+                 (node.keepVariables ? " " + keyword("KEEP") + " " + node.keepVariables.map(function(variable) { return variableName(variable); }).join(", ") : "") +
+                 (node.hashed ? "   " + annotation("/* hashed */") : "");
       case "SortNode":
         return keyword("SORT") + " " + node.elements.map(function(node) {
           return variableName(node.inVariable) + " " + keyword(node.ascending ? "ASC" : "DESC"); 
@@ -502,6 +521,8 @@ function processQuery (query, explain) {
     if ([ "EnumerateCollectionNode",
           "EnumerateListNode",
           "IndexRangeNode",
+          "GeoIndexNode",
+          "FulltextIndexNode",
           "SubqueryNode" ].indexOf(node.type) !== -1) {
       level++;
     }
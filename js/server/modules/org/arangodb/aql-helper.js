@@ -265,6 +265,45 @@ function assertQueryWarningAndNull (errorCode, query, bindVars) {
   assertEqual([ null ], result.json);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the expression types ("json", "simple" or "v8") of the
+/// calculations of a query
+////////////////////////////////////////////////////////////////////////////////
+
+function getExpressionTypes (query, bindVars, options) {
+  return AQL_EXPLAIN(query, bindVars, options).plan.nodes.filter(function (node) {
+    return node.type === "CalculationNode";
+  }).map(function (node) {
+    return node.expressionType;
+  });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief assert that a query, all of whose expressions can be evaluated
+/// natively, returns the same results and warnings when its expressions are
+/// evaluated natively and with V8. returns the results
+////////////////////////////////////////////////////////////////////////////////
+
+function assertNativeEqualsV8 (query, bindVars) {
+  var options = { nativeExpressions: false };
+  var warningCodes = function (result) {
+    return result.warnings.map(function (warning) {
+      return warning.code;
+    });
+  };
+
+  assertEqual(-1, getExpressionTypes(query, bindVars).indexOf("v8"), query);
+  assertEqual(-1, getExpressionTypes(query, bindVars, options).indexOf("simple"), query);
+
+  var expected = AQL_EXECUTE(query, bindVars, options);
+  var actual = AQL_EXECUTE(query, bindVars);
+
+  assertEqual(expected.json, actual.json, query);
+  assertEqual(warningCodes(expected), warningCodes(actual), query);
+
+  return actual.json;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get a linearized version of an execution plan
 ////////////////////////////////////////////////////////////////////////////////
@@ -486,6 +525,8 @@ exports.getRawQueryResults                 = getRawQueryResults;
 exports.getQueryResults                    = getQueryResults;
 exports.assertQueryError                   = assertQueryError;
 exports.assertQueryWarningAndNull          = assertQueryWarningAndNull;
+exports.getExpressionTypes                 = getExpressionTypes;
+exports.assertNativeEqualsV8               = assertNativeEqualsV8;
 exports.getLinearizedPlan                  = getLinearizedPlan;
 exports.getCompactPlan                     = getCompactPlan;
 exports.findExecutionNodes                 = findExecutionNodes;
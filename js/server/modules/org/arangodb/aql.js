@@ -3755,6 +3755,38 @@ function AQL_WITHIN (collection, latitude, longitude, radius, distanceAttribute)
   return documents;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the distance between two coordinates, in meters
+////////////////////////////////////////////////////////////////////////////////
+
+function AQL_DISTANCE (latitude1, longitude1, latitude2, longitude2) {
+  'use strict';
+
+  if (TYPEWEIGHT(latitude1) !== TYPEWEIGHT_NUMBER ||
+      TYPEWEIGHT(longitude1) !== TYPEWEIGHT_NUMBER ||
+      TYPEWEIGHT(latitude2) !== TYPEWEIGHT_NUMBER ||
+      TYPEWEIGHT(longitude2) !== TYPEWEIGHT_NUMBER) {
+    WARN("DISTANCE", INTERNAL.errors.ERROR_QUERY_FUNCTION_ARGUMENT_TYPE_MISMATCH);
+    return null;
+  }
+
+  // same formula as used by the geo index
+  var toRadians = Math.PI / 180;
+  var z1 = Math.sin(latitude1 * toRadians);
+  var x1 = Math.cos(latitude1 * toRadians) * Math.cos(longitude1 * toRadians);
+  var y1 = Math.cos(latitude1 * toRadians) * Math.sin(longitude1 * toRadians);
+  var z2 = Math.sin(latitude2 * toRadians);
+  var x2 = Math.cos(latitude2 * toRadians) * Math.cos(longitude2 * toRadians);
+  var y2 = Math.cos(latitude2 * toRadians) * Math.sin(longitude2 * toRadians);
+  var mole = Math.sqrt((x1 - x2) * (x1 - x2) + (y1 - y2) * (y1 - y2) + (z1 - z2) * (z1 - z2));
+
+  if (mole > 2.0) {
+    mole = 2.0;
+  }
+
+  return NUMERIC_VALUE(2.0 * 6371000.0 * Math.asin(mole / 2.0));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return documents within a bounding rectangle 
 ////////////////////////////////////////////////////////////////////////////////
@@ -7992,6 +8024,7 @@ exports.AQL_STDDEV_SAMPLE = AQL_STDDEV_SAMPLE;
 exports.AQL_STDDEV_POPULATION = AQL_STDDEV_POPULATION;
 exports.AQL_NEAR = AQL_NEAR;
 exports.AQL_WITHIN = AQL_WITHIN;
+exports.AQL_DISTANCE = AQL_DISTANCE;
 exports.AQL_WITHIN_RECTANGLE = AQL_WITHIN_RECTANGLE;
 exports.AQL_IS_IN_POLYGON = AQL_IS_IN_POLYGON;
 exports.AQL_FULLTEXT = AQL_FULLTEXT;
@@ -31,6 +31,17 @@
 var jsunity = require("jsunity");
 var helper = require("org/arangodb/aql-helper");
 var getQueryResults = helper.getQueryResults;
+var assertNativeEqualsV8 = helper.assertNativeEqualsV8;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief operand values of all types, including values that cannot be
+/// converted to numbers
+////////////////////////////////////////////////////////////////////////////////
+
+var operandValues = [
+  null, false, true, 0, 1, -1, 2.5, -7, 1e308, "", " ", "1", " 42 ", "-2.5", "1e3",
+  "0x10", "abc", [ ], [ 1 ], [ "3" ], [ 1, 2 ], { }, { a: 1 }
+];
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test suite
@@ -1245,6 +1256,52 @@ function ahuacatlArithmeticTestSuite () {
       var expected = [ 40 ];
       var actual = getQueryResults("RETURN -7 - -4 - -2 + 10 * 5 - 9");
       assertEqual(expected, actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test unary operators with values not known at query compile time,
+/// evaluated natively and with V8
+////////////////////////////////////////////////////////////////////////////////
+
+    testArithmeticUnaryNativeV8 : function () {
+      var query = "FOR a IN @values RETURN [ -a, +a, -(-a), -a + 1 ]";
+
+      var actual = assertNativeEqualsV8(query, { values: operandValues });
+      assertEqual([ -1, 1, 1, 0 ], actual[4]);
+      assertEqual([ 2.5, -2.5, -2.5, 3.5 ], actual[13]);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test binary operators with values not known at query compile time,
+/// evaluated natively and with V8
+////////////////////////////////////////////////////////////////////////////////
+
+    testArithmeticBinaryNativeV8 : function () {
+      var query = "FOR a IN @values FOR b IN @values RETURN [ a + b, a - b, a * b, a / b, a % b ]";
+
+      var actual = assertNativeEqualsV8(query, { values: operandValues });
+      assertEqual(operandValues.length * operandValues.length, actual.length);
+
+      // 2.5 and "1"
+      assertEqual([ 3.5, 1.5, 2.5, 2.5, 0.5 ], actual[6 * operandValues.length + 11]);
+      // 1 and null
+      assertEqual([ 1, 1, 0, null, null ], actual[4 * operandValues.length]);
+      // 1e308 and 1e308
+      assertEqual([ null, 0, null, 1, 0 ], actual[8 * operandValues.length + 8]);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test arithmetic on document attributes, evaluated natively and
+/// with V8
+////////////////////////////////////////////////////////////////////////////////
+
+    testArithmeticAttributesNativeV8 : function () {
+      var values = operandValues.map(function (value, i) {
+        return { value: value, other: operandValues[operandValues.length - 1 - i] };
+      });
+      var query = "FOR d IN @values LET gross = d.value * 1.19 RETURN [ gross, d.value % 7, d.value / d.other, -d.other - gross ]";
+
+      assertNativeEqualsV8(query, { values: values });
     }
 
   };
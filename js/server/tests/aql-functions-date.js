@@ -34,6 +34,7 @@ var helper = require("org/arangodb/aql-helper");
 var getQueryResults = helper.getQueryResults;
 var assertQueryError = helper.assertQueryError;
 var assertQueryWarningAndNull = helper.assertQueryWarningAndNull;
+var assertNativeEqualsV8 = helper.assertNativeEqualsV8;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test suite
@@ -926,6 +927,75 @@ function ahuacatlDateFunctionsTestSuite () {
 
       actual = getQueryResults("RETURN DATE_ISO8601(DATE_TIMESTAMP(DATE_YEAR(@value), DATE_MONTH(@value), DATE_DAY(@value), DATE_HOUR(@value), DATE_MINUTE(@value), DATE_SECOND(@value), DATE_MILLISECOND(@value)))", { value: dt + "Z" });
       assertEqual([ dt + "Z" ], actual); 
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test date strings in non-ISO formats, with values that are not
+/// known at query compile time
+////////////////////////////////////////////////////////////////////////////////
+
+    testDateNonIsoFormats : function () {
+      var values = [
+        [ "Mar 25 2015", Date.UTC(2015, 2, 25) ],
+        [ "25 March 2015", Date.UTC(2015, 2, 25) ],
+        [ "2015/03/25", Date.UTC(2015, 2, 25) ],
+        [ "03/25/2015 10:00:00.123", Date.UTC(2015, 2, 25, 10, 0, 0, 123) ],
+        [ "Wed Mar 25 2015 10:00:00 GMT+0100 (CET)", Date.UTC(2015, 2, 25, 9, 0, 0) ],
+        [ "Mar 25, 2015 10:00:00 GMT+0100", Date.UTC(2015, 2, 25, 9, 0, 0) ],
+        [ "2015-03-25 10:00:00 +01:00", Date.UTC(2015, 2, 25, 9, 0, 0) ],
+        [ "2015-03-25T10:00:00+0100", Date.UTC(2015, 2, 25, 9, 0, 0) ],
+        [ "2015-03-25T10:00:00.123456Z", Date.UTC(2015, 2, 25, 10, 0, 0, 123) ],
+        [ "+002015-03-25T10:00:00Z", Date.UTC(2015, 2, 25, 10, 0, 0) ],
+        [ "Tue 2015-03-25", Date.UTC(2015, 2, 25) ],
+        [ "12/31/99", Date.UTC(1999, 11, 31) ],
+        [ "2015 03 25", Date.UTC(2015, 2, 25) ],
+        [ "2015-03-25 1:2:3", Date.UTC(2015, 2, 25, 1, 2, 3) ],
+        [ "Wed, 25 Mar 2015 10:00:00 GMT", null ],
+        [ "Dec 25 2015 12:00 AM", null ],
+        [ "2015-03-25T10:00:00 UTC", null ],
+        [ "2015-03-25-01:00", null ],
+        [ "2015-03-25T24:00:00Z", null ]
+      ];
+
+      var query = "FOR value IN @values RETURN DATE_TIMESTAMP(value)";
+      var actual = getQueryResults(query, { values: values.map(function (value) { return value[0]; }) });
+      assertEqual(values.map(function (value) { return value[1]; }), actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that date functions return the same results and warnings when
+/// evaluated natively and with V8
+////////////////////////////////////////////////////////////////////////////////
+
+    testDateNativeV8 : function () {
+      var values = [
+        null, false, true, [ ], { }, -1, 0, 1, 1399472349522, 8.64e15, 8.64e15 + 1, -8.64e15,
+        "", " ", "foobar", "2012", "2012-1z", "  2012-01-01Z", "2012-2-12Z", "2012fjh",
+        "2012-02-12 13:24:12", "2012-02-12 23:59:59.991", "1970-01-01T01:05:27+01:00",
+        "1970-01-01T01:05:27-01:00", "1970-01-01T01:05:27", "2001-02-11 24:00:00",
+        "2001-1-32", "2000-00-00", "-000001-03-25T10:00:00Z", "9999-12-31",
+        "Mar 25 2015", "25 March 2015", "2015/03/25", "Wed, 25 Mar 2015 10:00:00 GMT",
+        "2015-03-25 10:00 PM", "Wed Mar 25 2015 10:00:00 GMT+0100 (CET)",
+        "2015-03-25 10:00:00 -5", "12/31/99", "1/1/49", "Dec 25 2015 12:00 pm"
+      ];
+
+      var functions = [
+        "DATE_DAYOFWEEK", "DATE_YEAR", "DATE_MONTH", "DATE_DAY", "DATE_HOUR", "DATE_MINUTE",
+        "DATE_SECOND", "DATE_MILLISECOND", "DATE_TIMESTAMP", "DATE_ISO8601"
+      ];
+
+      functions.forEach(function (func) {
+        assertNativeEqualsV8("FOR value IN @values RETURN " + func + "(value)", { values: values });
+      });
+
+      var components = [
+        [ 2015, 3, 25 ], [ 2015, 3, 25, 10, 11, 12, 13 ], [ "2015", "3", "25" ], [ null, null, null ],
+        [ 2015, -1, 25 ], [ 2015, "foo", 25 ], [ 2015, [ ], 25 ], [ 99, 1, 1 ], [ 2015, 14, 40 ]
+      ];
+
+      assertNativeEqualsV8("FOR value IN @values RETURN DATE_TIMESTAMP(value[0], value[1], value[2], value[3], value[4], value[5], value[6])", { values: components });
+      assertNativeEqualsV8("FOR value IN @values RETURN DATE_ISO8601(value[0], value[1], value[2])", { values: components });
+      assertNativeEqualsV8("FOR value IN @values RETURN DATE_TIMESTAMP(value[0], value[1])", { values: components });
     }
   
   };
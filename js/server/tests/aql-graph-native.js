@@ -0,0 +1,184 @@
+/*jshint globalstrict:false, strict:false, sub: true, maxlen: 500 */
+/*global assertEqual, assertTrue */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for query language, native vs. JavaScript graph functions
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2015 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2015, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+var helper = require("org/arangodb/aql-helper");
+var getQueryResults = helper.getQueryResults;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite comparing the native graph functions with their
+/// JavaScript implementations. Passing the edge collection as a collection
+/// name (identifier) runs the native path, passing it as a string runs the
+/// JavaScript path
+////////////////////////////////////////////////////////////////////////////////
+
+function ahuacatlQueryGraphNativeTestSuite () {
+  var vn = "UnitTestsAhuacatlVertex";
+  var on = "UnitTestsAhuacatlOtherVertex";
+  var en = "UnitTestsAhuacatlEdge";
+  var starts = [ vn + "/v1", vn + "/v2", vn + "/v3", on + "/o1", vn + "/v8" ];
+
+  var compare = function (native, js, bindVars) {
+    var actual = getQueryResults(native, bindVars || { });
+    var expected = getQueryResults(js, bindVars || { });
+
+    assertEqual(expected, actual);
+    return actual;
+  };
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(vn);
+      db._drop(on);
+      db._drop(en);
+
+      var vertex = db._create(vn);
+      var other = db._create(on);
+      var edge = db._createEdgeCollection(en);
+
+      [ "v1", "v2", "v3", "v4", "v5" ].forEach(function (key) {
+        vertex.save({ _key: key, value: key });
+      });
+      [ "o1", "o2" ].forEach(function (key) {
+        other.save({ _key: key, value: key });
+      });
+
+      function makeEdge (from, to) {
+        edge.save(from, to, { what: from.split("/")[1] + "->" + to.split("/")[1] });
+      }
+
+      makeEdge(vn + "/v1", vn + "/v2");
+      makeEdge(vn + "/v1", vn + "/v3");
+      makeEdge(vn + "/v2", vn + "/v3");
+      makeEdge(vn + "/v3", vn + "/v4");
+      makeEdge(vn + "/v4", vn + "/v2");
+      // edges into a vertex collection the queries do not reference
+      makeEdge(vn + "/v3", on + "/o1");
+      makeEdge(on + "/o1", on + "/o2");
+      makeEdge(on + "/o2", vn + "/v5");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(vn);
+      db._drop(on);
+      db._drop(en);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks EDGES() with non-constant start vertices
+////////////////////////////////////////////////////////////////////////////////
+
+    testEdgesNativeVsJs : function () {
+      [ "outbound", "inbound", "any" ].forEach(function (direction) {
+        var query = "FOR s IN @starts FOR e IN EDGES(#, s, @direction) SORT s, e.what RETURN [ s, e.what ]";
+        var bind = { starts: starts, direction: direction };
+
+        compare(query.replace("#", en), query.replace("#", "'" + en + "'"), bind);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks NEIGHBORS() with non-constant start vertices, including
+/// neighbors in a vertex collection not referenced by the query
+////////////////////////////////////////////////////////////////////////////////
+
+    testNeighborsNativeVsJs : function () {
+      [ "outbound", "inbound", "any" ].forEach(function (direction) {
+        var query = "FOR s IN @starts FOR n IN NEIGHBORS(" + vn + ", #, s, @direction) " +
+                    "SORT s, n.vertex._id, n.edge.what RETURN [ s, n.vertex._id, n.vertex.value, n.edge.what ]";
+        var bind = { starts: starts, direction: direction };
+
+        compare(query.replace("#", en), query.replace("#", "'" + en + "'"), bind);
+      });
+
+      var actual = getQueryResults("FOR n IN NEIGHBORS(" + vn + ", " + en + ", @start, 'outbound') SORT n.vertex._id RETURN n.vertex.value", { start: vn + "/v3" });
+      assertEqual([ "o1", "v4" ], actual);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks TRAVERSAL() with non-constant start vertices, crossing into
+/// a vertex collection not referenced by the query
+////////////////////////////////////////////////////////////////////////////////
+
+    testTraversalNativeVsJs : function () {
+      [ "outbound", "inbound", "any" ].forEach(function (direction) {
+        var query = "FOR s IN @starts FOR p IN TRAVERSAL(" + vn + ", #, s, @direction, { strategy: 'depthfirst', order: 'preorder', itemOrder: 'forward', uniqueness: { vertices: 'global', edges: 'global' }, maxDepth: 3 }) " +
+                    "SORT s, p.vertex._id RETURN [ s, p.vertex._id, p.vertex.value ]";
+        var bind = { starts: starts, direction: direction };
+
+        compare(query.replace("#", en), query.replace("#", "'" + en + "'"), bind);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief checks SHORTEST_PATH() with non-constant start and end vertices
+////////////////////////////////////////////////////////////////////////////////
+
+    testShortestPathNativeVsJs : function () {
+      var ends = [ vn + "/v4", vn + "/v5", on + "/o2", vn + "/v8" ];
+
+      [ "outbound", "inbound", "any" ].forEach(function (direction) {
+        var query = "FOR s IN @starts FOR t IN @ends FOR p IN SHORTEST_PATH(" + vn + ", #, s, t, @direction, { }) " +
+                    "SORT s, t, p.vertex._id RETURN [ s, t, p.vertex._id, p.vertex.value, LENGTH(p.path.vertices) ]";
+        var bind = { starts: starts, ends: ends, direction: direction };
+
+        compare(query.replace("#", en), query.replace("#", "'" + en + "'"), bind);
+      });
+
+      var actual = getQueryResults("FOR p IN SHORTEST_PATH(" + vn + ", " + en + ", @from, @to, 'outbound', { }) RETURN p.vertex.value", { from: vn + "/v1", to: vn + "/v5" });
+      assertTrue(actual.length > 0);
+      assertEqual("v5", actual[actual.length - 1]);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(ahuacatlQueryGraphNativeTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
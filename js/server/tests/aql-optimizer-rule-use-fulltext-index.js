@@ -0,0 +1,235 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertNotEqual, fail, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+var helper = require("org/arangodb/aql-helper");
+var errors = require("internal").errors;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-fulltext-index";
+  // various choices to control the optimizer:
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+
+  var cn1 = "UnitTestsAqlOptimizerFulltext1";
+  var cn2 = "UnitTestsAqlOptimizerFulltext2";
+
+  var words = [ "apple", "banana", "cherry", "date", "elderberry", "fig", "grape", "Ärger", "über" ];
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn1);
+      db._drop(cn2);
+
+      var c1 = db._create(cn1);
+      var c2 = db._create(cn2);
+
+      c1.ensureFulltextIndex("text");
+
+      for (var i = 0; i < 500; ++i) {
+        var text = [ ];
+        for (var j = 0; j < words.length; ++j) {
+          if (i % (j + 2) === 0) {
+            text.push(words[j]);
+          }
+        }
+        c1.save({ _key: "test" + i, value: i, text: text.join(" ") + " word" + i });
+        c2.save({ _key: "test" + i, value: i, text: text.join(" ") });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn1);
+      db._drop(cn2);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'apple') RETURN d",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'prefix:ban') RETURN d.value"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual([ ], result.plan.rules);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        // no index on attribute
+        "FOR d IN FULLTEXT(" + cn1 + ", 'value', 'apple') RETURN d",
+        // fulltext query not constant
+        "FOR i IN [ 'apple', 'fig' ] FOR d IN FULLTEXT(" + cn1 + ", 'text', i) RETURN d",
+        // result not iterated over
+        "RETURN LENGTH(FULLTEXT(" + cn1 + ", 'text', 'apple'))",
+        "LET r = FULLTEXT(" + cn1 + ", 'text', 'apple') RETURN r"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertTrue(result.plan.rules.indexOf(ruleName) === -1, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        [ "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'apple') RETURN d", "apple" ],
+        [ "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'prefix:ban,-cherry') RETURN d", "prefix:ban,-cherry" ],
+        [ "FOR d IN FULLTEXT('" + cn1 + "', 'text', 'apple,|fig') FILTER d.value > 10 RETURN d", "apple,|fig" ],
+        [ "FOR i IN 1..2 FOR d IN FULLTEXT(" + cn1 + ", 'text', 'grape') RETURN [ i, d ]", "grape" ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+
+        var nodes = helper.findExecutionNodes(result, "FulltextIndexNode");
+        assertEqual(1, nodes.length, query[0]);
+        assertEqual(query[1], nodes[0].query, query[0]);
+        assertEqual(cn1, nodes[0].collection, query[0]);
+        assertEqual(0, helper.findExecutionNodes(result, "EnumerateListNode").length, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test generated plans
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlans : function () {
+      var plans = [
+        [ "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'apple') RETURN d", [ "SingletonNode", "FulltextIndexNode", "ReturnNode" ] ],
+        [ "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'apple') LIMIT 3 RETURN d.value", [ "SingletonNode", "FulltextIndexNode", "LimitNode", "CalculationNode", "ReturnNode" ] ]
+      ];
+
+      plans.forEach(function(plan) {
+        var result = AQL_EXPLAIN(plan[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), plan[0]);
+        assertEqual(plan[1], helper.getCompactPlan(result).map(function(node) { return node.type; }), plan[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'apple') SORT d.value RETURN d.value",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'apple,banana,-cherry') SORT d.value RETURN d.value",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'prefix:el,|fig') SORT d.value RETURN d.value",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'ärger') SORT d.value RETURN d.value",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'prefix:word1') SORT d.value RETURN d.value",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'prefix:word') SORT d.value LIMIT 10, 5 RETURN d.value",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'doesnotexist') RETURN d",
+        "FOR i IN [ 1, 2, 3 ] FOR d IN FULLTEXT(" + cn1 + ", 'text', 'grape') SORT i, d.value RETURN [ i, d.value ]",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'fig') FOR e IN " + cn2 + " FILTER e._key == d._key RETURN e.text"
+      ];
+
+      queries.forEach(function(query) {
+        var planDisabled   = AQL_EXPLAIN(query, { }, paramDisabled);
+        var planEnabled    = AQL_EXPLAIN(query, { }, paramEnabled);
+        var resultDisabled = AQL_EXECUTE(query, { }, paramDisabled).json;
+        var resultEnabled  = AQL_EXECUTE(query, { }, paramEnabled).json;
+
+        // the index does not return the documents in any particular order
+        assertEqual(resultDisabled.sort(), resultEnabled.sort(), query);
+
+        assertEqual(-1, planDisabled.plan.rules.indexOf(ruleName), query);
+        assertNotEqual(-1, planEnabled.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test invalid fulltext queries
+////////////////////////////////////////////////////////////////////////////////
+
+    testInvalidQueries : function () {
+      var queries = [
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', '') RETURN d",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', ',,') RETURN d",
+        "FOR d IN FULLTEXT(" + cn1 + ", 'text', 'prefix:') RETURN d"
+      ];
+
+      queries.forEach(function(query) {
+        [ paramEnabled, paramDisabled ].forEach(function(param) {
+          try {
+            AQL_EXECUTE(query, { }, param);
+            fail();
+          }
+          catch (err) {
+            assertEqual(errors.ERROR_BAD_PARAMETER.code, err.errorNum, query);
+          }
+        });
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
@@ -0,0 +1,286 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
+var helper = require("org/arangodb/aql-helper");
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-geo-index";
+  // various choices to control the optimizer:
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+
+  var cn1 = "UnitTestsAqlOptimizerGeo1";
+  var cn2 = "UnitTestsAqlOptimizerGeo2";
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn1);
+      db._drop(cn2);
+
+      var c1 = db._create(cn1);
+      var c2 = db._create(cn2);
+
+      for (var i = -10; i < 10; ++i) {
+        for (var j = -10; j < 10; ++j) {
+          c1.save({ lat: i, lon: j });
+          c2.save({ location: [ i, j ] });
+        }
+      }
+
+      c1.ensureGeoIndex("lat", "lon");
+      c2.ensureGeoIndex("location");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn1);
+      db._drop(cn2);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 5 RETURN d",
+        "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 200000 RETURN d"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual([ ], result.plan.rules);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [
+        // no LIMIT
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) RETURN d",
+        // descending sort
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) DESC LIMIT 5 RETURN d",
+        // attributes not indexed, or in wrong order
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lon, d.lat, 0.3, 0.7) LIMIT 5 RETURN d",
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.foo, 0.3, 0.7) LIMIT 5 RETURN d",
+        "FOR d IN " + cn2 + " SORT DISTANCE(d.location[1], d.location[0], 0.3, 0.7) LIMIT 5 RETURN d",
+        // reference coordinate not constant
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, d.lat, 0.7) LIMIT 5 RETURN d",
+        // other filter before the LIMIT
+        "FOR d IN " + cn1 + " FILTER d.lat > 0 SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 5 RETURN d",
+        // minimum distance
+        "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) > 200000 RETURN d",
+        // inner loop
+        "FOR i IN 1..2 FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 5 RETURN d"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertTrue(result.plan.rules.indexOf(ruleName) === -1, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [
+        [ "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 5 RETURN d", 5, false ],
+        [ "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 2, 5 RETURN d", 7, false ],
+        [ "FOR d IN " + cn2 + " SORT DISTANCE(d.location[0], d.location[1], 0.3, 0.7) LIMIT 5 RETURN d", 5, false ],
+        [ "FOR d IN " + cn1 + " LET dist = DISTANCE(d.lat, d.lon, 0.3, 0.7) SORT dist LIMIT 5 RETURN d", 5, false ],
+        [ "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 200000 RETURN d", 0, true ],
+        [ "FOR d IN " + cn1 + " FILTER 200000 >= DISTANCE(d.lat, d.lon, 0.3, 0.7) RETURN d", 0, true ],
+        [ "FOR d IN " + cn1 + " FILTER d.lat > 0 FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 200000 RETURN d", 0, true ],
+        [ "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 200000 SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 3 RETURN d", 3, true ],
+        [ "FOR i IN 1..2 FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 200000 RETURN d", 0, true ]
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query[0]);
+
+        var nodes = helper.findExecutionNodes(result, "GeoIndexNode");
+        assertEqual(1, nodes.length, query[0]);
+        assertEqual(0.3, nodes[0].latitude, query[0]);
+        assertEqual(0.7, nodes[0].longitude, query[0]);
+        assertEqual(query[1], nodes[0].limit, query[0]);
+        assertEqual(query[2], nodes[0].hasOwnProperty("radius"), query[0]);
+        assertEqual(0, helper.findExecutionNodes(result, "EnumerateCollectionNode").length, query[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test generated plans
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlans : function () {
+      var plans = [
+        [ "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 5 RETURN d", [ "SingletonNode", "GeoIndexNode", "CalculationNode", "LimitNode", "ReturnNode" ] ],
+        [ "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 200000 RETURN d", [ "SingletonNode", "GeoIndexNode", "CalculationNode", "FilterNode", "ReturnNode" ] ]
+      ];
+
+      plans.forEach(function(plan) {
+        var result = AQL_EXPLAIN(plan[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), plan[0]);
+        assertEqual(plan[1], helper.getCompactPlan(result).map(function(node) { return node.type; }), plan[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 5 RETURN DISTANCE(d.lat, d.lon, 0.3, 0.7)",
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 3, 10 RETURN DISTANCE(d.lat, d.lon, 0.3, 0.7)",
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, -5.1, 3.7) LIMIT 1000 RETURN DISTANCE(d.lat, d.lon, -5.1, 3.7)",
+        "FOR d IN " + cn2 + " SORT DISTANCE(d.location[0], d.location[1], 0.3, 0.7) LIMIT 5 RETURN DISTANCE(d.location[0], d.location[1], 0.3, 0.7)",
+        "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 300000 SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) RETURN DISTANCE(d.lat, d.lon, 0.3, 0.7)",
+        "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 300000 SORT d.lat, d.lon RETURN [ d.lat, d.lon ]",
+        "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 0 RETURN d",
+        "FOR i IN [ 1, 2 ] FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 200000 SORT i, d.lat, d.lon RETURN [ i, d.lat, d.lon ]"
+      ];
+
+      queries.forEach(function(query) {
+        var planDisabled   = AQL_EXPLAIN(query, { }, paramDisabled);
+        var planEnabled    = AQL_EXPLAIN(query, { }, paramEnabled);
+        var resultDisabled = AQL_EXECUTE(query, { }, paramDisabled).json;
+        var resultEnabled  = AQL_EXECUTE(query, { }, paramEnabled).json;
+
+        assertEqual(resultDisabled, resultEnabled, query);
+
+        assertEqual(-1, planDisabled.plan.rules.indexOf(ruleName), query);
+        assertNotEqual(-1, planEnabled.plan.rules.indexOf(ruleName), query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results for documents that are not in the geo index
+////////////////////////////////////////////////////////////////////////////////
+
+    testResultsWithoutCoordinates : function () {
+      var c1 = db._collection(cn1);
+      var c2 = db._collection(cn2);
+      var keys1 = [ ], keys2 = [ ];
+
+      keys1.push(c1.save({ lon: 1 })._key);
+      keys1.push(c1.save({ lat: null, lon: 2 })._key);
+      keys1.push(c1.save({ lat: "foo", lon: 3 })._key);
+      keys1.push(c1.save({ lat: 100, lon: 0.7 })._key);
+      keys2.push(c2.save({ location: null })._key);
+      keys2.push(c2.save({ location: [ 1 ] })._key);
+
+      var queries = [
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 5 RETURN DISTANCE(d.lat, d.lon, 0.3, 0.7)",
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 2 RETURN DISTANCE(d.lat, d.lon, 0.3, 0.7)",
+        "FOR d IN " + cn1 + " SORT DISTANCE(d.lat, d.lon, 0.3, 0.7) LIMIT 1000 RETURN DISTANCE(d.lat, d.lon, 0.3, 0.7)",
+        "FOR d IN " + cn2 + " SORT DISTANCE(d.location[0], d.location[1], 0.3, 0.7) LIMIT 5 RETURN DISTANCE(d.location[0], d.location[1], 0.3, 0.7)",
+        "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 300000 SORT d.lon, d.lat RETURN [ d.lat, d.lon ]",
+        "FOR d IN " + cn1 + " FILTER DISTANCE(d.lat, d.lon, 0.3, 0.7) < 20000000 SORT d.lon, d.lat RETURN [ d.lat, d.lon ]",
+        "FOR d IN " + cn2 + " FILTER DISTANCE(d.location[0], d.location[1], 0.3, 0.7) <= 200000 SORT d.location RETURN d.location"
+      ];
+
+      queries.forEach(function(query) {
+        var planEnabled    = AQL_EXPLAIN(query, { }, paramEnabled);
+        var resultDisabled = AQL_EXECUTE(query, { }, paramDisabled).json;
+        var resultEnabled  = AQL_EXECUTE(query, { }, paramEnabled).json;
+
+        assertNotEqual(-1, planEnabled.plan.rules.indexOf(ruleName), query);
+        assertEqual(resultDisabled, resultEnabled, query);
+      });
+
+      // the documents without coordinates are found with a full scan
+      var query = queries[0];
+      assertNotEqual(0, AQL_EXECUTE(query, { }, paramEnabled).stats.scannedFull);
+      assertEqual(null, AQL_EXECUTE(query, { }, paramEnabled).json[0]);
+
+      // which is not needed anymore once they are gone
+      keys1.forEach(function(key) {
+        c1.remove(key);
+      });
+      keys2.forEach(function(key) {
+        c2.remove(key);
+      });
+
+      assertEqual(0, AQL_EXECUTE(query, { }, paramEnabled).stats.scannedFull);
+      assertEqual(AQL_EXECUTE(query, { }, paramDisabled).json, AQL_EXECUTE(query, { }, paramEnabled).json);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test the DISTANCE function
+////////////////////////////////////////////////////////////////////////////////
+
+    testDistance : function () {
+      var result = AQL_EXECUTE("RETURN [ DISTANCE(0, 0, 0, 0), DISTANCE(0, 0, 0, 180), DISTANCE(50.9, 6.9, 50.9, 6.9) ]").json[0];
+      assertEqual(0, result[0]);
+      assertTrue(Math.abs(result[1] - Math.PI * 6371000) < 1);
+      assertEqual(0, result[2]);
+
+      result = AQL_EXECUTE("RETURN DISTANCE(0, 0, 'foo', 0)");
+      assertEqual([ null ], result.json);
+      assertEqual(1, result.warnings.length);
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
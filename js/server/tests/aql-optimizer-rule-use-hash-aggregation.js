@@ -0,0 +1,202 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, assertNotEqual, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for optimizer rules
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var helper = require("org/arangodb/aql-helper");
+var isEqual = helper.isEqual;
+var db = require("org/arangodb").db;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function optimizerRuleTestSuite () {
+  var ruleName = "use-hash-aggregation";
+  // various choices to control the optimizer: 
+  var paramNone     = { optimizer: { rules: [ "-all" ] } };
+  var paramEnabled  = { optimizer: { rules: [ "-all", "+" + ruleName ] } };
+  var paramDisabled = { optimizer: { rules: [ "+all", "-" + ruleName ] } };
+  var c;
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop("UnitTestsAhuacatlHashAggregation");
+      c = db._create("UnitTestsAhuacatlHashAggregation");
+
+      for (var i = 0; i < 2000; ++i) {
+        c.save({ value: i % 10, other: i % 10 });
+      }
+
+      c.ensureHashIndex("value");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop("UnitTestsAhuacatlHashAggregation");
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect when explicitly disabled
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleDisabled : function () {
+      var queries = [ 
+        "FOR i IN 1..5000 COLLECT a = i % 10 RETURN a",
+        "FOR i IN 1..5000 COLLECT a = i % 10 WITH COUNT INTO c RETURN [ a, c ]",
+        "FOR i IN 1..100 FOR j IN 1..100 COLLECT a = i % 10, b = j % 10 RETURN [ a, b ]"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramNone);
+        assertEqual([ ], result.plan.rules);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has no effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleNoEffect : function () {
+      var queries = [ 
+        "FOR i IN 1..10 COLLECT a = i % 10 RETURN a",
+        "FOR i IN 1..5000 COLLECT a = i % 10 INTO group RETURN [ a, group ]",
+        "FOR i IN 1..5000 COLLECT a = i % 10 INTO group = i RETURN [ a, group ]",
+        "FOR i IN 1..5000 COLLECT WITH COUNT INTO c RETURN c",
+        "FOR i IN 1..5000 COLLECT a = i RETURN a",
+        "FOR i IN 1..5000 COLLECT a = i % 2000 RETURN a",
+        "FOR i IN 1..5000 COLLECT a = i * 2 RETURN a",
+        "FOR i IN 1..100 FOR j IN 1..100 COLLECT a = i, b = j RETURN [ a, b ]",
+        "FOR doc IN " + c.name() + " COLLECT a = doc.other RETURN a",
+        "FOR doc IN " + c.name() + " COLLECT a = doc._key RETURN a"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertTrue(result.plan.rules.indexOf(ruleName) === -1, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test that rule has an effect
+////////////////////////////////////////////////////////////////////////////////
+
+    testRuleHasEffect : function () {
+      var queries = [ 
+        "FOR i IN 1..5000 COLLECT a = i % 10 RETURN a",
+        "FOR i IN 1..5000 COLLECT a = i % 10 WITH COUNT INTO c RETURN [ a, c ]",
+        "FOR i IN 1..100 FOR j IN 1..100 COLLECT a = i % 10, b = j % 10 RETURN [ a, b ]",
+        "FOR i IN 1..5000 COLLECT a = i % 10 SORT a DESC RETURN a",
+        "FOR i IN 1..5000 COLLECT a = (i % 3 == 0) RETURN a",
+        "FOR doc IN " + c.name() + " COLLECT a = doc.value RETURN a"
+      ];
+
+      queries.forEach(function(query) {
+        var result = AQL_EXPLAIN(query, { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), query);
+
+        var nodes = helper.findExecutionNodes(result, "AggregateNode");
+        assertEqual(1, nodes.length);
+        assertTrue(nodes[0].hashed, query);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test generated plans
+////////////////////////////////////////////////////////////////////////////////
+
+    testPlans : function () {
+      var plans = [ 
+        [ "FOR i IN 1..5000 COLLECT a = i % 10 RETURN a", [ "SingletonNode", "CalculationNode", "EnumerateListNode", "CalculationNode", "AggregateNode", "SortNode", "ReturnNode" ] ],
+        [ "FOR i IN 1..5000 COLLECT a = i % 10 WITH COUNT INTO c RETURN [ a, c ]", [ "SingletonNode", "CalculationNode", "EnumerateListNode", "CalculationNode", "AggregateNode", "SortNode", "CalculationNode", "ReturnNode" ] ],
+        [ "FOR i IN 1..5000 COLLECT a = i % 10 SORT a DESC RETURN a", [ "SingletonNode", "CalculationNode", "EnumerateListNode", "CalculationNode", "AggregateNode", "SortNode", "ReturnNode" ] ]
+      ];
+
+      plans.forEach(function(plan) {
+        var result = AQL_EXPLAIN(plan[0], { }, paramEnabled);
+        assertNotEqual(-1, result.plan.rules.indexOf(ruleName), plan[0]);
+        assertEqual(plan[1], helper.getCompactPlan(result).map(function(node) { return node.type; }), plan[0]);
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test results
+////////////////////////////////////////////////////////////////////////////////
+
+    testResults : function () {
+      var queries = [ 
+        [ "FOR i IN 1..5000 COLLECT a = i % 5 RETURN a", [ 0, 1, 2, 3, 4 ] ],
+        [ "FOR i IN 1..5000 COLLECT a = i % 5 SORT a DESC RETURN a", [ 4, 3, 2, 1, 0 ] ],
+        [ "FOR i IN 1..5000 COLLECT a = i % 5 WITH COUNT INTO c RETURN [ a, c ]", [ [ 0, 1000 ], [ 1, 1000 ], [ 2, 1000 ], [ 3, 1000 ], [ 4, 1000 ] ] ],
+        [ "FOR i IN 1..5000 COLLECT a = (i % 3 == 0 ? null : i % 2 == 0 ? 'even' : [ 'odd' ]) WITH COUNT INTO c RETURN [ a, c ]", [ [ null, 1666 ], [ "even", 1667 ], [ [ "odd" ], 1667 ] ] ],
+        [ "FOR i IN 1..100 FOR j IN 1..100 FILTER i <= 2 && j <= 2 COLLECT a = i % 3, b = j % 3 RETURN [ a, b ]", [ [ 1, 1 ], [ 1, 2 ], [ 2, 1 ], [ 2, 2 ] ] ],
+        [ "FOR i IN 1..5000 FILTER i > 5000 COLLECT a = i % 7 RETURN a", [ ] ],
+        [ "FOR i IN 1..5000 COLLECT a = (i % 2 == 0 ? 0 : -0) WITH COUNT INTO c RETURN [ a, c ]", [ [ 0, 5000 ] ] ],
+        [ "FOR doc IN " + c.name() + " COLLECT a = doc.value WITH COUNT INTO c RETURN [ a, c ]", [ [ 0, 200 ], [ 1, 200 ], [ 2, 200 ], [ 3, 200 ], [ 4, 200 ], [ 5, 200 ], [ 6, 200 ], [ 7, 200 ], [ 8, 200 ], [ 9, 200 ] ] ]
+      ];
+
+      queries.forEach(function(query) {
+        var planDisabled   = AQL_EXPLAIN(query[0], { }, paramDisabled);
+        var planEnabled    = AQL_EXPLAIN(query[0], { }, paramEnabled);
+        var resultDisabled = AQL_EXECUTE(query[0], { }, paramDisabled).json;
+        var resultEnabled  = AQL_EXECUTE(query[0], { }, paramEnabled).json;
+
+        assertTrue(isEqual(resultDisabled, resultEnabled), query[0]);
+
+        assertEqual(-1, planDisabled.plan.rules.indexOf(ruleName), query[0]);
+        assertNotEqual(-1, planEnabled.plan.rules.indexOf(ruleName), query[0]);
+
+        assertEqual(resultDisabled, query[1]);
+        assertEqual(resultEnabled, query[1]);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(optimizerRuleTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
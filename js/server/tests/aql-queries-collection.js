@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false, maxlen: 850 */
-/*global assertEqual */
+/*global assertEqual, assertFalse, assertNotEqual */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief tests for query language, simple collection-based queries
@@ -859,11 +859,116 @@ function ahuacatlQueryCollectionTestSuite () {
   };
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite for full scans of large collections
+////////////////////////////////////////////////////////////////////////////////
+
+function ahuacatlQueryLargeCollectionTestSuite () {
+  var cn = "UnitTestsAhuacatlLarge";
+  var c = null;
+  var n = 20000;
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      internal.db._drop(cn);
+      c = internal.db._create(cn, { journalSize: 1024 * 1024 });
+
+      for (var i = 0; i < n; ++i) {
+        c.save({ _key: "test" + i, value: i });
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      internal.db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief full scan with documents in the WAL
+////////////////////////////////////////////////////////////////////////////////
+
+    testFullScanWal : function () {
+      var actual = getQueryResults("FOR c IN " + cn + " COLLECT WITH COUNT INTO count RETURN count");
+      assertEqual([ n ], actual);
+
+      actual = getQueryResults("FOR c IN " + cn + " RETURN c.value");
+      assertEqual(n, actual.length);
+      actual.sort(function (l, r) { return l - r; });
+      for (var i = 0; i < n; ++i) {
+        assertEqual(i, actual[i]);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief full scan with documents in datafiles and in the WAL
+////////////////////////////////////////////////////////////////////////////////
+
+    testFullScanDatafilesAndWal : function () {
+      internal.wal.flush(true, true);
+
+      var i;
+      // update some documents, so they are contained in the datafiles and
+      // the WAL. only the new revisions must be returned
+      for (i = 0; i < n; i += 10) {
+        c.update("test" + i, { value: i + n });
+      }
+      // remove some documents
+      for (i = 1; i < n; i += 10) {
+        c.remove("test" + i);
+      }
+
+      var actual = getQueryResults("FOR c IN " + cn + " RETURN c.value");
+      assertEqual(n - n / 10, actual.length);
+
+      var seen = { };
+      actual.forEach(function (value) {
+        assertFalse(seen.hasOwnProperty(value));
+        seen[value] = true;
+
+        if (value >= n) {
+          assertEqual(0, (value - n) % 10);
+        }
+        else {
+          assertNotEqual(0, value % 10);
+          assertNotEqual(1, value % 10);
+        }
+      });
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief full scan after all documents were moved into the datafiles
+////////////////////////////////////////////////////////////////////////////////
+
+    testFullScanDatafiles : function () {
+      for (var i = 0; i < n; i += 2) {
+        c.remove("test" + i);
+      }
+      internal.wal.flush(true, true);
+
+      var actual = getQueryResults("FOR c IN " + cn + " FILTER c.value % 2 == 0 RETURN c.value");
+      assertEqual([ ], actual);
+
+      actual = getQueryResults("FOR c IN " + cn + " COLLECT WITH COUNT INTO count RETURN count");
+      assertEqual([ n / 2 ], actual);
+    }
+
+  };
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief executes the test suite
 ////////////////////////////////////////////////////////////////////////////////
 
 jsunity.run(ahuacatlQueryCollectionTestSuite);
+jsunity.run(ahuacatlQueryLargeCollectionTestSuite);
 
 return jsunity.done();
 
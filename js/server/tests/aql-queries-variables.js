@@ -31,6 +31,7 @@
 var jsunity = require("jsunity");
 var helper = require("org/arangodb/aql-helper");
 var getQueryResults = helper.getQueryResults;
+var assertNativeEqualsV8 = helper.assertNativeEqualsV8;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test suite
@@ -158,6 +159,28 @@ function ahuacatlQueryVariablesTestSuite () {
       assertEqual(expected, actual);
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return expanded values not known at query compile time, evaluated
+/// natively and with V8
+////////////////////////////////////////////////////////////////////////////////
+
+    testListExpansionNativeV8 : function () {
+      var values = [
+        null, 1, "abc", [ ], [ { x: 1 }, { x: [ { y: 2 }, { y: 3 } ] }, 5 ],
+        { x: 1, y: { x: 2 } }, [ [ { x: 1 } ] ], [ { x: { y: 4 } }, { x: null } ]
+      ];
+      var query = "FOR a IN @values RETURN [ a[*], a[*].x, a[*].x[*].y, a[*].x.y, a[*][0].x, a[*].x + 1 ]";
+
+      var actual = assertNativeEqualsV8(query, { values: values });
+      assertEqual([ [ ], [ ], [ ], [ ], [ ], 1 ], actual[0]);
+      assertEqual([ 1, [ { y: 2 }, { y: 3 } ], null ], actual[4][1]);
+      assertEqual([ 1, 2 ], actual[5][1]);
+
+      query = "FOR a IN @airports RETURN a.continent.countries[*].airports[*].name";
+      actual = assertNativeEqualsV8(query, { airports: airports });
+      assertEqual([ [ "NRT", "HND", "OKD", "OKA" ] ], actual[2]);
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief return an expanded variable
 ////////////////////////////////////////////////////////////////////////////////
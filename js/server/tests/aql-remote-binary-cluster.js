@@ -0,0 +1,186 @@
+/*jshint globalstrict:false, strict:false, maxlen: 500 */
+/*global assertEqual, assertTrue, AQL_EXPLAIN, AQL_EXECUTE */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for the binary transfer of AqlItemBlocks between servers
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2015 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Copyright 2015, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var db = require("org/arangodb").db;
+var jsunity = require("jsunity");
+var helper = require("org/arangodb/aql-helper");
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function remoteBinaryTestSuite () {
+  var cn = "UnitTestsRemoteBinary";
+  var c;
+
+  var explain = function (query) {
+    return helper.getCompactPlan(AQL_EXPLAIN(query)).map(function(node) 
+        { return node.type; });
+  };
+
+  // the calculation must be done on the DB servers, so its results are
+  // transferred to the coordinator
+  var assertCalculationBeforeRemote = function (query) {
+    var nodes = explain(query);
+    var remote = nodes.indexOf("RemoteNode");
+
+    assertTrue(remote !== -1, query);
+    assertTrue(nodes.indexOf("CalculationNode") !== -1, query);
+    assertTrue(nodes.indexOf("CalculationNode") < remote, query);
+  };
+
+  var sortByFirst = function (l, r) {
+    return l[0] - r[0];
+  };
+
+  return {
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief set up
+    ////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn, { numberOfShards: 3 });
+
+      // more documents than fit into a single block
+      for (var i = 0; i < 2500; ++i) {
+        c.save({ _key: "test" + i, value: i, values: [ i, "foo" + i, { sub: i * 0.5 } ] });
+      }
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief tear down
+    ////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+      c = null;
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief shaped documents are transferred with all their attributes
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testShaped : function () {
+      var query = "FOR d IN " + cn + " RETURN d";
+      assertTrue(explain(query).indexOf("RemoteNode") !== -1, query);
+
+      var actual = AQL_EXECUTE(query).json;
+      assertEqual(2500, actual.length);
+
+      actual.sort(function (l, r) {
+        return l.value - r.value;
+      });
+
+      actual.forEach(function (doc, i) {
+        assertEqual("test" + i, doc._key);
+        assertEqual(cn + "/test" + i, doc._id);
+        assertTrue(typeof doc._rev === "string");
+        assertEqual(i, doc.value);
+        assertEqual([ i, "foo" + i, { sub: i * 0.5 } ], doc.values);
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief shaped documents used in more than one register
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testShapedRepeated : function () {
+      var query = "FOR d IN " + cn + " LET v = d.value RETURN [ v, d, d.values ]";
+      assertCalculationBeforeRemote(query);
+
+      var actual = AQL_EXECUTE(query).json;
+      assertEqual(2500, actual.length);
+
+      actual.sort(sortByFirst);
+
+      actual.forEach(function (row, i) {
+        assertEqual(i, row[0]);
+        assertEqual("test" + i, row[1]._key);
+        assertEqual(i, row[1].value);
+        assertEqual(row[1].values, row[2]);
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief ranges are transferred with their bounds
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testRanges : function () {
+      var query = "FOR d IN " + cn + " LET r = (d.value - 2) .. (d.value + 1) RETURN [ d.value, r ]";
+      assertCalculationBeforeRemote(query);
+
+      var actual = AQL_EXECUTE(query).json;
+      assertEqual(2500, actual.length);
+
+      actual.sort(sortByFirst);
+
+      actual.forEach(function (row, i) {
+        assertEqual([ i, [ i - 2, i - 1, i, i + 1 ] ], row);
+      });
+    },
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// @brief descending ranges with negative bounds
+    ////////////////////////////////////////////////////////////////////////////////
+
+    testRangesDescending : function () {
+      var query = "FOR d IN " + cn + " FILTER d.value < 10 LET r = d.value .. -3 RETURN [ d.value, r ]";
+      assertCalculationBeforeRemote(query);
+
+      var actual = AQL_EXECUTE(query).json;
+      assertEqual(10, actual.length);
+
+      actual.sort(sortByFirst);
+
+      actual.forEach(function (row, i) {
+        var expected = [ ];
+        for (var j = i; j >= -3; --j) {
+          expected.push(j);
+        }
+        assertEqual([ i, expected ], row);
+      });
+    }
+
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(remoteBinaryTestSuite);
+
+return jsunity.done();
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "^\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @}\\)"
+// End:
@@ -29,14 +29,17 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 var jsunity = require("jsunity");
+var db = require("org/arangodb").db;
 var helper = require("org/arangodb/aql-helper");
 var getQueryResults = helper.getQueryResults;
+var assertNativeEqualsV8 = helper.assertNativeEqualsV8;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test suite
 ////////////////////////////////////////////////////////////////////////////////
 
 function ahuacatlTernaryTestSuite () {
+  var cn = "UnitTestsAhuacatlTernary";
 
   return {
 
@@ -45,6 +48,7 @@ function ahuacatlTernaryTestSuite () {
 ////////////////////////////////////////////////////////////////////////////////
 
     setUp : function () {
+      db._drop(cn);
     },
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -52,6 +56,7 @@ function ahuacatlTernaryTestSuite () {
 ////////////////////////////////////////////////////////////////////////////////
 
     tearDown : function () {
+      db._drop(cn);
     },
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -181,6 +186,41 @@ function ahuacatlTernaryTestSuite () {
       assertEqual([ 2 ], getQueryResults("RETURN [ ] ? 2 : 3"));
       assertEqual([ 2 ], getQueryResults("RETURN [ 0 ] ? 2 : 3"));
       assertEqual([ 2 ], getQueryResults("RETURN { } ? 2 : 3"));
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test ternary with values not known at query compile time, evaluated
+/// natively and with V8
+////////////////////////////////////////////////////////////////////////////////
+    
+    testTernaryNativeV8 : function () {
+      var values = [ null, false, true, 0, 1, -1, 2.5, "", "0", "abc", [ ], [ 0 ], { }, { a: 1 } ];
+      var query = "FOR a IN @values RETURN [ a ? 2 : 3, a ? a : \"none\", a > 0 ? a * 2 : (a == null ? \"null\" : -a), a ? (a[0] ? a[0] : a.a) : a ]";
+
+      var actual = assertNativeEqualsV8(query, { values: values });
+      assertEqual([ 3, "none", "null", null ], actual[0]);
+      assertEqual([ 2, 2.5, 5, null ], actual[6]);
+      assertEqual([ 2, { a: 1 }, null, 1 ], actual[13]);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test ternary returning documents, evaluated natively and with V8
+////////////////////////////////////////////////////////////////////////////////
+    
+    testTernaryDocumentsNativeV8 : function () {
+      var c = db._create(cn);
+      for (var i = 0; i < 10; ++i) {
+        c.save({ _key: "test" + i, value: i, tags: [ { name: "a" + i }, { name: "b" + i } ] });
+      }
+
+      var query = "FOR d IN " + cn + " SORT d.value RETURN d.value % 2 == 0 ? d : d.tags[*].name";
+
+      var actual = assertNativeEqualsV8(query);
+      assertEqual(10, actual.length);
+      assertEqual("test0", actual[0]._key);
+      assertEqual(cn + "/test0", actual[0]._id);
+      assertEqual(0, actual[0].value);
+      assertEqual([ "a1", "b1" ], actual[1]);
     }
 
   };
@@ -0,0 +1,161 @@
+/*jshint globalstrict:false, strict:false, unused : false */
+/*global assertEqual, assertFalse */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for recovery with document-level locking
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2015 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2015, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var db = require("org/arangodb").db;
+var internal = require("internal");
+var jsunity = require("jsunity");
+
+
+function runSetup () {
+  'use strict';
+  internal.debugClearFailAt();
+  
+  var c, e, i;
+  db._drop("UnitTestsRecovery");
+  db._drop("UnitTestsRecoveryEdges");
+  c = db._create("UnitTestsRecovery");
+  e = db._createEdgeCollection("UnitTestsRecoveryEdges");
+
+  for (i = 0; i < 100; ++i) {
+    c.save({ _key: "test" + i, value: i });
+    e.save("UnitTestsRecovery/test" + i, "UnitTestsRecovery/test" + (i % 10), { _key: "test" + i, value: i });
+  }
+
+  // failed updates must not be replayed
+  internal.debugSetFailAt("InsertSecondaryIndexes");
+  for (i = 0; i < 50; ++i) {
+    try {
+      c.update("test" + i, { value: "failed" });
+    }
+    catch (err1) {
+    }
+    try {
+      e.update("test" + i, { value: "failed" });
+    }
+    catch (err2) {
+    }
+  }
+  internal.debugClearFailAt();
+
+  // failed removals must not be replayed
+  internal.debugSetFailAt("DeleteSecondaryIndexes");
+  for (i = 50; i < 100; ++i) {
+    try {
+      c.remove("test" + i);
+    }
+    catch (err3) {
+    }
+    try {
+      e.remove("test" + i);
+    }
+    catch (err4) {
+    }
+  }
+  internal.debugClearFailAt();
+
+  // successful operations
+  for (i = 0; i < 100; i += 10) {
+    c.update("test" + i, { value: "updated" });
+    e.update("test" + i, { value: "updated" });
+  }
+  for (i = 5; i < 100; i += 10) {
+    c.remove("test" + i);
+    e.remove("test" + i);
+  }
+
+  c.save({ _key: "crashme" }, true); // wait for sync
+
+  internal.debugSegfault("crashing server");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function recoverySuite () {
+  'use strict';
+  jsunity.jsUnity.attachAssertions();
+
+  return {
+    setUp: function () {
+    },
+    tearDown: function () {
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test whether failed operations are not recovered
+////////////////////////////////////////////////////////////////////////////////
+    
+    testDocumentLevelLocking : function () {
+      var c = db._collection("UnitTestsRecovery");
+      var e = db._collection("UnitTestsRecoveryEdges");
+      var i;
+
+      assertEqual(91, c.count());
+      assertEqual(90, e.count());
+
+      [ c, e ].forEach(function (col) {
+        for (i = 0; i < 100; ++i) {
+          if (i % 10 === 5) {
+            assertFalse(col.exists("test" + i));
+          }
+          else if (i % 10 === 0) {
+            assertEqual("updated", col.document("test" + i).value);
+          }
+          else {
+            assertEqual(i, col.document("test" + i).value);
+          }
+        }
+      });
+
+      for (i = 0; i < 100; ++i) {
+        assertEqual(i % 10 === 5 ? 0 : 1, e.outEdges("UnitTestsRecovery/test" + i).length);
+      }
+    }
+        
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function main (argv) {
+  'use strict';
+  if (argv[1] === "setup") {
+    runSetup();
+    return 0;
+  }
+  else {
+    jsunity.run(recoverySuite);
+    return jsunity.done().status ? 0 : 1;
+  }
+}
+
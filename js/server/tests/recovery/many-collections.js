@@ -0,0 +1,167 @@
+/*jshint globalstrict:false, strict:false, unused : false */
+/*global assertEqual, assertFalse, assertTrue */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for recovery with operations in many collections
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2012 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2012, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var db = require("org/arangodb").db;
+var internal = require("internal");
+var jsunity = require("jsunity");
+
+var numCollections = 8;
+var numDocuments = 25000;
+
+function runSetup () {
+  'use strict';
+  internal.debugClearFailAt();
+  
+  // disable collector, so all operations must be replayed from the WAL
+  internal.debugSetFailAt("CollectorThreadProcessQueuedOperations");
+
+  var i, j, c;
+
+  for (i = 0; i < numCollections; ++i) {
+    db._drop("UnitTestsRecovery" + i);
+    db._drop("UnitTestsRecoveryRenamed" + i);
+    db._create("UnitTestsRecovery" + i);
+  }
+  db._drop("UnitTestsRecoveryEdges");
+  var edges = db._createEdgeCollection("UnitTestsRecoveryEdges");
+
+  // interleave the operations of all collections
+  for (j = 0; j < numDocuments; ++j) {
+    for (i = 0; i < numCollections; ++i) {
+      c = db._collection("UnitTestsRecovery" + i);
+      c.save({ _key: "test" + j, value: j, collection: i });
+    }
+
+    if (j > 0 && j % 10 === 0) {
+      edges.save("UnitTestsRecovery0/test" + j, "UnitTestsRecovery1/test" + (j - 1), { value: j });
+    }
+  }
+
+  // updates and removes after a structural change of one collection
+  db._collection("UnitTestsRecovery0").ensureHashIndex("value");
+  for (i = 0; i < numCollections; ++i) {
+    c = db._collection("UnitTestsRecovery" + i);
+    for (j = 0; j < numDocuments; j += 5) {
+      c.update("test" + j, { updated: true });
+    }
+    for (j = 1; j < numDocuments; j += 5) {
+      c.remove("test" + j);
+    }
+  }
+
+  // rename a collection and continue writing into it
+  db._collection("UnitTestsRecovery" + (numCollections - 1)).rename("UnitTestsRecoveryRenamed" + (numCollections - 1));
+  c = db._collection("UnitTestsRecoveryRenamed" + (numCollections - 1));
+  for (j = numDocuments; j < numDocuments + 1000; ++j) {
+    c.save({ _key: "test" + j, value: j });
+  }
+
+  db._collection("UnitTestsRecovery0").save({ _key: "crashme" }, true);
+
+  internal.debugSegfault("crashing server");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function recoverySuite () {
+  'use strict';
+  jsunity.jsUnity.attachAssertions();
+
+  return {
+    setUp: function () {
+    },
+    tearDown: function () {
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test whether the operations of all collections were replayed
+////////////////////////////////////////////////////////////////////////////////
+    
+    testManyCollections : function () {
+      var i, j, c, doc, expected;
+
+      for (i = 0; i < numCollections; ++i) {
+        if (i === numCollections - 1) {
+          assertEqual(null, db._collection("UnitTestsRecovery" + i));
+          c = db._collection("UnitTestsRecoveryRenamed" + i);
+          expected = numDocuments - numDocuments / 5 + 1000;
+        }
+        else {
+          c = db._collection("UnitTestsRecovery" + i);
+          expected = numDocuments - numDocuments / 5 + (i === 0 ? 1 : 0);
+        }
+
+        assertEqual(expected, c.count());
+
+        for (j = 0; j < numDocuments; ++j) {
+          if (j % 5 === 1) {
+            assertFalse(c.exists("test" + j));
+            continue;
+          }
+
+          doc = c.document("test" + j);
+          assertEqual(j, doc.value);
+          assertEqual(i, doc.collection);
+          assertEqual(j % 5 === 0, doc.updated === true);
+        }
+      }
+
+      c = db._collection("UnitTestsRecovery0");
+      assertEqual(2, c.getIndexes().length);
+      assertEqual(1, c.byExample({ value: 10 }).toArray().length);
+      assertTrue(c.exists("crashme"));
+
+      c = db._collection("UnitTestsRecoveryEdges");
+      assertEqual(numDocuments / 10 - 1, c.count());
+      assertEqual(1, c.outEdges("UnitTestsRecovery0/test10").length);
+      assertEqual(1, c.inEdges("UnitTestsRecovery1/test9").length);
+    }
+        
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+function main (argv) {
+  'use strict';
+  if (argv[1] === "setup") {
+    runSetup();
+    return 0;
+  }
+  else {
+    jsunity.run(recoverySuite);
+    return jsunity.done().status ? 0 : 1;
+  }
+}
+
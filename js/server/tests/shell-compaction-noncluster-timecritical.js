@@ -515,6 +515,9 @@ function CompactionSuite () {
       assertEqual(0, fig["dead"]["count"]);
       assertEqual(0, fig["dead"]["size"]);
       assertEqual(0, fig["dead"]["deletion"]);
+      assertEqual(0, fig["compaction"]["backlogSize"]);
+      assertTrue(0 < fig["compaction"]["runs"]);
+      assertTrue(0 < fig["compaction"]["bytesRead"]);
 
       internal.db._drop(cn);
     },
@@ -573,6 +576,9 @@ function CompactionSuite () {
       assertEqual(n, fig["dead"]["deletion"]);
       assertEqual(0, fig["journals"]["count"]);
       assertTrue(0 < fig["datafiles"]["count"]);
+      assertTrue(0 < fig["compaction"]["backlogCount"]);
+      assertTrue(0 < fig["compaction"]["backlogSize"]);
+      assertEqual(0, fig["compaction"]["runs"]);
       
       // wait for compactor to run
       require("console").log("waiting for compactor to run");
@@ -0,0 +1,143 @@
+/*jshint globalstrict:false, strict:false */
+/*global assertTrue, assertEqual */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test writes while the compaction is throttled
+///
+/// these tests are meant to be run with a very low
+/// --database.compactor-max-rate, so the compactor pauses for a long time
+/// after its first run
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2015 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2015, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var testHelper = require("org/arangodb/test-helper").Helper;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                        compaction
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite: throttled compaction
+////////////////////////////////////////////////////////////////////////////////
+
+function CompactionThrottleSuite () {
+  'use strict';
+  var cn = "UnitTestsCompactionThrottle";
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      internal.db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      internal.db._drop(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief writes and collection of the WAL continue while the compactor
+/// waits for the rate limit
+////////////////////////////////////////////////////////////////////////////////
+
+    testWritesWhileThrottled : function () {
+      var c = internal.db._create(cn, { journalSize: 1048576 });
+      var i, end, start, fig;
+
+      // create a few datafiles full of dead documents
+      for (i = 0; i < 20000; ++i) {
+        c.save({ _key: "test" + i, value: "thequickbrownfoxjumpsoverthelazydog" + i });
+      }
+      for (i = 0; i < 20000; ++i) {
+        if (i % 10 !== 0) {
+          c.remove("test" + i);
+        }
+      }
+      testHelper.rotate(c);
+
+      // wait until the compactor has compacted the collection once. this
+      // exceeds the rate limit by far, so the compactor pauses afterwards
+      end = internal.time() + 30;
+      while (internal.time() < end) {
+        fig = c.figures();
+        if (fig.compaction.runs > 0) {
+          break;
+        }
+        internal.wait(0.5, false);
+      }
+
+      assertTrue(c.figures().compaction.runs > 0);
+
+      // modify the collection and have the WAL collected into it. both need
+      // the collection's compaction lock
+      start = internal.time();
+
+      for (i = 0; i < 1000; ++i) {
+        c.save({ _key: "new" + i, value: i });
+      }
+      for (i = 0; i < 1000; i += 2) {
+        c.update("new" + i, { value: -i });
+      }
+      internal.wal.flush(true, true);
+
+      assertTrue(internal.time() - start < 15);
+
+      assertEqual(3000, c.count());
+      assertEqual(-10, c.document("new10").value);
+      assertEqual(11, c.document("new11").value);
+    }
+
+  };
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                              main
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suite
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(CompactionThrottleSuite);
+
+return jsunity.done();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @\\}\\)"
+// End:
@@ -0,0 +1,453 @@
+/*jshint globalstrict:false, strict:false, maxlen : 200 */
+/*global fail, assertTrue, assertFalse, assertEqual, assertNotEqual */
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tests for single-document operations with document-level locking
+///
+/// these tests are meant to be run with --database.document-level-locking true
+///
+/// @file
+///
+/// DISCLAIMER
+///
+/// Copyright 2010-2015 triagens GmbH, Cologne, Germany
+///
+/// Licensed under the Apache License, Version 2.0 (the "License");
+/// you may not use this file except in compliance with the License.
+/// You may obtain a copy of the License at
+///
+///     http://www.apache.org/licenses/LICENSE-2.0
+///
+/// Unless required by applicable law or agreed to in writing, software
+/// distributed under the License is distributed on an "AS IS" BASIS,
+/// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+/// See the License for the specific language governing permissions and
+/// limitations under the License.
+///
+/// Copyright holder is triAGENS GmbH, Cologne, Germany
+///
+/// @author Jan Steemann
+/// @author Copyright 2015, triAGENS GmbH, Cologne, Germany
+////////////////////////////////////////////////////////////////////////////////
+
+var jsunity = require("jsunity");
+var internal = require("internal");
+var arangodb = require("org/arangodb");
+var db = arangodb.db;
+var ERRORS = arangodb.errors;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 document operations
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite: single-document operations
+////////////////////////////////////////////////////////////////////////////////
+
+function documentLevelLockingSuite () {
+  'use strict';
+  var cn = "UnitTestsDocumentLevelLocking";
+  var c = null;
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      db._drop(cn);
+      c = db._create(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      db._drop(cn);
+      c = null;
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: insert, update, replace and remove
+////////////////////////////////////////////////////////////////////////////////
+
+    testCrud : function () {
+      var i, doc;
+
+      for (i = 0; i < 1000; ++i) {
+        c.save({ _key: "test" + i, value: i });
+      }
+      assertEqual(1000, c.count());
+
+      for (i = 0; i < 1000; i += 2) {
+        c.update("test" + i, { value: i + 1, updated: true });
+      }
+      for (i = 1; i < 1000; i += 2) {
+        c.replace("test" + i, { value: i - 1 });
+      }
+
+      for (i = 0; i < 1000; ++i) {
+        doc = c.document("test" + i);
+        if (i % 2 === 0) {
+          assertEqual(i + 1, doc.value);
+          assertTrue(doc.updated);
+        }
+        else {
+          assertEqual(i - 1, doc.value);
+          assertFalse(doc.hasOwnProperty("updated"));
+        }
+      }
+
+      for (i = 0; i < 1000; i += 3) {
+        c.remove("test" + i);
+      }
+      assertEqual(666, c.count());
+
+      for (i = 0; i < 1000; ++i) {
+        assertEqual(i % 3 !== 0, c.exists("test" + i) !== false);
+      }
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: unique constraint violation on insert
+////////////////////////////////////////////////////////////////////////////////
+
+    testInsertDuplicate : function () {
+      c.save({ _key: "test", value: 1 });
+
+      try {
+        c.save({ _key: "test", value: 2 });
+        fail();
+      }
+      catch (err) {
+        assertEqual(ERRORS.ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED.code, err.errorNum);
+      }
+
+      assertEqual(1, c.count());
+      assertEqual(1, c.document("test").value);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: revision conflicts and missing documents
+////////////////////////////////////////////////////////////////////////////////
+
+    testConflicts : function () {
+      var doc1 = c.save({ _key: "test", value: 1 });
+      var doc2 = c.update("test", { value: 2 });
+
+      assertNotEqual(doc1._rev, doc2._rev);
+
+      try {
+        c.update(doc1, { value: 3 });
+        fail();
+      }
+      catch (err1) {
+        assertEqual(ERRORS.ERROR_ARANGO_CONFLICT.code, err1.errorNum);
+      }
+
+      try {
+        c.remove(doc1);
+        fail();
+      }
+      catch (err2) {
+        assertEqual(ERRORS.ERROR_ARANGO_CONFLICT.code, err2.errorNum);
+      }
+
+      assertEqual(2, c.document("test").value);
+      assertEqual(doc2._rev, c.document("test")._rev);
+
+      c.remove(doc2);
+
+      try {
+        c.update("test", { value: 4 });
+        fail();
+      }
+      catch (err3) {
+        assertEqual(ERRORS.ERROR_ARANGO_DOCUMENT_NOT_FOUND.code, err3.errorNum);
+      }
+
+      try {
+        c.remove("test");
+        fail();
+      }
+      catch (err4) {
+        assertEqual(ERRORS.ERROR_ARANGO_DOCUMENT_NOT_FOUND.code, err4.errorNum);
+      }
+
+      assertEqual(0, c.count());
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: collection with a secondary index uses the collection lock
+////////////////////////////////////////////////////////////////////////////////
+
+    testSecondaryIndex : function () {
+      var i;
+
+      c.ensureUniqueConstraint("value");
+
+      for (i = 0; i < 100; ++i) {
+        c.save({ _key: "test" + i, value: i });
+      }
+
+      try {
+        c.update("test0", { value: 1 });
+        fail();
+      }
+      catch (err) {
+        assertEqual(ERRORS.ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED.code, err.errorNum);
+      }
+
+      assertEqual(0, c.document("test0").value);
+      assertEqual(1, c.byExample({ value: 1 }).toArray().length);
+
+      for (i = 0; i < 100; ++i) {
+        c.remove("test" + i);
+      }
+      assertEqual(0, c.count());
+      assertEqual(0, c.byExample({ value: 1 }).toArray().length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: edges
+////////////////////////////////////////////////////////////////////////////////
+
+    testEdges : function () {
+      var i;
+
+      db._drop(cn);
+      c = db._createEdgeCollection(cn);
+
+      for (i = 0; i < 100; ++i) {
+        c.save("UnitTestsVertices/v" + i, "UnitTestsVertices/v" + (i % 10), { _key: "test" + i, value: i });
+      }
+
+      assertEqual(10, c.inEdges("UnitTestsVertices/v0").length);
+
+      for (i = 0; i < 100; ++i) {
+        c.update("test" + i, { value: i + 1 });
+      }
+
+      for (i = 0; i < 100; ++i) {
+        assertEqual(1, c.outEdges("UnitTestsVertices/v" + i).length);
+        assertEqual(i + 1, c.outEdges("UnitTestsVertices/v" + i)[0].value);
+      }
+
+      for (i = 0; i < 100; i += 10) {
+        c.remove("test" + i);
+      }
+
+      assertEqual(90, c.count());
+      assertEqual(0, c.inEdges("UnitTestsVertices/v0").length);
+      assertEqual(10, c.inEdges("UnitTestsVertices/v1").length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: operations inside a transaction use the collection lock
+////////////////////////////////////////////////////////////////////////////////
+
+    testTransactionRollback : function () {
+      var i;
+
+      for (i = 0; i < 10; ++i) {
+        c.save({ _key: "test" + i, value: i });
+      }
+
+      try {
+        db._executeTransaction({
+          collections: { write: cn },
+          action: function () {
+            var i;
+            for (i = 0; i < 10; ++i) {
+              c.update("test" + i, { value: -1 });
+            }
+            c.remove("test0");
+            throw "rollback!";
+          }
+        });
+        fail();
+      }
+      catch (err) {
+      }
+
+      assertEqual(10, c.count());
+      for (i = 0; i < 10; ++i) {
+        assertEqual(i, c.document("test" + i).value);
+      }
+    }
+
+  };
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                          failures
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test suite: index failures during single-document operations
+////////////////////////////////////////////////////////////////////////////////
+
+function documentLevelLockingFailuresSuite () {
+  'use strict';
+  var cn = "UnitTestsDocumentLevelLocking";
+  var c = null;
+
+  return {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set up
+////////////////////////////////////////////////////////////////////////////////
+
+    setUp : function () {
+      internal.debugClearFailAt();
+      db._drop(cn);
+      c = db._createEdgeCollection(cn);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tear down
+////////////////////////////////////////////////////////////////////////////////
+
+    tearDown : function () {
+      internal.debugClearFailAt();
+      db._drop(cn);
+      c = null;
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: failed update does not modify the document
+////////////////////////////////////////////////////////////////////////////////
+
+    testUpdateIndexFailures : function () {
+      var failures = [ "InsertSecondaryIndexes", "DeleteSecondaryIndexes" ];
+      var doc = c.save("UnitTestsVertices/a", "UnitTestsVertices/b", { _key: "test", value: 1 });
+
+      failures.forEach(function (f) {
+        internal.debugSetFailAt(f);
+
+        try {
+          c.update("test", { value: 2 });
+          fail();
+        }
+        catch (err1) {
+          assertEqual(ERRORS.ERROR_DEBUG.code, err1.errorNum);
+        }
+
+        try {
+          c.replace("test", { _from: "UnitTestsVertices/a", _to: "UnitTestsVertices/b", value: 3 });
+          fail();
+        }
+        catch (err2) {
+          assertEqual(ERRORS.ERROR_DEBUG.code, err2.errorNum);
+        }
+
+        internal.debugClearFailAt();
+
+        assertEqual(1, c.count());
+        assertEqual(1, c.document("test").value);
+        assertEqual(doc._rev, c.document("test")._rev);
+        assertEqual(1, c.outEdges("UnitTestsVertices/a").length);
+        assertEqual(1, c.inEdges("UnitTestsVertices/b").length);
+      });
+
+      c.update("test", { value: 4 });
+      assertEqual(4, c.document("test").value);
+      assertEqual(4, c.outEdges("UnitTestsVertices/a")[0].value);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: failed remove keeps the document
+////////////////////////////////////////////////////////////////////////////////
+
+    testRemoveIndexFailures : function () {
+      var failures = [ "DeleteSecondaryIndexes", "DeletePrimaryIndex" ];
+      var doc = c.save("UnitTestsVertices/a", "UnitTestsVertices/b", { _key: "test", value: 1 });
+
+      failures.forEach(function (f) {
+        internal.debugSetFailAt(f);
+
+        try {
+          c.remove("test");
+          fail();
+        }
+        catch (err) {
+          assertEqual(ERRORS.ERROR_DEBUG.code, err.errorNum);
+        }
+
+        internal.debugClearFailAt();
+
+        assertEqual(1, c.count());
+        assertEqual(1, c.document("test").value);
+        assertEqual(doc._rev, c.document("test")._rev);
+        assertEqual(1, c.outEdges("UnitTestsVertices/a").length);
+      });
+
+      c.remove("test");
+      assertEqual(0, c.count());
+      assertEqual(0, c.outEdges("UnitTestsVertices/a").length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: failed WAL write leaves the indexes untouched
+////////////////////////////////////////////////////////////////////////////////
+
+    testWalFailures : function () {
+      var doc = c.save("UnitTestsVertices/a", "UnitTestsVertices/b", { _key: "test", value: 1 });
+
+      internal.debugSetFailAt("TransactionOperationNoSlot");
+
+      try {
+        c.update("test", { value: 2 });
+        fail();
+      }
+      catch (err1) {
+        assertEqual(ERRORS.ERROR_DEBUG.code, err1.errorNum);
+      }
+
+      try {
+        c.remove("test");
+        fail();
+      }
+      catch (err2) {
+        assertEqual(ERRORS.ERROR_DEBUG.code, err2.errorNum);
+      }
+
+      internal.debugClearFailAt();
+
+      assertEqual(1, c.count());
+      assertEqual(doc._rev, c.document("test")._rev);
+      assertEqual(1, c.document("test").value);
+      assertEqual(1, c.inEdges("UnitTestsVertices/b").length);
+      assertEqual(1, c.inEdges("UnitTestsVertices/b")[0].value);
+    }
+
+  };
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                              main
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief executes the test suites
+////////////////////////////////////////////////////////////////////////////////
+
+jsunity.run(documentLevelLockingSuite);
+
+// only run this test suite if server-side failures are enabled
+if (internal.debugCanUseFailAt()) {
+  jsunity.run(documentLevelLockingFailuresSuite);
+}
+
+return jsunity.done();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                       END-OF-FILE
+// -----------------------------------------------------------------------------
+
+// Local Variables:
+// mode: outline-minor
+// outline-regexp: "\\(/// @brief\\|/// @addtogroup\\|// --SECTION--\\|/// @page\\|/// @\\}\\)"
+// End:
@@ -1,5 +1,5 @@
 /*jshint globalstrict:false, strict:false */
-/*global fail, assertEqual, assertNotEqual  */
+/*global fail, assertEqual, assertNotEqual, assertTrue  */
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test the skip-list index
@@ -696,6 +696,107 @@ function SkipListSuite() {
       assertEqual(0, result.length);
       result = collection.byConditionSkiplist(idx.id, { value: [[">", null], ["<=", true ]] }).toArray();
       assertEqual(1, result.length);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: selectivity estimate of a unique skiplist
+////////////////////////////////////////////////////////////////////////////////
+
+    testSelectivityEstimateUnique : function () {
+      var i;
+
+      var idx = collection.ensureUniqueSkiplist("value");
+      for (i = 0; i < 1000; ++i) {
+        collection.save({ _key: "test" + i, value: i });
+      }
+
+      idx = collection.ensureUniqueSkiplist("value");
+      assertEqual(1, idx.selectivityEstimate);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: selectivity estimate of a non-unique skiplist
+////////////////////////////////////////////////////////////////////////////////
+
+    testSelectivityEstimateNonUnique : function () {
+      var i;
+
+      var idx = collection.ensureSkiplist("value");
+      for (i = 0; i < 1000; ++i) {
+        collection.save({ value: i });
+      }
+
+      idx = collection.ensureSkiplist("value");
+      assertTrue(idx.selectivityEstimate >= 0.95 && idx.selectivityEstimate <= 1);
+
+      var keys = [ ];
+      for (i = 0; i < 1000; ++i) {
+        keys.push(collection.save({ value: i })._key);
+      }
+
+      // the distinct values are counted on every modification
+      idx = collection.ensureSkiplist("value");
+      assertEqual(0.5, idx.selectivityEstimate);
+
+      for (i = 0; i < 500; ++i) {
+        collection.remove(keys[i]);
+      }
+
+      idx = collection.ensureSkiplist("value");
+      assertEqual(1000 / 1500, idx.selectivityEstimate);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: selectivity estimate of a skiplist built on collection load
+////////////////////////////////////////////////////////////////////////////////
+
+    testSelectivityEstimateAfterLoad : function () {
+      var i;
+
+      for (i = 0; i < 1000; ++i) {
+        collection.save({ value: i % 10 });
+      }
+      var idx = collection.ensureSkiplist("value");
+      assertEqual(0.01, idx.selectivityEstimate);
+      
+      collection.unload();
+      collection = null;
+      internal.wait(2);
+      collection = internal.db._collection(cn);
+
+      idx = collection.ensureSkiplist("value");
+      assertEqual(0.01, idx.selectivityEstimate);
+    },
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test: the optimizer uses the statistics to pick the more selective
+/// skiplist
+////////////////////////////////////////////////////////////////////////////////
+
+    testStatisticsPickSelectiveIndex : function () {
+      var i;
+
+      for (i = 0; i < 1000; ++i) {
+        collection.save({ a: i % 2, b: i });
+      }
+      collection.ensureSkiplist("a");
+      collection.ensureSkiplist("b");
+
+      var query = "FOR doc IN " + cn + " FILTER doc.a == 1 && doc.b == 17 RETURN doc";
+      var nodes = internal.db._createStatement(query).explain().plan.nodes.filter(function (node) {
+        return node.type === "IndexRangeNode";
+      });
+
+      assertEqual(1, nodes.length);
+      assertEqual([ "b" ], nodes[0].index.fields);
+
+      query = "FOR doc IN " + cn + " FILTER doc.a == 1 && doc.b >= 0 RETURN doc";
+      nodes = internal.db._createStatement(query).explain().plan.nodes.filter(function (node) {
+        return node.type === "IndexRangeNode";
+      });
+
+      assertEqual(1, nodes.length);
+      assertEqual([ "a" ], nodes[0].index.fields);
     }
 
   };
@@ -274,6 +274,33 @@ function walSuite () {
       assertEqual(p.throttleWhenPending, result2.throttleWhenPending);
     },
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief test setting a commit window greater than the sync interval
+////////////////////////////////////////////////////////////////////////////////
+
+    testSetSyncCommitWindowTooBig : function () {
+      var initial = internal.wal.properties();
+
+      try {
+        internal.wal.properties({ 
+          syncCommitWindow: initial.syncInterval * 1000 + 1, 
+          throttleWait: initial.throttleWait + 1
+        });
+        fail();
+      }
+      catch (err) {
+        assertEqual(arangodb.errors.ERROR_BAD_PARAMETER.code, err.errorNum);
+      }
+
+      // nothing was changed
+      var result = internal.wal.properties();
+      assertEqual(initial.syncCommitWindow, result.syncCommitWindow);
+      assertEqual(initial.throttleWait, result.throttleWait);
+
+      result = internal.wal.properties({ syncCommitWindow: initial.syncInterval * 1000 });
+      assertEqual(initial.syncInterval * 1000, result.syncCommitWindow);
+    },
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief test max tick
 ////////////////////////////////////////////////////////////////////////////////
@@ -229,6 +229,234 @@ std::string JsonHelper::toString (TRI_json_t const* json) {
   return out;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append an unsigned integer in variable-length encoding
+////////////////////////////////////////////////////////////////////////////////
+
+void JsonHelper::appendBinaryLength (StringBuffer& buffer,
+                                     uint64_t value) {
+  while (value >= 0x80) {
+    buffer.appendChar(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.appendChar(static_cast<char>(value));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read an unsigned integer in variable-length encoding
+////////////////////////////////////////////////////////////////////////////////
+
+bool JsonHelper::readBinaryLength (char const*& position,
+                                   char const* end,
+                                   uint64_t& value) {
+  value = 0;
+
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (position >= end) {
+      return false;
+    }
+
+    uint8_t c = static_cast<uint8_t>(*position++);
+    value |= static_cast<uint64_t>(c & 0x7f) << shift;
+
+    if ((c & 0x80) == 0) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief serialize json into the binary representation
+///
+/// each value starts with its TRI_json_type_e as a single byte. numbers are
+/// stored as 8 bytes little endian, strings (and object keys) as length,
+/// bytes and a terminating NUL byte, arrays and objects as number of
+/// members followed by the members
+////////////////////////////////////////////////////////////////////////////////
+
+void JsonHelper::toBinary (TRI_json_t const* json,
+                           StringBuffer& buffer) {
+  if (json == nullptr) {
+    buffer.appendChar(static_cast<char>(TRI_JSON_NULL));
+    return;
+  }
+
+  switch (json->_type) {
+    case TRI_JSON_UNUSED:
+    case TRI_JSON_NULL: {
+      buffer.appendChar(static_cast<char>(TRI_JSON_NULL));
+      break;
+    }
+
+    case TRI_JSON_BOOLEAN: {
+      buffer.appendChar(static_cast<char>(TRI_JSON_BOOLEAN));
+      buffer.appendChar(json->_value._boolean ? 1 : 0);
+      break;
+    }
+
+    case TRI_JSON_NUMBER: {
+      uint64_t bits;
+      memcpy(&bits, &json->_value._number, sizeof(bits));
+
+      char data[sizeof(bits)];
+      for (size_t i = 0; i < sizeof(bits); ++i) {
+        data[i] = static_cast<char>(bits & 0xff);
+        bits >>= 8;
+      }
+
+      buffer.appendChar(static_cast<char>(TRI_JSON_NUMBER));
+      buffer.appendText(data, sizeof(data));
+      break;
+    }
+
+    case TRI_JSON_STRING:
+    case TRI_JSON_STRING_REFERENCE: {
+      // _string.length includes the NUL byte
+      buffer.appendChar(static_cast<char>(TRI_JSON_STRING));
+      appendBinaryLength(buffer, json->_value._string.length - 1);
+      buffer.appendText(json->_value._string.data, json->_value._string.length);
+      break;
+    }
+
+    case TRI_JSON_ARRAY:
+    case TRI_JSON_OBJECT: {
+      size_t const n = json->_value._objects._length;
+
+      buffer.appendChar(static_cast<char>(json->_type));
+      appendBinaryLength(buffer, n);
+
+      for (size_t i = 0; i < n; ++i) {
+        toBinary(static_cast<TRI_json_t const*>(TRI_AtVector(&json->_value._objects, i)), buffer);
+      }
+      break;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief decode a binary json value into an uninitialised TRI_json_t
+////////////////////////////////////////////////////////////////////////////////
+
+static bool DecodeBinary (TRI_memory_zone_t* zone,
+                          TRI_json_t* result,
+                          char const*& position,
+                          char const* end) {
+  if (position >= end) {
+    return false;
+  }
+
+  uint64_t length;
+
+  switch (static_cast<TRI_json_type_e>(*position++)) {
+    case TRI_JSON_NULL: {
+      TRI_InitNullJson(result);
+      return true;
+    }
+
+    case TRI_JSON_BOOLEAN: {
+      if (position >= end) {
+        return false;
+      }
+      TRI_InitBooleanJson(result, *position++ != 0);
+      return true;
+    }
+
+    case TRI_JSON_NUMBER: {
+      if (end - position < static_cast<ptrdiff_t>(sizeof(uint64_t))) {
+        return false;
+      }
+
+      uint64_t bits = 0;
+      for (size_t i = 0; i < sizeof(bits); ++i) {
+        bits |= static_cast<uint64_t>(static_cast<uint8_t>(position[i])) << (8 * i);
+      }
+      position += sizeof(bits);
+
+      double value;
+      memcpy(&value, &bits, sizeof(value));
+      TRI_InitNumberJson(result, value);
+      return true;
+    }
+
+    case TRI_JSON_STRING: {
+      if (! JsonHelper::readBinaryLength(position, end, length) ||
+          static_cast<uint64_t>(end - position) <= length) {
+        return false;
+      }
+
+      if (TRI_InitStringCopyJson(zone, result, position, static_cast<size_t>(length)) != TRI_ERROR_NO_ERROR) {
+        return false;
+      }
+      position += length + 1;
+      return true;
+    }
+
+    case TRI_JSON_ARRAY:
+    case TRI_JSON_OBJECT: {
+      bool const isObject = (position[-1] == static_cast<char>(TRI_JSON_OBJECT));
+
+      if (! JsonHelper::readBinaryLength(position, end, length) ||
+          static_cast<uint64_t>(end - position) < length) {
+        // every member takes at least one byte
+        return false;
+      }
+
+      if (isObject) {
+        if (length % 2 != 0) {
+          return false;
+        }
+        TRI_InitObjectJson(zone, result, static_cast<size_t>(length / 2));
+      }
+      else {
+        TRI_InitArrayJson(zone, result, static_cast<size_t>(length));
+      }
+
+      for (uint64_t i = 0; i < length; ++i) {
+        TRI_json_t member;
+
+        if (! DecodeBinary(zone, &member, position, end)) {
+          TRI_DestroyJson(zone, result);
+          return false;
+        }
+
+        if ((isObject && i % 2 == 0 && member._type != TRI_JSON_STRING) ||
+            TRI_PushBackVector(&result->_value._objects, &member) != TRI_ERROR_NO_ERROR) {
+          TRI_DestroyJson(zone, &member);
+          TRI_DestroyJson(zone, result);
+          return false;
+        }
+      }
+      return true;
+    }
+
+    default: {
+      return false;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create JSON from the binary representation
+////////////////////////////////////////////////////////////////////////////////
+
+TRI_json_t* JsonHelper::fromBinary (char const*& position,
+                                    char const* end) {
+  TRI_json_t* json = static_cast<TRI_json_t*>(TRI_Allocate(TRI_UNKNOWN_MEM_ZONE, sizeof(TRI_json_t), false));
+
+  if (json == nullptr) {
+    return nullptr;
+  }
+
+  if (! DecodeBinary(TRI_UNKNOWN_MEM_ZONE, json, position, end)) {
+    TRI_Free(TRI_UNKNOWN_MEM_ZONE, json);
+    return nullptr;
+  }
+
+  return json;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns an object sub-element
 ////////////////////////////////////////////////////////////////////////////////
@@ -130,6 +130,42 @@ namespace triagens {
 
         static std::string toString (TRI_json_t const*);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief serialize json into a compact binary representation
+///
+/// the binary representation avoids the number and string conversions of
+/// the text format. it is meant for transferring values between servers,
+/// not for storage
+////////////////////////////////////////////////////////////////////////////////
+
+        static void toBinary (TRI_json_t const*,
+                              triagens::basics::StringBuffer&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief create JSON from its binary representation
+///
+/// the position is advanced behind the value. returns a nullptr if the input
+/// is malformed or truncated
+////////////////////////////////////////////////////////////////////////////////
+
+        static TRI_json_t* fromBinary (char const*&,
+                                       char const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief append an unsigned integer in variable-length encoding
+////////////////////////////////////////////////////////////////////////////////
+
+        static void appendBinaryLength (triagens::basics::StringBuffer&,
+                                        uint64_t);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief read an unsigned integer in variable-length encoding
+////////////////////////////////////////////////////////////////////////////////
+
+        static bool readBinaryLength (char const*&,
+                                      char const*,
+                                      uint64_t&);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief returns true for objects
 ////////////////////////////////////////////////////////////////////////////////
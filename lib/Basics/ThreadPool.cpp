@@ -28,10 +28,83 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "ThreadPool.h"
+#include "Basics/Exceptions.h"
 #include "Basics/WorkerThread.h"
 
 using namespace triagens::basics;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief shared state of a parallelFor call. helper tasks may be dequeued
+/// after the call has returned, so they keep the state alive on their own
+////////////////////////////////////////////////////////////////////////////////
+
+  struct ParallelForState {
+    ParallelForState (size_t n,
+                      std::function<int(size_t)> const& fn)
+      : fn(fn),
+        n(n),
+        next(0),
+        pending(n),
+        result(TRI_ERROR_NO_ERROR),
+        condition() {
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief process partitions until none are left
+////////////////////////////////////////////////////////////////////////////////
+
+    void work () {
+      while (true) {
+        size_t const i = next.fetch_add(1);
+
+        if (i >= n) {
+          return;
+        }
+
+        int res;
+
+        try {
+          res = fn(i);
+        }
+        catch (triagens::basics::Exception const& ex) {
+          res = ex.code();
+        }
+        catch (std::bad_alloc const&) {
+          res = TRI_ERROR_OUT_OF_MEMORY;
+        }
+        catch (...) {
+          res = TRI_ERROR_INTERNAL;
+        }
+
+        if (res != TRI_ERROR_NO_ERROR) {
+          int expected = TRI_ERROR_NO_ERROR;
+          result.compare_exchange_strong(expected, res);
+        }
+
+        if (pending.fetch_sub(1) == 1) {
+          // last partition done
+          CONDITION_LOCKER(guard, condition);
+          guard.signal();
+        }
+      }
+    }
+
+    std::function<int(size_t)> const fn;
+    size_t const                     n;
+    std::atomic<size_t>              next;
+    std::atomic<size_t>              pending;
+    std::atomic<int>                 result;
+    ConditionVariable                condition;
+  };
+
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                        ThreadPool
 // -----------------------------------------------------------------------------
@@ -113,6 +186,47 @@ bool ThreadPool::dequeue (std::function<void()>& result) {
   return false;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief call a function for each of the partitions 0 .. n - 1
+////////////////////////////////////////////////////////////////////////////////
+
+int ThreadPool::parallelFor (size_t n,
+                             std::function<int(size_t)> const& fn) {
+  if (n == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  auto state = std::make_shared<ParallelForState>(n, fn);
+
+  // the calling thread is one of the workers
+  size_t const helpers = (std::min)(n - 1, _threads.size());
+
+  for (size_t i = 0; i < helpers; ++i) {
+    try {
+      enqueue([state] () -> void {
+        state->work();
+      });
+    }
+    catch (...) {
+      // not an error. the calling thread will do the work
+      break;
+    }
+  }
+
+  state->work();
+
+  // all partitions have been claimed now. wait for the ones still running
+  {
+    CONDITION_LOCKER(guard, state->condition);
+
+    while (state->pending.load() > 0) {
+      guard.wait();
+    }
+  }
+
+  return state->result.load();
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
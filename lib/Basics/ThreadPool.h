@@ -75,6 +75,14 @@ namespace triagens {
           return _name.c_str();
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the number of worker threads
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t size () const {
+          return _threads.size();
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief dequeue a task
 ////////////////////////////////////////////////////////////////////////////////
@@ -95,6 +103,18 @@ namespace triagens {
           _condition.signal();
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief call a function for each of the partitions 0 .. n - 1 and wait
+/// until all calls have finished. idle worker threads help processing the
+/// partitions, but the calling thread processes partitions itself until
+/// none are left. it thus never waits for a partition nobody has started,
+/// and can safely be called from within a task of the same pool. returns
+/// the first error reported by any of the calls
+////////////////////////////////////////////////////////////////////////////////
+
+        int parallelFor (size_t,
+                         std::function<int(size_t)> const&);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -1510,6 +1510,305 @@ size_t TRI_GetLengthAssociativeSynced (TRI_associative_synced_t* const array) {
   return (size_t) result;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                              ASSOCIATIVE LOCKFREE
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief creates an empty table with the given number of slots
+///
+/// the slots are placed directly behind the table header. the memory is
+/// cleared by allocate, which leaves all slots empty
+////////////////////////////////////////////////////////////////////////////////
+
+static TRI_associative_lockfree_table_t* CreateTableLockFree (TRI_memory_zone_t* zone,
+                                                              uint64_t nrAlloc) {
+  size_t const size = sizeof(TRI_associative_lockfree_table_t) +
+                      static_cast<size_t>(nrAlloc) * sizeof(std::atomic<void*>);
+
+  TRI_associative_lockfree_table_t* table = static_cast<TRI_associative_lockfree_table_t*>(TRI_Allocate(zone, size, true));
+
+  if (table == nullptr) {
+    return nullptr;
+  }
+
+  table->_nrAlloc  = nrAlloc;
+  table->_previous = nullptr;
+  table->_slots    = reinterpret_cast<std::atomic<void*>*>(table + 1);
+
+  return table;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief resizes the array
+///
+/// the old table is not modified. the new table is filled completely before
+/// it is published, so a reader sees either the old or the new table with all
+/// elements that were present when the resize started. the old table is kept
+/// until the array is destroyed because readers may still be probing it.
+///
+/// Note: this function must be called while the mutex is held
+////////////////////////////////////////////////////////////////////////////////
+
+static void ResizeAssociativeLockFree (TRI_associative_lockfree_t* array,
+                                       uint64_t targetSize) {
+  TRI_associative_lockfree_table_t* oldTable = array->_table.load(std::memory_order_relaxed);
+  TRI_associative_lockfree_table_t* newTable = CreateTableLockFree(array->_memoryZone, targetSize);
+
+  if (newTable == nullptr) {
+    return;
+  }
+
+  for (uint64_t j = 0; j < oldTable->_nrAlloc; ++j) {
+    void* element = oldTable->_slots[j].load(std::memory_order_relaxed);
+
+    if (element != nullptr) {
+      uint64_t i = array->hashElement(array, element) % newTable->_nrAlloc;
+
+      while (newTable->_slots[i].load(std::memory_order_relaxed) != nullptr) {
+        i = TRI_IncModU64(i, newTable->_nrAlloc);
+      }
+
+      newTable->_slots[i].store(element, std::memory_order_relaxed);
+    }
+  }
+
+  newTable->_previous = oldTable;
+
+  // publish the filled table
+  array->_table.store(newTable, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief stores an element in the slot found for it
+///
+/// Note: this function must be called while the mutex is held
+////////////////////////////////////////////////////////////////////////////////
+
+static void* StoreElementLockFree (TRI_associative_lockfree_t* array,
+                                   TRI_associative_lockfree_table_t* table,
+                                   uint64_t i,
+                                   void* element,
+                                   bool overwrite) {
+  void* old = table->_slots[i].load(std::memory_order_relaxed);
+
+  // if we found an element, return
+  if (old != nullptr) {
+    if (overwrite) {
+      table->_slots[i].store(element, std::memory_order_release);
+    }
+    return old;
+  }
+
+  // add a new element to the associative array
+  table->_slots[i].store(element, std::memory_order_release);
+  array->_nrUsed++;
+
+  // if we were adding and the table is more than half full, extend it
+  if (table->_nrAlloc < 2 * array->_nrUsed) {
+    ResizeAssociativeLockFree(array, 2 * table->_nrAlloc + 1);
+  }
+
+  return nullptr;
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                      constructors and destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initialises an array
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_InitAssociativeLockFree (TRI_associative_lockfree_t* array,
+                                 TRI_memory_zone_t* zone,
+                                 uint64_t (*hashKey) (TRI_associative_lockfree_t*, void const*),
+                                 uint64_t (*hashElement) (TRI_associative_lockfree_t*, void const*),
+                                 bool (*isEqualKeyElement) (TRI_associative_lockfree_t*, void const*, void const*),
+                                 bool (*isEqualElementElement) (TRI_associative_lockfree_t*, void const*, void const*)) {
+  array->hashKey = hashKey;
+  array->hashElement = hashElement;
+  array->isEqualKeyElement = isEqualKeyElement;
+  array->isEqualElementElement = isEqualElementElement;
+
+  array->_memoryZone = zone;
+  array->_nrUsed  = 0;
+
+  TRI_associative_lockfree_table_t* table = CreateTableLockFree(zone, INITIAL_SIZE);
+
+  if (table == nullptr) {
+    array->_table.store(nullptr);
+    return TRI_ERROR_OUT_OF_MEMORY;
+  }
+
+  array->_table.store(table, std::memory_order_release);
+
+  TRI_InitMutex(&array->_lock);
+
+  return TRI_ERROR_NO_ERROR;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroys an array, but does not free the pointer
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_DestroyAssociativeLockFree (TRI_associative_lockfree_t* array) {
+  TRI_associative_lockfree_table_t* table = array->_table.load();
+
+  // free the current table and all tables it has replaced
+  while (table != nullptr) {
+    TRI_associative_lockfree_table_t* previous = table->_previous;
+    TRI_Free(array->_memoryZone, table);
+    table = previous;
+  }
+
+  array->_table.store(nullptr);
+
+  TRI_DestroyMutex(&array->_lock);
+}
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief looks up an element given a key, without locking
+////////////////////////////////////////////////////////////////////////////////
+
+void const* TRI_LookupByKeyAssociativeLockFree (TRI_associative_lockfree_t* array,
+                                                void const* key) {
+  // compute the hash
+  uint64_t hash = array->hashKey(array, key);
+
+  TRI_associative_lockfree_table_t const* table = array->_table.load(std::memory_order_acquire);
+
+  // search the table
+  uint64_t i = hash % table->_nrAlloc;
+  void const* result;
+
+  while ((result = table->_slots[i].load(std::memory_order_acquire)) != nullptr &&
+         ! array->isEqualKeyElement(array, key, result)) {
+    i = TRI_IncModU64(i, table->_nrAlloc);
+  }
+
+  // return whatever we found
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief looks up an element given an element, without locking
+////////////////////////////////////////////////////////////////////////////////
+
+void const* TRI_LookupByElementAssociativeLockFree (TRI_associative_lockfree_t* array,
+                                                    void const* element) {
+  // compute the hash
+  uint64_t hash = array->hashElement(array, element);
+
+  TRI_associative_lockfree_table_t const* table = array->_table.load(std::memory_order_acquire);
+
+  // search the table
+  uint64_t i = hash % table->_nrAlloc;
+  void const* result;
+
+  while ((result = table->_slots[i].load(std::memory_order_acquire)) != nullptr &&
+         ! array->isEqualElementElement(array, element, result)) {
+    i = TRI_IncModU64(i, table->_nrAlloc);
+  }
+
+  // return whatever we found
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adds an element to the array
+////////////////////////////////////////////////////////////////////////////////
+
+void* TRI_InsertElementAssociativeLockFree (TRI_associative_lockfree_t* array,
+                                            void* element,
+                                            bool overwrite) {
+  // compute the hash
+  uint64_t hash = array->hashElement(array, element);
+
+  TRI_LockMutex(&array->_lock);
+
+  TRI_associative_lockfree_table_t* table = array->_table.load(std::memory_order_relaxed);
+
+  // check for out-of-memory
+  if (table->_nrAlloc == array->_nrUsed && ! overwrite) {
+    TRI_UnlockMutex(&array->_lock);
+    TRI_set_errno(TRI_ERROR_OUT_OF_MEMORY);
+    return nullptr;
+  }
+
+  uint64_t i = hash % table->_nrAlloc;
+  void* current;
+
+  // search the table
+  while ((current = table->_slots[i].load(std::memory_order_relaxed)) != nullptr &&
+         ! array->isEqualElementElement(array, element, current)) {
+    i = TRI_IncModU64(i, table->_nrAlloc);
+  }
+
+  void* old = StoreElementLockFree(array, table, i, element, overwrite);
+
+  TRI_UnlockMutex(&array->_lock);
+  return old;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adds an key/element to the array
+////////////////////////////////////////////////////////////////////////////////
+
+void* TRI_InsertKeyAssociativeLockFree (TRI_associative_lockfree_t* array,
+                                        void const* key,
+                                        void* element,
+                                        bool overwrite) {
+  // compute the hash
+  uint64_t hash = array->hashKey(array, key);
+
+  TRI_LockMutex(&array->_lock);
+
+  TRI_associative_lockfree_table_t* table = array->_table.load(std::memory_order_relaxed);
+
+  // check for out-of-memory
+  if (table->_nrAlloc == array->_nrUsed && ! overwrite) {
+    TRI_UnlockMutex(&array->_lock);
+    TRI_set_errno(TRI_ERROR_OUT_OF_MEMORY);
+    return nullptr;
+  }
+
+  uint64_t i = hash % table->_nrAlloc;
+  void* current;
+
+  // search the table
+  while ((current = table->_slots[i].load(std::memory_order_relaxed)) != nullptr &&
+         ! array->isEqualKeyElement(array, key, current)) {
+    i = TRI_IncModU64(i, table->_nrAlloc);
+  }
+
+  void* old = StoreElementLockFree(array, table, i, element, overwrite);
+
+  TRI_UnlockMutex(&array->_lock);
+  return old;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the number of elements from the array
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_GetLengthAssociativeLockFree (TRI_associative_lockfree_t* array) {
+  uint64_t result;
+
+  TRI_LockMutex(&array->_lock);
+  result = array->_nrUsed;
+  TRI_UnlockMutex(&array->_lock);
+
+  return (size_t) result;
+}
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
@@ -473,6 +473,118 @@ void* TRI_RemoveKeyAssociativeSynced (TRI_associative_synced_t*,
 
 size_t TRI_GetLengthAssociativeSynced (TRI_associative_synced_t* const);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                              ASSOCIATIVE LOCKFREE
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                      public types
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief table of an associative lock-free array
+///
+/// The slots are allocated directly behind the table header. A table is never
+/// modified after it has been replaced by a larger one, and it is kept alive
+/// until the array is destroyed, so readers can still finish probing it.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct TRI_associative_lockfree_table_s {
+  uint64_t _nrAlloc;                                  // the size of the table
+  struct TRI_associative_lockfree_table_s* _previous; // the replaced table
+  std::atomic<void*>* _slots;                         // the table itself
+}
+TRI_associative_lockfree_table_t;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief associative array of pointers with lock-free lookups
+///
+/// This is meant for insert-mostly dictionaries that are read much more often
+/// than they are written, e.g. the attribute and shape dictionaries of a
+/// collection. Lookups do not acquire any lock. Inserts are serialised using a
+/// mutex. An insert with overwrite replaces a slot's pointer atomically.
+/// Elements cannot be removed.
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct TRI_associative_lockfree_s {
+  uint64_t (*hashKey) (struct TRI_associative_lockfree_s*, void const*);
+  uint64_t (*hashElement) (struct TRI_associative_lockfree_s*, void const*);
+
+  bool (*isEqualKeyElement) (struct TRI_associative_lockfree_s*, void const*, void const*);
+  bool (*isEqualElementElement) (struct TRI_associative_lockfree_s*, void const*, void const*);
+
+  std::atomic<TRI_associative_lockfree_table_t*> _table; // the current table
+
+  uint64_t _nrUsed;      // the number of used entries, protected by _lock
+
+  TRI_mutex_t _lock;     // serialises writers
+
+  TRI_memory_zone_t* _memoryZone;
+}
+TRI_associative_lockfree_t;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                      constructors and destructors
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief initialises an array
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_InitAssociativeLockFree (TRI_associative_lockfree_t* array,
+                                 TRI_memory_zone_t*,
+                                 uint64_t (*hashKey) (TRI_associative_lockfree_t*, void const*),
+                                 uint64_t (*hashElement) (TRI_associative_lockfree_t*, void const*),
+                                 bool (*isEqualKeyElement) (TRI_associative_lockfree_t*, void const*, void const*),
+                                 bool (*isEqualElementElement) (TRI_associative_lockfree_t*, void const*, void const*));
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief destroys an array, but does not free the pointer
+////////////////////////////////////////////////////////////////////////////////
+
+void TRI_DestroyAssociativeLockFree (TRI_associative_lockfree_t*);
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief looks up an element given a key, without locking
+////////////////////////////////////////////////////////////////////////////////
+
+void const* TRI_LookupByKeyAssociativeLockFree (TRI_associative_lockfree_t*,
+                                                void const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief looks up an element given an element, without locking
+////////////////////////////////////////////////////////////////////////////////
+
+void const* TRI_LookupByElementAssociativeLockFree (TRI_associative_lockfree_t*,
+                                                    void const*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adds an element to the array
+////////////////////////////////////////////////////////////////////////////////
+
+void* TRI_InsertElementAssociativeLockFree (TRI_associative_lockfree_t*,
+                                            void*,
+                                            bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief adds an key/element to the array
+////////////////////////////////////////////////////////////////////////////////
+
+void* TRI_InsertKeyAssociativeLockFree (TRI_associative_lockfree_t*,
+                                        void const*,
+                                        void*,
+                                        bool);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief get the number of elements from the array
+////////////////////////////////////////////////////////////////////////////////
+
+size_t TRI_GetLengthAssociativeLockFree (TRI_associative_lockfree_t*);
+
 #endif
 
 // -----------------------------------------------------------------------------
@@ -29,6 +29,12 @@
 
 #include "hashes.h"
 
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__clang__) || (defined(__GNUC__) && (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))))
+#define TRI_HAVE_SSE42_CRC32C 1
+#include <cpuid.h>
+#endif
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                               FNV
 // -----------------------------------------------------------------------------
@@ -566,6 +572,205 @@ uint32_t TRI_Crc32HashString (char const* data) {
   return TRI_FinalCrc32(crc);
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                            CRC32C
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private variables
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief precomputed lookup values for crc32c 8 bytes-at-a-time calculation
+///
+/// the values are generated in TRI_InitialiseHashes
+////////////////////////////////////////////////////////////////////////////////
+
+static uint32_t Crc32CLookup[8][256];
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the CPU provides the crc32 instruction
+////////////////////////////////////////////////////////////////////////////////
+
+static bool HasHardwareCrc32C = false;
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief generates the CRC32C lookup tables
+////////////////////////////////////////////////////////////////////////////////
+
+static void GenerateCrc32CLookup (void) {
+  // reflected Castagnoli polynomial
+  uint32_t const polynomial = 0x82F63B78;
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    uint32_t value = i;
+
+    for (int j = 0; j < 8; ++j) {
+      value = (value >> 1) ^ ((value & 1) ? polynomial : 0);
+    }
+
+    Crc32CLookup[0][i] = value;
+  }
+
+  for (uint32_t i = 0; i < 256; ++i) {
+    for (int slice = 1; slice < 8; ++slice) {
+      uint32_t previous = Crc32CLookup[slice - 1][i];
+      Crc32CLookup[slice][i] = (previous >> 8) ^ Crc32CLookup[0][previous & 0xFF];
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief detects whether the CPU supports SSE4.2
+////////////////////////////////////////////////////////////////////////////////
+
+static bool DetectHardwareCrc32C (void) {
+#ifdef TRI_HAVE_SSE42_CRC32C
+  unsigned int eax = 0;
+  unsigned int ebx = 0;
+  unsigned int ecx = 0;
+  unsigned int edx = 0;
+
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+    return false;
+  }
+
+  return (ecx & bit_SSE4_2) != 0;
+#else
+  return false;
+#endif
+}
+
+#ifdef TRI_HAVE_SSE42_CRC32C
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, using the crc32 instruction
+///
+/// the function is compiled for SSE4.2 regardless of the compiler flags, so it
+/// must only be called after DetectHardwareCrc32C() returned true
+////////////////////////////////////////////////////////////////////////////////
+
+__attribute__((target("sse4.2")))
+static uint32_t BlockCrc32CHardware (uint32_t value, char const* data, size_t length) {
+  uint8_t const* current = reinterpret_cast<uint8_t const*>(data);
+
+  // process single bytes until the data is aligned
+  while (length > 0 && (reinterpret_cast<uintptr_t>(current) & 7) != 0) {
+    value = __builtin_ia32_crc32qi(value, *current++);
+    --length;
+  }
+
+#ifdef __x86_64__
+  // process eight bytes at once
+  uint64_t value64 = value;
+
+  while (length >= 8) {
+    value64 = __builtin_ia32_crc32di(value64, *reinterpret_cast<uint64_t const*>(current));
+    current += 8;
+    length -= 8;
+  }
+
+  value = static_cast<uint32_t>(value64);
+#endif
+
+  // process four bytes at once
+  while (length >= 4) {
+    value = __builtin_ia32_crc32si(value, *reinterpret_cast<uint32_t const*>(current));
+    current += 4;
+    length -= 4;
+  }
+
+  // remaining 1 to 3 bytes
+  while (length > 0) {
+    value = __builtin_ia32_crc32qi(value, *current++);
+    --length;
+  }
+
+  return value;
+}
+
+#endif
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not CRC32C values are computed using the CPU's crc32
+/// instruction (SSE4.2)
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HasHardwareCrc32C () {
+  return HasHardwareCrc32C;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32C (uint32_t value, char const* data, size_t length) {
+#ifdef TRI_HAVE_SSE42_CRC32C
+  if (HasHardwareCrc32C) {
+    return BlockCrc32CHardware(value, data, length);
+  }
+#endif
+
+  return TRI_BlockCrc32CSoftware(value, data, length);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, always computed without the CPU's
+/// crc32 instruction
+///
+/// same slicing-by-8 algorithm as TRI_BlockCrc32, using the Castagnoli tables
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32CSoftware (uint32_t value, char const* data, size_t length) {
+  uint32_t* current = (uint32_t*) data;
+  uint8_t* currentChar;
+
+  // process eight bytes at once
+  while (length >= 8) {
+    uint32_t one = *current++ ^ value;
+    uint32_t two = *current++;
+
+    value = Crc32CLookup[0][(two>>24) & 0xFF] ^
+            Crc32CLookup[1][(two>>16) & 0xFF] ^
+            Crc32CLookup[2][(two>> 8) & 0xFF] ^
+            Crc32CLookup[3][ two      & 0xFF] ^
+            Crc32CLookup[4][(one>>24) & 0xFF] ^
+            Crc32CLookup[5][(one>>16) & 0xFF] ^
+            Crc32CLookup[6][(one>> 8) & 0xFF] ^
+            Crc32CLookup[7][ one      & 0xFF];
+    length -= 8;
+  }
+
+  currentChar = (uint8_t*) current;
+  // remaining 1 to 7 bytes (standard CRC table-based algorithm)
+  while (length--) {
+    value = (value >> 8) ^ Crc32CLookup[0][(value & 0xFF) ^ *currentChar++];
+  }
+
+  return value;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes a CRC32C for memory blobs
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_Crc32CHashPointer (void const* data, size_t length) {
+  uint32_t crc;
+
+  crc = TRI_InitialCrc32();
+  crc = TRI_BlockCrc32C(crc, static_cast<char const*>(data), length);
+
+  return TRI_FinalCrc32(crc);
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                            MODULE
 // -----------------------------------------------------------------------------
@@ -594,6 +799,9 @@ void TRI_InitialiseHashes () {
   }
 
   GenerateCrc32Polynomial();
+  GenerateCrc32CLookup();
+
+  HasHardwareCrc32C = DetectHardwareCrc32C();
 
   Initialised = true;
 }
@@ -120,6 +120,43 @@ uint32_t TRI_Crc32HashPointer (void const*, size_t);
 
 uint32_t TRI_Crc32HashString (char const*);
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                            (Castagnoli)   CRC32C
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                  public functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not CRC32C values are computed using the CPU's crc32
+/// instruction (SSE4.2)
+////////////////////////////////////////////////////////////////////////////////
+
+bool TRI_HasHardwareCrc32C (void);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block
+///
+/// uses the initial and final values of CRC32, i.e. TRI_InitialCrc32() and
+/// TRI_FinalCrc32()
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32C (uint32_t, char const* data, size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief CRC32C value of data block, always computed without the CPU's
+/// crc32 instruction
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_BlockCrc32CSoftware (uint32_t, char const* data, size_t length);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief computes a CRC32C for memory blobs
+////////////////////////////////////////////////////////////////////////////////
+
+uint32_t TRI_Crc32CHashPointer (void const*, size_t);
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                            MODULE
 // -----------------------------------------------------------------------------
@@ -761,10 +761,12 @@ static uint64_t HashBlock (uint64_t hash, char const* buffer, size_t length) {
 /// @brief compute a hash value for a JSON document, starting with a given
 /// initial hash value. Note that a NULL pointer for json hashes to the
 /// same value as a json pointer that points to a JSON value `null`.
+/// If normalizeZero is true, -0 hashes to the same value as 0.
 ////////////////////////////////////////////////////////////////////////////////
 
 static uint64_t HashJsonRecursive (uint64_t hash, 
-                                   TRI_json_t const* object) {
+                                   TRI_json_t const* object,
+                                   bool normalizeZero) {
   if (nullptr == object) {
     return HashBlock(hash, "null", 4);   // strlen("null")
   }
@@ -788,6 +790,10 @@ static uint64_t HashJsonRecursive (uint64_t hash,
     }
 
     case TRI_JSON_NUMBER: {
+      if (normalizeZero && object->_value._number == 0.0) {
+        double const zero = 0.0;
+        return HashBlock(hash, (char const*) &zero, sizeof(zero));
+      }
       return HashBlock(hash, (char const*) &(object->_value._number), sizeof(object->_value._number));
     }
 
@@ -805,9 +811,9 @@ static uint64_t HashJsonRecursive (uint64_t hash,
       for (size_t i = 0;  i < n;  i += 2) {
         TRI_json_t const* subjson = static_cast<TRI_json_t const*>(TRI_AtVector(&object->_value._objects, i));
         TRI_ASSERT(TRI_IsStringJson(subjson));
-        tmphash ^= HashJsonRecursive(hash, subjson);
+        tmphash ^= HashJsonRecursive(hash, subjson, normalizeZero);
         subjson = static_cast<TRI_json_t const*>(TRI_AtVector(&object->_value._objects, i + 1));
-        tmphash ^= HashJsonRecursive(hash, subjson);
+        tmphash ^= HashJsonRecursive(hash, subjson, normalizeZero);
       }
       return tmphash;
     }
@@ -817,7 +823,7 @@ static uint64_t HashJsonRecursive (uint64_t hash,
       size_t const n = object->_value._objects._length;
       for (size_t i = 0;  i < n;  ++i) {
         TRI_json_t const* subjson = static_cast<TRI_json_t const*>(TRI_AtVector(&object->_value._objects, i));
-        hash = HashJsonRecursive(hash, subjson);
+        hash = HashJsonRecursive(hash, subjson, normalizeZero);
       }
       return hash;
     }
@@ -832,7 +838,17 @@ static uint64_t HashJsonRecursive (uint64_t hash,
 ////////////////////////////////////////////////////////////////////////////////
 
 uint64_t TRI_HashJson (TRI_json_t const* json) {
-  return HashJsonRecursive(TRI_FnvHashBlockInitial(), json);
+  return HashJsonRecursive(TRI_FnvHashBlockInitial(), json, false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compute a hash value for a JSON document that is consistent with
+/// TRI_CompareValuesJson, i.e. -0 hashes to the same value as 0. This must
+/// not be used for values that are persisted, such as shard assignments
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t TRI_HashJsonNormalized (TRI_json_t const* json) {
+  return HashJsonRecursive(TRI_FnvHashBlockInitial(), json, true);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -868,7 +884,7 @@ uint64_t TRI_HashJsonByAttributes (TRI_json_t const* json,
       if (subjson == nullptr && ! docComplete && error != nullptr) {
         *error = TRI_ERROR_CLUSTER_NOT_ALL_SHARDING_ATTRIBUTES_GIVEN;
       }
-      hash = HashJsonRecursive(hash, subjson);
+      hash = HashJsonRecursive(hash, subjson, false);
     }
   }
   return hash;
@@ -146,6 +146,13 @@ TRI_json_t* TRI_MergeJson (TRI_memory_zone_t*,
 
 uint64_t TRI_HashJson (TRI_json_t const* json);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief compute a hash value for a JSON document that is consistent with
+/// TRI_CompareValuesJson (-0 hashes like 0). not for persisted values
+////////////////////////////////////////////////////////////////////////////////
+
+uint64_t TRI_HashJsonNormalized (TRI_json_t const* json);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief compute a hash value for a JSON document depending on a list
 /// of attributes.
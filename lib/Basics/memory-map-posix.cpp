@@ -162,6 +162,28 @@ int TRI_ProtectMMFile (void* memoryAddress,
   return TRI_ERROR_SYS_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// @brief give an access pattern hint for a memory-mapped region
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileAdvise (void* memoryAddress,
+                      size_t numOfBytes,
+                      int advice) {
+  static uintptr_t const pageSize = static_cast<uintptr_t>(getpagesize());
+
+  // madvise requires a page-aligned start address
+  uintptr_t const start = reinterpret_cast<uintptr_t>(memoryAddress);
+  uintptr_t const aligned = start - (start % pageSize);
+
+  int result = madvise(reinterpret_cast<void*>(aligned), numOfBytes + (start - aligned), advice);
+
+  if (result == 0) {
+    return TRI_ERROR_NO_ERROR;
+  }
+
+  return TRI_ERROR_SYS_ERROR;
+}
+
 #endif
 
 // -----------------------------------------------------------------------------
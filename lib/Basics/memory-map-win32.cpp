@@ -328,6 +328,16 @@ int TRI_ProtectMMFile(void* memoryAddress,  size_t numOfBytesToProtect, int flag
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// @brief give an access pattern hint for a memory-mapped region (ignored)
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileAdvise (void* memoryAddress,
+                      size_t numOfBytes,
+                      int advice) {
+  return TRI_ERROR_NO_ERROR;
+}
+
 
 #endif
 
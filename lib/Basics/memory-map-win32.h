@@ -66,6 +66,14 @@
 #define MS_INVALIDATE   2             /* invalidate the caches */
 #define MS_SYNC         4             /* synchronous memory sync */
 
+////////////////////////////////////////////////////////////////////////////////
+// Access pattern hints, which are ignored under windows.
+////////////////////////////////////////////////////////////////////////////////
+
+#define TRI_MADVISE_NORMAL      0
+#define TRI_MADVISE_SEQUENTIAL  1
+#define TRI_MADVISE_WILLNEED    2
+
 
 
 #define PROT_READ       0x1             /* Page can be read.  */
@@ -111,6 +111,17 @@ int TRI_ProtectMMFile (void* memoryAddress,
                        int fileDescriptor,
                        void** mmHandle);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief gives the operating system a hint about the expected access
+/// pattern for a region of a memory mapped file. the advice is one of
+/// TRI_MADVISE_NORMAL, TRI_MADVISE_SEQUENTIAL or TRI_MADVISE_WILLNEED. this
+/// is a hint only, and a no-op on platforms that do not support it
+////////////////////////////////////////////////////////////////////////////////
+
+int TRI_MMFileAdvise (void* memoryAddress,
+                      size_t numOfBytes,
+                      int advice);
+
 #endif
 
 // -----------------------------------------------------------------------------
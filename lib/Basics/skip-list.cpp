@@ -412,6 +412,77 @@ int SkipList::insert (void* doc) {
   return TRI_ERROR_NO_ERROR;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief builds the skiplist from documents sorted in the total order
+////////////////////////////////////////////////////////////////////////////////
+
+int SkipList::bulkInsert (void* const* docs,
+                          size_t n) {
+  TRI_ASSERT(_nrUsed == 0);
+  TRI_ASSERT(_start->_next[0] == nullptr);
+
+  if (_unique) {
+    for (size_t i = 1; i < n; i++) {
+      if (0 == _cmp_elm_elm(_cmpdata, docs[i - 1], docs[i], SKIPLIST_CMP_PREORDER)) {
+        return TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED;
+      }
+    }
+  }
+
+  // the last node seen on each level. new nodes are always appended, so
+  // there is no need to search for the insert position
+  SkipListNode* last[TRI_SKIPLIST_MAX_HEIGHT];
+
+  for (int lev = 0; lev < TRI_SKIPLIST_MAX_HEIGHT; lev++) {
+    last[lev] = _start;
+  }
+
+  for (size_t i = 0; i < n; i++) {
+    TRI_ASSERT(i == 0 || _cmp_elm_elm(_cmpdata, docs[i - 1], docs[i], SKIPLIST_CMP_TOTORDER) < 0);
+
+    SkipListNode* newNode;
+
+    try {
+      newNode = allocNode(0);
+    }
+    catch (...) {
+      // give back the nodes allocated so far, but not the documents
+      SkipListNode* p = _start->_next[0];
+
+      while (nullptr != p) {
+        SkipListNode* next = p->_next[0];
+        freeNode(p);
+        p = next;
+      }
+
+      for (int lev = 0; lev < _start->_height; lev++) {
+        _start->_next[lev] = nullptr;
+      }
+      _start->_height = 1;
+      _end = _start;
+
+      return TRI_ERROR_OUT_OF_MEMORY;
+    }
+
+    newNode->_doc = docs[i];
+    newNode->_prev = last[0];
+
+    if (newNode->_height > _start->_height) {
+      _start->_height = newNode->_height;
+    }
+
+    for (int lev = 0; lev < newNode->_height; lev++) {
+      last[lev]->_next[lev] = newNode;
+      last[lev] = newNode;
+    }
+  }
+
+  _end = last[0];
+  _nrUsed = n;
+
+  return TRI_ERROR_NO_ERROR;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes a document from a skiplist
 ///
@@ -207,6 +207,19 @@ namespace triagens {
 
         int insert (void* doc);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief builds the skiplist from documents that are already sorted in
+/// the proper total order, in linear time and without any comparisons
+/// except for the uniqueness check. the skiplist must be empty. Returns
+/// TRI_ERROR_NO_ERROR if all is well, TRI_ERROR_OUT_OF_MEMORY if allocation
+/// failed and TRI_ERROR_ARANGO_UNIQUE_CONSTRAINT_VIOLATED if the unique
+/// constraint would have been violated. In the latter two cases nothing
+/// is inserted and the caller keeps the ownership of the documents.
+////////////////////////////////////////////////////////////////////////////////
+
+        int bulkInsert (void* const* docs,
+                        size_t n);
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief removes a document from a skiplist
 ///
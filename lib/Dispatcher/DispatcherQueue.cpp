@@ -35,12 +35,45 @@
 #include "DispatcherQueue.h"
 
 #include "Basics/ConditionLocker.h"
+#include "Basics/MutexLocker.h"
 #include "Basics/logging.h"
 #include "Dispatcher/DispatcherThread.h"
 
 using namespace std;
 using namespace triagens::rest;
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                 private functions
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief cancels a job that has not been started yet
+////////////////////////////////////////////////////////////////////////////////
+
+static bool CancelReadyJob (Job* job,
+                            bool stopping) {
+  bool canceled = job->cancel(false);
+
+  if (canceled) {
+    try {
+      job->setDispatcherThread(0);
+      job->cleanup();
+    }
+    catch (...) {
+#ifdef TRI_HAVE_POSIX_THREADS
+      if (stopping) {
+        LOG_WARNING("caught cancellation exception during cleanup");
+        throw;
+      }
+#endif
+
+      LOG_WARNING("caught error while cleaning up!");
+    }
+  }
+
+  return canceled;
+}
+
 // -----------------------------------------------------------------------------
 // constructors and destructors
 // -----------------------------------------------------------------------------
@@ -59,11 +92,16 @@ DispatcherQueue::DispatcherQueue (Scheduler* scheduler,
   : _name(name),
     _threadData(threadData),
     _accessQueue(),
-    _readyJobs(),
-    _runningJobs(),
+    _lanes(),
+    _nextLane(0),
+    _nrReady(0),
+    _writeJobs(),
+    _nrWriteJobs(0),
+    _nrWorking(0),
+    _nrIdle(0),
     _maxSize(maxSize),
     _stopping(0),
-    _monopolizer(0),
+    _monopolizer(nullptr),
     _startedThreads(),
     _stoppedThreads(),
     _nrStarted(0),
@@ -79,6 +117,13 @@ DispatcherQueue::DispatcherQueue (Scheduler* scheduler,
     _scheduler(scheduler),
     _dispatcher(dispatcher),
     createDispatcherThread(creator) {
+
+  // one lane per configured thread
+  size_t const nrLanes = (nrThreads > 0 ? nrThreads : 1);
+
+  for (size_t i = 0;  i < nrLanes;  ++i) {
+    _lanes.push_back(new JobLane());
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -89,6 +134,10 @@ DispatcherQueue::~DispatcherQueue () {
   if (_stopping == 0) {
     beginShutdown();
   }
+
+  for (auto lane : _lanes) {
+    delete lane;
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -102,25 +151,46 @@ DispatcherQueue::~DispatcherQueue () {
 bool DispatcherQueue::addJob (Job* job) {
   TRI_ASSERT(job != 0);
 
-  CONDITION_LOCKER(guard, _accessQueue);
-
   // queue is full
-  if (_readyJobs.size() >= _maxSize) {
+  if (_nrReady.fetch_add(1) >= _maxSize) {
+    --_nrReady;
     return false;
   }
 
   // if all threads are block, we start new threads
-  if (0 == _nrWaiting && _nrRunning + _nrStarted <= _nrBlocked) {
-    startQueueThread();
+  if (0 < _nrBlocked.load()) {
+    CONDITION_LOCKER(guard, _accessQueue);
+
+    if (0 == _nrWaiting && _nrRunning + _nrStarted <= _nrBlocked) {
+      startQueueThread();
+    }
   }
 
-  // add the job to the list of ready jobs
-  _readyJobs.push_back(job);
+  if (job->type() == Job::WRITE_JOB) {
+    CONDITION_LOCKER(guard, _accessQueue);
 
-  // wake up the _dispatcher queue threads
-  if (0 < _nrWaiting) {
-    guard.broadcast();
+    _writeJobs.push_back(job);
+    ++_nrWriteJobs;
   }
+  else {
+    // jobs created by one of our own threads go into its home lane, all other
+    // jobs are distributed round-robin
+    DispatcherThread* current = DispatcherThread::currentDispatcherThread;
+    JobLane* lane;
+
+    if (current != nullptr && current->_queue == this) {
+      lane = _lanes[current->_lane];
+    }
+    else {
+      lane = _lanes[_nextLane++ % _lanes.size()];
+    }
+
+    MUTEX_LOCKER(lane->_lock);
+    lane->_jobs.push_back(job);
+  }
+
+  // wake up a waiting dispatcher queue thread
+  wakeupThread();
 
   return true;
 }
@@ -137,42 +207,46 @@ bool DispatcherQueue::cancelJob (uint64_t jobId) {
   }
 
   // job is already running, try to cancel it
-  for (set<Job*>::iterator it = _runningJobs.begin();  it != _runningJobs.end();  ++it) {
-    Job* job = *it;
+  for (auto thread : _startedThreads) {
+    MUTEX_LOCKER(_lanes[thread->_lane]->_lock);
 
-    if (job->id() == jobId) {
+    Job* job = thread->_currentJob;
+
+    if (job != nullptr && job->id() == jobId) {
       job->cancel(true);
       return true;
     }
   }
 
   // maybe there is a waiting job with this it, try to remove it
-  for (list<Job*>::iterator it = _readyJobs.begin();  it != _readyJobs.end();  ++it) {
+  for (auto it = _writeJobs.begin();  it != _writeJobs.end();  ++it) {
     Job* job = *it;
 
     if (job->id() == jobId) {
-      bool canceled = job->cancel(false);
+      if (CancelReadyJob(job, _stopping != 0)) {
+        _writeJobs.erase(it);
+        --_nrWriteJobs;
+        --_nrReady;
+      }
 
-      if (canceled) {
-        try {
-          job->setDispatcherThread(0);
-          job->cleanup();
-        }
-        catch (...) {
-#ifdef TRI_HAVE_POSIX_THREADS
-          if (_stopping != 0) {
-            LOG_WARNING("caught cancellation exception during cleanup");
-            throw;
-          }
-#endif
+      return true;
+    }
+  }
+
+  for (auto lane : _lanes) {
+    MUTEX_LOCKER(lane->_lock);
 
-          LOG_WARNING("caught error while cleaning up!");
+    for (auto it = lane->_jobs.begin();  it != lane->_jobs.end();  ++it) {
+      Job* job = *it;
+
+      if (job->id() == jobId) {
+        if (CancelReadyJob(job, _stopping != 0)) {
+          lane->_jobs.erase(it);
+          --_nrReady;
         }
 
-        _readyJobs.erase(it);
+        return true;
       }
-
-      return true;
     }
   }
 
@@ -194,9 +268,14 @@ void DispatcherQueue::specializeThread (DispatcherThread* thread) {
 
     startQueueThread();
 
-    if (_monopolizer == thread) {
-      _monopolizer = 0;
+    if (_monopolizer.load() == thread) {
+      _monopolizer.store(nullptr);
     }
+
+    // special threads do not count as working, this might allow a write job
+    // or the jobs blocked by a write job to start
+    --_nrWorking;
+    guard.broadcast();
   }
 }
 
@@ -265,10 +344,7 @@ void DispatcherQueue::beginShutdown () {
   
   // kill all jobs in the queue that were not yet executed
   {
-    CONDITION_LOCKER(guard, _accessQueue);
-    for (auto it = _readyJobs.begin();  it != _readyJobs.end();  ++it) {
-      Job* job = *it;
-
+    auto cancel = [] (Job* job) -> void {
       bool canceled = job->cancel(false);
 
       if (canceled) {
@@ -279,8 +355,28 @@ void DispatcherQueue::beginShutdown () {
         catch (...) {
         }
       }
+    };
+
+    CONDITION_LOCKER(guard, _accessQueue);
+
+    for (auto job : _writeJobs) {
+      cancel(job);
+    }
+
+    _nrReady -= _writeJobs.size();
+    _nrWriteJobs = 0;
+    _writeJobs.clear();
+
+    for (auto lane : _lanes) {
+      MUTEX_LOCKER(lane->_lock);
+
+      for (auto job : lane->_jobs) {
+        cancel(job);
+      }
+
+      _nrReady -= lane->_jobs.size();
+      lane->_jobs.clear();
     }
-    _readyJobs.clear();
   }
 
 
@@ -378,6 +474,210 @@ bool DispatcherQueue::startQueueThread () {
   return ok;
 }
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief takes the next job for a thread, returns nullptr if there is no job
+/// the thread may start now
+////////////////////////////////////////////////////////////////////////////////
+
+Job* DispatcherQueue::takeJob (DispatcherThread* thread) {
+  // a write job is waiting, this is the slow path
+  if (0 < _nrWriteJobs.load()) {
+    CONDITION_LOCKER(guard, _accessQueue);
+
+    return takeWriteJob(thread);
+  }
+
+  // announce that we are working before checking for a monopolizer. a thread
+  // starting a write job does it the other way round, so at least one of us
+  // will notice the other
+  ++_nrWorking;
+
+  if (_monopolizer.load() != nullptr) {
+    stopWorking();
+    return nullptr;
+  }
+
+  Job* job = popReadyJob(thread);
+
+  if (job == nullptr) {
+    stopWorking();
+    return nullptr;
+  }
+
+  // handle job type
+  if (job->type() == Job::SPECIAL_JOB) {
+    stopWorking();
+
+    // start a new thread for special jobs
+    CONDITION_LOCKER(guard, _accessQueue);
+
+    thread->_jobType = Job::SPECIAL_JOB;
+
+    _nrRunning--;
+    _nrSpecial++;
+
+    startQueueThread();
+  }
+  else {
+    thread->_jobType = job->type();
+  }
+
+  return job;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief takes the next ready job, preferring the thread's home lane
+///
+/// the home lane is checked first, then the other lanes are tried in order.
+/// jobs are always taken from the front of a lane, so the oldest job of a lane
+/// is executed first
+////////////////////////////////////////////////////////////////////////////////
+
+Job* DispatcherQueue::popReadyJob (DispatcherThread* thread) {
+  size_t const nrLanes = _lanes.size();
+  size_t const home = thread->_lane;
+
+  for (size_t i = 0;  i < nrLanes;  ++i) {
+    JobLane* lane = _lanes[(home + i) % nrLanes];
+    Job* job = nullptr;
+
+    {
+      MUTEX_LOCKER(lane->_lock);
+
+      if (! lane->_jobs.empty()) {
+        job = lane->_jobs.front();
+        lane->_jobs.pop_front();
+
+        if (i == 0) {
+          thread->_currentJob = job;
+        }
+      }
+    }
+
+    if (job != nullptr) {
+      --_nrReady;
+
+      if (i != 0) {
+        // stolen from another lane, register it with our own lane
+        MUTEX_LOCKER(_lanes[home]->_lock);
+        thread->_currentJob = job;
+      }
+
+      return job;
+    }
+  }
+
+  return nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tries to start a write job, must be called with the queue lock held
+////////////////////////////////////////////////////////////////////////////////
+
+Job* DispatcherQueue::takeWriteJob (DispatcherThread* thread) {
+  if (_writeJobs.empty() || _monopolizer.load() != nullptr) {
+    return nullptr;
+  }
+
+  // monopolize queue, but only if no other job is running
+  _monopolizer.store(thread);
+
+  if (0 < _nrWorking.load()) {
+    _monopolizer.store(nullptr);
+    return nullptr;
+  }
+
+  Job* job = _writeJobs.front();
+  _writeJobs.pop_front();
+
+  --_nrWriteJobs;
+  --_nrReady;
+  ++_nrWorking;
+
+  thread->_jobType = Job::WRITE_JOB;
+
+  MUTEX_LOCKER(_lanes[thread->_lane]->_lock);
+  thread->_currentJob = job;
+
+  return job;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marks the job of a thread as finished
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::finishJob (DispatcherThread* thread, Job* job) {
+  {
+    MUTEX_LOCKER(_lanes[thread->_lane]->_lock);
+
+    TRI_ASSERT(thread->_currentJob == job);
+    thread->_currentJob = nullptr;
+  }
+
+  if (thread->_jobType == Job::WRITE_JOB) {
+    // release the queue and let the other threads continue
+    CONDITION_LOCKER(guard, _accessQueue);
+
+    if (_monopolizer.load() == thread) {
+      _monopolizer.store(nullptr);
+    }
+
+    --_nrWorking;
+    guard.broadcast();
+  }
+  else if (thread->_jobType == Job::READ_JOB) {
+    stopWorking();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief decreases the number of working threads
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::stopWorking () {
+  // the last working thread must wake up threads waiting for a write job
+  if (_nrWorking.fetch_sub(1) == 1 && 0 < _nrWriteJobs.load()) {
+    CONDITION_LOCKER(guard, _accessQueue);
+    guard.broadcast();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether a waiting thread could start a job now
+////////////////////////////////////////////////////////////////////////////////
+
+bool DispatcherQueue::hasRunnableJob () const {
+  if (_monopolizer.load() != nullptr) {
+    return false;
+  }
+
+  if (0 < _nrWriteJobs.load()) {
+    return 0 == _nrWorking.load();
+  }
+
+  return 0 < _nrReady.load();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wakes up a waiting thread, if there is one
+///
+/// a thread increases _nrIdle before it checks for ready jobs, and a job is
+/// counted in _nrReady before _nrIdle is checked here. so either the thread
+/// sees the new job or we see the idle thread. as the thread holds the queue
+/// lock until it waits, the signal cannot get lost
+////////////////////////////////////////////////////////////////////////////////
+
+void DispatcherQueue::wakeupThread () {
+  if (0 < _nrIdle.load()) {
+    CONDITION_LOCKER(guard, _accessQueue);
+    guard.signal();
+  }
+}
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                       END-OF-FILE
 // -----------------------------------------------------------------------------
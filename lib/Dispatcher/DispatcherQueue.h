@@ -34,7 +34,9 @@
 #include "Basics/Common.h"
 
 #include "Basics/ConditionVariable.h"
+#include "Basics/Mutex.h"
 #include "Dispatcher/Dispatcher.h"
+#include "Dispatcher/Job.h"
 
 // -----------------------------------------------------------------------------
 // --SECTION--                                              forward declarations
@@ -51,6 +53,13 @@ namespace triagens {
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief dispatcher queue
+///
+/// Ready jobs are distributed over several lanes, one per configured thread.
+/// Each lane has its own lock. A dispatcher thread takes jobs from its home
+/// lane first and steals from the other lanes when its own lane is empty, so
+/// handing a job from the scheduler to a dispatcher thread does not contend
+/// on a single queue-wide lock. The queue-wide lock (_accessQueue) protects
+/// the thread bookkeeping, write jobs and sleeping threads.
 ////////////////////////////////////////////////////////////////////////////////
 
     class DispatcherQueue {
@@ -157,6 +166,79 @@ namespace triagens {
 
         bool startQueueThread ();
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                   private methods
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief takes the next job for a thread, returns nullptr if there is no job
+/// the thread may start now
+///
+/// the caller must not hold the queue lock
+////////////////////////////////////////////////////////////////////////////////
+
+        Job* takeJob (DispatcherThread*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief takes the next ready job, preferring the thread's home lane
+////////////////////////////////////////////////////////////////////////////////
+
+        Job* popReadyJob (DispatcherThread*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief tries to start a write job, must be called with the queue lock held
+////////////////////////////////////////////////////////////////////////////////
+
+        Job* takeWriteJob (DispatcherThread*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief marks the job of a thread as finished
+////////////////////////////////////////////////////////////////////////////////
+
+        void finishJob (DispatcherThread*, Job*);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief decreases the number of working threads
+///
+/// the caller must not hold the queue lock
+////////////////////////////////////////////////////////////////////////////////
+
+        void stopWorking ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether a waiting thread could start a job now
+///
+/// must be called with the queue lock held
+////////////////////////////////////////////////////////////////////////////////
+
+        bool hasRunnableJob () const;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief wakes up a waiting thread, if there is one
+////////////////////////////////////////////////////////////////////////////////
+
+        void wakeupThread ();
+
+// -----------------------------------------------------------------------------
+// --SECTION--                                                     private types
+// -----------------------------------------------------------------------------
+
+      private:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief a lane of ready jobs
+///
+/// the lock also protects the current job of all threads using this lane as
+/// their home lane
+////////////////////////////////////////////////////////////////////////////////
+
+        struct JobLane {
+          basics::Mutex _lock;
+          std::deque<Job*> _jobs;
+        };
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                 private variables
 // -----------------------------------------------------------------------------
@@ -182,16 +264,49 @@ namespace triagens {
         basics::ConditionVariable _accessQueue;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief list of ready jobs
+/// @brief lanes of ready jobs
+////////////////////////////////////////////////////////////////////////////////
+
+        std::vector<JobLane*> _lanes;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief lane that receives the next job added from outside the queue
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _nextLane;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of ready jobs in all lanes and in the list of write jobs
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _nrReady;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief ready write jobs, protected by the queue lock
+///
+/// write jobs must run alone, so they do not go into the lanes but wait here
+/// until no other job is running
+////////////////////////////////////////////////////////////////////////////////
+
+        std::list<Job*> _writeJobs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of ready write jobs
+////////////////////////////////////////////////////////////////////////////////
+
+        std::atomic<size_t> _nrWriteJobs;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief number of threads working on a read or write job
 ////////////////////////////////////////////////////////////////////////////////
 
-        std::list<Job*> _readyJobs;
+        std::atomic<size_t> _nrWorking;
 
 ////////////////////////////////////////////////////////////////////////////////
-/// @brief current running job
+/// @brief number of threads that are about to wait or are waiting for work
 ////////////////////////////////////////////////////////////////////////////////
 
-        std::set<Job*> _runningJobs;
+        std::atomic<size_t> _nrIdle;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief maximum queue size (number of jobs)
@@ -209,7 +324,7 @@ namespace triagens {
 /// @brief monopolistic job
 ////////////////////////////////////////////////////////////////////////////////
 
-        DispatcherThread* _monopolizer;
+        std::atomic<DispatcherThread*> _monopolizer;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief list of started threads
@@ -300,7 +415,7 @@ namespace triagens {
 /// The number of threads, that are blocked for some reason. 
 ////////////////////////////////////////////////////////////////////////////////
 
-        size_t _nrBlocked;
+        std::atomic<size_t> _nrBlocked;
 
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief total number of threads
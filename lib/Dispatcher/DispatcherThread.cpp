@@ -58,7 +58,9 @@ using namespace triagens::rest;
 DispatcherThread::DispatcherThread (DispatcherQueue* queue)
   : Thread("dispatcher"),
     _queue(queue),
-    _jobType(Job::READ_JOB) {
+    _jobType(Job::READ_JOB),
+    _lane(0),
+    _currentJob(nullptr) {
   allowAsynchronousCancelation();
 }
 
@@ -82,46 +84,19 @@ void DispatcherThread::run () {
 
   _queue->_startedThreads.insert(this);
 
+  // spread the threads over the lanes of the queue
+  _lane = _queue->_nextLane++ % _queue->_lanes.size();
+
   // iterate until we are shutting down.
   while (_jobType != Job::SPECIAL_JOB && _queue->_stopping == 0) {
 
-    // delete old jobs
-    for (list<DispatcherThread*>::iterator i = _queue->_stoppedThreads.begin();  i != _queue->_stoppedThreads.end();  ++i) {
-      delete *i;
-    }
+    // taking a job does not need the queue lock
+    _queue->_accessQueue.unlock();
 
-    _queue->_stoppedThreads.clear();
-    _queue->_nrStopped = 0;
+    Job* job = _queue->takeJob(this);
 
     // a job is waiting to execute
-    if (  ! _queue->_readyJobs.empty()
-         && _queue->_monopolizer == 0
-         && ! (_queue->_readyJobs.front()->type() == Job::WRITE_JOB && 1 < _queue->_nrRunning)) {
-
-      // try next job
-      Job* job = _queue->_readyJobs.front();
-      _queue->_readyJobs.pop_front();
-
-      // handle job type
-      _jobType = job->type();
-
-      // start a new thread for special jobs
-      if (_jobType == Job::SPECIAL_JOB) {
-        _queue->_nrRunning--;
-        _queue->_nrSpecial++;
-        _queue->startQueueThread();
-      }
-
-      // monopolize queue
-      else if (_jobType == Job::WRITE_JOB) {
-        _queue->_monopolizer = this;
-      }
-
-      // set running job
-      _queue->_runningJobs.insert(job);
-
-      // now release the queue lock (initialise is inside the lock, work outside)
-      _queue->_accessQueue.unlock();
+    if (job != nullptr) {
 
       // do the work (this might change the job type)
       Job::status_t status(Job::JOB_FAILED);
@@ -196,9 +171,7 @@ void DispatcherThread::run () {
       }
 
       // clear running job
-      _queue->_accessQueue.lock();
-      _queue->_runningJobs.erase(job);
-      _queue->_accessQueue.unlock();
+      _queue->finishJob(this, job);
 
       // trigger GC
       tick(false);
@@ -251,21 +224,21 @@ void DispatcherThread::run () {
 
       // require the lock
       _queue->_accessQueue.lock();
-
-      // cleanup
-      _queue->_monopolizer = 0;
-
-      if (0 < _queue->_nrWaiting && ! _queue->_readyJobs.empty()) {
-        _queue->_accessQueue.broadcast();
-      }
     }
     else {
 
       // cleanup without holding a lock
-      _queue->_accessQueue.unlock();
       tick(true);
       _queue->_accessQueue.lock();
 
+      // delete old threads
+      for (list<DispatcherThread*>::iterator i = _queue->_stoppedThreads.begin();  i != _queue->_stoppedThreads.end();  ++i) {
+        delete *i;
+      }
+
+      _queue->_stoppedThreads.clear();
+      _queue->_nrStopped = 0;
+
       // there is a chance, that we created more threads than necessary
       if (_queue->_nrThreads + _queue->_nrBlocked < _queue->_nrRunning + _queue->_nrStarted + _queue->_nrWaiting) {
         double n = TRI_microtime();
@@ -276,8 +249,11 @@ void DispatcherThread::run () {
         }
       }
 
-      // wait, if there are no jobs
-      if (_queue->_readyJobs.empty()) {
+      // wait, if there are no jobs we could start. announce this first, see
+      // DispatcherQueue::wakeupThread
+      ++_queue->_nrIdle;
+
+      if (! _queue->hasRunnableJob()) {
         _queue->_nrRunning--;
         _queue->_nrWaiting++;
 
@@ -286,6 +262,8 @@ void DispatcherThread::run () {
         _queue->_nrWaiting--;
         _queue->_nrRunning++;
       }
+
+      --_queue->_nrIdle;
     }
   }
 
@@ -144,6 +144,18 @@ namespace triagens {
 ////////////////////////////////////////////////////////////////////////////////
 
         Job::JobType _jobType;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief home lane of the thread in the queue
+////////////////////////////////////////////////////////////////////////////////
+
+        size_t _lane;
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief current job, protected by the lock of the home lane
+////////////////////////////////////////////////////////////////////////////////
+
+        Job* _currentJob;
     };
   }
 }
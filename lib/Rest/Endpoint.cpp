@@ -66,7 +66,8 @@ Endpoint::Endpoint (const Endpoint::EndpointType type,
   _domainType(domainType),
   _encryption(encryption),
   _specification(specification),
-  _listenBacklog(listenBacklog) {
+  _listenBacklog(listenBacklog),
+  _nonBlockingConnect(false) {
   TRI_invalidatesocket(&_socket);
 }
 
@@ -209,6 +209,26 @@ namespace triagens {
           return _connected;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief set whether or not client connects should return immediately
+///
+/// if set, connect() hands out the socket while the connection is still being
+/// established, and the caller has to wait for the socket to become writable
+/// before using it. this is only honoured by unencrypted TCP endpoints
+////////////////////////////////////////////////////////////////////////////////
+
+        void setNonBlockingConnect (bool value) {
+          _nonBlockingConnect = value;
+        }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return whether or not client connects return immediately
+////////////////////////////////////////////////////////////////////////////////
+
+        bool nonBlockingConnect () const {
+          return _nonBlockingConnect;
+        }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief get the type of an endpoint
 ////////////////////////////////////////////////////////////////////////////////
@@ -323,6 +343,12 @@ namespace triagens {
 
         int _listenBacklog;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not client connects return immediately
+////////////////////////////////////////////////////////////////////////////////
+
+        bool _nonBlockingConnect;
+
     };
   }
 }
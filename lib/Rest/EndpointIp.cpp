@@ -230,8 +230,30 @@ TRI_socket_t EndpointIp::connectSocket (const struct addrinfo* aip,
     // set timeout
     setTimeout(listenSocket, connectTimeout);
 
+    bool const nonBlocking = (_nonBlockingConnect && _encryption == ENCRYPTION_NONE);
+
+    if (nonBlocking) {
+      // switch to non-blocking before connecting, so connect() returns
+      // while the connection is still being established
+      if (! setSocketFlags(listenSocket)) {
+        TRI_CLOSE_SOCKET(listenSocket);
+        TRI_invalidatesocket(&listenSocket);
+        return listenSocket;
+      }
+    }
+
     int result = TRI_connect(listenSocket, (const struct sockaddr*) aip->ai_addr, (int) aip->ai_addrlen);
 
+#ifdef _WIN32
+    if (result != 0 && nonBlocking && WSAGetLastError() == WSAEWOULDBLOCK) {
+      result = 0;
+    }
+#else
+    if (result != 0 && nonBlocking && errno == EINPROGRESS) {
+      result = 0;
+    }
+#endif
+
     if (result != 0) {
       pErr = STR_ERROR();
       snprintf(errBuf, sizeof(errBuf),
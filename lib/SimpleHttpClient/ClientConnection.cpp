@@ -244,6 +244,14 @@ bool ClientConnection::writeClientConnection (void* buffer, size_t length, size_
 #endif
 
   if (status < 0) {
+#ifndef _WIN32
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      // the socket is non-blocking and its send buffer is full
+      *bytesWritten = 0;
+      return true;
+    }
+#endif
+
     TRI_set_errno(errno);
     disconnect();
     return false;
@@ -285,6 +293,13 @@ bool ClientConnection::readClientConnection (StringBuffer& stringBuffer,
     int lenRead = TRI_READ_SOCKET(_socket, stringBuffer.end(), READBUFFER_SIZE - 1, 0);
 
     if (lenRead == -1) {
+#ifndef _WIN32
+      if (errno == EAGAIN || errno == EWOULDBLOCK) {
+        // the socket is non-blocking and there is nothing to read yet
+        break;
+      }
+#endif
+
       // error occurred
       connectionClosed = true;
       return false;
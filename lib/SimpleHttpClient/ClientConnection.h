@@ -74,6 +74,20 @@ namespace triagens {
 
         virtual ~ClientConnection ();
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the underlying socket
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_socket_t getSocket () const {
+          return _socket;
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                                   private methods
 // -----------------------------------------------------------------------------
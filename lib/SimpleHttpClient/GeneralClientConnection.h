@@ -126,6 +126,15 @@ namespace triagens {
           return _isConnected;
         }
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the underlying socket
+///
+/// this is used to register the connection with an event loop. the socket
+/// is only valid while the connection is connected
+////////////////////////////////////////////////////////////////////////////////
+
+        virtual TRI_socket_t getSocket () const = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief reset the number of connect attempts
 ////////////////////////////////////////////////////////////////////////////////
@@ -59,6 +59,7 @@ namespace triagens {
       _warn(warn),
       _state(IN_CONNECT),
       _written(0),
+      _connectPending(false),
       _errorMessage(""),
       _locationRewriter({nullptr, nullptr}),
       _nextChunkedSize(0),
@@ -110,7 +111,42 @@ namespace triagens {
       char const* body,
       size_t bodyLength,
       std::map<std::string, std::string> const& headerFields) {
-      
+
+      beginRequest(method, location, body, bodyLength, headerFields);
+
+      // respect timeout
+      double endTime = now() + _requestTimeout;
+      double remainingTime = _requestTimeout;
+
+      while (! isFinished() && remainingTime > 0.0) {
+        // Note that this loop can either be left by timeout or because
+        // a connect did not work (which sets the _state to DEAD). In all
+        // other error conditions we call close() which resets the state
+        // to IN_CONNECT and tries a reconnect. This is important because
+        // it is always possible that we are called with a connection that
+        // has already been closed by the other side. This leads to the
+        // strange effect that the write (if it is small enough) proceeds
+        // but the following read runs into an error. In that case we try
+        // to reconnect one and then give up if this does not work.
+        processStep(remainingTime);
+
+        remainingTime = endTime - now();
+      }
+
+      return finishRequest();
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepare a request without sending anything
+////////////////////////////////////////////////////////////////////////////////
+
+    void SimpleHttpClient::beginRequest (
+      rest::HttpRequest::HttpRequestType method,
+      std::string const& location,
+      char const* body,
+      size_t bodyLength,
+      std::map<std::string, std::string> const& headerFields) {
+
       // ensure connection has not yet been invalidated
       TRI_ASSERT(_connection != nullptr);
 
@@ -128,149 +164,160 @@ namespace triagens {
 
       // ensure state
       TRI_ASSERT(_state == IN_CONNECT || _state == IN_WRITE);
+    }
 
-      // respect timeout
-      double endTime = now() + _requestTimeout;
-      double remainingTime = _requestTimeout;
+////////////////////////////////////////////////////////////////////////////////
+/// @brief perform a single step of the request
+////////////////////////////////////////////////////////////////////////////////
 
-      while (_state < FINISHED && remainingTime > 0.0) {
-        // Note that this loop can either be left by timeout or because
-        // a connect did not work (which sets the _state to DEAD). In all
-        // other error conditions we call close() which resets the state
-        // to IN_CONNECT and tries a reconnect. This is important because
-        // it is always possible that we are called with a connection that
-        // has already been closed by the other side. This leads to the
-        // strange effect that the write (if it is small enough) proceeds
-        // but the following read runs into an error. In that case we try
-        // to reconnect one and then give up if this does not work.
-        switch (_state) {
-          case (IN_CONNECT): {
-            handleConnect();
-            // If this goes wrong, _state is set to DEAD
-            break;
-          }
+    void SimpleHttpClient::processStep (double timeout) {
+      TRI_ASSERT(_result != nullptr);
+
+      switch (_state) {
+        case (IN_CONNECT): {
+          handleConnect();
+          // If this goes wrong, _state is set to DEAD
+          break;
+        }
 
-          case (IN_WRITE): {
-            size_t bytesWritten = 0;
+        case (IN_WRITE): {
+          size_t bytesWritten = 0;
 
-            TRI_set_errno(TRI_ERROR_NO_ERROR);
+          TRI_set_errno(TRI_ERROR_NO_ERROR);
 
-            bool res = _connection->handleWrite(
-              remainingTime, 
-              (void*) (_writeBuffer.c_str() + _written),
-              _writeBuffer.length() - _written,
-              &bytesWritten);
+          bool res = _connection->handleWrite(
+            timeout, 
+            (void*) (_writeBuffer.c_str() + _written),
+            _writeBuffer.length() - _written,
+            &bytesWritten);
 
-            if (! res) {
-              setErrorMessage("Error writing to '" +
+          if (! res) {
+            if (_connectPending) {
+              // the non-blocking connect has failed, do not retry
+              setErrorMessage("Could not connect to '" +
                               _connection->getEndpoint()->getSpecification() +
                               "' '" +
                               _connection->getErrorDetails() +
                               "'");
-              this->close(); // this sets _state to IN_CONNECT for a retry
+              this->close();
+              _state = DEAD;
+              _connectPending = false;
+              break;
             }
-            else {
-              _written += bytesWritten;
 
-              if (_written == _writeBuffer.length())  {
-                _state = IN_READ_HEADER;
-              }
-            }
+            setErrorMessage("Error writing to '" +
+                            _connection->getEndpoint()->getSpecification() +
+                            "' '" +
+                            _connection->getErrorDetails() +
+                            "'");
+            this->close(); // this sets _state to IN_CONNECT for a retry
+          }
+          else {
+            _connectPending = false;
+            _written += bytesWritten;
 
-            break;
+            if (_written == _writeBuffer.length())  {
+              _state = IN_READ_HEADER;
+            }
           }
 
-          case (IN_READ_HEADER):
-          case (IN_READ_BODY):
-          case (IN_READ_CHUNKED_HEADER):
-          case (IN_READ_CHUNKED_BODY): {
-            TRI_set_errno(TRI_ERROR_NO_ERROR);
+          break;
+        }
 
-            // we need to notice if the other side has closed the connection:
-            bool connectionClosed;
+        case (IN_READ_HEADER):
+        case (IN_READ_BODY):
+        case (IN_READ_CHUNKED_HEADER):
+        case (IN_READ_CHUNKED_BODY): {
+          TRI_set_errno(TRI_ERROR_NO_ERROR);
 
-            bool res = _connection->handleRead(remainingTime,
-                                               _readBuffer,
-                                               connectionClosed);
+          // we need to notice if the other side has closed the connection:
+          bool connectionClosed;
 
+          bool res = _connection->handleRead(timeout,
+                                             _readBuffer,
+                                             connectionClosed);
 
-            // If there was an error, then we are doomed:
-            if (! res) {
-              setErrorMessage("Error reading from: '" +
-                              _connection->getEndpoint()->getSpecification() +
-                              "' '" +
-                              _connection->getErrorDetails() +
-                              "'");
-              this->close(); // this sets the state to IN_CONNECT for a retry
-              break;
-            }
 
-            if (connectionClosed) {
-              // write might have succeeded even if the server has closed 
-              // the connection, this will then show up here with us being
-              // in state IN_READ_HEADER but nothing read.
-              if (_state == IN_READ_HEADER && 0 == _readBuffer.length()) {
-                this->close(); // sets _state to IN_CONNECT again for a retry
-                continue;
-              }
+          // If there was an error, then we are doomed:
+          if (! res) {
+            setErrorMessage("Error reading from: '" +
+                            _connection->getEndpoint()->getSpecification() +
+                            "' '" +
+                            _connection->getErrorDetails() +
+                            "'");
+            this->close(); // this sets the state to IN_CONNECT for a retry
+            break;
+          }
 
-              else if (_state == IN_READ_BODY && ! _result->hasContentLength()) {
-                // If we are reading the body and no content length was
-                // found in the header, then we must read until no more
-                // progress is made (but without an error), this then means
-                // that the server has closed the connection and we must
-                // process the body one more time:
-                _result->setContentLength(_readBuffer.length() - _readBufferOffset);
-                processBody();
-
-                if (_state != FINISHED) {
-                  // If the body was not fully found we give up:
-                  this->close(); // this sets the state IN_CONNECT to retry
-                }
-
-                break;
-              }
+          if (connectionClosed) {
+            // write might have succeeded even if the server has closed 
+            // the connection, this will then show up here with us being
+            // in state IN_READ_HEADER but nothing read.
+            if (_state == IN_READ_HEADER && 0 == _readBuffer.length()) {
+              this->close(); // sets _state to IN_CONNECT again for a retry
+              return;
+            }
 
-              else {
-                // In all other cases of closed connection, we are doomed:
-                this->close(); // this sets the state to IN_CONNECT retry
-                break;
+            else if (_state == IN_READ_BODY && ! _result->hasContentLength()) {
+              // If we are reading the body and no content length was
+              // found in the header, then we must read until no more
+              // progress is made (but without an error), this then means
+              // that the server has closed the connection and we must
+              // process the body one more time:
+              _result->setContentLength(_readBuffer.length() - _readBufferOffset);
+              processBody();
+
+              if (_state != FINISHED) {
+                // If the body was not fully found we give up:
+                this->close(); // this sets the state IN_CONNECT to retry
               }
+
+              break;
             }
 
-            // the connection is still alive:
-            switch (_state) {
-              case (IN_READ_HEADER):
-                processHeader();
-                break;
+            else {
+              // In all other cases of closed connection, we are doomed:
+              this->close(); // this sets the state to IN_CONNECT retry
+              break;
+            }
+          }
 
-              case (IN_READ_BODY):
-                processBody();
-                break;
+          // the connection is still alive:
+          switch (_state) {
+            case (IN_READ_HEADER):
+              processHeader();
+              break;
 
-              case (IN_READ_CHUNKED_HEADER):
-                processChunkedHeader();
-                break;
+            case (IN_READ_BODY):
+              processBody();
+              break;
 
-              case (IN_READ_CHUNKED_BODY):
-                processChunkedBody();
-                break;
+            case (IN_READ_CHUNKED_HEADER):
+              processChunkedHeader();
+              break;
 
-              default:
-                break;
-            }
+            case (IN_READ_CHUNKED_BODY):
+              processChunkedBody();
+              break;
 
-            break;
+            default:
+              break;
           }
 
-          default:
-            break;
+          break;
         }
 
-        remainingTime = endTime - now();
+        default:
+          break;
       }
+    }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finish a request and hand out its result
+////////////////////////////////////////////////////////////////////////////////
 
-      if (_state < FINISHED && _errorMessage.empty()) {
+    SimpleHttpResult* SimpleHttpClient::finishRequest () {
+      if (! isFinished() && _errorMessage.empty()) {
         setErrorMessage("Request timeout reached");
       }
 
@@ -306,6 +353,7 @@ namespace triagens {
           // can write now
           _state = IN_WRITE;
           _written = 0;
+          _connectPending = _connection->getEndpoint()->nonBlockingConnect();
         }
       }
 
@@ -121,6 +121,64 @@ namespace triagens {
                                  size_t,
                                  std::map<std::string, std::string> const&);
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief prepare a http request without sending anything
+///
+/// this is the non-blocking counterpart of request(): the caller drives the
+/// request by calling processStep() whenever the connection's socket is
+/// ready for the I/O indicated by wantsWrite(), and collects the result via
+/// finishRequest() once isFinished() returns true (or the caller gives up)
+////////////////////////////////////////////////////////////////////////////////
+
+      void beginRequest (rest::HttpRequest::HttpRequestType,
+                         std::string const&,
+                         char const*,
+                         size_t,
+                         std::map<std::string, std::string> const&);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief perform a single step of a request started with beginRequest()
+///
+/// this will wait at most the given number of seconds for the connection to
+/// become ready. if the connection's endpoint connects without blocking,
+/// connecting returns immediately and the socket becomes writable once the
+/// connection is established (or has failed)
+////////////////////////////////////////////////////////////////////////////////
+
+      void processStep (double);
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief finish a request started with beginRequest()
+/// the caller has to delete the result object
+////////////////////////////////////////////////////////////////////////////////
+
+      SimpleHttpResult* finishRequest ();
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the current request is complete or has failed
+////////////////////////////////////////////////////////////////////////////////
+
+      bool isFinished () const {
+        return _state >= FINISHED;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the current request needs to (re-)connect
+////////////////////////////////////////////////////////////////////////////////
+
+      bool needsConnect () const {
+        return _state == IN_CONNECT;
+      }
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not the current request waits for the socket to become
+/// writable (as opposed to readable)
+////////////////////////////////////////////////////////////////////////////////
+
+      bool wantsWrite () const {
+        return _state == IN_WRITE;
+      }
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief sets username and password
 ///
@@ -353,6 +411,14 @@ namespace triagens {
 
       size_t _written;
 
+////////////////////////////////////////////////////////////////////////////////
+/// @brief whether or not a non-blocking connect may still be in progress
+///
+/// if so, a failing first write means that the connect has failed
+////////////////////////////////////////////////////////////////////////////////
+
+      bool _connectPending;
+
       std::string _errorMessage;
 
 ////////////////////////////////////////////////////////////////////////////////
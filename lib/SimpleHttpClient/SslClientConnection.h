@@ -79,6 +79,20 @@ namespace triagens {
 
         virtual ~SslClientConnection ();
 
+// -----------------------------------------------------------------------------
+// --SECTION--                                                    public methods
+// -----------------------------------------------------------------------------
+
+      public:
+
+////////////////////////////////////////////////////////////////////////////////
+/// @brief return the underlying socket
+////////////////////////////////////////////////////////////////////////////////
+
+        TRI_socket_t getSocket () const {
+          return _socket;
+        }
+
 // -----------------------------------------------------------------------------
 // --SECTION--                                         protected virtual methods
 // -----------------------------------------------------------------------------